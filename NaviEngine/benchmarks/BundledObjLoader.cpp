@@ -0,0 +1,33 @@
+#include "BundledObjLoader.h"
+
+// Se incluyen antes los headers estndar que usa OBJ_Loader.h para que, al
+// abrir el namespace, sus #include no vuelvan a expandirse dentro de l.
+#include <fstream>
+#include <iostream>
+#include <math.h>
+#include <string>
+#include <vector>
+
+namespace
+bundled {
+#include "OBJ_Loader.h"
+}
+
+bool
+loadWithBundledObjLoader(const std::string& fileName, uint64_t& triangles) {
+  bundled::objl::Loader loader;
+
+  // OBJ_Loader.h define OBJL_CONSOLE_OUTPUT y escribe el progreso en std::cout;
+  // se silencia para no mezclarlo con el JSON de resultados.
+  std::streambuf* previous = std::cout.rdbuf(nullptr);
+  bool loaded = loader.LoadFile(fileName);
+  std::cout.rdbuf(previous);
+  std::cout.clear();
+
+  if (!loaded) {
+    triangles = 0;
+    return false;
+  }
+  triangles = loader.LoadedIndices.size() / 3;
+  return !loader.LoadedVertices.empty();
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * @file BundledObjLoader.h
+ * @brief Acceso al OBJ_Loader.h incluido en el repositorio.
+ *
+ * OBJ_Loader.h y ParserOBJ.h declaran ambos el namespace objl con clases
+ * distintas del mismo nombre. Para medir los dos en el mismo ejecutable el
+ * cargador original se compila aislado en BundledObjLoader.cpp, dentro del
+ * namespace "bundled", y solo se expone esta funcin.
+ */
+
+/**
+ * @brief Carga un OBJ con el objl::Loader de OBJ_Loader.h.
+ * @param fileName Ruta del archivo OBJ.
+ * @param triangles Recibe el nmero de tringulos cargados.
+ * @return true si se carg algn vrtice.
+ */
+bool
+loadWithBundledObjLoader(const std::string& fileName, uint64_t& triangles);
@@ -0,0 +1,2080 @@
+/**
+ * @file NaviBench.cpp
+ * @brief Benchmarks portables de las rutas calientes de carga de assets.
+ *
+ * Mide el parser OBJ propio (objl::Loader de ParserOBJ.h), el OBJ_Loader.h
+ * incluido en el repositorio, ModelLoader::Load y la decodificacin PNG/JPG de
+ * ImageDecoder (stb_image sobre el pool de memoria). Los assets se generan al vuelo (SyntheticAssets.h) y los
+ * resultados se escriben como JSON con MB/s, tringulos/s y megapxeles/s.
+ * Los casos jobs/... miden el escalado de JobSystem con 1..N hilos, los casos
+ * mips/... la generacin de la cadena de mipmaps (MipGenerator.h), los casos
+ * bcn/... el codificador de bloques (BlockCompressor.h), con su PSNR, los
+ * casos atlas/... el empaquetado de atlas (TextureAtlas.h), los casos
+ * channels/... las conversiones entre 1, 2, 3 y 4 canales (PixelFormat.h),
+ * comprobadas contra una versin escalar antes de medir, los casos lz/... el
+ * cdec de LzCodec.h, los casos vfs/... la lectura de 1000 archivos sueltos
+ * frente a un .pak (PakFile.h), con la cach del sistema caliente y fra, y
+ * los casos mem/... los asignadores de Allocators.h frente a malloc/new, los
+ * casos log/... el coste por llamada de Logger.h frente al antiguo MESSAGE y
+ * los casos math/... los ncleos por lotes de SimdMath.h frente a un bucle
+ * escalar, comprobados contra una referencia en double antes de medir, los
+ * casos graph/... la construccin y compilacin de un FrameGraph sinttico y
+ * los casos lights/... la asignacin de luces a clusters (ClusteredLights.h)
+ * frente a la prueba escalar de cada luz contra cada cluster, y los casos
+ * skin/... el skinning de personajes (Skinning.h) en vrtices por segundo, y
+ * los casos anim/... la compresin de clips (AnimationClip.h), con su cota de
+ * error comprobada, y su muestreo frente a interpolar los floats sin comprimir.
+ *
+ * No forma parte de las soluciones de Visual Studio. En Linux se compila con
+ * el objetivo navibench de NaviEngine/CMakeLists.txt:
+ *
+ *   cmake -S NaviEngine -B build -DCMAKE_BUILD_TYPE=Release
+ *   cmake --build build -j --target navibench
+ *   ./build/navibench --max-tris 1000000 --out results.json
+ *
+ * Con -DNAVI_AVX2=ON (-mavx2 -mfma) los casos math/..., skin/... y anim/...
+ * usan la ruta AVX2 de SimdMath.h.
+ *
+ * Opciones:
+ *   --filter <texto>   Solo ejecuta los casos cuyo nombre contiene el texto.
+ *   --max-tris <n>     Tamao mximo de malla (1K a 10M, por defecto 1M).
+ *   --max-image <n>    Lado mximo de imagen (256 a 4096, por defecto 2048).
+ *   --min-time <s>     Tiempo mnimo de medicin por caso (por defecto 0.5 s).
+ *   --max-threads <n>  Hilos mximos de los casos jobs/... (por defecto, los lgicos).
+ *   --assets <dir>     Carpeta de assets generados (por defecto navibench_assets).
+ *   --out <archivo>    Escribe el JSON en un archivo en lugar de stdout.
+ *   --list             Lista los casos sin ejecutarlos.
+ *
+ * Los archivos se leen con la cach del sistema caliente: se mide el coste de
+ * parseo/decodificacin, no el del disco. La excepcin son los casos
+ * vfs/... cold, que antes de cada iteracin piden al sistema que descarte las
+ * pginas de los archivos (posix_fadvise, solo en Linux).
+ */
+#include "BundledObjLoader.h"
+#include "SyntheticAssets.h"
+#include "Allocators.h"
+#include "AnimationClip.h"
+#include "BlockCompressor.h"
+#include "ClusteredLights.h"
+#include "Clock.h"
+#include "FileSystem.h"
+#include "FrameGraph.h"
+#include "ImageDecoder.h"
+#include "JobSystem.h"
+#include "Logger.h"
+#include "LzCodec.h"
+#include "MipGenerator.h"
+#include "ModelLoader.h"
+#include "PakFile.h"
+#include "ParserOBJ.h"
+#include "PixelFormat.h"
+#include "SimdMath.h"
+#include "Skinning.h"
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+  /**
+   * @struct BenchOptions
+   * @brief Opciones de lnea de comandos.
+   */
+  struct
+  BenchOptions {
+    std::string filter;
+    std::string assetDir = "navibench_assets";
+    std::string outFile;
+    uint64_t maxTriangles = 1000000;
+    unsigned int maxImageSize = 2048;
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    double minTime = 0.5;
+    bool listOnly = false;
+  };
+
+  /**
+   * @struct BenchResult
+   * @brief Resultado de un caso: tiempos por iteracin y volumen procesado.
+   */
+  struct
+  BenchResult {
+    std::string name;
+    std::string size;
+    bool ok = true;
+    unsigned int iterations = 0;
+    uint64_t bytes = 0;
+    uint64_t triangles = 0;
+    uint64_t pixels = 0;
+    uint64_t items = 0;
+    unsigned int threads = 0;
+    double psnr = 0.0;
+    double minSeconds = 0.0;
+    double medianSeconds = 0.0;
+    double meanSeconds = 0.0;
+  };
+
+  /**
+   * @struct BenchCase
+   * @brief Caso registrado. prepare() genera los assets y devuelve false si falla;
+   *        run() ejecuta una iteracin y devuelve false si el resultado es invlido.
+   *        reset() (opcional) se ejecuta antes de cada iteracin, fuera de la medicin.
+   */
+  struct
+  BenchCase {
+    std::string name;
+    std::string size;
+    std::function<bool(BenchResult&)> prepare;
+    std::function<bool()> run;
+    std::function<void()> reset;
+  };
+
+  std::string
+  sizeLabel(uint64_t count) {
+    if (count >= 1000000) return std::to_string(count / 1000000) + "M";
+    if (count >= 1000) return std::to_string(count / 1000) + "K";
+    return std::to_string(count);
+  }
+
+  std::string
+  jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+        out += c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20) {
+        char code[8];
+        std::snprintf(code, sizeof(code), "\\u%04x", c);
+        out += code;
+      }
+      else {
+        out += c;
+      }
+    }
+    return out;
+  }
+
+  std::string
+  cpuModel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+      if (line.compare(0, 10, "model name") == 0) {
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+          return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+      }
+    }
+    return "unknown";
+  }
+
+  std::string
+  compilerName() {
+#if defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+  }
+
+  bool
+  fileExists(const std::string& fileName) {
+    struct stat info;
+    return stat(fileName.c_str(), &info) == 0;
+  }
+
+  uint64_t
+  fileSize(const std::string& fileName) {
+    struct stat info;
+    return stat(fileName.c_str(), &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+  }
+
+  /**
+   * @brief Genera (o reutiliza) la malla de @p triangles tringulos.
+   */
+  bool
+  prepareMesh(const BenchOptions& options, uint64_t triangles, std::string& fileName, BenchResult& result) {
+    fileName = options.assetDir + "/grid_" + sizeLabel(triangles) + ".obj";
+    SyntheticMeshInfo info;
+    if (!fileExists(fileName)) {
+      std::fprintf(stderr, "generating %s\n", fileName.c_str());
+      if (!writeSyntheticObj(fileName, triangles, info)) {
+        return false;
+      }
+    }
+    result.bytes = fileSize(fileName);
+    return result.bytes > 0;
+  }
+
+  /**
+   * @brief Ejecuta un caso hasta cubrir el tiempo mnimo y calcula las estadsticas.
+   */
+  void
+  measure(const BenchOptions& options, const BenchCase& bench, BenchResult& result) {
+    SystemClock clock;
+    std::vector<double> samples;
+    double elapsed = 0.0;
+    const unsigned int kMaxIterations = 1000;
+
+    while (samples.size() < kMaxIterations && (samples.empty() || elapsed < options.minTime)) {
+      if (bench.reset) {
+        bench.reset();
+      }
+      double start = clock.now();
+      bool ok = bench.run();
+      double seconds = clock.now() - start;
+      if (!ok) {
+        result.ok = false;
+        break;
+      }
+      samples.push_back(seconds);
+      elapsed += seconds;
+    }
+
+    result.iterations = static_cast<unsigned int>(samples.size());
+    if (samples.empty()) {
+      return;
+    }
+    std::sort(samples.begin(), samples.end());
+    result.minSeconds = samples.front();
+    result.medianSeconds = samples[samples.size() / 2];
+    result.meanSeconds = elapsed / samples.size();
+  }
+
+  void
+  writeJson(FILE* out, const std::vector<BenchResult>& results) {
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"suite\": \"navibench\",\n");
+    std::fprintf(out, "  \"timestamp\": \"%s\",\n", timestamp);
+    std::fprintf(out, "  \"host\": {\n");
+    std::fprintf(out, "    \"cpu\": \"%s\",\n", jsonEscape(cpuModel()).c_str());
+    std::fprintf(out, "    \"threads\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(out, "    \"compiler\": \"%s\"\n", jsonEscape(compilerName()).c_str());
+    std::fprintf(out, "  },\n");
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+      const BenchResult& r = results[i];
+      double median = r.medianSeconds > 0.0 ? r.medianSeconds : 1e-12;
+      std::fprintf(out, "    {\"name\": \"%s\", \"size\": \"%s\", \"ok\": %s, \"iterations\": %u, "
+                        "\"bytes\": %llu, \"triangles\": %llu, \"pixels\": %llu, \"items\": %llu, \"threads\": %u, "
+                        "\"min_s\": %.9f, \"median_s\": %.9f, \"mean_s\": %.9f, "
+                        "\"mb_per_s\": %.3f, \"triangles_per_s\": %.1f, \"mpixels_per_s\": %.3f, "
+                        "\"items_per_s\": %.1f, \"psnr_db\": %.2f}%s\n",
+                   jsonEscape(r.name).c_str(), r.size.c_str(), r.ok ? "true" : "false", r.iterations,
+                   static_cast<unsigned long long>(r.bytes),
+                   static_cast<unsigned long long>(r.triangles),
+                   static_cast<unsigned long long>(r.pixels),
+                   static_cast<unsigned long long>(r.items),
+                   r.threads,
+                   r.minSeconds, r.medianSeconds, r.meanSeconds,
+                   r.bytes / median / 1e6,
+                   r.triangles / median,
+                   r.pixels / median / 1e6,
+                   r.items / median,
+                   r.psnr,
+                   i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+  }
+
+  /**
+   * @brief Registra los casos de carga de OBJ para todas las mallas permitidas.
+   */
+  void
+  registerObjCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    static const uint64_t kTriangleCounts[] = { 1000, 10000, 100000, 1000000, 10000000 };
+
+    for (uint64_t count : kTriangleCounts) {
+      if (count > options.maxTriangles) {
+        continue;
+      }
+      auto fileName = std::make_shared<std::string>();
+      auto expected = std::make_shared<uint64_t>(0);
+      std::string label = sizeLabel(count);
+
+      auto prepare = [&options, count, fileName, expected](BenchResult& result) {
+        if (!prepareMesh(options, count, *fileName, result)) {
+          return false;
+        }
+        // El nmero real de tringulos lo da el propio parser.
+        objl::Loader loader;
+        if (!loader.LoadFile(*fileName)) {
+          return false;
+        }
+        *expected = loader.LoadedIndices.size() / 3;
+        result.triangles = *expected;
+        return true;
+      };
+
+      cases.push_back({ "obj/ParserOBJ::LoadFile", label, prepare, [fileName, expected]() {
+        objl::Loader loader;
+        return loader.LoadFile(*fileName) && loader.LoadedIndices.size() / 3 == *expected;
+      } });
+
+      cases.push_back({ "obj/ModelLoader::Load", label, prepare, [fileName, expected]() {
+        ModelLoader modelLoader;
+        LoadData data = modelLoader.Load(*fileName);
+        return static_cast<uint64_t>(data.numIndex / 3) == *expected;
+      } });
+
+      cases.push_back({ "obj/OBJ_Loader.h", label, prepare, [fileName, expected]() {
+        uint64_t triangles = 0;
+        return loadWithBundledObjLoader(*fileName, triangles) && triangles == *expected;
+      } });
+    }
+  }
+
+  /**
+   * @brief Registra los casos de decodificacin PNG/JPG desde memoria.
+   */
+  void
+  registerImageCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    static const unsigned int kImageSizes[] = { 256, 1024, 2048, 4096 };
+
+    for (unsigned int side : kImageSizes) {
+      if (side > options.maxImageSize) {
+        continue;
+      }
+      std::string label = std::to_string(side) + "x" + std::to_string(side);
+
+      struct Encoded {
+        std::vector<uint8_t> png;
+        std::vector<uint8_t> jpg;
+      };
+      auto encoded = std::make_shared<Encoded>();
+
+      auto makePrepare = [&options, side, encoded](bool png) {
+        return [&options, side, encoded, png](BenchResult& result) {
+          std::string base = options.assetDir + "/image_" + std::to_string(side);
+          std::vector<uint8_t>& bytes = png ? encoded->png : encoded->jpg;
+          if (bytes.empty()) {
+            std::vector<uint8_t> pixels = generateSyntheticImage(side, side, 4);
+            bytes = png ? encodePng(pixels, side, side, 4) : encodeJpeg(pixels, side, side, 4, 90);
+            // Se guardan en disco para poder inspeccionarlas.
+            writeFileBytes(base + (png ? ".png" : ".jpg"), bytes);
+          }
+          result.bytes = bytes.size();
+          result.pixels = static_cast<uint64_t>(side) * side;
+          return !bytes.empty();
+        };
+      };
+
+      auto decode = [encoded, side](bool png) {
+        return [encoded, side, png]() {
+          const std::vector<uint8_t>& bytes = png ? encoded->png : encoded->jpg;
+          // Igual que Texture::init: RGBA8 en memoria del pool, que vuelve al pool al terminar.
+          DecodedImage image;
+          bool ok = ImageDecoder::instance().decodeMemory(bytes.data(), bytes.size(), image) &&
+                    image.width == side && image.height == side;
+          ImageDecoder::instance().recycle(std::move(image.pixels));
+          return ok;
+        };
+      };
+
+      cases.push_back({ "image/stb_image PNG", label, makePrepare(true), decode(true) });
+      cases.push_back({ "image/stb_image JPG", label, makePrepare(false), decode(false) });
+    }
+  }
+
+  /**
+   * @brief Reinicia el JobSystem con @p threads hilos en total (1 = sin hilos de trabajo).
+   */
+  bool
+  restartJobSystem(unsigned int threads) {
+    JobSystem& jobs = JobSystem::instance();
+    jobs.destroy();
+    return threads <= 1 || (jobs.init(threads - 1) && jobs.threadCount() == threads);
+  }
+
+  /**
+   * @brief Registra los casos de escalado del JobSystem para 1, 2, 4... hilos.
+   */
+  void
+  registerJobCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    const size_t kElements = 4 * 1024 * 1024;
+    const unsigned int kSpawnJobs = 100000;
+    auto data = std::make_shared<std::vector<float>>();
+
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < options.maxThreads; threads *= 2) {
+      threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(options.maxThreads);
+
+    for (unsigned int threads : threadCounts) {
+      std::string label = std::to_string(threads) + "t";
+
+      auto preparefor = [data, threads, kElements](BenchResult& result) {
+        if (data->empty()) {
+          data->resize(kElements);
+          for (size_t i = 0; i < kElements; ++i) {
+            (*data)[i] = static_cast<float>(i % 1000) * 0.001f;
+          }
+        }
+        result.threads = threads;
+        result.items = kElements;
+        result.bytes = kElements * sizeof(float);
+        return restartJobSystem(threads);
+      };
+
+      // Carga limitada por clculo: el escalado ideal es lineal con los ncleos fsicos.
+      cases.push_back({ "jobs/parallelFor", label, preparefor, [data, kElements]() {
+        std::atomic<uint64_t> checksum{ 0 };
+        JobSystem::instance().parallelFor(0, kElements, [&](size_t begin, size_t end) {
+          double sum = 0.0;
+          for (size_t i = begin; i < end; ++i) {
+            float x = (*data)[i];
+            sum += std::sqrt(x * x + 1.0f) * std::sin(x);
+          }
+          checksum.fetch_add(static_cast<uint64_t>(sum * 1000.0));
+        });
+        return checksum.load() > 0;
+      } });
+
+      // Coste puro de planificar, robar y completar tareas vacas.
+      cases.push_back({ "jobs/spawn empty", label, [threads, kSpawnJobs](BenchResult& result) {
+        result.threads = threads;
+        result.items = kSpawnJobs;
+        return restartJobSystem(threads);
+      }, [kSpawnJobs]() {
+        JobSystem& jobs = JobSystem::instance();
+        std::atomic<unsigned int> executed{ 0 };
+        JobCounter counter;
+        for (unsigned int i = 0; i < kSpawnJobs; ++i) {
+          jobs.run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+        return executed.load() == kSpawnJobs;
+      } });
+    }
+  }
+
+  bool
+  parseArguments(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      auto value = [&]() -> const char* {
+        if (i + 1 >= argc) {
+          std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+          std::exit(2);
+        }
+        return argv[++i];
+      };
+      if (arg == "--filter") options.filter = value();
+      else if (arg == "--max-tris") options.maxTriangles = std::strtoull(value(), nullptr, 10);
+      else if (arg == "--max-image") options.maxImageSize = static_cast<unsigned int>(std::strtoul(value(), nullptr, 10));
+      else if (arg == "--min-time") options.minTime = std::strtod(value(), nullptr);
+      else if (arg == "--max-threads") options.maxThreads = std::max(1u, static_cast<unsigned int>(std::strtoul(value(), nullptr, 10)));
+      else if (arg == "--assets") options.assetDir = value();
+      else if (arg == "--out") options.outFile = value();
+      else if (arg == "--list") options.listOnly = true;
+      else {
+        std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Registra los casos de generacin de mipmaps (filtro box y Kaiser) con todos los hilos.
+   */
+  void
+  registerMipCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    static const unsigned int kImageSizes[] = { 256, 1024, 2048, 4096 };
+
+    for (unsigned int side : kImageSizes) {
+      if (side > options.maxImageSize) {
+        continue;
+      }
+      std::string label = std::to_string(side) + "x" + std::to_string(side);
+      auto pixels = std::make_shared<std::vector<uint8_t>>();
+
+      auto prepare = [&options, side, pixels](BenchResult& result) {
+        if (pixels->empty()) {
+          *pixels = generateSyntheticImage(side, side, 4);
+        }
+        result.bytes = pixels->size();
+        result.pixels = static_cast<uint64_t>(side) * side;
+        result.threads = options.maxThreads;
+        return restartJobSystem(options.maxThreads);
+      };
+
+      auto generate = [pixels, side](MipFilter filter) {
+        return [pixels, side, filter]() {
+          MipSettings settings;
+          settings.filter = filter;
+          MipChain chain;
+          return generateMipChain(pixels->data(), side, side, settings, chain) &&
+                 chain.levels.size() == mipLevelCount(side, side);
+        };
+      };
+
+      cases.push_back({ "mips/box", label, prepare, generate(MIP_FILTER_BOX) });
+      cases.push_back({ "mips/kaiser", label, prepare, generate(MIP_FILTER_KAISER) });
+    }
+  }
+
+  /**
+   * @brief Registra los casos de compresin BCn (formato x preset) con todos los hilos.
+   *
+   * prepare() comprime una vez, decodifica y guarda el PSNR en el resultado.
+   */
+  void
+  registerBlockCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    static const unsigned int kImageSizes[] = { 256, 1024 };
+    static const struct {
+      BlockFormat format;
+      const char* name;
+      unsigned int channelMask;
+    } kFormats[] = {
+      { BLOCK_BC1, "bc1", 0x7 }, { BLOCK_BC3, "bc3", 0xF }, { BLOCK_BC4, "bc4", 0x1 },
+      { BLOCK_BC5, "bc5", 0x3 }, { BLOCK_BC7, "bc7", 0xF }
+    };
+    static const char* kQualityNames[] = { "fast", "normal", "high" };
+
+    for (unsigned int side : kImageSizes) {
+      if (side > options.maxImageSize) {
+        continue;
+      }
+      std::string label = std::to_string(side) + "x" + std::to_string(side);
+      auto translucent = std::make_shared<std::vector<uint8_t>>();
+      auto opaque = std::make_shared<std::vector<uint8_t>>();
+
+      for (const auto& format : kFormats) {
+        for (int quality = BLOCK_QUALITY_FAST; quality <= BLOCK_QUALITY_HIGH; ++quality) {
+          BlockFormat blockFormat = format.format;
+          BlockQuality blockQuality = static_cast<BlockQuality>(quality);
+          unsigned int channelMask = format.channelMask;
+          // BC1 solo guarda alpha de 1 bit: se mide con una copia opaca de la imagen.
+          auto pixels = blockFormat == BLOCK_BC1 ? opaque : translucent;
+
+          auto prepare = [&options, side, pixels, blockFormat, blockQuality, channelMask](BenchResult& result) {
+            if (pixels->empty()) {
+              *pixels = generateSyntheticImage(side, side, 4);
+              if (blockFormat == BLOCK_BC1) {
+                for (size_t i = 3; i < pixels->size(); i += 4) {
+                  (*pixels)[i] = 255;
+                }
+              }
+            }
+            result.bytes = pixels->size();
+            result.pixels = static_cast<uint64_t>(side) * side;
+            result.threads = options.maxThreads;
+            if (!restartJobSystem(options.maxThreads)) {
+              return false;
+            }
+            std::vector<uint8_t> blocks;
+            std::vector<uint8_t> decoded;
+            if (!compressImage(pixels->data(), side, side, blockFormat, blockQuality, blocks) ||
+                !decompressImage(blocks.data(), side, side, blockFormat, decoded)) {
+              return false;
+            }
+            result.psnr = computePsnr(pixels->data(), decoded.data(), result.pixels, channelMask);
+            return true;
+          };
+
+          auto compress = [pixels, side, blockFormat, blockQuality]() {
+            std::vector<uint8_t> blocks;
+            return compressImage(pixels->data(), side, side, blockFormat, blockQuality, blocks) &&
+                   blocks.size() == compressedSize(blockFormat, side, side);
+          };
+
+          cases.push_back({ std::string("bcn/") + format.name + " " + kQualityNames[quality], label, prepare, compress });
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Registra los casos de empaquetado de atlas (1K, 5K y 20K imgenes de 8 a 256 texels).
+   */
+  void
+  registerAtlasCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    static const unsigned int kCounts[] = { 1000, 5000, 20000 };
+    (void)options;
+
+    for (unsigned int count : kCounts) {
+      auto inputs = std::make_shared<std::vector<AtlasInput>>();
+
+      auto prepare = [inputs, count](BenchResult& result) {
+        if (inputs->empty()) {
+          // Tamaos deterministas: mezcla de potencias de 2 y tamaos arbitrarios.
+          uint32_t state = 12345u;
+          inputs->resize(count);
+          for (AtlasInput& input : *inputs) {
+            state = state * 1664525u + 1013904223u;
+            input.width = 8 + (state >> 8) % 249;
+            state = state * 1664525u + 1013904223u;
+            input.height = (state & 0x100) ? input.width : 8 + (state >> 8) % 249;
+          }
+        }
+        result.items = count;
+        result.pixels = 0;
+        for (const AtlasInput& input : *inputs) {
+          result.pixels += static_cast<uint64_t>(input.width) * input.height;
+        }
+        return true;
+      };
+
+      auto pack = [inputs]() {
+        AtlasLayout layout;
+        return packAtlas(*inputs, AtlasSettings(), layout) && !layout.pages.empty();
+      };
+
+      cases.push_back({ "atlas/pack", sizeLabel(count), prepare, pack });
+    }
+  }
+
+  /**
+   * @brief Registra la matriz de conversiones de canales (gris, gris + alpha, RGB, RGBA -> R8, R8G8, RGBA8).
+   *
+   * La exactitud de cada conversin se comprueba en tests/PixelFormatTests.cpp.
+   */
+  void
+  registerChannelCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    static const unsigned int kSourceChannels[] = { 1, 2, 3, 4 };
+    static const unsigned int kTargetChannels[] = { 1, 2, 4 };
+    unsigned int side = std::min(2048u, options.maxImageSize);
+    std::string label = std::to_string(side) + "x" + std::to_string(side);
+    size_t pixelCount = static_cast<size_t>(side) * side;
+
+    for (unsigned int srcChannels : kSourceChannels) {
+      auto pixels = std::make_shared<std::vector<uint8_t>>();
+      for (unsigned int dstChannels : kTargetChannels) {
+        if (srcChannels == dstChannels) {
+          continue;
+        }
+        auto output = std::make_shared<std::vector<uint8_t>>();
+
+        auto prepare = [side, pixelCount, srcChannels, dstChannels, pixels, output](BenchResult& result) {
+          if (pixels->empty()) {
+            *pixels = generateSyntheticImage(side, side, srcChannels);
+          }
+          output->assign(pixelCount * dstChannels, 0);
+          result.bytes = pixels->size();
+          result.pixels = pixelCount;
+          return true;
+        };
+
+        auto convert = [pixelCount, srcChannels, dstChannels, pixels, output]() {
+          return convertChannels(pixels->data(), srcChannels, output->data(), dstChannels, pixelCount);
+        };
+
+        std::string name = "channels/" + std::to_string(srcChannels) + "to" + std::to_string(dstChannels);
+        cases.push_back({ name, label, prepare, convert });
+      }
+    }
+  }
+
+  /**
+   * @brief Texto con la forma de un OBJ (vrtices, coordenadas y caras) de unos @p bytes.
+   */
+  std::string
+  syntheticObjText(size_t bytes, uint32_t seed) {
+    std::string text;
+    text.reserve(bytes + 64);
+    char line[96];
+    uint32_t state = seed * 2654435761u + 1;
+    auto next = [&state]() {
+      state = state * 1664525u + 1013904223u;
+      return state >> 8;
+    };
+    for (unsigned int i = 1; text.size() < bytes; ++i) {
+      int length;
+      switch (i % 4) {
+      case 0:
+        length = std::snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u\n",
+                               i, i, i, i + 1, i + 1, i, i + 2, i + 2, i);
+        break;
+      case 1:
+        length = std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", (next() % 100000) / 1e5, (next() % 100000) / 1e5);
+        break;
+      default:
+        length = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", (next() % 200000) / 1e5 - 1.0,
+                               (next() % 200000) / 1e5 - 1.0, (next() % 200000) / 1e5 - 1.0);
+        break;
+      }
+      text.append(line, static_cast<size_t>(length));
+    }
+    return text;
+  }
+
+  /**
+   * @brief Pide al sistema que descarte de la cach las pginas de @p fileName.
+   */
+  bool
+  dropFileCache(const std::string& fileName) {
+#if defined(__linux__)
+    int descriptor = open(fileName.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      return false;
+    }
+    int result = posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+    close(descriptor);
+    return result == 0;
+#else
+    (void)fileName;
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Suma de todos los bytes de la vista, para obligar a leerlos.
+   */
+  uint64_t
+  checksumView(const FileView& view) {
+    uint64_t sum = 0;
+    size_t words = view.size() / 8;
+    for (size_t i = 0; i < words; ++i) {
+      uint64_t word;
+      std::memcpy(&word, view.data() + i * 8, 8);
+      sum += word;
+    }
+    for (size_t i = words * 8; i < view.size(); ++i) {
+      sum += view.data()[i];
+    }
+    return sum;
+  }
+
+  /**
+   * @brief Registra los casos del cdec LZ sobre 16 MB de texto OBJ.
+   */
+  void
+  registerLzCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    (void)options;
+    struct Corpus {
+      std::string text;
+      std::vector<uint8_t> compressed;
+      std::vector<uint8_t> output;
+    };
+    auto corpus = std::make_shared<Corpus>();
+    const size_t kBytes = 16u << 20;
+
+    auto prepare = [corpus, kBytes](BenchResult& result) {
+      if (corpus->text.empty()) {
+        corpus->text = syntheticObjText(kBytes, 7);
+        lzCompress(reinterpret_cast<const uint8_t*>(corpus->text.data()), corpus->text.size(), corpus->compressed);
+        corpus->output.resize(corpus->text.size());
+        std::fprintf(stderr, "lz: %zu -> %zu bytes (%.1f%%)\n", corpus->text.size(), corpus->compressed.size(),
+                     100.0 * corpus->compressed.size() / corpus->text.size());
+      }
+      result.bytes = corpus->text.size();
+      // La ida y vuelta debe reproducir el original.
+      return lzDecompress(corpus->compressed.data(), corpus->compressed.size(),
+                          corpus->output.data(), corpus->output.size()) &&
+             std::memcmp(corpus->output.data(), corpus->text.data(), corpus->text.size()) == 0;
+    };
+
+    cases.push_back({ "lz/compress", "16MB", prepare, [corpus]() {
+      std::vector<uint8_t> out;
+      return lzCompress(reinterpret_cast<const uint8_t*>(corpus->text.data()), corpus->text.size(), out) ==
+             corpus->compressed.size();
+    } });
+    cases.push_back({ "lz/decompress", "16MB", prepare, [corpus]() {
+      return lzDecompress(corpus->compressed.data(), corpus->compressed.size(),
+                          corpus->output.data(), corpus->output.size());
+    } });
+  }
+
+  /**
+   * @brief Registra la lectura de 1000 archivos (texto OBJ y pxeles) sueltos y
+   *        desde un .pak sin comprimir y comprimido, con cach caliente y fra.
+   *
+   * Cada iteracin abre el origen (la carpeta o el .pak), abre cada archivo por
+   * su ruta y suma todos sus bytes.
+   */
+  void
+  registerVfsCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    const unsigned int kFiles = 1000;
+    struct Corpus {
+      std::vector<std::string> names;
+      std::vector<uint64_t> checksums;
+      uint64_t bytes = 0;
+    };
+    auto corpus = std::make_shared<Corpus>();
+    std::string directory = options.assetDir;
+    std::string rawPak = options.assetDir + "/vfs.pak";
+    std::string lzPak = options.assetDir + "/vfs_lz.pak";
+
+    auto prepare = [corpus, directory, rawPak, lzPak, kFiles](BenchResult& result) {
+      if (corpus->names.empty()) {
+        mkdir((directory + "/vfs").c_str(), 0755);
+        PakWriter raw;
+        PakWriter compressed;
+        std::vector<uint8_t> pixels = generateSyntheticImage(64, 64, 4);
+        for (unsigned int i = 0; i < kFiles; ++i) {
+          char name[32];
+          std::vector<uint8_t> data;
+          if (i % 2 == 0) {
+            std::snprintf(name, sizeof(name), "vfs/mesh%04u.obj", i);
+            std::string text = syntheticObjText(4096 + (i * 7919u) % 61440, i);
+            data.assign(text.begin(), text.end());
+          }
+          else {
+            std::snprintf(name, sizeof(name), "vfs/pixels%04u.raw", i);
+            data = pixels;
+            data[0] = static_cast<uint8_t>(i);
+          }
+          if (!fileExists(directory + "/" + name) && !writeFileBytes(directory + "/" + name, data)) {
+            return false;
+          }
+          raw.add(name, data.data(), data.size(), false);
+          compressed.add(name, data.data(), data.size(), true);
+          corpus->names.push_back(name);
+          corpus->checksums.push_back(checksumView(FileView(std::move(data))));
+        }
+        corpus->bytes = raw.originalBytes();
+        if (!raw.write(rawPak) || !compressed.write(lzPak)) {
+          return false;
+        }
+        std::fprintf(stderr, "vfs: %u files, %.1f MB, lz pak stores %.1f MB\n", kFiles,
+                     raw.originalBytes() / 1e6, compressed.storedBytes() / 1e6);
+      }
+      result.bytes = corpus->bytes;
+      result.items = corpus->names.size();
+      return true;
+    };
+
+    auto readAll = [corpus](const FileSource& source) {
+      for (size_t i = 0; i < corpus->names.size(); ++i) {
+        FileView view;
+        if (!source.open(corpus->names[i], view) || checksumView(view) != corpus->checksums[i]) {
+          return false;
+        }
+      }
+      return true;
+    };
+    auto readLoose = [directory, readAll]() {
+      return readAll(DirectorySource(directory));
+    };
+    auto readPak = [readAll](const std::string& fileName) {
+      return [readAll, fileName]() {
+        PakArchive archive;
+        return archive.load(fileName) && readAll(archive);
+      };
+    };
+
+    std::string label = sizeLabel(kFiles) + " files";
+    cases.push_back({ "vfs/loose warm", label, prepare, readLoose });
+    cases.push_back({ "vfs/pak warm", label, prepare, readPak(rawPak) });
+    cases.push_back({ "vfs/pak-lz warm", label, prepare, readPak(lzPak) });
+#if defined(__linux__)
+    auto dropLoose = [corpus, directory]() {
+      for (const std::string& name : corpus->names) {
+        dropFileCache(directory + "/" + name);
+      }
+    };
+    cases.push_back({ "vfs/loose cold", label, prepare, readLoose, dropLoose });
+    cases.push_back({ "vfs/pak cold", label, prepare, readPak(rawPak), [rawPak]() { dropFileCache(rawPak); } });
+    cases.push_back({ "vfs/pak-lz cold", label, prepare, readPak(lzPak), [lzPak]() { dropFileCache(lzPak); } });
+#endif
+  }
+
+  /**
+   * @brief Registra los asignadores de Allocators.h frente a malloc/new.
+   *
+   * - mem/frame: 10000 asignaciones de 16 a 256 bytes por "frame" y liberacin
+   *   de todas (reset() frente a free() de cada una).
+   * - mem/pool: 100000 altas y bajas de objetos de 64 bytes sobre 1024 vivos.
+   * - mem/map: el cach de vrtices de ParserOBJ, 100000 claves "v/vt/vn".
+   * - mem/tagged: el sobrecoste de la contabilidad de TaggedHeap sobre malloc.
+   */
+  void
+  registerMemoryCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    (void)options;
+    const size_t kFrameAllocations = 10000;
+    const size_t kPoolOperations = 100000;
+    const size_t kPoolLive = 1024;
+    const size_t kMapKeys = 100000;
+
+    // Tamaos y orden de reemplazo fijos para que todas las variantes hagan el mismo trabajo.
+    auto sizes = std::make_shared<std::vector<uint32_t>>();
+    auto victims = std::make_shared<std::vector<uint32_t>>();
+    auto keys = std::make_shared<std::vector<std::string>>();
+    uint32_t state = 12345;
+    auto next = [&state]() {
+      state = state * 1664525u + 1013904223u;
+      return state >> 8;
+    };
+    for (size_t i = 0; i < kFrameAllocations; ++i) {
+      sizes->push_back(16 + next() % 241);
+    }
+    for (size_t i = 0; i < kPoolOperations; ++i) {
+      victims->push_back(next() % kPoolLive);
+    }
+    for (size_t i = 0; i < kMapKeys; ++i) {
+      keys->push_back(std::to_string(1 + next() % 50000) + "/" + std::to_string(1 + next() % 50000) + "/" +
+                      std::to_string(1 + next() % 50000));
+    }
+
+    auto items = [](size_t count) {
+      return [count](BenchResult& result) {
+        result.items = count;
+        return true;
+      };
+    };
+
+    auto frameAllocator = std::make_shared<LinearAllocator>(64 * 1024, MEMORY_FRAME);
+    cases.push_back({ "mem/frame linear", "10K allocs", items(kFrameAllocations), [sizes, frameAllocator]() {
+      uint64_t sum = 0;
+      for (uint32_t size : *sizes) {
+        uint8_t* block = static_cast<uint8_t*>(frameAllocator->allocate(size, 16));
+        block[0] = static_cast<uint8_t>(size);
+        sum += block[0];
+      }
+      frameAllocator->reset();
+      return sum != 0;
+    } });
+    cases.push_back({ "mem/frame malloc", "10K allocs", items(kFrameAllocations), [sizes]() {
+      std::vector<void*> blocks;
+      blocks.reserve(sizes->size());
+      uint64_t sum = 0;
+      for (uint32_t size : *sizes) {
+        uint8_t* block = static_cast<uint8_t*>(std::malloc(size));
+        block[0] = static_cast<uint8_t>(size);
+        sum += block[0];
+        blocks.push_back(block);
+      }
+      for (void* block : blocks) {
+        std::free(block);
+      }
+      return sum != 0;
+    } });
+
+    struct
+    Particle {
+      float position[4];
+      float velocity[4];
+      float color[4];
+      uint64_t id;
+      uint64_t flags;
+    };
+    static_assert(sizeof(Particle) == 64, "El caso mem/pool usa objetos de 64 bytes");
+
+    auto pool = std::make_shared<TypedPool<Particle>>(kPoolLive, MEMORY_GENERAL);
+    cases.push_back({ "mem/pool", "100K ops", items(kPoolOperations), [victims, pool, kPoolLive]() {
+      std::vector<Particle*> live(kPoolLive);
+      for (size_t i = 0; i < kPoolLive; ++i) {
+        live[i] = pool->create();
+        live[i]->id = i;
+      }
+      for (uint32_t victim : *victims) {
+        pool->destroy(live[victim]);
+        live[victim] = pool->create();
+        live[victim]->id = victim;
+      }
+      bool ok = true;
+      for (size_t i = 0; i < kPoolLive; ++i) {
+        ok = ok && live[i]->id == i;
+        pool->destroy(live[i]);
+      }
+      return ok && pool->liveCount() == 0;
+    } });
+    cases.push_back({ "mem/pool new-delete", "100K ops", items(kPoolOperations), [victims, kPoolLive]() {
+      std::vector<Particle*> live(kPoolLive);
+      for (size_t i = 0; i < kPoolLive; ++i) {
+        live[i] = new Particle();
+        live[i]->id = i;
+      }
+      for (uint32_t victim : *victims) {
+        delete live[victim];
+        live[victim] = new Particle();
+        live[victim]->id = victim;
+      }
+      bool ok = true;
+      for (size_t i = 0; i < kPoolLive; ++i) {
+        ok = ok && live[i]->id == i;
+        delete live[i];
+      }
+      return ok;
+    } });
+
+    cases.push_back({ "mem/map linear", "100K keys", items(kMapKeys), [keys]() {
+      LinearAllocator scratch(256 * 1024, MEMORY_LOADER);
+      LinearMap<std::string, unsigned int> cache{ LinearStlAllocator<std::pair<const std::string, unsigned int>>(scratch) };
+      for (size_t i = 0; i < keys->size(); ++i) {
+        cache.emplace((*keys)[i], static_cast<unsigned int>(i));
+      }
+      return !cache.empty();
+    } });
+    cases.push_back({ "mem/map std", "100K keys", items(kMapKeys), [keys]() {
+      std::map<std::string, unsigned int> cache;
+      for (size_t i = 0; i < keys->size(); ++i) {
+        cache.emplace((*keys)[i], static_cast<unsigned int>(i));
+      }
+      return !cache.empty();
+    } });
+
+    cases.push_back({ "mem/tagged", "10K allocs", items(kFrameAllocations), [sizes]() {
+      uint64_t live = TaggedHeap::instance().stats(MEMORY_GENERAL).liveAllocations;
+      std::vector<void*> blocks;
+      blocks.reserve(sizes->size());
+      for (uint32_t size : *sizes) {
+        blocks.push_back(TaggedHeap::instance().allocate(size, MEMORY_GENERAL));
+      }
+      for (void* block : blocks) {
+        TaggedHeap::instance().deallocate(block);
+      }
+      return TaggedHeap::instance().stats(MEMORY_GENERAL).liveAllocations == live;
+    } });
+  }
+
+  /**
+   * @class NullLogSink
+   * @brief Destino que solo cuenta lneas: asla el coste del logger del de la E/S.
+   */
+  class
+  NullLogSink : public LogSink {
+  public:
+    void
+    write(LogLevel level, const char* text, size_t length) override {
+      (void)level;
+      (void)text;
+      m_lines.fetch_add(1, std::memory_order_relaxed);
+      m_bytes.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    uint64_t
+    lines() const { return m_lines.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<uint64_t> m_lines{ 0 };
+    std::atomic<uint64_t> m_bytes{ 0 };
+  };
+
+  /**
+   * @brief Registra el coste por llamada del logger en el hilo que registra.
+   *
+   * - log/async: Logger::write con 0, 1 y 3 argumentos sobre un anillo de 4 MB.
+   *   El formato y la escritura ocurren en el hilo del logger; reset() espera
+   *   a que se vace antes de la siguiente iteracin, fuera de la medicin.
+   * - log/wostringstream: el antiguo MESSAGE (wostringstream formateado en el
+   *   hilo que registra), con el mismo destino nulo.
+   */
+  void
+  registerLogCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    (void)options;
+    const size_t kMessages = 10000;
+
+    auto sink = std::make_shared<NullLogSink*>(nullptr);
+    auto prepare = [sink, kMessages](BenchResult& result) {
+      if (!*sink) {
+        auto owned = std::make_unique<NullLogSink>();
+        *sink = owned.get();
+        Logger::instance().clearSinks();
+        Logger::instance().addSink(std::move(owned));
+        Logger::instance().start(4 * 1024 * 1024);
+      }
+      result.items = kMessages;
+      return Logger::instance().isRunning();
+    };
+    auto drain = []() { Logger::instance().flush(); };
+    std::string name = "level";
+
+    cases.push_back({ "log/async 0 args", "10K msgs", prepare, [kMessages]() {
+      uint64_t dropped = Logger::instance().droppedCount();
+      for (size_t i = 0; i < kMessages; ++i) {
+        Logger::instance().write(LOG_LEVEL_INFO, "NaviBench", "log", "Frame done");
+      }
+      return Logger::instance().droppedCount() == dropped;
+    }, drain });
+    cases.push_back({ "log/async 1 arg", "10K msgs", prepare, [kMessages]() {
+      uint64_t dropped = Logger::instance().droppedCount();
+      for (size_t i = 0; i < kMessages; ++i) {
+        Logger::instance().write(LOG_LEVEL_INFO, "NaviBench", "log", "Frame %u done", i);
+      }
+      return Logger::instance().droppedCount() == dropped;
+    }, drain });
+    cases.push_back({ "log/async 3 args", "10K msgs", prepare, [kMessages, name]() {
+      uint64_t dropped = Logger::instance().droppedCount();
+      for (size_t i = 0; i < kMessages; ++i) {
+        Logger::instance().write(LOG_LEVEL_INFO, "NaviBench", "log", "Loaded %s %u in %.3f ms", name, i, 0.25 * i);
+      }
+      return Logger::instance().droppedCount() == dropped;
+    }, drain });
+    cases.push_back({ "log/wostringstream 3 args", "10K msgs", prepare, [sink, kMessages, name]() {
+      for (size_t i = 0; i < kMessages; ++i) {
+        std::wostringstream os_;
+        os_ << "NaviBench" << "::" << "log" << " : " << "[CREATION OF RESOURCE " << ": "
+            << "Loaded " << name.c_str() << " " << i << " in " << 0.25 * i << " ms" << "] \n";
+        std::wstring text = os_.str();
+        (*sink)->write(LOG_LEVEL_INFO, reinterpret_cast<const char*>(text.c_str()), text.size());
+      }
+      return true;
+    } });
+  }
+
+  /**
+   * @brief Registra los ncleos por lotes de SimdMath.h.
+   *
+   * - math/points, math/normals, math/aabbs: 100000 elementos con una matriz de
+   *   mundo (escala, rotacin y traslacin).
+   * - math/matrices: 10000 matrices por una matriz de vista-proyeccin.
+   *
+   * Cada caso se compara antes de medir con una referencia en double (tolerancia
+   * 1e-4); las variantes "scalar" son el bucle directo en float que sustituyen.
+   */
+  void
+  registerMathCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    (void)options;
+    using namespace SimdMath;
+    const size_t kElements = 100000;
+    const size_t kMatrices = 10000;
+    std::string path = simdPath();
+
+    Matrix world = multiply(multiply(scaling(1.5f, 0.5f, 2.0f), rotationRollPitchYaw(0.3f, 1.1f, -0.7f)),
+                            translation(3.0f, -2.0f, 5.0f));
+    Matrix viewProjection = multiply(lookAtLH(set(0.0f, 3.0f, -6.0f, 1.0f), set(0.0f, 1.0f, 0.0f, 1.0f),
+                                              set(0.0f, 1.0f, 0.0f, 0.0f)),
+                                     perspectiveFovLH(0.785398163f, 16.0f / 9.0f, 0.01f, 100.0f));
+    auto m = std::make_shared<Float4x4>();
+    storeFloat4x4(m.get(), world);
+
+    auto points = std::make_shared<std::vector<Float3>>(kElements);
+    auto boxes = std::make_shared<std::vector<Aabb>>(kElements);
+    auto matrices = std::make_shared<std::vector<Matrix>>(kMatrices);
+    uint32_t state = 2024;
+    auto next = [&state]() {
+      state = state * 1664525u + 1013904223u;
+      return static_cast<float>(state >> 8) / 16777216.0f * 20.0f - 10.0f;
+    };
+    for (Float3& point : *points) {
+      point = { next(), next(), next() };
+    }
+    for (Aabb& box : *boxes) {
+      Float3 corner = { next(), next(), next() };
+      box = { corner, { corner.x + std::fabs(next()), corner.y + std::fabs(next()), corner.z + std::fabs(next()) } };
+    }
+    for (Matrix& matrix : *matrices) {
+      matrix = multiply(rotationRollPitchYaw(next(), next(), next()), translation(next(), next(), next()));
+    }
+    auto outPoints = std::make_shared<std::vector<Float3>>(kElements);
+    auto outBoxes = std::make_shared<std::vector<Aabb>>(kElements);
+    auto outMatrices = std::make_shared<std::vector<Matrix>>(kMatrices);
+
+    // La exactitud de cada ncleo frente a una referencia en double se comprueba
+    // en tests/SimdMathTests.cpp; aqu solo se mide.
+    auto items = [](size_t count) {
+      return [count](BenchResult& result) {
+        result.items = count;
+        return true;
+      };
+    };
+    std::string label = sizeLabel(kElements);
+
+    std::function<void()> simdPoints = [world, points, outPoints]() {
+      transformPoints(world, points->data(), outPoints->data(), points->size());
+    };
+    std::function<void()> scalarPoints = [m, points, outPoints]() {
+      for (size_t i = 0; i < points->size(); ++i) {
+        const Float3& p = (*points)[i];
+        Float3& out = (*outPoints)[i];
+        out.x = p.x * m->m[0][0] + p.y * m->m[1][0] + p.z * m->m[2][0] + m->m[3][0];
+        out.y = p.x * m->m[0][1] + p.y * m->m[1][1] + p.z * m->m[2][1] + m->m[3][1];
+        out.z = p.x * m->m[0][2] + p.y * m->m[1][2] + p.z * m->m[2][2] + m->m[3][2];
+      }
+    };
+    cases.push_back({ "math/points " + path, label, items(kElements),
+                      [simdPoints]() { simdPoints(); return true; } });
+    cases.push_back({ "math/points scalar", label, items(kElements),
+                      [scalarPoints]() { scalarPoints(); return true; } });
+
+    std::function<void()> simdNormals = [world, points, outPoints]() {
+      transformNormals(world, points->data(), outPoints->data(), points->size());
+    };
+    std::function<void()> scalarNormals = [m, points, outPoints]() {
+      for (size_t i = 0; i < points->size(); ++i) {
+        const Float3& p = (*points)[i];
+        float x = p.x * m->m[0][0] + p.y * m->m[1][0] + p.z * m->m[2][0];
+        float y = p.x * m->m[0][1] + p.y * m->m[1][1] + p.z * m->m[2][1];
+        float z = p.x * m->m[0][2] + p.y * m->m[1][2] + p.z * m->m[2][2];
+        float length = std::sqrt(x * x + y * y + z * z);
+        float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+        (*outPoints)[i] = { x * inverse, y * inverse, z * inverse };
+      }
+    };
+    cases.push_back({ "math/normals " + path, label, items(kElements),
+                      [simdNormals]() { simdNormals(); return true; } });
+    cases.push_back({ "math/normals scalar", label, items(kElements),
+                      [scalarNormals]() { scalarNormals(); return true; } });
+
+    std::function<void()> simdBoxes = [world, boxes, outBoxes]() {
+      transformAabbs(world, boxes->data(), outBoxes->data(), boxes->size());
+    };
+    std::function<void()> scalarBoxes = [m, boxes, outBoxes]() {
+      for (size_t i = 0; i < boxes->size(); ++i) {
+        const Aabb& box = (*boxes)[i];
+        float center[3] = { (box.min.x + box.max.x) * 0.5f, (box.min.y + box.max.y) * 0.5f,
+                            (box.min.z + box.max.z) * 0.5f };
+        float extent[3] = { (box.max.x - box.min.x) * 0.5f, (box.max.y - box.min.y) * 0.5f,
+                            (box.max.z - box.min.z) * 0.5f };
+        float newCenter[3], newExtent[3];
+        for (int c = 0; c < 3; ++c) {
+          newCenter[c] = center[0] * m->m[0][c] + center[1] * m->m[1][c] + center[2] * m->m[2][c] + m->m[3][c];
+          newExtent[c] = extent[0] * std::fabs(m->m[0][c]) + extent[1] * std::fabs(m->m[1][c]) +
+                         extent[2] * std::fabs(m->m[2][c]);
+        }
+        (*outBoxes)[i] = { { newCenter[0] - newExtent[0], newCenter[1] - newExtent[1], newCenter[2] - newExtent[2] },
+                           { newCenter[0] + newExtent[0], newCenter[1] + newExtent[1], newCenter[2] + newExtent[2] } };
+      }
+    };
+    cases.push_back({ "math/aabbs " + path, label, items(kElements),
+                      [simdBoxes]() { simdBoxes(); return true; } });
+    cases.push_back({ "math/aabbs scalar", label, items(kElements),
+                      [scalarBoxes]() { scalarBoxes(); return true; } });
+
+    std::function<void()> simdMatrices = [matrices, outMatrices, viewProjection]() {
+      multiplyMatrices(matrices->data(), viewProjection, outMatrices->data(), matrices->size());
+    };
+    std::function<void()> scalarMatrices = [matrices, outMatrices, viewProjection]() {
+      Float4x4 b;
+      storeFloat4x4(&b, viewProjection);
+      for (size_t i = 0; i < matrices->size(); ++i) {
+        Float4x4 a, result;
+        storeFloat4x4(&a, (*matrices)[i]);
+        for (int row = 0; row < 4; ++row) {
+          for (int column = 0; column < 4; ++column) {
+            result.m[row][column] = a.m[row][0] * b.m[0][column] + a.m[row][1] * b.m[1][column] +
+                                    a.m[row][2] * b.m[2][column] + a.m[row][3] * b.m[3][column];
+          }
+        }
+        (*outMatrices)[i] = loadFloat4x4(&result);
+      }
+    };
+    cases.push_back({ "math/matrices " + path, sizeLabel(kMatrices),
+                      items(kMatrices),
+                      [simdMatrices]() { simdMatrices(); return true; } });
+    cases.push_back({ "math/matrices scalar", sizeLabel(kMatrices),
+                      items(kMatrices),
+                      [scalarMatrices]() { scalarMatrices(); return true; } });
+  }
+
+  /**
+   * @brief Backend que no crea nada: execute() mide solo el pool y las transiciones.
+   */
+  class
+  NullFrameGraphBackend : public FrameGraphBackend {
+  public:
+    void*
+    createTexture(const FrameGraphTextureDesc& desc, uint32_t accessMask) override {
+      (void)desc;
+      (void)accessMask;
+      return new int(0);
+    }
+
+    void
+    destroyTexture(void* texture) override { delete static_cast<int*>(texture); }
+
+    void
+    barrier(const FrameGraphBarrier& barrier, void* texture) override {
+      (void)barrier;
+      m_barriers += texture ? 1 : 0;
+    }
+
+    uint64_t m_barriers = 0;
+  };
+
+  /**
+   * @brief Construye un frame sinttico de @p passes pases.
+   *
+   * Cada pase crea una textura (tres formatos y dos resoluciones) y lee la
+   * salida del anterior y, a veces, la de tres pases atrs. Uno de cada siete
+   * es una rama de depuracin que nadie lee; el ltimo escribe el back buffer.
+   */
+  void
+  buildSyntheticGraph(FrameGraph& graph, size_t passes, void* backBuffer) {
+    static const uint32_t kFormats[3] = { 10, 28, 45 };
+    FrameGraphTextureDesc backBufferDesc;
+    backBufferDesc.width = 1920;
+    backBufferDesc.height = 1080;
+    backBufferDesc.format = 28;
+
+    graph.reset();
+    FrameGraphHandle back = graph.importTexture("BackBuffer", backBufferDesc, backBuffer,
+                                                FRAME_GRAPH_ACCESS_PRESENT, FRAME_GRAPH_ACCESS_PRESENT);
+    std::vector<FrameGraphHandle> outputs;
+    outputs.reserve(passes);
+    char name[32];
+    for (size_t i = 0; i + 1 < passes; ++i) {
+      bool debug = i % 7 == 6;
+      FrameGraphTextureDesc desc;
+      desc.width = i % 2 ? 960 : 1920;
+      desc.height = i % 2 ? 540 : 1080;
+      desc.format = kFormats[i % 3];
+      FrameGraphAccess access = desc.format == 45 ? FRAME_GRAPH_ACCESS_DEPTH_WRITE
+                                                  : FRAME_GRAPH_ACCESS_RENDER_TARGET;
+      std::snprintf(name, sizeof(name), "Pass%zu", i);
+      FrameGraphHandle output;
+      graph.addPass(name, [&](FrameGraphBuilder& builder) {
+        if (!outputs.empty()) {
+          builder.read(outputs.back());
+        }
+        if (outputs.size() > 3 && i % 3 == 0) {
+          builder.read(outputs[outputs.size() - 3]);
+        }
+        output = builder.write(builder.createTexture(name, desc), access);
+      }, [](FrameGraphPassContext&) {});
+      if (!debug) {
+        outputs.push_back(output);
+      }
+    }
+    graph.addPass("Present", [&](FrameGraphBuilder& builder) {
+      if (!outputs.empty()) {
+        builder.read(outputs.back());
+      }
+      back = builder.write(back);
+    }, [](FrameGraphPassContext&) {});
+  }
+
+  /**
+   * @brief Registra el coste por frame del FrameGraph con 50, 200 y 1000 pases.
+   *
+   * - graph/compile: reset, configuracin de los pases y compile().
+   * - graph/frame: lo mismo ms execute() con un backend nulo (pool y transiciones).
+   *
+   * prepare() muestra cuntos pases se descartan y cunto reduce el aliasing;
+   * la correccin del descarte y del aliasing se prueba en tests/FrameGraphTests.cpp.
+   */
+  void
+  registerGraphCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    (void)options;
+    auto backend = std::make_shared<NullFrameGraphBackend>();
+    static int backBuffer = 0;
+
+    for (size_t passes : { size_t(50), size_t(200), size_t(1000) }) {
+      auto graph = std::make_shared<FrameGraph>();
+      auto prepare = [graph, passes](BenchResult& result) {
+        buildSyntheticGraph(*graph, passes, &backBuffer);
+        std::string error;
+        if (!graph->compile(&error)) {
+          std::fprintf(stderr, "graph: %s\n", error.c_str());
+          return false;
+        }
+        const FrameGraphStats& stats = graph->stats();
+        std::fprintf(stderr, "graph %zu passes: %u culled, %u transient -> %u physical, "
+                     "%.1f MB -> %.1f MB (heap %.1f MB), %u barriers\n",
+                     passes, stats.culledPasses, stats.transientTextures, stats.physicalTextures,
+                     stats.transientBytes / 1048576.0, stats.physicalBytes / 1048576.0,
+                     stats.heapBytes / 1048576.0, stats.barriers);
+        result.items = passes;
+        return true;
+      };
+      cases.push_back({ "graph/compile", sizeLabel(passes) + " passes", prepare, [graph, passes]() {
+        buildSyntheticGraph(*graph, passes, &backBuffer);
+        return graph->compile();
+      } });
+      cases.push_back({ "graph/frame", sizeLabel(passes) + " passes", prepare, [graph, passes, backend]() {
+        buildSyntheticGraph(*graph, passes, &backBuffer);
+        return graph->compile() && graph->execute(*backend);
+      } });
+    }
+  }
+
+  /**
+   * @brief Luces repartidas por el volumen visible desde (0, 3, -10) mirando a +z.
+   *
+   * Un 30 % son focos; los alcances van de 1 a 5 unidades.
+   */
+  std::vector<ClusterLight>
+  syntheticLights(size_t count) {
+    std::vector<ClusterLight> lights(count);
+    uint32_t state = 12345u;
+    auto random = [&state]() {
+      state = state * 1664525u + 1013904223u;
+      return (state >> 8) * (1.0f / 16777216.0f);
+    };
+    for (ClusterLight& light : lights) {
+      float z = random() * 90.0f;
+      light.position = { (random() * 2.0f - 1.0f) * (5.0f + z * 0.45f), random() * 12.0f - 3.0f, z };
+      light.range = 1.0f + random() * 4.0f;
+      light.color = { random(), random(), random() };
+      light.direction = { 0.0f, -1.0f, 0.0f };
+      if (random() < 0.3f) {
+        float dx = random() - 0.5f;
+        float dz = random() - 0.5f;
+        float length = std::sqrt(dx * dx + 1.0f + dz * dz);
+        light.type = CLUSTER_LIGHT_SPOT;
+        light.direction = { dx / length, -1.0f / length, dz / length };
+        light.spotCosine = std::cos(0.2f + random() * 0.8f);
+      }
+    }
+    return lights;
+  }
+
+  /**
+   * @brief Prueba escalar de una luz contra un cluster, con las mismas
+   *        operaciones (y en el mismo orden) que ClusteredLights.
+   */
+  bool
+  lightTouchesCluster(const SimdMath::Aabb& box, const SimdMath::Float3& position,
+                      const SimdMath::Float3& direction, const ClusterLight& light) {
+    auto positive = [](float value) { return value > 0.0f ? value : 0.0f; };
+    float dx = positive(box.min.x - position.x) + positive(position.x - box.max.x);
+    float dy = positive(box.min.y - position.y) + positive(position.y - box.max.y);
+    float dz = positive(box.min.z - position.z) + positive(position.z - box.max.z);
+    float radiusSq = light.range > 0.0f ? light.range * light.range : -1.0f;
+    if (!((dx * dx + dy * dy) + dz * dz <= radiusSq)) {
+      return false;
+    }
+    if (light.type != CLUSTER_LIGHT_SPOT) {
+      return true;
+    }
+    float hx = (box.max.x - box.min.x) * 0.5f;
+    float hy = (box.max.y - box.min.y) * 0.5f;
+    float hz = (box.max.z - box.min.z) * 0.5f;
+    float radius = std::sqrt(hx * hx + hy * hy + hz * hz);
+    float vx = (box.min.x + hx) - position.x;
+    float vy = (box.min.y + hy) - position.y;
+    float vz = (box.min.z + hz) - position.z;
+    float cosine = (std::max)(-1.0f, (std::min)(1.0f, light.spotCosine));
+    float sine = std::sqrt(1.0f - cosine * cosine);
+    float lengthSq = (vx * vx + vy * vy) + vz * vz;
+    float along = (vx * direction.x + vy * direction.y) + vz * direction.z;
+    float across = std::sqrt((std::max)(lengthSq - along * along, 0.0f));
+    float closest = cosine * across - along * sine;
+    return closest <= radius && along <= radius + light.range && -radius <= along;
+  }
+
+  /**
+   * @brief Asignacin de referencia: cada luz contra cada cluster, sin SIMD ni jerarqua.
+   */
+  void
+  assignBruteForce(const ClusteredLights& grid, const std::vector<ClusterLight>& lights,
+                   const SimdMath::Matrix& view, std::vector<ClusterRange>& ranges,
+                   std::vector<uint32_t>& indices) {
+    using namespace SimdMath;
+    std::vector<Float3> positions(lights.size());
+    std::vector<Float3> directions(lights.size());
+    for (size_t i = 0; i < lights.size(); ++i) {
+      storeFloat3(&positions[i], transformPoint(loadFloat3(&lights[i].position), view));
+      storeFloat3(&directions[i], transformNormal(loadFloat3(&lights[i].direction), view));
+    }
+    ranges.resize(grid.clusterCount());
+    indices.clear();
+    for (unsigned int cluster = 0; cluster < grid.clusterCount(); ++cluster) {
+      ranges[cluster].offset = static_cast<uint32_t>(indices.size());
+      for (size_t i = 0; i < lights.size(); ++i) {
+        if (lightTouchesCluster(grid.clusterBounds(cluster), positions[i], directions[i], lights[i])) {
+          indices.push_back(static_cast<uint32_t>(i));
+        }
+      }
+      ranges[cluster].count = static_cast<uint32_t>(indices.size() - ranges[cluster].offset);
+    }
+  }
+
+  /**
+   * @brief Registra la asignacin de 1K, 4K y 16K luces a una rejilla de 16x9x24.
+   *
+   * - lights/assign 1t y Nt: ClusteredLights::assign() con uno y con todos los
+   *   hilos (los cortes de profundidad se reparten con JobSystem).
+   * - lights/brute scalar: cada luz contra cada cluster (solo 1K y 4K).
+   *
+   * prepare() comprueba que assign() produce exactamente las mismas listas que
+   * la referencia; el objetivo es menos de 1 ms con 4K luces.
+   */
+  void
+  registerLightCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    using namespace SimdMath;
+    const Matrix view = lookAtLH(set(0.0f, 3.0f, -10.0f, 1.0f), set(0.0f, 3.0f, 0.0f, 1.0f),
+                                 set(0.0f, 1.0f, 0.0f, 0.0f));
+
+    for (size_t count : { size_t(1024), size_t(4096), size_t(16384) }) {
+      auto lights = std::make_shared<std::vector<ClusterLight>>(syntheticLights(count));
+      auto grid = std::make_shared<ClusteredLights>();
+      grid->init(ClusterGridDesc());
+
+      for (unsigned int threads : { 1u, options.maxThreads }) {
+        auto prepare = [lights, grid, view, threads](BenchResult& result) {
+          if (!restartJobSystem(threads)) {
+            return false;
+          }
+          std::vector<ClusterRange> ranges;
+          std::vector<uint32_t> indices;
+          assignBruteForce(*grid, *lights, view, ranges, indices);
+          grid->assign(lights->data(), lights->size(), view);
+          for (unsigned int cluster = 0; cluster < grid->clusterCount(); ++cluster) {
+            const ClusterRange& expected = ranges[cluster];
+            const ClusterRange& actual = grid->ranges()[cluster];
+            if (expected.count != actual.count ||
+                !std::equal(indices.begin() + expected.offset, indices.begin() + expected.offset + expected.count,
+                            grid->lightIndices().begin() + actual.offset)) {
+              std::fprintf(stderr, "lights: cluster %u differs from the reference\n", cluster);
+              return false;
+            }
+          }
+          const ClusterStats& stats = grid->stats();
+          std::fprintf(stderr, "lights %zu: %zu indices, %u/%u clusters occupied, max %u per cluster\n",
+                       lights->size(), stats.lightIndices, stats.occupiedClusters, grid->clusterCount(),
+                       stats.maxLightsPerCluster);
+          result.threads = threads;
+          result.items = lights->size();
+          return stats.droppedIndices == 0;
+        };
+        cases.push_back({ "lights/assign " + std::to_string(threads) + "t", sizeLabel(count), prepare,
+                          [lights, grid, view, threads]() {
+          grid->assign(lights->data(), lights->size(), view, threads > 1);
+          return grid->stats().lightIndices > 0;
+        } });
+        if (threads == options.maxThreads) {
+          break;
+        }
+      }
+
+      if (count <= 4096) {
+        auto ranges = std::make_shared<std::vector<ClusterRange>>();
+        auto indices = std::make_shared<std::vector<uint32_t>>();
+        cases.push_back({ "lights/brute scalar", sizeLabel(count), [lights](BenchResult& result) {
+          result.items = lights->size();
+          return true;
+        }, [lights, grid, view, ranges, indices]() {
+          assignBruteForce(*grid, *lights, view, *ranges, *indices);
+          return !indices->empty();
+        } });
+      }
+    }
+  }
+
+  /**
+   * @struct SkinScene
+   * @brief Personajes sintticos: un esqueleto de 64 articulaciones, una malla
+   *        compartida y, por personaje, su pose, sus matrices y su salida.
+   */
+  struct
+  SkinScene {
+    Skeleton skeleton;
+    std::vector<SkinnedVertex> vertices;
+    std::vector<std::vector<JointPose>> poses;
+    std::vector<std::vector<SimdMath::Matrix>> model;
+    std::vector<std::vector<SimdMath::Matrix>> skin;
+    std::vector<std::vector<DualQuaternion>> dualQuaternions;
+    std::vector<std::vector<SkinnedOutputVertex>> output;
+    std::vector<SkinningJob> jobs;
+
+    void
+    evaluatePoses() {
+      for (size_t c = 0; c < poses.size(); ++c) {
+        skeleton.localToModel(poses[c].data(), model[c].data());
+        skeleton.skinningMatrices(model[c].data(), skin[c].data());
+        toDualQuaternions(skin[c].data(), dualQuaternions[c].data(), skeleton.jointCount());
+      }
+    }
+  };
+
+  /**
+   * @brief Cuatro cadenas de 16 articulaciones desde una raz; cada vrtice
+   *        depende de 1 a 4 articulaciones vecinas (una de cada cuatro es rgida).
+   */
+  std::shared_ptr<SkinScene>
+  syntheticSkinScene(size_t characters, size_t verticesPerCharacter) {
+    using namespace SimdMath;
+    const int kJoints = 64;
+    auto scene = std::make_shared<SkinScene>();
+    uint32_t state = 777u;
+    auto random = [&state]() {
+      state = state * 1664525u + 1013904223u;
+      return (state >> 8) * (1.0f / 16777216.0f);
+    };
+    auto randomRotation = [&random](float amount) {
+      Float4 q;
+      storeFloat4(&q, quaternionRotationAxis(normalize3(set(random() - 0.5f, random() - 0.5f, random() - 0.5f, 0.0f)),
+                                             (random() - 0.5f) * amount));
+      return q;
+    };
+
+    std::vector<int> parents(kJoints);
+    std::vector<JointPose> rest(kJoints);
+    for (int j = 0; j < kJoints; ++j) {
+      parents[j] = j == 0 ? -1 : (j <= 4 ? 0 : j - 4);
+      rest[j].translation = j == 0 ? Float3{ 0.0f, 1.0f, 0.0f } : Float3{ 0.0f, 0.12f, 0.0f };
+      rest[j].rotation = j <= 4 ? randomRotation(2.0f) : randomRotation(0.3f);
+    }
+    scene->skeleton.init(parents.data(), rest.data(), kJoints);
+
+    std::vector<Matrix> restModel(kJoints);
+    scene->skeleton.localToModel(rest.data(), restModel.data());
+    scene->vertices.resize(verticesPerCharacter);
+    for (size_t v = 0; v < verticesPerCharacter; ++v) {
+      SkinnedVertex& vertex = scene->vertices[v];
+      int joint = static_cast<int>(random() * kJoints) % kJoints;
+      Vector position = add(restModel[joint].r[3], set(random() * 0.2f - 0.1f, random() * 0.2f - 0.1f,
+                                                       random() * 0.2f - 0.1f, 0.0f));
+      storeFloat3(&vertex.position, position);
+      storeFloat3(&vertex.normal, normalize3(set(random() - 0.5f, random() - 0.5f, random() - 0.5f, 0.0f)));
+      vertex.texCoord = { random(), random() };
+      int neighbours[kSkinInfluences] = { joint, parents[joint] < 0 ? joint : parents[joint],
+                                          joint + 4 < kJoints ? joint + 4 : joint, joint == 0 ? 1 : joint - 1 };
+      bool rigid = v % 4 == 0;
+      float total = 0.0f;
+      for (unsigned int k = 0; k < kSkinInfluences; ++k) {
+        vertex.joints[k] = static_cast<uint8_t>(neighbours[k]);
+        vertex.weights[k] = rigid ? (k == 0 ? 1.0f : 0.0f) : random();
+        total += vertex.weights[k];
+      }
+      for (float& weight : vertex.weights) {
+        weight /= total;
+      }
+    }
+
+    scene->poses.resize(characters);
+    scene->model.assign(characters, std::vector<Matrix>(kJoints));
+    scene->skin.assign(characters, std::vector<Matrix>(kJoints));
+    scene->dualQuaternions.assign(characters, std::vector<DualQuaternion>(kJoints));
+    scene->output.assign(characters, std::vector<SkinnedOutputVertex>(verticesPerCharacter));
+    scene->jobs.resize(characters);
+    for (size_t c = 0; c < characters; ++c) {
+      scene->poses[c] = rest;
+      for (JointPose& pose : scene->poses[c]) {
+        Float4 bend = randomRotation(0.8f);
+        storeFloat4(&pose.rotation, quaternionMultiply(loadFloat4(&pose.rotation), loadFloat4(&bend)));
+      }
+      SkinningJob& job = scene->jobs[c];
+      job.vertices = scene->vertices.data();
+      job.output = scene->output[c].data();
+      job.count = verticesPerCharacter;
+      job.matrices = scene->skin[c].data();
+      job.dualQuaternions = scene->dualQuaternions[c].data();
+    }
+    scene->evaluatePoses();
+    return scene;
+  }
+
+  /**
+   * @brief Comprueba el skinning lineal contra una referencia en double y, en
+   *        los vrtices rgidos, que los cuaterniones duales dan el mismo resultado.
+   */
+  bool
+  verifySkinning(SkinScene& scene) {
+    using namespace SimdMath;
+    const double kTolerance = 1e-4;
+    const SkinningJob& job = scene.jobs[0];
+    std::vector<SkinnedOutputVertex> linear(job.count);
+    std::vector<SkinnedOutputVertex> dual(job.count);
+    skinLinear(job.matrices, job.vertices, linear.data(), job.count);
+    skinDualQuaternion(job.dualQuaternions, job.vertices, dual.data(), job.count);
+
+    double worst = 0.0;
+    for (size_t v = 0; v < job.count; ++v) {
+      const SkinnedVertex& vertex = job.vertices[v];
+      double position[3] = { 0.0, 0.0, 0.0 };
+      for (unsigned int k = 0; k < kSkinInfluences; ++k) {
+        Float4x4 m;
+        storeFloat4x4(&m, job.matrices[vertex.joints[k]]);
+        const double input[4] = { vertex.position.x, vertex.position.y, vertex.position.z, 1.0 };
+        for (int column = 0; column < 3; ++column) {
+          for (int row = 0; row < 4; ++row) {
+            position[column] += vertex.weights[k] * input[row] * m.m[row][column];
+          }
+        }
+      }
+      const SkinnedOutputVertex& out = linear[v];
+      worst = (std::max)(worst, std::fabs(position[0] - out.position.x) + std::fabs(position[1] - out.position.y) +
+                                std::fabs(position[2] - out.position.z));
+      if (vertex.weights[0] == 1.0f) {
+        worst = (std::max)(worst, 0.0 + std::fabs(out.position.x - dual[v].position.x) +
+                                        std::fabs(out.position.y - dual[v].position.y) +
+                                        std::fabs(out.position.z - dual[v].position.z) +
+                                        std::fabs(out.normal.x - dual[v].normal.x));
+      }
+    }
+    if (worst > kTolerance) {
+      std::fprintf(stderr, "skin: max error %g exceeds %g\n", worst, kTolerance);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Registra el skinning de 16 y 128 personajes de 8K vrtices y la
+   *        evaluacin de sus poses.
+   *
+   * - skin/linear y skin/dual quat 1t y Nt: skinMeshes() con uno y con todos
+   *   los hilos. items son vrtices: items_per_s / threads da los vrtices
+   *   por segundo y ncleo.
+   * - skin/pose: localToModel(), skinningMatrices() y toDualQuaternions() de
+   *   todos los personajes; items son articulaciones.
+   */
+  void
+  registerSkinCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    const size_t kVerticesPerCharacter = 8192;
+    for (size_t characters : { size_t(16), size_t(128) }) {
+      auto scene = syntheticSkinScene(characters, kVerticesPerCharacter);
+      std::string size = sizeLabel(characters * kVerticesPerCharacter);
+
+      for (SkinningMethod method : { SKINNING_LINEAR, SKINNING_DUAL_QUATERNION }) {
+        for (unsigned int threads : { 1u, options.maxThreads }) {
+          std::string name = method == SKINNING_LINEAR ? "skin/linear " : "skin/dual quat ";
+          cases.push_back({ name + std::to_string(threads) + "t", size, [scene, method, threads](BenchResult& result) {
+            if (!restartJobSystem(threads) || !verifySkinning(*scene)) {
+              return false;
+            }
+            for (SkinningJob& job : scene->jobs) {
+              job.method = method;
+            }
+            result.threads = threads;
+            result.items = scene->jobs.size() * scene->vertices.size();
+            result.bytes = result.items * (sizeof(SkinnedVertex) + sizeof(SkinnedOutputVertex));
+            return true;
+          }, [scene, threads]() {
+            skinMeshes(scene->jobs.data(), scene->jobs.size(), threads > 1);
+            return true;
+          } });
+          if (threads == options.maxThreads) {
+            break;
+          }
+        }
+      }
+
+      cases.push_back({ "skin/pose", sizeLabel(characters * scene->skeleton.jointCount()),
+                        [scene](BenchResult& result) {
+        result.items = scene->poses.size() * scene->skeleton.jointCount();
+        return true;
+      }, [scene]() {
+        scene->evaluatePoses();
+        return true;
+      } });
+    }
+  }
+
+  /**
+   * @brief Dos clips de 64 articulaciones (caminar y correr, 10 s a 30 fps) y
+   *        el estado de reproduccin de muchos personajes.
+   */
+  struct
+  AnimScene {
+    RawAnimationClip raw[2];
+    AnimationClip clips[2];
+    std::vector<float> times;          /**< Tiempo de cada personaje. */
+    std::vector<ClipCursor> cursors[2];
+    std::vector<SoaPose> poses[2];
+    std::vector<SoaPose> blended;
+    std::vector<std::vector<JointPose>> rawPoses;
+  };
+
+  /**
+   * @brief Pose sinttica: cada articulacin oscila alrededor de su reposo con
+   *        su propia fase; la raz avanza y sube y baja. La mitad de los
+   *        dedos (articulaciones 48 a 63) no se mueve, como en clips reales.
+   */
+  RawAnimationClip
+  syntheticClip(float frequency, float amplitude, uint32_t seed) {
+    using namespace SimdMath;
+    const size_t kJoints = 64;
+    const size_t kFrames = 301;
+    RawAnimationClip clip;
+    clip.sampleRate = 30.0f;
+    clip.jointCount = kJoints;
+    clip.frameCount = kFrames;
+    clip.poses.resize(kJoints * kFrames);
+
+    uint32_t state = seed;
+    auto random = [&state]() {
+      state = state * 1664525u + 1013904223u;
+      return (state >> 8) * (1.0f / 16777216.0f);
+    };
+    std::vector<Float3> axes(kJoints);
+    std::vector<float> phases(kJoints);
+    std::vector<Float4> rest(kJoints);
+    for (size_t j = 0; j < kJoints; ++j) {
+      storeFloat3(&axes[j], normalize3(set(random() - 0.5f, random() - 0.5f, random() - 0.5f, 0.0f)));
+      phases[j] = random() * 6.2831853f;
+      storeFloat4(&rest[j], quaternionRotationAxis(
+        normalize3(set(random() - 0.5f, random() - 0.5f, random() - 0.5f, 0.0f)), random() * 3.0f));
+    }
+    for (size_t frame = 0; frame < kFrames; ++frame) {
+      float time = frame / clip.sampleRate;
+      for (size_t j = 0; j < kJoints; ++j) {
+        JointPose& pose = clip.poses[frame * kJoints + j];
+        float angle = j >= 48 ? 0.0f
+                              : amplitude * (std::sin(time * frequency * 6.2831853f + phases[j]) +
+                                             0.3f * std::sin(time * frequency * 12.566371f + 2.0f * phases[j]));
+        storeFloat4(&pose.rotation, quaternionMultiply(loadFloat4(&rest[j]), quaternionRotationAxis(loadFloat3(&axes[j]), angle)));
+        pose.translation = j == 0 ? Float3{ 0.0f, 1.0f + 0.05f * std::sin(time * frequency * 12.566371f), time * frequency }
+                                  : Float3{ 0.0f, 0.12f, 0.0f };
+      }
+    }
+    return clip;
+  }
+
+  /**
+   * @brief Muestrea todos los frames de @p clip y comprueba que ningn valor se
+   *        aleja de @p raw ms que la tolerancia de su pista.
+   */
+  bool
+  verifyClip(const AnimationClip& clip, const RawAnimationClip& raw, const ClipCompressionSettings& settings) {
+    const float kSlack = 1e-5f;   // Redondeo del tiempo a frame y de la descuantizacin.
+    const float tolerances[CLIP_TRACK_KIND_COUNT] = {
+      settings.rotationTolerance, settings.translationTolerance, settings.scaleTolerance
+    };
+    ClipCursor cursor;
+    SoaPose pose;
+    float worst[CLIP_TRACK_KIND_COUNT] = { 0.0f, 0.0f, 0.0f };
+    for (size_t frame = 0; frame < raw.frameCount; ++frame) {
+      clip.sample(frame / raw.sampleRate, cursor, pose);
+      for (size_t j = 0; j < raw.jointCount; ++j) {
+        const JointPose& expected = raw.poses[frame * raw.jointCount + j];
+        const float rotation[4] = { expected.rotation.x, expected.rotation.y, expected.rotation.z, expected.rotation.w };
+        const float translation[3] = { expected.translation.x, expected.translation.y, expected.translation.z };
+        const float scale[3] = { expected.scale.x, expected.scale.y, expected.scale.z };
+        float dot = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+          dot += rotation[c] * pose.rotation[c][j];
+        }
+        for (int c = 0; c < 4; ++c) {
+          worst[0] = (std::max)(worst[0], std::fabs((dot < 0.0f ? -rotation[c] : rotation[c]) - pose.rotation[c][j]));
+        }
+        for (int c = 0; c < 3; ++c) {
+          worst[1] = (std::max)(worst[1], std::fabs(translation[c] - pose.translation[c][j]));
+          worst[2] = (std::max)(worst[2], std::fabs(scale[c] - pose.scale[c][j]));
+        }
+      }
+    }
+    for (unsigned int kind = 0; kind < CLIP_TRACK_KIND_COUNT; ++kind) {
+      if (worst[kind] > tolerances[kind] + kSlack) {
+        std::fprintf(stderr, "anim: track kind %u error %g exceeds %g\n", kind, worst[kind], tolerances[kind]);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Muestreo de referencia sin comprimir: interpolacin lineal de los
+   *        floats originales, AoS, con nlerp por el camino corto.
+   */
+  void
+  sampleRaw(const RawAnimationClip& raw, float time, JointPose* output) {
+    using namespace SimdMath;
+    float frame = (std::min)(static_cast<float>(raw.frameCount - 1), (std::max)(0.0f, time * raw.sampleRate));
+    size_t first = static_cast<size_t>(frame);
+    size_t second = (std::min)(first + 1, raw.frameCount - 1);
+    float alpha = frame - first;
+    const JointPose* from = &raw.poses[first * raw.jointCount];
+    const JointPose* to = &raw.poses[second * raw.jointCount];
+    for (size_t j = 0; j < raw.jointCount; ++j) {
+      storeFloat4(&output[j].rotation,
+                  quaternionNlerp(loadFloat4(&from[j].rotation), loadFloat4(&to[j].rotation), alpha));
+      storeFloat3(&output[j].translation,
+                  lerp(loadFloat3(&from[j].translation), loadFloat3(&to[j].translation), alpha));
+      storeFloat3(&output[j].scale, lerp(loadFloat3(&from[j].scale), loadFloat3(&to[j].scale), alpha));
+    }
+  }
+
+  /**
+   * @brief Registra la compresin de clips y su muestreo para 256 personajes.
+   *
+   * - anim/compress: AnimationClip::compress() de los dos clips. El prepare
+   *   comprueba la cota de error en todos los frames e imprime el tamao y las
+   *   claves conservadas. items son claves originales.
+   * - anim/sample, anim/sample+blend y anim/raw lerp: avanzan 1/60 s a cada
+   *   personaje y muestrean un clip, dos clips y su mezcla, o los floats sin
+   *   comprimir. items son articulaciones.
+   */
+  void
+  registerAnimCases(const BenchOptions& options, std::vector<BenchCase>& cases) {
+    (void)options;
+    const size_t kCharacters = 256;
+    const float kStep = 1.0f / 60.0f;
+    const ClipCompressionSettings settings;
+    auto scene = std::make_shared<AnimScene>();
+    scene->raw[0] = syntheticClip(1.0f, 0.6f, 11u);
+    scene->raw[1] = syntheticClip(1.6f, 0.9f, 23u);
+    scene->times.resize(kCharacters);
+    for (size_t c = 0; c < kCharacters; ++c) {
+      scene->times[c] = c * 0.037f;
+    }
+    for (int k = 0; k < 2; ++k) {
+      scene->cursors[k].resize(kCharacters);
+      scene->poses[k].resize(kCharacters);
+    }
+    scene->blended.resize(kCharacters);
+    scene->rawPoses.assign(kCharacters, std::vector<JointPose>(scene->raw[0].jointCount));
+    size_t joints = scene->raw[0].jointCount;
+    size_t rawKeys = 2 * scene->raw[0].frameCount * joints * CLIP_TRACK_KIND_COUNT;
+
+    cases.push_back({ "anim/compress", sizeLabel(rawKeys), [scene, settings](BenchResult& result) {
+      ClipCompressionStats stats[2];
+      std::string error;
+      for (int k = 0; k < 2; ++k) {
+        if (!scene->clips[k].compress(scene->raw[k], settings, &stats[k], &error)) {
+          std::fprintf(stderr, "anim: %s\n", error.c_str());
+          return false;
+        }
+        if (!verifyClip(scene->clips[k], scene->raw[k], settings)) {
+          return false;
+        }
+        std::fprintf(stderr, "anim clip %d: %zu -> %zu bytes (%.1fx), %zu/%zu keys, max error %.5f %.5f %.5f\n",
+                     k, stats[k].rawBytes, stats[k].compressedBytes,
+                     static_cast<double>(stats[k].rawBytes) / stats[k].compressedBytes, stats[k].keys,
+                     stats[k].rawKeys, stats[k].maxError[0], stats[k].maxError[1], stats[k].maxError[2]);
+        result.bytes += stats[k].rawBytes;
+        result.items += stats[k].rawKeys;
+      }
+      return true;
+    }, [scene, settings]() {
+      for (int k = 0; k < 2; ++k) {
+        scene->clips[k].compress(scene->raw[k], settings);
+      }
+      return true;
+    } });
+
+    auto prepareClips = [scene, settings]() {
+      for (int k = 0; k < 2; ++k) {
+        if (scene->clips[k].jointCount() == 0 && !scene->clips[k].compress(scene->raw[k], settings)) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    cases.push_back({ "anim/sample", sizeLabel(kCharacters * joints),
+                      [scene, prepareClips, joints](BenchResult& result) {
+      result.items = scene->times.size() * joints;
+      return prepareClips();
+    }, [scene, kStep]() {
+      const AnimationClip& clip = scene->clips[0];
+      for (size_t c = 0; c < scene->times.size(); ++c) {
+        scene->times[c] = std::fmod(scene->times[c] + kStep, clip.duration());
+        clip.sample(scene->times[c], scene->cursors[0][c], scene->poses[0][c]);
+      }
+      return true;
+    } });
+
+    cases.push_back({ "anim/sample+blend", sizeLabel(kCharacters * joints),
+                      [scene, prepareClips, joints](BenchResult& result) {
+      result.items = scene->times.size() * joints;
+      return prepareClips();
+    }, [scene, kStep]() {
+      const float weights[2] = { 0.7f, 0.3f };
+      for (size_t c = 0; c < scene->times.size(); ++c) {
+        scene->times[c] = std::fmod(scene->times[c] + kStep, scene->clips[0].duration());
+        // Los dos clips en fase: el mismo tiempo normalizado.
+        float phase = scene->times[c] / scene->clips[0].duration();
+        for (int k = 0; k < 2; ++k) {
+          scene->clips[k].sample(phase * scene->clips[k].duration(), scene->cursors[k][c], scene->poses[k][c]);
+        }
+        const SoaPose* poses[2] = { &scene->poses[0][c], &scene->poses[1][c] };
+        blendPoses(poses, weights, 2, scene->blended[c]);
+      }
+      return true;
+    } });
+
+    cases.push_back({ "anim/raw lerp", sizeLabel(kCharacters * joints), [scene, joints](BenchResult& result) {
+      result.items = scene->times.size() * joints;
+      return true;
+    }, [scene, kStep]() {
+      const RawAnimationClip& raw = scene->raw[0];
+      float duration = (raw.frameCount - 1) / raw.sampleRate;
+      for (size_t c = 0; c < scene->times.size(); ++c) {
+        scene->times[c] = std::fmod(scene->times[c] + kStep, duration);
+        sampleRaw(raw, scene->times[c], scene->rawPoses[c].data());
+      }
+      return true;
+    } });
+  }
+}
+
+int
+main(int argc, char** argv) {
+  BenchOptions options;
+  if (!parseArguments(argc, argv, options)) {
+    return 2;
+  }
+
+  std::vector<BenchCase> cases;
+  registerObjCases(options, cases);
+  registerImageCases(options, cases);
+  registerJobCases(options, cases);
+  registerMipCases(options, cases);
+  registerBlockCases(options, cases);
+  registerAtlasCases(options, cases);
+  registerChannelCases(options, cases);
+  registerLzCases(options, cases);
+  registerVfsCases(options, cases);
+  registerMemoryCases(options, cases);
+  registerLogCases(options, cases);
+  registerMathCases(options, cases);
+  registerGraphCases(options, cases);
+  registerLightCases(options, cases);
+  registerSkinCases(options, cases);
+  registerAnimCases(options, cases);
+
+  std::vector<const BenchCase*> selected;
+  for (const BenchCase& bench : cases) {
+    std::string fullName = bench.name + "/" + bench.size;
+    if (options.filter.empty() || fullName.find(options.filter) != std::string::npos) {
+      selected.push_back(&bench);
+    }
+  }
+
+  if (options.listOnly) {
+    for (const BenchCase* bench : selected) {
+      std::printf("%s/%s\n", bench->name.c_str(), bench->size.c_str());
+    }
+    return 0;
+  }
+
+  mkdir(options.assetDir.c_str(), 0755);
+
+  std::vector<BenchResult> results;
+  bool allOk = true;
+  for (const BenchCase* bench : selected) {
+    BenchResult result;
+    result.name = bench->name;
+    result.size = bench->size;
+    if (!bench->prepare(result)) {
+      std::fprintf(stderr, "%s/%s: failed to prepare assets\n", bench->name.c_str(), bench->size.c_str());
+      result.ok = false;
+    }
+    else {
+      measure(options, *bench, result);
+    }
+    std::fprintf(stderr, "%-28s %-10s %6u it  median %10.3f ms  %8.1f MB/s\n",
+                 result.name.c_str(), result.size.c_str(), result.iterations,
+                 result.medianSeconds * 1000.0,
+                 result.medianSeconds > 0.0 ? result.bytes / result.medianSeconds / 1e6 : 0.0);
+    allOk = allOk && result.ok;
+    results.push_back(result);
+  }
+  JobSystem::instance().destroy();
+
+  FILE* out = stdout;
+  if (!options.outFile.empty()) {
+    out = std::fopen(options.outFile.c_str(), "w");
+    if (!out) {
+      std::fprintf(stderr, "cannot open %s\n", options.outFile.c_str());
+      return 1;
+    }
+  }
+  writeJson(out, results);
+  if (out != stdout) {
+    std::fclose(out);
+  }
+  return allOk ? 0 : 1;
+}
@@ -0,0 +1,729 @@
+#include "SyntheticAssets.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+  /**
+   * @brief Generador xorshift32: rpido y estable entre compiladores.
+   */
+  class
+  Random {
+  public:
+    explicit Random(uint32_t seed) : m_state(seed ? seed : 0x9E3779B9u) {}
+
+    uint32_t
+    next() {
+      m_state ^= m_state << 13;
+      m_state ^= m_state >> 17;
+      m_state ^= m_state << 5;
+      return m_state;
+    }
+
+  private:
+    uint32_t m_state;
+  };
+
+  //
+  // Utilidades de escritura big-endian / CRC / Adler para PNG.
+  //
+  void
+  putU16BE(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+  }
+
+  void
+  putU32BE(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+  }
+
+  uint32_t
+  crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+      for (uint32_t n = 0; n < 256; ++n) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; ++k) {
+          c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[n] = c;
+      }
+      ready = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+      crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+  }
+
+  uint32_t
+  adler32(const uint8_t* data, size_t size) {
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+      size_t block = std::min<size_t>(size, 5552);
+      size -= block;
+      while (block--) {
+        a += *data++;
+        b += a;
+      }
+      a %= 65521;
+      b %= 65521;
+    }
+    return (b << 16) | a;
+  }
+
+  void
+  writeChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    putU32BE(out, static_cast<uint32_t>(data.size()));
+    size_t typeStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putU32BE(out, crc32(out.data() + typeStart, out.size() - typeStart));
+  }
+
+  /**
+   * @class BitWriter
+   * @brief Escritor de bits LSB-primero (orden de deflate).
+   */
+  class
+  BitWriter {
+  public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void
+    write(uint32_t bits, unsigned int count) {
+      m_buffer |= static_cast<uint64_t>(bits) << m_count;
+      m_count += count;
+      while (m_count >= 8) {
+        m_out.push_back(static_cast<uint8_t>(m_buffer));
+        m_buffer >>= 8;
+        m_count -= 8;
+      }
+    }
+
+    /**
+     * @brief Escribe un cdigo Huffman (se emite con el bit ms significativo primero).
+     */
+    void
+    writeCode(uint32_t code, unsigned int length) {
+      uint32_t reversed = 0;
+      for (unsigned int i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+      }
+      write(reversed, length);
+    }
+
+    void
+    flush() {
+      if (m_count > 0) {
+        m_out.push_back(static_cast<uint8_t>(m_buffer));
+      }
+      m_buffer = 0;
+      m_count = 0;
+    }
+
+  private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_buffer = 0;
+    unsigned int m_count = 0;
+  };
+
+  const uint16_t kLengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+  const uint8_t kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+  const uint16_t kDistanceBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+  const uint8_t kDistanceExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+  void
+  writeFixedLiteral(BitWriter& bits, unsigned int symbol) {
+    if (symbol < 144) {
+      bits.writeCode(0x30 + symbol, 8);
+    }
+    else if (symbol < 256) {
+      bits.writeCode(0x190 + (symbol - 144), 9);
+    }
+    else if (symbol < 280) {
+      bits.writeCode(symbol - 256, 7);
+    }
+    else {
+      bits.writeCode(0xC0 + (symbol - 280), 8);
+    }
+  }
+
+  /**
+   * @brief Comprime con deflate (un bloque de Huffman fijo, LZ77 con tabla hash de 3 bytes).
+   */
+  std::vector<uint8_t>
+  zlibCompress(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> out;
+    out.push_back(0x78);
+    out.push_back(0x01);
+
+    BitWriter bits(out);
+    bits.write(1, 1); // BFINAL
+    bits.write(1, 2); // BTYPE = 01 (Huffman fijo)
+
+    const size_t kWindow = 32768;
+    const unsigned int kHashBits = 15;
+    std::vector<int64_t> head(size_t(1) << kHashBits, -1);
+    const size_t size = data.size();
+
+    size_t pos = 0;
+    while (pos < size) {
+      size_t bestLength = 0;
+      size_t bestDistance = 0;
+      if (pos + 3 <= size) {
+        uint32_t h = (data[pos] << 16) | (data[pos + 1] << 8) | data[pos + 2];
+        h = (h * 2654435761u) >> (32 - kHashBits);
+        int64_t candidate = head[h];
+        head[h] = static_cast<int64_t>(pos);
+        if (candidate >= 0 && pos - static_cast<size_t>(candidate) <= kWindow) {
+          size_t maxLength = std::min<size_t>(258, size - pos);
+          size_t length = 0;
+          while (length < maxLength && data[candidate + length] == data[pos + length]) {
+            ++length;
+          }
+          if (length >= 3) {
+            bestLength = length;
+            bestDistance = pos - static_cast<size_t>(candidate);
+          }
+        }
+      }
+
+      if (bestLength == 0) {
+        writeFixedLiteral(bits, data[pos]);
+        ++pos;
+        continue;
+      }
+
+      unsigned int lengthCode = 28;
+      while (kLengthBase[lengthCode] > bestLength) --lengthCode;
+      writeFixedLiteral(bits, 257 + lengthCode);
+      bits.write(static_cast<uint32_t>(bestLength - kLengthBase[lengthCode]), kLengthExtra[lengthCode]);
+
+      unsigned int distanceCode = 29;
+      while (kDistanceBase[distanceCode] > bestDistance) --distanceCode;
+      bits.writeCode(distanceCode, 5);
+      bits.write(static_cast<uint32_t>(bestDistance - kDistanceBase[distanceCode]), kDistanceExtra[distanceCode]);
+
+      // Se registran en la tabla hash algunas posiciones internas del match.
+      size_t end = pos + bestLength;
+      for (size_t p = pos + 1; p < end && p + 3 <= size; p += 2) {
+        uint32_t h = (data[p] << 16) | (data[p + 1] << 8) | data[p + 2];
+        head[(h * 2654435761u) >> (32 - kHashBits)] = static_cast<int64_t>(p);
+      }
+      pos = end;
+    }
+    writeFixedLiteral(bits, 256);
+    bits.flush();
+
+    putU32BE(out, adler32(data.data(), data.size()));
+    return out;
+  }
+
+  uint8_t
+  paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return static_cast<uint8_t>(a);
+    if (pb <= pc) return static_cast<uint8_t>(b);
+    return static_cast<uint8_t>(c);
+  }
+
+  //
+  // Tablas del JPEG baseline (ITU T.81, anexo K).
+  //
+  const uint8_t kZigZag[64] = {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63 };
+
+  const uint8_t kLumaQuant[64] = {
+    16, 11, 10, 16, 24, 40, 51, 61,
+    12, 12, 14, 19, 26, 58, 60, 55,
+    14, 13, 16, 24, 40, 57, 69, 56,
+    14, 17, 22, 29, 51, 87, 80, 62,
+    18, 22, 37, 56, 68, 109, 103, 77,
+    24, 35, 55, 64, 81, 104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101,
+    72, 92, 95, 98, 112, 100, 103, 99 };
+
+  const uint8_t kChromaQuant[64] = {
+    17, 18, 24, 47, 99, 99, 99, 99,
+    18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99,
+    47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99 };
+
+  const uint8_t kDcLumaBits[16] = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+  const uint8_t kDcChromaBits[16] = { 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 };
+  const uint8_t kDcValues[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+  const uint8_t kAcLumaBits[16] = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D };
+  const uint8_t kAcLumaValues[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+    0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5,
+    0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+    0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA };
+
+  const uint8_t kAcChromaBits[16] = { 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77 };
+  const uint8_t kAcChromaValues[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+    0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26,
+    0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+    0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+    0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+    0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA };
+
+  /**
+   * @struct HuffmanTable
+   * @brief Cdigos cannicos indexados por smbolo.
+   */
+  struct
+  HuffmanTable {
+    uint16_t code[256] = {};
+    uint8_t length[256] = {};
+  };
+
+  HuffmanTable
+  buildHuffman(const uint8_t bits[16], const uint8_t* values) {
+    HuffmanTable table;
+    uint16_t code = 0;
+    int k = 0;
+    for (int len = 1; len <= 16; ++len) {
+      for (int i = 0; i < bits[len - 1]; ++i) {
+        table.code[values[k]] = code++;
+        table.length[values[k]] = static_cast<uint8_t>(len);
+        ++k;
+      }
+      code <<= 1;
+    }
+    return table;
+  }
+
+  /**
+   * @class JpegBitWriter
+   * @brief Escritor de bits MSB-primero con relleno de bytes 0xFF.
+   */
+  class
+  JpegBitWriter {
+  public:
+    explicit JpegBitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void
+    write(uint32_t bits, unsigned int count) {
+      m_buffer = (m_buffer << count) | (bits & ((1u << count) - 1));
+      m_count += count;
+      while (m_count >= 8) {
+        uint8_t byte = static_cast<uint8_t>(m_buffer >> (m_count - 8));
+        m_out.push_back(byte);
+        if (byte == 0xFF) {
+          m_out.push_back(0x00);
+        }
+        m_count -= 8;
+      }
+    }
+
+    void
+    flush() {
+      if (m_count > 0) {
+        write(0x7F, 8 - m_count);
+      }
+    }
+
+  private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_buffer = 0;
+    unsigned int m_count = 0;
+  };
+
+  void
+  encodeBlock(JpegBitWriter& bits,
+              const float block[64],
+              const float quant[64],
+              int& previousDc,
+              const HuffmanTable& dc,
+              const HuffmanTable& ac) {
+    static float cosTable[8][8];
+    static bool ready = false;
+    if (!ready) {
+      for (int x = 0; x < 8; ++x) {
+        for (int u = 0; u < 8; ++u) {
+          float c = (u == 0) ? std::sqrt(0.125f) : 0.5f;
+          cosTable[x][u] = c * std::cos((2.0f * x + 1.0f) * u * 3.14159265358979f / 16.0f);
+        }
+      }
+      ready = true;
+    }
+
+    // DCT separable: filas y luego columnas.
+    float temp[64];
+    for (int y = 0; y < 8; ++y) {
+      for (int u = 0; u < 8; ++u) {
+        float sum = 0.0f;
+        for (int x = 0; x < 8; ++x) sum += block[y * 8 + x] * cosTable[x][u];
+        temp[y * 8 + u] = sum;
+      }
+    }
+    int coefficients[64];
+    for (int u = 0; u < 8; ++u) {
+      for (int v = 0; v < 8; ++v) {
+        float sum = 0.0f;
+        for (int y = 0; y < 8; ++y) sum += temp[y * 8 + u] * cosTable[y][v];
+        coefficients[v * 8 + u] = static_cast<int>(std::lround(sum / quant[v * 8 + u]));
+      }
+    }
+
+    auto category = [](int value) {
+      unsigned int magnitude = static_cast<unsigned int>(value < 0 ? -value : value);
+      unsigned int bitsNeeded = 0;
+      while (magnitude) {
+        ++bitsNeeded;
+        magnitude >>= 1;
+      }
+      return bitsNeeded;
+    };
+    auto writeValue = [&](int value, unsigned int size) {
+      if (size == 0) return;
+      bits.write(static_cast<uint32_t>(value < 0 ? value - 1 : value), size);
+    };
+
+    int diff = coefficients[0] - previousDc;
+    previousDc = coefficients[0];
+    unsigned int dcSize = category(diff);
+    bits.write(dc.code[dcSize], dc.length[dcSize]);
+    writeValue(diff, dcSize);
+
+    int lastNonZero = 0;
+    for (int i = 63; i > 0; --i) {
+      if (coefficients[kZigZag[i]] != 0) {
+        lastNonZero = i;
+        break;
+      }
+    }
+    int run = 0;
+    for (int i = 1; i <= lastNonZero; ++i) {
+      int value = coefficients[kZigZag[i]];
+      if (value == 0) {
+        ++run;
+        continue;
+      }
+      while (run >= 16) {
+        bits.write(ac.code[0xF0], ac.length[0xF0]);
+        run -= 16;
+      }
+      unsigned int size = category(value);
+      unsigned int symbol = (run << 4) | size;
+      bits.write(ac.code[symbol], ac.length[symbol]);
+      writeValue(value, size);
+      run = 0;
+    }
+    if (lastNonZero < 63) {
+      bits.write(ac.code[0x00], ac.length[0x00]);
+    }
+  }
+
+  void
+  writeSegmentHeader(std::vector<uint8_t>& out, uint8_t marker, uint32_t length) {
+    out.push_back(0xFF);
+    out.push_back(marker);
+    putU16BE(out, length);
+  }
+
+  void
+  writeHuffmanSegment(std::vector<uint8_t>& out, uint8_t tableClassId, const uint8_t bits[16], const uint8_t* values) {
+    int count = 0;
+    for (int i = 0; i < 16; ++i) count += bits[i];
+    writeSegmentHeader(out, 0xC4, 2 + 1 + 16 + count);
+    out.push_back(tableClassId);
+    out.insert(out.end(), bits, bits + 16);
+    out.insert(out.end(), values, values + count);
+  }
+}
+
+bool
+writeSyntheticObj(const std::string& fileName, uint64_t targetTriangles, SyntheticMeshInfo& info) {
+  // Rejilla de cols x rows quads, 2 tringulos por quad.
+  uint64_t quads = std::max<uint64_t>(1, targetTriangles / 2);
+  uint64_t cols = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::sqrt(static_cast<double>(quads)))));
+  uint64_t rows = std::max<uint64_t>(1, (quads + cols / 2) / cols);
+
+  FILE* file = std::fopen(fileName.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  std::vector<char> buffer;
+  buffer.reserve(1 << 20);
+  uint64_t written = 0;
+  auto flush = [&]() {
+    written += std::fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+  };
+  auto append = [&](const char* text, int length) {
+    buffer.insert(buffer.end(), text, text + length);
+    if (buffer.size() > (1 << 20) - 256) {
+      flush();
+    }
+  };
+
+  char line[160];
+  int length = std::snprintf(line, sizeof(line), "# NaviEngine synthetic grid %llu x %llu\n",
+                             static_cast<unsigned long long>(cols), static_cast<unsigned long long>(rows));
+  append(line, length);
+
+  const uint64_t vx = cols + 1;
+  const uint64_t vy = rows + 1;
+  auto height = [](double u, double v) {
+    return 0.15 * std::sin(u * 12.566) * std::cos(v * 9.424);
+  };
+
+  for (uint64_t y = 0; y < vy; ++y) {
+    for (uint64_t x = 0; x < vx; ++x) {
+      double u = static_cast<double>(x) / cols;
+      double v = static_cast<double>(y) / rows;
+      length = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", u * 2.0 - 1.0, height(u, v), v * 2.0 - 1.0);
+      append(line, length);
+    }
+  }
+  for (uint64_t y = 0; y < vy; ++y) {
+    for (uint64_t x = 0; x < vx; ++x) {
+      length = std::snprintf(line, sizeof(line), "vt %.6f %.6f\n",
+                             static_cast<double>(x) / cols, static_cast<double>(y) / rows);
+      append(line, length);
+    }
+  }
+  const double e = 1e-3;
+  for (uint64_t y = 0; y < vy; ++y) {
+    for (uint64_t x = 0; x < vx; ++x) {
+      double u = static_cast<double>(x) / cols;
+      double v = static_cast<double>(y) / rows;
+      double dx = (height(u + e, v) - height(u - e, v)) / (4.0 * e);
+      double dz = (height(u, v + e) - height(u, v - e)) / (4.0 * e);
+      double len = std::sqrt(dx * dx + 1.0 + dz * dz);
+      length = std::snprintf(line, sizeof(line), "vn %.6f %.6f %.6f\n", -dx / len, 1.0 / len, -dz / len);
+      append(line, length);
+    }
+  }
+  for (uint64_t y = 0; y < rows; ++y) {
+    for (uint64_t x = 0; x < cols; ++x) {
+      unsigned long long a = y * vx + x + 1;
+      unsigned long long b = a + 1;
+      unsigned long long c = a + vx;
+      unsigned long long d = c + 1;
+      length = std::snprintf(line, sizeof(line), "f %llu/%llu/%llu %llu/%llu/%llu %llu/%llu/%llu\n",
+                             a, a, a, c, c, c, b, b, b);
+      append(line, length);
+      length = std::snprintf(line, sizeof(line), "f %llu/%llu/%llu %llu/%llu/%llu %llu/%llu/%llu\n",
+                             b, b, b, c, c, c, d, d, d);
+      append(line, length);
+    }
+  }
+  flush();
+  bool ok = std::ferror(file) == 0;
+  ok = (std::fclose(file) == 0) && ok;
+
+  info.triangles = cols * rows * 2;
+  info.vertices = vx * vy;
+  info.bytes = written;
+  return ok;
+}
+
+std::vector<uint8_t>
+generateSyntheticImage(unsigned int width, unsigned int height, unsigned int channels) {
+  std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+  Random random(width * 73856093u ^ height * 19349663u ^ channels);
+
+  for (unsigned int y = 0; y < height; ++y) {
+    for (unsigned int x = 0; x < width; ++x) {
+      float u = static_cast<float>(x) / width;
+      float v = static_cast<float>(y) / height;
+
+      // Gradiente suave + anillos + tablero fino + algo de ruido.
+      float ring = 0.5f + 0.5f * std::sin(40.0f * std::sqrt((u - 0.5f) * (u - 0.5f) + (v - 0.5f) * (v - 0.5f)));
+      bool checker = ((x >> 3) ^ (y >> 3)) & 1;
+      int noise = static_cast<int>(random.next() & 15) - 8;
+
+      int r = static_cast<int>(255.0f * u * ring) + noise;
+      int g = static_cast<int>(255.0f * v) + (checker ? 24 : -24) + noise;
+      int b = static_cast<int>(255.0f * (1.0f - u) * (1.0f - ring * 0.5f)) + noise;
+
+      uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * channels];
+      p[0] = static_cast<uint8_t>(std::min(255, std::max(0, r)));
+      if (channels > 1) p[1] = static_cast<uint8_t>(std::min(255, std::max(0, g)));
+      if (channels > 2) p[2] = static_cast<uint8_t>(std::min(255, std::max(0, b)));
+      if (channels > 3) p[3] = static_cast<uint8_t>(ring > 0.2f ? 255 : static_cast<int>(ring * 1275.0f));
+    }
+  }
+  return pixels;
+}
+
+std::vector<uint8_t>
+encodePng(const std::vector<uint8_t>& pixels,
+          unsigned int width,
+          unsigned int height,
+          unsigned int channels) {
+  static const uint8_t kColorType[5] = { 0, 0, 4, 2, 6 };
+  const size_t stride = static_cast<size_t>(width) * channels;
+
+  // Cada fila va precedida por su tipo de filtro (4 = Paeth).
+  std::vector<uint8_t> filtered;
+  filtered.reserve((stride + 1) * height);
+  for (unsigned int y = 0; y < height; ++y) {
+    const uint8_t* row = &pixels[y * stride];
+    const uint8_t* prev = y > 0 ? &pixels[(y - 1) * stride] : nullptr;
+    filtered.push_back(4);
+    for (size_t i = 0; i < stride; ++i) {
+      int a = i >= channels ? row[i - channels] : 0;
+      int b = prev ? prev[i] : 0;
+      int c = (prev && i >= channels) ? prev[i - channels] : 0;
+      filtered.push_back(static_cast<uint8_t>(row[i] - paeth(a, b, c)));
+    }
+  }
+
+  std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+  std::vector<uint8_t> header;
+  putU32BE(header, width);
+  putU32BE(header, height);
+  header.push_back(8);                     // bits por canal
+  header.push_back(kColorType[channels]);  // tipo de color
+  header.push_back(0);                     // compresin deflate
+  header.push_back(0);                     // filtro adaptativo
+  header.push_back(0);                     // sin entrelazado
+  writeChunk(png, "IHDR", header);
+  writeChunk(png, "IDAT", zlibCompress(filtered));
+  writeChunk(png, "IEND", {});
+  return png;
+}
+
+std::vector<uint8_t>
+encodeJpeg(const std::vector<uint8_t>& pixels,
+           unsigned int width,
+           unsigned int height,
+           unsigned int channels,
+           int quality) {
+  quality = std::min(100, std::max(1, quality));
+  int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+
+  uint8_t lumaQ[64];
+  uint8_t chromaQ[64];
+  float lumaDivisor[64];
+  float chromaDivisor[64];
+  for (int i = 0; i < 64; ++i) {
+    lumaQ[i] = static_cast<uint8_t>(std::min(255, std::max(1, (kLumaQuant[i] * scale + 50) / 100)));
+    chromaQ[i] = static_cast<uint8_t>(std::min(255, std::max(1, (kChromaQuant[i] * scale + 50) / 100)));
+    lumaDivisor[i] = lumaQ[i];
+    chromaDivisor[i] = chromaQ[i];
+  }
+
+  std::vector<uint8_t> out = { 0xFF, 0xD8 };
+
+  // DQT: tablas en orden zigzag.
+  writeSegmentHeader(out, 0xDB, 2 + 2 * 65);
+  out.push_back(0x00);
+  for (int i = 0; i < 64; ++i) out.push_back(lumaQ[kZigZag[i]]);
+  out.push_back(0x01);
+  for (int i = 0; i < 64; ++i) out.push_back(chromaQ[kZigZag[i]]);
+
+  // SOF0: baseline, 3 componentes sin submuestreo.
+  writeSegmentHeader(out, 0xC0, 2 + 6 + 3 * 3);
+  out.push_back(8);
+  putU16BE(out, height);
+  putU16BE(out, width);
+  out.push_back(3);
+  const uint8_t components[3][3] = { { 1, 0x11, 0 }, { 2, 0x11, 1 }, { 3, 0x11, 1 } };
+  for (auto& component : components) {
+    out.insert(out.end(), component, component + 3);
+  }
+
+  writeHuffmanSegment(out, 0x00, kDcLumaBits, kDcValues);
+  writeHuffmanSegment(out, 0x10, kAcLumaBits, kAcLumaValues);
+  writeHuffmanSegment(out, 0x01, kDcChromaBits, kDcValues);
+  writeHuffmanSegment(out, 0x11, kAcChromaBits, kAcChromaValues);
+
+  // SOS
+  writeSegmentHeader(out, 0xDA, 2 + 1 + 3 * 2 + 3);
+  out.push_back(3);
+  out.push_back(1); out.push_back(0x00);
+  out.push_back(2); out.push_back(0x11);
+  out.push_back(3); out.push_back(0x11);
+  out.push_back(0);
+  out.push_back(63);
+  out.push_back(0);
+
+  const HuffmanTable dcLuma = buildHuffman(kDcLumaBits, kDcValues);
+  const HuffmanTable acLuma = buildHuffman(kAcLumaBits, kAcLumaValues);
+  const HuffmanTable dcChroma = buildHuffman(kDcChromaBits, kDcValues);
+  const HuffmanTable acChroma = buildHuffman(kAcChromaBits, kAcChromaValues);
+
+  JpegBitWriter bits(out);
+  int previousDc[3] = { 0, 0, 0 };
+  float blocks[3][64];
+  for (unsigned int by = 0; by < height; by += 8) {
+    for (unsigned int bx = 0; bx < width; bx += 8) {
+      for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+          // Los bordes se rellenan repitiendo el ltimo pxel.
+          unsigned int px = std::min(bx + x, width - 1);
+          unsigned int py = std::min(by + y, height - 1);
+          const uint8_t* p = &pixels[(static_cast<size_t>(py) * width + px) * channels];
+          float r = p[0], g = p[1], b = p[2];
+          blocks[0][y * 8 + x] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+          blocks[1][y * 8 + x] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+          blocks[2][y * 8 + x] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+        }
+      }
+      encodeBlock(bits, blocks[0], lumaDivisor, previousDc[0], dcLuma, acLuma);
+      encodeBlock(bits, blocks[1], chromaDivisor, previousDc[1], dcChroma, acChroma);
+      encodeBlock(bits, blocks[2], chromaDivisor, previousDc[2], dcChroma, acChroma);
+    }
+  }
+  bits.flush();
+
+  out.push_back(0xFF);
+  out.push_back(0xD9);
+  return out;
+}
+
+bool
+writeFileBytes(const std::string& fileName, const std::vector<uint8_t>& data) {
+  FILE* file = std::fopen(fileName.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  size_t written = std::fwrite(data.data(), 1, data.size(), file);
+  bool ok = std::fclose(file) == 0;
+  return ok && written == data.size();
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file SyntheticAssets.h
+ * @brief Generadores deterministas de mallas OBJ e imgenes PNG/JPG para benchmarks.
+ *
+ * Los benchmarks no dependen de assets del repositorio: todo se genera a partir
+ * de una semilla fija, de modo que dos mquinas miden exactamente los mismos bytes.
+ */
+
+/**
+ * @struct SyntheticMeshInfo
+ * @brief Descripcin de una malla OBJ generada.
+ */
+struct
+SyntheticMeshInfo {
+  uint64_t triangles = 0; /**< Tringulos reales de la malla (puede diferir un poco del pedido). */
+  uint64_t vertices = 0;  /**< Vrtices nicos (v/vt/vn comparten ndice). */
+  uint64_t bytes = 0;     /**< Tamao del archivo OBJ en bytes. */
+};
+
+/**
+ * @brief Escribe una malla OBJ en forma de rejilla con relieve.
+ *
+ * La rejilla tiene posiciones, coordenadas de textura y normales, y cada cara
+ * es un tringulo "f a/a/a b/b/b c/c/c". Los vrtices internos se comparten
+ * entre seis tringulos, igual que en un modelo real exportado.
+ *
+ * @param fileName Ruta del archivo de salida.
+ * @param targetTriangles Nmero aproximado de tringulos.
+ * @param info Recibe el tamao real de la malla generada.
+ * @return true si el archivo se escribi completo.
+ */
+bool
+writeSyntheticObj(const std::string& fileName, uint64_t targetTriangles, SyntheticMeshInfo& info);
+
+/**
+ * @brief Genera una imagen RGB/RGBA con gradientes, formas y ruido.
+ *
+ * El contenido mezcla zonas suaves y detalle de alta frecuencia para que la
+ * compresin PNG/JPG se parezca a la de una textura real.
+ *
+ * @param width Ancho en pxeles.
+ * @param height Alto en pxeles.
+ * @param channels 1 (gris), 2 (gris + alpha), 3 (RGB) o 4 (RGBA).
+ * @return Pxeles en orden de filas, @p channels bytes por pxel.
+ */
+std::vector<uint8_t>
+generateSyntheticImage(unsigned int width, unsigned int height, unsigned int channels);
+
+/**
+ * @brief Codifica pxeles de 8 bits como PNG (filtro Paeth, deflate con Huffman fijo).
+ * @param pixels Pxeles en orden de filas.
+ * @param width Ancho en pxeles.
+ * @param height Alto en pxeles.
+ * @param channels 1, 2, 3 o 4.
+ * @return Archivo PNG completo en memoria.
+ */
+std::vector<uint8_t>
+encodePng(const std::vector<uint8_t>& pixels,
+          unsigned int width,
+          unsigned int height,
+          unsigned int channels);
+
+/**
+ * @brief Codifica pxeles RGB/RGBA como JPEG baseline 4:4:4 (tablas estndar del anexo K).
+ * @param pixels Pxeles en orden de filas (el canal alfa se ignora).
+ * @param width Ancho en pxeles.
+ * @param height Alto en pxeles.
+ * @param channels 3 o 4.
+ * @param quality Calidad 1-100 (escala IJG de las tablas de cuantizacin).
+ * @return Archivo JPEG completo en memoria.
+ */
+std::vector<uint8_t>
+encodeJpeg(const std::vector<uint8_t>& pixels,
+           unsigned int width,
+           unsigned int height,
+           unsigned int channels,
+           int quality = 90);
+
+/**
+ * @brief Escribe un bloque de bytes en disco.
+ * @return true si se escribieron todos los bytes.
+ */
+bool
+writeFileBytes(const std::string& fileName, const std::vector<uint8_t>& data);
@@ -0,0 +1,527 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file Allocators.h
+ * @brief Subsistema de memoria: heap etiquetado, asignador lineal por frame y pools.
+ *
+ * Toda la memoria de estos asignadores sale de TaggedHeap, que lleva por
+ * subsistema (MemoryTag) los bytes vivos, el pico y el nmero de asignaciones.
+ * Sobre l:
+ *  - LinearAllocator: asignacin por incremento de puntero que se libera de una
+ *    vez con reset(). EngineMemory::frame() es el del hilo principal y BaseApp
+ *    lo reinicia al comienzo de cada frame.
+ *  - PoolAllocator / TypedPool: bloques de tamao fijo con lista libre, para
+ *    objetos que se crean y destruyen a menudo.
+ *  - LinearStlAllocator / TaggedStlAllocator: adaptadores para los contenedores
+ *    de la STL en los caminos calientes.
+ *
+ * Solo TaggedHeap es seguro entre hilos; los dems asignadores pertenecen a un
+ * nico hilo (o el dueo sincroniza el acceso). No depende de Windows.
+ */
+
+/**
+ * @brief Subsistema al que se cargan las asignaciones.
+ */
+enum
+MemoryTag {
+  MEMORY_GENERAL = 0, /**< Sin clasificar. */
+  MEMORY_LOADER = 1,  /**< Parseo de modelos: temporales y resultados antes de subirlos. */
+  MEMORY_FRAME = 2,   /**< Bloques del asignador lineal del frame. */
+  MEMORY_TAG_COUNT = 3
+};
+
+/**
+ * @brief Nombre de la etiqueta (snake_case, apto para mtricas).
+ */
+const char*
+memoryTagName(MemoryTag tag);
+
+/**
+ * @struct MemoryStats
+ * @brief Contabilidad de una etiqueta.
+ */
+struct
+MemoryStats {
+  uint64_t currentBytes = 0;     /**< Bytes vivos (pedidos, sin cabeceras). */
+  uint64_t peakBytes = 0;        /**< Mximo de currentBytes. */
+  uint64_t liveAllocations = 0;  /**< Asignaciones sin liberar. */
+  uint64_t totalAllocations = 0; /**< Asignaciones desde el inicio del proceso. */
+};
+
+/**
+ * @class TaggedHeap
+ * @brief Heap general con contabilidad por subsistema.
+ *
+ * Cada bloque lleva una cabecera de 16 bytes con su tamao y etiqueta, as que
+ * deallocate() no necesita que se le indiquen. Los contadores son atmicos
+ * relajados: se puede asignar y liberar desde cualquier hilo.
+ */
+class
+TaggedHeap {
+public:
+  /**
+   * @brief Instancia global.
+   */
+  static TaggedHeap&
+  instance();
+
+  /**
+   * @brief Reserva @p size bytes a nombre de @p tag.
+   * @param alignment Alineacin (potencia de dos; como mnimo 16).
+   * @return El bloque o nullptr si no hay memoria.
+   */
+  void*
+  allocate(size_t size, MemoryTag tag, size_t alignment = 16);
+
+  /**
+   * @brief Libera un bloque obtenido con allocate() (nullptr no hace nada).
+   */
+  void
+  deallocate(void* pointer);
+
+  /**
+   * @brief Contabilidad actual de @p tag.
+   */
+  MemoryStats
+  stats(MemoryTag tag) const;
+
+  /**
+   * @brief Suma de todas las etiquetas.
+   */
+  MemoryStats
+  totals() const;
+
+private:
+  TaggedHeap() = default;
+
+  /**
+   * @struct Counters
+   * @brief Contadores de una etiqueta, cada uno en su propia lnea de cach.
+   */
+  struct alignas(64)
+  Counters {
+    std::atomic<uint64_t> current{ 0 };
+    std::atomic<uint64_t> peak{ 0 };
+    std::atomic<uint64_t> live{ 0 };
+    std::atomic<uint64_t> total{ 0 };
+  };
+
+  Counters m_counters[MEMORY_TAG_COUNT];
+};
+
+/**
+ * @class LinearAllocator
+ * @brief Asignador por incremento de puntero que se libera entero con reset().
+ *
+ * Trabaja sobre un bloque principal. Si un frame lo supera, la asignacin no
+ * falla: se encadenan bloques extra y en el siguiente reset() el principal se
+ * recrea con el tamao del pico, de modo que el desbordamiento ocurre una sola vez.
+ * No ejecuta destructores: solo debe guardar datos triviales o contenedores
+ * cuya vida termina antes del reset().
+ */
+class
+LinearAllocator {
+public:
+  /**
+   * @brief Constructor.
+   * @param capacity Tamao inicial del bloque principal en bytes.
+   * @param tag Etiqueta a la que se cargan los bloques.
+   */
+  explicit
+  LinearAllocator(size_t capacity = 64 * 1024, MemoryTag tag = MEMORY_FRAME);
+
+  /**
+   * @brief Destructor. Devuelve todos los bloques al heap.
+   */
+  ~LinearAllocator();
+
+  LinearAllocator(const LinearAllocator&) = delete;
+  LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+  /**
+   * @brief Reserva @p size bytes alineados a @p alignment (potencia de dos).
+   */
+  void*
+  allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    uintptr_t aligned = (m_cursor + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    if (aligned + size > m_end || aligned < m_cursor) {
+      return allocateSlow(size, alignment);
+    }
+    m_cursor = aligned + size;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  /**
+   * @brief Reserva espacio para @p count objetos de tipo T (sin construirlos).
+   */
+  template<typename T>
+  T*
+  allocateArray(size_t count) {
+    return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief Devuelve el bloque si es la ltima asignacin; si no, no hace nada.
+   *
+   * Permite que un vector que crece sobre este asignador reaproveche el
+   * espacio cuando nadie asign despus de l.
+   */
+  void
+  deallocate(void* pointer, size_t size) {
+    if (reinterpret_cast<uintptr_t>(pointer) + size == m_cursor) {
+      m_cursor = reinterpret_cast<uintptr_t>(pointer);
+    }
+  }
+
+  /**
+   * @brief Libera todas las asignaciones. Los punteros previos dejan de ser vlidos.
+   */
+  void
+  reset();
+
+  /**
+   * @brief Bytes consumidos desde el ltimo reset() (incluye relleno de alineacin).
+   */
+  size_t
+  used() const { return m_usedBefore + (m_cursor - m_begin); }
+
+  /**
+   * @brief Tamao del bloque principal.
+   */
+  size_t
+  capacity() const { return m_capacity; }
+
+  /**
+   * @brief Mximo de used() observado en un ciclo entre reset().
+   */
+  size_t
+  highWater() const { return m_highWater; }
+
+  /**
+   * @brief Bloques extra creados porque el principal se qued corto.
+   */
+  uint64_t
+  overflowCount() const { return m_overflowCount; }
+
+private:
+  /**
+   * @brief Encadena un bloque extra con espacio para la asignacin.
+   */
+  void*
+  allocateSlow(size_t size, size_t alignment);
+
+  /**
+   * @brief Libera los bloques extra.
+   */
+  void
+  releaseOverflow();
+
+  /** @brief Etiqueta de los bloques. */
+  MemoryTag m_tag;
+
+  /** @brief Bloque principal. */
+  uint8_t* m_block = nullptr;
+
+  /** @brief Tamao del bloque principal. */
+  size_t m_capacity = 0;
+
+  /** @brief Bloques extra del ciclo actual (cada uno guarda el anterior al inicio). */
+  void* m_overflow = nullptr;
+
+  /** @brief Inicio, cursor y final de la regin en uso. */
+  uintptr_t m_begin = 0;
+  uintptr_t m_cursor = 0;
+  uintptr_t m_end = 0;
+
+  /** @brief Bytes consumidos en las regiones anteriores del ciclo. */
+  size_t m_usedBefore = 0;
+
+  /** @brief Pico de used() entre reset(). */
+  size_t m_highWater = 0;
+
+  /** @brief Bloques extra creados desde la construccin. */
+  uint64_t m_overflowCount = 0;
+};
+
+/**
+ * @class PoolAllocator
+ * @brief Bloques de tamao fijo con lista libre intrusiva.
+ *
+ * Los bloques se reservan por trozos de @p blocksPerChunk y nunca se devuelven
+ * al heap hasta destruir el pool, as que allocate() y deallocate() son O(1)
+ * sin tocar el heap salvo al crecer.
+ */
+class
+PoolAllocator {
+public:
+  /**
+   * @brief Constructor.
+   * @param blockSize Tamao de cada bloque (se redondea a mltiplo de 16).
+   * @param blocksPerChunk Bloques que se reservan cada vez que el pool crece.
+   * @param tag Etiqueta a la que se cargan los trozos.
+   */
+  PoolAllocator(size_t blockSize, size_t blocksPerChunk = 256, MemoryTag tag = MEMORY_GENERAL);
+
+  /**
+   * @brief Destructor. Devuelve los trozos al heap (no destruye objetos vivos).
+   */
+  ~PoolAllocator();
+
+  PoolAllocator(const PoolAllocator&) = delete;
+  PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+  /**
+   * @brief Reserva un bloque.
+   * @return El bloque o nullptr si no hay memoria.
+   */
+  void*
+  allocate() {
+    if (!m_free && !grow()) {
+      return nullptr;
+    }
+    FreeBlock* block = m_free;
+    m_free = block->next;
+    ++m_live;
+    return block;
+  }
+
+  /**
+   * @brief Devuelve un bloque al pool (nullptr no hace nada).
+   */
+  void
+  deallocate(void* pointer) {
+    if (!pointer) {
+      return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    block->next = m_free;
+    m_free = block;
+    --m_live;
+  }
+
+  /**
+   * @brief Tamao efectivo de cada bloque.
+   */
+  size_t
+  blockSize() const { return m_blockSize; }
+
+  /**
+   * @brief Bloques entregados y no devueltos.
+   */
+  size_t
+  liveCount() const { return m_live; }
+
+  /**
+   * @brief Bloques reservados en total (vivos y libres).
+   */
+  size_t
+  capacity() const { return m_chunks.size() * m_blocksPerChunk; }
+
+private:
+  /**
+   * @struct FreeBlock
+   * @brief Un bloque libre guarda el siguiente de la lista.
+   */
+  struct
+  FreeBlock {
+    FreeBlock* next;
+  };
+
+  /**
+   * @brief Reserva un trozo nuevo y lo encadena a la lista libre.
+   */
+  bool
+  grow();
+
+  size_t m_blockSize;
+  size_t m_blocksPerChunk;
+  MemoryTag m_tag;
+  FreeBlock* m_free = nullptr;
+  size_t m_live = 0;
+  std::vector<void*> m_chunks;
+};
+
+/**
+ * @class TypedPool
+ * @brief PoolAllocator que construye y destruye objetos de tipo T.
+ */
+template<typename T>
+class
+TypedPool {
+public:
+  static_assert(alignof(T) <= 16, "TypedPool solo garantiza alineacin de 16 bytes");
+
+  /**
+   * @brief Constructor.
+   * @param blocksPerChunk Objetos que se reservan cada vez que el pool crece.
+   * @param tag Etiqueta a la que se cargan los trozos.
+   */
+  explicit
+  TypedPool(size_t blocksPerChunk = 256, MemoryTag tag = MEMORY_GENERAL)
+    : m_pool(sizeof(T), blocksPerChunk, tag) {}
+
+  /**
+   * @brief Construye un objeto con @p args.
+   * @return El objeto o nullptr si no hay memoria.
+   */
+  template<typename... Args>
+  T*
+  create(Args&&... args) {
+    void* block = m_pool.allocate();
+    return block ? new (block) T(std::forward<Args>(args)...) : nullptr;
+  }
+
+  /**
+   * @brief Destruye un objeto creado con create() (nullptr no hace nada).
+   */
+  void
+  destroy(T* object) {
+    if (object) {
+      object->~T();
+      m_pool.deallocate(object);
+    }
+  }
+
+  /**
+   * @brief Objetos vivos.
+   */
+  size_t
+  liveCount() const { return m_pool.liveCount(); }
+
+  /**
+   * @brief Objetos que caben sin crecer.
+   */
+  size_t
+  capacity() const { return m_pool.capacity(); }
+
+private:
+  PoolAllocator m_pool;
+};
+
+/**
+ * @class LinearStlAllocator
+ * @brief Adaptador de la STL sobre un LinearAllocator.
+ *
+ * deallocate() solo recupera la ltima asignacin; el resto se libera con el
+ * reset() del asignador, que no debe ocurrir mientras viva el contenedor.
+ */
+template<typename T>
+class
+LinearStlAllocator {
+public:
+  using value_type = T;
+
+  LinearStlAllocator(LinearAllocator& allocator) noexcept : m_allocator(&allocator) {}
+
+  template<typename U>
+  LinearStlAllocator(const LinearStlAllocator<U>& other) noexcept : m_allocator(other.allocator()) {}
+
+  T*
+  allocate(size_t count) {
+    void* pointer = m_allocator->allocate(count * sizeof(T), alignof(T) < 16 ? 16 : alignof(T));
+    if (!pointer) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(pointer);
+  }
+
+  void
+  deallocate(T* pointer, size_t count) noexcept { m_allocator->deallocate(pointer, count * sizeof(T)); }
+
+  LinearAllocator*
+  allocator() const noexcept { return m_allocator; }
+
+  template<typename U>
+  bool
+  operator==(const LinearStlAllocator<U>& other) const noexcept { return m_allocator == other.allocator(); }
+
+  template<typename U>
+  bool
+  operator!=(const LinearStlAllocator<U>& other) const noexcept { return m_allocator != other.allocator(); }
+
+private:
+  LinearAllocator* m_allocator;
+};
+
+/**
+ * @class TaggedStlAllocator
+ * @brief Adaptador de la STL sobre TaggedHeap: el contenedor se contabiliza en @p Tag.
+ */
+template<typename T, MemoryTag Tag>
+class
+TaggedStlAllocator {
+public:
+  using value_type = T;
+
+  template<typename U>
+  struct
+  rebind {
+    using other = TaggedStlAllocator<U, Tag>;
+  };
+
+  TaggedStlAllocator() noexcept = default;
+
+  template<typename U>
+  TaggedStlAllocator(const TaggedStlAllocator<U, Tag>&) noexcept {}
+
+  T*
+  allocate(size_t count) {
+    void* pointer = TaggedHeap::instance().allocate(count * sizeof(T), Tag, alignof(T) < 16 ? 16 : alignof(T));
+    if (!pointer) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(pointer);
+  }
+
+  void
+  deallocate(T* pointer, size_t) noexcept { TaggedHeap::instance().deallocate(pointer); }
+
+  template<typename U>
+  bool
+  operator==(const TaggedStlAllocator<U, Tag>&) const noexcept { return true; }
+
+  template<typename U>
+  bool
+  operator!=(const TaggedStlAllocator<U, Tag>&) const noexcept { return false; }
+};
+
+/** @brief Vector sobre un LinearAllocator. */
+template<typename T>
+using LinearVector = std::vector<T, LinearStlAllocator<T>>;
+
+/** @brief Mapa ordenado sobre un LinearAllocator. */
+template<typename K, typename V, typename Compare = std::less<K>>
+using LinearMap = std::map<K, V, Compare, LinearStlAllocator<std::pair<const K, V>>>;
+
+/** @brief Vector contabilizado en @p Tag. */
+template<typename T, MemoryTag Tag>
+using TaggedVector = std::vector<T, TaggedStlAllocator<T, Tag>>;
+
+/** @brief Cadena contabilizada en @p Tag. */
+template<MemoryTag Tag>
+using TaggedString = std::basic_string<char, std::char_traits<char>, TaggedStlAllocator<char, Tag>>;
+
+/**
+ * @namespace EngineMemory
+ * @brief Asignadores globales del motor.
+ */
+namespace
+EngineMemory {
+  /**
+   * @brief Asignador lineal del frame (1 MB inicial, MEMORY_FRAME).
+   *
+   * Solo para el hilo principal. BaseApp llama a reset() al comenzar cada
+   * frame, as que nada de lo que se reserve aqu puede sobrevivir al frame
+   * ni pasarse a tareas del JobSystem.
+   */
+  LinearAllocator&
+  frame();
+}
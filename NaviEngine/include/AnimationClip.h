@@ -0,0 +1,249 @@
+#pragma once
+#include "Skinning.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file AnimationClip.h
+ * @brief Clips de animacin comprimidos: claves de 16 bits, reduccin de
+ *        claves con error acotado y muestreo de cuatro articulaciones a la vez.
+ *
+ * Cada articulacin tiene tres pistas (rotacin, traslacin y escala). Al
+ * comprimir, cada componente se cuantiza a 16 bits dentro del rango de su
+ * pista y la pista se ajusta con una curva lineal a trozos: se conservan solo
+ * las claves necesarias para que, interpolando entre ellas tal y como lo hace
+ * sample(), ningn frame original se aleje ms que la tolerancia de su pista.
+ * Las pistas constantes quedan en una clave.
+ *
+ * Los rangos de cuantizacin se guardan en SoA (componente, articulacin), y
+ * sample() escribe un SoaPose: los clculos se hacen en registros de cuatro
+ * articulaciones con SimdMath. blendPoses() mezcla varias poses igual.
+ *
+ * Disposicin del formato serializado (little-endian):
+ *
+ *   ClipHeader | ClipTrack[3 * jointCount] | rangos (float) | frames de clave (uint16) | valores (uint16)
+ */
+
+/** @brief Versin del formato que escribe y lee este cdigo. */
+const uint32_t kClipVersion = 1;
+
+/**
+ * @brief Pistas de cada articulacin, en el orden en que se guardan.
+ */
+enum
+ClipTrackKind {
+  CLIP_TRACK_ROTATION = 0,     /**< Cuaternin (x, y, z, w). */
+  CLIP_TRACK_TRANSLATION = 1,
+  CLIP_TRACK_SCALE = 2,
+  CLIP_TRACK_KIND_COUNT = 3
+};
+
+/**
+ * @struct RawAnimationClip
+ * @brief Clip sin comprimir: una JointPose por articulacin y frame.
+ */
+struct
+RawAnimationClip {
+  float sampleRate = 30.0f;   /**< Frames por segundo. */
+  size_t jointCount = 0;
+  size_t frameCount = 0;
+  std::vector<JointPose> poses;  /**< poses[frame * jointCount + joint]. */
+};
+
+/**
+ * @struct ClipCompressionSettings
+ * @brief Error mximo permitido por pista, en unidades de cada componente.
+ */
+struct
+ClipCompressionSettings {
+  float rotationTolerance = 0.0005f;     /**< Por componente del cuaternin normalizado (~0.06 grados). */
+  float translationTolerance = 0.0005f;
+  float scaleTolerance = 0.0005f;
+};
+
+/**
+ * @struct ClipCompressionStats
+ * @brief Resultado de AnimationClip::compress().
+ */
+struct
+ClipCompressionStats {
+  size_t rawBytes = 0;           /**< Floats de las claves originales. */
+  size_t compressedBytes = 0;    /**< Tamao serializado. */
+  size_t rawKeys = 0;            /**< Frames por pistas. */
+  size_t keys = 0;               /**< Claves conservadas. */
+  float maxError[CLIP_TRACK_KIND_COUNT] = { 0.0f, 0.0f, 0.0f };  /**< Error medido por tipo de pista. */
+};
+
+/**
+ * @struct ClipHeader
+ * @brief Cabecera del formato serializado (32 bytes).
+ */
+struct
+ClipHeader {
+  char magic[4];         /**< "NCLP". */
+  uint32_t version;      /**< kClipVersion. */
+  uint32_t jointCount;
+  uint32_t frameCount;
+  float sampleRate;
+  uint32_t keyCount;     /**< Total de frames de clave. */
+  uint32_t valueCount;   /**< Total de valores cuantizados. */
+  uint32_t reserved;
+};
+
+/**
+ * @struct ClipTrack
+ * @brief Claves de una pista: frames [firstKey, firstKey + keyCount) y sus
+ *        valores desde firstValue (componentes consecutivos por clave).
+ */
+struct
+ClipTrack {
+  uint32_t firstKey;
+  uint32_t firstValue;
+  uint32_t keyCount;
+};
+
+/**
+ * @struct SoaPose
+ * @brief Pose en SoA: un array por componente, relleno hasta mltiplo de 4 articulaciones.
+ */
+struct
+SoaPose {
+  size_t jointCount = 0;
+  std::vector<float> rotation[4];
+  std::vector<float> translation[3];
+  std::vector<float> scale[3];
+
+  void
+  resize(size_t joints);
+
+  /**
+   * @brief Copia la pose a JointPose (para Skeleton::localToModel()).
+   */
+  void
+  toJointPoses(JointPose* output) const;
+};
+
+/**
+ * @struct ClipCursor
+ * @brief Estado de reproduccin de un clip; uno por instancia que lo reproduce.
+ *
+ * Guarda, por pista, la clave actual y el tramo que empieza en ella ya
+ * descuantizado (valor inicial y diferencia hasta la clave siguiente). Mientras
+ * el tiempo no salga del tramo, sample() solo interpola estos floats; al salir
+ * avanza desde la clave actual en lugar de buscar. Ocupa unos 120 bytes por
+ * articulacin; sample() lo reinicia si corresponde a otro clip.
+ */
+struct
+ClipCursor {
+  uint64_t clip = 0;                  /**< Identificador del clip que lo rellen. */
+  std::vector<uint32_t> keys;         /**< Clave actual, [tipo][articulacin]. */
+  std::vector<float> values;          /**< Valor al inicio del tramo, [componente de la pose][articulacin rellena]. */
+  std::vector<float> deltas;          /**< Valor al final del tramo menos el inicial. */
+  std::vector<float> segmentStart;    /**< Frame de la clave actual, [tipo][articulacin rellena]. */
+  std::vector<float> inverseLength;   /**< 1 / frames del tramo. */
+};
+
+/**
+ * @class AnimationClip
+ * @brief Clip comprimido y su muestreo.
+ */
+class
+AnimationClip {
+public:
+  AnimationClip() = default;
+  ~AnimationClip() = default;
+
+  /**
+   * @brief Comprime un clip.
+   * @param stats Si no es nulo, recibe tamaos, claves y error medido.
+   * @param error Si no es nulo, recibe la causa del fallo.
+   * @return false si el clip est vaco o tiene ms de 65536 frames.
+   */
+  bool
+  compress(const RawAnimationClip& raw,
+           const ClipCompressionSettings& settings,
+           ClipCompressionStats* stats = nullptr,
+           std::string* error = nullptr);
+
+  /**
+   * @brief Escribe el clip en el formato de la cabecera de este archivo.
+   */
+  void
+  serialize(std::vector<uint8_t>& output) const;
+
+  /**
+   * @brief Lee un clip escrito por serialize() (p. ej. una entrada de un .pak).
+   * @return false si los datos no son un clip vlido de esta versin.
+   */
+  bool
+  deserialize(const uint8_t* data, size_t size, std::string* error = nullptr);
+
+  size_t
+  jointCount() const { return m_jointCount; }
+
+  float
+  duration() const { return m_frameCount > 1 ? (m_frameCount - 1) / m_sampleRate : 0.0f; }
+
+  /**
+   * @brief Bytes que ocupa serializado.
+   */
+  size_t
+  sizeInBytes() const;
+
+  /**
+   * @brief Pose en @p time segundos, limitado a [0, duration()].
+   * @param cursor Estado de reproduccin; se ajusta solo si no corresponde al clip.
+   */
+  void
+  sample(float time, ClipCursor& cursor, SoaPose& pose) const;
+
+private:
+  size_t
+  paddedJoints() const { return (m_jointCount + 3) / 4 * 4; }
+
+  /**
+   * @brief ndice de la clave de @p track que empieza el tramo que contiene @p frame.
+   */
+  uint32_t
+  findKey(const ClipTrack& track, float frame, uint32_t hint) const;
+
+  /**
+   * @brief Prepara @p cursor para este clip: todas las pistas quedan fuera de su tramo.
+   */
+  void
+  resetCursor(ClipCursor& cursor) const;
+
+  /**
+   * @brief Descuantiza en @p cursor el tramo de la pista (@p kind, @p joint) que contiene @p frame.
+   */
+  void
+  loadSegment(ClipTrackKind kind, size_t joint, float frame, ClipCursor& cursor) const;
+
+  /**
+   * @brief Muestrea las pistas de tipo @p kind (de @p Components componentes) en @p output[componente].
+   */
+  template<unsigned int Components>
+  void
+  sampleTracks(ClipTrackKind kind, float frame, ClipCursor& cursor, std::vector<float>* output) const;
+
+  uint64_t m_id = 0;                      /**< Distinto tras cada compress() o deserialize(). */
+  size_t m_jointCount = 0;
+  size_t m_frameCount = 0;
+  float m_sampleRate = 30.0f;
+  std::vector<ClipTrack> m_tracks;        /**< m_tracks[kind * jointCount + joint]. */
+  std::vector<float> m_rangeMinimum;      /**< [kind][componente][articulacin rellena]. */
+  std::vector<float> m_rangeScale;        /**< Extensin / 65535, con la misma disposicin. */
+  std::vector<uint16_t> m_keyFrames;
+  std::vector<uint16_t> m_values;
+};
+
+/**
+ * @brief Mezcla ponderada de poses: lineal en traslacin y escala y, en la
+ *        rotacin, suma por el camino corto normalizada.
+ *
+ * Los pesos se normalizan; todas las poses deben tener el mismo nmero de articulaciones.
+ */
+void
+blendPoses(const SoaPose* const* poses, const float* weights, size_t count, SoaPose& output);
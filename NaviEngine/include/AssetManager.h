@@ -0,0 +1,352 @@
+#pragma once
+#include "Prerequisites.h"
+#include "AsyncLoader.h"
+#include "Buffer.h"
+#include "DdsFile.h"
+#include "JobSystem.h"
+#include "FileSystem.h"
+#include "MeshComponent.h"
+#include "SlotMap.h"
+#include "Texture.h"
+#include "TextureStreamer.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+class
+Device;
+
+/**
+ * @file AssetManager.h
+ * @brief Registro central de mallas y texturas compartidas.
+ *
+ * Cada asset se identifica por el hash FNV-1a de su ruta normalizada: pedir la
+ * misma ruta dos veces devuelve el mismo handle y aumenta su contador de
+ * referencias, de modo que N objetos que comparten una malla usan una sola copia
+ * en CPU y una sola en GPU. Los recursos viven en SlotMaps y se referencian con
+ * handles generacionales, nunca con punteros COM.
+ *
+ * Cuando el contador llega a cero el recurso no se libera en el acto: se destruye
+ * en endFrame() tras kDestroyLatency frames, cuando la GPU ya no puede estar
+ * usndolo, y si alguien vuelve a pedirlo antes se reaprovecha.
+ *
+ * Con enableStreaming() las texturas DDS se crean solo con su cola de mips
+ * pequeos y el TextureStreamer decide, segn el tamao en pantalla que se
+ * reporta con requestTextureDetail(), qu niveles superiores se suben sin pasar
+ * del presupuesto. El archivo queda proyectado en memoria para leer esos niveles.
+ */
+
+/**
+ * @struct MeshAsset
+ * @brief Malla compartida: copia en CPU y buffers de GPU.
+ */
+struct
+MeshAsset {
+  MeshComponent mesh;
+  Buffer vertexBuffer;
+  Buffer indexBuffer;
+};
+
+/**
+ * @struct TextureAsset
+ * @brief Textura compartida.
+ */
+struct
+TextureAsset {
+  Texture texture;
+  FileView file;                    /**< Contenido del DDS (solo texturas con streaming). */
+  DdsImage image;                   /**< Superficies dentro de @c file. */
+  StreamHandle stream;              /**< Registro en el TextureStreamer (nulo sin streaming). */
+};
+
+/**
+ * @brief Handle de una malla del AssetManager.
+ */
+using MeshHandle = SlotHandle<MeshAsset>;
+
+/**
+ * @brief Handle de una textura del AssetManager.
+ */
+using TextureHandle = SlotHandle<TextureAsset>;
+
+/**
+ * @class AssetManager
+ * @brief Deduplica, cuenta referencias y difiere la destruccin de assets.
+ *
+ * acquire*(), addRef(), release() y state() son seguras desde cualquier hilo.
+ * processUploads(), mesh(), texture() y endFrame() son del hilo principal: los
+ * punteros que devuelven mesh()/texture() son vlidos hasta el siguiente endFrame().
+ */
+class
+AssetManager {
+public:
+  /** @brief Frames que espera un asset sin referencias antes de destruirse. */
+  static const uint64_t kDestroyLatency = 3;
+
+  /**
+   * @brief Constructor por defecto.
+   */
+  AssetManager() = default;
+
+  /**
+   * @brief Destructor por defecto (los recursos se liberan en destroy()).
+   */
+  ~AssetManager() = default;
+
+  AssetManager(const AssetManager&) = delete;
+  AssetManager& operator=(const AssetManager&) = delete;
+
+  /**
+   * @brief Hash FNV-1a de 64 bits de la ruta normalizada (minsculas, '/' como separador).
+   */
+  static uint64_t
+  hashPath(const std::string& path);
+
+  /**
+   * @brief Asocia el gestor al dispositivo y al cargador asncrono.
+   * @return S_OK.
+   */
+  HRESULT
+  init(Device& device, AsyncLoader& loader);
+
+  /**
+   * @brief Libera todos los recursos de GPU, tengan o no referencias.
+   */
+  void
+  destroy();
+
+  /**
+   * @brief Obtiene (y referencia) la malla OBJ de @p path; la carga si es nueva.
+   * @return Handle compartido por todas las peticiones de la misma ruta.
+   */
+  MeshHandle
+  acquireMesh(const std::string& path);
+
+  /**
+   * @brief Obtiene (y referencia) la textura de @p path (DDS, PNG o JPG).
+   * @param usage Uso de la textura (formato de PNG/JPG). Si la ruta ya estaba
+   *        cargada se comparte la textura existente con el uso de la primera peticin.
+   * @return Handle compartido por todas las peticiones de la misma ruta.
+   */
+  TextureHandle
+  acquireTexture(const std::string& path, TextureUsage usage = TEXTURE_USAGE_AUTO);
+
+  /**
+   * @brief Aade una referencia a un handle ya obtenido.
+   */
+  void
+  addRef(MeshHandle handle);
+
+  void
+  addRef(TextureHandle handle);
+
+  /**
+   * @brief Quita una referencia; con cero referencias el asset queda pendiente de destruir.
+   */
+  void
+  release(MeshHandle handle);
+
+  void
+  release(TextureHandle handle);
+
+  /**
+   * @brief Estado de carga (ASSET_FAILED si el handle ya no es vlido).
+   */
+  AssetState
+  state(MeshHandle handle) const;
+
+  AssetState
+  state(TextureHandle handle) const;
+
+  /**
+   * @brief Malla residente en GPU, o nullptr si no es vlida o an no se sube.
+   */
+  MeshAsset*
+  mesh(MeshHandle handle);
+
+  /**
+   * @brief Textura residente en GPU, o nullptr si no es vlida o an no se sube.
+   */
+  Texture*
+  texture(TextureHandle handle);
+
+  /**
+   * @brief Activa el streaming de mips para las texturas DDS que se suban desde ahora.
+   * @param budgetBytes Presupuesto de memoria de esas texturas, colas incluidas.
+   * @param maxLoadsInFlight Lecturas de mips simultneas.
+   */
+  void
+  enableStreaming(size_t budgetBytes, unsigned int maxLoadsInFlight = 4);
+
+  /**
+   * @brief Informa de que @p handle se dibuja este frame ocupando @p screenPixels pxeles.
+   * @param uvSpan Veces que la textura se repite a lo largo de esos pxeles.
+   */
+  void
+  requestTextureDetail(TextureHandle handle, float screenPixels, float uvSpan = 1.0f);
+
+  /**
+   * @brief Aplica las decisiones del streamer: recrea las texturas que bajan de
+   *        nivel o que terminaron de leer un mip y lanza las lecturas nuevas.
+   */
+  void
+  updateStreaming();
+
+  /**
+   * @brief Contadores del streaming de mips.
+   */
+  StreamStats
+  streamingStats() const;
+
+  /**
+   * @brief Crea los recursos de GPU de los assets que el cargador termin.
+   * @param maxItems Mximo de assets por llamada.
+   * @param maxBytes Presupuesto de bytes de subida por llamada.
+   */
+  void
+  processUploads(size_t maxItems, size_t maxBytes);
+
+  /**
+   * @brief Cierra el frame y destruye los assets sin referencias desde hace kDestroyLatency frames.
+   */
+  void
+  endFrame();
+
+  /**
+   * @brief Nmero de mallas registradas (incluidas las pendientes de destruir).
+   */
+  size_t
+  meshCount() const;
+
+  /**
+   * @brief Nmero de texturas registradas (incluidas las pendientes de destruir).
+   */
+  size_t
+  textureCount() const;
+
+private:
+  /**
+   * @struct Entry
+   * @brief Registro de un asset: identidad, referencias y estado de carga.
+   */
+  template<typename T>
+  struct
+  Entry {
+    uint64_t key = 0;
+    std::string path;
+    uint32_t refCount = 0;
+    AssetState state = ASSET_QUEUED;
+    AssetHandle request = INVALID_ASSET_HANDLE;
+    uint64_t releasedFrame = 0;
+    T resource;
+  };
+
+  /**
+   * @struct Table
+   * @brief Assets de un tipo: SlotMap y bsqueda por hash de ruta.
+   */
+  template<typename T>
+  struct
+  Table {
+    SlotMap<Entry<T>, T> entries;
+    std::unordered_map<uint64_t, SlotHandle<T>> byKey;
+    std::vector<SlotHandle<T>> released;
+  };
+
+  /**
+   * @struct PendingUpload
+   * @brief Asset que espera el resultado de una peticin del cargador.
+   */
+  struct
+  PendingUpload {
+    MeshHandle mesh;
+    TextureHandle texture;
+  };
+
+  /**
+   * @struct StreamedMip
+   * @brief Mip que un hilo de trabajo termin de leer del archivo proyectado.
+   */
+  struct
+  StreamedMip {
+    TextureHandle texture;
+    StreamHandle stream;
+    unsigned int mip = 0;
+  };
+
+  static void
+  bindRequest(PendingUpload& target, MeshHandle handle) { target.mesh = handle; }
+
+  static void
+  bindRequest(PendingUpload& target, TextureHandle handle) { target.texture = handle; }
+
+  template<typename T>
+  SlotHandle<T>
+  acquire(Table<T>& table, const std::string& path, AssetType type,
+          TextureUsage usage = TEXTURE_USAGE_AUTO);
+
+  template<typename T>
+  void
+  addRef(Table<T>& table, SlotHandle<T> handle);
+
+  template<typename T>
+  void
+  release(Table<T>& table, SlotHandle<T> handle);
+
+  template<typename T>
+  AssetState
+  state(const Table<T>& table, SlotHandle<T> handle) const;
+
+  template<typename T, typename Destroy>
+  void
+  collect(Table<T>& table, Destroy destroyResource);
+
+  HRESULT
+  upload(CompletedAsset& asset, const PendingUpload& target);
+
+  HRESULT
+  uploadDds(const CompletedAsset& asset, TextureHandle handle, TextureAsset& resource);
+
+  void
+  unregisterStream(TextureAsset& resource);
+
+  void
+  setState(const PendingUpload& target, AssetState state);
+
+private:
+  /** @brief Protege las tablas, m_requests, m_frameIndex, el streamer y m_streamedMips. */
+  mutable std::mutex m_mutex;
+
+  /** @brief Dispositivo con el que se crean los recursos. */
+  Device* m_device = nullptr;
+
+  /** @brief Cargador que lee y decodifica en segundo plano. */
+  AsyncLoader* m_loader = nullptr;
+
+  /** @brief Mallas registradas. */
+  Table<MeshAsset> m_meshes;
+
+  /** @brief Texturas registradas. */
+  Table<TextureAsset> m_textures;
+
+  /** @brief Peticin del cargador -> handle (malla o textura) que la espera. */
+  std::unordered_map<AssetHandle, PendingUpload> m_requests;
+
+  /** @brief Frames cerrados con endFrame(). */
+  uint64_t m_frameIndex = 0;
+
+  /** @brief Residencia de mips de las texturas con streaming. */
+  TextureStreamer m_streamer;
+
+  /** @brief Indica si las texturas DDS nuevas se registran en m_streamer. */
+  bool m_streaming = false;
+
+  /** @brief StreamHandle -> textura, para ejecutar las acciones del streamer. */
+  std::unordered_map<uint32_t, TextureHandle> m_streamOwners;
+
+  /** @brief Mips ledos por los hilos de trabajo, pendientes de subir a GPU. */
+  std::vector<StreamedMip> m_streamedMips;
+
+  /** @brief Lecturas de mips en curso (destroy() espera a que terminen). */
+  JobCounter m_streamJobs;
+};
@@ -0,0 +1,272 @@
+#pragma once
+#include "Prerequisites.h"
+#include "JobSystem.h"
+#include "FileSystem.h"
+#include "BlockCompressor.h"
+#include "PixelFormat.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/**
+ * @file AsyncLoader.h
+ * @brief Carga de assets en el JobSystem con entrega por lotes al hilo principal.
+ *
+ * Los hilos de trabajo leen (con VirtualFileSystem), parsean y decodifican (OBJ
+ * con ModelLoader, PNG/JPG con ImageDecoder, archivos crudos como DDS). La creacin de recursos de GPU queda
+ * para el hilo principal, que recoge los resultados con takeCompleted() en lotes
+ * limitados por nmero y por bytes para no alargar ningn frame.
+ */
+
+/**
+ * @brief Identificador de una peticin de carga. 0 es invlido.
+ */
+using AssetHandle = uint32_t;
+
+/**
+ * @brief Handle nulo: nunca lo devuelve una peticin vlida.
+ */
+const AssetHandle INVALID_ASSET_HANDLE = 0;
+
+/**
+ * @brief Tipo de contenido que produce una peticin.
+ */
+enum
+AssetType {
+  ASSET_MODEL = 0, /**< Malla OBJ parseada a LoadData. */
+  ASSET_IMAGE = 1, /**< Imagen PNG/JPG decodificada a RGBA8. */
+  ASSET_FILE = 2   /**< Bytes del archivo sin procesar (por ejemplo DDS). */
+};
+
+/**
+ * @brief Ciclo de vida de una peticin.
+ */
+enum
+AssetState {
+  ASSET_QUEUED = 0,   /**< En cola, ningn hilo la ha tomado. */
+  ASSET_LOADING = 1,  /**< Un hilo de trabajo la est procesando. */
+  ASSET_DECODED = 2,  /**< Lista en CPU, esperando su subida a GPU. */
+  ASSET_RESIDENT = 3, /**< El hilo principal cre los recursos de GPU. */
+  ASSET_FAILED = 4    /**< Fall la carga o la creacin de recursos. */
+};
+
+/**
+ * @struct LoadedImage
+ * @brief Imagen decodificada a 8 bits por canal (R8, R8G8 o RGBA8 segn su uso).
+ *
+ * Los mipmaps se generan en el hilo de trabajo junto con la decodificacin,
+ * de modo que el hilo principal solo sube la cadena ya calculada.
+ */
+struct
+LoadedImage {
+  MipChain mips;              /**< Cadena sin comprimir (vaca si se comprimi). */
+  CompressedChain compressed; /**< Cadena comprimida si la peticin lo pidi. */
+  uint32_t dxgiFormat = 28;   /**< DXGI_FORMAT de @ref mips. */
+};
+
+/**
+ * @struct CompletedAsset
+ * @brief Resultado de una peticin terminada por un hilo de trabajo.
+ *
+ * Solo el campo correspondiente a @ref type tiene contenido.
+ */
+struct
+CompletedAsset {
+  AssetHandle handle = INVALID_ASSET_HANDLE;
+  AssetType type = ASSET_FILE;
+  std::string path;
+  bool ok = false;
+  LoadData model;
+  LoadedImage image;
+  FileView file;              /**< Contenido del archivo (ASSET_FILE), proyectado si el origen lo permite. */
+
+  /**
+   * @brief Bytes que se subirn a la GPU (para el presupuesto por frame).
+   */
+  size_t
+  uploadBytes() const {
+    return model.vertex.size() * sizeof(SimpleVertex) +
+           model.index.size() * sizeof(unsigned int) +
+           image.mips.byteSize() +
+           image.compressed.byteSize() +
+           file.size();
+  }
+};
+
+/**
+ * @class AsyncLoader
+ * @brief Peticiones de carga ejecutadas como tareas del JobSystem.
+ *
+ * Las funciones load*() regresan de inmediato con un handle; state() permite
+ * consultar el progreso. No depende de Direct3D: el hilo principal decide qu
+ * hacer con cada CompletedAsset y lo confirma con markResident()/markFailed().
+ */
+class
+AsyncLoader {
+public:
+  /**
+   * @brief Constructor por defecto.
+   */
+  AsyncLoader() = default;
+
+  /**
+   * @brief Destructor. Espera a las tareas en curso.
+   */
+  ~AsyncLoader() { destroy(); }
+
+  AsyncLoader(const AsyncLoader&) = delete;
+  AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+  /**
+   * @brief Habilita las peticiones.
+   *
+   * Cada peticin se ejecuta como una tarea de JobSystem::instance(); si el
+   * JobSystem no est inicializado las cargas se hacen en el hilo que las pide.
+   * @return true si el cargador acepta peticiones.
+   */
+  bool
+  init();
+
+  /**
+   * @brief Descarta las peticiones pendientes y espera a las tareas en curso.
+   */
+  void
+  destroy();
+
+  /**
+   * @brief Pide la carga de un modelo OBJ.
+   * @param path Ruta del archivo.
+   * @return Handle de la peticin.
+   */
+  AssetHandle
+  loadModel(const std::string& path);
+
+  /**
+   * @brief Pide la carga y decodificacin de una imagen PNG o JPG.
+   * @param path Ruta del archivo.
+   * @param usage Uso de la textura: decide si se entrega en R8, R8G8 o RGBA8.
+   * @return Handle de la peticin.
+   */
+  AssetHandle
+  loadImage(const std::string& path, TextureUsage usage = TEXTURE_USAGE_AUTO);
+
+  /**
+   * @brief Formato en el que se entregan las imgenes pedidas a partir de ahora.
+   *
+   * Con un formato distinto de BLOCK_NONE la tarea de carga comprime la cadena
+   * de mips en el mismo hilo de trabajo. Las imgenes cuyo tamao no es
+   * mltiplo de 4 se entregan sin comprimir; las de un canal se comprimen
+   * siempre en BC4 y las de dos canales en BC5.
+   */
+  void
+  setImageCompression(BlockFormat format, BlockQuality quality);
+
+  /**
+   * @brief Pide la proyeccin en memoria de un archivo completo.
+   *
+   * La tarea de carga proyecta el archivo y recorre sus pginas, de modo que
+   * el hilo principal lee los bytes ya residentes sin copiarlos.
+   * @param path Ruta del archivo.
+   * @return Handle de la peticin.
+   */
+  AssetHandle
+  loadFile(const std::string& path);
+
+  /**
+   * @brief Estado actual de una peticin (ASSET_FAILED si el handle no existe).
+   */
+  AssetState
+  state(AssetHandle handle) const;
+
+  /**
+   * @brief Recoge peticiones terminadas en CPU para crear sus recursos de GPU.
+   *
+   * Devuelve como mximo @p maxItems resultados y deja de tomar ms en cuanto
+   * la suma de uploadBytes() supera @p maxBytes. Siempre se entrega al menos
+   * uno si hay alguno listo, para que un asset grande no se quede atascado.
+   *
+   * @param out Vector al que se aaden los resultados.
+   * @param maxItems Mximo de resultados en este lote.
+   * @param maxBytes Presupuesto de bytes de subida del lote.
+   * @return Nmero de resultados aadidos.
+   */
+  size_t
+  takeCompleted(std::vector<CompletedAsset>& out, size_t maxItems, size_t maxBytes);
+
+  /**
+   * @brief Marca una peticin como residente en GPU.
+   */
+  void
+  markResident(AssetHandle handle);
+
+  /**
+   * @brief Marca una peticin como fallida.
+   */
+  void
+  markFailed(AssetHandle handle);
+
+  /**
+   * @brief Peticiones que an no son residentes ni fallidas.
+   */
+  size_t
+  pendingCount() const;
+
+  /**
+   * @brief Nmero de hilos que pueden atender peticiones.
+   */
+  unsigned int
+  workerCount() const { return JobSystem::instance().threadCount(); }
+
+private:
+  /**
+   * @struct Request
+   * @brief Peticin pendiente en la cola de trabajo.
+   */
+  struct
+  Request {
+    AssetHandle handle;
+    AssetType type;
+    std::string path;
+    BlockFormat compression;
+    BlockQuality quality;
+    TextureUsage usage;
+  };
+
+  AssetHandle
+  enqueue(AssetType type, const std::string& path, TextureUsage usage = TEXTURE_USAGE_AUTO);
+
+  void
+  setState(AssetHandle handle, AssetState state);
+
+  void
+  execute(const Request& request);
+
+  void
+  process(const Request& request, CompletedAsset& result);
+
+private:
+  /** @brief Protege todas las colas y estados. */
+  mutable std::mutex m_mutex;
+
+  /** @brief Tareas de carga planificadas que an no terminan. */
+  JobCounter m_inFlight;
+
+  /** @brief Resultados listos para el hilo principal. */
+  std::deque<CompletedAsset> m_completed;
+
+  /** @brief Estado de cada peticin, indexado por handle - 1. */
+  std::vector<AssetState> m_states;
+
+  /** @brief Formato de compresin de las imgenes nuevas. */
+  BlockFormat m_imageCompression = BLOCK_NONE;
+
+  /** @brief Preset de calidad de la compresin de imgenes. */
+  BlockQuality m_imageQuality = BLOCK_QUALITY_NORMAL;
+
+  /** @brief init() ya se ejecut y destroy() an no. */
+  bool m_initialized = false;
+
+  /** @brief Indica a las tareas pendientes que deben descartarse. */
+  bool m_stopping = false;
+};
@@ -8,12 +8,19 @@
 #include "RenderTargetView.h"
 #include "DepthStencilView.h"
 #include "Viewport.h"
-#include "ShaderProgram.h"
+#include "ShaderVariants.h"
 #include "MeshComponent.h"
 #include "Buffer.h"
 #include "SamplerState.h"
 
 #include "ModelLoader.h"
+#include "AsyncLoader.h"
+#include "AssetManager.h"
+#include "Clock.h"
+#include "FrameLoop.h"
+#include "FramePacer.h"
+#include "ShaderCache.h"
+#include "FrameGraphD3D11.h"
 
 /**
  * @class BaseApp
@@ -55,17 +62,18 @@ public:
   init();
 
   /**
-   * @brief Actualiza el estado lgico de la aplicacin.
-   * @param deltaTime Tiempo transcurrido desde el ltimo frame (en segundos).
+   * @brief Avanza un paso fijo de la simulacin.
+   * @param deltaTime Duracin del paso fijo (en segundos), ver FrameLoop.
    */
   void
   update(float deltaTime);
 
   /**
    * @brief Renderiza la escena en pantalla.
+   * @param alpha Factor de interpolacin entre el paso de simulacin anterior y el actual.
    */
   void
-  render();
+  render(float alpha = 1.0f);
 
   /**
    * @brief Libera todos los recursos y objetos utilizados por la aplicacin.
@@ -86,28 +94,47 @@ private:
   static LRESULT CALLBACK
   WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 
+  /**
+   * @brief Dibuja el modelo (o el cubo provisional) sobre los targets ya enlazados.
+   * @param scale Escala del modelo, para estimar su tamao en pantalla.
+   */
+  void
+  drawScene(float scale);
+
 
   Window                              m_window;
   Device                              m_device;
   DeviceContext                       m_deviceContext;
   SwapChain                           m_swapChain;
-  Texture                             m_backBuffer;
-  RenderTargetView                    m_renderTargetView;
-  Texture                             m_depthStencil;
-  DepthStencilView                    m_depthStencilView;
+  // El back buffer entra al frame graph como textura importada; la
+  // profundidad es una textura transitoria que crea y recicla el grafo.
+  FrameGraphTextureD3D11              m_backBuffer;
+  FrameGraph                          m_frameGraph;
+  D3D11FrameGraphBackend              m_frameGraphBackend{ m_device, m_deviceContext };
   Viewport                            m_viewport;
-  ShaderProgram                       m_shaderProgram;
-  MeshComponent												m_mesh;
-  Buffer															m_vertexBuffer;
-  Buffer															m_indexBuffer;
+  ShaderVariants                      m_shaderVariants;
+  D3DShaderCompiler                   m_shaderCompiler;
   Buffer															m_cbNeverChanges;
   Buffer															m_cbChangeOnResize;
   Buffer															m_cbChangesEveryFrame;
-  Texture 														m_textureCube;
   SamplerState                        m_samplerState;
 
   ModelLoader                         m_modelLoader;
-  LoadData                            LD;
+
+  // Carga en segundo plano: hasta que el modelo y la textura son residentes
+  // se dibuja un cubo provisional con una textura de tablero.
+  AsyncLoader                         m_asyncLoader;
+  AssetManager                        m_assets;
+  MeshHandle                          m_modelMesh;
+  TextureHandle                       m_modelTexture;
+  MeshComponent                       m_placeholderMesh;
+  Buffer                              m_placeholderVertexBuffer;
+  Buffer                              m_placeholderIndexBuffer;
+  Texture                             m_placeholderTexture;
+  unsigned int                        m_maxUploadsPerFrame = 2;
+  size_t                              m_uploadBudgetBytes = 16 * 1024 * 1024;
+  size_t                              m_textureBudgetBytes = 256 * 1024 * 1024;
+  float                               m_modelRadius = 0.0f;
 
   XMMATRIX                            m_World;
   XMMATRIX                            m_View;
@@ -117,4 +144,11 @@ private:
   CBChangeOnResize cbChangesOnResize;
   CBNeverChanges cbNeverChanges;
   CBChangesEveryFrame cb;
+
+  SystemClock                         m_clock;
+  FrameLoop                           m_frameLoop;
+  FramePacer                          m_framePacer;
+  double                              m_simulationTime = 0.0; // Tiempo simulado acumulado.
+  float                               m_previousYaw = 0.0f;   // Estado del paso anterior.
+  float                               m_currentYaw = 0.0f;    // Estado del paso actual.
 };
\ No newline at end of file
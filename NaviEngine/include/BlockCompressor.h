@@ -0,0 +1,176 @@
+#pragma once
+#include "MipGenerator.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file BlockCompressor.h
+ * @brief Codificador en CPU de texturas comprimidas por bloques (BC1, BC3, BC4, BC5 y BC7).
+ *
+ * La imagen se divide en bloques de 4x4 pxeles; las filas de bloques se
+ * reparten entre los hilos del JobSystem y, dentro de cada bloque, los 16
+ * pxeles se guardan por canal para evaluar proyecciones y distancias de
+ * cuatro en cuatro con SSE (con una versin escalar fuera de x86).
+ *
+ * BC7 solo emite el modo 6 (un subconjunto, RGBA con ndices de 4 bits), que
+ * es el que mejor calidad da por coste de bsqueda; el decodificador de
+ * referencia acepta nicamente ese modo.
+ *
+ * No depende de Windows ni de DirectX: los formatos se exponen con su valor
+ * numrico de DXGI para que Texture y los archivos DDS los usen directamente.
+ */
+
+/**
+ * @brief Formato comprimido de salida.
+ */
+enum
+BlockFormat {
+  BLOCK_NONE = 0, /**< Sin compresin (RGBA8). */
+  BLOCK_BC1 = 1,  /**< RGB 5:6:5 con alpha de 1 bit, 8 bytes por bloque. */
+  BLOCK_BC3 = 2,  /**< BC1 para el color ms alpha interpolado, 16 bytes por bloque. */
+  BLOCK_BC5 = 3,  /**< Dos canales (R, G) independientes, para mapas de normales. */
+  BLOCK_BC7 = 4,  /**< RGBA de alta calidad, 16 bytes por bloque. */
+  BLOCK_BC4 = 5   /**< Un canal (R), 8 bytes por bloque, para mscaras y alturas. */
+};
+
+/**
+ * @brief Preset de calidad/velocidad.
+ */
+enum
+BlockQuality {
+  BLOCK_QUALITY_FAST = 0,   /**< Extremos de la caja envolvente, sin refinamiento. */
+  BLOCK_QUALITY_NORMAL = 1, /**< Eje principal (PCA) y un refinamiento por mnimos cuadrados. */
+  BLOCK_QUALITY_HIGH = 2    /**< PCA, varios refinamientos y bsqueda de modos alternativos. */
+};
+
+/**
+ * @struct CompressedLevel
+ * @brief Un nivel de mip comprimido: bloques en orden de filas.
+ */
+struct
+CompressedLevel {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  std::vector<uint8_t> blocks;
+};
+
+/**
+ * @struct CompressedChain
+ * @brief Cadena de mips comprimida lista para crear la textura o escribir un DDS.
+ */
+struct
+CompressedChain {
+  BlockFormat format = BLOCK_NONE;
+  bool srgb = false;
+  std::vector<CompressedLevel> levels;
+
+  /**
+   * @brief Bytes de todos los niveles.
+   */
+  size_t
+  byteSize() const {
+    size_t bytes = 0;
+    for (const CompressedLevel& level : levels) {
+      bytes += level.blocks.size();
+    }
+    return bytes;
+  }
+};
+
+/**
+ * @brief Bytes por bloque de 4x4 (0 para BLOCK_NONE).
+ */
+size_t
+blockBytes(BlockFormat format);
+
+/**
+ * @brief Bytes de una fila de bloques de una imagen de @p width pxeles.
+ */
+size_t
+blockRowPitch(BlockFormat format, unsigned int width);
+
+/**
+ * @brief Tamao comprimido de una imagen @p width x @p height.
+ */
+size_t
+compressedSize(BlockFormat format, unsigned int width, unsigned int height);
+
+/**
+ * @brief Valor de DXGI_FORMAT correspondiente (0 = DXGI_FORMAT_UNKNOWN).
+ */
+uint32_t
+dxgiFormatOf(BlockFormat format, bool srgb);
+
+/**
+ * @brief Direct3D exige que el nivel 0 de una textura BC sea mltiplo de 4.
+ */
+bool
+canBlockCompress(unsigned int width, unsigned int height);
+
+/**
+ * @brief Comprime una imagen RGBA8.
+ *
+ * Los bloques del borde de imgenes que no son mltiplo de 4 repiten el ltimo
+ * pxel. BC4 codifica el canal R y BC5 los canales R y G.
+ *
+ * @param rgba Pxeles en orden de filas (4 bytes por pxel).
+ * @param width Ancho en pxeles.
+ * @param height Alto en pxeles.
+ * @param format Formato de salida.
+ * @param quality Preset de calidad.
+ * @param blocks Bloques resultantes (se redimensiona).
+ * @return false si la imagen est vaca o el formato es BLOCK_NONE.
+ */
+bool
+compressImage(const uint8_t* rgba,
+              unsigned int width,
+              unsigned int height,
+              BlockFormat format,
+              BlockQuality quality,
+              std::vector<uint8_t>& blocks);
+
+/**
+ * @brief Comprime todos los niveles de una cadena de mips.
+ * @param srgb Indica si el color est en sRGB (solo afecta al formato DXGI).
+ */
+bool
+compressMipChain(const MipChain& mips,
+                 BlockFormat format,
+                 BlockQuality quality,
+                 bool srgb,
+                 CompressedChain& chain);
+
+/**
+ * @brief Decodifica bloques a RGBA8 (referencia para medir la calidad).
+ *
+ * BC4 devuelve G = B = 0, BC5 devuelve B = 0 y ambos A = 255. En BC7 solo se
+ * admite el modo 6.
+ * @return false si algn bloque no se puede decodificar.
+ */
+bool
+decompressImage(const uint8_t* blocks,
+                unsigned int width,
+                unsigned int height,
+                BlockFormat format,
+                std::vector<uint8_t>& rgba);
+
+/**
+ * @brief PSNR en dB entre dos imgenes RGBA8.
+ * @param channelMask Canales comparados (bit 0 = R ... bit 3 = A).
+ * @return PSNR, o 99 dB si las imgenes son idnticas.
+ */
+double
+computePsnr(const uint8_t* reference,
+            const uint8_t* test,
+            size_t pixelCount,
+            unsigned int channelMask = 0xF);
+
+/**
+ * @brief Serializa la cadena como archivo DDS.
+ *
+ * BC1, BC3, BC4 y BC5 sin sRGB usan la cabecera clsica (DXT1, DXT5, ATI1,
+ * ATI2); BC7 y las variantes sRGB usan la extensin DX10.
+ */
+bool
+writeDds(const CompressedChain& chain, std::vector<uint8_t>& out);
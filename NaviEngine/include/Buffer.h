@@ -51,6 +51,32 @@ public:
   HRESULT
   init(Device& device, unsigned int ByteWidth);
 
+  /**
+   * @brief Inicializa un vertex buffer dinmico que la CPU reescribe cada frame
+   *        (p. ej. con los vrtices de skinMeshes()).
+   * @param device Referencia al dispositivo de renderizado.
+   * @param vertexCount Nmero de vrtices.
+   * @param stride Tamao en bytes de cada vrtice.
+   * @return HRESULT que indica el resultado de la creacin.
+   */
+  HRESULT
+  initDynamic(Device& device, unsigned int vertexCount, unsigned int stride);
+
+  /**
+   * @brief Mapea un buffer dinmico descartando su contenido anterior.
+   * @param deviceContext Contexto del dispositivo.
+   * @return Puntero de solo escritura al contenido, o nullptr si falla.
+   */
+  void*
+  map(DeviceContext& deviceContext);
+
+  /**
+   * @brief Termina la escritura empezada con map().
+   * @param deviceContext Contexto del dispositivo.
+   */
+  void
+  unmap(DeviceContext& deviceContext);
+
   /**
    * @brief Actualiza el contenido del buffer con nuevos datos.
    * @param deviceContext Contexto del dispositivo para la actualizacin.
@@ -117,4 +143,7 @@ private:
   /** @brief Bandera que indica el tipo de enlace (bind flag) del buffer. */
   unsigned int m_bindFlag = 0;
 
+  /** @brief Tamao en bytes de un buffer dinmico (0 en el resto). */
+  unsigned int m_dynamicBytes = 0;
+
 };
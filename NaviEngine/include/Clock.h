@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+
+/**
+ * @file Clock.h
+ * @brief Relojes monotnicos de alta resolucin usados por el ciclo principal.
+ *
+ * Estas clases no dependen de Windows ni de DirectX, de modo que el ciclo de
+ * frames puede ejecutarse sin ventana (por ejemplo, con un reloj simulado).
+ */
+
+/**
+ * @class Clock
+ * @brief Interfaz de un reloj monotnico expresado en segundos.
+ */
+class
+Clock {
+public:
+  /**
+   * @brief Destructor virtual por defecto.
+   */
+  virtual
+  ~Clock() = default;
+
+  /**
+   * @brief Devuelve el tiempo actual en segundos desde un origen arbitrario.
+   * @return Tiempo monotnico en segundos.
+   */
+  virtual double
+  now() const = 0;
+};
+
+/**
+ * @class SystemClock
+ * @brief Reloj del sistema basado en std::chrono::steady_clock.
+ *
+ * En Windows steady_clock se implementa sobre QueryPerformanceCounter, por lo que
+ * la resolucin es de microsegundos o mejor en todas las plataformas.
+ */
+class
+SystemClock : public Clock {
+public:
+  /**
+   * @brief Constructor. Toma el instante de creacin como origen de tiempo.
+   */
+  SystemClock() : m_start(std::chrono::steady_clock::now()) {}
+
+  /**
+   * @brief Segundos transcurridos desde la creacin del reloj.
+   */
+  double
+  now() const override {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+  }
+
+private:
+  /** @brief Instante de referencia del reloj. */
+  std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * @class ManualClock
+ * @brief Reloj simulado que solo avanza cuando se le indica.
+ *
+ * Se usa para ejecutar el ciclo de frames de forma determinista sin ventana.
+ */
+class
+ManualClock : public Clock {
+public:
+  /**
+   * @brief Devuelve el tiempo simulado actual.
+   */
+  double
+  now() const override { return m_time; }
+
+  /**
+   * @brief Avanza el reloj simulado.
+   * @param seconds Segundos a sumar al tiempo actual.
+   */
+  void
+  advance(double seconds) { m_time += seconds; }
+
+  /**
+   * @brief Fija el tiempo simulado a un valor absoluto.
+   * @param seconds Nuevo tiempo en segundos.
+   */
+  void
+  set(double seconds) { m_time = seconds; }
+
+private:
+  /** @brief Tiempo simulado en segundos. */
+  double m_time = 0.0;
+};
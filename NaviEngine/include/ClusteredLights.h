@@ -0,0 +1,238 @@
+#pragma once
+#include "SimdMath.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file ClusteredLights.h
+ * @brief Asignacin de luces puntuales y focos a clusters (froxels) en la CPU.
+ *
+ * El frustum de vista se divide en tilesX x tilesY tiles de pantalla y en
+ * `slices` cortes de profundidad exponenciales. Cada frame, assign() pasa las
+ * luces a espacio de vista y prueba cada una contra el AABB de los clusters:
+ * esfera contra AABB para todas y, en los focos, adems cono contra la esfera
+ * envolvente del cluster. Cada luz se recorta una sola vez contra el frustum y
+ * se apunta en los cortes que alcanza; dentro de un corte solo se prueba contra
+ * las filas y columnas de tiles a su alcance, de cuatro tiles a la vez (SoA con
+ * SimdMath). Cada corte de profundidad es una tarea de JobSystem.
+ *
+ * El resultado est listo para subir tal cual:
+ * - ranges(): un ClusterRange (uint2 en HLSL) por cluster, con ndice
+ *   x + y * tilesX + slice * tilesX * tilesY; la fila 0 es la superior.
+ * - lightIndices(): lista compacta de ndices al array de luces de assign().
+ *
+ * En el shader, con la posicin en pxeles y la profundidad de vista z:
+ *   slice = floor(log2(z) * sliceScale() + sliceBias())
+ *   tile  = floor(pixel * tiles / resolucin)
+ */
+
+/**
+ * @brief Tipo de luz.
+ */
+enum
+ClusterLightType {
+  CLUSTER_LIGHT_POINT = 0,
+  CLUSTER_LIGHT_SPOT = 1
+};
+
+/**
+ * @struct ClusterLight
+ * @brief Luz en espacio de mundo; 48 bytes, misma disposicin que en el shader.
+ */
+struct
+ClusterLight {
+  SimdMath::Float3 position;
+  float range = 0.0f;               /**< Radio de influencia. */
+  SimdMath::Float3 direction;       /**< Direccin del foco (normalizada). */
+  float spotCosine = -1.0f;         /**< Coseno del semingulo exterior del foco. */
+  SimdMath::Float3 color;
+  uint32_t type = CLUSTER_LIGHT_POINT;
+};
+
+/**
+ * @struct ClusterRange
+ * @brief Luces de un cluster: lightIndices()[offset .. offset + count).
+ */
+struct
+ClusterRange {
+  uint32_t offset = 0;
+  uint32_t count = 0;
+};
+
+/**
+ * @struct ClusterGridDesc
+ * @brief Subdivisin del frustum y proyeccin que cubre.
+ */
+struct
+ClusterGridDesc {
+  unsigned int tilesX = 16;         /**< tilesX * tilesY, 65536 como mucho. */
+  unsigned int tilesY = 9;
+  unsigned int slices = 24;
+  float fovY = 0.785398163f;        /**< Campo de visin vertical (radianes). */
+  float aspect = 16.0f / 9.0f;
+  float nearZ = 0.1f;
+  float farZ = 100.0f;
+  size_t maxLightIndices = 1 << 20; /**< Capacidad de la lista de ndices. */
+};
+
+/**
+ * @struct ClusterStats
+ * @brief Resumen de la ltima asignacin.
+ */
+struct
+ClusterStats {
+  size_t lights = 0;
+  size_t lightIndices = 0;          /**< Entradas escritas en lightIndices(). */
+  size_t droppedIndices = 0;        /**< Entradas que no cupieron en maxLightIndices. */
+  unsigned int maxLightsPerCluster = 0;
+  unsigned int occupiedClusters = 0;
+};
+
+/**
+ * @class ClusteredLights
+ * @brief Rejilla de clusters y su asignacin de luces.
+ */
+class
+ClusteredLights {
+public:
+  ClusteredLights() = default;
+  ~ClusteredLights() = default;
+
+  /**
+   * @brief Calcula los AABB de los clusters en espacio de vista.
+   *
+   * Solo hay que repetirlo si cambia la proyeccin o la subdivisin.
+   * @param error Si no es nulo, recibe la causa del fallo.
+   * @return false si la descripcin no es vlida.
+   */
+  bool
+  init(const ClusterGridDesc& desc, std::string* error = nullptr);
+
+  /**
+   * @brief Asigna las luces a los clusters.
+   * @param lights Luces en espacio de mundo.
+   * @param view Matriz de vista (mundo -> vista, mano izquierda).
+   * @param parallel Reparte los cortes de profundidad entre los hilos de JobSystem.
+   */
+  void
+  assign(const ClusterLight* lights, size_t count, const SimdMath::Matrix& view, bool parallel = true);
+
+  const std::vector<ClusterRange>&
+  ranges() const { return m_ranges; }
+
+  const std::vector<uint32_t>&
+  lightIndices() const { return m_lightIndices; }
+
+  const ClusterStats&
+  stats() const { return m_stats; }
+
+  const ClusterGridDesc&
+  desc() const { return m_desc; }
+
+  unsigned int
+  clusterCount() const { return m_desc.tilesX * m_desc.tilesY * m_desc.slices; }
+
+  unsigned int
+  clusterIndex(unsigned int x, unsigned int y, unsigned int slice) const {
+    return x + (y + slice * m_desc.tilesY) * m_desc.tilesX;
+  }
+
+  /**
+   * @brief AABB de un cluster en espacio de vista.
+   */
+  const SimdMath::Aabb&
+  clusterBounds(unsigned int cluster) const { return m_clusterBounds[cluster]; }
+
+  /**
+   * @brief Corte de profundidad de una z de vista (puede quedar fuera de [0, slices)).
+   */
+  int
+  slice(float viewZ) const;
+
+  /** @brief Constantes del shader: slice = floor(log2(z) * sliceScale + sliceBias). */
+  float
+  sliceScale() const { return m_sliceScale; }
+
+  float
+  sliceBias() const { return m_sliceBias; }
+
+private:
+  /**
+   * @brief Luz en espacio de vista, con el mismo ndice que en assign().
+   *
+   * Los campos de la prueba de esfera van primero: cada corte lee solo las
+   * luces que le tocan, y as cada una suele costar una nica lnea de cach.
+   */
+  struct
+  ViewLight {
+    float x, y, z, radiusSq;
+    float reach;                    /**< Alcance con holgura para los descartes por intervalo. */
+    uint32_t spot;
+    float dirX, dirY, dirZ, cosine, sine, range;
+  };
+
+  /**
+   * @brief Cajas y esferas envolventes de los tiles en SoA.
+   *
+   * Las caras de un froxel tienen x/z, y/z o z constantes, as que su caja en
+   * x solo depende del corte y la columna, en y del corte y la fila, y en z
+   * del corte (m_sliceBounds): la prueba esfera-caja se separa por ejes. Las
+   * tablas por columna y por fila llevan relleno al final, con mnimo infinito
+   * en las columnas, para leer varias seguidas desde cualquier posicin.
+   */
+  struct
+  TileLanes {
+    std::vector<float> minX, maxX, centerX;   /**< m_columnStride por corte. */
+    std::vector<float> minY, maxY, centerY;   /**< m_rowStride por corte. */
+    std::vector<float> radius;                /**< Por corte y fila, m_columnStride por fila. */
+
+    void
+    resize(unsigned int slices, unsigned int rows, unsigned int columnStride, unsigned int rowStride);
+  };
+
+  /**
+   * @brief Trminos por eje de la luz en curso: distancia a la caja al
+   *        cuadrado, distancia al centro al cuadrado y proyeccin sobre el foco.
+   */
+  struct
+  AxisTerms {
+    std::vector<float> distanceSq, lengthSq, along;
+
+    void
+    resize(size_t count);
+  };
+
+  /**
+   * @brief Estado de un corte de profundidad; cada tarea usa solo el suyo.
+   */
+  struct
+  SliceWork {
+    std::vector<uint32_t> lights;       /**< Luces que alcanzan el corte, en orden. */
+    std::vector<uint16_t> hitClusters;  /**< Aciertos en orden de luz: cluster local... */
+    std::vector<uint32_t> hitLights;    /**< ...y luz. */
+    std::vector<uint32_t> indices;
+    AxisTerms columns;
+    AxisTerms rows;
+  };
+
+  void
+  assignSlice(unsigned int slice);
+
+  ClusterGridDesc m_desc;
+  float m_sliceScale = 0.0f;
+  float m_sliceBias = 0.0f;
+  std::vector<SimdMath::Aabb> m_clusterBounds;
+  TileLanes m_tiles;
+  unsigned int m_columnStride = 0;
+  unsigned int m_rowStride = 0;
+  float m_tanX = 0.0f;                             /**< Tangentes del semingulo de la proyeccin. */
+  float m_tanY = 0.0f;
+  std::vector<SimdMath::Aabb> m_sliceBounds;
+  std::vector<float> m_sliceFar;                   /**< Fondo de cada corte, relleno con infinito. */
+  std::vector<SliceWork> m_work;
+  std::vector<ViewLight> m_viewLights;
+  std::vector<ClusterRange> m_ranges;
+  std::vector<uint32_t> m_lightIndices;
+  ClusterStats m_stats;
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file DdsFile.h
+ * @brief Lector de archivos DDS que no copia los pxeles.
+ *
+ * Interpreta las cabeceras clsicas (DX9, con FourCC o mscaras de bits) y la
+ * extensin DX10, y describe cada subrecurso (mip de cada elemento del array
+ * o cara del cubemap) con un puntero al interior del bfer de entrada. Con un
+ * MappedFile como entrada, Texture crea los D3D11_SUBRESOURCE_DATA apuntando
+ * directamente a la proyeccin del archivo.
+ *
+ * No depende de Windows ni de DirectX: los formatos se exponen con su valor
+ * numrico de DXGI_FORMAT.
+ */
+
+/**
+ * @brief Dimensin del recurso (mismos valores que D3D11_RESOURCE_DIMENSION).
+ */
+enum
+DdsDimension {
+  DDS_TEXTURE1D = 2,
+  DDS_TEXTURE2D = 3,
+  DDS_TEXTURE3D = 4
+};
+
+/**
+ * @struct DdsSurface
+ * @brief Un subrecurso: un nivel de mip de un elemento del array (o cara).
+ */
+struct
+DdsSurface {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  unsigned int depth = 1;
+  const uint8_t* data = nullptr; /**< Apunta dentro del bfer pasado a parseDds(). */
+  size_t rowPitch = 0;           /**< Bytes por fila (de bloques, en formatos BC). */
+  size_t slicePitch = 0;         /**< Bytes por corte de profundidad. */
+};
+
+/**
+ * @struct DdsImage
+ * @brief Descripcin de un archivo DDS ya validado.
+ */
+struct
+DdsImage {
+  uint32_t dxgiFormat = 0;
+  DdsDimension dimension = DDS_TEXTURE2D;
+  unsigned int width = 0;
+  unsigned int height = 0;
+  unsigned int depth = 1;
+  unsigned int mipLevels = 1;
+  unsigned int arraySize = 1; /**< Elementos del array (cubemaps: nmero de cubos). */
+  bool cubemap = false;
+
+  /**
+   * @brief Subrecursos en el orden de D3D11CalcSubresource: mip + slice * mipLevels.
+   */
+  std::vector<DdsSurface> surfaces;
+
+  /**
+   * @brief Nmero de texturas 2D del array (6 por cubo en los cubemaps).
+   */
+  unsigned int
+  sliceCount() const { return arraySize * (cubemap ? 6 : 1); }
+
+  /**
+   * @brief Subrecurso de un mip de un elemento del array.
+   */
+  const DdsSurface&
+  surface(unsigned int mip, unsigned int slice) const { return surfaces[slice * mipLevels + mip]; }
+};
+
+/**
+ * @brief Interpreta un archivo DDS completo en memoria.
+ *
+ * Admite formatos BC1-BC7, los formatos sin comprimir de tamao fijo por
+ * pxel, arrays, cubemaps completos y volmenes. Los punteros de @p image
+ * solo son vlidos mientras @p data siga vivo.
+ *
+ * @param data Contenido del archivo.
+ * @param size Bytes de @p data.
+ * @param image Descripcin resultante.
+ * @param error Motivo del rechazo (opcional).
+ * @return false si el archivo est truncado, es invlido o usa un formato no admitido.
+ */
+bool
+parseDds(const uint8_t* data, size_t size, DdsImage& image, std::string* error = nullptr);
+
+/**
+ * @brief Bits por pxel de un formato DXGI sin comprimir (0 si es BC o no se admite).
+ */
+unsigned int
+dxgiBitsPerPixel(uint32_t dxgiFormat);
+
+/**
+ * @brief Bytes por bloque de 4x4 de un formato BC (0 si no es comprimido).
+ */
+unsigned int
+dxgiBlockBytes(uint32_t dxgiFormat);
@@ -56,6 +56,26 @@ public:
                       ID3D11RenderTargetView* const* ppRenderTargetViews,
                       ID3D11DepthStencilView* pDepthStencilView);
 
+  /**
+   * @brief Desenlaza todos los render targets y el depth-stencil.
+   *
+   * Es necesario antes de leer como SRV una textura que se acaba de escribir.
+   */
+  void
+  OMUnbindRenderTargets();
+
+  /**
+   * @brief Desenlaza un rango de slots de recursos del Pixel Shader.
+   *
+   * Es necesario antes de escribir en una textura que se estaba leyendo.
+   *
+   * @param StartSlot Slot inicial.
+   * @param NumViews Nmero de slots a vaciar.
+   */
+  void
+  PSUnbindShaderResources(unsigned int StartSlot,
+                          unsigned int NumViews);
+
   /**
    * @brief Define los viewports activos en el rasterizador.
    *
@@ -128,6 +148,30 @@ public:
                     unsigned int SrcRowPitch,
                     unsigned int SrcDepthPitch);
 
+  /**
+   * @brief Mapea un recurso dinmico para escribirlo desde la CPU.
+   *
+   * @param pResource Recurso a mapear.
+   * @param Subresource Subrecurso a mapear.
+   * @param MapType Tipo de acceso (p. ej. D3D11_MAP_WRITE_DISCARD).
+   * @param pMappedResource Recibe el puntero y los pitches.
+   * @return HRESULT que indica el resultado de la operacin.
+   */
+  HRESULT
+  Map(ID3D11Resource* pResource,
+      unsigned int Subresource,
+      D3D11_MAP MapType,
+      D3D11_MAPPED_SUBRESOURCE* pMappedResource);
+
+  /**
+   * @brief Deshace un Map() anterior.
+   *
+   * @param pResource Recurso mapeado.
+   * @param Subresource Subrecurso mapeado.
+   */
+  void
+  Unmap(ID3D11Resource* pResource, unsigned int Subresource);
+
   /**
    * @brief Limpia un render target con un color especfico.
    *
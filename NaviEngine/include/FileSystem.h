@@ -0,0 +1,228 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+class
+MappedFile;
+
+/**
+ * @file FileSystem.h
+ * @brief Sistema de archivos virtual de solo lectura: carpetas sueltas y archivos .pak.
+ *
+ * Los cargadores (ModelLoader, Texture, ShaderProgram, AsyncLoader) piden los
+ * archivos por ruta a VirtualFileSystem y reciben un FileView: un rango de bytes
+ * de solo lectura que mantiene vivo su origen. Si el archivo viene de una
+ * proyeccin en memoria (carpeta o .pak sin comprimir) la vista apunta dentro
+ * de ella y no se copia nada.
+ *
+ * Las fuentes montadas se consultan de la ltima a la primera; si ninguna tiene
+ * la ruta se lee como archivo suelto relativo al directorio de trabajo, igual
+ * que antes de existir el VFS. No depende de Windows ni de DirectX.
+ */
+
+/**
+ * @class FileView
+ * @brief Contenido de un archivo abierto por el VFS.
+ *
+ * Se copia como un puntero compartido: todas las copias ven los mismos bytes,
+ * que siguen siendo vlidos mientras exista alguna.
+ */
+class
+FileView {
+public:
+  /**
+   * @brief Vista vaca.
+   */
+  FileView() = default;
+
+  /**
+   * @brief Vista de [data, data + size) dentro de una proyeccin.
+   * @param mapping Proyeccin que contiene los bytes (para prefetch()).
+   */
+  FileView(std::shared_ptr<const MappedFile> mapping, const uint8_t* data, size_t size);
+
+  /**
+   * @brief Vista de un bfer propio (por ejemplo, un archivo descomprimido).
+   */
+  explicit
+  FileView(std::vector<uint8_t>&& bytes);
+
+  const uint8_t*
+  data() const { return m_data; }
+
+  size_t
+  size() const { return m_size; }
+
+  bool
+  empty() const { return m_data == nullptr; }
+
+  /**
+   * @brief Indica si los bytes se leen directamente de una proyeccin (sin copia).
+   */
+  bool
+  isMapped() const { return m_mapping != nullptr; }
+
+  /**
+   * @brief Trae a memoria las pginas de [offset, offset + size) de una vista proyectada.
+   */
+  void
+  prefetch(size_t offset, size_t size) const;
+
+  /**
+   * @brief Como prefetch(offset, size) para toda la vista.
+   */
+  void
+  prefetch() const { prefetch(0, m_size); }
+
+  /**
+   * @brief Suelta los bytes.
+   */
+  void
+  reset();
+
+private:
+  /** @brief Dueo de los bytes (MappedFile o std::vector<uint8_t>). */
+  std::shared_ptr<const void> m_owner;
+
+  /** @brief Proyeccin que contiene la vista, o nullptr si los bytes son propios. */
+  const MappedFile* m_mapping = nullptr;
+
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+/**
+ * @class FileViewBuffer
+ * @brief std::streambuf sobre un FileView, para parsear con std::istream sin copiar el archivo.
+ */
+class
+FileViewBuffer : public std::streambuf {
+public:
+  explicit
+  FileViewBuffer(const FileView& view) {
+    char* begin = const_cast<char*>(reinterpret_cast<const char*>(view.data()));
+    setg(begin, begin, begin + view.size());
+  }
+};
+
+/**
+ * @class FileSource
+ * @brief Origen de archivos montable en el VFS.
+ */
+class
+FileSource {
+public:
+  virtual
+  ~FileSource() = default;
+
+  /**
+   * @brief Abre @p path. Puede llamarse desde varios hilos a la vez.
+   * @return false si el origen no tiene la ruta o no puede leerla.
+   */
+  virtual bool
+  open(const std::string& path, FileView& view) const = 0;
+
+  /**
+   * @brief Indica si el origen tiene la ruta, sin abrirla.
+   */
+  virtual bool
+  exists(const std::string& path) const = 0;
+};
+
+/**
+ * @class DirectorySource
+ * @brief Archivos sueltos bajo una carpeta, proyectados en memoria con MappedFile.
+ */
+class
+DirectorySource : public FileSource {
+public:
+  /**
+   * @param root Carpeta raz; las rutas se resuelven como root + "/" + path ("" = directorio de trabajo).
+   */
+  explicit
+  DirectorySource(const std::string& root = std::string());
+
+  bool
+  open(const std::string& path, FileView& view) const override;
+
+  bool
+  exists(const std::string& path) const override;
+
+private:
+  std::string
+  resolve(const std::string& path) const;
+
+private:
+  std::string m_root;
+};
+
+/**
+ * @class VirtualFileSystem
+ * @brief Punto nico de acceso a archivos del motor (singleton).
+ */
+class
+VirtualFileSystem {
+public:
+  static VirtualFileSystem&
+  instance();
+
+  VirtualFileSystem(const VirtualFileSystem&) = delete;
+  VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+  /**
+   * @brief Monta un origen por encima de los ya montados.
+   */
+  void
+  mount(std::shared_ptr<FileSource> source);
+
+  /**
+   * @brief Abre y monta un archivo .pak.
+   * @return false si no existe o no es un .pak vlido.
+   */
+  bool
+  mountPak(const std::string& path);
+
+  /**
+   * @brief Desmonta todo (las vistas ya abiertas siguen siendo vlidas).
+   */
+  void
+  unmountAll();
+
+  /**
+   * @brief Abre @p path en el origen montado ms reciente que lo tenga, o como archivo suelto.
+   */
+  bool
+  open(const std::string& path, FileView& view) const;
+
+  bool
+  exists(const std::string& path) const;
+
+  /**
+   * @brief Lee @p path como texto.
+   */
+  bool
+  readText(const std::string& path, std::string& text) const;
+
+private:
+  VirtualFileSystem() = default;
+
+  ~VirtualFileSystem() = default;
+
+  std::vector<std::shared_ptr<FileSource>>
+  sources() const;
+
+private:
+  /** @brief Protege m_sources; las bsquedas trabajan sobre una copia. */
+  mutable std::mutex m_mutex;
+
+  /** @brief Orgenes montados, del ms antiguo al ms reciente. */
+  std::vector<std::shared_ptr<FileSource>> m_sources;
+
+  /** @brief Archivos sueltos relativos al directorio de trabajo. */
+  DirectorySource m_loose;
+};
@@ -0,0 +1,501 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @file FrameGraph.h
+ * @brief Grafo de frame: pases que declaran lo que leen y escriben.
+ *
+ * Cada frame se describe de nuevo: addPass() ejecuta en el acto la funcin de
+ * configuracin del pase, que declara sus texturas con FrameGraphBuilder, y
+ * guarda la de ejecucin. compile() es un paso puro de CPU (sin dispositivo):
+ * - descarta los pases cuyo resultado nadie usa,
+ * - calcula la vida de cada textura transitoria (primer y ltimo pase),
+ * - asigna las texturas que no coinciden en el tiempo a la misma textura
+ *   fsica (mismo tamao y formato) y, para APIs con recursos colocados, a
+ *   desplazamientos de un heap compartido,
+ * - y ordena las transiciones de estado que necesita cada pase.
+ * execute() pide las texturas fsicas a un FrameGraphBackend (conservadas entre
+ * frames) y llama a los pases supervivientes en el orden en que se aadieron.
+ *
+ * Las escrituras crean versiones: write() devuelve un handle nuevo que los pases
+ * siguientes deben leer. As un pase que dibuja sobre un resultado anterior
+ * (modify()) no lo mantiene vivo por s mismo si nadie lee su salida.
+ */
+
+/**
+ * @brief Uso de una textura dentro de un pase. Es tambin su estado en las transiciones.
+ */
+enum
+FrameGraphAccess {
+  FRAME_GRAPH_ACCESS_NONE = 0,              /**< Sin estado: contenido indefinido. */
+  FRAME_GRAPH_ACCESS_RENDER_TARGET = 1,     /**< Escritura como render target. */
+  FRAME_GRAPH_ACCESS_DEPTH_WRITE = 2,       /**< Escritura de profundidad/plantilla. */
+  FRAME_GRAPH_ACCESS_DEPTH_READ = 3,        /**< Prueba de profundidad sin escritura. */
+  FRAME_GRAPH_ACCESS_SHADER_READ = 4,       /**< Lectura desde un shader (SRV). */
+  FRAME_GRAPH_ACCESS_UNORDERED_ACCESS = 5,  /**< Lectura/escritura desde un compute shader (UAV). */
+  FRAME_GRAPH_ACCESS_COPY_SOURCE = 6,       /**< Origen de una copia o resolve. */
+  FRAME_GRAPH_ACCESS_COPY_DEST = 7,         /**< Destino de una copia o resolve. */
+  FRAME_GRAPH_ACCESS_PRESENT = 8,           /**< Back buffer listo para Present. */
+  FRAME_GRAPH_ACCESS_COUNT = 9
+};
+
+/**
+ * @brief Nombre del acceso, para mensajes de error y volcados.
+ */
+const char*
+frameGraphAccessName(FrameGraphAccess access);
+
+/**
+ * @brief Indica si el acceso modifica la textura.
+ */
+bool
+isFrameGraphWrite(FrameGraphAccess access);
+
+/**
+ * @struct FrameGraphTextureDesc
+ * @brief Descripcin de una textura 2D del grafo.
+ */
+struct
+FrameGraphTextureDesc {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  uint32_t format = 0;             /**< Valor numrico de DXGI_FORMAT. */
+  unsigned int sampleCount = 1;
+  unsigned int sampleQuality = 0;
+
+  bool
+  operator==(const FrameGraphTextureDesc& other) const {
+    return width == other.width && height == other.height && format == other.format &&
+           sampleCount == other.sampleCount && sampleQuality == other.sampleQuality;
+  }
+
+  bool
+  operator!=(const FrameGraphTextureDesc& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Bytes aproximados de una textura (sin relleno ni alineacin del driver).
+ */
+uint64_t
+frameGraphTextureBytes(const FrameGraphTextureDesc& desc);
+
+/**
+ * @struct FrameGraphHandle
+ * @brief Versin de una textura del grafo.
+ */
+struct
+FrameGraphHandle {
+  static const uint32_t kInvalid = 0xFFFFFFFFu;
+
+  uint32_t index = kInvalid;
+
+  bool
+  valid() const { return index != kInvalid; }
+};
+
+/**
+ * @struct FrameGraphBarrier
+ * @brief Transicin de una textura antes de un pase.
+ */
+struct
+FrameGraphBarrier {
+  FrameGraphHandle resource;
+  FrameGraphAccess before = FRAME_GRAPH_ACCESS_NONE;
+  FrameGraphAccess after = FRAME_GRAPH_ACCESS_NONE;
+  bool aliasing = false;   /**< Primer uso de una textura fsica que antes tena otra. */
+};
+
+/**
+ * @struct FrameGraphStats
+ * @brief Resumen de la ltima compilacin.
+ */
+struct
+FrameGraphStats {
+  unsigned int passes = 0;
+  unsigned int culledPasses = 0;
+  unsigned int transientTextures = 0;   /**< Transitorias que usa algn pase superviviente. */
+  unsigned int physicalTextures = 0;    /**< Texturas fsicas tras compartir por descripcin. */
+  unsigned int barriers = 0;
+  uint64_t transientBytes = 0;          /**< Suma de todas las transitorias sin compartir. */
+  uint64_t physicalBytes = 0;           /**< Suma de las texturas fsicas. */
+  uint64_t heapBytes = 0;               /**< Tamao del heap con las transitorias colocadas. */
+};
+
+class
+FrameGraph;
+
+/**
+ * @class FrameGraphBackend
+ * @brief Crea las texturas fsicas y aplica las transiciones de un API concreto.
+ */
+class
+FrameGraphBackend {
+public:
+  /**
+   * @brief Destructor virtual por defecto.
+   */
+  virtual
+  ~FrameGraphBackend() = default;
+
+  /**
+   * @brief Crea una textura fsica.
+   * @param accessMask OR de (1 << FrameGraphAccess) con todos los usos que tendr.
+   * @return Objeto opaco que reciben los pases, o nullptr si falla.
+   */
+  virtual void*
+  createTexture(const FrameGraphTextureDesc& desc, uint32_t accessMask) = 0;
+
+  /**
+   * @brief Destruye una textura creada con createTexture().
+   */
+  virtual void
+  destroyTexture(void* texture) = 0;
+
+  /**
+   * @brief Aplica una transicin antes de un pase.
+   */
+  virtual void
+  barrier(const FrameGraphBarrier& barrier, void* texture) {
+    (void)barrier;
+    (void)texture;
+  }
+};
+
+/**
+ * @class FrameGraphBuilder
+ * @brief Declaraciones de un pase durante su configuracin.
+ */
+class
+FrameGraphBuilder {
+public:
+  /**
+   * @brief Crea una textura transitoria; su primera versin no tiene contenido.
+   */
+  FrameGraphHandle
+  createTexture(const std::string& name, const FrameGraphTextureDesc& desc);
+
+  /**
+   * @brief Lee una versin de una textura.
+   */
+  FrameGraphHandle
+  read(FrameGraphHandle handle, FrameGraphAccess access = FRAME_GRAPH_ACCESS_SHADER_READ);
+
+  /**
+   * @brief Escribe una textura sin conservar su contenido.
+   * @return La versin nueva, la que deben leer los pases siguientes.
+   */
+  FrameGraphHandle
+  write(FrameGraphHandle handle, FrameGraphAccess access = FRAME_GRAPH_ACCESS_RENDER_TARGET);
+
+  /**
+   * @brief Dibuja sobre el contenido anterior: lee @p handle y devuelve la versin nueva.
+   */
+  FrameGraphHandle
+  modify(FrameGraphHandle handle, FrameGraphAccess access = FRAME_GRAPH_ACCESS_RENDER_TARGET);
+
+  /**
+   * @brief El pase nunca se descarta aunque nadie use lo que escribe.
+   */
+  void
+  sideEffect();
+
+private:
+  friend class FrameGraph;
+
+  FrameGraphBuilder(FrameGraph& graph, uint32_t pass) : m_graph(graph), m_pass(pass) {}
+
+  FrameGraph& m_graph;
+  uint32_t m_pass;
+};
+
+/**
+ * @class FrameGraphPassContext
+ * @brief Acceso a las texturas fsicas durante la ejecucin de un pase.
+ */
+class
+FrameGraphPassContext {
+public:
+  /**
+   * @brief Textura fsica (objeto del backend) de una versin.
+   */
+  void*
+  physical(FrameGraphHandle handle) const;
+
+  /**
+   * @brief physical() convertido al tipo del backend.
+   */
+  template<typename T>
+  T*
+  texture(FrameGraphHandle handle) const { return static_cast<T*>(physical(handle)); }
+
+  /**
+   * @brief Descripcin de la textura de una versin.
+   */
+  const FrameGraphTextureDesc&
+  desc(FrameGraphHandle handle) const;
+
+  /**
+   * @brief Nombre del pase en ejecucin.
+   */
+  const std::string&
+  passName() const;
+
+private:
+  friend class FrameGraph;
+
+  FrameGraphPassContext(const FrameGraph& graph, uint32_t pass) : m_graph(graph), m_pass(pass) {}
+
+  const FrameGraph& m_graph;
+  uint32_t m_pass;
+};
+
+/**
+ * @class FrameGraph
+ * @brief Grafo de pases de un frame y su compilacin.
+ *
+ * El objeto vive entre frames: reset() vaca los pases y las texturas del
+ * frame, pero conserva las texturas fsicas para reutilizarlas. Una textura
+ * fsica que no se usa durante kPoolFrames frames se destruye.
+ */
+class
+FrameGraph {
+public:
+  using SetupFunction = std::function<void(FrameGraphBuilder&)>;
+  using ExecuteFunction = std::function<void(FrameGraphPassContext&)>;
+
+  /** @brief Frames que una textura fsica sin uso se conserva antes de destruirla. */
+  static const unsigned int kPoolFrames = 3;
+
+  /** @brief Alineacin de las texturas dentro del heap (la de D3D12 y Vulkan). */
+  static const uint64_t kHeapAlignment = 64 * 1024;
+
+  FrameGraph() = default;
+  ~FrameGraph() = default;
+
+  FrameGraph(const FrameGraph&) = delete;
+  FrameGraph& operator=(const FrameGraph&) = delete;
+
+  /**
+   * @brief Vaca los pases y texturas del frame. Conserva las texturas fsicas.
+   */
+  void
+  reset();
+
+  /**
+   * @brief Registra una textura externa (p. ej. el back buffer). Nunca se comparte
+   *        y los pases que la escriben no se descartan.
+   * @param physical Objeto del backend que recibirn los pases.
+   * @param initialAccess Estado al empezar el frame.
+   * @param finalAccess Estado en que debe quedar (NONE = el del ltimo pase).
+   */
+  FrameGraphHandle
+  importTexture(const std::string& name,
+                const FrameGraphTextureDesc& desc,
+                void* physical,
+                FrameGraphAccess initialAccess,
+                FrameGraphAccess finalAccess = FRAME_GRAPH_ACCESS_NONE);
+
+  /**
+   * @brief Aade un pase. @p setup se ejecuta aqu mismo; @p execute en execute().
+   * @return ndice del pase.
+   */
+  uint32_t
+  addPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+  /**
+   * @brief Descarta pases, calcula vidas, comparte texturas y ordena transiciones.
+   * @param error Si no es nulo, recibe la causa del fallo.
+   * @return false si el grafo es invlido (lectura sin escritura previa, handles
+   *         de otro frame o accesos incompatibles en un mismo pase).
+   */
+  bool
+  compile(std::string* error = nullptr);
+
+  /**
+   * @brief Ejecuta los pases supervivientes. Requiere compile().
+   *
+   * Usar siempre el mismo backend: las texturas fsicas le pertenecen.
+   * @return false si el backend no pudo crear alguna textura.
+   */
+  bool
+  execute(FrameGraphBackend& backend);
+
+  /**
+   * @brief Destruye las texturas fsicas conservadas.
+   */
+  void
+  destroy(FrameGraphBackend& backend);
+
+  /**
+   * @brief Resumen de la ltima compilacin.
+   */
+  const FrameGraphStats&
+  stats() const { return m_stats; }
+
+  unsigned int
+  passCount() const { return static_cast<unsigned int>(m_passes.size()); }
+
+  /**
+   * @brief Indica si compile() descart el pase.
+   */
+  bool
+  isCulled(uint32_t pass) const { return m_passes[pass].culled; }
+
+  /**
+   * @brief Transiciones que se aplican antes del pase.
+   */
+  const std::vector<FrameGraphBarrier>&
+  barriers(uint32_t pass) const { return m_passes[pass].barriers; }
+
+  /**
+   * @brief Transiciones que se aplican tras el ltimo pase (finalAccess de las importadas).
+   */
+  const std::vector<FrameGraphBarrier>&
+  finalBarriers() const { return m_finalBarriers; }
+
+  /**
+   * @brief Primer y ltimo pase que usan la textura de @p handle (-1 si ninguno).
+   */
+  void
+  lifetime(FrameGraphHandle handle, int& firstPass, int& lastPass) const;
+
+  /**
+   * @brief Textura fsica asignada (-1 para importadas o sin uso).
+   */
+  int
+  physicalIndex(FrameGraphHandle handle) const;
+
+  /**
+   * @brief Desplazamiento en el heap de transitorias (solo vlido si physicalIndex() >= 0).
+   */
+  uint64_t
+  heapOffset(FrameGraphHandle handle) const;
+
+  /**
+   * @brief Texturas fsicas conservadas entre frames.
+   */
+  size_t
+  pooledTextureCount() const { return m_pool.size(); }
+
+private:
+  friend class FrameGraphBuilder;
+  friend class FrameGraphPassContext;
+
+  /**
+   * @brief Textura lgica del frame.
+   */
+  struct
+  Resource {
+    std::string name;
+    FrameGraphTextureDesc desc;
+    bool imported = false;
+    void* importedTexture = nullptr;
+    FrameGraphAccess initialAccess = FRAME_GRAPH_ACCESS_NONE;
+    FrameGraphAccess finalAccess = FRAME_GRAPH_ACCESS_NONE;
+    uint32_t latestNode = 0;
+    uint32_t accessMask = 0;
+    int firstPass = -1;
+    int lastPass = -1;
+    int physical = -1;
+    uint64_t heapOffset = 0;
+    uint64_t bytes = 0;
+  };
+
+  /**
+   * @brief Versin de una textura: la escribe como mucho un pase.
+   */
+  struct
+  Node {
+    uint32_t resource = 0;
+    int producer = -1;
+    uint32_t readers = 0;
+  };
+
+  /**
+   * @brief Uso de una versin dentro de un pase.
+   */
+  struct
+  Access {
+    uint32_t node = 0;
+    FrameGraphAccess access = FRAME_GRAPH_ACCESS_NONE;
+    bool write = false;
+  };
+
+  struct
+  Pass {
+    std::string name;
+    ExecuteFunction execute;
+    std::vector<Access> accesses;
+    std::vector<FrameGraphBarrier> barriers;
+    bool sideEffect = false;
+    bool culled = false;
+    uint32_t references = 0;
+  };
+
+  /**
+   * @brief Textura fsica compartida por transitorias que no coinciden en el tiempo.
+   */
+  struct
+  PhysicalTexture {
+    FrameGraphTextureDesc desc;
+    uint32_t accessMask = 0;
+    int busyUntil = -1;
+    int pooled = -1;
+  };
+
+  /**
+   * @brief Textura fsica del backend conservada entre frames.
+   */
+  struct
+  PooledTexture {
+    FrameGraphTextureDesc desc;
+    uint32_t accessMask = 0;
+    void* texture = nullptr;
+    uint64_t lastUsedFrame = 0;
+    bool taken = false;
+  };
+
+  FrameGraphHandle
+  addNode(uint32_t resource);
+
+  FrameGraphHandle
+  addAccess(uint32_t pass, FrameGraphHandle handle, FrameGraphAccess access, bool write);
+
+  bool
+  validate(std::string* error);
+
+  void
+  cull();
+
+  void
+  computeLifetimes();
+
+  void
+  assignPhysical();
+
+  void
+  placeInHeap();
+
+  void
+  buildBarriers();
+
+  bool
+  fail(std::string* error, const std::string& message);
+
+  std::vector<Resource> m_resources;
+  std::vector<Node> m_nodes;
+  std::vector<Pass> m_passes;
+  std::vector<PhysicalTexture> m_physical;
+  std::vector<FrameGraphBarrier> m_finalBarriers;
+  std::vector<PooledTexture> m_pool;
+  std::vector<void*> m_physicalTextures;
+  std::vector<uint32_t> m_scratch;
+  FrameGraphStats m_stats;
+  uint64_t m_frame = 0;
+  bool m_compiled = false;
+  std::string m_buildError;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include "Prerequisites.h"
+#include "FrameGraph.h"
+#include "Texture.h"
+#include "RenderTargetView.h"
+#include "DepthStencilView.h"
+
+class
+Device;
+
+class
+DeviceContext;
+
+/**
+ * @struct FrameGraphTextureD3D11
+ * @brief Textura fsica del frame graph en D3D11 y las vistas que piden sus usos.
+ *
+ * Es el objeto que reciben los pases con FrameGraphPassContext::texture<FrameGraphTextureD3D11>().
+ * Las texturas importadas (el back buffer) usan la misma estructura, creada por la aplicacin.
+ */
+struct
+FrameGraphTextureD3D11 {
+  /**
+   * @brief Textura y, si se lee desde shaders, su SRV (m_textureFromImg).
+   */
+  Texture texture;
+
+  /**
+   * @brief Vista de render target, si se usa como tal.
+   */
+  RenderTargetView renderTargetView;
+
+  /**
+   * @brief Vista de profundidad, si se usa como tal.
+   */
+  DepthStencilView depthStencilView;
+
+  /**
+   * @brief Libera la textura y sus vistas.
+   */
+  void
+  destroy();
+};
+
+/**
+ * @class D3D11FrameGraphBackend
+ * @brief Crea las texturas transitorias del frame graph con D3D11.
+ *
+ * D3D11 no tiene recursos colocados ni barreras explcitas: el aliasing se
+ * limita a reutilizar texturas con la misma descripcin (lo que ya decide
+ * FrameGraph::compile()) y las transiciones solo desenlazan las vistas que el
+ * runtime rechazara, como un SRV de una textura que pasa a ser render target.
+ */
+class
+D3D11FrameGraphBackend : public FrameGraphBackend {
+public:
+  /** @brief Slots de SRV del pixel shader que se desenlazan al escribir una textura leda. */
+  static const unsigned int kShaderResourceSlots = 8;
+
+  D3D11FrameGraphBackend(Device& device, DeviceContext& deviceContext)
+    : m_device(device), m_deviceContext(deviceContext) {}
+
+  /**
+   * @brief Crea una FrameGraphTextureD3D11 con los bind flags y vistas de @p accessMask.
+   *
+   * Una profundidad que tambin se lee desde shaders se crea con el formato
+   * TYPELESS correspondiente para poder tener DSV y SRV a la vez.
+   */
+  void*
+  createTexture(const FrameGraphTextureDesc& desc, uint32_t accessMask) override;
+
+  void
+  destroyTexture(void* texture) override;
+
+  void
+  barrier(const FrameGraphBarrier& barrier, void* texture) override;
+
+private:
+  Device& m_device;
+  DeviceContext& m_deviceContext;
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+/**
+ * @class FrameLoop
+ * @brief Ciclo de simulacin de paso fijo con acumulador e interpolacin.
+ *
+ * Cada llamada a tick() recibe el tiempo actual, acumula el tiempo real
+ * transcurrido y ejecuta tantos pasos de simulacin de duracin fija como
+ * quepan en el acumulador. El resto se expone como alpha() para interpolar
+ * el estado de render entre el paso anterior y el actual.
+ *
+ * Para evitar la "espiral de la muerte" (frames lentos que generan ms pasos,
+ * que a su vez hacen ms lento el siguiente frame) el tiempo de cada frame se
+ * limita a m_maxFrameTime y el nmero de pasos por tick a m_maxStepsPerTick.
+ *
+ * La clase no depende de Windows: el tiempo se inyecta desde fuera, as que
+ * puede conducirse con un ManualClock para pruebas sin ventana.
+ */
+class
+FrameLoop {
+public:
+  /**
+   * @brief Callback de simulacin. Recibe la duracin del paso en segundos.
+   */
+  using StepFunction = std::function<void(double)>;
+
+  /**
+   * @brief Constructor por defecto (60 Hz, mximo 0.25 s por frame).
+   */
+  FrameLoop() = default;
+
+  /**
+   * @brief Destructor por defecto.
+   */
+  ~FrameLoop() = default;
+
+  /**
+   * @brief Configura el ciclo.
+   * @param fixedStep Duracin de cada paso de simulacin en segundos.
+   * @param maxFrameTime Tiempo mximo de un frame que se acepta en el acumulador.
+   * @param maxStepsPerTick Pasos mximos por tick (0 = derivado de maxFrameTime).
+   * @return true si los parmetros son vlidos.
+   */
+  bool
+  init(double fixedStep, double maxFrameTime = 0.25, unsigned int maxStepsPerTick = 0);
+
+  /**
+   * @brief Reinicia el acumulador y toma @p now como instante del ltimo frame.
+   * @param now Tiempo actual en segundos.
+   */
+  void
+  reset(double now);
+
+  /**
+   * @brief Procesa un frame a partir del tiempo absoluto actual.
+   * @param now Tiempo actual en segundos (del mismo reloj usado en reset()).
+   * @param step Funcin de simulacin que se invoca una vez por paso fijo.
+   * @return Nmero de pasos de simulacin ejecutados.
+   */
+  unsigned int
+  tick(double now, const StepFunction& step);
+
+  /**
+   * @brief Procesa un frame a partir de la duracin del frame.
+   * @param frameTime Segundos transcurridos desde el frame anterior.
+   * @param step Funcin de simulacin que se invoca una vez por paso fijo.
+   * @return Nmero de pasos de simulacin ejecutados.
+   */
+  unsigned int
+  advance(double frameTime, const StepFunction& step);
+
+  /**
+   * @brief Factor de interpolacin [0, 1) entre el paso anterior y el actual.
+   */
+  double
+  alpha() const { return m_accumulator / m_fixedStep; }
+
+  /**
+   * @brief Duracin de un paso fijo en segundos.
+   */
+  double
+  fixedStep() const { return m_fixedStep; }
+
+  /**
+   * @brief Tiempo total simulado en segundos.
+   */
+  double
+  simulationTime() const { return static_cast<double>(m_totalSteps) * m_fixedStep; }
+
+  /**
+   * @brief Nmero total de pasos ejecutados desde reset().
+   */
+  uint64_t
+  totalSteps() const { return m_totalSteps; }
+
+  /**
+   * @brief Tiempo real descartado por los lmites anti-espiral.
+   */
+  double
+  droppedTime() const { return m_droppedTime; }
+
+  /**
+   * @brief Duracin del ltimo frame tal como lleg (sin limitar).
+   */
+  double
+  lastFrameTime() const { return m_lastFrameTime; }
+
+private:
+  /** @brief Duracin de un paso fijo (segundos). */
+  double m_fixedStep = 1.0 / 60.0;
+
+  /** @brief Tiempo mximo de frame aceptado (segundos). */
+  double m_maxFrameTime = 0.25;
+
+  /** @brief Nmero mximo de pasos por tick. */
+  unsigned int m_maxStepsPerTick = 15;
+
+  /** @brief Tiempo pendiente de simular (segundos). */
+  double m_accumulator = 0.0;
+
+  /** @brief Instante del frame anterior (segundos). */
+  double m_previousTime = 0.0;
+
+  /** @brief Indica si reset() ya fij m_previousTime. */
+  bool m_started = false;
+
+  /** @brief Pasos de simulacin ejecutados desde reset(). */
+  uint64_t m_totalSteps = 0;
+
+  /** @brief Tiempo descartado por los lmites (segundos). */
+  double m_droppedTime = 0.0;
+
+  /** @brief Duracin del ltimo frame recibido (segundos). */
+  double m_lastFrameTime = 0.0;
+};
@@ -0,0 +1,162 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include "Clock.h"
+
+/**
+ * @struct FrameTimeStats
+ * @brief Estadsticas acumuladas del intervalo entre frames.
+ *
+ * La media y la varianza se calculan en lnea (algoritmo de Welford), por lo
+ * que no se guarda el historial de frames.
+ */
+struct
+FrameTimeStats {
+  uint64_t frameCount = 0;     /**< Frames medidos. */
+  double   lastFrame = 0.0;    /**< ltimo intervalo medido (segundos). */
+  double   minFrame = 0.0;     /**< Intervalo mnimo (segundos). */
+  double   maxFrame = 0.0;     /**< Intervalo mximo (segundos). */
+  double   mean = 0.0;         /**< Intervalo medio (segundos). */
+  double   m2 = 0.0;           /**< Suma de cuadrados de las desviaciones (Welford). */
+  uint64_t missedDeadlines = 0;/**< Frames que ya haban pasado su fecha lmite antes de esperar. */
+  double   maxWaitError = 0.0; /**< Mayor retraso al terminar una espera (imprecisin de dormir y girar). */
+
+  /**
+   * @brief Varianza muestral del intervalo entre frames (segundos^2).
+   */
+  double
+  variance() const { return frameCount > 1 ? m2 / static_cast<double>(frameCount - 1) : 0.0; }
+
+  /**
+   * @brief Desviacin estndar del intervalo entre frames (segundos).
+   */
+  double
+  stdDev() const;
+};
+
+/**
+ * @class FramePacer
+ * @brief Limitador de frames con espera hbrida (dormir y luego girar).
+ *
+ * Dormir con el planificador del sistema es barato pero impreciso (en Windows
+ * la granularidad por defecto es de ~15.6 ms); girar es preciso pero consume
+ * un ncleo completo. El pacer duerme hasta quedar a m_spinThreshold de la
+ * fecha lmite, corrigiendo con el exceso de sueo observado, y gira el resto.
+ *
+ * El reloj, la funcin de dormir y la de girar son inyectables, de modo que la
+ * clase puede ejecutarse con un ManualClock sin ventana ni tiempo real.
+ */
+class
+FramePacer {
+public:
+  /**
+   * @brief Funcin que duerme el hilo. Recibe los segundos a dormir.
+   */
+  using SleepFunction = std::function<void(double)>;
+
+  /**
+   * @brief Funcin invocada en cada iteracin de la espera activa.
+   */
+  using SpinFunction = std::function<void()>;
+
+  /**
+   * @brief Constructor por defecto.
+   */
+  FramePacer() = default;
+
+  /**
+   * @brief Destructor por defecto.
+   */
+  ~FramePacer() = default;
+
+  /**
+   * @brief Inicializa el pacer.
+   * @param clock Reloj usado para medir (debe vivir ms que el pacer).
+   * @param targetRate Frames por segundo objetivo (0 = sin lmite).
+   * @param spinThreshold Segundos finales de cada espera que se resuelven girando.
+   * @param sleepFn Funcin para dormir (vaca = std::this_thread::sleep_for).
+   * @param spinFn Funcin de espera activa (vaca = std::this_thread::yield).
+   */
+  void
+  init(const Clock& clock,
+       double targetRate,
+       double spinThreshold = 0.002,
+       SleepFunction sleepFn = SleepFunction(),
+       SpinFunction spinFn = SpinFunction());
+
+  /**
+   * @brief Cambia la tasa objetivo.
+   * @param targetRate Frames por segundo (0 = sin lmite).
+   */
+  void
+  setTargetRate(double targetRate);
+
+  /**
+   * @brief Tasa objetivo actual en frames por segundo (0 = sin lmite).
+   */
+  double
+  targetRate() const { return m_period > 0.0 ? 1.0 / m_period : 0.0; }
+
+  /**
+   * @brief Espera hasta la fecha lmite del siguiente frame y registra el intervalo.
+   * @return Intervalo entre este frame y el anterior (segundos).
+   */
+  double
+  waitForNextFrame();
+
+  /**
+   * @brief Estadsticas acumuladas desde el ltimo resetStats().
+   */
+  const FrameTimeStats&
+  stats() const { return m_stats; }
+
+  /**
+   * @brief Reinicia las estadsticas acumuladas.
+   */
+  void
+  resetStats() { m_stats = FrameTimeStats(); }
+
+private:
+  /**
+   * @brief Espera hasta @p deadline durmiendo y girando.
+   */
+  void
+  waitUntil(double deadline);
+
+  /**
+   * @brief Registra un intervalo de frame en las estadsticas.
+   */
+  void
+  record(double frameTime);
+
+private:
+  /** @brief Reloj de referencia. */
+  const Clock* m_clock = nullptr;
+
+  /** @brief Periodo objetivo en segundos (0 = sin lmite). */
+  double m_period = 0.0;
+
+  /** @brief Margen final de la espera que se resuelve girando (segundos). */
+  double m_spinThreshold = 0.002;
+
+  /** @brief Estimacin del exceso de sueo del sistema (segundos). */
+  double m_sleepOvershoot = 0.0;
+
+  /** @brief Fecha lmite del siguiente frame (segundos). */
+  double m_nextDeadline = 0.0;
+
+  /** @brief Instante en que termin la espera del frame anterior. */
+  double m_lastFrameTime = 0.0;
+
+  /** @brief Indica si ya se midi al menos un frame. */
+  bool m_started = false;
+
+  /** @brief Funcin para dormir. */
+  SleepFunction m_sleep;
+
+  /** @brief Funcin de espera activa. */
+  SpinFunction m_spin;
+
+  /** @brief Estadsticas de intervalos. */
+  FrameTimeStats m_stats;
+};
@@ -0,0 +1,164 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file ImageDecoder.h
+ * @brief Decodificacin PNG/JPG con stb_image sobre memoria reutilizable.
+ *
+ * stb_image reserva con malloc cada bfer intermedio (salida de zlib, filas
+ * filtradas) y la imagen final, que luego se sube a GPU y se libera. Aqu las
+ * reservas de stb (STBI_MALLOC/STBI_REALLOC/STBI_FREE) salen de un pool de
+ * std::vector<uint8_t> compartido por todos los hilos: al cargar cientos de
+ * texturas las mismas pginas se reutilizan de una imagen a la siguiente.
+ *
+ * La imagen decodificada se entrega como el propio vector del pool, as que
+ * pasa a la cadena de mips (generateMipChain con std::move) sin otra copia; el
+ * dueo la devuelve con recycle() cuando la textura ya est en GPU.
+ *
+ * Es seguro decodificar en varios hilos a la vez. No depende de Windows ni de DirectX.
+ */
+
+/**
+ * @struct DecodedImage
+ * @brief Imagen decodificada a 8 bits por canal.
+ */
+struct
+DecodedImage {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  unsigned int channels = 0;   /**< Canales de @p pixels (1 a 4; los del archivo si se decodific sin forzar canales). */
+  std::vector<uint8_t> pixels; /**< Memoria del pool; puede ser mayor que width * height * channels. */
+};
+
+/**
+ * @struct DecodeStats
+ * @brief Contadores del pool de decodificacin.
+ */
+struct
+DecodeStats {
+  size_t bytesInUse = 0;    /**< Bytes en manos de stb (decodificaciones en curso). */
+  size_t peakBytes = 0;     /**< Mximo histrico de bytesInUse: memoria pico de decodificacin. */
+  size_t pooledBytes = 0;   /**< Bytes libres guardados para reutilizar. */
+  uint64_t allocations = 0; /**< Reservas pedidas por stb. */
+  uint64_t poolHits = 0;    /**< Reservas servidas desde el pool. */
+  uint64_t images = 0;      /**< Imgenes decodificadas. */
+};
+
+/**
+ * @class ImageDecoder
+ * @brief Decodificador de imgenes con pool de memoria (singleton).
+ */
+class
+ImageDecoder {
+public:
+  /**
+   * @brief Instancia nica (las funciones de reserva de stb son globales).
+   */
+  static ImageDecoder&
+  instance();
+
+  ImageDecoder(const ImageDecoder&) = delete;
+  ImageDecoder& operator=(const ImageDecoder&) = delete;
+
+  /**
+   * @brief Decodifica un archivo PNG/JPG.
+   * @param error Motivo del fallo (opcional).
+   * @param desiredChannels Canales de la salida (1 a 4), o 0 para conservar los del archivo.
+   */
+  bool
+  decodeFile(const std::string& path, DecodedImage& image, std::string* error = nullptr,
+             unsigned int desiredChannels = 4);
+
+  /**
+   * @brief Decodifica una imagen PNG/JPG ya leda a memoria.
+   */
+  bool
+  decodeMemory(const uint8_t* data, size_t size, DecodedImage& image, std::string* error = nullptr,
+               unsigned int desiredChannels = 4);
+
+  /**
+   * @brief Toma del pool un bfer de @p size bytes (sin inicializar si se reutiliza).
+   *        Se devuelve con recycle() como cualquier otro.
+   */
+  std::vector<uint8_t>
+  acquire(size_t size);
+
+  /**
+   * @brief Devuelve un bfer al pool (cualquier vector sirve, no solo los del pool;
+   *        los menores de 4 KB se descartan).
+   */
+  void
+  recycle(std::vector<uint8_t>&& buffer);
+
+  /**
+   * @brief Mximo de bytes libres que guarda el pool; lo que exceda se libera.
+   */
+  void
+  setPoolLimit(size_t bytes);
+
+  /**
+   * @brief Libera toda la memoria libre del pool.
+   */
+  void
+  trim();
+
+  DecodeStats
+  stats() const;
+
+  /**
+   * @brief Reserva para stb (STBI_MALLOC). Devuelve memoria del pool.
+   */
+  void*
+  allocate(size_t size);
+
+  /**
+   * @brief Redimensiona para stb (STBI_REALLOC).
+   */
+  void*
+  reallocate(void* pointer, size_t size);
+
+  /**
+   * @brief Libera para stb (STBI_FREE): el bfer vuelve al pool.
+   */
+  void
+  release(void* pointer);
+
+private:
+  ImageDecoder() = default;
+
+  ~ImageDecoder() = default;
+
+  bool
+  finish(uint8_t* pixels, int width, int height, int channels, unsigned int desiredChannels,
+         DecodedImage& image, std::string* error);
+
+  /**
+   * @brief Saca del pool el menor bfer libre de al menos @p size bytes (con m_mutex tomado).
+   */
+  std::vector<uint8_t>
+  take(size_t size);
+
+  void
+  store(std::vector<uint8_t>&& buffer);
+
+private:
+  /** @brief Protege el pool y los contadores. */
+  mutable std::mutex m_mutex;
+
+  /** @brief Bferes libres ordenados por tamao. */
+  std::multimap<size_t, std::vector<uint8_t>> m_free;
+
+  /** @brief Bferes entregados a stb, por direccin. */
+  std::unordered_map<const void*, std::vector<uint8_t>> m_used;
+
+  /** @brief Mximo de bytes libres guardados. */
+  size_t m_poolLimit = 256u * 1024u * 1024u;
+
+  DecodeStats m_stats;
+};
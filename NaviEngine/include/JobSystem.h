@@ -0,0 +1,302 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file JobSystem.h
+ * @brief Planificador de tareas con robo de trabajo (work stealing).
+ *
+ * Cada hilo (incluido el principal) tiene una cola Chase-Lev propia: el dueo
+ * apila y desapila por abajo sin bloqueos y los dems hilos roban por arriba.
+ * Las dependencias se expresan con JobCounter: un contador se incrementa por
+ * cada tarea asociada, llega a cero cuando todas terminan y en ese momento
+ * libera las tareas encadenadas con runAfter().
+ *
+ * El hilo principal participa en la ejecucin cuando espera un contador
+ * (wait()) o cuando llama a tryRunOne(). No depende de Windows ni de DirectX.
+ */
+
+class
+JobSystem;
+
+/**
+ * @struct Job
+ * @brief Tarea planificable. Se crea y destruye dentro de JobSystem.
+ */
+struct
+Job;
+
+/**
+ * @class JobCounter
+ * @brief Contador de tareas pendientes usado para esperas y dependencias.
+ */
+class
+JobCounter {
+public:
+  /**
+   * @brief Constructor. El contador empieza en cero (sin trabajo pendiente).
+   */
+  JobCounter() = default;
+
+  JobCounter(const JobCounter&) = delete;
+  JobCounter& operator=(const JobCounter&) = delete;
+
+  /**
+   * @brief Tareas asociadas que an no terminan.
+   */
+  int
+  value() const { return m_value.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Indica si todas las tareas asociadas terminaron.
+   */
+  bool
+  isDone() const { return value() == 0; }
+
+private:
+  friend class JobSystem;
+
+  /** @brief Tareas pendientes. */
+  std::atomic<int> m_value{ 0 };
+
+  /** @brief Protege m_continuations. */
+  std::mutex m_mutex;
+
+  /** @brief Tareas que esperan a que el contador llegue a cero. */
+  std::vector<Job*> m_continuations;
+};
+
+/**
+ * @class WorkStealingDeque
+ * @brief Cola Chase-Lev de capacidad fija (L et al., 2013, modelo de memoria C11).
+ *
+ * push() y pop() solo las llama el hilo dueo; steal() cualquier otro hilo.
+ */
+class
+WorkStealingDeque {
+public:
+  /** @brief Capacidad de la cola (potencia de dos). */
+  static const int64_t kCapacity = 4096;
+
+  WorkStealingDeque();
+
+  /**
+   * @brief Apila una tarea (solo el dueo).
+   * @return false si la cola est llena.
+   */
+  bool
+  push(Job* job);
+
+  /**
+   * @brief Desapila la tarea ms reciente (solo el dueo).
+   * @return La tarea o nullptr si la cola est vaca.
+   */
+  Job*
+  pop();
+
+  /**
+   * @brief Roba la tarea ms antigua (cualquier hilo).
+   * @return La tarea o nullptr si est vaca o se perdi la carrera.
+   */
+  Job*
+  steal();
+
+  /**
+   * @brief Nmero aproximado de tareas en la cola.
+   */
+  int64_t
+  size() const;
+
+private:
+  alignas(64) std::atomic<int64_t> m_top{ 0 };
+  alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+  std::unique_ptr<std::atomic<Job*>[]> m_buffer;
+};
+
+/**
+ * @struct CpuTopology
+ * @brief Ncleos lgicos y fsicos de la mquina.
+ */
+struct
+CpuTopology {
+  unsigned int logicalCores = 1;  /**< Hilos de hardware. */
+  unsigned int physicalCores = 1; /**< Ncleos fsicos (sin SMT). */
+  unsigned int packages = 1;      /**< Zcalos / paquetes. */
+
+  /** @brief Un procesador lgico por ncleo fsico (para fijar afinidad sin compartir ncleo). */
+  std::vector<unsigned int> primaryLogicalCores;
+};
+
+/**
+ * @brief Detecta la topologa de CPU (sysfs en Linux, GetLogicalProcessorInformation en Windows).
+ */
+CpuTopology
+detectCpuTopology();
+
+/**
+ * @class JobSystem
+ * @brief Grupo de hilos con colas de robo de trabajo. Singleton.
+ */
+class
+JobSystem {
+public:
+  /**
+   * @brief Funcin de un parallelFor: recibe el subrango [begin, end).
+   */
+  using RangeFunction = std::function<void(size_t, size_t)>;
+
+  /**
+   * @brief Acceso a la instancia global.
+   */
+  static JobSystem&
+  instance();
+
+  /**
+   * @brief Arranca los hilos de trabajo. El hilo que llama pasa a ser el hilo 0.
+   * @param workerThreads Hilos adicionales (0 = ncleos fsicos - 1, mnimo 1).
+   * @param pinThreads Fija cada hilo a un ncleo fsico distinto.
+   * @return true si el sistema qued listo.
+   */
+  bool
+  init(unsigned int workerThreads = 0, bool pinThreads = false);
+
+  /**
+   * @brief Ejecuta las tareas pendientes y detiene los hilos.
+   */
+  void
+  destroy();
+
+  /**
+   * @brief Indica si init() ya se llam.
+   */
+  bool
+  isInitialized() const { return m_initialized; }
+
+  /**
+   * @brief Hilos que ejecutan tareas, incluido el principal.
+   */
+  unsigned int
+  threadCount() const { return static_cast<unsigned int>(m_queues.size()); }
+
+  /**
+   * @brief Topologa detectada en init().
+   */
+  const CpuTopology&
+  topology() const { return m_topology; }
+
+  /**
+   * @brief Planifica una tarea.
+   *
+   * Si el sistema no est inicializado la tarea se ejecuta de inmediato en el hilo actual.
+   * @param function Trabajo a ejecutar.
+   * @param counter Contador que se incrementa ahora y se decrementa al terminar (opcional).
+   */
+  void
+  run(std::function<void()> function, JobCounter* counter = nullptr);
+
+  /**
+   * @brief Planifica una tarea que solo empieza cuando @p dependency llega a cero.
+   * @param dependency Contador del que depende.
+   * @param function Trabajo a ejecutar.
+   * @param counter Contador de la nueva tarea (opcional).
+   */
+  void
+  runAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter = nullptr);
+
+  /**
+   * @brief Espera a que @p counter llegue a cero ejecutando otras tareas mientras tanto.
+   */
+  void
+  wait(JobCounter& counter);
+
+  /**
+   * @brief Ejecuta una tarea pendiente si la hay (modo de participacin del hilo principal).
+   * @return true si se ejecut alguna tarea.
+   */
+  bool
+  tryRunOne();
+
+  /**
+   * @brief Reparte el rango [begin, end) entre los hilos y espera a que termine.
+   *
+   * El rango se divide por mitades recursivamente: cada tarea publica la mitad
+   * derecha para que otro hilo la robe y sigue con la izquierda, hasta llegar
+   * al tamao de grano.
+   *
+   * @param begin Primer ndice.
+   * @param end ndice final (exclusivo).
+   * @param function Trabajo por subrango.
+   * @param grain Tamao mnimo de un subrango (0 = automtico, ~8 trozos por hilo).
+   */
+  void
+  parallelFor(size_t begin, size_t end, const RangeFunction& function, size_t grain = 0);
+
+  /**
+   * @brief ndice del hilo actual dentro del sistema (-1 si es un hilo externo).
+   */
+  static int
+  currentThreadIndex();
+
+private:
+  JobSystem() = default;
+  ~JobSystem() { destroy(); }
+
+  void
+  workerMain(unsigned int index);
+
+  void
+  submit(Job* job);
+
+  Job*
+  findJob(int index);
+
+  void
+  execute(Job* job);
+
+  void
+  finish(JobCounter* counter);
+
+  void
+  splitRange(size_t begin, size_t end, size_t grain, const RangeFunction& function, JobCounter& counter);
+
+private:
+  /** @brief Una cola por hilo; la 0 es la del hilo principal. */
+  std::vector<std::unique_ptr<WorkStealingDeque>> m_queues;
+
+  /** @brief Hilos de trabajo (ndices 1..N). */
+  std::vector<std::thread> m_threads;
+
+  /** @brief Cola para tareas enviadas desde hilos externos o con la cola propia llena. */
+  std::deque<Job*> m_injected;
+
+  /** @brief Protege m_injected. */
+  std::mutex m_injectedMutex;
+
+  /** @brief Tareas publicadas que an no toma ningn hilo. */
+  std::atomic<int> m_queuedJobs{ 0 };
+
+  /** @brief Hilos dormidos esperando trabajo. */
+  std::atomic<int> m_sleepers{ 0 };
+
+  /** @brief Protege el sueo de los hilos. */
+  std::mutex m_sleepMutex;
+
+  /** @brief Despierta hilos dormidos. */
+  std::condition_variable m_wakeUp;
+
+  /** @brief Seal de parada. */
+  std::atomic<bool> m_stopping{ false };
+
+  /** @brief init() ya se ejecut. */
+  bool m_initialized = false;
+
+  /** @brief Topologa de CPU. */
+  CpuTopology m_topology;
+};
@@ -0,0 +1,484 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file Logger.h
+ * @brief Registro asncrono con argumentos de formato estilo printf.
+ *
+ * Quien registra solo copia los argumentos (enteros, reales, punteros y el
+ * texto de las cadenas) a un anillo de bytes sin bloqueos y sin reservar
+ * memoria; un hilo de fondo da formato a los mensajes y los entrega a los
+ * sinks (archivo, stdout o la salida de depuracin). La clase, el mtodo y la
+ * cadena de formato se guardan como punteros, as que deben ser literales.
+ *
+ * Los niveles por debajo de NAVI_LOG_LEVEL desaparecen en compilacin (ni
+ * siquiera se evalan sus argumentos). Si el anillo se llena, el mensaje se
+ * descarta y se cuenta: quien registra nunca espera.
+ *
+ * Antes de start() y despus de stop() los mensajes se formatean y escriben en
+ * el hilo que los registra. No depende de Windows.
+ */
+
+/**
+ * @brief Nivel de un mensaje. Los valores coinciden con NAVI_LOG_LEVEL.
+ */
+enum
+LogLevel {
+  LOG_LEVEL_DEBUG = 0,   /**< Detalle para depurar. */
+  LOG_LEVEL_INFO = 1,    /**< Eventos normales (MESSAGE). */
+  LOG_LEVEL_WARNING = 2, /**< Situaciones recuperables. */
+  LOG_LEVEL_ERROR = 3    /**< Fallos (ERROR). */
+};
+
+/**
+ * @brief Nivel mnimo que se compila: 0 = debug, 1 = info, 2 = warning,
+ *        3 = error, 4 = ninguno. Por defecto debug en Debug e info en el resto.
+ */
+#if !defined(NAVI_LOG_LEVEL)
+#if defined(_DEBUG)
+#define NAVI_LOG_LEVEL 0
+#else
+#define NAVI_LOG_LEVEL 1
+#endif
+#endif
+
+/**
+ * @class LogSink
+ * @brief Destino de los mensajes ya formateados. Solo lo llama un hilo a la vez.
+ */
+class
+LogSink {
+public:
+  virtual
+  ~LogSink() = default;
+
+  /**
+   * @brief Escribe una lnea completa (incluye el salto de lnea).
+   */
+  virtual void
+  write(LogLevel level, const char* text, size_t length) = 0;
+
+  /**
+   * @brief Vuelca lo pendiente al destino.
+   */
+  virtual void
+  flush() {}
+};
+
+/**
+ * @class StdoutLogSink
+ * @brief Escribe en stdout.
+ */
+class
+StdoutLogSink : public LogSink {
+public:
+  void
+  write(LogLevel level, const char* text, size_t length) override;
+
+  void
+  flush() override;
+};
+
+/**
+ * @class FileLogSink
+ * @brief Escribe en un archivo de texto (se trunca al abrirlo).
+ */
+class
+FileLogSink : public LogSink {
+public:
+  /**
+   * @brief Abre @p fileName. isOpen() indica si se pudo.
+   */
+  explicit
+  FileLogSink(const std::string& fileName);
+
+  ~FileLogSink() override;
+
+  bool
+  isOpen() const { return m_file != nullptr; }
+
+  void
+  write(LogLevel level, const char* text, size_t length) override;
+
+  void
+  flush() override;
+
+private:
+  std::FILE* m_file = nullptr;
+};
+
+/**
+ * @class DebugOutputLogSink
+ * @brief Ventana de salida del depurador (OutputDebugStringA); stderr fuera de Windows.
+ */
+class
+DebugOutputLogSink : public LogSink {
+public:
+  void
+  write(LogLevel level, const char* text, size_t length) override;
+};
+
+/**
+ * @namespace LogDetail
+ * @brief Codificacin de los argumentos dentro del anillo.
+ */
+namespace
+LogDetail {
+  /** @brief Tipo de un argumento codificado (1 byte antes de su valor). */
+  enum
+  ArgType : uint8_t {
+    ARG_INT = 0,
+    ARG_UINT = 1,
+    ARG_DOUBLE = 2,
+    ARG_STRING = 3, /**< uint32_t con la longitud y los bytes, sin terminador. */
+    ARG_POINTER = 4
+  };
+
+  /** @brief Longitud mxima de una cadena; el resto se trunca. */
+  const size_t kMaxStringArg = 4096;
+
+  template<typename T>
+  struct
+  AlwaysFalse : std::false_type {};
+
+  /**
+   * @brief Tipo con el que se guarda un argumento de tipo @p T.
+   */
+  template<typename T>
+  constexpr ArgType
+  argType() {
+    using U = typename std::decay<T>::type;
+    if constexpr (std::is_same<U, const char*>::value || std::is_same<U, char*>::value ||
+                  std::is_same<U, std::string>::value) {
+      return ARG_STRING;
+    }
+    else if constexpr (std::is_floating_point<U>::value) {
+      return ARG_DOUBLE;
+    }
+    else if constexpr (std::is_enum<U>::value || (std::is_integral<U>::value && std::is_signed<U>::value)) {
+      return ARG_INT;
+    }
+    else if constexpr (std::is_integral<U>::value) {
+      return ARG_UINT;
+    }
+    else if constexpr (std::is_pointer<U>::value) {
+      return ARG_POINTER;
+    }
+    else {
+      static_assert(AlwaysFalse<U>::value, "Tipo de argumento de registro no soportado");
+      return ARG_INT;
+    }
+  }
+
+  inline size_t
+  stringLength(const char* text) {
+    return text ? std::min(std::strlen(text), kMaxStringArg) : 6;
+  }
+
+  inline size_t
+  stringLength(const std::string& text) {
+    return std::min(text.size(), kMaxStringArg);
+  }
+
+  /**
+   * @brief Bytes que ocupa @p value codificado.
+   */
+  template<typename T>
+  size_t
+  encodedSize(const T& value) {
+    if constexpr (argType<T>() == ARG_STRING) {
+      return 1 + sizeof(uint32_t) + stringLength(value);
+    }
+    else {
+      (void)value;
+      return 1 + 8;
+    }
+  }
+
+  /**
+   * @brief Copia @p value a @p out y devuelve el final de lo escrito.
+   */
+  template<typename T>
+  uint8_t*
+  encode(uint8_t* out, const T& value) {
+    constexpr ArgType type = argType<T>();
+    *out++ = type;
+    if constexpr (type == ARG_STRING) {
+      const char* text;
+      if constexpr (std::is_same<typename std::decay<T>::type, std::string>::value) {
+        text = value.data();
+      }
+      else if constexpr (std::is_array<T>::value) {
+        text = value;
+      }
+      else {
+        text = value ? value : "(null)";
+      }
+      uint32_t length = static_cast<uint32_t>(stringLength(value));
+      std::memcpy(out, &length, sizeof(length));
+      std::memcpy(out + sizeof(length), text, length);
+      return out + sizeof(length) + length;
+    }
+    else {
+      if constexpr (type == ARG_DOUBLE) {
+        double number = static_cast<double>(value);
+        std::memcpy(out, &number, 8);
+      }
+      else if constexpr (type == ARG_INT) {
+        int64_t number = static_cast<int64_t>(value);
+        std::memcpy(out, &number, 8);
+      }
+      else if constexpr (type == ARG_UINT) {
+        uint64_t number = static_cast<uint64_t>(value);
+        std::memcpy(out, &number, 8);
+      }
+      else {
+        uint64_t number = reinterpret_cast<uintptr_t>(value);
+        std::memcpy(out, &number, 8);
+      }
+      return out + 8;
+    }
+  }
+
+  /**
+   * @struct RecordHeader
+   * @brief Cabecera de cada mensaje dentro del anillo (48 bytes).
+   */
+  struct
+  RecordHeader {
+    std::atomic<uint32_t> state; /**< Tamao del registro | banderas; 0 = en escritura. */
+    uint16_t level;
+    uint16_t argCount;
+    uint32_t thread;
+    uint32_t reserved;
+    uint64_t timestamp;          /**< Nanosegundos desde start(). */
+    const char* classObj;
+    const char* method;
+    const char* format;
+  };
+}
+
+/**
+ * @class Logger
+ * @brief Registro global: anillo MPSC sin bloqueos y un hilo que da formato.
+ */
+class
+Logger {
+public:
+  /**
+   * @brief Instancia global.
+   */
+  static Logger&
+  instance();
+
+  /**
+   * @brief Aade un destino. Sin destinos se usa DebugOutputLogSink.
+   */
+  void
+  addSink(std::unique_ptr<LogSink> sink);
+
+  /**
+   * @brief Quita todos los destinos.
+   */
+  void
+  clearSinks();
+
+  /**
+   * @brief Arranca el hilo de formato.
+   * @param capacityBytes Tamao del anillo (se redondea a potencia de dos, mnimo 64 KB).
+   * @return false si ya estaba en marcha.
+   */
+  bool
+  start(size_t capacityBytes = 1024 * 1024);
+
+  /**
+   * @brief Escribe lo pendiente y detiene el hilo. Los mensajes posteriores
+   *        vuelven a escribirse en el hilo que los registra.
+   *
+   * Debe llamarse cuando ningn otro hilo registre (por ejemplo, tras detener el JobSystem).
+   */
+  void
+  stop();
+
+  /**
+   * @brief Espera a que se escriba todo lo registrado hasta ahora y vaca los destinos.
+   */
+  void
+  flush();
+
+  /**
+   * @brief Indica si el hilo de formato est en marcha.
+   */
+  bool
+  isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Mensajes descartados porque el anillo estaba lleno.
+   */
+  uint64_t
+  droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Registra un mensaje. Usar las macros MESSAGE, ERROR y LOG_*.
+   * @param format Cadena de formato estilo printf (literal).
+   */
+  template<size_t N, typename... Args>
+  void
+  write(LogLevel level, const char* classObj, const char* method, const char (&format)[N], const Args&... args) {
+    size_t size = sizeof(LogDetail::RecordHeader);
+    size_t sizes[] = { 0, LogDetail::encodedSize(args)... };
+    for (size_t part : sizes) {
+      size += part;
+    }
+    uint8_t* record = isRunning() ? reserve(size) : nullptr;
+    if (!record) {
+      if (!isRunning()) {
+        writeDirect(level, classObj, method, format, args...);
+      }
+      return;
+    }
+    uint8_t* out = record + sizeof(LogDetail::RecordHeader);
+    int expand[] = { 0, (out = LogDetail::encode(out, args), 0)... };
+    (void)expand;
+    (void)out;
+    commit(record, size, level, classObj, method, format, sizeof...(Args));
+  }
+
+  /**
+   * @brief Da formato a un registro codificado. Expuesto para el hilo de formato y el camino directo.
+   */
+  static void
+  formatRecord(const LogDetail::RecordHeader& header, const uint8_t* args, const uint8_t* end, std::string& out);
+
+private:
+  Logger() = default;
+  ~Logger();
+
+  /**
+   * @brief Reserva @p size bytes del anillo. nullptr si est lleno.
+   */
+  uint8_t*
+  reserve(size_t& size);
+
+  /**
+   * @brief Rellena la cabecera y publica el registro.
+   */
+  void
+  commit(uint8_t* record, size_t size, LogLevel level, const char* classObj, const char* method,
+         const char* format, size_t argCount);
+
+  /**
+   * @brief Camino sin hilo: codifica en un bfer del hilo y escribe en el momento.
+   */
+  template<typename... Args>
+  void
+  writeDirect(LogLevel level, const char* classObj, const char* method, const char* format, const Args&... args) {
+    size_t size = sizeof(LogDetail::RecordHeader);
+    size_t sizes[] = { 0, LogDetail::encodedSize(args)... };
+    for (size_t part : sizes) {
+      size += part;
+    }
+    std::vector<uint8_t>& buffer = directBuffer();
+    buffer.assign(size, 0);
+    uint8_t* out = buffer.data() + sizeof(LogDetail::RecordHeader);
+    int expand[] = { 0, (out = LogDetail::encode(out, args), 0)... };
+    (void)expand;
+    (void)out;
+    fillHeader(buffer.data(), size, level, classObj, method, format, sizeof...(Args));
+    dispatch(*reinterpret_cast<const LogDetail::RecordHeader*>(buffer.data()),
+             buffer.data() + sizeof(LogDetail::RecordHeader), buffer.data() + size);
+  }
+
+  static std::vector<uint8_t>&
+  directBuffer();
+
+  void
+  fillHeader(uint8_t* record, size_t size, LogLevel level, const char* classObj, const char* method,
+             const char* format, size_t argCount);
+
+  /**
+   * @brief Da formato al registro y lo entrega a los destinos.
+   */
+  void
+  dispatch(const LogDetail::RecordHeader& header, const uint8_t* args, const uint8_t* end);
+
+  /**
+   * @brief Consume registros publicados. Devuelve cuntos proces.
+   */
+  size_t
+  drain();
+
+  /**
+   * @brief Bucle del hilo de formato.
+   */
+  void
+  consumerLoop();
+
+private:
+  std::unique_ptr<uint8_t[]> m_buffer;
+  size_t m_capacity = 0;
+  size_t m_mask = 0;
+
+  /** @brief Bytes reservados por los productores (posicin absoluta). */
+  alignas(64) std::atomic<uint64_t> m_head{ 0 };
+
+  /** @brief Bytes liberados por el consumidor (posicin absoluta). */
+  alignas(64) std::atomic<uint64_t> m_tail{ 0 };
+
+  alignas(64) std::atomic<uint64_t> m_dropped{ 0 };
+  uint64_t m_reportedDrops = 0;
+
+  std::atomic<bool> m_running{ false };
+  std::atomic<bool> m_stopping{ false };
+  std::thread m_thread;
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wakeUp;
+
+  /** @brief Protege los destinos y el texto formateado. */
+  std::mutex m_sinkMutex;
+  std::vector<std::unique_ptr<LogSink>> m_sinks;
+  DebugOutputLogSink m_defaultSink;
+  std::string m_line;
+};
+
+/**
+ * @brief Registra un mensaje de nivel @p level. La clase y el mtodo deben ser literales.
+ */
+#define NAVI_LOG(level, classObj, method, ...) \
+  Logger::instance().write(level, "" classObj, "" method, __VA_ARGS__)
+
+#if NAVI_LOG_LEVEL <= 0
+#define LOG_DEBUG(classObj, method, ...) NAVI_LOG(LOG_LEVEL_DEBUG, classObj, method, __VA_ARGS__)
+#else
+#define LOG_DEBUG(classObj, method, ...) ((void)0)
+#endif
+
+#if NAVI_LOG_LEVEL <= 1
+#define LOG_INFO(classObj, method, ...) NAVI_LOG(LOG_LEVEL_INFO, classObj, method, __VA_ARGS__)
+#else
+#define LOG_INFO(classObj, method, ...) ((void)0)
+#endif
+
+#if NAVI_LOG_LEVEL <= 2
+#define LOG_WARNING(classObj, method, ...) NAVI_LOG(LOG_LEVEL_WARNING, classObj, method, __VA_ARGS__)
+#else
+#define LOG_WARNING(classObj, method, ...) ((void)0)
+#endif
+
+#if NAVI_LOG_LEVEL <= 3
+#define LOG_ERROR(classObj, method, ...) NAVI_LOG(LOG_LEVEL_ERROR, classObj, method, __VA_ARGS__)
+#else
+#define LOG_ERROR(classObj, method, ...) ((void)0)
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file LzCodec.h
+ * @brief Compresor LZ77 rpido con el formato de bloque de LZ4.
+ *
+ * Cada secuencia es un token (longitud de literales en el nibble alto, longitud
+ * de coincidencia menos 4 en el bajo), las extensiones de longitud en bytes de
+ * 255, los literales y un desplazamiento de 16 bits little-endian. La ltima
+ * secuencia solo tiene literales. El compresor busca coincidencias con una
+ * tabla hash de posiciones (sin cadenas), as que comprime a cientos de MB/s y
+ * descomprime a varios GB/s: sirve para los archivos .pak, donde la
+ * descompresin ocurre en los hilos de carga.
+ *
+ * No depende de Windows ni de DirectX.
+ */
+
+/**
+ * @brief Tamao mximo de la salida de lzCompress() para @p size bytes de entrada.
+ */
+size_t
+lzCompressBound(size_t size);
+
+/**
+ * @brief Comprime @p size bytes.
+ * @param out Recibe el bloque comprimido (se reemplaza su contenido).
+ * @return Bytes del bloque comprimido.
+ */
+size_t
+lzCompress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+/**
+ * @brief Descomprime un bloque completo.
+ *
+ * Comprueba todos los lmites: un bloque corrupto o truncado devuelve false
+ * sin leer ni escribir fuera de los bferes.
+ * @param dstSize Tamao exacto de los datos originales.
+ * @return true si el bloque produjo exactamente @p dstSize bytes.
+ */
+bool
+lzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Archivo de solo lectura proyectado en memoria.
+ *
+ * El contenido se lee directamente de la cach de pginas del sistema, sin
+ * copiarlo a un bfer propio: los parsers (DdsFile.h) pueden devolver punteros
+ * al interior de la proyeccin. Usa CreateFileMapping en Windows y mmap en el
+ * resto de plataformas; el encabezado no incluye cabeceras del sistema.
+ */
+class
+MappedFile {
+public:
+  /**
+   * @brief Constructor por defecto (sin archivo).
+   */
+  MappedFile() = default;
+
+  /**
+   * @brief Destructor. Cierra la proyeccin si sigue abierta.
+   */
+  ~MappedFile() { close(); }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief Proyecta un archivo completo.
+   * @param path Ruta del archivo.
+   * @return false si no existe, est vaco o no se puede proyectar.
+   */
+  bool
+  open(const std::string& path);
+
+  /**
+   * @brief Libera la proyeccin y el archivo.
+   */
+  void
+  close();
+
+  /**
+   * @brief Lee una vez cada pgina para que los fallos de pgina ocurran en el
+   *        hilo que llama (un hilo de carga) y no durante la subida a GPU.
+   */
+  void
+  prefetch() const { prefetch(0, m_size); }
+
+  /**
+   * @brief Como prefetch(), pero solo para los bytes [offset, offset + size).
+   */
+  void
+  prefetch(size_t offset, size_t size) const;
+
+  /**
+   * @brief Indica si hay un archivo proyectado.
+   */
+  bool
+  isOpen() const { return m_data != nullptr; }
+
+  /**
+   * @brief Primer byte del archivo.
+   */
+  const uint8_t*
+  data() const { return m_data; }
+
+  /**
+   * @brief Tamao del archivo en bytes.
+   */
+  size_t
+  size() const { return m_size; }
+
+private:
+  /** @brief Inicio de la proyeccin. */
+  const uint8_t* m_data = nullptr;
+
+  /** @brief Bytes proyectados. */
+  size_t m_size = 0;
+
+  /** @brief HANDLE del archivo y de la proyeccin en Windows (sin uso en POSIX). */
+  void* m_file = nullptr;
+  void* m_mapping = nullptr;
+};
@@ -0,0 +1,316 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file Metrics.h
+ * @brief Registro de contadores, medidores e histogramas del motor.
+ *
+ * Las actualizaciones son una operacin atmica relajada sobre una referencia
+ * obtenida una sola vez, as que pueden quedarse activas en produccin. Una vez
+ * por frame MetricsRegistry::endFrame() cierra los valores por frame, y
+ * peridicamente se vuelcan a CSV (una fila por volcado) y a texto de
+ * Prometheus (se reescribe el archivo) para detectar regresiones sin profiler.
+ */
+
+/**
+ * @class MetricCounter
+ * @brief Contador monotnico con valor por frame y total acumulado.
+ */
+class
+MetricCounter {
+public:
+  /**
+   * @brief Constructor.
+   * @param name Nombre de la mtrica (formato snake_case).
+   * @param help Descripcin para el volcado de Prometheus.
+   */
+  MetricCounter(std::string name, std::string help)
+    : m_name(std::move(name)), m_help(std::move(help)) {}
+
+  /**
+   * @brief Suma @p value al frame actual.
+   */
+  void
+  add(uint64_t value = 1) { m_current.fetch_add(value, std::memory_order_relaxed); }
+
+  /**
+   * @brief Cierra el frame: guarda el valor del frame y lo suma al total.
+   */
+  void
+  endFrame();
+
+  /** @brief Valor del ltimo frame cerrado. */
+  uint64_t
+  lastFrame() const { return m_lastFrame.load(std::memory_order_relaxed); }
+
+  /** @brief Total acumulado de frames cerrados. */
+  uint64_t
+  total() const { return m_total.load(std::memory_order_relaxed); }
+
+  /** @brief Nombre de la mtrica. */
+  const std::string&
+  name() const { return m_name; }
+
+  /** @brief Descripcin de la mtrica. */
+  const std::string&
+  help() const { return m_help; }
+
+private:
+  std::string m_name;
+  std::string m_help;
+  std::atomic<uint64_t> m_current{ 0 };
+  std::atomic<uint64_t> m_lastFrame{ 0 };
+  std::atomic<uint64_t> m_total{ 0 };
+};
+
+/**
+ * @class MetricGauge
+ * @brief Valor instantneo (ltimo valor escrito).
+ */
+class
+MetricGauge {
+public:
+  /**
+   * @brief Constructor.
+   * @param name Nombre de la mtrica.
+   * @param help Descripcin para el volcado de Prometheus.
+   */
+  MetricGauge(std::string name, std::string help)
+    : m_name(std::move(name)), m_help(std::move(help)) {}
+
+  /** @brief Fija el valor actual. */
+  void
+  set(double value) { m_value.store(value, std::memory_order_relaxed); }
+
+  /** @brief Valor actual. */
+  double
+  value() const { return m_value.load(std::memory_order_relaxed); }
+
+  /** @brief Nombre de la mtrica. */
+  const std::string&
+  name() const { return m_name; }
+
+  /** @brief Descripcin de la mtrica. */
+  const std::string&
+  help() const { return m_help; }
+
+private:
+  std::string m_name;
+  std::string m_help;
+  std::atomic<double> m_value{ 0.0 };
+};
+
+/**
+ * @class MetricHistogram
+ * @brief Histograma logartmico con cubetas atmicas y percentiles.
+ *
+ * Las cubetas crecen geomtricamente desde @p minValue hasta @p maxValue con
+ * @p bucketsPerOctave cubetas por cada duplicacin, as que el error relativo
+ * de un percentil es de ~2^(1/bucketsPerOctave) - 1 (9 % con 8 cubetas).
+ */
+class
+MetricHistogram {
+public:
+  /**
+   * @brief Constructor.
+   * @param name Nombre de la mtrica.
+   * @param help Descripcin para el volcado de Prometheus.
+   * @param minValue Lmite inferior del rango (valores menores caen en la primera cubeta).
+   * @param maxValue Lmite superior del rango (valores mayores caen en la ltima cubeta).
+   * @param bucketsPerOctave Cubetas por duplicacin de valor.
+   */
+  MetricHistogram(std::string name,
+                  std::string help,
+                  double minValue,
+                  double maxValue,
+                  unsigned int bucketsPerOctave = 8);
+
+  /**
+   * @brief Registra una muestra.
+   */
+  void
+  record(double value);
+
+  /**
+   * @brief Percentil aproximado.
+   * @param p Percentil en [0, 1] (0.5 = mediana).
+   * @return Valor estimado (media geomtrica de la cubeta), 0 sin muestras.
+   */
+  double
+  percentile(double p) const;
+
+  /** @brief Nmero de muestras registradas. */
+  uint64_t
+  count() const { return m_count.load(std::memory_order_relaxed); }
+
+  /** @brief Suma de todas las muestras. */
+  double
+  sum() const { return m_sum.load(std::memory_order_relaxed); }
+
+  /** @brief Descarta todas las muestras. */
+  void
+  reset();
+
+  /** @brief Nombre de la mtrica. */
+  const std::string&
+  name() const { return m_name; }
+
+  /** @brief Descripcin de la mtrica. */
+  const std::string&
+  help() const { return m_help; }
+
+private:
+  std::string m_name;
+  std::string m_help;
+  double m_minValue;
+  double m_logMin;
+  double m_bucketsPerLog2;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+  size_t m_bucketCount;
+  std::atomic<uint64_t> m_count{ 0 };
+  std::atomic<double> m_sum{ 0.0 };
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief Registro global de mtricas y volcado peridico a disco.
+ */
+class
+MetricsRegistry {
+public:
+  /**
+   * @brief Instancia global del registro.
+   */
+  static MetricsRegistry&
+  instance();
+
+  /**
+   * @brief Busca o registra un contador. La referencia es estable.
+   */
+  MetricCounter&
+  counter(const std::string& name, const std::string& help);
+
+  /**
+   * @brief Busca o registra un medidor. La referencia es estable.
+   */
+  MetricGauge&
+  gauge(const std::string& name, const std::string& help);
+
+  /**
+   * @brief Busca o registra un histograma. La referencia es estable.
+   */
+  MetricHistogram&
+  histogram(const std::string& name,
+            const std::string& help,
+            double minValue,
+            double maxValue,
+            unsigned int bucketsPerOctave = 8);
+
+  /**
+   * @brief Cierra el frame de todos los contadores y registra el tiempo de frame.
+   * @param frameSeconds Duracin del frame en segundos.
+   */
+  void
+  endFrame(double frameSeconds);
+
+  /**
+   * @brief Configura el volcado peridico y registra las mtricas estndar del motor.
+   *
+   * Cada volcado cubre solo su intervalo: tras escribirlo se vacan los histogramas.
+   *
+   * @param csvFile Archivo CSV (se aade una fila por volcado; vaco = desactivado).
+   * @param prometheusFile Archivo de texto Prometheus (se reescribe; vaco = desactivado).
+   * @param intervalSeconds Segundos entre volcados.
+   */
+  void
+  setDumpTargets(const std::string& csvFile,
+                 const std::string& prometheusFile,
+                 double intervalSeconds);
+
+  /**
+   * @brief Vuelca las mtricas si pas el intervalo configurado.
+   * @param now Tiempo actual en segundos.
+   * @return true si se realiz un volcado.
+   */
+  bool
+  dumpIfDue(double now);
+
+  /**
+   * @brief Aade una fila con el estado actual al CSV.
+   *
+   * Nunca trunca: la cabecera se escribe solo si el archivo es nuevo o est vaco.
+   * Si el archivo ya tiene otras columnas (o cambian durante la ejecucin) se
+   * contina en <nombre>_<n>.<ext>, con el primer n libre o con la misma cabecera.
+   */
+  bool
+  writeCsv(const std::string& fileName);
+
+  /**
+   * @brief Escribe el estado actual en formato de exposicin de Prometheus.
+   */
+  bool
+  writePrometheus(const std::string& fileName);
+
+  /** @brief Frames cerrados. */
+  uint64_t
+  frameIndex() const { return m_frameIndex; }
+
+private:
+  MetricsRegistry();
+
+  /**
+   * @brief Cabecera CSV del conjunto actual de mtricas. Requiere m_mutex.
+   */
+  std::string
+  csvHeader() const;
+
+private:
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<MetricCounter>> m_counters;
+  std::vector<std::unique_ptr<MetricGauge>> m_gauges;
+  std::vector<std::unique_ptr<MetricHistogram>> m_histograms;
+  std::string m_csvFile;
+  std::string m_prometheusFile;
+  double m_dumpInterval = 0.0;
+  double m_nextDump = 0.0;
+  uint64_t m_frameIndex = 0;
+  uint64_t m_lastAllocationCount = 0;
+  std::string m_csvTarget;   /**< Archivo pedido en writeCsv(). */
+  std::string m_csvPath;     /**< Archivo en el que se escribe realmente. */
+  std::string m_csvHeader;   /**< Cabecera de m_csvPath; vaca si an no se eligi. */
+};
+
+/**
+ * @namespace EngineMetrics
+ * @brief Mtricas estndar del motor, registradas la primera vez que se usan.
+ */
+namespace
+EngineMetrics {
+  MetricCounter& drawCalls();          /**< Llamadas de dibujo. */
+  MetricCounter& stateChanges();       /**< Cambios de estado del pipeline. */
+  MetricCounter& bytesUploaded();      /**< Bytes subidos a la GPU. */
+  MetricCounter& trianglesSubmitted(); /**< Tringulos enviados a dibujar. */
+  MetricGauge&   allocationsPerFrame();/**< Asignaciones de memoria del ltimo frame. */
+  MetricGauge&   frameTimeMs();        /**< Tiempo del ltimo frame (ms). */
+  MetricHistogram& frameTime();        /**< Histograma de tiempos de frame (s). */
+
+  /**
+   * @brief Registra todas las mtricas estndar, para que las columnas del CSV
+   *        no cambien cuando alguna se usa por primera vez.
+   */
+  void
+  registerAll();
+
+  /**
+   * @brief Nmero total de llamadas a operator new desde el inicio del proceso.
+   *
+   * Solo cuenta si NAVI_METRICS_TRACK_ALLOCATIONS es distinto de 0.
+   */
+  uint64_t
+  allocationCount();
+}
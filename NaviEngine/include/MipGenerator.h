@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file MipGenerator.h
+ * @brief Generacin en CPU de la cadena de mipmaps de imgenes RGBA8.
+ *
+ * Cada nivel se obtiene del anterior en espacio lineal: los canales de color se
+ * decodifican de sRGB a lineal, se filtran en coma flotante y se vuelven a
+ * codificar, para que los niveles pequeos no se oscurezcan. Las filas de cada
+ * nivel se reparten entre los hilos del JobSystem y los ncleos de filtrado
+ * operan sobre un pxel RGBA completo con SSE (con una versin escalar
+ * equivalente fuera de x86).
+ *
+ * No depende de Windows ni de DirectX.
+ */
+
+/**
+ * @brief Filtro de reduccin.
+ */
+enum
+MipFilter {
+  MIP_FILTER_BOX = 0,   /**< Promedio 2x2: rpido, algo borroso. */
+  MIP_FILTER_KAISER = 1 /**< Sinc con ventana de Kaiser: ms ntido, sin aliasing. */
+};
+
+/**
+ * @struct MipSettings
+ * @brief Parmetros de generacin.
+ */
+struct
+MipSettings {
+  MipFilter filter = MIP_FILTER_BOX;
+  bool srgb = true;                   /**< Los canales RGB estn codificados en sRGB. */
+  bool preserveAlphaCoverage = false; /**< Mantiene la cobertura del alpha test en todos los niveles. */
+  float alphaReference = 0.5f;        /**< Umbral del alpha test (0..1). */
+  float kaiserAlpha = 4.0f;           /**< Parmetro de forma de la ventana de Kaiser. */
+  float kaiserWidth = 3.0f;           /**< Radio del filtro en texels del nivel destino. */
+  unsigned int maxLevels = 0;         /**< Mximo de niveles (0 = cadena completa hasta 1x1). */
+};
+
+/**
+ * @struct MipLevel
+ * @brief Un nivel de la cadena en orden de filas (RGBA8 salvo que MipChain::channels diga otra cosa).
+ */
+struct
+MipLevel {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  std::vector<uint8_t> pixels;
+};
+
+/**
+ * @struct MipChain
+ * @brief Cadena de niveles; el nivel 0 es la imagen original.
+ */
+struct
+MipChain {
+  std::vector<MipLevel> levels;
+  unsigned int channels = 4; /**< Bytes por texel de cada nivel (generateMipChain() produce RGBA8). */
+
+  /**
+   * @brief Ancho del nivel 0.
+   */
+  unsigned int
+  width() const { return levels.empty() ? 0 : levels[0].width; }
+
+  /**
+   * @brief Alto del nivel 0.
+   */
+  unsigned int
+  height() const { return levels.empty() ? 0 : levels[0].height; }
+
+  /**
+   * @brief Bytes de todos los niveles.
+   */
+  size_t
+  byteSize() const {
+    size_t bytes = 0;
+    for (const MipLevel& level : levels) {
+      bytes += level.pixels.size();
+    }
+    return bytes;
+  }
+};
+
+/**
+ * @brief Nmero de niveles de la cadena completa de una imagen @p width x @p height.
+ */
+unsigned int
+mipLevelCount(unsigned int width, unsigned int height);
+
+/**
+ * @brief Genera la cadena de mipmaps de una imagen RGBA8.
+ * @param rgba Pxeles del nivel 0 (4 bytes por pxel).
+ * @param width Ancho en pxeles.
+ * @param height Alto en pxeles.
+ * @param settings Filtro, espacio de color y cobertura de alpha.
+ * @param chain Cadena resultante (incluye una copia del nivel 0).
+ * @return false si la imagen est vaca.
+ */
+bool
+generateMipChain(const uint8_t* rgba,
+                 unsigned int width,
+                 unsigned int height,
+                 const MipSettings& settings,
+                 MipChain& chain);
+
+/**
+ * @brief Igual que la anterior, pero adopta @p rgba como nivel 0 sin copiarlo.
+ *
+ * Es la variante de la ruta de carga: el bfer del decodificador pasa a la
+ * cadena tal cual. @p rgba puede ser mayor que la imagen (se recorta).
+ */
+bool
+generateMipChain(std::vector<uint8_t>&& rgba,
+                 unsigned int width,
+                 unsigned int height,
+                 const MipSettings& settings,
+                 MipChain& chain);
@@ -53,6 +53,16 @@ public:
   LoadData
   Load(std::string objFileName);
 
+  /**
+   * @brief Genera un cubo con normales y coordenadas de textura por cara.
+   *
+   * Se usa como geometra provisional mientras el modelo real se carga en segundo plano.
+   * @param halfExtent Mitad de la longitud de la arista.
+   * @return Estructura LoadData con 24 vrtices y 36 ndices.
+   */
+  LoadData
+  CreateCube(float halfExtent);
+
 private:
   /** @brief Cargador OBJ (comentado actualmente, podra usarse para importar modelos). */
   //objl::Loader m_loader;
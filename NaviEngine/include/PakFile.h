@@ -0,0 +1,214 @@
+#pragma once
+#include "FileSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file PakFile.h
+ * @brief Archivo .pak: muchos assets en un solo archivo proyectado en memoria.
+ *
+ * Disposicin (little-endian):
+ *
+ *   PakHeader | PakEntry[entryCount] ordenados por hash | nombres | datos
+ *
+ * La tabla de contenidos empieza alineada a 64 bytes y se lee en su sitio
+ * desde la proyeccin; una bsqueda es una bsqueda binaria por el hash FNV-1a
+ * de la ruta normalizada y una comparacin del nombre. Cada entrada empieza
+ * alineada a PakHeader::alignment y puede guardarse comprimida con LzCodec;
+ * las que no lo estn se entregan como vistas de la proyeccin, sin copia.
+ *
+ * Abrir un .pak cuesta un open y un mmap para todos los assets, y los datos
+ * quedan contiguos en el orden en que se aadieron, lo que favorece la lectura
+ * anticipada del sistema con la cach fra. No depende de Windows ni de DirectX.
+ */
+
+/** @brief Versin del formato que escribe y lee este cdigo. */
+const uint32_t kPakVersion = 1;
+
+/** @brief Alineacin por defecto de los datos de cada entrada. */
+const uint32_t kPakDefaultAlignment = 64;
+
+/**
+ * @struct PakHeader
+ * @brief Cabecera del archivo (48 bytes).
+ */
+struct
+PakHeader {
+  char magic[4];        /**< "NPAK". */
+  uint32_t version;     /**< kPakVersion. */
+  uint32_t entryCount;  /**< Entradas de la tabla de contenidos. */
+  uint32_t alignment;   /**< Alineacin de los datos de cada entrada (potencia de 2). */
+  uint64_t tocOffset;   /**< Inicio de la tabla de PakEntry. */
+  uint64_t namesOffset; /**< Inicio de los nombres (UTF-8, sin terminador). */
+  uint64_t namesSize;   /**< Bytes de nombres. */
+  uint64_t dataOffset;  /**< Inicio de la primera entrada. */
+};
+
+/**
+ * @brief Bits de PakEntry::flags.
+ */
+enum
+PakEntryFlags {
+  PAK_ENTRY_LZ = 1 /**< Datos comprimidos con lzCompress(). */
+};
+
+/**
+ * @struct PakEntry
+ * @brief Entrada de la tabla de contenidos (48 bytes).
+ */
+struct
+PakEntry {
+  uint64_t hash;        /**< pakPathHash() de la ruta. */
+  uint64_t offset;      /**< Inicio de los datos en el archivo. */
+  uint64_t storedSize;  /**< Bytes guardados (comprimidos o no). */
+  uint64_t size;        /**< Bytes originales. */
+  uint32_t nameOffset;  /**< Posicin del nombre dentro del bloque de nombres. */
+  uint32_t nameLength;  /**< Bytes del nombre. */
+  uint32_t flags;       /**< PakEntryFlags. */
+  uint32_t reserved;
+};
+
+/**
+ * @brief Forma cannica de una ruta: '/' como separador, minsculas, sin "./" ni barras repetidas.
+ */
+std::string
+normalizePakPath(const std::string& path);
+
+/**
+ * @brief Hash FNV-1a de 64 bits de la ruta normalizada.
+ */
+uint64_t
+pakPathHash(const std::string& path);
+
+/**
+ * @class PakWriter
+ * @brief Construye un .pak en memoria y lo escribe de una vez.
+ */
+class
+PakWriter {
+public:
+  /**
+   * @brief Alineacin de los datos de cada entrada (potencia de 2; 4096 alinea a pgina).
+   */
+  void
+  setAlignment(uint32_t bytes);
+
+  /**
+   * @brief Aade un archivo.
+   * @param compress Intenta comprimirlo; se guarda sin comprimir si no ahorra al menos 1/8.
+   * @return false si la ruta ya estaba (tras normalizarla) o es demasiado grande.
+   */
+  bool
+  add(const std::string& path, const uint8_t* data, size_t size, bool compress);
+
+  /**
+   * @brief Escribe el archivo. Las entradas quedan en el orden en que se aadieron.
+   */
+  bool
+  write(const std::string& fileName, std::string* error = nullptr) const;
+
+  size_t
+  entryCount() const { return m_entries.size(); }
+
+  /**
+   * @brief Bytes originales de todas las entradas.
+   */
+  uint64_t
+  originalBytes() const { return m_originalBytes; }
+
+  /**
+   * @brief Bytes guardados de todas las entradas (sin cabecera ni relleno).
+   */
+  uint64_t
+  storedBytes() const { return m_storedBytes; }
+
+private:
+  /**
+   * @struct Pending
+   * @brief Entrada aadida y an no escrita.
+   */
+  struct
+  Pending {
+    std::string name;
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    uint32_t flags = 0;
+    std::vector<uint8_t> stored;
+  };
+
+  std::vector<Pending> m_entries;
+  uint32_t m_alignment = kPakDefaultAlignment;
+  uint64_t m_originalBytes = 0;
+  uint64_t m_storedBytes = 0;
+};
+
+/**
+ * @class PakArchive
+ * @brief Lector de .pak montable en VirtualFileSystem.
+ */
+class
+PakArchive : public FileSource {
+public:
+  /**
+   * @brief Proyecta y valida un .pak.
+   * @param error Motivo del fallo (opcional).
+   */
+  bool
+  load(const std::string& fileName, std::string* error = nullptr);
+
+  /**
+   * @brief Cierra el archivo (las vistas entregadas siguen siendo vlidas).
+   */
+  void
+  close();
+
+  bool
+  isLoaded() const { return m_file != nullptr; }
+
+  /**
+   * @brief Vista de una entrada: de la proyeccin si no est comprimida, descomprimida si lo est.
+   */
+  bool
+  open(const std::string& path, FileView& view) const override;
+
+  bool
+  exists(const std::string& path) const override { return find(path) != nullptr; }
+
+  /**
+   * @brief Entrada de @p path, o nullptr.
+   */
+  const PakEntry*
+  find(const std::string& path) const;
+
+  /**
+   * @brief Vista de una entrada de la tabla.
+   */
+  bool
+  extract(const PakEntry& entry, FileView& view) const;
+
+  size_t
+  entryCount() const { return m_count; }
+
+  /**
+   * @brief Entradas en orden de hash.
+   */
+  const PakEntry&
+  entry(size_t index) const { return m_entries[index]; }
+
+  std::string
+  entryName(const PakEntry& entry) const;
+
+private:
+  /** @brief Archivo proyectado (compartido con las vistas entregadas). */
+  std::shared_ptr<MappedFile> m_file;
+
+  /** @brief Tabla de contenidos dentro de la proyeccin. */
+  const PakEntry* m_entries = nullptr;
+  size_t m_count = 0;
+
+  /** @brief Bloque de nombres dentro de la proyeccin. */
+  const char* m_names = nullptr;
+};
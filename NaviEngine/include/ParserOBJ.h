@@ -1,5 +1,6 @@
 #pragma once
 #include "Prerequisites.h" 
+#include "Allocators.h"
 #include <string>
 #include <vector>
 
@@ -70,16 +71,16 @@ objl
     /**
      * @brief Vector que almacena los vrtices nicos cargados.
      * Nuestro parser personalizado llena este vector para que
-     * ModelLoader.cpp pueda leerlo.
+     * ModelLoader.cpp pueda leerlo. Se contabiliza en MEMORY_LOADER.
      */
-    std::vector<Vertex> LoadedVertices;
+    TaggedVector<Vertex, MEMORY_LOADER> LoadedVertices;
 
     /**
      * @brief Vector que almacena los ndices del modelo.
      * Nuestro parser personalizado llena este vector para que
-     * ModelLoader.cpp pueda leerlo.
+     * ModelLoader.cpp pueda leerlo. Se contabiliza en MEMORY_LOADER.
      */
-    std::vector<unsigned int> LoadedIndices;
+    TaggedVector<unsigned int, MEMORY_LOADER> LoadedIndices;
 
 
     // --- Mtodos Pblicos (Llamados por ModelLoader.cpp) ---
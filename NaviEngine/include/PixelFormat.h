@@ -0,0 +1,76 @@
+#pragma once
+#include "ImageDecoder.h"
+#include "MipGenerator.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file PixelFormat.h
+ * @brief Eleccin del formato de textura segn los canales de la imagen y su uso.
+ *
+ * Una mscara en escala de grises no necesita cuatro canales: se sube como R8
+ * (4 veces menos memoria que RGBA8) y un mapa de normales de dos canales como
+ * R8G8. El formato se decide con los canales del archivo y una pista de uso
+ * por textura; convertChannels() hace las conversiones con ncleos SSE2 para los
+ * casos habituales (con equivalentes escalares fuera de x86).
+ *
+ * No depende de Windows ni de DirectX: los formatos se expresan como valores
+ * numricos de DXGI_FORMAT.
+ */
+
+/**
+ * @brief Pista de uso de una textura.
+ */
+enum
+TextureUsage {
+  TEXTURE_USAGE_AUTO = 0,       /**< Segn el archivo: gris -> R8, gris+alpha -> R8G8, color -> RGBA8. */
+  TEXTURE_USAGE_COLOR = 1,      /**< Color RGBA8 UNORM (tambin para imgenes en gris). */
+  TEXTURE_USAGE_COLOR_SRGB = 2, /**< Color RGBA8 sRGB: el hardware linealiza al muestrear. */
+  TEXTURE_USAGE_DATA = 3,       /**< Cuatro canales de datos lineales (p. ej. ORM empaquetado). */
+  TEXTURE_USAGE_MASK = 4,       /**< Un canal R8 (rugosidad, oclusin, mscaras); de una imagen en color toma R. */
+  TEXTURE_USAGE_NORMAL_XY = 5   /**< Dos canales R8G8 con X e Y de la normal; Z se reconstruye en el shader. */
+};
+
+/**
+ * @struct ImageFormat
+ * @brief Formato elegido para subir una imagen.
+ */
+struct
+ImageFormat {
+  unsigned int channels = 4;  /**< Canales por pxel en GPU (1, 2 o 4). */
+  bool color = true;          /**< Contenido de color: los mips se filtran en espacio lineal. */
+  bool srgb = false;          /**< Formato _SRGB. */
+  uint32_t dxgiFormat = 28;   /**< DXGI_FORMAT sin comprimir (R8 = 61, R8G8 = 49, RGBA8 = 28/29). */
+};
+
+/**
+ * @brief Elige el formato de GPU para una imagen de @p sourceChannels canales (1 a 4).
+ */
+ImageFormat
+chooseImageFormat(unsigned int sourceChannels, TextureUsage usage);
+
+/**
+ * @brief Convierte pxeles entre 1, 2, 3 y 4 canales de 8 bits.
+ *
+ * A menos canales se conservan los primeros (R, RG); a ms, el gris se replica en
+ * RGB y el alpha que falta vale 255. @p dstChannels no puede ser 3.
+ * @return false si la combinacin no se admite.
+ */
+bool
+convertChannels(const uint8_t* src,
+                unsigned int srcChannels,
+                uint8_t* dst,
+                unsigned int dstChannels,
+                size_t pixelCount);
+
+/**
+ * @brief Construye la cadena de mips de una imagen decodificada con @p channels canales por nivel.
+ *
+ * Los mips se generan en RGBA8 (MipGenerator) y, si @p channels es 1 o 2, cada
+ * nivel se reduce despus. Los bferes intermedios vuelven al pool de ImageDecoder.
+ * @param image Imagen con sus canales originales; se consume.
+ * @param format Formato elegido (decide el filtrado sRGB).
+ * @param channels Canales de la cadena resultante (1, 2 o 4).
+ */
+bool
+buildMipChain(DecodedImage&& image, const ImageFormat& format, unsigned int channels, MipChain& chain);
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @file PlatformCompat.h
+ * @brief Sustitutos mnimos de los tipos de Windows y xnamath.
+ *
+ * Solo se incluye desde Prerequisites.h cuando no se compila para Windows.
+ * Permite compilar las partes del motor que no tocan Direct3D (parser OBJ,
+ * ModelLoader, perfilador...) en Linux, por ejemplo para los benchmarks.
+ */
+
+// LONG de Windows: 32 bits tambin en LP64, donde long tiene 64 y E_FAIL sera positivo.
+typedef int32_t HRESULT;
+
+#define S_OK          ((HRESULT)0L)
+#define S_FALSE       ((HRESULT)1L)
+#define E_FAIL        ((HRESULT)0x80004005L)
+#define E_POINTER     ((HRESULT)0x80004003L)
+#define E_INVALIDARG  ((HRESULT)0x80070057L)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
+#define E_NOTIMPL     ((HRESULT)0x80004001L)
+
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr)    (((HRESULT)(hr)) < 0)
+
+static_assert(sizeof(HRESULT) == 4, "HRESULT debe tener 32 bits, como LONG en Windows");
+static_assert(FAILED(E_FAIL), "E_FAIL debe ser un cdigo de error");
+
+/**
+ * @brief Vector de 2 componentes compatible con XMFLOAT2.
+ */
+struct
+XMFLOAT2 {
+  float x;
+  float y;
+
+  XMFLOAT2() = default;
+  XMFLOAT2(float _x, float _y) : x(_x), y(_y) {}
+};
+
+/**
+ * @brief Vector de 3 componentes compatible con XMFLOAT3.
+ */
+struct
+XMFLOAT3 {
+  float x;
+  float y;
+  float z;
+
+  XMFLOAT3() = default;
+  XMFLOAT3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+};
+
+/**
+ * @brief Vector de 4 componentes compatible con XMFLOAT4.
+ */
+struct
+XMFLOAT4 {
+  float x;
+  float y;
+  float z;
+  float w;
+
+  XMFLOAT4() = default;
+  XMFLOAT4(float _x, float _y, float _z, float _w) : x(_x), y(_y), z(_z), w(_w) {}
+};
+
+/**
+ * @brief Matriz 4x4 con la misma disposicin y alineacin que XMMATRIX.
+ */
+struct alignas(16)
+XMMATRIX {
+  float m[4][4];
+};
@@ -3,10 +3,11 @@
 #include <string>
 #include <sstream>
 #include <vector>
-#include <windows.h>
-#include <xnamath.h>
 #include <thread>
 
+#if defined(_WIN32)
+#include <windows.h>
+#include <xnamath.h>
 
 //Librerias DirectX
 #include <d3d11.h>
@@ -14,6 +15,12 @@
 #include <d3dcompiler.h>
 #include "Resource.h"
 #include "resource.h"
+#else
+// Fuera de Windows (benchmarks) solo se necesitan los tipos bsicos de xnamath.
+#include "PlatformCompat.h"
+#include "Resource.h"
+#endif
+#include "Logger.h"
 
 
 //third Party Libraries
@@ -31,42 +38,32 @@
 #define SAFE_RELEASE(x) if(x != nullptr) x->Release(); x = nullptr;
 
  /**
-  * @brief Macro para mostrar mensajes de creacin de recursos en la ventana de depuracin.
+  * @brief Macro para registrar mensajes informativos del motor.
   *
-  * Formatea un mensaje con la clase, el mtodo y el estado actual de la creacin.
+  * Redirige al Logger asncrono: el formato es estilo printf y los argumentos
+  * se copian al buffer circular sin reservar memoria; el texto final se
+  * compone en el hilo del logger.
   *
-  * @param classObj Nombre de la clase donde ocurre el evento.
-  * @param method Nombre del mtodo donde ocurre el evento.
-  * @param state Estado del recurso (ejemplo: "OK", "FAILED").
+  * @param classObj Nombre de la clase donde ocurre el evento (literal).
+  * @param method Nombre del mtodo donde ocurre el evento (literal).
+  * @param ... Formato estilo printf (literal) seguido de sus argumentos.
   */
-#define MESSAGE( classObj, method, state )   \
-{                                            \
-   std::wostringstream os_;                  \
-   os_ << classObj << "::" << method << " : " << "[CREATION OF RESOURCE " << ": " << state << "] \n"; \
-   OutputDebugStringW( os_.str().c_str() );  \
-}
+#define MESSAGE(classObj, method, ...) LOG_INFO(classObj, method, __VA_ARGS__)
 
   /**
-   * @brief Macro para registrar mensajes de error en la ventana de depuracin.
+   * @brief Macro para registrar mensajes de error.
    *
-   * Captura informacin detallada de la clase, mtodo y descripcin del error.
-   * Si ocurre un fallo durante el registro, captura la excepcin y notifica.
+   * Igual que MESSAGE pero con nivel LOG_LEVEL_ERROR. Solo se elimina en
+   * compilacin si NAVI_LOG_LEVEL es mayor que 3 (vase LOG_ERROR en Logger.h).
    *
-   * @param classObj Nombre de la clase donde ocurre el error.
-   * @param method Nombre del mtodo donde ocurre el error.
-   * @param errorMSG Mensaje descriptivo del error.
+   * @param classObj Nombre de la clase donde ocurre el error (literal).
+   * @param method Nombre del mtodo donde ocurre el error (literal).
+   * @param ... Formato estilo printf (literal) seguido de sus argumentos.
    */
-#define ERROR(classObj, method, errorMSG)                     \
-{                                                             \
-    try {                                                     \
-        std::wostringstream os_;                              \
-        os_ << L"ERROR : " << classObj << L"::" << method     \
-            << L" : " << errorMSG << L"\n";                   \
-        OutputDebugStringW(os_.str().c_str());                \
-    } catch (...) {                                           \
-        OutputDebugStringW(L"Failed to log error message.\n");\
-    }                                                         \
-}
+#ifdef ERROR
+#undef ERROR  // wingdi.h define ERROR como 0.
+#endif
+#define ERROR(classObj, method, ...) LOG_ERROR(classObj, method, __VA_ARGS__)
 
    /**
     * @brief Representa un vrtice simple con posicin y coordenadas de textura.
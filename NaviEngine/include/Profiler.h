@@ -0,0 +1,326 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file Profiler.h
+ * @brief Profiler jerrquico de CPU basado en zonas con alcance (scoped zones).
+ *
+ * Cada hilo escribe sus zonas en un buffer circular propio sin bloqueos
+ * (un productor, un consumidor). Una vez por frame, Profiler::endFrame()
+ * vaca los buffers, agrega los tiempos por zona y, si hay una captura activa,
+ * guarda los eventos para exportarlos a JSON de Chrome (chrome://tracing,
+ * Perfetto) o a un formato binario compacto.
+ *
+ * Con NAVI_PROFILER_ENABLED = 0 las macros desaparecen por completo. Compilado
+ * pero deshabilitado en tiempo de ejecucin, el coste de una zona es una lectura
+ * atmica relajada y un salto.
+ */
+#ifndef NAVI_PROFILER_ENABLED
+#define NAVI_PROFILER_ENABLED 1
+#endif
+
+/**
+ * @struct ProfileEvent
+ * @brief Zona terminada tal como se guarda en el buffer de un hilo.
+ */
+struct
+ProfileEvent {
+  const char* name;     /**< Nombre de la zona (literal con vida esttica). */
+  uint64_t    start;    /**< Inicio en nanosegundos (Profiler::now()). */
+  uint64_t    end;      /**< Fin en nanosegundos. */
+  uint32_t    depth;    /**< Profundidad de anidacin dentro del hilo. */
+  uint32_t    threadId; /**< Identificador compacto del hilo. */
+};
+
+/**
+ * @struct ProfileZoneStats
+ * @brief Tiempos agregados de una zona durante un frame.
+ */
+struct
+ProfileZoneStats {
+  const char* name = nullptr; /**< Nombre de la zona. */
+  uint32_t    calls = 0;      /**< Veces que se ejecut en el frame. */
+  uint32_t    depth = 0;      /**< Menor profundidad a la que apareci. */
+  uint64_t    totalNs = 0;    /**< Tiempo inclusivo (con zonas hijas). */
+  uint64_t    selfNs = 0;     /**< Tiempo exclusivo (sin zonas hijas). */
+  uint64_t    maxNs = 0;      /**< Llamada ms larga. */
+};
+
+/**
+ * @class ProfileThreadBuffer
+ * @brief Buffer circular SPSC de eventos de un hilo.
+ *
+ * Solo el hilo dueo escribe (push) y solo Profiler::endFrame() lee (drain).
+ * Si el buffer se llena los eventos nuevos se descartan y se cuentan.
+ */
+class
+ProfileThreadBuffer {
+public:
+  /** @brief Capacidad del buffer (potencia de dos). */
+  static constexpr uint32_t kCapacity = 1u << 14;
+
+  /**
+   * @brief Constructor.
+   * @param threadId Identificador compacto del hilo dueo.
+   * @param threadName Nombre legible del hilo.
+   */
+  ProfileThreadBuffer(uint32_t threadId, std::string threadName);
+
+  /**
+   * @brief Aade un evento (solo desde el hilo dueo).
+   */
+  void
+  push(const ProfileEvent& event) {
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= kCapacity) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    m_events[head & (kCapacity - 1)] = event;
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Mueve los eventos pendientes a @p out (solo desde el consumidor).
+   * @return Nmero de eventos extrados.
+   */
+  size_t
+  drain(std::vector<ProfileEvent>& out);
+
+public:
+  /** @brief Profundidad actual de zonas abiertas en el hilo. */
+  uint32_t m_depth = 0;
+
+  /** @brief Identificador compacto del hilo. */
+  uint32_t m_threadId = 0;
+
+  /** @brief Nombre del hilo para la exportacin. */
+  std::string m_threadName;
+
+  /** @brief Eventos descartados por buffer lleno. */
+  std::atomic<uint64_t> m_dropped{ 0 };
+
+private:
+  /** @brief Almacenamiento circular. */
+  std::unique_ptr<ProfileEvent[]> m_events;
+
+  /** @brief Siguiente posicin de escritura (productor). */
+  alignas(64) std::atomic<uint64_t> m_head{ 0 };
+
+  /** @brief Siguiente posicin de lectura (consumidor). */
+  alignas(64) std::atomic<uint64_t> m_tail{ 0 };
+};
+
+/**
+ * @class Profiler
+ * @brief Registro global de buffers por hilo, agregacin por frame y exportacin.
+ */
+class
+Profiler {
+public:
+  /**
+   * @brief Instancia global del profiler.
+   */
+  static Profiler&
+  instance();
+
+  /**
+   * @brief Marca de tiempo monotnica en nanosegundos.
+   */
+  static uint64_t
+  now();
+
+  /**
+   * @brief Consulta rpida del estado habilitado (usada por las zonas).
+   */
+  static bool
+  isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Habilita o deshabilita la recoleccin en tiempo de ejecucin.
+   */
+  void
+  setEnabled(bool enabled);
+
+  /**
+   * @brief Buffer del hilo llamador; lo registra la primera vez como "Thread <id>".
+   */
+  ProfileThreadBuffer*
+  threadBuffer();
+
+  /**
+   * @brief Asigna un nombre legible al hilo llamador (BaseApp::run() nombra "Main"
+   *        al hilo principal y JobSystem a sus trabajadores).
+   */
+  void
+  setThreadName(const std::string& name);
+
+  /**
+   * @brief Cierra el frame: vaca los buffers y agrega los tiempos por zona.
+   */
+  void
+  endFrame();
+
+  /**
+   * @brief Zonas agregadas del ltimo frame cerrado.
+   */
+  const std::vector<ProfileZoneStats>&
+  lastFrame() const { return m_lastFrame; }
+
+  /**
+   * @brief Duracin del ltimo frame cerrado en nanosegundos.
+   */
+  uint64_t
+  lastFrameDuration() const { return m_lastFrameDuration; }
+
+  /**
+   * @brief Nmero de frames cerrados.
+   */
+  uint64_t
+  frameIndex() const { return m_frameIndex; }
+
+  /**
+   * @brief Empieza a guardar eventos para exportarlos.
+   * @param maxEvents Lmite de eventos guardados (los siguientes se descartan).
+   */
+  void
+  beginCapture(size_t maxEvents = 1u << 20);
+
+  /**
+   * @brief Deja de guardar eventos (los ya capturados se conservan).
+   */
+  void
+  endCapture();
+
+  /**
+   * @brief Exporta la captura en formato JSON de Chrome Trace Event.
+   * @return true si el archivo se escribi.
+   */
+  bool
+  exportChromeTrace(const std::string& fileName);
+
+  /**
+   * @brief Exporta la captura en el formato binario compacto "NPRF".
+   *
+   * Estructura (little endian): magic "NPRF", u32 versin, u64 ticks por segundo,
+   * u32 nmero de nombres y cada nombre como u16 longitud + bytes, u32 nmero de
+   * eventos y cada evento como u32 nombre, u32 hilo, u32 profundidad, u64 inicio,
+   * u64 duracin.
+   *
+   * @return true si el archivo se escribi.
+   */
+  bool
+  exportBinary(const std::string& fileName);
+
+  /**
+   * @brief Eventos capturados hasta el momento.
+   */
+  size_t
+  capturedEventCount() const { return m_capture.size(); }
+
+private:
+  Profiler() = default;
+
+  /**
+   * @brief Calcula el tiempo exclusivo y agrega un lote de eventos por zona.
+   */
+  void
+  aggregate(std::vector<ProfileEvent>& events);
+
+private:
+  /** @brief Estado habilitado compartido por todas las zonas. */
+  static std::atomic<bool> s_enabled;
+
+  /** @brief Protege el registro de hilos y la captura. */
+  std::mutex m_mutex;
+
+  /** @brief Buffers de todos los hilos registrados (viven hasta el final del proceso). */
+  std::vector<std::unique_ptr<ProfileThreadBuffer>> m_threads;
+
+  /** @brief Eventos del frame en curso (reutilizado entre frames). */
+  std::vector<ProfileEvent> m_frameEvents;
+
+  /** @brief Resultado agregado del ltimo frame. */
+  std::vector<ProfileZoneStats> m_lastFrame;
+
+  /** @brief Eventos capturados para exportar. */
+  std::vector<ProfileEvent> m_capture;
+
+  /** @brief Lmite de eventos de la captura. */
+  size_t m_captureLimit = 0;
+
+  /** @brief Indica si hay una captura activa. */
+  bool m_capturing = false;
+
+  /** @brief Inicio del frame en curso (ns). */
+  uint64_t m_frameStart = 0;
+
+  /** @brief Duracin del ltimo frame (ns). */
+  uint64_t m_lastFrameDuration = 0;
+
+  /** @brief Frames cerrados. */
+  uint64_t m_frameIndex = 0;
+};
+
+/**
+ * @class ProfileScope
+ * @brief Zona RAII: mide desde su construccin hasta su destruccin.
+ */
+class
+ProfileScope {
+public:
+  /**
+   * @brief Abre la zona si el profiler est habilitado.
+   * @param name Nombre de la zona; debe tener vida esttica (literal).
+   */
+  explicit
+  ProfileScope(const char* name) {
+    if (Profiler::isEnabled()) {
+      m_buffer = Profiler::instance().threadBuffer();
+      m_name = name;
+      m_depth = m_buffer->m_depth++;
+      m_start = Profiler::now();
+    }
+  }
+
+  /**
+   * @brief Cierra la zona y la escribe en el buffer del hilo.
+   */
+  ~ProfileScope() {
+    if (m_buffer) {
+      ProfileEvent event = { m_name, m_start, Profiler::now(), m_depth, m_buffer->m_threadId };
+      m_buffer->push(event);
+      --m_buffer->m_depth;
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  ProfileThreadBuffer* m_buffer = nullptr;
+  const char* m_name = nullptr;
+  uint64_t m_start = 0;
+  uint32_t m_depth = 0;
+};
+
+#define NAVI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NAVI_PROFILE_CONCAT(a, b) NAVI_PROFILE_CONCAT_IMPL(a, b)
+
+#if NAVI_PROFILER_ENABLED
+/** @brief Abre una zona con nombre hasta el final del bloque actual. */
+#define NAVI_PROFILE_SCOPE(name) ProfileScope NAVI_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+/** @brief Abre una zona con el nombre de la funcin actual. */
+#define NAVI_PROFILE_FUNCTION() NAVI_PROFILE_SCOPE(__FUNCTION__)
+/** @brief Cierra el frame del profiler. */
+#define NAVI_PROFILE_END_FRAME() Profiler::instance().endFrame()
+#else
+#define NAVI_PROFILE_SCOPE(name) ((void)0)
+#define NAVI_PROFILE_FUNCTION() ((void)0)
+#define NAVI_PROFILE_END_FRAME() ((void)0)
+#endif
@@ -0,0 +1,201 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file ShaderCache.h
+ * @brief Cach en disco de bytecode de shaders compilados.
+ *
+ * La clave de cada shader es un hash FNV-1a de 64 bits del cdigo fuente, del
+ * contenido de todos sus #include (recursivos), de los defines, del punto de
+ * entrada, del perfil, de las banderas y de la versin del compilador. Si
+ * cualquiera cambia, la clave cambia y el shader se recompila; las entradas
+ * viejas simplemente dejan de usarse.
+ *
+ * La compilacin se delega en una ShaderCompiler, de modo que la bsqueda, la
+ * invalidacin y el almacenamiento se pueden probar fuera de Windows con un
+ * compilador simulado. Solo D3DShaderCompiler depende de DirectX.
+ */
+
+/**
+ * @struct ShaderCompileRequest
+ * @brief Todo lo que determina el bytecode de un shader.
+ */
+struct
+ShaderCompileRequest {
+  std::string fileName;   /**< Archivo fuente (.fx / .hlsl). */
+  std::string entryPoint; /**< Funcin de entrada, por ejemplo "VS". */
+  std::string profile;    /**< Perfil, por ejemplo "vs_4_0". */
+  std::vector<std::pair<std::string, std::string>> defines; /**< Macros (nombre, valor). */
+  uint32_t flags = 0;     /**< Banderas del compilador (D3DCOMPILE_*). */
+};
+
+/**
+ * @class ShaderCompiler
+ * @brief Interfaz de un compilador de shaders.
+ */
+class
+ShaderCompiler {
+public:
+  /**
+   * @brief Destructor virtual por defecto.
+   */
+  virtual
+  ~ShaderCompiler() = default;
+
+  /**
+   * @brief Compila el shader descrito por @p request.
+   * @param request Archivo, entrada, perfil, defines y banderas.
+   * @param bytecode Bytecode resultante.
+   * @param errors Mensajes del compilador si falla.
+   * @return true si la compilacin tuvo xito.
+   */
+  virtual bool
+  compile(const ShaderCompileRequest& request,
+          std::vector<uint8_t>& bytecode,
+          std::string& errors) = 0;
+
+  /**
+   * @brief Identifica al compilador; forma parte de la clave de cach.
+   */
+  virtual std::string
+  version() const = 0;
+};
+
+#if defined(_WIN32)
+/**
+ * @class D3DShaderCompiler
+ * @brief Compilador basado en D3DCompile. Lee la fuente con VirtualFileSystem y
+ *        resuelve los #include relativos al archivo que los incluye.
+ */
+class
+D3DShaderCompiler : public ShaderCompiler {
+public:
+  bool
+  compile(const ShaderCompileRequest& request,
+          std::vector<uint8_t>& bytecode,
+          std::string& errors) override;
+
+  std::string
+  version() const override;
+};
+#endif
+
+/**
+ * @class ShaderCache
+ * @brief Busca el bytecode en disco y solo compila si falta o es invlido.
+ *
+ * Cada entrada es un archivo <directorio>/<clave>.cso con una cabecera (firma,
+ * versin de formato, clave, tamao y checksum del bytecode). Una entrada
+ * truncada o corrupta se trata como fallo de cach y se reescribe. getOrCompile()
+ * puede llamarse desde varios hilos a la vez.
+ */
+class
+ShaderCache {
+public:
+  /**
+   * @brief Constructor por defecto (cach deshabilitada hasta init()).
+   */
+  ShaderCache() = default;
+
+  ShaderCache(const ShaderCache&) = delete;
+  ShaderCache& operator=(const ShaderCache&) = delete;
+
+  /**
+   * @brief Cach global usada por ShaderProgram.
+   */
+  static ShaderCache&
+  instance();
+
+  /**
+   * @brief Habilita la cach.
+   * @param directory Carpeta de las entradas (se crea si no existe).
+   * @param compiler Compilador usado en los fallos de cach.
+   * @return true si la carpeta existe o pudo crearse.
+   */
+  bool
+  init(const std::string& directory, ShaderCompiler& compiler);
+
+  /**
+   * @brief Deshabilita la cach (las entradas en disco se conservan).
+   */
+  void
+  destroy();
+
+  /**
+   * @brief Indica si init() tuvo xito.
+   */
+  bool
+  isInitialized() const { return m_compiler != nullptr; }
+
+  /**
+   * @brief Devuelve el bytecode de @p request, de disco o compilndolo y guardndolo.
+   * @param request Shader solicitado.
+   * @param bytecode Bytecode resultante.
+   * @param errors Mensajes del compilador si falla (opcional).
+   * @return true si hay bytecode vlido.
+   */
+  bool
+  getOrCompile(const ShaderCompileRequest& request,
+               std::vector<uint8_t>& bytecode,
+               std::string* errors = nullptr);
+
+  /**
+   * @brief Calcula la clave de @p request leyendo la fuente y sus #include.
+   * @return La clave, o 0 si el archivo fuente no existe.
+   */
+  uint64_t
+  computeKey(const ShaderCompileRequest& request) const;
+
+  /**
+   * @brief Lee y valida la entrada @p key.
+   * @return false si no existe o no es vlida.
+   */
+  bool
+  load(uint64_t key, std::vector<uint8_t>& bytecode) const;
+
+  /**
+   * @brief Escribe la entrada @p key (archivo temporal y renombrado).
+   * @return true si se escribi completa.
+   */
+  bool
+  store(uint64_t key, const std::vector<uint8_t>& bytecode) const;
+
+  /**
+   * @brief Ruta del archivo de la entrada @p key.
+   */
+  std::string
+  entryPath(uint64_t key) const;
+
+  /**
+   * @brief Shaders servidos desde disco.
+   */
+  uint32_t
+  hits() const { return m_hits.load(); }
+
+  /**
+   * @brief Shaders que hubo que compilar.
+   */
+  uint32_t
+  misses() const { return m_misses.load(); }
+
+  /**
+   * @brief Compilaciones fallidas.
+   */
+  uint32_t
+  failures() const { return m_failures.load(); }
+
+private:
+  /** @brief Carpeta de las entradas. */
+  std::string m_directory;
+
+  /** @brief Compilador para los fallos de cach (nullptr = deshabilitada). */
+  ShaderCompiler* m_compiler = nullptr;
+
+  std::atomic<uint32_t> m_hits{ 0 };
+  std::atomic<uint32_t> m_misses{ 0 };
+  std::atomic<uint32_t> m_failures{ 0 };
+};
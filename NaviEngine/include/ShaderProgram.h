@@ -45,6 +45,20 @@ public:
       const std::string& fileName,
       std::vector < D3D11_INPUT_ELEMENT_DESC> Layout);
 
+  /**
+   * @brief Inicializa el programa a partir de bytecode ya compilado (por ejemplo, una variante).
+   * @param device Referencia al dispositivo de renderizado.
+   * @param vertexBytecode Bytecode del Vertex Shader.
+   * @param pixelBytecode Bytecode del Pixel Shader.
+   * @param Layout Vector con la descripcin de los elementos de entrada del shader.
+   * @return HRESULT que indica el resultado de la operacin.
+   */
+  HRESULT
+  init(Device& device,
+      const std::vector<uint8_t>& vertexBytecode,
+      const std::vector<uint8_t>& pixelBytecode,
+      std::vector<D3D11_INPUT_ELEMENT_DESC> Layout);
+
   /**
    * @brief Actualiza los parmetros o recursos del shader si es necesario.
    */
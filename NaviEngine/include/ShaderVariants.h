@@ -0,0 +1,111 @@
+#pragma once
+#include "Prerequisites.h"
+#include "ShaderProgram.h"
+
+class
+Device;
+
+class
+DeviceContext;
+
+/**
+ * @brief Combinacin de palabras clave de un shader: el bit i activa la palabra i.
+ */
+using ShaderVariantMask = uint32_t;
+
+/**
+ * @struct ShaderStageEntryPoints
+ * @brief Funciones de entrada y perfiles del Vertex y el Pixel Shader de las variantes.
+ */
+struct
+ShaderStageEntryPoints {
+  std::string vertexEntryPoint = "VS";
+  std::string vertexProfile = "vs_4_0";
+  std::string pixelEntryPoint = "PS";
+  std::string pixelProfile = "ps_4_0";
+};
+
+/**
+ * @class ShaderVariants
+ * @brief Conjunto de permutaciones de un mismo archivo de shader.
+ *
+ * El programa declara palabras clave (por ejemplo TEXTURED, VERTEX_COLOR,
+ * INSTANCING, SKINNING) y cada combinacin se compila como una variante
+ * especializada, con un #define NOMBRE 1 por bit activo, en lugar de un nico
+ * "uber-shader" con ramas. Las variantes se compilan en paralelo en el
+ * JobSystem al inicializar (a travs de ShaderCache si est activa, as que en
+ * los arranques siguientes solo se leen de disco) y se guardan en un arreglo
+ * indexado por la mscara: elegir la variante al dibujar es O(1).
+ */
+class
+ShaderVariants {
+public:
+  /** @brief Mximo de palabras clave (2^8 = 256 variantes). */
+  static const unsigned int kMaxKeywords = 8;
+
+  /**
+   * @brief Constructor por defecto.
+   */
+  ShaderVariants() = default;
+
+  /**
+   * @brief Destructor por defecto (los recursos se liberan en destroy()).
+   */
+  ~ShaderVariants() = default;
+
+  /**
+   * @brief Compila y crea las variantes.
+   * @param device Dispositivo de renderizado.
+   * @param fileName Archivo del shader.
+   * @param entryPoints Entradas y perfiles de cada etapa.
+   * @param Layout Descripcin de los elementos de entrada.
+   * @param keywords Palabras clave, en orden de bit.
+   * @param masks Variantes a construir (vaco = todas las combinaciones); las
+   *        repetidas se construyen una vez.
+   * @return S_OK si todas las variantes pedidas se crearon.
+   */
+  HRESULT
+  init(Device& device,
+       const std::string& fileName,
+       const ShaderStageEntryPoints& entryPoints,
+       const std::vector<D3D11_INPUT_ELEMENT_DESC>& Layout,
+       const std::vector<std::string>& keywords,
+       std::vector<ShaderVariantMask> masks = {});
+
+  /**
+   * @brief Enlaza al pipeline la variante @p mask (layout, VS y PS).
+   */
+  void
+  render(DeviceContext& deviceContext, ShaderVariantMask mask);
+
+  /**
+   * @brief Libera todas las variantes.
+   */
+  void
+  destroy();
+
+  /**
+   * @brief Bit de la palabra clave @p keyword (0 si no est declarada).
+   */
+  ShaderVariantMask
+  maskOf(const std::string& keyword) const;
+
+  /**
+   * @brief Indica si la variante @p mask se construy.
+   */
+  bool
+  hasVariant(ShaderVariantMask mask) const;
+
+  /**
+   * @brief Defines que corresponden a @p mask.
+   */
+  static std::vector<std::pair<std::string, std::string>>
+  definesFor(const std::vector<std::string>& keywords, ShaderVariantMask mask);
+
+private:
+  /** @brief Palabras clave declaradas, en orden de bit. */
+  std::vector<std::string> m_keywords;
+
+  /** @brief Variantes indexadas por mscara; las no construidas quedan vacas. */
+  std::vector<ShaderProgram> m_variants;
+};
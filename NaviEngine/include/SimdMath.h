@@ -0,0 +1,694 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @file SimdMath.h
+ * @brief Vectores, matrices y cuaterniones con rutas SSE/AVX2 y equivalente escalar.
+ *
+ * Sustituye a xnamath.h en el cdigo de CPU que no toca Direct3D, de modo que
+ * compila y se perfila tambin fuera de Windows. Sigue las convenciones de
+ * xnamath: vectores fila (v' = v * M), matrices por filas con la traslacin en
+ * r[3], sistema de mano izquierda y cuaterniones (x, y, z, w). Matrix tiene la
+ * misma disposicin que XMMATRIX (cuatro filas de 16 bytes alineadas), as que
+ * puede copiarse tal cual a un constant buffer o a un XMMATRIX.
+ *
+ * La ruta se elige al compilar:
+ * - SSE2 en x64 (SIMD_MATH_SSE), con _mm_dp_ps si hay SSE4.1 (/arch:AVX o -msse4.1).
+ * - FMA en las multiplicaciones-suma si hay AVX2 (/arch:AVX2 o -mavx2 -mfma); los
+ *   ncleos por lotes de SimdMath.cpp usan entonces registros de 256 bits.
+ * - Escalar en el resto de plataformas o si se define NAVI_MATH_SCALAR.
+ *
+ * Las funciones de transformacin de un elemento estn aqu, en lnea; las de
+ * lotes (puntos, normales, AABB y matrices) en SimdMath.cpp.
+ */
+
+#if !defined(NAVI_MATH_SCALAR) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SIMD_MATH_SSE 1
+#include <emmintrin.h>
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define SIMD_MATH_SSE4 1
+#include <smmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define SIMD_MATH_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define SIMD_MATH_FMA 1
+#endif
+#endif
+
+namespace SimdMath {
+  //
+  // Tipos de almacenamiento (sin requisitos de alineacin).
+  //
+
+  /** @brief Dos floats; misma disposicin que XMFLOAT2. */
+  struct
+  Float2 {
+    float x;
+    float y;
+  };
+
+  /** @brief Tres floats; misma disposicin que XMFLOAT3. */
+  struct
+  Float3 {
+    float x;
+    float y;
+    float z;
+  };
+
+  /** @brief Cuatro floats; misma disposicin que XMFLOAT4. */
+  struct
+  Float4 {
+    float x;
+    float y;
+    float z;
+    float w;
+  };
+
+  /** @brief Matriz 4x4 por filas; misma disposicin que XMFLOAT4X4. */
+  struct
+  Float4x4 {
+    float m[4][4];
+  };
+
+  /**
+   * @struct Aabb
+   * @brief Caja alineada con los ejes.
+   */
+  struct
+  Aabb {
+    Float3 min;
+    Float3 max;
+  };
+
+  //
+  // Registro de 4 floats.
+  //
+#if defined(SIMD_MATH_SSE)
+  using Vector = __m128;
+#else
+  struct alignas(16)
+  Vector {
+    float v[4];
+  };
+#endif
+
+  /**
+   * @struct Matrix
+   * @brief Matriz 4x4 en registros: cuatro filas. Misma disposicin que XMMATRIX.
+   */
+  struct alignas(16)
+  Matrix {
+    Vector r[4];
+  };
+
+  static_assert(sizeof(Matrix) == 64, "Matrix debe tener la disposicin de XMMATRIX");
+  static_assert(sizeof(Float4x4) == 64, "Float4x4 debe tener la disposicin de XMFLOAT4X4");
+
+  /**
+   * @brief Ruta SIMD compilada: "AVX2", "SSE4.1", "SSE2" o "scalar".
+   */
+  const char*
+  simdPath();
+
+  //
+  // Operaciones bsicas por ruta. El resto de la biblioteca se escribe sobre ellas.
+  //
+#if defined(SIMD_MATH_SSE)
+  inline Vector set(float x, float y, float z, float w) { return _mm_set_ps(w, z, y, x); }
+  inline Vector splat(float value) { return _mm_set1_ps(value); }
+  inline Vector zero() { return _mm_setzero_ps(); }
+  inline Vector add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+  inline Vector subtract(Vector a, Vector b) { return _mm_sub_ps(a, b); }
+  inline Vector multiply(Vector a, Vector b) { return _mm_mul_ps(a, b); }
+  inline Vector divide(Vector a, Vector b) { return _mm_div_ps(a, b); }
+  inline Vector sqrt(Vector a) { return _mm_sqrt_ps(a); }
+  inline Vector minimum(Vector a, Vector b) { return _mm_min_ps(a, b); }
+  inline Vector maximum(Vector a, Vector b) { return _mm_max_ps(a, b); }
+  inline Vector abs(Vector a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  inline Vector negate(Vector a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+  /** @brief Magnitud de @p magnitude con el signo de @p sign, componente a componente. */
+  inline Vector
+  copySign(Vector magnitude, Vector sign) {
+    __m128 signBit = _mm_set1_ps(-0.0f);
+    return _mm_or_ps(_mm_andnot_ps(signBit, magnitude), _mm_and_ps(signBit, sign));
+  }
+#if defined(SIMD_MATH_FMA)
+  inline Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm_fmadd_ps(a, b, c); }
+#else
+  inline Vector multiplyAdd(Vector a, Vector b, Vector c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#endif
+
+  /**
+   * @brief Reordena los componentes: permute<1, 2, 0, 3>(v) = (v.y, v.z, v.x, v.w).
+   */
+  template<int X, int Y, int Z, int W>
+  inline Vector
+  permute(Vector v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X)); }
+
+  inline float getX(Vector v) { return _mm_cvtss_f32(v); }
+  inline float getY(Vector v) { return _mm_cvtss_f32(permute<1, 1, 1, 1>(v)); }
+  inline float getZ(Vector v) { return _mm_cvtss_f32(permute<2, 2, 2, 2>(v)); }
+  inline float getW(Vector v) { return _mm_cvtss_f32(permute<3, 3, 3, 3>(v)); }
+
+  /**
+   * @brief Mscara de 4 bits: el bit i vale 1 si a[i] <= b[i] (o a[i] > b[i]).
+   *
+   * Para pruebas de cuatro elementos a la vez con los datos en SoA.
+   */
+  inline int lessOrEqualMask(Vector a, Vector b) { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+  inline int greaterMask(Vector a, Vector b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+
+  /**
+   * @brief Sustituye la w por @p w (x, y, z se conservan).
+   */
+  inline Vector
+  setW(Vector v, float w) {
+    Vector zw = _mm_shuffle_ps(v, _mm_set_ss(w), _MM_SHUFFLE(0, 0, 2, 2));  // (z, z, w', w')
+    return _mm_shuffle_ps(v, zw, _MM_SHUFFLE(2, 0, 1, 0));
+  }
+
+  inline Vector load(const float* source) { return _mm_loadu_ps(source); }
+  inline void store(float* destination, Vector v) { _mm_storeu_ps(destination, v); }
+  inline Vector loadFloat4(const Float4* source) { return _mm_loadu_ps(&source->x); }
+  inline void storeFloat4(Float4* destination, Vector v) { _mm_storeu_ps(&destination->x, v); }
+
+  /**
+   * @brief Carga (x, y, z, 0) sin leer ms all del Float3.
+   */
+  inline Vector
+  loadFloat3(const Float3* source) {
+    __m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+    return _mm_movelh_ps(xy, _mm_load_ss(&source->z));
+  }
+
+  inline void
+  storeFloat3(Float3* destination, Vector v) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_castps_si128(v));
+    _mm_store_ss(&destination->z, permute<2, 2, 2, 2>(v));
+  }
+
+#if defined(SIMD_MATH_SSE4)
+  inline Vector dot3(Vector a, Vector b) { return _mm_dp_ps(a, b, 0x7F); }
+  inline Vector dot4(Vector a, Vector b) { return _mm_dp_ps(a, b, 0xFF); }
+#else
+  inline Vector
+  dot3(Vector a, Vector b) {
+    Vector product = _mm_mul_ps(a, b);
+    Vector sum = _mm_add_ss(product, permute<1, 1, 1, 1>(product));
+    sum = _mm_add_ss(sum, permute<2, 2, 2, 2>(product));
+    return permute<0, 0, 0, 0>(sum);
+  }
+
+  inline Vector
+  dot4(Vector a, Vector b) {
+    Vector product = _mm_mul_ps(a, b);
+    Vector sum = _mm_add_ps(product, permute<2, 3, 0, 1>(product));
+    return _mm_add_ps(sum, permute<1, 0, 3, 2>(sum));
+  }
+#endif
+
+  /**
+   * @brief Traspone una matriz.
+   */
+  inline Matrix
+  transpose(const Matrix& m) {
+    Matrix result = m;
+    _MM_TRANSPOSE4_PS(result.r[0], result.r[1], result.r[2], result.r[3]);
+    return result;
+  }
+#else
+  inline Vector set(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+  inline Vector splat(float value) { return { { value, value, value, value } }; }
+  inline Vector zero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+
+  /**
+   * @brief Aplica @p op componente a componente.
+   */
+  template<typename Op>
+  inline Vector
+  componentWise(Vector a, Vector b, Op op) {
+    return { { op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]) } };
+  }
+
+  inline Vector add(Vector a, Vector b) { return componentWise(a, b, [](float x, float y) { return x + y; }); }
+  inline Vector subtract(Vector a, Vector b) { return componentWise(a, b, [](float x, float y) { return x - y; }); }
+  inline Vector multiply(Vector a, Vector b) { return componentWise(a, b, [](float x, float y) { return x * y; }); }
+  inline Vector divide(Vector a, Vector b) { return componentWise(a, b, [](float x, float y) { return x / y; }); }
+  inline Vector minimum(Vector a, Vector b) { return componentWise(a, b, [](float x, float y) { return y < x ? y : x; }); }
+  inline Vector maximum(Vector a, Vector b) { return componentWise(a, b, [](float x, float y) { return y > x ? y : x; }); }
+  inline Vector sqrt(Vector a) { return { { std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) } }; }
+  inline Vector abs(Vector a) { return { { std::fabs(a.v[0]), std::fabs(a.v[1]), std::fabs(a.v[2]), std::fabs(a.v[3]) } }; }
+  inline Vector negate(Vector a) { return { { -a.v[0], -a.v[1], -a.v[2], -a.v[3] } }; }
+  inline Vector
+  copySign(Vector magnitude, Vector sign) {
+    return { { std::copysign(magnitude.v[0], sign.v[0]), std::copysign(magnitude.v[1], sign.v[1]),
+               std::copysign(magnitude.v[2], sign.v[2]), std::copysign(magnitude.v[3], sign.v[3]) } };
+  }
+  inline Vector multiplyAdd(Vector a, Vector b, Vector c) { return add(multiply(a, b), c); }
+
+  /**
+   * @brief Reordena los componentes: permute<1, 2, 0, 3>(v) = (v.y, v.z, v.x, v.w).
+   */
+  template<int X, int Y, int Z, int W>
+  inline Vector
+  permute(Vector v) { return { { v.v[X], v.v[Y], v.v[Z], v.v[W] } }; }
+
+  inline float getX(Vector v) { return v.v[0]; }
+  inline float getY(Vector v) { return v.v[1]; }
+  inline float getZ(Vector v) { return v.v[2]; }
+  inline float getW(Vector v) { return v.v[3]; }
+
+  /**
+   * @brief Mscara de 4 bits: el bit i vale 1 si a[i] <= b[i] (o a[i] > b[i]).
+   *
+   * Para pruebas de cuatro elementos a la vez con los datos en SoA.
+   */
+  inline int
+  lessOrEqualMask(Vector a, Vector b) {
+    return (a.v[0] <= b.v[0] ? 1 : 0) | (a.v[1] <= b.v[1] ? 2 : 0) |
+           (a.v[2] <= b.v[2] ? 4 : 0) | (a.v[3] <= b.v[3] ? 8 : 0);
+  }
+
+  inline int
+  greaterMask(Vector a, Vector b) {
+    return (a.v[0] > b.v[0] ? 1 : 0) | (a.v[1] > b.v[1] ? 2 : 0) |
+           (a.v[2] > b.v[2] ? 4 : 0) | (a.v[3] > b.v[3] ? 8 : 0);
+  }
+
+  /**
+   * @brief Sustituye la w por @p w (x, y, z se conservan).
+   */
+  inline Vector
+  setW(Vector v, float w) {
+    v.v[3] = w;
+    return v;
+  }
+
+  inline Vector load(const float* source) { return { { source[0], source[1], source[2], source[3] } }; }
+  inline void store(float* destination, Vector v) { std::memcpy(destination, v.v, sizeof(v.v)); }
+  inline Vector loadFloat4(const Float4* source) { return { { source->x, source->y, source->z, source->w } }; }
+  inline void storeFloat4(Float4* destination, Vector v) { std::memcpy(destination, v.v, sizeof(Float4)); }
+
+  /**
+   * @brief Carga (x, y, z, 0).
+   */
+  inline Vector loadFloat3(const Float3* source) { return { { source->x, source->y, source->z, 0.0f } }; }
+  inline void storeFloat3(Float3* destination, Vector v) { std::memcpy(destination, v.v, sizeof(Float3)); }
+
+  inline Vector dot3(Vector a, Vector b) { return splat(a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2]); }
+  inline Vector dot4(Vector a, Vector b) { return splat(a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3]); }
+
+  /**
+   * @brief Traspone una matriz.
+   */
+  inline Matrix
+  transpose(const Matrix& m) {
+    Matrix result;
+    for (int row = 0; row < 4; ++row) {
+      for (int column = 0; column < 4; ++column) {
+        result.r[row].v[column] = m.r[column].v[row];
+      }
+    }
+    return result;
+  }
+#endif
+
+  //
+  // Vectores.
+  //
+  inline Vector splatX(Vector v) { return permute<0, 0, 0, 0>(v); }
+  inline Vector splatY(Vector v) { return permute<1, 1, 1, 1>(v); }
+  inline Vector splatZ(Vector v) { return permute<2, 2, 2, 2>(v); }
+  inline Vector splatW(Vector v) { return permute<3, 3, 3, 3>(v); }
+  inline Vector scale(Vector v, float factor) { return multiply(v, splat(factor)); }
+
+  /**
+   * @brief Interpolacin lineal a + (b - a) * t.
+   */
+  inline Vector
+  lerp(Vector a, Vector b, float t) { return multiplyAdd(subtract(b, a), splat(t), a); }
+
+  /**
+   * @brief Producto vectorial de las componentes xyz (w = 0).
+   */
+  inline Vector
+  cross3(Vector a, Vector b) {
+    Vector result = subtract(multiply(permute<1, 2, 0, 3>(a), permute<2, 0, 1, 3>(b)),
+                             multiply(permute<2, 0, 1, 3>(a), permute<1, 2, 0, 3>(b)));
+    return setW(result, 0.0f);
+  }
+
+  inline Vector length3(Vector v) { return sqrt(dot3(v, v)); }
+  inline Vector length4(Vector v) { return sqrt(dot4(v, v)); }
+
+  /**
+   * @brief Normaliza xyz. Un vector de longitud 0 devuelve 0.
+   */
+  inline Vector
+  normalize3(Vector v) {
+    float length = getX(length3(v));
+    return length > 0.0f ? divide(v, splat(length)) : zero();
+  }
+
+  /**
+   * @brief Normaliza los cuatro componentes. Un vector de longitud 0 devuelve 0.
+   */
+  inline Vector
+  normalize4(Vector v) {
+    float length = getX(length4(v));
+    return length > 0.0f ? divide(v, splat(length)) : zero();
+  }
+
+  /**
+   * @brief Compara componente a componente con una tolerancia absoluta.
+   */
+  inline bool
+  nearEqual(Vector a, Vector b, float epsilon) {
+    Vector difference = abs(subtract(a, b));
+    return getX(difference) <= epsilon && getY(difference) <= epsilon &&
+           getZ(difference) <= epsilon && getW(difference) <= epsilon;
+  }
+
+  //
+  // Matrices.
+  //
+  inline Matrix
+  identity() {
+    return { { set(1.0f, 0.0f, 0.0f, 0.0f), set(0.0f, 1.0f, 0.0f, 0.0f),
+               set(0.0f, 0.0f, 1.0f, 0.0f), set(0.0f, 0.0f, 0.0f, 1.0f) } };
+  }
+
+  /**
+   * @brief v * M con los cuatro componentes de @p v.
+   */
+  inline Vector
+  transform4(Vector v, const Matrix& m) {
+    Vector result = multiply(splatX(v), m.r[0]);
+    result = multiplyAdd(splatY(v), m.r[1], result);
+    result = multiplyAdd(splatZ(v), m.r[2], result);
+    return multiplyAdd(splatW(v), m.r[3], result);
+  }
+
+  /**
+   * @brief Transforma un punto (w = 1) sin divisin perspectiva.
+   */
+  inline Vector
+  transformPoint(Vector point, const Matrix& m) {
+    Vector result = multiplyAdd(splatX(point), m.r[0], m.r[3]);
+    result = multiplyAdd(splatY(point), m.r[1], result);
+    return multiplyAdd(splatZ(point), m.r[2], result);
+  }
+
+  /**
+   * @brief Transforma una direccin (w = 0): solo la parte 3x3.
+   */
+  inline Vector
+  transformNormal(Vector normal, const Matrix& m) {
+    Vector result = multiply(splatX(normal), m.r[0]);
+    result = multiplyAdd(splatY(normal), m.r[1], result);
+    return multiplyAdd(splatZ(normal), m.r[2], result);
+  }
+
+  /**
+   * @brief a * b: primero se aplica @p a y despus @p b.
+   */
+  inline Matrix
+  multiply(const Matrix& a, const Matrix& b) {
+    return { { transform4(a.r[0], b), transform4(a.r[1], b), transform4(a.r[2], b), transform4(a.r[3], b) } };
+  }
+
+  inline Matrix
+  translation(float x, float y, float z) {
+    Matrix result = identity();
+    result.r[3] = set(x, y, z, 1.0f);
+    return result;
+  }
+
+  inline Matrix
+  scaling(float x, float y, float z) {
+    return { { set(x, 0.0f, 0.0f, 0.0f), set(0.0f, y, 0.0f, 0.0f),
+               set(0.0f, 0.0f, z, 0.0f), set(0.0f, 0.0f, 0.0f, 1.0f) } };
+  }
+
+  inline Matrix
+  rotationX(float angle) {
+    float s = std::sin(angle);
+    float c = std::cos(angle);
+    return { { set(1.0f, 0.0f, 0.0f, 0.0f), set(0.0f, c, s, 0.0f),
+               set(0.0f, -s, c, 0.0f), set(0.0f, 0.0f, 0.0f, 1.0f) } };
+  }
+
+  inline Matrix
+  rotationY(float angle) {
+    float s = std::sin(angle);
+    float c = std::cos(angle);
+    return { { set(c, 0.0f, -s, 0.0f), set(0.0f, 1.0f, 0.0f, 0.0f),
+               set(s, 0.0f, c, 0.0f), set(0.0f, 0.0f, 0.0f, 1.0f) } };
+  }
+
+  inline Matrix
+  rotationZ(float angle) {
+    float s = std::sin(angle);
+    float c = std::cos(angle);
+    return { { set(c, s, 0.0f, 0.0f), set(-s, c, 0.0f, 0.0f),
+               set(0.0f, 0.0f, 1.0f, 0.0f), set(0.0f, 0.0f, 0.0f, 1.0f) } };
+  }
+
+  /**
+   * @brief Como XMMatrixRotationRollPitchYaw: roll (Z), despus pitch (X), despus yaw (Y).
+   */
+  inline Matrix
+  rotationRollPitchYaw(float pitch, float yaw, float roll) {
+    return multiply(multiply(rotationZ(roll), rotationX(pitch)), rotationY(yaw));
+  }
+
+  /**
+   * @brief Matriz de vista de mano izquierda (XMMatrixLookAtLH).
+   */
+  inline Matrix
+  lookAtLH(Vector eye, Vector focus, Vector up) {
+    Vector zAxis = normalize3(subtract(focus, eye));
+    Vector xAxis = normalize3(cross3(up, zAxis));
+    Vector yAxis = cross3(zAxis, xAxis);
+    Matrix axes = { { xAxis, yAxis, zAxis, set(0.0f, 0.0f, 0.0f, 1.0f) } };
+    Matrix result = transpose(axes);
+    result.r[3] = set(-getX(dot3(xAxis, eye)), -getX(dot3(yAxis, eye)), -getX(dot3(zAxis, eye)), 1.0f);
+    return result;
+  }
+
+  /**
+   * @brief Proyeccin perspectiva de mano izquierda (XMMatrixPerspectiveFovLH).
+   * @param fovY Campo de visin vertical en radianes.
+   */
+  inline Matrix
+  perspectiveFovLH(float fovY, float aspect, float nearZ, float farZ) {
+    float height = 1.0f / std::tan(fovY * 0.5f);
+    float width = height / aspect;
+    float range = farZ / (farZ - nearZ);
+    return { { set(width, 0.0f, 0.0f, 0.0f), set(0.0f, height, 0.0f, 0.0f),
+               set(0.0f, 0.0f, range, 1.0f), set(0.0f, 0.0f, -range * nearZ, 0.0f) } };
+  }
+
+  inline Matrix
+  loadFloat4x4(const Float4x4* source) {
+    return { { loadFloat4(reinterpret_cast<const Float4*>(source->m[0])),
+               loadFloat4(reinterpret_cast<const Float4*>(source->m[1])),
+               loadFloat4(reinterpret_cast<const Float4*>(source->m[2])),
+               loadFloat4(reinterpret_cast<const Float4*>(source->m[3])) } };
+  }
+
+  inline void
+  storeFloat4x4(Float4x4* destination, const Matrix& m) {
+    for (int row = 0; row < 4; ++row) {
+      storeFloat4(reinterpret_cast<Float4*>(destination->m[row]), m.r[row]);
+    }
+  }
+
+  /**
+   * @brief Inversa general por cofactores.
+   * @param determinant Si no es nulo, recibe el determinante.
+   * @return La inversa, o la identidad si la matriz es singular.
+   */
+  Matrix
+  inverse(const Matrix& m, float* determinant = nullptr);
+
+  //
+  // Cuaterniones (x, y, z, w) unitarios.
+  //
+  inline Vector quaternionIdentity() { return set(0.0f, 0.0f, 0.0f, 1.0f); }
+  inline Vector quaternionConjugate(Vector q) { return multiply(q, set(-1.0f, -1.0f, -1.0f, 1.0f)); }
+  inline Vector quaternionNormalize(Vector q) { return normalize4(q); }
+
+  /**
+   * @brief Rotacin de @p angle radianes alrededor de @p axis (normalizado).
+   */
+  inline Vector
+  quaternionRotationAxis(Vector axis, float angle) {
+    return setW(scale(axis, std::sin(angle * 0.5f)), std::cos(angle * 0.5f));
+  }
+
+  /**
+   * @brief Composicin como XMQuaternionMultiply: primero @p a y despus @p b (b * a).
+   */
+  inline Vector
+  quaternionMultiply(Vector a, Vector b) {
+    // (b.w a.v + a.w b.v + b.v x a.v, b.w a.w - b.v . a.v)
+    Vector aw = splatW(a);
+    Vector bw = splatW(b);
+    Vector vector = multiplyAdd(bw, a, multiplyAdd(aw, b, cross3(b, a)));
+    return setW(vector, getW(a) * getW(b) - getX(dot3(a, b)));
+  }
+
+  /**
+   * @brief Como rotationRollPitchYaw(): roll (Z), despus pitch (X), despus yaw (Y).
+   */
+  inline Vector
+  quaternionRotationRollPitchYaw(float pitch, float yaw, float roll) {
+    Vector qRoll = quaternionRotationAxis(set(0.0f, 0.0f, 1.0f, 0.0f), roll);
+    Vector qPitch = quaternionRotationAxis(set(1.0f, 0.0f, 0.0f, 0.0f), pitch);
+    Vector qYaw = quaternionRotationAxis(set(0.0f, 1.0f, 0.0f, 0.0f), yaw);
+    return quaternionMultiply(quaternionMultiply(qRoll, qPitch), qYaw);
+  }
+
+  /**
+   * @brief Rota xyz de @p v con @p q: v + 2w (q x v) + 2 q x (q x v).
+   */
+  inline Vector
+  quaternionRotate(Vector v, Vector q) {
+    Vector t = scale(cross3(q, v), 2.0f);
+    return add(multiplyAdd(splatW(q), t, v), cross3(q, t));
+  }
+
+  /**
+   * @brief Interpolacin lineal normalizada por el camino corto. Ms barata que slerp
+   *        y suficiente entre claves de animacin cercanas.
+   */
+  inline Vector
+  quaternionNlerp(Vector a, Vector b, float t) {
+    if (getX(dot4(a, b)) < 0.0f) {
+      b = negate(b);
+    }
+    return normalize4(lerp(a, b, t));
+  }
+
+  /**
+   * @brief Interpolacin esfrica por el camino corto.
+   */
+  inline Vector
+  quaternionSlerp(Vector a, Vector b, float t) {
+    float cosine = getX(dot4(a, b));
+    if (cosine < 0.0f) {
+      b = negate(b);
+      cosine = -cosine;
+    }
+    if (cosine > 0.9995f) {
+      return normalize4(lerp(a, b, t));
+    }
+    float angle = std::acos(cosine);
+    float inverseSine = 1.0f / std::sin(angle);
+    Vector weightA = splat(std::sin((1.0f - t) * angle) * inverseSine);
+    Vector weightB = splat(std::sin(t * angle) * inverseSine);
+    return multiplyAdd(a, weightA, multiply(b, weightB));
+  }
+
+  /**
+   * @brief Matriz de rotacin de un cuaternin unitario (XMMatrixRotationQuaternion).
+   */
+  inline Matrix
+  rotationQuaternion(Vector q) {
+    float x = getX(q), y = getY(q), z = getZ(q), w = getW(q);
+    float xx = x * x, yy = y * y, zz = z * z;
+    float xy = x * y, xz = x * z, yz = y * z;
+    float wx = w * x, wy = w * y, wz = w * z;
+    return { { set(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f),
+               set(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f),
+               set(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f),
+               set(0.0f, 0.0f, 0.0f, 1.0f) } };
+  }
+
+  /**
+   * @brief Cuaternin de la parte 3x3 de @p m, que debe ser una rotacin pura
+   *        (XMQuaternionRotationMatrix). Inversa de rotationQuaternion().
+   */
+  inline Vector
+  quaternionRotationMatrix(const Matrix& m) {
+    Float4x4 a;
+    storeFloat4x4(&a, m);
+    float trace = a.m[0][0] + a.m[1][1] + a.m[2][2];
+    // Se parte del mayor de w, x, y, z para no dividir por un valor cercano a 0.
+    if (trace > 0.0f) {
+      float s = 0.5f / std::sqrt(trace + 1.0f);
+      return set((a.m[1][2] - a.m[2][1]) * s, (a.m[2][0] - a.m[0][2]) * s,
+                 (a.m[0][1] - a.m[1][0]) * s, 0.25f / s);
+    }
+    if (a.m[0][0] > a.m[1][1] && a.m[0][0] > a.m[2][2]) {
+      float s = 0.5f / std::sqrt(1.0f + a.m[0][0] - a.m[1][1] - a.m[2][2]);
+      return set(0.25f / s, (a.m[0][1] + a.m[1][0]) * s,
+                 (a.m[2][0] + a.m[0][2]) * s, (a.m[1][2] - a.m[2][1]) * s);
+    }
+    if (a.m[1][1] > a.m[2][2]) {
+      float s = 0.5f / std::sqrt(1.0f + a.m[1][1] - a.m[0][0] - a.m[2][2]);
+      return set((a.m[0][1] + a.m[1][0]) * s, 0.25f / s,
+                 (a.m[1][2] + a.m[2][1]) * s, (a.m[2][0] - a.m[0][2]) * s);
+    }
+    float s = 0.5f / std::sqrt(1.0f + a.m[2][2] - a.m[0][0] - a.m[1][1]);
+    return set((a.m[2][0] + a.m[0][2]) * s, (a.m[1][2] + a.m[2][1]) * s,
+               0.25f / s, (a.m[0][1] - a.m[1][0]) * s);
+  }
+
+  /**
+   * @brief Escala, despus rotacin y despus traslacin (una transformacin de hueso).
+   */
+  inline Matrix
+  affineTransformation(Vector scaleFactors, Vector rotation, Vector translationOffset) {
+    Matrix result = rotationQuaternion(rotation);
+    result.r[0] = multiply(result.r[0], splatX(scaleFactors));
+    result.r[1] = multiply(result.r[1], splatY(scaleFactors));
+    result.r[2] = multiply(result.r[2], splatZ(scaleFactors));
+    result.r[3] = setW(translationOffset, 1.0f);
+    return result;
+  }
+
+  //
+  // Ncleos por lotes (SimdMath.cpp). Los de puntos y normales admiten que
+  // @p output sea igual a @p input.
+  //
+
+  /**
+   * @brief output[i] = input[i] * m con w = 1 (sin divisin perspectiva).
+   */
+  void
+  transformPoints(const Matrix& m, const Float3* input, Float3* output, size_t count);
+
+  /**
+   * @brief output[i] = normalize(input[i] * m) con w = 0.
+   *
+   * Con escalas no uniformes @p m debe ser la inversa traspuesta de la matriz de mundo.
+   */
+  void
+  transformNormals(const Matrix& m, const Float3* input, Float3* output, size_t count);
+
+  /**
+   * @brief Caja que contiene cada caja transformada (mtodo de Arvo: centro y extensin).
+   */
+  void
+  transformAabbs(const Matrix& m, const Aabb* input, Aabb* output, size_t count);
+
+  /**
+   * @brief output[i] = a[i] * b. @p output puede ser @p a, pero no @p b.
+   */
+  void
+  multiplyMatrices(const Matrix* a, const Matrix& b, Matrix* output, size_t count);
+
+  /**
+   * @brief output[i] = a[i] * b[i]. @p output puede ser @p a, pero no @p b.
+   */
+  void
+  multiplyMatrices(const Matrix* a, const Matrix* b, Matrix* output, size_t count);
+}
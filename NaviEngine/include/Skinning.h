@@ -0,0 +1,188 @@
+#pragma once
+#include "SimdMath.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file Skinning.h
+ * @brief Esqueletos, evaluacin de poses y skinning de vrtices en la CPU.
+ *
+ * Un frame de animacin pasa por tres pasos:
+ * 1. Skeleton::localToModel(): la pose local de cada articulacin (escala,
+ *    rotacin y traslacin respecto a su padre) a matrices de modelo.
+ * 2. Skeleton::skinningMatrices(): inversa de la pose de bind por la matriz de
+ *    modelo; opcionalmente toDualQuaternions() para el skinning con cuaterniones duales.
+ * 3. skinMeshes(): aplica las matrices a los vrtices de una o varias mallas y
+ *    escribe el resultado con la disposicin de SimpleVertex, normalmente en un
+ *    Buffer dinmico mapeado (Buffer::initDynamic() y Buffer::map()).
+ *
+ * Se siguen las convenciones de SimdMath.h: vectores fila, de modo que la
+ * matriz de modelo de una articulacin es local * modelo del padre.
+ */
+
+/** @brief Influencias por vrtice. */
+const unsigned int kSkinInfluences = 4;
+
+/**
+ * @struct JointPose
+ * @brief Transformacin local de una articulacin respecto a su padre.
+ */
+struct
+JointPose {
+  SimdMath::Float4 rotation = { 0.0f, 0.0f, 0.0f, 1.0f };  /**< Cuaternin unitario. */
+  SimdMath::Float3 translation = { 0.0f, 0.0f, 0.0f };
+  SimdMath::Float3 scale = { 1.0f, 1.0f, 1.0f };
+};
+
+/**
+ * @struct SkinnedVertex
+ * @brief Vrtice de entrada en la pose de bind, con sus articulaciones y pesos.
+ */
+struct
+SkinnedVertex {
+  SimdMath::Float3 position;
+  SimdMath::Float3 normal;
+  SimdMath::Float2 texCoord;
+  uint8_t joints[kSkinInfluences];  /**< ndices en el Skeleton. */
+  float weights[kSkinInfluences];   /**< Suman 1; los sobrantes valen 0. */
+};
+
+/**
+ * @struct SkinnedOutputVertex
+ * @brief Vrtice deformado; misma disposicin que SimpleVertex (Pos, Tex, Normal).
+ */
+struct
+SkinnedOutputVertex {
+  SimdMath::Float3 position;
+  SimdMath::Float2 texCoord;
+  SimdMath::Float3 normal;
+};
+
+/**
+ * @struct DualQuaternion
+ * @brief Transformacin rgida: rotacin @p real y traslacin codificada en @p dual.
+ */
+struct
+DualQuaternion {
+  SimdMath::Float4 real;
+  SimdMath::Float4 dual;
+};
+
+/**
+ * @brief Mezcla de las influencias de cada vrtice.
+ */
+enum
+SkinningMethod {
+  SKINNING_LINEAR = 0,           /**< Mezcla lineal de matrices; admite escala. */
+  SKINNING_DUAL_QUATERNION = 1   /**< Cuaterniones duales: sin prdida de volumen en torsiones, sin escala. */
+};
+
+/**
+ * @class Skeleton
+ * @brief Jerarqua de articulaciones y su pose de bind.
+ *
+ * Las articulaciones estn ordenadas de modo que cada padre precede a sus
+ * hijos, lo que permite evaluar la jerarqua en un nico recorrido.
+ */
+class
+Skeleton {
+public:
+  /** @brief Mximo de articulaciones (los ndices de SkinnedVertex son de 8 bits). */
+  static const unsigned int kMaxJoints = 256;
+
+  Skeleton() = default;
+  ~Skeleton() = default;
+
+  /**
+   * @brief Define la jerarqua.
+   * @param parents Padre de cada articulacin, o -1 en las races; parents[i] < i.
+   * @param restPose Pose local de reposo (la que devuelve restPose()).
+   * @param inverseBindPoses Inversas de las matrices de modelo de bind; si es
+   *        nulo se calculan a partir de @p restPose.
+   * @param error Si no es nulo, recibe la causa del fallo.
+   * @return false si la jerarqua no es vlida.
+   */
+  bool
+  init(const int* parents,
+       const JointPose* restPose,
+       size_t jointCount,
+       const SimdMath::Float4x4* inverseBindPoses = nullptr,
+       std::string* error = nullptr);
+
+  size_t
+  jointCount() const { return m_parents.size(); }
+
+  int
+  parent(size_t joint) const { return m_parents[joint]; }
+
+  const std::vector<JointPose>&
+  restPose() const { return m_restPose; }
+
+  /**
+   * @brief Pose local a matrices de modelo: model[i] = local[i] * model[parent(i)].
+   * @param local jointCount() poses locales.
+   * @param model Recibe jointCount() matrices.
+   */
+  void
+  localToModel(const JointPose* local, SimdMath::Matrix* model) const;
+
+  /**
+   * @brief Matrices de skinning: skin[i] = inverseBind[i] * model[i].
+   *
+   * @p skin no puede ser @p model.
+   */
+  void
+  skinningMatrices(const SimdMath::Matrix* model, SimdMath::Matrix* skin) const;
+
+private:
+  std::vector<int> m_parents;
+  std::vector<JointPose> m_restPose;
+  std::vector<SimdMath::Matrix> m_inverseBindPoses;
+};
+
+/**
+ * @brief Convierte matrices de skinning en cuaterniones duales.
+ *
+ * Se descarta la escala de cada matriz: el skinning con cuaterniones duales
+ * solo representa rotaciones y traslaciones.
+ */
+void
+toDualQuaternions(const SimdMath::Matrix* skin, DualQuaternion* output, size_t count);
+
+/**
+ * @brief Skinning lineal de @p count vrtices con las matrices de @p skin.
+ *
+ * @p output solo se escribe, en orden, as que puede ser memoria de GPU mapeada.
+ */
+void
+skinLinear(const SimdMath::Matrix* skin, const SkinnedVertex* input, SkinnedOutputVertex* output, size_t count);
+
+/**
+ * @brief Skinning con cuaterniones duales (mezcla por el camino corto y normalizada).
+ */
+void
+skinDualQuaternion(const DualQuaternion* skin, const SkinnedVertex* input, SkinnedOutputVertex* output,
+                   size_t count);
+
+/**
+ * @struct SkinningJob
+ * @brief Una malla a deformar en skinMeshes().
+ */
+struct
+SkinningJob {
+  const SkinnedVertex* vertices = nullptr;
+  SkinnedOutputVertex* output = nullptr;
+  size_t count = 0;
+  SkinningMethod method = SKINNING_LINEAR;
+  const SimdMath::Matrix* matrices = nullptr;        /**< Con SKINNING_LINEAR. */
+  const DualQuaternion* dualQuaternions = nullptr;   /**< Con SKINNING_DUAL_QUATERNION. */
+};
+
+/**
+ * @brief Deforma varias mallas, repartiendo mallas y tramos de vrtices entre
+ *        los hilos de JobSystem.
+ * @param parallel Si es false todo se ejecuta en el hilo que llama.
+ */
+void
+skinMeshes(const SkinningJob* jobs, size_t jobCount, bool parallel = true);
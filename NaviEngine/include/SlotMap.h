@@ -0,0 +1,185 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * @file SlotMap.h
+ * @brief Contenedor de objetos referenciados por handles generacionales.
+ *
+ * Los objetos viven empaquetados en un arreglo denso (se recorren sin huecos) y
+ * cada handle apunta a una ranura que guarda la posicin densa y una generacin.
+ * Al borrar, la ranura incrementa su generacin: los handles viejos dejan de ser
+ * vlidos en lugar de apuntar a un objeto distinto que reutilice la ranura.
+ */
+
+/**
+ * @struct SlotHandle
+ * @brief Handle generacional. @p Tag distingue tipos de handle en compilacin.
+ */
+template<typename Tag>
+struct
+SlotHandle {
+  uint32_t index = 0;      /**< Ranura dentro del SlotMap. */
+  uint32_t generation = 0; /**< Generacin de la ranura al crear el handle (0 = nulo). */
+
+  /**
+   * @brief Indica si el handle se obtuvo de una insercin (no comprueba si sigue vivo).
+   */
+  bool
+  isValid() const { return generation != 0; }
+
+  bool
+  operator==(const SlotHandle& other) const {
+    return index == other.index && generation == other.generation;
+  }
+
+  bool
+  operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @class SlotMap
+ * @brief Arreglo denso con acceso O(1) por handle generacional.
+ *
+ * El almacenamiento denso es un std::deque: insertar no invalida referencias a
+ * los objetos existentes. Borrar mueve el ltimo objeto al hueco, as que solo
+ * remove() invalida la referencia al objeto movido.
+ *
+ * No es seguro entre hilos; el dueo debe sincronizar el acceso.
+ */
+template<typename T, typename Tag = T>
+class
+SlotMap {
+public:
+  using Handle = SlotHandle<Tag>;
+
+  /**
+   * @brief Inserta un objeto.
+   * @return Handle al objeto insertado.
+   */
+  Handle
+  insert(T value) {
+    uint32_t slotIndex;
+    if (!m_freeSlots.empty()) {
+      slotIndex = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    }
+    else {
+      slotIndex = static_cast<uint32_t>(m_slots.size());
+      m_slots.push_back({ 0, 1 });
+    }
+
+    Slot& slot = m_slots[slotIndex];
+    slot.dense = static_cast<uint32_t>(m_dense.size());
+    m_dense.push_back(std::move(value));
+    m_denseToSlot.push_back(slotIndex);
+    return { slotIndex, slot.generation };
+  }
+
+  /**
+   * @brief Borra el objeto de @p handle.
+   * @return false si el handle ya no era vlido.
+   */
+  bool
+  remove(Handle handle) {
+    if (!contains(handle)) {
+      return false;
+    }
+    Slot& slot = m_slots[handle.index];
+    uint32_t dense = slot.dense;
+    uint32_t last = static_cast<uint32_t>(m_dense.size() - 1);
+
+    // Se mueve el ltimo objeto al hueco para que el arreglo siga sin huecos.
+    if (dense != last) {
+      m_dense[dense] = std::move(m_dense[last]);
+      m_denseToSlot[dense] = m_denseToSlot[last];
+      m_slots[m_denseToSlot[dense]].dense = dense;
+    }
+    m_dense.pop_back();
+    m_denseToSlot.pop_back();
+
+    // La generacin 0 se reserva para el handle nulo.
+    if (++slot.generation == 0) {
+      slot.generation = 1;
+    }
+    m_freeSlots.push_back(handle.index);
+    return true;
+  }
+
+  /**
+   * @brief Indica si @p handle apunta a un objeto vivo.
+   */
+  bool
+  contains(Handle handle) const {
+    return handle.isValid() && handle.index < m_slots.size() &&
+           m_slots[handle.index].generation == handle.generation;
+  }
+
+  /**
+   * @brief Objeto de @p handle o nullptr si el handle ya no es vlido.
+   */
+  T*
+  get(Handle handle) {
+    return contains(handle) ? &m_dense[m_slots[handle.index].dense] : nullptr;
+  }
+
+  const T*
+  get(Handle handle) const {
+    return contains(handle) ? &m_dense[m_slots[handle.index].dense] : nullptr;
+  }
+
+  /**
+   * @brief Nmero de objetos vivos.
+   */
+  size_t
+  size() const { return m_dense.size(); }
+
+  /**
+   * @brief Objeto en la posicin densa @p i (0 <= i < size()).
+   */
+  T&
+  at(size_t i) { return m_dense[i]; }
+
+  const T&
+  at(size_t i) const { return m_dense[i]; }
+
+  /**
+   * @brief Handle del objeto en la posicin densa @p i.
+   */
+  Handle
+  handleAt(size_t i) const {
+    uint32_t slotIndex = m_denseToSlot[i];
+    return { slotIndex, m_slots[slotIndex].generation };
+  }
+
+  /**
+   * @brief Borra todos los objetos e invalida todos los handles.
+   */
+  void
+  clear() {
+    while (!m_dense.empty()) {
+      remove(handleAt(m_dense.size() - 1));
+    }
+  }
+
+private:
+  struct
+  Slot {
+    uint32_t dense;      /**< Posicin del objeto en m_dense. */
+    uint32_t generation; /**< Generacin actual de la ranura. */
+  };
+
+  /** @brief Ranuras indexadas por Handle::index. */
+  std::vector<Slot> m_slots;
+
+  /** @brief Ranuras libres para reutilizar. */
+  std::vector<uint32_t> m_freeSlots;
+
+  /** @brief Objetos vivos, sin huecos. */
+  std::deque<T> m_dense;
+
+  /** @brief Ranura de cada objeto denso (para actualizar al mover). */
+  std::vector<uint32_t> m_denseToSlot;
+};
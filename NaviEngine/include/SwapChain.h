@@ -80,9 +80,12 @@ public:
    *
    * Intercambia los buffers (front y back) para mostrar en pantalla
    * el fotograma renderizado ms reciente.
+   *
+   * @param syncInterval 0 = sin esperar al vblank (el ritmo lo marca FramePacer),
+   *        1..4 = sincronizar con el n-simo vblank.
    */
   void
-  present();
+  present(unsigned int syncInterval = 0);
 
 
 
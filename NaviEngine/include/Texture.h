@@ -1,5 +1,6 @@
 #pragma once
 #include "Prerequisites.h"
+#include "PixelFormat.h"
 
 class 
 Device;
@@ -7,6 +8,15 @@ Device;
 class 
 DeviceContext;
 
+struct
+MipChain;
+
+struct
+CompressedChain;
+
+struct
+DdsImage;
+
 /**
  * @class Texture
  * @brief Representa una textura en DirectX 11.
@@ -34,12 +44,14 @@ public:
    * @param device Referencia al dispositivo de DirectX.
    * @param textureName Nombre o ruta del archivo de la textura.
    * @param extensionType Tipo de extensin de la textura (ej. PNG, JPG).
+   * @param usage Uso de la textura; decide el formato de PNG/JPG (R8, R8G8 o RGBA8).
    * @return HRESULT Cdigo de resultado (S_OK si se carg correctamente).
    */
   HRESULT
   init(Device& device,
       const std::string& textureName,
-      ExtensionType extensionType);
+      ExtensionType extensionType,
+      TextureUsage usage = TEXTURE_USAGE_AUTO);
 
   /**
    * @brief Inicializa la textura como un recurso vaco en memoria.
@@ -73,6 +85,101 @@ public:
   HRESULT
   init(Device& device, Texture& textureRef, DXGI_FORMAT format);
 
+  /**
+   * @brief Crea una textura de solo lectura para shaders a partir de pxeles en memoria.
+   *
+   * La usan los cargadores asncronos: la decodificacin ocurre en otro hilo
+   * y aqu solo se crea el recurso de GPU.
+   *
+   * @param device Referencia al dispositivo de DirectX.
+   * @param pixels Pxeles en orden de filas (4 bytes por pxel para RGBA8).
+   * @param width Ancho en pxeles.
+   * @param height Alto en pxeles.
+   * @param format Formato de los pxeles.
+   * @return HRESULT Cdigo de resultado.
+   */
+  HRESULT
+  init(Device& device,
+      const unsigned char* pixels,
+      unsigned int width,
+      unsigned int height,
+      DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM);
+
+  /**
+   * @brief Crea una textura de solo lectura con la cadena de mips completa.
+   *
+   * Cada nivel de la cadena se sube como un subrecurso en la creacin de la
+   * textura, sin GenerateMips ni render targets intermedios.
+   *
+   * @param device Referencia al dispositivo de DirectX.
+   * @param chain Cadena de mips de 1, 2 o 4 canales (nivel 0 = imagen original).
+   * @param format Formato de los pxeles; debe tener chain.channels bytes por texel.
+   * @return HRESULT Cdigo de resultado.
+   */
+  HRESULT
+  init(Device& device,
+      const MipChain& chain,
+      DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM);
+
+  /**
+   * @brief Crea un array de texturas con una cadena de mips por corte.
+   *
+   * Todas las cadenas deben tener el mismo tamao y nmero de niveles (ver
+   * packTextureArrays()); el shader elige la imagen con el ndice de corte.
+   *
+   * @param device Referencia al dispositivo de DirectX.
+   * @param slices Cadena de mips RGBA8 de cada corte.
+   * @param format Formato de los pxeles.
+   * @return HRESULT Cdigo de resultado.
+   */
+  HRESULT
+  init(Device& device,
+      const std::vector<const MipChain*>& slices,
+      DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM);
+
+  /**
+   * @brief Crea una textura comprimida por bloques (BC1/BC3/BC4/BC5/BC7) con todos sus mips.
+   *
+   * @param device Referencia al dispositivo de DirectX.
+   * @param chain Cadena comprimida; el formato DXGI se deduce de ella.
+   * @return HRESULT Cdigo de resultado.
+   */
+  HRESULT
+  init(Device& device, const CompressedChain& chain);
+
+  /**
+   * @brief Crea la textura descrita por un archivo DDS ya interpretado.
+   *
+   * Los D3D11_SUBRESOURCE_DATA apuntan directamente a los pxeles de
+   * @p image (normalmente la proyeccin en memoria del archivo), sin copias
+   * intermedias. Admite texturas 2D, arrays y cubemaps.
+   *
+   * Con @p mostDetailedMip > 0 se crea solo la parte [mostDetailedMip, mipLevels)
+   * de la cadena; es lo que usa el streaming de mips para subir o bajar de nivel.
+   *
+   * @param device Referencia al dispositivo de DirectX.
+   * @param image Resultado de parseDds().
+   * @param mostDetailedMip Primer mip del archivo que se sube.
+   * @return HRESULT Cdigo de resultado.
+   */
+  HRESULT
+  init(Device& device, const DdsImage& image, unsigned int mostDetailedMip = 0);
+
+  /**
+   * @brief Crea la textura a partir del contenido completo de un archivo ya ledo.
+   *
+   * @param device Referencia al dispositivo de DirectX.
+   * @param fileData Bytes del archivo (DDS, PNG o JPG).
+   * @param extensionType Formato del archivo.
+   * @param usage Uso de la textura; decide el formato de PNG/JPG (R8, R8G8 o RGBA8).
+   * @return HRESULT Cdigo de resultado.
+   */
+  HRESULT
+  init(Device& device,
+      const std::vector<unsigned char>& fileData,
+      ExtensionType extensionType,
+      TextureUsage usage = TEXTURE_USAGE_AUTO);
+
   /**
    * @brief Actualiza el estado de la textura.
    *
@@ -0,0 +1,237 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file TextureAtlas.h
+ * @brief Agrupacin de texturas pequeas en atlas y en arrays de texturas.
+ *
+ * Cada Texture enlaza su propio SRV; agrupar las texturas de un mismo formato
+ * permite dibujar muchos materiales con un solo PSSetShaderResources.
+ *
+ * - packAtlas() coloca las imgenes en pginas con un empaquetador skyline
+ *   (bottom-left, mejor ajuste). Cada imagen lleva un borde de @c padding texels
+ *   que composeAtlasPage() rellena repitiendo los texels del contorno, y las
+ *   posiciones se alinean a 2^(mipLevels-1) texels: as, en los primeros
+ *   mipLevels niveles de la pgina ningn texel mezcla dos imgenes. Las mallas
+ *   se adaptan con AtlasRect::remap() / remapUVs(); solo sirve para UVs dentro de
+ *   [0, 1] (las texturas que se repiten deben ir a un array).
+ * - packTextureArrays() reparte texturas del mismo tamao, formato y nmero de
+ *   mips en arrays y devuelve el ndice de corte que cada material pasa al shader.
+ *
+ * El empaquetado trabaja en celdas de la alineacin de mips, as que miles de
+ * imgenes se colocan en milisegundos y puede hacerse al cargar. No depende de
+ * Windows ni de DirectX.
+ */
+
+/**
+ * @struct AtlasSettings
+ * @brief Parmetros del atlas.
+ */
+struct
+AtlasSettings {
+  unsigned int maxSize = 4096; /**< Lado mximo de una pgina en texels. */
+  unsigned int padding = 4;    /**< Borde alrededor de cada imagen en el mip 0. */
+  unsigned int mipLevels = 4;  /**< Niveles de la pgina sin mezcla entre imgenes vecinas. */
+};
+
+/**
+ * @struct AtlasInput
+ * @brief Tamao de una imagen a empaquetar.
+ */
+struct
+AtlasInput {
+  unsigned int width = 0;
+  unsigned int height = 0;
+};
+
+/**
+ * @struct AtlasRect
+ * @brief Posicin de una imagen dentro del atlas.
+ */
+struct
+AtlasRect {
+  int page = -1;           /**< Pgina, o -1 si la imagen no cabe en ninguna. */
+  unsigned int x = 0;      /**< Esquina del rea til (sin borde) en texels. */
+  unsigned int y = 0;
+  unsigned int width = 0;
+  unsigned int height = 0;
+  float scaleU = 1.0f;     /**< UV de pgina = offset + UV original * scale. */
+  float scaleV = 1.0f;
+  float offsetU = 0.0f;
+  float offsetV = 0.0f;
+
+  /**
+   * @brief Convierte un UV de la imagen original en UV de la pgina.
+   */
+  void
+  remap(float& u, float& v) const {
+    u = offsetU + u * scaleU;
+    v = offsetV + v * scaleV;
+  }
+};
+
+/**
+ * @struct AtlasPage
+ * @brief Pgina del atlas y las imgenes que contiene.
+ */
+struct
+AtlasPage {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  std::vector<uint32_t> items; /**< ndices en el vector de entradas. */
+};
+
+/**
+ * @struct AtlasLayout
+ * @brief Resultado de packAtlas().
+ */
+struct
+AtlasLayout {
+  std::vector<AtlasPage> pages;
+  std::vector<AtlasRect> rects; /**< Uno por entrada, en el mismo orden. */
+  unsigned int padding = 0;
+  unsigned int alignment = 1;   /**< Alineacin de las posiciones (2^(mipLevels-1)). */
+
+  /**
+   * @brief Fraccin de texels de las pginas ocupada por imgenes (sin bordes).
+   */
+  double
+  occupancy() const;
+};
+
+/**
+ * @class SkylinePacker
+ * @brief Empaquetador de rectngulos por lnea de horizonte.
+ *
+ * Guarda el contorno superior de lo ya colocado como una lista de segmentos y
+ * pone cada rectngulo donde su borde superior queda ms bajo.
+ */
+class
+SkylinePacker {
+public:
+  /**
+   * @brief Vaca el empaquetador para un rea de @p width x @p height.
+   */
+  void
+  init(unsigned int width, unsigned int height);
+
+  /**
+   * @brief Coloca un rectngulo.
+   * @return false si no cabe.
+   */
+  bool
+  insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y);
+
+  /**
+   * @brief Ancho ocupado (mximo x + ancho de lo colocado).
+   */
+  unsigned int
+  usedWidth() const { return m_usedWidth; }
+
+  /**
+   * @brief Alto ocupado (mximo y + alto de lo colocado).
+   */
+  unsigned int
+  usedHeight() const { return m_usedHeight; }
+
+private:
+  /**
+   * @struct Node
+   * @brief Segmento horizontal del contorno.
+   */
+  struct
+  Node {
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+  };
+
+  bool
+  fit(size_t index, unsigned int width, unsigned int height, unsigned int& y) const;
+
+private:
+  std::vector<Node> m_nodes;
+  unsigned int m_width = 0;
+  unsigned int m_height = 0;
+  unsigned int m_usedWidth = 0;
+  unsigned int m_usedHeight = 0;
+};
+
+/**
+ * @brief Empaqueta las imgenes en pginas de como mucho maxSize x maxSize.
+ *
+ * Las pginas se recortan al rea usada (mltiplo de la alineacin).
+ * @return true si todas las imgenes cupieron (las que no, quedan con page = -1).
+ */
+bool
+packAtlas(const std::vector<AtlasInput>& inputs, const AtlasSettings& settings, AtlasLayout& layout);
+
+/**
+ * @brief Compone los pxeles RGBA8 de una pgina.
+ * @param pixels Pxeles RGBA8 de cada entrada, en el orden de packAtlas().
+ * @param page Pgina a componer.
+ * @param rgba Destino (width * height * 4 bytes de la pgina).
+ */
+bool
+composeAtlasPage(const AtlasLayout& layout,
+                 const std::vector<const uint8_t*>& pixels,
+                 unsigned int page,
+                 std::vector<uint8_t>& rgba);
+
+/**
+ * @brief Aplica AtlasRect::remap() al miembro Tex de cada vrtice (p. ej. SimpleVertex).
+ */
+template<typename Vertex>
+void
+remapUVs(std::vector<Vertex>& vertices, const AtlasRect& rect) {
+  for (Vertex& vertex : vertices) {
+    rect.remap(vertex.Tex.x, vertex.Tex.y);
+  }
+}
+
+/**
+ * @struct ArrayInput
+ * @brief Descripcin de una textura candidata a array.
+ */
+struct
+ArrayInput {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  uint32_t format = 0;         /**< DXGI_FORMAT. */
+  unsigned int mipLevels = 1;
+};
+
+/**
+ * @struct ArraySlot
+ * @brief Array y corte asignados a una textura.
+ */
+struct
+ArraySlot {
+  uint32_t group = 0;
+  uint32_t slice = 0;
+};
+
+/**
+ * @struct ArrayGroup
+ * @brief Array de texturas compatibles.
+ */
+struct
+ArrayGroup {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  uint32_t format = 0;
+  unsigned int mipLevels = 1;
+  std::vector<uint32_t> items; /**< ndices de entrada; la posicin es el corte. */
+};
+
+/**
+ * @brief Agrupa las texturas compatibles en arrays de como mucho @p maxSlices cortes.
+ * @param slots Array y corte de cada entrada, en el mismo orden.
+ */
+void
+packTextureArrays(const std::vector<ArrayInput>& inputs,
+                  std::vector<ArrayGroup>& groups,
+                  std::vector<ArraySlot>& slots,
+                  unsigned int maxSlices = 2048);
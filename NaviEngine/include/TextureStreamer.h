@@ -0,0 +1,226 @@
+#pragma once
+#include "SlotMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file TextureStreamer.h
+ * @brief Residencia de mips de texturas bajo un presupuesto global de memoria.
+ *
+ * Cada textura registrada tiene siempre en memoria su cola de mips pequeos
+ * (tailMip y siguientes) y el streamer decide cuntos niveles superiores deben
+ * sumarse. La decisin parte de la densidad de texels en pantalla que el
+ * render reporta cada frame con request(): el mip deseado es el primero cuyo
+ * tamao no supera los pxeles que ocupa el objeto.
+ *
+ * Si la suma de los mips deseados no cabe en el presupuesto se renuncia a
+ * niveles de las texturas menos importantes primero: la importancia es el
+ * tamao en pantalla, y cada nivel descartado la duplica, de modo que el recorte
+ * se reparte en lugar de dejar borrosa una sola textura. Los niveles sobrantes
+ * se expulsan en el acto y los que faltan se piden de uno en uno (del ms pequeo
+ * al ms grande), por prioridad y con un lmite de cargas simultneas.
+ *
+ * El streamer solo lleva la contabilidad: no toca la GPU ni el disco, emite
+ * StreamActions que el dueo ejecuta y confirma con onLoaded(). No depende de
+ * Windows ni de DirectX y no es seguro entre hilos.
+ */
+
+struct
+StreamTag;
+
+/**
+ * @brief Handle de una textura registrada en el TextureStreamer.
+ */
+using StreamHandle = SlotHandle<StreamTag>;
+
+/**
+ * @struct StreamTextureDesc
+ * @brief Descripcin de una textura para el streamer.
+ */
+struct
+StreamTextureDesc {
+  unsigned int width = 0;          /**< Ancho del mip 0. */
+  unsigned int height = 0;         /**< Alto del mip 0. */
+  std::vector<size_t> levelBytes;  /**< Bytes de cada mip (uno por nivel). */
+  unsigned int tailMip = 0;        /**< Primer mip que siempre est residente. */
+};
+
+/**
+ * @brief Tipo de accin que el dueo debe ejecutar.
+ */
+enum
+StreamActionType {
+  STREAM_LOAD = 0, /**< Cargar el mip @c mip; confirmar con onLoaded(). */
+  STREAM_EVICT = 1 /**< Recrear la textura con @c mip como nivel ms detallado. */
+};
+
+/**
+ * @struct StreamAction
+ * @brief Accin pendiente sobre una textura.
+ */
+struct
+StreamAction {
+  StreamHandle handle;
+  StreamActionType type = STREAM_LOAD;
+  unsigned int mip = 0;
+};
+
+/**
+ * @struct StreamStats
+ * @brief Contadores del streamer.
+ */
+struct
+StreamStats {
+  size_t residentBytes = 0; /**< Bytes de los mips residentes. */
+  size_t pendingBytes = 0;  /**< Bytes de las cargas en curso. */
+  size_t wantedBytes = 0;   /**< Bytes que haran falta para los mips deseados. */
+  uint32_t loadsInFlight = 0;
+  uint64_t loadsIssued = 0;
+  uint64_t evictions = 0;
+};
+
+/**
+ * @class TextureStreamer
+ * @brief Decide qu mips de cada textura deben estar residentes.
+ */
+class
+TextureStreamer {
+public:
+  /**
+   * @brief Constructor por defecto (sin presupuesto: no carga ningn mip superior).
+   */
+  TextureStreamer() = default;
+
+  /**
+   * @brief Destructor por defecto.
+   */
+  ~TextureStreamer() = default;
+
+  /**
+   * @brief Configura el streamer.
+   * @param budgetBytes Presupuesto total, incluidas las colas de mips.
+   * @param maxLoadsInFlight Cargas simultneas mximas.
+   * @param keepFrames Frames que una textura conserva sus mips sin recibir request().
+   */
+  void
+  init(size_t budgetBytes, unsigned int maxLoadsInFlight = 4, unsigned int keepFrames = 30);
+
+  /**
+   * @brief Cambia el presupuesto; el exceso se expulsa en el siguiente update().
+   */
+  void
+  setBudget(size_t budgetBytes) { m_budget = budgetBytes; }
+
+  /**
+   * @brief Primer mip que se mantiene siempre residente: el primero que no supera
+   *        @p tailSize en ninguno de sus lados.
+   */
+  static unsigned int
+  tailMipFor(unsigned int width, unsigned int height, unsigned int mipLevels, unsigned int tailSize = 64);
+
+  /**
+   * @brief Mip que aporta como mucho un texel por pxel.
+   * @param textureSize Lado mayor del mip 0 en texels.
+   * @param screenPixels Pxeles que ocupa en pantalla el objeto (lado mayor).
+   * @param uvSpan Veces que la textura se repite a lo largo de ese lado.
+   */
+  static float
+  requiredMip(unsigned int textureSize, float screenPixels, float uvSpan = 1.0f);
+
+  /**
+   * @brief Registra una textura cuya cola (tailMip..) ya est residente.
+   */
+  StreamHandle
+  add(const StreamTextureDesc& desc);
+
+  /**
+   * @brief Elimina una textura; sus cargas en curso se descartan.
+   */
+  void
+  remove(StreamHandle handle);
+
+  /**
+   * @brief Informa de que la textura se dibuja este frame a @p screenPixels pxeles.
+   *
+   * Varias llamadas en el mismo frame se combinan (el mip ms detallado y la
+   * mayor importancia).
+   */
+  void
+  request(StreamHandle handle, float screenPixels, float uvSpan = 1.0f);
+
+  /**
+   * @brief Recalcula la residencia y aade a @p actions lo que debe hacerse.
+   *
+   * Las expulsiones se dan por hechas al devolverlas; las cargas, cuando llega onLoaded().
+   */
+  void
+  update(std::vector<StreamAction>& actions);
+
+  /**
+   * @brief Confirma una carga emitida por update().
+   * @param success false si la lectura fall (el mip se volver a pedir).
+   */
+  void
+  onLoaded(StreamHandle handle, unsigned int mip, bool success = true);
+
+  /**
+   * @brief Mip ms detallado residente (0 si el handle no es vlido).
+   */
+  unsigned int
+  residentMip(StreamHandle handle) const;
+
+  /**
+   * @brief Mip que el streamer quiere residente tras aplicar el presupuesto (0 si no es vlido).
+   */
+  unsigned int
+  targetMip(StreamHandle handle) const;
+
+  /**
+   * @brief Nmero de texturas registradas.
+   */
+  size_t
+  size() const { return m_entries.size(); }
+
+  const StreamStats&
+  stats() const { return m_stats; }
+
+  size_t
+  budget() const { return m_budget; }
+
+private:
+  /**
+   * @struct Entry
+   * @brief Estado de residencia de una textura.
+   */
+  struct
+  Entry {
+    std::vector<size_t> levelBytes;
+    unsigned int size = 0;         /**< Lado mayor del mip 0. */
+    unsigned int tailMip = 0;
+    unsigned int residentMip = 0;
+    unsigned int wantedMip = 0;
+    unsigned int targetMip = 0;
+    unsigned int loadingMip = 0;
+    bool loading = false;
+    float importance = 0.0f;
+    float frameMip = 0.0f;         /**< Mnimo de los request() del frame. */
+    float frameImportance = 0.0f;  /**< Mximo de los request() del frame. */
+    bool requested = false;
+    uint64_t lastRequest = 0;
+  };
+
+  /**
+   * @brief Bytes de los mips desde @p mip hasta el final de la cadena.
+   */
+  static size_t
+  bytesFrom(const Entry& entry, unsigned int mip);
+
+private:
+  SlotMap<Entry, StreamTag> m_entries;
+  size_t m_budget = 0;
+  unsigned int m_maxLoadsInFlight = 4;
+  unsigned int m_keepFrames = 30;
+  uint64_t m_frame = 0;
+  StreamStats m_stats;
+};
@@ -0,0 +1,218 @@
+#include "Allocators.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+  /**
+   * @struct BlockHeader
+   * @brief Cabecera que precede a cada bloque de TaggedHeap.
+   */
+  struct
+  BlockHeader {
+    uint64_t size;   // Bytes pedidos.
+    uint32_t offset; // Distancia desde el inicio de la reserva real.
+    uint32_t tag;
+  };
+  static_assert(sizeof(BlockHeader) == 16, "La cabecera debe conservar la alineacin de 16 bytes");
+
+  const char* const kTagNames[MEMORY_TAG_COUNT] = {
+    "general", "loader", "frame"
+  };
+
+  // Tamao mnimo de los bloques extra de LinearAllocator.
+  const size_t kMinOverflowBlock = 4096;
+}
+
+const char*
+memoryTagName(MemoryTag tag) {
+  return tag >= 0 && tag < MEMORY_TAG_COUNT ? kTagNames[tag] : "unknown";
+}
+
+TaggedHeap&
+TaggedHeap::instance() {
+  static TaggedHeap heap;
+  return heap;
+}
+
+void*
+TaggedHeap::allocate(size_t size, MemoryTag tag, size_t alignment) {
+  if (tag < 0 || tag >= MEMORY_TAG_COUNT) {
+    tag = MEMORY_GENERAL;
+  }
+  alignment = std::max<size_t>(alignment, 16);
+  if ((alignment & (alignment - 1)) != 0 || size > SIZE_MAX - alignment - sizeof(BlockHeader)) {
+    return nullptr;
+  }
+
+  // Con alineacin 16 malloc ya deja la cabecera alineada; para ms se reserva el margen.
+  size_t padding = alignment > 16 ? alignment : 0;
+  uint8_t* raw = static_cast<uint8_t*>(std::malloc(size + sizeof(BlockHeader) + padding));
+  if (!raw) {
+    return nullptr;
+  }
+  uintptr_t start = reinterpret_cast<uintptr_t>(raw) + sizeof(BlockHeader);
+  uintptr_t aligned = (start + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+  BlockHeader* header = reinterpret_cast<BlockHeader*>(aligned) - 1;
+  header->size = size;
+  header->offset = static_cast<uint32_t>(aligned - reinterpret_cast<uintptr_t>(raw));
+  header->tag = static_cast<uint32_t>(tag);
+
+  Counters& counters = m_counters[tag];
+  uint64_t current = counters.current.fetch_add(size, std::memory_order_relaxed) + size;
+  uint64_t peak = counters.peak.load(std::memory_order_relaxed);
+  while (current > peak && !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+  }
+  counters.live.fetch_add(1, std::memory_order_relaxed);
+  counters.total.fetch_add(1, std::memory_order_relaxed);
+  return reinterpret_cast<void*>(aligned);
+}
+
+void
+TaggedHeap::deallocate(void* pointer) {
+  if (!pointer) {
+    return;
+  }
+  BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+  Counters& counters = m_counters[header->tag];
+  counters.current.fetch_sub(header->size, std::memory_order_relaxed);
+  counters.live.fetch_sub(1, std::memory_order_relaxed);
+  std::free(static_cast<uint8_t*>(pointer) - header->offset);
+}
+
+MemoryStats
+TaggedHeap::stats(MemoryTag tag) const {
+  MemoryStats result;
+  if (tag < 0 || tag >= MEMORY_TAG_COUNT) {
+    return result;
+  }
+  const Counters& counters = m_counters[tag];
+  result.currentBytes = counters.current.load(std::memory_order_relaxed);
+  result.peakBytes = counters.peak.load(std::memory_order_relaxed);
+  result.liveAllocations = counters.live.load(std::memory_order_relaxed);
+  result.totalAllocations = counters.total.load(std::memory_order_relaxed);
+  return result;
+}
+
+MemoryStats
+TaggedHeap::totals() const {
+  // El pico total es la suma de picos: una cota superior, no un pico simultneo.
+  MemoryStats result;
+  for (int tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+    MemoryStats part = stats(static_cast<MemoryTag>(tag));
+    result.currentBytes += part.currentBytes;
+    result.peakBytes += part.peakBytes;
+    result.liveAllocations += part.liveAllocations;
+    result.totalAllocations += part.totalAllocations;
+  }
+  return result;
+}
+
+LinearAllocator::LinearAllocator(size_t capacity, MemoryTag tag)
+  : m_tag(tag) {
+  m_capacity = std::max<size_t>(capacity, 256);
+  m_block = static_cast<uint8_t*>(TaggedHeap::instance().allocate(m_capacity, m_tag, 64));
+  if (!m_block) {
+    m_capacity = 0;
+  }
+  m_begin = reinterpret_cast<uintptr_t>(m_block);
+  m_cursor = m_begin;
+  m_end = m_begin + m_capacity;
+}
+
+LinearAllocator::~LinearAllocator() {
+  releaseOverflow();
+  TaggedHeap::instance().deallocate(m_block);
+}
+
+void*
+LinearAllocator::allocateSlow(size_t size, size_t alignment) {
+  if ((alignment & (alignment - 1)) != 0) {
+    return nullptr;
+  }
+  // El bloque extra guarda el puntero al anterior en sus primeros 16 bytes.
+  size_t blockSize = std::max(std::max(m_capacity / 2, kMinOverflowBlock), size + 16 + alignment);
+  uint8_t* block = static_cast<uint8_t*>(TaggedHeap::instance().allocate(blockSize, m_tag, 64));
+  if (!block) {
+    return nullptr;
+  }
+  *reinterpret_cast<void**>(block) = m_overflow;
+  m_overflow = block;
+  ++m_overflowCount;
+
+  m_usedBefore += m_cursor - m_begin;
+  m_begin = reinterpret_cast<uintptr_t>(block) + 16;
+  m_cursor = m_begin;
+  m_end = reinterpret_cast<uintptr_t>(block) + blockSize;
+  m_highWater = std::max(m_highWater, used());
+  return allocate(size, alignment);
+}
+
+void
+LinearAllocator::releaseOverflow() {
+  while (m_overflow) {
+    void* previous = *static_cast<void**>(m_overflow);
+    TaggedHeap::instance().deallocate(m_overflow);
+    m_overflow = previous;
+  }
+}
+
+void
+LinearAllocator::reset() {
+  size_t consumed = used();
+  m_highWater = std::max(m_highWater, consumed);
+
+  // Si el ciclo desbord, el bloque principal se recrea con el tamao consumido
+  // (ms un margen) para que el siguiente ciclo quepa en una sola regin.
+  if (m_overflow) {
+    releaseOverflow();
+    size_t grown = consumed + consumed / 4;
+    uint8_t* block = static_cast<uint8_t*>(TaggedHeap::instance().allocate(grown, m_tag, 64));
+    if (block) {
+      TaggedHeap::instance().deallocate(m_block);
+      m_block = block;
+      m_capacity = grown;
+    }
+  }
+  m_usedBefore = 0;
+  m_begin = reinterpret_cast<uintptr_t>(m_block);
+  m_cursor = m_begin;
+  m_end = m_begin + m_capacity;
+}
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t blocksPerChunk, MemoryTag tag)
+  : m_blockSize((std::max(blockSize, sizeof(FreeBlock)) + 15) & ~static_cast<size_t>(15)),
+    m_blocksPerChunk(std::max<size_t>(blocksPerChunk, 1)),
+    m_tag(tag) {
+}
+
+PoolAllocator::~PoolAllocator() {
+  for (void* chunk : m_chunks) {
+    TaggedHeap::instance().deallocate(chunk);
+  }
+}
+
+bool
+PoolAllocator::grow() {
+  uint8_t* chunk = static_cast<uint8_t*>(TaggedHeap::instance().allocate(m_blockSize * m_blocksPerChunk, m_tag, 64));
+  if (!chunk) {
+    return false;
+  }
+  m_chunks.push_back(chunk);
+
+  // Se encadena en orden de direccin para que las primeras entregas sean contiguas.
+  for (size_t i = m_blocksPerChunk; i-- > 0;) {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * m_blockSize);
+    block->next = m_free;
+    m_free = block;
+  }
+  return true;
+}
+
+namespace
+EngineMemory {
+  LinearAllocator&
+  frame() {
+    static LinearAllocator allocator(1024 * 1024, MEMORY_FRAME);
+    return allocator;
+  }
+}
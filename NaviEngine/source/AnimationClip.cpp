@@ -0,0 +1,594 @@
+#include "AnimationClip.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+using namespace SimdMath;
+
+namespace {
+
+  const char kMagic[4] = { 'N', 'C', 'L', 'P' };
+
+  /** @brief Componentes de los rangos por tipo de pista (la traslacin y la escala dejan uno sin usar). */
+  const unsigned int kRangeComponents = 4;
+
+  /** @brief Tramo ms largo que prueba el ajuste; acota el coste cuadrtico en clips largos. */
+  const size_t kMaxSegmentFrames = 512;
+
+  unsigned int
+  componentCount(unsigned int kind) {
+    return kind == CLIP_TRACK_ROTATION ? 4 : 3;
+  }
+
+  /** @brief Componentes de una pose: rotacin, traslacin y escala. */
+  const unsigned int kPoseComponents = 10;
+
+  /**
+   * @brief Primer componente de la pose (ndice en ClipCursor::values) de las pistas de tipo @p kind.
+   */
+  unsigned int
+  firstPoseComponent(unsigned int kind) {
+    return kind == CLIP_TRACK_ROTATION ? 0 : kind == CLIP_TRACK_TRANSLATION ? 4 : 7;
+  }
+
+  /** @brief Origen de AnimationClip::m_id. */
+  std::atomic<uint64_t> g_nextClipId{ 1 };
+
+  /**
+   * @brief Una pista sin comprimir, cuantizada, y la reconstruccin que har sample().
+   */
+  struct
+  TrackFit {
+    unsigned int components = 0;
+    size_t frames = 0;
+    std::vector<float> samples;     /**< Valores originales, samples[frame * components + c]. */
+    std::vector<uint16_t> quantized;
+    float minimum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float scale[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    bool rotation = false;
+
+    float
+    value(size_t frame, unsigned int c) const {
+      return quantized[frame * components + c] * scale[c] + minimum[c];
+    }
+
+    /**
+     * @brief Error mximo en el frame @p frame interpolando entre las claves @p from y @p to.
+     */
+    float
+    error(size_t from, size_t to, size_t frame) const {
+      float alpha = to > from ? (static_cast<float>(frame) - from) / static_cast<float>(to - from) : 0.0f;
+      float result[4];
+      float lengthSq = 0.0f;
+      for (unsigned int c = 0; c < components; ++c) {
+        float a = value(from, c);
+        result[c] = (value(to, c) - a) * alpha + a;
+        lengthSq += result[c] * result[c];
+      }
+      if (rotation) {
+        float inverseLength = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+        for (unsigned int c = 0; c < components; ++c) {
+          result[c] *= inverseLength;
+        }
+      }
+      float worst = 0.0f;
+      for (unsigned int c = 0; c < components; ++c) {
+        worst = (std::max)(worst, std::fabs(result[c] - samples[frame * components + c]));
+      }
+      return worst;
+    }
+
+    /**
+     * @brief Error mximo de todos los frames del tramo [from, to].
+     */
+    float
+    segmentError(size_t from, size_t to) const {
+      float worst = 0.0f;
+      for (size_t frame = from; frame <= to; ++frame) {
+        worst = (std::max)(worst, error(from, to, frame));
+      }
+      return worst;
+    }
+
+    void
+    quantize() {
+      quantized.resize(samples.size());
+      for (unsigned int c = 0; c < components; ++c) {
+        float low = samples[c];
+        float high = samples[c];
+        for (size_t frame = 1; frame < frames; ++frame) {
+          low = (std::min)(low, samples[frame * components + c]);
+          high = (std::max)(high, samples[frame * components + c]);
+        }
+        minimum[c] = low;
+        scale[c] = (high - low) / 65535.0f;
+        for (size_t frame = 0; frame < frames; ++frame) {
+          float normalized = scale[c] > 0.0f ? (samples[frame * components + c] - low) / (high - low) : 0.0f;
+          quantized[frame * components + c] =
+            static_cast<uint16_t>(std::lround((std::min)(1.0f, (std::max)(0.0f, normalized)) * 65535.0f));
+        }
+      }
+    }
+
+    /**
+     * @brief Ajuste lineal a trozos: cada tramo se alarga mientras todos sus
+     *        frames queden dentro de la tolerancia.
+     * @return Frames de las claves conservadas.
+     */
+    std::vector<size_t>
+    fit(float tolerance, float& maxError) const {
+      std::vector<size_t> keys(1, 0);
+      maxError = error(0, 0, 0);
+      if (frames == 1) {
+        return keys;
+      }
+      float constantError = 0.0f;
+      for (size_t frame = 1; frame < frames; ++frame) {
+        constantError = (std::max)(constantError, error(0, 0, frame));
+      }
+      if (constantError <= tolerance) {
+        maxError = (std::max)(maxError, constantError);
+        return keys;
+      }
+      size_t from = 0;
+      while (from + 1 < frames) {
+        size_t to = from + 1;
+        float toError = segmentError(from, to);
+        while (to + 1 < frames && to + 1 - from <= kMaxSegmentFrames) {
+          float extended = segmentError(from, to + 1);
+          if (extended > tolerance) {
+            break;
+          }
+          ++to;
+          toError = extended;
+        }
+        maxError = (std::max)(maxError, toError);
+        keys.push_back(to);
+        from = to;
+      }
+      return keys;
+    }
+  };
+
+  template<typename T>
+  void
+  appendBytes(std::vector<uint8_t>& output, const T* data, size_t count) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    output.insert(output.end(), bytes, bytes + count * sizeof(T));
+  }
+
+  /**
+   * @brief Normaliza cuatro cuaterniones en SoA.
+   */
+  inline void
+  normalizeRotations(float* x, float* y, float* z, float* w) {
+    Vector qx = load(x), qy = load(y), qz = load(z), qw = load(w);
+    Vector lengthSq = multiplyAdd(qx, qx, multiplyAdd(qy, qy, multiplyAdd(qz, qz, multiply(qw, qw))));
+    Vector inverseLength = divide(splat(1.0f), sqrt(lengthSq));
+    store(x, multiply(qx, inverseLength));
+    store(y, multiply(qy, inverseLength));
+    store(z, multiply(qz, inverseLength));
+    store(w, multiply(qw, inverseLength));
+  }
+
+}
+
+// ---------------------------------------------------------------------------
+// SoaPose
+// ---------------------------------------------------------------------------
+
+void
+SoaPose::resize(size_t joints) {
+  jointCount = joints;
+  size_t padded = (joints + 3) / 4 * 4;
+  for (std::vector<float>& component : rotation) {
+    component.resize(padded);
+  }
+  for (std::vector<float>& component : translation) {
+    component.resize(padded);
+  }
+  for (std::vector<float>& component : scale) {
+    component.resize(padded);
+  }
+}
+
+void
+SoaPose::toJointPoses(JointPose* output) const {
+  for (size_t joint = 0; joint < jointCount; ++joint) {
+    JointPose& pose = output[joint];
+    pose.rotation = { rotation[0][joint], rotation[1][joint], rotation[2][joint], rotation[3][joint] };
+    pose.translation = { translation[0][joint], translation[1][joint], translation[2][joint] };
+    pose.scale = { scale[0][joint], scale[1][joint], scale[2][joint] };
+  }
+}
+
+// ---------------------------------------------------------------------------
+// AnimationClip
+// ---------------------------------------------------------------------------
+
+bool
+AnimationClip::compress(const RawAnimationClip& raw,
+                        const ClipCompressionSettings& settings,
+                        ClipCompressionStats* stats,
+                        std::string* error) {
+  const char* problem = nullptr;
+  if (raw.jointCount == 0 || raw.frameCount == 0 || raw.poses.size() != raw.jointCount * raw.frameCount) {
+    problem = "an animation clip needs at least one joint and frame, with one pose per joint and frame";
+  }
+  else if (raw.frameCount > 65536) {
+    problem = "an animation clip can have at most 65536 frames";
+  }
+  else if (!(raw.sampleRate > 0.0f)) {
+    problem = "the sample rate of an animation clip must be positive";
+  }
+  if (problem) {
+    if (error) {
+      *error = problem;
+    }
+    return false;
+  }
+
+  m_id = g_nextClipId.fetch_add(1);
+  m_jointCount = raw.jointCount;
+  m_frameCount = raw.frameCount;
+  m_sampleRate = raw.sampleRate;
+  m_tracks.resize(CLIP_TRACK_KIND_COUNT * m_jointCount);
+  size_t padded = paddedJoints();
+  m_rangeMinimum.assign(CLIP_TRACK_KIND_COUNT * kRangeComponents * padded, 0.0f);
+  m_rangeScale.assign(m_rangeMinimum.size(), 0.0f);
+  m_keyFrames.clear();
+  m_values.clear();
+  // Las articulaciones de relleno muestrean la identidad.
+  for (size_t joint = m_jointCount; joint < padded; ++joint) {
+    m_rangeMinimum[(CLIP_TRACK_ROTATION * kRangeComponents + 3) * padded + joint] = 1.0f;
+    for (unsigned int c = 0; c < 3; ++c) {
+      m_rangeMinimum[(CLIP_TRACK_SCALE * kRangeComponents + c) * padded + joint] = 1.0f;
+    }
+  }
+
+  const float tolerances[CLIP_TRACK_KIND_COUNT] = {
+    settings.rotationTolerance, settings.translationTolerance, settings.scaleTolerance
+  };
+  float maxError[CLIP_TRACK_KIND_COUNT] = { 0.0f, 0.0f, 0.0f };
+  TrackFit track;
+  track.frames = m_frameCount;
+  for (unsigned int kind = 0; kind < CLIP_TRACK_KIND_COUNT; ++kind) {
+    track.components = componentCount(kind);
+    track.rotation = kind == CLIP_TRACK_ROTATION;
+    track.samples.resize(m_frameCount * track.components);
+    for (size_t joint = 0; joint < m_jointCount; ++joint) {
+      for (size_t frame = 0; frame < m_frameCount; ++frame) {
+        const JointPose& pose = raw.poses[frame * m_jointCount + joint];
+        float* sample = &track.samples[frame * track.components];
+        if (kind == CLIP_TRACK_ROTATION) {
+          float q[4] = { pose.rotation.x, pose.rotation.y, pose.rotation.z, pose.rotation.w };
+          float lengthSq = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+          float inverseLength = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+          // q y -q son la misma rotacin: se elige el signo ms cercano al frame
+          // anterior para que la pista sea continua y se pueda interpolar.
+          if (frame > 0) {
+            const float* previous = sample - 4;
+            float dot = q[0] * previous[0] + q[1] * previous[1] + q[2] * previous[2] + q[3] * previous[3];
+            inverseLength = std::copysign(inverseLength, dot);
+          }
+          for (unsigned int c = 0; c < 4; ++c) {
+            sample[c] = q[c] * inverseLength;
+          }
+        }
+        else {
+          const SimdMath::Float3& value = kind == CLIP_TRACK_TRANSLATION ? pose.translation : pose.scale;
+          sample[0] = value.x;
+          sample[1] = value.y;
+          sample[2] = value.z;
+        }
+      }
+
+      track.quantize();
+      float trackError = 0.0f;
+      std::vector<size_t> keys = track.fit(tolerances[kind], trackError);
+      maxError[kind] = (std::max)(maxError[kind], trackError);
+
+      ClipTrack& stored = m_tracks[kind * m_jointCount + joint];
+      stored.firstKey = static_cast<uint32_t>(m_keyFrames.size());
+      stored.firstValue = static_cast<uint32_t>(m_values.size());
+      stored.keyCount = static_cast<uint32_t>(keys.size());
+      for (size_t frame : keys) {
+        m_keyFrames.push_back(static_cast<uint16_t>(frame));
+        for (unsigned int c = 0; c < track.components; ++c) {
+          m_values.push_back(track.quantized[frame * track.components + c]);
+        }
+      }
+      for (unsigned int c = 0; c < track.components; ++c) {
+        m_rangeMinimum[(kind * kRangeComponents + c) * padded + joint] = track.minimum[c];
+        m_rangeScale[(kind * kRangeComponents + c) * padded + joint] = track.scale[c];
+      }
+    }
+  }
+
+  if (stats) {
+    stats->rawBytes = m_frameCount * m_jointCount * sizeof(JointPose);
+    stats->compressedBytes = sizeInBytes();
+    stats->rawKeys = m_frameCount * m_tracks.size();
+    stats->keys = m_keyFrames.size();
+    for (unsigned int kind = 0; kind < CLIP_TRACK_KIND_COUNT; ++kind) {
+      stats->maxError[kind] = maxError[kind];
+    }
+  }
+  return true;
+}
+
+size_t
+AnimationClip::sizeInBytes() const {
+  return sizeof(ClipHeader) + m_tracks.size() * sizeof(ClipTrack) +
+         (m_rangeMinimum.size() + m_rangeScale.size()) * sizeof(float) +
+         (m_keyFrames.size() + m_values.size()) * sizeof(uint16_t);
+}
+
+void
+AnimationClip::serialize(std::vector<uint8_t>& output) const {
+  ClipHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kClipVersion;
+  header.jointCount = static_cast<uint32_t>(m_jointCount);
+  header.frameCount = static_cast<uint32_t>(m_frameCount);
+  header.sampleRate = m_sampleRate;
+  header.keyCount = static_cast<uint32_t>(m_keyFrames.size());
+  header.valueCount = static_cast<uint32_t>(m_values.size());
+
+  output.clear();
+  output.reserve(sizeInBytes());
+  appendBytes(output, &header, 1);
+  appendBytes(output, m_tracks.data(), m_tracks.size());
+  appendBytes(output, m_rangeMinimum.data(), m_rangeMinimum.size());
+  appendBytes(output, m_rangeScale.data(), m_rangeScale.size());
+  appendBytes(output, m_keyFrames.data(), m_keyFrames.size());
+  appendBytes(output, m_values.data(), m_values.size());
+}
+
+bool
+AnimationClip::deserialize(const uint8_t* data, size_t size, std::string* error) {
+  ClipHeader header = {};
+  const char* problem = nullptr;
+  if (!data || size < sizeof(ClipHeader)) {
+    problem = "the data is too small to be an animation clip";
+  }
+  else {
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+      problem = "the data is not an animation clip";
+    }
+    else if (header.version != kClipVersion) {
+      problem = "unsupported animation clip version";
+    }
+    else if (header.jointCount == 0 || header.frameCount == 0 || header.frameCount > 65536 ||
+             !(header.sampleRate > 0.0f)) {
+      problem = "the animation clip header is corrupt";
+    }
+  }
+
+  size_t trackCount = CLIP_TRACK_KIND_COUNT * static_cast<size_t>(header.jointCount);
+  size_t rangeCount = CLIP_TRACK_KIND_COUNT * kRangeComponents * ((header.jointCount + 3) / 4 * 4);
+  if (!problem) {
+    size_t expected = sizeof(ClipHeader) + trackCount * sizeof(ClipTrack) + 2 * rangeCount * sizeof(float) +
+                      (static_cast<size_t>(header.keyCount) + header.valueCount) * sizeof(uint16_t);
+    if (size != expected) {
+      problem = "the animation clip size does not match its header";
+    }
+  }
+
+  std::vector<ClipTrack> tracks;
+  if (!problem) {
+    tracks.resize(trackCount);
+    std::memcpy(tracks.data(), data + sizeof(ClipHeader), trackCount * sizeof(ClipTrack));
+    for (size_t i = 0; !problem && i < trackCount; ++i) {
+      const ClipTrack& track = tracks[i];
+      size_t components = componentCount(static_cast<unsigned int>(i / header.jointCount));
+      if (track.keyCount == 0 ||
+          static_cast<size_t>(track.firstKey) + track.keyCount > header.keyCount ||
+          track.firstValue + track.keyCount * components > header.valueCount) {
+        problem = "an animation clip track is out of range";
+      }
+    }
+  }
+  if (problem) {
+    if (error) {
+      *error = problem;
+    }
+    return false;
+  }
+
+  const uint8_t* cursor = data + sizeof(ClipHeader) + trackCount * sizeof(ClipTrack);
+  m_id = g_nextClipId.fetch_add(1);
+  m_jointCount = header.jointCount;
+  m_frameCount = header.frameCount;
+  m_sampleRate = header.sampleRate;
+  m_tracks.swap(tracks);
+  m_rangeMinimum.resize(rangeCount);
+  std::memcpy(m_rangeMinimum.data(), cursor, rangeCount * sizeof(float));
+  cursor += rangeCount * sizeof(float);
+  m_rangeScale.resize(rangeCount);
+  std::memcpy(m_rangeScale.data(), cursor, rangeCount * sizeof(float));
+  cursor += rangeCount * sizeof(float);
+  m_keyFrames.resize(header.keyCount);
+  std::memcpy(m_keyFrames.data(), cursor, header.keyCount * sizeof(uint16_t));
+  cursor += header.keyCount * sizeof(uint16_t);
+  m_values.resize(header.valueCount);
+  std::memcpy(m_values.data(), cursor, header.valueCount * sizeof(uint16_t));
+  return true;
+}
+
+uint32_t
+AnimationClip::findKey(const ClipTrack& track, float frame, uint32_t hint) const {
+  const uint16_t* frames = &m_keyFrames[track.firstKey];
+  if (hint >= track.keyCount || frames[hint] > frame) {
+    // Salto hacia atrs (o cursor nuevo): bsqueda binaria. frames[0] es siempre 0.
+    return static_cast<uint32_t>(std::upper_bound(frames, frames + track.keyCount, frame) - frames - 1);
+  }
+  while (hint + 1 < track.keyCount && frames[hint + 1] <= frame) {
+    ++hint;
+  }
+  return hint;
+}
+
+void
+AnimationClip::resetCursor(ClipCursor& cursor) const {
+  size_t padded = paddedJoints();
+  cursor.clip = m_id;
+  cursor.keys.assign(m_tracks.size(), 0);
+  cursor.values.assign(kPoseComponents * padded, 0.0f);
+  cursor.deltas.assign(kPoseComponents * padded, 0.0f);
+  // Un tramo que empieza despus del ltimo frame obliga a cargarlo en el
+  // primer sample(). El relleno es un tramo constante con la identidad.
+  cursor.segmentStart.assign(CLIP_TRACK_KIND_COUNT * padded, static_cast<float>(m_frameCount));
+  cursor.inverseLength.assign(CLIP_TRACK_KIND_COUNT * padded, 1.0f);
+  for (size_t joint = m_jointCount; joint < padded; ++joint) {
+    cursor.values[3 * padded + joint] = 1.0f;
+    for (unsigned int c = 0; c < 3; ++c) {
+      cursor.values[(firstPoseComponent(CLIP_TRACK_SCALE) + c) * padded + joint] = 1.0f;
+    }
+    for (unsigned int kind = 0; kind < CLIP_TRACK_KIND_COUNT; ++kind) {
+      cursor.segmentStart[kind * padded + joint] = 0.0f;
+      cursor.inverseLength[kind * padded + joint] = 0.0f;
+    }
+  }
+}
+
+void
+AnimationClip::loadSegment(ClipTrackKind kind, size_t joint, float frame, ClipCursor& cursor) const {
+  size_t padded = paddedJoints();
+  unsigned int components = componentCount(kind);
+  const ClipTrack& track = m_tracks[kind * m_jointCount + joint];
+  uint32_t& hint = cursor.keys[kind * m_jointCount + joint];
+  uint32_t key = findKey(track, frame, hint);
+  hint = key;
+  uint32_t next = key + 1 < track.keyCount ? key + 1 : key;
+  float start = m_keyFrames[track.firstKey + key];
+  cursor.segmentStart[kind * padded + joint] = start;
+  // La ltima clave se extiende hasta el final del clip con diferencia 0. Su
+  // longitud inversa es pequea pero no nula para que un salto hacia atrs d
+  // t < 0 y recargue; hacia delante t no llega a 1 (hay como mucho 65536 frames).
+  cursor.inverseLength[kind * padded + joint] =
+    next > key ? 1.0f / (m_keyFrames[track.firstKey + next] - start) : 1.0f / 65536.0f;
+
+  const uint16_t* valuesFrom = &m_values[track.firstValue + key * components];
+  const uint16_t* valuesTo = valuesFrom + (next - key) * components;
+  for (unsigned int c = 0; c < components; ++c) {
+    size_t range = (kind * kRangeComponents + c) * padded + joint;
+    float a = valuesFrom[c] * m_rangeScale[range] + m_rangeMinimum[range];
+    float b = valuesTo[c] * m_rangeScale[range] + m_rangeMinimum[range];
+    size_t slot = (firstPoseComponent(kind) + c) * padded + joint;
+    cursor.values[slot] = a;
+    cursor.deltas[slot] = b - a;
+  }
+}
+
+template<unsigned int Components>
+void
+AnimationClip::sampleTracks(ClipTrackKind kind, float frame, ClipCursor& cursor, std::vector<float>* output) const {
+  size_t padded = paddedJoints();
+  const float* values = &cursor.values[firstPoseComponent(kind) * padded];
+  const float* deltas = &cursor.deltas[firstPoseComponent(kind) * padded];
+  const float* start = &cursor.segmentStart[kind * padded];
+  const float* inverseLength = &cursor.inverseLength[kind * padded];
+  Vector frameVector = splat(frame);
+  Vector one = splat(1.0f);
+
+  for (size_t group = 0; group < padded; group += 4) {
+    // Solo las articulaciones que salen de su tramo (t fuera de [0, 1)) tocan
+    // las claves; el resto interpola los floats del cursor con las cuatro a la vez.
+    Vector t = multiply(subtract(frameVector, load(start + group)), load(inverseLength + group));
+    int stale = greaterMask(zero(), t) | lessOrEqualMask(one, t);
+    if (stale) {
+      for (size_t lane = 0; lane < 4; ++lane) {
+        if (stale & (1 << lane)) {
+          loadSegment(kind, group + lane, frame, cursor);
+        }
+      }
+      t = multiply(subtract(frameVector, load(start + group)), load(inverseLength + group));
+    }
+    for (unsigned int c = 0; c < Components; ++c) {
+      store(&output[c][group], multiplyAdd(load(deltas + c * padded + group), t, load(values + c * padded + group)));
+    }
+  }
+}
+
+void
+AnimationClip::sample(float time, ClipCursor& cursor, SoaPose& pose) const {
+  if (m_jointCount == 0) {
+    pose.resize(0);
+    return;
+  }
+  if (cursor.clip != m_id) {
+    resetCursor(cursor);
+  }
+  pose.resize(m_jointCount);
+  float frame = (std::min)(static_cast<float>(m_frameCount - 1), (std::max)(0.0f, time * m_sampleRate));
+
+  sampleTracks<4>(CLIP_TRACK_ROTATION, frame, cursor, pose.rotation);
+  sampleTracks<3>(CLIP_TRACK_TRANSLATION, frame, cursor, pose.translation);
+  sampleTracks<3>(CLIP_TRACK_SCALE, frame, cursor, pose.scale);
+  for (size_t group = 0; group < pose.rotation[0].size(); group += 4) {
+    normalizeRotations(&pose.rotation[0][group], &pose.rotation[1][group],
+                       &pose.rotation[2][group], &pose.rotation[3][group]);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Mezcla
+// ---------------------------------------------------------------------------
+
+void
+blendPoses(const SoaPose* const* poses, const float* weights, size_t count, SoaPose& output) {
+  if (count == 0) {
+    output.resize(0);
+    return;
+  }
+  size_t joints = poses[0]->jointCount;
+  output.resize(joints);
+  float total = 0.0f;
+  for (size_t k = 0; k < count; ++k) {
+    total += weights[k];
+  }
+  if (!(total > 0.0f)) {
+    output = *poses[0];
+    return;
+  }
+  float normalization = 1.0f / total;
+
+  for (size_t group = 0; group < output.rotation[0].size(); group += 4) {
+    const SoaPose& reference = *poses[0];
+    Vector rx = load(&reference.rotation[0][group]);
+    Vector ry = load(&reference.rotation[1][group]);
+    Vector rz = load(&reference.rotation[2][group]);
+    Vector rw = load(&reference.rotation[3][group]);
+    Vector rotation[4] = { zero(), zero(), zero(), zero() };
+    Vector translation[3] = { zero(), zero(), zero() };
+    Vector scale[3] = { zero(), zero(), zero() };
+    for (size_t k = 0; k < count; ++k) {
+      const SoaPose& pose = *poses[k];
+      Vector weight = splat(weights[k] * normalization);
+      Vector q[4] = { load(&pose.rotation[0][group]), load(&pose.rotation[1][group]),
+                      load(&pose.rotation[2][group]), load(&pose.rotation[3][group]) };
+      // Camino corto respecto a la primera pose, articulacin a articulacin.
+      Vector dot = multiplyAdd(q[0], rx, multiplyAdd(q[1], ry, multiplyAdd(q[2], rz, multiply(q[3], rw))));
+      Vector rotationWeight = copySign(weight, dot);
+      for (unsigned int c = 0; c < 4; ++c) {
+        rotation[c] = multiplyAdd(q[c], rotationWeight, rotation[c]);
+      }
+      for (unsigned int c = 0; c < 3; ++c) {
+        translation[c] = multiplyAdd(load(&pose.translation[c][group]), weight, translation[c]);
+        scale[c] = multiplyAdd(load(&pose.scale[c][group]), weight, scale[c]);
+      }
+    }
+    for (unsigned int c = 0; c < 4; ++c) {
+      store(&output.rotation[c][group], rotation[c]);
+    }
+    for (unsigned int c = 0; c < 3; ++c) {
+      store(&output.translation[c][group], translation[c]);
+      store(&output.scale[c][group], scale[c]);
+    }
+    normalizeRotations(&output.rotation[0][group], &output.rotation[1][group],
+                       &output.rotation[2][group], &output.rotation[3][group]);
+  }
+}
@@ -0,0 +1,507 @@
+#include "AssetManager.h"
+#include "Allocators.h"
+#include "DdsFile.h"
+#include "Device.h"
+#include "ImageDecoder.h"
+#include <cctype>
+
+namespace {
+  bool
+  endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::char_traits<char>::length(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+  }
+
+  std::string
+  normalizePath(const std::string& path) {
+    std::string normalized(path);
+    for (char& c : normalized) {
+      c = c == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return normalized;
+  }
+
+  void
+  destroyMesh(MeshAsset& asset) {
+    asset.vertexBuffer.destroy();
+    asset.indexBuffer.destroy();
+    asset.mesh.m_vertex.clear();
+    asset.mesh.m_index.clear();
+  }
+
+  void
+  destroyTexture(TextureAsset& asset) {
+    asset.texture.destroy();
+    asset.image = DdsImage();
+    asset.file.reset();
+  }
+
+  /** @brief Lado mayor de la cola de mips que se sube siempre con la textura. */
+  const unsigned int kStreamTailSize = 64;
+}
+
+uint64_t
+AssetManager::hashPath(const std::string& path) {
+  // FNV-1a de 64 bits sobre la ruta normalizada.
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : normalizePath(path)) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+HRESULT
+AssetManager::init(Device& device, AsyncLoader& loader) {
+  m_device = &device;
+  m_loader = &loader;
+  return S_OK;
+}
+
+void
+AssetManager::destroy() {
+  // Las lecturas de mips en curso toman m_mutex al terminar.
+  JobSystem::instance().wait(m_streamJobs);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (size_t i = 0; i < m_meshes.entries.size(); ++i) {
+    destroyMesh(m_meshes.entries.at(i).resource);
+  }
+  for (size_t i = 0; i < m_textures.entries.size(); ++i) {
+    unregisterStream(m_textures.entries.at(i).resource);
+    destroyTexture(m_textures.entries.at(i).resource);
+  }
+  m_meshes = Table<MeshAsset>();
+  m_textures = Table<TextureAsset>();
+  m_requests.clear();
+  m_streamedMips.clear();
+}
+
+MeshHandle
+AssetManager::acquireMesh(const std::string& path) {
+  return acquire(m_meshes, path, ASSET_MODEL);
+}
+
+TextureHandle
+AssetManager::acquireTexture(const std::string& path, TextureUsage usage) {
+  // Los DDS se proyectan en memoria y se suben tal cual; PNG/JPG se decodifican en el hilo de trabajo.
+  AssetType type = endsWith(normalizePath(path), ".dds") ? ASSET_FILE : ASSET_IMAGE;
+  return acquire(m_textures, path, type, usage);
+}
+
+void
+AssetManager::addRef(MeshHandle handle) {
+  addRef(m_meshes, handle);
+}
+
+void
+AssetManager::addRef(TextureHandle handle) {
+  addRef(m_textures, handle);
+}
+
+void
+AssetManager::release(MeshHandle handle) {
+  release(m_meshes, handle);
+}
+
+void
+AssetManager::release(TextureHandle handle) {
+  release(m_textures, handle);
+}
+
+AssetState
+AssetManager::state(MeshHandle handle) const {
+  return state(m_meshes, handle);
+}
+
+AssetState
+AssetManager::state(TextureHandle handle) const {
+  return state(m_textures, handle);
+}
+
+MeshAsset*
+AssetManager::mesh(MeshHandle handle) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry<MeshAsset>* entry = m_meshes.entries.get(handle);
+  return entry && entry->state == ASSET_RESIDENT ? &entry->resource : nullptr;
+}
+
+Texture*
+AssetManager::texture(TextureHandle handle) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry<TextureAsset>* entry = m_textures.entries.get(handle);
+  return entry && entry->state == ASSET_RESIDENT ? &entry->resource.texture : nullptr;
+}
+
+void
+AssetManager::enableStreaming(size_t budgetBytes, unsigned int maxLoadsInFlight) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_streamer.init(budgetBytes, maxLoadsInFlight);
+  m_streaming = true;
+}
+
+void
+AssetManager::requestTextureDetail(TextureHandle handle, float screenPixels, float uvSpan) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry<TextureAsset>* entry = m_textures.entries.get(handle);
+  if (entry && entry->resource.stream.isValid()) {
+    m_streamer.request(entry->resource.stream, screenPixels, uvSpan);
+  }
+}
+
+void
+AssetManager::updateStreaming() {
+  if (!m_streaming) {
+    return;
+  }
+  struct
+  MipRead {
+    StreamedMip mip;
+    FileView file;
+    std::vector<DdsSurface> surfaces;
+  };
+  // Lista del frame: vive en el asignador lineal del hilo principal. Cada tarea
+  // recibe su propia copia de la lectura, as que nada apunta a ella tras el frame.
+  LinearVector<MipRead> reads{ LinearStlAllocator<MipRead>(EngineMemory::frame()) };
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Mips ya ledos: la textura se recrea con el nuevo nivel ms detallado.
+    for (const StreamedMip& loaded : m_streamedMips) {
+      Entry<TextureAsset>* entry = m_textures.entries.get(loaded.texture);
+      if (!entry || entry->resource.stream != loaded.stream) {
+        continue;
+      }
+      // Si el objetivo cambi mientras se lea, el streamer descarta el mip.
+      m_streamer.onLoaded(loaded.stream, loaded.mip);
+      if (m_streamer.residentMip(loaded.stream) != loaded.mip) {
+        continue;
+      }
+      Texture texture;
+      HRESULT hr = texture.init(*m_device, entry->resource.image, loaded.mip);
+      if (SUCCEEDED(hr)) {
+        entry->resource.texture.destroy();
+        entry->resource.texture = texture;
+      }
+      else {
+        // Se queda con los mips que ya tiene y sale del streaming para no reintentar cada frame.
+        ERROR("AssetManager", "updateStreaming", "Failed to stream mip of %s", entry->path);
+        unregisterStream(entry->resource);
+        entry->resource.image = DdsImage();
+        entry->resource.file.reset();
+      }
+    }
+    m_streamedMips.clear();
+
+    std::vector<StreamAction> actions;
+    m_streamer.update(actions);
+    for (const StreamAction& action : actions) {
+      auto owner = m_streamOwners.find(action.handle.index);
+      Entry<TextureAsset>* entry = owner != m_streamOwners.end() ? m_textures.entries.get(owner->second) : nullptr;
+      if (!entry) {
+        m_streamer.onLoaded(action.handle, action.mip, false);
+        continue;
+      }
+      if (action.type == STREAM_EVICT) {
+        Texture texture;
+        if (SUCCEEDED(texture.init(*m_device, entry->resource.image, action.mip))) {
+          entry->resource.texture.destroy();
+          entry->resource.texture = texture;
+        }
+        continue;
+      }
+      MipRead read;
+      read.mip = { owner->second, action.handle, action.mip };
+      read.file = entry->resource.file;
+      for (unsigned int slice = 0; slice < entry->resource.image.sliceCount(); ++slice) {
+        read.surfaces.push_back(entry->resource.image.surface(action.mip, slice));
+      }
+      reads.push_back(std::move(read));
+    }
+  }
+
+  // Las lecturas se lanzan sin el mutex: sin JobSystem, run() ejecuta la tarea aqu mismo.
+  for (MipRead& read : reads) {
+    JobSystem::instance().run([this, read]() {
+      for (const DdsSurface& surface : read.surfaces) {
+        read.file.prefetch(static_cast<size_t>(surface.data - read.file.data()),
+                           surface.slicePitch * surface.depth);
+      }
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_streamedMips.push_back(read.mip);
+    }, &m_streamJobs);
+  }
+}
+
+StreamStats
+AssetManager::streamingStats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_streamer.stats();
+}
+
+void
+AssetManager::processUploads(size_t maxItems, size_t maxBytes) {
+  if (!m_loader) {
+    return;
+  }
+  std::vector<CompletedAsset> completed;
+  if (m_loader->takeCompleted(completed, maxItems, maxBytes) == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (CompletedAsset& asset : completed) {
+    auto request = m_requests.find(asset.handle);
+    if (request == m_requests.end()) {
+      m_loader->markFailed(asset.handle);
+      continue;
+    }
+    PendingUpload target = request->second;
+    m_requests.erase(request);
+
+    HRESULT hr = upload(asset, target);
+    setState(target, SUCCEEDED(hr) ? ASSET_RESIDENT : ASSET_FAILED);
+
+    if (SUCCEEDED(hr)) {
+      m_loader->markResident(asset.handle);
+      MESSAGE("AssetManager", "processUploads", "Resident: %s", asset.path);
+    }
+    else {
+      m_loader->markFailed(asset.handle);
+      ERROR("AssetManager", "processUploads", "Failed to create GPU resources for %s", asset.path);
+    }
+  }
+}
+
+void
+AssetManager::endFrame() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_frameIndex;
+
+  // Las lecturas que fallan en el cargador nunca llegan a processUploads().
+  for (auto it = m_requests.begin(); m_loader && it != m_requests.end();) {
+    if (m_loader->state(it->first) == ASSET_FAILED) {
+      setState(it->second, ASSET_FAILED);
+      it = m_requests.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  collect(m_meshes, destroyMesh);
+  collect(m_textures, [this](TextureAsset& asset) {
+    unregisterStream(asset);
+    destroyTexture(asset);
+  });
+}
+
+HRESULT
+AssetManager::upload(CompletedAsset& asset, const PendingUpload& target) {
+  HRESULT hr = E_FAIL;
+
+  if (Entry<MeshAsset>* entry = m_meshes.entries.get(target.mesh)) {
+    MeshComponent& mesh = entry->resource.mesh;
+    mesh.m_name = asset.model.name;
+    mesh.m_vertex = std::move(asset.model.vertex);
+    mesh.m_index = std::move(asset.model.index);
+    mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+    mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+
+    hr = entry->resource.vertexBuffer.init(*m_device, mesh, D3D11_BIND_VERTEX_BUFFER);
+    if (SUCCEEDED(hr)) {
+      hr = entry->resource.indexBuffer.init(*m_device, mesh, D3D11_BIND_INDEX_BUFFER);
+    }
+    if (FAILED(hr)) {
+      destroyMesh(entry->resource);
+    }
+  }
+  else if (Entry<TextureAsset>* entry = m_textures.entries.get(target.texture)) {
+    Texture& texture = entry->resource.texture;
+    if (asset.type == ASSET_IMAGE && !asset.image.compressed.levels.empty()) {
+      hr = texture.init(*m_device, asset.image.compressed);
+    }
+    else if (asset.type == ASSET_IMAGE) {
+      hr = texture.init(*m_device, asset.image.mips, static_cast<DXGI_FORMAT>(asset.image.dxgiFormat));
+      // Los pxeles ya estn en GPU: sus bferes vuelven al pool del decodificador.
+      for (MipLevel& level : asset.image.mips.levels) {
+        ImageDecoder::instance().recycle(std::move(level.pixels));
+      }
+    }
+    else {
+      hr = uploadDds(asset, target.texture, entry->resource);
+    }
+  }
+  return hr;
+}
+
+HRESULT
+AssetManager::uploadDds(const CompletedAsset& asset, TextureHandle handle, TextureAsset& resource) {
+  DdsImage& image = resource.image;
+  std::string error;
+  if (asset.file.empty() || !parseDds(asset.file.data(), asset.file.size(), image, &error)) {
+    ERROR("AssetManager", "upload", "Invalid DDS file %s: %s", asset.path, error);
+    image = DdsImage();
+    return E_FAIL;
+  }
+
+  // Con streaming solo se sube la cola de mips; en formatos BC su primer nivel
+  // debe seguir siendo mltiplo de 4.
+  unsigned int tailMip = 0;
+  if (m_streaming && image.dimension == DDS_TEXTURE2D) {
+    tailMip = TextureStreamer::tailMipFor(image.width, image.height, image.mipLevels, kStreamTailSize);
+    while (tailMip > 0 && dxgiBlockBytes(image.dxgiFormat) != 0 &&
+           (image.surface(tailMip, 0).width % 4 != 0 || image.surface(tailMip, 0).height % 4 != 0)) {
+      --tailMip;
+    }
+  }
+
+  HRESULT hr = resource.texture.init(*m_device, image, tailMip);
+  if (FAILED(hr) || tailMip == 0) {
+    image = DdsImage();
+    return hr;
+  }
+
+  StreamTextureDesc desc;
+  desc.width = image.width;
+  desc.height = image.height;
+  desc.tailMip = tailMip;
+  desc.levelBytes.assign(image.mipLevels, 0);
+  for (unsigned int slice = 0; slice < image.sliceCount(); ++slice) {
+    for (unsigned int mip = 0; mip < image.mipLevels; ++mip) {
+      desc.levelBytes[mip] += image.surface(mip, slice).slicePitch;
+    }
+  }
+  resource.file = asset.file;
+  resource.stream = m_streamer.add(desc);
+  m_streamOwners[resource.stream.index] = handle;
+  return S_OK;
+}
+
+void
+AssetManager::unregisterStream(TextureAsset& resource) {
+  if (resource.stream.isValid()) {
+    m_streamer.remove(resource.stream);
+    m_streamOwners.erase(resource.stream.index);
+    resource.stream = StreamHandle();
+  }
+}
+
+void
+AssetManager::setState(const PendingUpload& target, AssetState state) {
+  if (Entry<MeshAsset>* entry = m_meshes.entries.get(target.mesh)) {
+    entry->state = state;
+  }
+  if (Entry<TextureAsset>* entry = m_textures.entries.get(target.texture)) {
+    entry->state = state;
+  }
+}
+
+size_t
+AssetManager::meshCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_meshes.entries.size();
+}
+
+size_t
+AssetManager::textureCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_textures.entries.size();
+}
+
+template<typename T>
+SlotHandle<T>
+AssetManager::acquire(Table<T>& table, const std::string& path, AssetType type, TextureUsage usage) {
+  uint64_t key = hashPath(path);
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto found = table.byKey.find(key);
+  if (found != table.byKey.end()) {
+    Entry<T>* entry = table.entries.get(found->second);
+    if (normalizePath(entry->path) != normalizePath(path)) {
+      ERROR("AssetManager", "acquire", "Hash collision between %s and %s", entry->path, path);
+      return SlotHandle<T>();
+    }
+    ++entry->refCount;
+    return found->second;
+  }
+
+  Entry<T> entry;
+  entry.key = key;
+  entry.path = path;
+  entry.refCount = 1;
+  SlotHandle<T> handle = table.entries.insert(std::move(entry));
+  table.byKey[key] = handle;
+
+  if (!m_loader) {
+    ERROR("AssetManager", "acquire", "AssetManager not initialized");
+    table.entries.get(handle)->state = ASSET_FAILED;
+    return handle;
+  }
+
+  // La peticin se registra con el mutex tomado: processUploads() no puede
+  // recibir el resultado antes de saber a qu handle pertenece.
+  AssetHandle request = type == ASSET_MODEL ? m_loader->loadModel(path)
+                      : type == ASSET_IMAGE ? m_loader->loadImage(path, usage)
+                      : m_loader->loadFile(path);
+  Entry<T>* created = table.entries.get(handle);
+  created->request = request;
+  created->state = m_loader->state(request) == ASSET_FAILED ? ASSET_FAILED : ASSET_LOADING;
+
+  bindRequest(m_requests[request], handle);
+  return handle;
+}
+
+template<typename T>
+void
+AssetManager::addRef(Table<T>& table, SlotHandle<T> handle) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (Entry<T>* entry = table.entries.get(handle)) {
+    ++entry->refCount;
+  }
+}
+
+template<typename T>
+void
+AssetManager::release(Table<T>& table, SlotHandle<T> handle) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry<T>* entry = table.entries.get(handle);
+  if (!entry || entry->refCount == 0) {
+    return;
+  }
+  if (--entry->refCount == 0) {
+    entry->releasedFrame = m_frameIndex;
+    table.released.push_back(handle);
+  }
+}
+
+template<typename T>
+AssetState
+AssetManager::state(const Table<T>& table, SlotHandle<T> handle) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const Entry<T>* entry = table.entries.get(handle);
+  return entry ? entry->state : ASSET_FAILED;
+}
+
+template<typename T, typename Destroy>
+void
+AssetManager::collect(Table<T>& table, Destroy destroyResource) {
+  size_t kept = 0;
+  for (size_t i = 0; i < table.released.size(); ++i) {
+    SlotHandle<T> handle = table.released[i];
+    Entry<T>* entry = table.entries.get(handle);
+    if (!entry || entry->refCount > 0) {
+      // Ya destruido o se volvi a pedir antes de tiempo.
+      continue;
+    }
+    bool loading = entry->state == ASSET_QUEUED || entry->state == ASSET_LOADING;
+    if (loading || m_frameIndex - entry->releasedFrame < kDestroyLatency) {
+      table.released[kept++] = handle;
+      continue;
+    }
+
+    destroyResource(entry->resource);
+    table.byKey.erase(entry->key);
+    table.entries.remove(handle);
+  }
+  table.released.resize(kept);
+}
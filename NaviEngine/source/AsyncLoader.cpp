@@ -0,0 +1,207 @@
+#include "AsyncLoader.h"
+#include "ImageDecoder.h"
+#include "ModelLoader.h"
+#include "Profiler.h"
+#include <algorithm>
+
+bool
+AsyncLoader::init() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_initialized = true;
+  m_stopping = false;
+  return true;
+}
+
+void
+AsyncLoader::destroy() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_initialized) {
+      return;
+    }
+    m_stopping = true;
+  }
+  // Las tareas an en cola ven m_stopping y se descartan sin leer el disco.
+  JobSystem::instance().wait(m_inFlight);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_completed.clear();
+  m_initialized = false;
+}
+
+AssetHandle
+AsyncLoader::loadModel(const std::string& path) {
+  return enqueue(ASSET_MODEL, path);
+}
+
+AssetHandle
+AsyncLoader::loadImage(const std::string& path, TextureUsage usage) {
+  return enqueue(ASSET_IMAGE, path, usage);
+}
+
+AssetHandle
+AsyncLoader::loadFile(const std::string& path) {
+  return enqueue(ASSET_FILE, path);
+}
+
+AssetState
+AsyncLoader::state(AssetHandle handle) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (handle == INVALID_ASSET_HANDLE || handle > m_states.size()) {
+    return ASSET_FAILED;
+  }
+  return m_states[handle - 1];
+}
+
+size_t
+AsyncLoader::takeCompleted(std::vector<CompletedAsset>& out, size_t maxItems, size_t maxBytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t taken = 0;
+  size_t bytes = 0;
+  while (!m_completed.empty() && taken < maxItems) {
+    size_t next = m_completed.front().uploadBytes();
+    if (taken > 0 && bytes + next > maxBytes) {
+      break;
+    }
+    bytes += next;
+    out.push_back(std::move(m_completed.front()));
+    m_completed.pop_front();
+    ++taken;
+  }
+  return taken;
+}
+
+void
+AsyncLoader::markResident(AssetHandle handle) {
+  setState(handle, ASSET_RESIDENT);
+}
+
+void
+AsyncLoader::markFailed(AssetHandle handle) {
+  setState(handle, ASSET_FAILED);
+}
+
+size_t
+AsyncLoader::pendingCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<size_t>(std::count_if(m_states.begin(), m_states.end(), [](AssetState s) {
+    return s != ASSET_RESIDENT && s != ASSET_FAILED;
+  }));
+}
+
+void
+AsyncLoader::setImageCompression(BlockFormat format, BlockQuality quality) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_imageCompression = format;
+  m_imageQuality = quality;
+}
+
+AssetHandle
+AsyncLoader::enqueue(AssetType type, const std::string& path, TextureUsage usage) {
+  Request request;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_states.push_back(m_initialized && !m_stopping ? ASSET_QUEUED : ASSET_FAILED);
+    request = { static_cast<AssetHandle>(m_states.size()), type, path, m_imageCompression, m_imageQuality, usage };
+    if (m_states.back() == ASSET_FAILED) {
+      ERROR("AsyncLoader", "enqueue", "Loader not initialized");
+      return request.handle;
+    }
+  }
+  JobSystem::instance().run([this, request]() { execute(request); }, &m_inFlight);
+  return request.handle;
+}
+
+void
+AsyncLoader::setState(AssetHandle handle, AssetState state) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (handle != INVALID_ASSET_HANDLE && handle <= m_states.size()) {
+    m_states[handle - 1] = state;
+  }
+}
+
+void
+AsyncLoader::execute(const Request& request) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) {
+      m_states[request.handle - 1] = ASSET_FAILED;
+      return;
+    }
+    m_states[request.handle - 1] = ASSET_LOADING;
+  }
+
+  CompletedAsset result;
+  result.handle = request.handle;
+  result.type = request.type;
+  result.path = request.path;
+  process(request, result);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (result.ok && !m_stopping) {
+    m_states[request.handle - 1] = ASSET_DECODED;
+    m_completed.push_back(std::move(result));
+  }
+  else {
+    m_states[request.handle - 1] = ASSET_FAILED;
+  }
+}
+
+void
+AsyncLoader::process(const Request& request, CompletedAsset& result) {
+  NAVI_PROFILE_SCOPE("AsyncLoader::process");
+
+  switch (request.type) {
+  case ASSET_MODEL: {
+    ModelLoader loader;
+    result.model = loader.Load(request.path);
+    result.ok = !result.model.vertex.empty() && !result.model.index.empty();
+    break;
+  }
+  case ASSET_IMAGE: {
+    // Varios hilos decodifican a la vez sobre el pool de ImageDecoder; el bfer
+    // decodificado (con los canales del archivo) pasa a ser el nivel 0 de la
+    // cadena sin copiarse si ya es RGBA.
+    DecodedImage decoded;
+    std::string error;
+    FileView file;
+    if (!VirtualFileSystem::instance().open(request.path, file)) {
+      error = "file not found";
+    }
+    if (file.empty() || !ImageDecoder::instance().decodeMemory(file.data(), file.size(), decoded, &error, 0)) {
+      ERROR("AsyncLoader", "process", "Failed to decode image %s: %s", request.path, error);
+      break;
+    }
+    ImageFormat format = chooseImageFormat(decoded.channels, request.usage);
+    result.image.dxgiFormat = format.dxgiFormat;
+
+    // El compresor trabaja sobre RGBA: una cadena de uno o dos canales se
+    // comprime como BC4 o BC5 antes de reducirse.
+    bool compress = request.compression != BLOCK_NONE && canBlockCompress(decoded.width, decoded.height);
+    result.ok = buildMipChain(std::move(decoded), format, compress ? 4 : format.channels, result.image.mips);
+    if (result.ok && compress) {
+      BlockFormat blockFormat = format.channels == 1 ? BLOCK_BC4
+                              : format.channels == 2 ? BLOCK_BC5
+                              : request.compression;
+      result.ok = compressMipChain(result.image.mips, blockFormat, request.quality,
+                                   format.srgb, result.image.compressed);
+      for (MipLevel& level : result.image.mips.levels) {
+        ImageDecoder::instance().recycle(std::move(level.pixels));
+      }
+      result.image.mips.levels.clear();
+    }
+    break;
+  }
+  case ASSET_FILE: {
+    FileView file;
+    if (!VirtualFileSystem::instance().open(request.path, file)) {
+      ERROR("AsyncLoader", "process", "Failed to open file: %s", request.path);
+      break;
+    }
+    file.prefetch();
+    result.file = std::move(file);
+    result.ok = true;
+    break;
+  }
+  }
+}
@@ -1,4 +1,31 @@
 #include "BaseApp.h"
+#include "Allocators.h"
+#include "FileSystem.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include "Metrics.h"
+
+namespace {
+  /**
+   * @brief Publica los bytes vivos de cada subsistema (memory_<tag>_bytes) y lo
+   *        consumido por el asignador del frame que termina.
+   */
+  void
+  publishMemoryMetrics() {
+    static MetricGauge* gauges[MEMORY_TAG_COUNT] = {};
+    static MetricGauge& frameBytes =
+      MetricsRegistry::instance().gauge("frame_allocator_bytes", "Bytes used by the frame allocator");
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+      MemoryTag memoryTag = static_cast<MemoryTag>(tag);
+      if (!gauges[tag]) {
+        gauges[tag] = &MetricsRegistry::instance().gauge(
+          std::string("memory_") + memoryTagName(memoryTag) + "_bytes", "Live bytes in the tagged heap");
+      }
+      gauges[tag]->set(static_cast<double>(TaggedHeap::instance().stats(memoryTag).currentBytes));
+    }
+    frameBytes.set(static_cast<double>(EngineMemory::frame().used()));
+  }
+}
 
 BaseApp::BaseApp(HINSTANCE hInst, int nCmdShow) {
 
@@ -8,36 +35,112 @@ BaseApp::BaseApp(HINSTANCE hInst, int nCmdShow) {
 //El wWinMain creado, pero con un meodo de clase
 int
 BaseApp::run(HINSTANCE hInst, int nCmdShow) {
+  Profiler::instance().setThreadName("Main");
+  // El registro se escribe en un hilo propio: a fichero y a la salida de depuracin.
+  Logger::instance().addSink(std::make_unique<FileLogSink>("NaviEngine.log"));
+  Logger::instance().addSink(std::make_unique<DebugOutputLogSink>());
+  Logger::instance().start();
+#if defined(PROFILE)
+  // En las configuraciones Debug y Profile se captura toda la ejecucin,
+  // incluida la carga inicial, y se exporta al salir.
+  Profiler::instance().setEnabled(true);
+  Profiler::instance().beginCapture();
+#endif
   if (FAILED(m_window.init(hInst, nCmdShow, WndProc))) {
     return 0;
   }
   if (FAILED(init()))
     return 0;
   // Main message loop
+  // La simulacin avanza en pasos fijos de 1/60 s; el render interpola entre pasos.
   MSG msg = { };
-  LARGE_INTEGER freq, prev;
-  QueryPerformanceFrequency(&freq);
-  QueryPerformanceCounter(&prev);
+  m_frameLoop.init(1.0 / 60.0);
+  m_frameLoop.reset(m_clock.now());
+
+  // El pacer limita el ritmo a 60 Hz sin girar a plena CPU. timeBeginPeriod(1)
+  // baja la granularidad de Sleep de ~15.6 ms a ~1 ms mientras corre el ciclo.
+  timeBeginPeriod(1);
+  m_framePacer.init(m_clock, 60.0);
+
+  // Contadores por frame volcados a CSV y a texto de Prometheus cada 5 s.
+  MetricsRegistry& metrics = MetricsRegistry::instance();
+  metrics.setDumpTargets("NaviEngine_metrics.csv", "NaviEngine_metrics.prom", 5.0);
   while (WM_QUIT != msg.message)
   {
-    if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+    // Procesar todos los mensajes pendientes antes de producir el frame
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
     {
+      if (WM_QUIT == msg.message) {
+        break;
+      }
       TranslateMessage(&msg);
       DispatchMessage(&msg);
     }
-    else
+    if (WM_QUIT == msg.message) {
+      break;
+    }
+
+    double frameTime = m_framePacer.waitForNextFrame();
+
+    // Lo reservado en el asignador del frame anterior deja de ser vlido aqu.
+    EngineMemory::frame().reset();
     {
-      LARGE_INTEGER curr;
-      QueryPerformanceCounter(&curr);
-      float deltaTime = static_cast<float>(curr.QuadPart - prev.QuadPart) / freq.QuadPart;
-      prev = curr;
-      update(deltaTime);
-      render();
+      NAVI_PROFILE_SCOPE("BaseApp::update");
+      m_frameLoop.tick(m_clock.now(), [this](double step) {
+        update(static_cast<float>(step));
+      });
     }
+    {
+      NAVI_PROFILE_SCOPE("BaseApp::uploads");
+      m_assets.processUploads(m_maxUploadsPerFrame, m_uploadBudgetBytes);
+      m_assets.updateStreaming();
+    }
+    {
+      NAVI_PROFILE_SCOPE("BaseApp::render");
+      render(static_cast<float>(m_frameLoop.alpha()));
+    }
+    m_assets.endFrame();
+    NAVI_PROFILE_END_FRAME();
+    publishMemoryMetrics();
+    metrics.endFrame(frameTime);
+    metrics.dumpIfDue(m_clock.now());
+  }
+  timeEndPeriod(1);
+
+#if defined(PROFILE)
+  Profiler::instance().endCapture();
+  Profiler::instance().exportChromeTrace("NaviEngine_trace.json");
+  Profiler::instance().exportBinary("NaviEngine_trace.nprf");
+#endif
+
+  const FrameTimeStats& stats = m_framePacer.stats();
+  MESSAGE("BaseApp", "run",
+    "Frames: %llu mean(ms): %.3f stddev(ms): %.3f max(ms): %.3f missed: %llu wait error(ms): %.3f",
+    static_cast<unsigned long long>(stats.frameCount), stats.mean * 1000.0, stats.stdDev() * 1000.0,
+    stats.maxFrame * 1000.0, static_cast<unsigned long long>(stats.missedDeadlines),
+    stats.maxWaitError * 1000.0);
+
+  const MetricHistogram& frameTimes = EngineMetrics::frameTime();
+  MESSAGE("BaseApp", "run",
+    "Frame time p50(ms): %.3f p95(ms): %.3f p99(ms): %.3f",
+    frameTimes.percentile(0.50) * 1000.0, frameTimes.percentile(0.95) * 1000.0,
+    frameTimes.percentile(0.99) * 1000.0);
+
+  for (int tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+    MemoryStats memory = TaggedHeap::instance().stats(static_cast<MemoryTag>(tag));
+    MESSAGE("BaseApp", "run",
+      "Memory %s live(KB): %u peak(KB): %u allocations: %u",
+      memoryTagName(static_cast<MemoryTag>(tag)), memory.currentBytes / 1024, memory.peakBytes / 1024,
+      memory.totalAllocations);
   }
+  MESSAGE("BaseApp", "run",
+    "Frame allocator high water(KB): %u overflows: %u",
+    EngineMemory::frame().highWater() / 1024, EngineMemory::frame().overflowCount());
 
   //CleanupDevice();
 
+  // Vaca los mensajes pendientes antes de salir.
+  Logger::instance().stop();
   return (int)msg.wParam;
 }
 
@@ -47,43 +150,21 @@ BaseApp::init() {
   HRESULT hr = S_OK;
 
   // Creacion SwapChain (tmb Device/Context)
-  hr = m_swapChain.init(m_device, m_deviceContext, m_backBuffer, m_window);
+  hr = m_swapChain.init(m_device, m_deviceContext, m_backBuffer.texture, m_window);
   if (FAILED(hr)) {
     ERROR("BaseApp", "init", "Failed to initialize SwapChain.");
     return hr;
   }
 
   //Creacion del RenderTarget View
-  hr = m_renderTargetView.init(m_device, m_backBuffer, DXGI_FORMAT_R8G8B8A8_UNORM);
+  hr = m_backBuffer.renderTargetView.init(m_device, m_backBuffer.texture, DXGI_FORMAT_R8G8B8A8_UNORM);
   if (FAILED(hr)) {
     ERROR("BaseApp", "init", "Failed to initialize RenderTargetView.");
     return hr;
   }
 
-  //Creacion de la Texturea de Depth Stencil
-  hr = m_depthStencil.init(m_device,
-       m_window.m_width,
-       m_window.m_height,
-       DXGI_FORMAT_D24_UNORM_S8_UINT,
-       D3D11_BIND_DEPTH_STENCIL,
-       4,
-       0);
-  //
-  //Recordar reemplazar Main por BaseApp
-  //
-  if (FAILED(hr)) {
-    ERROR("BaseApp", "init", "Failed to initialize DepthStencil Texture.");
-    return hr;
-  }
-
-  //Creacion Depth Stencil View
-  hr = m_depthStencilView.init(m_device,
-                               m_depthStencil,
-                               DXGI_FORMAT_D24_UNORM_S8_UINT);
-  if (FAILED(hr)) {
-    ERROR("BaseApp", "init", "Failed to initialize DepthStencilView.");
-    return hr;
-  }
+  // La profundidad no se crea aqu: es una textura transitoria del frame
+  // graph que se pide (y se recicla entre frames) en render().
 
   //Creacion del Viewport
   hr = m_viewport.init(m_window);
@@ -127,59 +208,59 @@ BaseApp::init() {
   normal.InstanceDataStepRate = 0;
   Layout.push_back(normal);
 
-  //Creacion de ShaderProgram
-  hr = m_shaderProgram.init(m_device, "NaviEngine.fx", Layout);
-  if (FAILED(hr)) {
-    ERROR("Main", "InitDevice",
-      ("Failed to initialize ShaderProgram. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
+  // Con un Assets.pak (tools/PakTool.cpp) junto al ejecutable los assets y
+  // shaders se leen de l; lo que no contenga sigue leyndose suelto.
+  if (VirtualFileSystem::instance().mountPak("Assets.pak")) {
+    MESSAGE("BaseApp", "init", "Mounted Assets.pak");
   }
 
-  //Definir la Gemotria. En esta caso en el Main era un cubo
-  //ESTO ES TEMPORAL
+  // Los trabajadores arrancan antes de los shaders: las variantes se compilan en paralelo.
+  JobSystem::instance().init();
 
-  
-  //Load Model
-  LD = m_modelLoader.Load("Assets/Duck.obj");
-
-  if (LD.vertex.empty() || LD.index.empty()) {
-    ERROR("BaseApp", "init", "Fallo al cargar el modelo 'Assets/NAME.obj'");
-    return E_FAIL;
-  }
-
-  //Limpiar mesh
-  m_mesh.m_vertex.clear();
-  m_mesh.m_index.clear();
-
-  // Copiar los vrtices de LD a m_mesh
-  for (const auto& vertex : LD.vertex) {
-    m_mesh.m_vertex.push_back(vertex);
+  //Creacion de los shaders
+  // El bytecode compilado se guarda en ShaderCache/; sin carpeta se compila siempre.
+  // NaviEngine.fx an no declara palabras clave: una sola variante (mscara 0).
+  ShaderCache::instance().init("ShaderCache", m_shaderCompiler);
+  hr = m_shaderVariants.init(m_device, "NaviEngine.fx", ShaderStageEntryPoints(), Layout, {});
+  if (FAILED(hr)) {
+    ERROR("Main", "InitDevice",
+      "Failed to initialize shader variants. HRESULT: %d", hr);
+    return hr;
   }
-
-  // Copiar los ndices de LD a m_mesh
-  m_mesh.m_index = LD.index;
-  
-
-
-  // Actualizar los contadores en m_mesh
-  m_mesh.m_numVertex = m_mesh.m_vertex.size();
-  m_mesh.m_numIndex = m_mesh.m_index.size();
-
-  //La creacion del Vertex Buffer
-  // Create vertex buffer
-  hr = m_vertexBuffer.init(m_device, m_mesh, D3D11_BIND_VERTEX_BUFFER);
+  MESSAGE("BaseApp", "init", "Shader cache hits: %u misses: %u",
+          ShaderCache::instance().hits(), ShaderCache::instance().misses());
+
+  // Geometra provisional: un cubo que se dibuja mientras el modelo real
+  // se carga en segundo plano (o si el modelo no existe).
+  LoadData placeholder = m_modelLoader.CreateCube(0.2f);
+  m_placeholderMesh.m_name = placeholder.name;
+  m_placeholderMesh.m_vertex = placeholder.vertex;
+  m_placeholderMesh.m_index = placeholder.index;
+  m_placeholderMesh.m_numVertex = placeholder.numVertex;
+  m_placeholderMesh.m_numIndex = placeholder.numIndex;
+
+  hr = m_placeholderVertexBuffer.init(m_device, m_placeholderMesh, D3D11_BIND_VERTEX_BUFFER);
   if (FAILED(hr)) {
-    ERROR("BaseApp", "init", "Failed to initialize VertexBuffer.");
+    ERROR("BaseApp", "init", "Failed to initialize placeholder VertexBuffer.");
     return hr;
   }
 
-  //Creacion del IndexBuffer
-  hr = m_indexBuffer.init(m_device, m_mesh, D3D11_BIND_INDEX_BUFFER);
+  hr = m_placeholderIndexBuffer.init(m_device, m_placeholderMesh, D3D11_BIND_INDEX_BUFFER);
   if (FAILED(hr)) {
-    ERROR("BaseApp", "init", "Failed to initialize IndexBuffer.");
+    ERROR("BaseApp", "init", "Failed to initialize placeholder IndexBuffer.");
     return hr;
   }
 
+  // El modelo y su textura se piden al cargador asncrono; init() no espera.
+  m_asyncLoader.init();
+  // Las imgenes PNG/JPG se suben en BC7: 4 veces menos memoria que RGBA8.
+  m_asyncLoader.setImageCompression(BLOCK_BC7, BLOCK_QUALITY_NORMAL);
+  m_assets.init(m_device, m_asyncLoader);
+  // Los DDS empiezan con sus mips pequeos y suben de nivel segn su tamao en pantalla.
+  m_assets.enableStreaming(m_textureBudgetBytes);
+  m_modelMesh = m_assets.acquireMesh("Assets/Duck.obj");
+  m_modelTexture = m_assets.acquireTexture("Assets/DuckTexture.dds");
+
   //Set Primitive Topology
   m_deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
@@ -188,30 +269,32 @@ BaseApp::init() {
   hr = m_cbNeverChanges.init(m_device, sizeof(CBNeverChanges));
   if (FAILED(hr)) {
     ERROR("BaseApp", "InitDevice",
-      ("Failed to initialize NeverChanges Buffer. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to initialize NeverChanges Buffer. HRESULT: %d", hr);
     return hr;
   }
 
   hr = m_cbChangeOnResize.init(m_device, sizeof(CBChangeOnResize));
   if (FAILED(hr)) {
     ERROR("BaseApp", "InitDevice",
-      ("Failed to initialize ChangeOnResize Buffer. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to initialize ChangeOnResize Buffer. HRESULT: %d", hr);
     return hr;
   }
 
   hr = m_cbChangesEveryFrame.init(m_device, sizeof(CBChangesEveryFrame));
   if (FAILED(hr)) {
     ERROR("BaseApp", "InitDevice",
-      ("Failed to initialize ChangesEveryFrame Buffer. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to initialize ChangesEveryFrame Buffer. HRESULT: %d", hr);
     return hr;
   }
 
-  // Load the Texture
-  //hr = m_textureCube.init(m_device, "seafloor", ExtensionType::DDS);
-  hr = m_textureCube.init(m_device, "Assets/DuckTexture", ExtensionType::DDS);
+  // Textura provisional (tablero 2x2) hasta que llegue la del modelo.
+  const unsigned char checker[16] = {
+    255, 255, 255, 255,   128, 128, 128, 255,
+    128, 128, 128, 255,   255, 255, 255, 255 };
+  hr = m_placeholderTexture.init(m_device, checker, 2, 2, DXGI_FORMAT_R8G8B8A8_UNORM);
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
-      ("Failed to initialize texture Cube. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to initialize placeholder texture. HRESULT: %d", hr);
     return hr;
   }
 
@@ -244,19 +327,17 @@ void
 BaseApp::update(float deltaTime) {
 
   // Update our time
-  static float t = 0.0f;
-  if (m_swapChain.m_driverType == D3D_DRIVER_TYPE_REFERENCE)
-  {
-    t += (float)XM_PI * 0.0125f;
-  }
-  else
-  {
-    static DWORD dwTimeStart = 0;
-    DWORD dwTimeCur = GetTickCount();
-    if (dwTimeStart == 0)
-      dwTimeStart = dwTimeCur;
-    t = (dwTimeCur - dwTimeStart) / 1000.0f;
-  }
+  // Se guarda el estado del paso anterior para que render() pueda interpolar.
+  m_simulationTime += deltaTime;
+  m_previousYaw = m_currentYaw;
+  m_currentYaw = static_cast<float>(m_simulationTime);
+}
+
+void
+BaseApp::render(float alpha) {
+
+  // Estado interpolado entre los dos ltimos pasos de simulacin
+  float t = m_previousYaw + (m_currentYaw - m_previousYaw) * alpha;
 
   // Actualizar la matriz de proyeccin y vista
   cbNeverChanges.mView = XMMatrixTranspose(m_View);
@@ -302,32 +383,82 @@ BaseApp::update(float deltaTime) {
   cb.mWorld = XMMatrixTranspose(m_World);
   cb.vMeshColor = m_vMeshColor;
   m_cbChangesEveryFrame.update(m_deviceContext, nullptr, 0, nullptr, &cb, 0, 0);
-}
-
-void
-BaseApp::render() {
 
-  // Set Render Target View
-  float ClearColor[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
-  m_renderTargetView.render(m_deviceContext, m_depthStencilView, 1, ClearColor);
+  // El frame se describe como un grafo: el pase Forward escribe la
+  // profundidad (transitoria) y el back buffer (importado). compile() decide
+  // qu texturas crear o reciclar y execute() ejecuta los pases supervivientes.
+  m_frameGraph.reset();
+
+  D3D11_TEXTURE2D_DESC swapChainDesc;
+  m_backBuffer.texture.m_texture->GetDesc(&swapChainDesc);
+  FrameGraphTextureDesc backBufferDesc;
+  backBufferDesc.width = swapChainDesc.Width;
+  backBufferDesc.height = swapChainDesc.Height;
+  backBufferDesc.format = swapChainDesc.Format;
+  backBufferDesc.sampleCount = swapChainDesc.SampleDesc.Count;
+  backBufferDesc.sampleQuality = swapChainDesc.SampleDesc.Quality;
+  FrameGraphHandle backBuffer = m_frameGraph.importTexture("BackBuffer",
+                                                           backBufferDesc,
+                                                           &m_backBuffer,
+                                                           FRAME_GRAPH_ACCESS_PRESENT,
+                                                           FRAME_GRAPH_ACCESS_PRESENT);
+  FrameGraphHandle sceneDepth;
+
+  m_frameGraph.addPass("Forward",
+    [&](FrameGraphBuilder& builder) {
+      FrameGraphTextureDesc depthDesc = backBufferDesc;
+      depthDesc.format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+      depthDesc.sampleQuality = 0;
+      sceneDepth = builder.write(builder.createTexture("SceneDepth", depthDesc),
+                                 FRAME_GRAPH_ACCESS_DEPTH_WRITE);
+      backBuffer = builder.write(backBuffer, FRAME_GRAPH_ACCESS_RENDER_TARGET);
+    },
+    [&](FrameGraphPassContext& context) {
+      FrameGraphTextureD3D11* target = context.texture<FrameGraphTextureD3D11>(backBuffer);
+      FrameGraphTextureD3D11* depth = context.texture<FrameGraphTextureD3D11>(sceneDepth);
+
+      // Set Render Target View
+      float ClearColor[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
+      target->renderTargetView.render(m_deviceContext, depth->depthStencilView, 1, ClearColor);
+
+      // Set Viewport
+      m_viewport.render(m_deviceContext);
+
+      // Clear the depth buffer to 1.0 (max depth)
+      depth->depthStencilView.render(m_deviceContext);
+
+      drawScene(escala);
+    });
+
+  std::string error;
+  if (!m_frameGraph.compile(&error)) {
+    ERROR("BaseApp", "render", "Frame graph compilation failed: %s", error);
+    return;
+  }
+  if (!m_frameGraph.execute(m_frameGraphBackend)) {
+    ERROR("BaseApp", "render", "Frame graph execution failed");
+  }
 
   //
-  // Clear the depth buffer to 1.0 (max depth)
+  // Present our back buffer to our front buffer
   //
+  m_swapChain.present();
+}
 
-  // Set Viewport
-  m_viewport.render(m_deviceContext);
-
-  // Set depth stencil view
-  m_depthStencilView.render(m_deviceContext);
-
+void
+BaseApp::drawScene(float scale) {
   //Set shader program
-  m_shaderProgram.render(m_deviceContext);
+  m_shaderVariants.render(m_deviceContext, 0);
 
   // Render the cube
  // Asignar buffers Vertex e Index
-  m_vertexBuffer.render(m_deviceContext, 0, 1);
-  m_indexBuffer.render(m_deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
+  // Mientras el modelo no sea residente se dibuja el cubo provisional.
+  MeshAsset* model = m_assets.mesh(m_modelMesh);
+  Buffer& vertexBuffer = model ? model->vertexBuffer : m_placeholderVertexBuffer;
+  Buffer& indexBuffer = model ? model->indexBuffer : m_placeholderIndexBuffer;
+  int indexCount = model ? model->mesh.m_numIndex : m_placeholderMesh.m_numIndex;
+  vertexBuffer.render(m_deviceContext, 0, 1);
+  indexBuffer.render(m_deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
 
   // Asignar buffers constantes
   m_cbNeverChanges.render(m_deviceContext, 0, 1);
@@ -336,32 +467,50 @@ BaseApp::render() {
   m_cbChangesEveryFrame.render(m_deviceContext, 2, 1, true);
 
   // Asignar textura y sampler
-  m_textureCube.render(m_deviceContext, 0, 1);
+  Texture* texture = m_assets.texture(m_modelTexture);
+  (texture ? *texture : m_placeholderTexture).render(m_deviceContext, 0, 1);
+
+  // Tamao aproximado del modelo en pantalla (esfera envolvente proyectada) para
+  // decidir qu mips de su textura deben estar residentes.
+  if (model && m_modelRadius == 0.0f) {
+    for (const SimpleVertex& vertex : model->mesh.m_vertex) {
+      m_modelRadius = std::max(m_modelRadius, XMVectorGetX(XMVector3Length(XMLoadFloat3(&vertex.Pos))));
+    }
+  }
+  if (model) {
+    XMVECTOR eye = XMMatrixInverse(nullptr, m_View).r[3];
+    float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(eye, m_World.r[3])));
+    float screenPixels = m_modelRadius * scale * m_window.m_height /
+                         (std::max(distance, 0.01f) * tanf(XM_PIDIV4 * 0.5f));
+    m_assets.requestTextureDetail(m_modelTexture, screenPixels);
+  }
   m_samplerState.render(m_deviceContext, 0, 1);
-  m_deviceContext.DrawIndexed(m_mesh.m_numIndex, 0, 0);
-
-  //
-  // Present our back buffer to our front buffer
-  //
-  m_swapChain.present();
+  m_deviceContext.DrawIndexed(indexCount, 0, 0);
 }
 
 void
 BaseApp::destroy() {
+  // Primero se detienen las cargas y los hilos de trabajo: nada debe llegar tras liberar el dispositivo.
+  m_asyncLoader.destroy();
+  JobSystem::instance().destroy();
+  m_assets.release(m_modelMesh);
+  m_assets.release(m_modelTexture);
+  m_assets.destroy();
+
   if (m_deviceContext.m_deviceContext) m_deviceContext.m_deviceContext->ClearState();
 
   m_samplerState.destroy();
-  m_textureCube.destroy();
+  m_placeholderTexture.destroy();
+  m_placeholderVertexBuffer.destroy();
+  m_placeholderIndexBuffer.destroy();
 
   m_cbNeverChanges.destroy();
   m_cbChangeOnResize.destroy();
   m_cbChangesEveryFrame.destroy();
-  m_vertexBuffer.destroy();
-  m_indexBuffer.destroy();
-  m_shaderProgram.destroy();
-  m_depthStencil.destroy();
-  m_depthStencilView.destroy();
-  m_renderTargetView.destroy();
+  m_shaderVariants.destroy();
+  ShaderCache::instance().destroy();
+  VirtualFileSystem::instance().unmountAll();
+  m_frameGraph.destroy(m_frameGraphBackend);
   m_swapChain.destroy();
   m_backBuffer.destroy();
   m_deviceContext.destroy();
@@ -0,0 +1,1001 @@
+#include "BlockCompressor.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NAVI_BC_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+  const int kBlockPixels = 16;
+
+  /**
+   * @brief Bloque de 4x4 pxeles guardado por canal (R, G, B, A) en el rango 0..255.
+   */
+  struct
+  alignas(16) Block {
+    float channel[4][kBlockPixels];
+  };
+
+  /**
+   * @brief Paleta de un bloque: hasta 16 colores de 4 canales.
+   */
+  struct
+  Palette {
+    float color[16][4];
+    int size = 0;
+  };
+
+  /** @brief Pesos de interpolacin de BC7 para ndices de 4 bits. */
+  const int kBc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+  void
+  loadBlock(const uint8_t* rgba, unsigned int width, unsigned int height,
+            unsigned int blockX, unsigned int blockY, Block& block) {
+    for (int i = 0; i < kBlockPixels; ++i) {
+      unsigned int x = std::min(blockX * 4 + (i & 3), width - 1);
+      unsigned int y = std::min(blockY * 4 + (i >> 2), height - 1);
+      const uint8_t* pixel = rgba + (static_cast<size_t>(y) * width + x) * 4;
+      for (int c = 0; c < 4; ++c) {
+        block.channel[c][i] = pixel[c];
+      }
+    }
+  }
+
+  //
+  // Ncleos de 16 carriles: cada bloque se procesa en cuatro grupos de cuatro pxeles.
+  //
+  float
+  dot16(const float* x, const float* y) {
+#if defined(NAVI_BC_SSE)
+    __m128 sum = _mm_setzero_ps();
+    for (int i = 0; i < kBlockPixels; i += 4) {
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, sum);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+    float sum = 0.0f;
+    for (int i = 0; i < kBlockPixels; ++i) {
+      sum += x[i] * y[i];
+    }
+    return sum;
+#endif
+  }
+
+  /**
+   * @brief Asigna a cada pxel el color ms cercano de la paleta.
+   * @param channels Canales a comparar (1..4) empezando en @p first.
+   * @param skip Pxeles excluidos (se les asigna @p skipIndex), o nullptr.
+   * @return Error cuadrtico total de los pxeles no excluidos.
+   */
+  float
+  assignIndices(const Block& block, int first, int channels, const Palette& palette,
+                const bool* skip, int skipIndex, uint8_t* indices) {
+    float error = 0.0f;
+#if defined(NAVI_BC_SSE)
+    for (int i = 0; i < kBlockPixels; i += 4) {
+      __m128 bestDistance = _mm_set1_ps(3.4e38f);
+      __m128 bestIndex = _mm_setzero_ps();
+      for (int p = 0; p < palette.size; ++p) {
+        __m128 distance = _mm_setzero_ps();
+        for (int c = 0; c < channels; ++c) {
+          __m128 d = _mm_sub_ps(_mm_loadu_ps(block.channel[first + c] + i),
+                                _mm_set1_ps(palette.color[p][first + c]));
+          distance = _mm_add_ps(distance, _mm_mul_ps(d, d));
+        }
+        __m128 closer = _mm_cmplt_ps(distance, bestDistance);
+        bestDistance = _mm_or_ps(_mm_and_ps(closer, distance), _mm_andnot_ps(closer, bestDistance));
+        bestIndex = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(static_cast<float>(p))),
+                              _mm_andnot_ps(closer, bestIndex));
+      }
+      float distances[4];
+      float best[4];
+      _mm_storeu_ps(distances, bestDistance);
+      _mm_storeu_ps(best, bestIndex);
+      for (int lane = 0; lane < 4; ++lane) {
+        if (skip && skip[i + lane]) {
+          indices[i + lane] = static_cast<uint8_t>(skipIndex);
+          continue;
+        }
+        indices[i + lane] = static_cast<uint8_t>(best[lane]);
+        error += distances[lane];
+      }
+    }
+#else
+    for (int i = 0; i < kBlockPixels; ++i) {
+      if (skip && skip[i]) {
+        indices[i] = static_cast<uint8_t>(skipIndex);
+        continue;
+      }
+      float bestDistance = 3.4e38f;
+      int bestIndex = 0;
+      for (int p = 0; p < palette.size; ++p) {
+        float distance = 0.0f;
+        for (int c = 0; c < channels; ++c) {
+          float d = block.channel[first + c][i] - palette.color[p][first + c];
+          distance += d * d;
+        }
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          bestIndex = p;
+        }
+      }
+      indices[i] = static_cast<uint8_t>(bestIndex);
+      error += bestDistance;
+    }
+#endif
+    return error;
+  }
+
+  /**
+   * @brief Extremos del segmento que mejor aproxima el bloque.
+   *
+   * FAST usa las esquinas de la caja envolvente; el resto proyecta sobre el eje
+   * principal (iteracin de potencia sobre la covarianza).
+   */
+  void
+  fitEndpoints(const Block& block, int first, int channels, BlockQuality quality,
+               float* endpoint0, float* endpoint1) {
+    float minimum[4];
+    float maximum[4];
+    for (int c = 0; c < channels; ++c) {
+      const float* values = block.channel[first + c];
+      minimum[c] = *std::min_element(values, values + kBlockPixels);
+      maximum[c] = *std::max_element(values, values + kBlockPixels);
+    }
+    if (quality == BLOCK_QUALITY_FAST) {
+      for (int c = 0; c < channels; ++c) {
+        endpoint0[c] = minimum[c];
+        endpoint1[c] = maximum[c];
+      }
+      return;
+    }
+
+    alignas(16) float centered[4][kBlockPixels];
+    float mean[4];
+    for (int c = 0; c < channels; ++c) {
+      const float* values = block.channel[first + c];
+      float sum = 0.0f;
+      for (int i = 0; i < kBlockPixels; ++i) {
+        sum += values[i];
+      }
+      mean[c] = sum / kBlockPixels;
+      for (int i = 0; i < kBlockPixels; ++i) {
+        centered[c][i] = values[i] - mean[c];
+      }
+    }
+    float covariance[4][4];
+    for (int a = 0; a < channels; ++a) {
+      for (int b = a; b < channels; ++b) {
+        covariance[a][b] = covariance[b][a] = dot16(centered[a], centered[b]);
+      }
+    }
+
+    float axis[4];
+    for (int c = 0; c < channels; ++c) {
+      axis[c] = maximum[c] - minimum[c];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration) {
+      float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+      float length = 0.0f;
+      for (int a = 0; a < channels; ++a) {
+        for (int b = 0; b < channels; ++b) {
+          next[a] += covariance[a][b] * axis[b];
+        }
+        length = std::max(length, std::fabs(next[a]));
+      }
+      if (length < 1e-6f) {
+        break;
+      }
+      for (int c = 0; c < channels; ++c) {
+        axis[c] = next[c] / length;
+      }
+    }
+    float length = 0.0f;
+    for (int c = 0; c < channels; ++c) {
+      length += axis[c] * axis[c];
+    }
+    if (length < 1e-12f) {
+      for (int c = 0; c < channels; ++c) {
+        endpoint0[c] = endpoint1[c] = mean[c];
+      }
+      return;
+    }
+    length = std::sqrt(length);
+    for (int c = 0; c < channels; ++c) {
+      axis[c] /= length;
+    }
+
+    float lowest = 3.4e38f;
+    float highest = -3.4e38f;
+    for (int i = 0; i < kBlockPixels; ++i) {
+      float t = 0.0f;
+      for (int c = 0; c < channels; ++c) {
+        t += centered[c][i] * axis[c];
+      }
+      lowest = std::min(lowest, t);
+      highest = std::max(highest, t);
+    }
+    for (int c = 0; c < channels; ++c) {
+      endpoint0[c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * lowest));
+      endpoint1[c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * highest));
+    }
+  }
+
+  /**
+   * @brief Ajuste por mnimos cuadrados de los extremos dados los ndices.
+   * @param weights Peso hacia el extremo 1 de cada ndice.
+   * @return false si el sistema es singular (todos los pxeles en un extremo).
+   */
+  bool
+  refineEndpoints(const Block& block, int first, int channels, const uint8_t* indices,
+                  const float* weights, const bool* skip, float* endpoint0, float* endpoint1) {
+    float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f;
+    float alphaX[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float betaX[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < kBlockPixels; ++i) {
+      if (skip && skip[i]) {
+        continue;
+      }
+      float beta = weights[indices[i]];
+      float alpha = 1.0f - beta;
+      alpha2 += alpha * alpha;
+      beta2 += beta * beta;
+      alphaBeta += alpha * beta;
+      for (int c = 0; c < channels; ++c) {
+        alphaX[c] += alpha * block.channel[first + c][i];
+        betaX[c] += beta * block.channel[first + c][i];
+      }
+    }
+    float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+    if (std::fabs(determinant) < 1e-6f) {
+      return false;
+    }
+    for (int c = 0; c < channels; ++c) {
+      float a = (alphaX[c] * beta2 - betaX[c] * alphaBeta) / determinant;
+      float b = (betaX[c] * alpha2 - alphaX[c] * alphaBeta) / determinant;
+      endpoint0[c] = std::min(255.0f, std::max(0.0f, a));
+      endpoint1[c] = std::min(255.0f, std::max(0.0f, b));
+    }
+    return true;
+  }
+
+  int
+  refinementPasses(BlockQuality quality) {
+    return quality == BLOCK_QUALITY_FAST ? 0 : quality == BLOCK_QUALITY_NORMAL ? 1 : 3;
+  }
+
+  //
+  // BC1
+  //
+  uint16_t
+  packRgb565(const float* rgb) {
+    int r = static_cast<int>(rgb[0] * 31.0f / 255.0f + 0.5f);
+    int g = static_cast<int>(rgb[1] * 63.0f / 255.0f + 0.5f);
+    int b = static_cast<int>(rgb[2] * 31.0f / 255.0f + 0.5f);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+  }
+
+  void
+  unpackRgb565(uint16_t color, int* rgb) {
+    int r = (color >> 11) & 31;
+    int g = (color >> 5) & 63;
+    int b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+  }
+
+  /**
+   * @brief Paleta de BC1; con @p fourColor falso se usa el modo de 3 colores + transparente.
+   */
+  void
+  bc1Palette(uint16_t color0, uint16_t color1, bool fourColor, int rgba[4][4]) {
+    unpackRgb565(color0, rgba[0]);
+    unpackRgb565(color1, rgba[1]);
+    rgba[0][3] = rgba[1][3] = rgba[2][3] = rgba[3][3] = 255;
+    for (int c = 0; c < 3; ++c) {
+      if (fourColor) {
+        rgba[2][c] = (2 * rgba[0][c] + rgba[1][c]) / 3;
+        rgba[3][c] = (rgba[0][c] + 2 * rgba[1][c]) / 3;
+      }
+      else {
+        rgba[2][c] = (rgba[0][c] + rgba[1][c]) / 2;
+        rgba[3][c] = 0;
+      }
+    }
+    if (!fourColor) {
+      rgba[3][3] = 0;
+    }
+  }
+
+  /**
+   * @brief Codifica los colores con unos extremos dados y devuelve el error.
+   */
+  float
+  tryBc1(const Block& block, const float* endpoint0, const float* endpoint1, bool transparent,
+         const bool* skip, uint16_t& color0, uint16_t& color1, uint8_t* indices) {
+    color0 = packRgb565(endpoint0);
+    color1 = packRgb565(endpoint1);
+    // Modo de 4 colores: color0 > color1. Modo transparente: color0 <= color1.
+    if (transparent ? color0 > color1 : color0 < color1) {
+      std::swap(color0, color1);
+    }
+
+    int rgba[4][4];
+    bool fourColor = !transparent && color0 != color1;
+    bc1Palette(color0, color1, fourColor, rgba);
+    Palette palette;
+    palette.size = fourColor ? 4 : 3;
+    for (int p = 0; p < palette.size; ++p) {
+      for (int c = 0; c < 4; ++c) {
+        palette.color[p][c] = static_cast<float>(rgba[p][c]);
+      }
+    }
+    return assignIndices(block, 0, 3, palette, skip, 3, indices);
+  }
+
+  void
+  encodeBc1(const Block& block, BlockQuality quality, bool allowTransparent, uint8_t* out) {
+    bool skip[kBlockPixels];
+    bool transparent = false;
+    for (int i = 0; i < kBlockPixels; ++i) {
+      skip[i] = allowTransparent && block.channel[3][i] < 128.0f;
+      transparent = transparent || skip[i];
+    }
+
+    float endpoint0[4];
+    float endpoint1[4];
+    fitEndpoints(block, 0, 3, quality, endpoint0, endpoint1);
+
+    uint16_t bestColor0 = 0, bestColor1 = 0;
+    uint8_t bestIndices[kBlockPixels];
+    float bestError = tryBc1(block, endpoint0, endpoint1, transparent, skip,
+                             bestColor0, bestColor1, bestIndices);
+
+    for (int pass = 0; pass < refinementPasses(quality) && bestError > 0.0f; ++pass) {
+      bool fourColor = !transparent && bestColor0 != bestColor1;
+      static const float kFourWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+      static const float kThreeWeights[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+      if (!refineEndpoints(block, 0, 3, bestIndices, fourColor ? kFourWeights : kThreeWeights,
+                           skip, endpoint0, endpoint1)) {
+        break;
+      }
+      uint16_t color0, color1;
+      uint8_t indices[kBlockPixels];
+      float error = tryBc1(block, endpoint0, endpoint1, transparent, skip, color0, color1, indices);
+      if (error >= bestError) {
+        break;
+      }
+      bestError = error;
+      bestColor0 = color0;
+      bestColor1 = color1;
+      std::memcpy(bestIndices, indices, sizeof(indices));
+    }
+
+    uint32_t packed = 0;
+    for (int i = 0; i < kBlockPixels; ++i) {
+      packed |= static_cast<uint32_t>(bestIndices[i] & 3) << (i * 2);
+    }
+    out[0] = static_cast<uint8_t>(bestColor0);
+    out[1] = static_cast<uint8_t>(bestColor0 >> 8);
+    out[2] = static_cast<uint8_t>(bestColor1);
+    out[3] = static_cast<uint8_t>(bestColor1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+      out[4 + i] = static_cast<uint8_t>(packed >> (i * 8));
+    }
+  }
+
+  //
+  // BC4 (canal nico: R en BC4, alpha en BC3 y R y G en BC5)
+  //
+  void
+  bc4Palette(int value0, int value1, int palette[8]) {
+    palette[0] = value0;
+    palette[1] = value1;
+    if (value0 > value1) {
+      for (int i = 2; i < 8; ++i) {
+        palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+      }
+    }
+    else {
+      for (int i = 2; i < 6; ++i) {
+        palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+      }
+      palette[6] = 0;
+      palette[7] = 255;
+    }
+  }
+
+  float
+  tryBc4(const Block& block, int channel, int value0, int value1, uint8_t* indices) {
+    int values[8];
+    bc4Palette(value0, value1, values);
+    Palette palette;
+    palette.size = 8;
+    for (int p = 0; p < 8; ++p) {
+      palette.color[p][channel] = static_cast<float>(values[p]);
+    }
+    return assignIndices(block, channel, 1, palette, nullptr, 0, indices);
+  }
+
+  void
+  encodeBc4(const Block& block, int channel, BlockQuality quality, uint8_t* out) {
+    const float* values = block.channel[channel];
+    float minimum = *std::min_element(values, values + kBlockPixels);
+    float maximum = *std::max_element(values, values + kBlockPixels);
+
+    int bestValue0 = static_cast<int>(maximum + 0.5f);
+    int bestValue1 = static_cast<int>(minimum + 0.5f);
+    uint8_t bestIndices[kBlockPixels];
+    float bestError = tryBc4(block, channel, bestValue0, bestValue1, bestIndices);
+
+    // Refinamiento del modo de 8 valores (ndices 2..7 interpolan hacia value1).
+    static const float kWeights[8] = { 0.0f, 1.0f, 1.0f / 7, 2.0f / 7, 3.0f / 7, 4.0f / 7, 5.0f / 7, 6.0f / 7 };
+    for (int pass = 0; pass < refinementPasses(quality) && bestError > 0.0f && bestValue0 > bestValue1; ++pass) {
+      float endpoint0, endpoint1;
+      if (!refineEndpoints(block, channel, 1, bestIndices, kWeights, nullptr, &endpoint0, &endpoint1)) {
+        break;
+      }
+      int value0 = static_cast<int>(endpoint0 + 0.5f);
+      int value1 = static_cast<int>(endpoint1 + 0.5f);
+      if (value0 <= value1) {
+        break;
+      }
+      uint8_t indices[kBlockPixels];
+      float error = tryBc4(block, channel, value0, value1, indices);
+      if (error >= bestError) {
+        break;
+      }
+      bestError = error;
+      bestValue0 = value0;
+      bestValue1 = value1;
+      std::memcpy(bestIndices, indices, sizeof(indices));
+    }
+
+    // HIGH prueba adems el modo de 6 valores con 0 y 255 exactos, til para recortes de alpha.
+    if (quality == BLOCK_QUALITY_HIGH && bestError > 0.0f) {
+      float low = 255.0f;
+      float high = 0.0f;
+      for (int i = 0; i < kBlockPixels; ++i) {
+        if (values[i] > 0.5f && values[i] < 254.5f) {
+          low = std::min(low, values[i]);
+          high = std::max(high, values[i]);
+        }
+      }
+      if (low > high) {
+        low = high = 0.0f;
+      }
+      int value0 = static_cast<int>(low + 0.5f);
+      int value1 = static_cast<int>(high + 0.5f);
+      uint8_t indices[kBlockPixels];
+      float error = tryBc4(block, channel, value0, value1, indices);
+      if (error < bestError) {
+        bestError = error;
+        bestValue0 = value0;
+        bestValue1 = value1;
+        std::memcpy(bestIndices, indices, sizeof(indices));
+      }
+    }
+
+    uint64_t packed = 0;
+    for (int i = 0; i < kBlockPixels; ++i) {
+      packed |= static_cast<uint64_t>(bestIndices[i] & 7) << (i * 3);
+    }
+    out[0] = static_cast<uint8_t>(bestValue0);
+    out[1] = static_cast<uint8_t>(bestValue1);
+    for (int i = 0; i < 6; ++i) {
+      out[2 + i] = static_cast<uint8_t>(packed >> (i * 8));
+    }
+  }
+
+  //
+  // BC7 modo 6
+  //
+  /**
+   * @brief Escritor de bits de un bloque de 128 bits, empezando por el bit menos significativo.
+   */
+  struct
+  BitWriter {
+    uint8_t* data;
+    unsigned int position = 0;
+
+    explicit BitWriter(uint8_t* out) : data(out) { std::memset(out, 0, 16); }
+
+    void
+    write(uint32_t value, unsigned int bits) {
+      for (unsigned int i = 0; i < bits; ++i, ++position) {
+        data[position >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (position & 7));
+      }
+    }
+  };
+
+  /**
+   * @brief Lector de bits complementario de BitWriter.
+   */
+  struct
+  BitReader {
+    const uint8_t* data;
+    unsigned int position = 0;
+
+    explicit BitReader(const uint8_t* in) : data(in) {}
+
+    uint32_t
+    read(unsigned int bits) {
+      uint32_t value = 0;
+      for (unsigned int i = 0; i < bits; ++i, ++position) {
+        value |= static_cast<uint32_t>((data[position >> 3] >> (position & 7)) & 1) << i;
+      }
+      return value;
+    }
+  };
+
+  /**
+   * @brief Extremo de BC7 modo 6: 7 bits por canal ms un p-bit compartido.
+   */
+  struct
+  Bc7Endpoint {
+    int value[4];
+    int pbit;
+  };
+
+  Bc7Endpoint
+  quantizeBc7(const float* endpoint, int pbit) {
+    Bc7Endpoint result;
+    result.pbit = pbit;
+    for (int c = 0; c < 4; ++c) {
+      result.value[c] = std::min(127, std::max(0, static_cast<int>((endpoint[c] - pbit) * 0.5f + 0.5f)));
+    }
+    return result;
+  }
+
+  int
+  bc7Expand(const Bc7Endpoint& endpoint, int channel) {
+    return (endpoint.value[channel] << 1) | endpoint.pbit;
+  }
+
+  float
+  tryBc7(const Block& block, const Bc7Endpoint& endpoint0, const Bc7Endpoint& endpoint1, uint8_t* indices) {
+    Palette palette;
+    palette.size = 16;
+    for (int p = 0; p < 16; ++p) {
+      for (int c = 0; c < 4; ++c) {
+        int a = bc7Expand(endpoint0, c);
+        int b = bc7Expand(endpoint1, c);
+        palette.color[p][c] = static_cast<float>(((64 - kBc7Weights[p]) * a + kBc7Weights[p] * b + 32) >> 6);
+      }
+    }
+    return assignIndices(block, 0, 4, palette, nullptr, 0, indices);
+  }
+
+  /**
+   * @brief Busca los p-bits de un par de extremos (HIGH prueba las cuatro combinaciones).
+   */
+  float
+  searchBc7(const Block& block, const float* endpoint0, const float* endpoint1, BlockQuality quality,
+            Bc7Endpoint& best0, Bc7Endpoint& best1, uint8_t* bestIndices) {
+    float bestError = 3.4e38f;
+    for (int combination = 0; combination < 4; ++combination) {
+      int pbit0 = combination & 1;
+      int pbit1 = combination >> 1;
+      // Sin bsqueda exhaustiva, cada extremo toma el p-bit ms cercano a su media.
+      if (quality != BLOCK_QUALITY_HIGH) {
+        float mean0 = (endpoint0[0] + endpoint0[1] + endpoint0[2] + endpoint0[3]) * 0.25f;
+        float mean1 = (endpoint1[0] + endpoint1[1] + endpoint1[2] + endpoint1[3]) * 0.25f;
+        if (pbit0 != (static_cast<int>(mean0 + 0.5f) & 1) || pbit1 != (static_cast<int>(mean1 + 0.5f) & 1)) {
+          continue;
+        }
+      }
+      Bc7Endpoint candidate0 = quantizeBc7(endpoint0, pbit0);
+      Bc7Endpoint candidate1 = quantizeBc7(endpoint1, pbit1);
+      uint8_t indices[kBlockPixels];
+      float error = tryBc7(block, candidate0, candidate1, indices);
+      if (error < bestError) {
+        bestError = error;
+        best0 = candidate0;
+        best1 = candidate1;
+        std::memcpy(bestIndices, indices, sizeof(indices));
+      }
+    }
+    return bestError;
+  }
+
+  void
+  encodeBc7(const Block& block, BlockQuality quality, uint8_t* out) {
+    float endpoint0[4];
+    float endpoint1[4];
+    fitEndpoints(block, 0, 4, quality, endpoint0, endpoint1);
+
+    Bc7Endpoint best0, best1;
+    uint8_t bestIndices[kBlockPixels];
+    float bestError = searchBc7(block, endpoint0, endpoint1, quality, best0, best1, bestIndices);
+
+    static const float kWeights[16] = {
+      0.0f / 64, 4.0f / 64, 9.0f / 64, 13.0f / 64, 17.0f / 64, 21.0f / 64, 26.0f / 64, 30.0f / 64,
+      34.0f / 64, 38.0f / 64, 43.0f / 64, 47.0f / 64, 51.0f / 64, 55.0f / 64, 60.0f / 64, 64.0f / 64
+    };
+    for (int pass = 0; pass < refinementPasses(quality) && bestError > 0.0f; ++pass) {
+      if (!refineEndpoints(block, 0, 4, bestIndices, kWeights, nullptr, endpoint0, endpoint1)) {
+        break;
+      }
+      Bc7Endpoint candidate0, candidate1;
+      uint8_t indices[kBlockPixels];
+      float error = searchBc7(block, endpoint0, endpoint1, quality, candidate0, candidate1, indices);
+      if (error >= bestError) {
+        break;
+      }
+      bestError = error;
+      best0 = candidate0;
+      best1 = candidate1;
+      std::memcpy(bestIndices, indices, sizeof(indices));
+    }
+
+    // El bit alto del ndice del pxel 0 (anchor) es implcito y vale 0.
+    if (bestIndices[0] & 8) {
+      std::swap(best0, best1);
+      for (int i = 0; i < kBlockPixels; ++i) {
+        bestIndices[i] = static_cast<uint8_t>(15 - bestIndices[i]);
+      }
+    }
+
+    BitWriter writer(out);
+    writer.write(1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+      writer.write(static_cast<uint32_t>(best0.value[c]), 7);
+      writer.write(static_cast<uint32_t>(best1.value[c]), 7);
+    }
+    writer.write(static_cast<uint32_t>(best0.pbit), 1);
+    writer.write(static_cast<uint32_t>(best1.pbit), 1);
+    writer.write(bestIndices[0], 3);
+    for (int i = 1; i < kBlockPixels; ++i) {
+      writer.write(bestIndices[i], 4);
+    }
+  }
+
+  void
+  encodeBlock(const Block& block, BlockFormat format, BlockQuality quality, uint8_t* out) {
+    switch (format) {
+    case BLOCK_BC1:
+      encodeBc1(block, quality, true, out);
+      break;
+    case BLOCK_BC3:
+      encodeBc4(block, 3, quality, out);
+      encodeBc1(block, quality, false, out + 8);
+      break;
+    case BLOCK_BC4:
+      encodeBc4(block, 0, quality, out);
+      break;
+    case BLOCK_BC5:
+      encodeBc4(block, 0, quality, out);
+      encodeBc4(block, 1, quality, out + 8);
+      break;
+    case BLOCK_BC7:
+      encodeBc7(block, quality, out);
+      break;
+    default:
+      break;
+    }
+  }
+
+  //
+  // Decodificadores de referencia
+  //
+  void
+  decodeBc1(const uint8_t* in, bool forceFourColor, uint8_t pixels[16][4]) {
+    uint16_t color0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    uint16_t color1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+    int rgba[4][4];
+    bc1Palette(color0, color1, forceFourColor || color0 > color1, rgba);
+    uint32_t packed = static_cast<uint32_t>(in[4]) | (static_cast<uint32_t>(in[5]) << 8) |
+                      (static_cast<uint32_t>(in[6]) << 16) | (static_cast<uint32_t>(in[7]) << 24);
+    for (int i = 0; i < kBlockPixels; ++i) {
+      const int* color = rgba[(packed >> (i * 2)) & 3];
+      for (int c = 0; c < 4; ++c) {
+        pixels[i][c] = static_cast<uint8_t>(color[c]);
+      }
+    }
+  }
+
+  void
+  decodeBc4(const uint8_t* in, uint8_t pixels[16][4], int channel) {
+    int palette[8];
+    bc4Palette(in[0], in[1], palette);
+    uint64_t packed = 0;
+    for (int i = 0; i < 6; ++i) {
+      packed |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < kBlockPixels; ++i) {
+      pixels[i][channel] = static_cast<uint8_t>(palette[(packed >> (i * 3)) & 7]);
+    }
+  }
+
+  bool
+  decodeBc7(const uint8_t* in, uint8_t pixels[16][4]) {
+    BitReader reader(in);
+    if (reader.read(7) != (1u << 6)) {
+      return false;
+    }
+    Bc7Endpoint endpoint0, endpoint1;
+    for (int c = 0; c < 4; ++c) {
+      endpoint0.value[c] = static_cast<int>(reader.read(7));
+      endpoint1.value[c] = static_cast<int>(reader.read(7));
+    }
+    endpoint0.pbit = static_cast<int>(reader.read(1));
+    endpoint1.pbit = static_cast<int>(reader.read(1));
+    for (int i = 0; i < kBlockPixels; ++i) {
+      int weight = kBc7Weights[reader.read(i == 0 ? 3 : 4)];
+      for (int c = 0; c < 4; ++c) {
+        int a = bc7Expand(endpoint0, c);
+        int b = bc7Expand(endpoint1, c);
+        pixels[i][c] = static_cast<uint8_t>(((64 - weight) * a + weight * b + 32) >> 6);
+      }
+    }
+    return true;
+  }
+
+  void
+  putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+  }
+
+  uint32_t
+  fourCC(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+  }
+}
+
+size_t
+blockBytes(BlockFormat format) {
+  switch (format) {
+  case BLOCK_BC1:
+  case BLOCK_BC4:
+    return 8;
+  case BLOCK_BC3:
+  case BLOCK_BC5:
+  case BLOCK_BC7:
+    return 16;
+  default:
+    return 0;
+  }
+}
+
+size_t
+blockRowPitch(BlockFormat format, unsigned int width) {
+  return static_cast<size_t>((width + 3) / 4) * blockBytes(format);
+}
+
+size_t
+compressedSize(BlockFormat format, unsigned int width, unsigned int height) {
+  return blockRowPitch(format, width) * ((height + 3) / 4);
+}
+
+uint32_t
+dxgiFormatOf(BlockFormat format, bool srgb) {
+  switch (format) {
+  case BLOCK_NONE:
+    return srgb ? 29 : 28; // DXGI_FORMAT_R8G8B8A8_UNORM(_SRGB)
+  case BLOCK_BC1:
+    return srgb ? 72 : 71; // DXGI_FORMAT_BC1_UNORM(_SRGB)
+  case BLOCK_BC3:
+    return srgb ? 78 : 77; // DXGI_FORMAT_BC3_UNORM(_SRGB)
+  case BLOCK_BC4:
+    return 80;             // DXGI_FORMAT_BC4_UNORM
+  case BLOCK_BC5:
+    return 83;             // DXGI_FORMAT_BC5_UNORM
+  case BLOCK_BC7:
+    return srgb ? 99 : 98; // DXGI_FORMAT_BC7_UNORM(_SRGB)
+  }
+  return 0;
+}
+
+bool
+canBlockCompress(unsigned int width, unsigned int height) {
+  return width > 0 && height > 0 && width % 4 == 0 && height % 4 == 0;
+}
+
+bool
+compressImage(const uint8_t* rgba,
+              unsigned int width,
+              unsigned int height,
+              BlockFormat format,
+              BlockQuality quality,
+              std::vector<uint8_t>& blocks) {
+  NAVI_PROFILE_SCOPE("compressImage");
+  size_t bytesPerBlock = blockBytes(format);
+  if (!rgba || width == 0 || height == 0 || bytesPerBlock == 0) {
+    return false;
+  }
+
+  unsigned int blocksWide = (width + 3) / 4;
+  unsigned int blocksHigh = (height + 3) / 4;
+  blocks.resize(static_cast<size_t>(blocksWide) * blocksHigh * bytesPerBlock);
+  JobSystem::instance().parallelFor(0, blocksHigh, [&](size_t begin, size_t end) {
+    Block block;
+    for (size_t blockY = begin; blockY < end; ++blockY) {
+      uint8_t* out = blocks.data() + blockY * blocksWide * bytesPerBlock;
+      for (unsigned int blockX = 0; blockX < blocksWide; ++blockX) {
+        loadBlock(rgba, width, height, blockX, static_cast<unsigned int>(blockY), block);
+        encodeBlock(block, format, quality, out + blockX * bytesPerBlock);
+      }
+    }
+  });
+  return true;
+}
+
+bool
+compressMipChain(const MipChain& mips,
+                 BlockFormat format,
+                 BlockQuality quality,
+                 bool srgb,
+                 CompressedChain& chain) {
+  chain.format = format;
+  chain.srgb = srgb;
+  chain.levels.clear();
+  if (mips.levels.empty()) {
+    return false;
+  }
+  chain.levels.resize(mips.levels.size());
+  for (size_t i = 0; i < mips.levels.size(); ++i) {
+    const MipLevel& source = mips.levels[i];
+    CompressedLevel& target = chain.levels[i];
+    target.width = source.width;
+    target.height = source.height;
+    if (!compressImage(source.pixels.data(), source.width, source.height, format, quality, target.blocks)) {
+      chain.levels.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+decompressImage(const uint8_t* blocks,
+                unsigned int width,
+                unsigned int height,
+                BlockFormat format,
+                std::vector<uint8_t>& rgba) {
+  size_t bytesPerBlock = blockBytes(format);
+  if (!blocks || width == 0 || height == 0 || bytesPerBlock == 0) {
+    return false;
+  }
+
+  rgba.assign(static_cast<size_t>(width) * height * 4, 0);
+  unsigned int blocksWide = (width + 3) / 4;
+  unsigned int blocksHigh = (height + 3) / 4;
+  for (unsigned int blockY = 0; blockY < blocksHigh; ++blockY) {
+    for (unsigned int blockX = 0; blockX < blocksWide; ++blockX) {
+      const uint8_t* in = blocks + (static_cast<size_t>(blockY) * blocksWide + blockX) * bytesPerBlock;
+      uint8_t pixels[16][4] = {};
+      switch (format) {
+      case BLOCK_BC1:
+        decodeBc1(in, false, pixels);
+        break;
+      case BLOCK_BC3:
+        decodeBc1(in + 8, true, pixels);
+        decodeBc4(in, pixels, 3);
+        break;
+      case BLOCK_BC4:
+        decodeBc4(in, pixels, 0);
+        for (int i = 0; i < kBlockPixels; ++i) {
+          pixels[i][3] = 255;
+        }
+        break;
+      case BLOCK_BC5:
+        decodeBc4(in, pixels, 0);
+        decodeBc4(in + 8, pixels, 1);
+        for (int i = 0; i < kBlockPixels; ++i) {
+          pixels[i][3] = 255;
+        }
+        break;
+      case BLOCK_BC7:
+        if (!decodeBc7(in, pixels)) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+      }
+      for (int i = 0; i < kBlockPixels; ++i) {
+        unsigned int x = blockX * 4 + (i & 3);
+        unsigned int y = blockY * 4 + (i >> 2);
+        if (x < width && y < height) {
+          std::memcpy(&rgba[(static_cast<size_t>(y) * width + x) * 4], pixels[i], 4);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+double
+computePsnr(const uint8_t* reference,
+            const uint8_t* test,
+            size_t pixelCount,
+            unsigned int channelMask) {
+  double squaredError = 0.0;
+  size_t samples = 0;
+  for (size_t i = 0; i < pixelCount; ++i) {
+    for (int c = 0; c < 4; ++c) {
+      if (channelMask & (1u << c)) {
+        double d = static_cast<double>(reference[i * 4 + c]) - test[i * 4 + c];
+        squaredError += d * d;
+        ++samples;
+      }
+    }
+  }
+  if (samples == 0 || squaredError == 0.0) {
+    return 99.0;
+  }
+  double mse = squaredError / samples;
+  return std::min(99.0, 10.0 * std::log10(255.0 * 255.0 / mse));
+}
+
+bool
+writeDds(const CompressedChain& chain, std::vector<uint8_t>& out) {
+  if (chain.levels.empty() || blockBytes(chain.format) == 0) {
+    return false;
+  }
+
+  const uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PIXELFORMAT = 0x1000;
+  const uint32_t DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+  const uint32_t DDPF_FOURCC = 0x4;
+  const uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+
+  bool dx10 = chain.srgb || chain.format == BLOCK_BC7;
+  uint32_t code = dx10 ? fourCC('D', 'X', '1', '0')
+                : chain.format == BLOCK_BC1 ? fourCC('D', 'X', 'T', '1')
+                : chain.format == BLOCK_BC3 ? fourCC('D', 'X', 'T', '5')
+                : chain.format == BLOCK_BC4 ? fourCC('A', 'T', 'I', '1')
+                : fourCC('A', 'T', 'I', '2');
+  uint32_t mipCount = static_cast<uint32_t>(chain.levels.size());
+  const CompressedLevel& top = chain.levels[0];
+
+  out.clear();
+  out.reserve(148 + chain.byteSize());
+  putU32(out, fourCC('D', 'D', 'S', ' '));
+  putU32(out, 124);
+  putU32(out, DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE |
+              (mipCount > 1 ? DDSD_MIPMAPCOUNT : 0));
+  putU32(out, top.height);
+  putU32(out, top.width);
+  putU32(out, static_cast<uint32_t>(top.blocks.size()));
+  putU32(out, 0);
+  putU32(out, mipCount);
+  for (int i = 0; i < 11; ++i) {
+    putU32(out, 0);
+  }
+  // DDS_PIXELFORMAT
+  putU32(out, 32);
+  putU32(out, DDPF_FOURCC);
+  putU32(out, code);
+  for (int i = 0; i < 5; ++i) {
+    putU32(out, 0);
+  }
+  putU32(out, DDSCAPS_TEXTURE | (mipCount > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0));
+  for (int i = 0; i < 4; ++i) {
+    putU32(out, 0);
+  }
+  if (dx10) {
+    // DDS_HEADER_DXT10: formato, TEXTURE2D, sin flags, un elemento.
+    putU32(out, dxgiFormatOf(chain.format, chain.srgb));
+    putU32(out, 3);
+    putU32(out, 0);
+    putU32(out, 1);
+    putU32(out, 0);
+  }
+  for (const CompressedLevel& level : chain.levels) {
+    out.insert(out.end(), level.blocks.begin(), level.blocks.end());
+  }
+  return true;
+}
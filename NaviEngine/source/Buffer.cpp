@@ -1,7 +1,7 @@
 #include "Buffer.h"
 #include "Device.h"
 #include "DeviceContext.h"
-
+#include "Metrics.h"
 
 HRESULT
 Buffer::init(Device& device, const MeshComponent& mesh, unsigned int bindFlag) {
@@ -62,6 +62,53 @@ Buffer::init(Device& device, unsigned int ByteWidth) {
 	return createBuffer(device, desc, nullptr);
 }
 
+HRESULT
+Buffer::initDynamic(Device& device, unsigned int vertexCount, unsigned int stride) {
+	if (!device.m_device) {
+		ERROR("Buffer", "initDynamic", "Device is null.");
+		return E_POINTER;
+	}
+	if (vertexCount == 0 || stride == 0) {
+		ERROR("Buffer", "initDynamic", "Empty dynamic buffer (%u vertices of %u bytes)", vertexCount, stride);
+		return E_INVALIDARG;
+	}
+	m_stride = stride;
+	m_bindFlag = D3D11_BIND_VERTEX_BUFFER;
+	m_dynamicBytes = vertexCount * stride;
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.ByteWidth = m_dynamicBytes;
+	desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	return createBuffer(device, desc, nullptr);
+}
+
+void*
+Buffer::map(DeviceContext& deviceContext) {
+	if (!m_buffer || m_dynamicBytes == 0) {
+		ERROR("Buffer", "map", "Only dynamic buffers can be mapped.");
+		return nullptr;
+	}
+	D3D11_MAPPED_SUBRESOURCE mapped = {};
+	HRESULT hr = deviceContext.Map(m_buffer, 0, D3D11_MAP_WRITE_DISCARD, &mapped);
+	if (FAILED(hr)) {
+		ERROR("Buffer", "map", "Failed to map dynamic buffer. HRESULT: %d", hr);
+		return nullptr;
+	}
+	return mapped.pData;
+}
+
+void
+Buffer::unmap(DeviceContext& deviceContext) {
+	if (!m_buffer) {
+		return;
+	}
+	deviceContext.Unmap(m_buffer, 0);
+	EngineMetrics::bytesUploaded().add(m_dynamicBytes);
+}
+
 void
 Buffer::update(DeviceContext& deviceContext,
 							ID3D11Resource* pDstResource,
@@ -78,14 +125,25 @@ Buffer::update(DeviceContext& deviceContext,
 		ERROR("ShaderProgram", "update", "pSrcData is null.");
 		return;
 	}
-	deviceContext.m_deviceContext->UpdateSubresource(m_buffer,
+	deviceContext.UpdateSubresource(m_buffer,
 		DstSubresource,
 		pDstBox,
 		pSrcData,
 		SrcRowPitch,
 		SrcDepthPitch);
 
-
+	// En un bfer SrcRowPitch no es un tamao (suele valer 0): se cuenta el rango
+	// en bytes de la caja o, sin caja, el bfer entero.
+	unsigned int bytes = 0;
+	if (pDstBox) {
+		bytes = pDstBox->right - pDstBox->left;
+	}
+	else {
+		D3D11_BUFFER_DESC desc = {};
+		m_buffer->GetDesc(&desc);
+		bytes = desc.ByteWidth;
+	}
+	EngineMetrics::bytesUploaded().add(bytes);
 }
 
 void
@@ -105,16 +163,16 @@ Buffer::render(DeviceContext& deviceContext,
 
 	switch (m_bindFlag) {
 	case D3D11_BIND_VERTEX_BUFFER:
-		deviceContext.m_deviceContext->IASetVertexBuffers(StartSlot, NumBuffers, &m_buffer, &m_stride, &m_offset);
+		deviceContext.IASetVertexBuffers(StartSlot, NumBuffers, &m_buffer, &m_stride, &m_offset);
 		break;
 	case D3D11_BIND_CONSTANT_BUFFER:
-		deviceContext.m_deviceContext->VSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
+		deviceContext.VSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
 		if (setPixelShader) {
-			deviceContext.m_deviceContext->PSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
+			deviceContext.PSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
 		}
 		break;
 	case D3D11_BIND_INDEX_BUFFER:
-		deviceContext.m_deviceContext->IASetIndexBuffer(m_buffer, format, m_offset);
+		deviceContext.IASetIndexBuffer(m_buffer, format, m_offset);
 		break;
 	default:
 		ERROR("Buffer", "render", "Unsupported BindFlag");
@@ -0,0 +1,516 @@
+#include "ClusteredLights.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using namespace SimdMath;
+
+namespace {
+
+  /**
+   * @brief Carriles activos de cada mscara de 4 bits, en orden y de 16 en 16
+   *        bits (sumados a cuatro copias del primer tile dan sus clusters), y
+   *        cuntos son.
+   */
+  const uint64_t kPackedLanes[16] = {
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000001ull, 0x0000000000010000ull,
+    0x0000000000000002ull, 0x0000000000020000ull, 0x0000000000020001ull, 0x0000000200010000ull,
+    0x0000000000000003ull, 0x0000000000030000ull, 0x0000000000030001ull, 0x0000000300010000ull,
+    0x0000000000030002ull, 0x0000000300020000ull, 0x0000000300020001ull, 0x0003000200010000ull
+  };
+
+  const unsigned char kLaneCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+  /**
+   * @brief Cuatro copias de 1 en los carriles de 16 bits de kPackedLanes.
+   */
+  const uint64_t kLaneStep = 0x0001000100010001ull;
+
+  /**
+   * @brief Holgura relativa del alcance en los descartes por intervalo.
+   *
+   * Si la esfera toca la caja, cada eje por separado queda a menos de
+   * range * (1 + 2^-23) de ella aun con el redondeo de la prueba exacta; con
+   * esta holgura los descartes previos nunca quitan algo que la prueba acepte.
+   */
+  const float kReachSlack = 1.001f;
+
+  void
+  expand(Aabb& box, const Aabb& other) {
+    box.min.x = (std::min)(box.min.x, other.min.x);
+    box.min.y = (std::min)(box.min.y, other.min.y);
+    box.min.z = (std::min)(box.min.z, other.min.z);
+    box.max.x = (std::max)(box.max.x, other.max.x);
+    box.max.y = (std::max)(box.max.y, other.max.y);
+    box.max.z = (std::max)(box.max.z, other.max.z);
+  }
+
+  /**
+   * @brief Margen, en tiles, de los rangos de columnas y filas de assignSlice().
+   *
+   * Cubre el redondeo de la conversin a unidades de tile frente a los lmites
+   * de init(), del orden de tiles * 1e-6: un rango nunca deja fuera un tile
+   * que la prueba exacta aceptara.
+   */
+  const float kTileSlack = 1e-3f;
+
+  /**
+   * @brief Si la esfera de radio @p reach alrededor de @p position toca la caja.
+   *
+   * Con vectores en vez de seis comparaciones encadenadas: las luces cerca de
+   * los bordes del frustum hacen impredecibles los saltos.
+   */
+  inline bool
+  overlaps(const Aabb& box, Vector position, Vector reach) {
+    return (lessOrEqualMask(subtract(loadFloat3(&box.min), position), reach) &
+            lessOrEqualMask(subtract(position, loadFloat3(&box.max)), reach)) == 0xF;
+  }
+
+}
+
+// ---------------------------------------------------------------------------
+// TileLanes
+// ---------------------------------------------------------------------------
+
+void
+ClusteredLights::TileLanes::resize(unsigned int slices, unsigned int rows,
+                                   unsigned int columnStride, unsigned int rowStride) {
+  minX.assign(static_cast<size_t>(slices) * columnStride, std::numeric_limits<float>::infinity());
+  maxX.assign(static_cast<size_t>(slices) * columnStride, 0.0f);
+  centerX.assign(static_cast<size_t>(slices) * columnStride, 0.0f);
+  minY.assign(static_cast<size_t>(slices) * rowStride, std::numeric_limits<float>::infinity());
+  maxY.assign(static_cast<size_t>(slices) * rowStride, 0.0f);
+  centerY.assign(static_cast<size_t>(slices) * rowStride, 0.0f);
+  radius.assign(static_cast<size_t>(slices) * rows * columnStride, 0.0f);
+}
+
+void
+ClusteredLights::AxisTerms::resize(size_t count) {
+  distanceSq.resize(count);
+  lengthSq.resize(count);
+  along.resize(count);
+}
+
+// ---------------------------------------------------------------------------
+// ClusteredLights
+// ---------------------------------------------------------------------------
+
+bool
+ClusteredLights::init(const ClusterGridDesc& desc, std::string* error) {
+  const char* problem = nullptr;
+  if (desc.tilesX == 0 || desc.tilesY == 0 || desc.slices == 0) {
+    problem = "the cluster grid needs at least one tile and one slice";
+  }
+  else if (!(desc.nearZ > 0.0f) || !(desc.farZ > desc.nearZ)) {
+    problem = "the depth range must satisfy 0 < near < far";
+  }
+  else if (!(desc.fovY > 0.0f) || !(desc.fovY < 3.14159f) || !(desc.aspect > 0.0f)) {
+    problem = "invalid field of view or aspect ratio";
+  }
+  else if (static_cast<uint64_t>(desc.tilesX) * desc.tilesY > 0x10000u) {
+    problem = "the cluster grid allows at most 65536 tiles per slice";
+  }
+  else if (desc.maxLightIndices == 0 || desc.maxLightIndices > 0xFFFFFFFFu) {
+    problem = "maxLightIndices must fit in 32 bits";
+  }
+  if (problem) {
+    if (error) {
+      *error = problem;
+    }
+    return false;
+  }
+  m_desc = desc;
+
+  // Cortes exponenciales: cada uno cubre la misma proporcin de profundidad,
+  // de modo que los clusters cercanos no son lminas finsimas.
+  double depthRatio = std::log2(static_cast<double>(desc.farZ) / desc.nearZ);
+  m_sliceScale = static_cast<float>(desc.slices / depthRatio);
+  m_sliceBias = static_cast<float>(-static_cast<double>(desc.slices) * std::log2(static_cast<double>(desc.nearZ)) / depthRatio);
+
+  float tanY = std::tan(desc.fovY * 0.5f);
+  float tanX = tanY * desc.aspect;
+  m_tanX = tanX;
+  m_tanY = tanY;
+  // Relleno para leer de ocho en ocho columnas y de cuatro en cuatro filas
+  // desde la primera a su alcance (ver assignSlice()).
+  m_columnStride = desc.tilesX + 10;
+  m_rowStride = desc.tilesY + 3;
+  m_clusterBounds.resize(clusterCount());
+  m_tiles.resize(desc.slices, desc.tilesY, m_columnStride, m_rowStride);
+  m_sliceBounds.resize(desc.slices);
+
+  for (unsigned int s = 0; s < desc.slices; ++s) {
+    float depths[2] = {
+      static_cast<float>(desc.nearZ * std::pow(static_cast<double>(desc.farZ) / desc.nearZ,
+                                               static_cast<double>(s) / desc.slices)),
+      static_cast<float>(desc.nearZ * std::pow(static_cast<double>(desc.farZ) / desc.nearZ,
+                                               static_cast<double>(s + 1) / desc.slices))
+    };
+    if (s + 1 == desc.slices) {
+      depths[1] = desc.farZ;
+    }
+
+    for (unsigned int ty = 0; ty < desc.tilesY; ++ty) {
+      // La fila 0 es la superior de la pantalla (y NDC = 1).
+      float ndcY[2] = { 1.0f - 2.0f * ty / desc.tilesY, 1.0f - 2.0f * (ty + 1) / desc.tilesY };
+      for (unsigned int tx = 0; tx < desc.tilesX; ++tx) {
+        float ndcX[2] = { -1.0f + 2.0f * tx / desc.tilesX, -1.0f + 2.0f * (tx + 1) / desc.tilesX };
+
+        // Las caras del froxel son planos: basta con sus 8 esquinas.
+        Aabb box = { { 1e30f, 1e30f, depths[0] }, { -1e30f, -1e30f, depths[1] } };
+        for (float depth : depths) {
+          for (float nx : ndcX) {
+            box.min.x = (std::min)(box.min.x, nx * tanX * depth);
+            box.max.x = (std::max)(box.max.x, nx * tanX * depth);
+          }
+          for (float ny : ndcY) {
+            box.min.y = (std::min)(box.min.y, ny * tanY * depth);
+            box.max.y = (std::max)(box.max.y, ny * tanY * depth);
+          }
+        }
+
+        unsigned int cluster = clusterIndex(tx, ty, s);
+        m_clusterBounds[cluster] = box;
+        float hx = (box.max.x - box.min.x) * 0.5f;
+        float hy = (box.max.y - box.min.y) * 0.5f;
+        float hz = (box.max.z - box.min.z) * 0.5f;
+
+        size_t column = static_cast<size_t>(s) * m_columnStride + tx;
+        size_t row = static_cast<size_t>(s) * m_rowStride + ty;
+        m_tiles.minX[column] = box.min.x;
+        m_tiles.maxX[column] = box.max.x;
+        m_tiles.centerX[column] = box.min.x + hx;
+        m_tiles.minY[row] = box.min.y;
+        m_tiles.maxY[row] = box.max.y;
+        m_tiles.centerY[row] = box.min.y + hy;
+        m_tiles.radius[(static_cast<size_t>(s) * desc.tilesY + ty) * m_columnStride + tx] =
+          std::sqrt(hx * hx + hy * hy + hz * hz);
+
+        if (tx == 0 && ty == 0) {
+          m_sliceBounds[s] = box;
+        }
+        else {
+          expand(m_sliceBounds[s], box);
+        }
+      }
+    }
+  }
+
+  // Fondos de los cortes para la bsqueda de assign(), de cuatro en cuatro y
+  // rellenos con infinito.
+  m_sliceFar.assign((desc.slices + 3) / 4 * 4, std::numeric_limits<float>::infinity());
+  for (unsigned int s = 0; s < desc.slices; ++s) {
+    m_sliceFar[s] = m_sliceBounds[s].max.z;
+  }
+
+  m_work.resize(desc.slices);
+  for (SliceWork& work : m_work) {
+    work.columns.resize(m_columnStride);
+    work.rows.resize(m_rowStride);
+  }
+  m_ranges.assign(clusterCount(), ClusterRange());
+  m_lightIndices.clear();
+  m_stats = ClusterStats();
+  return true;
+}
+
+int
+ClusteredLights::slice(float viewZ) const {
+  if (!(viewZ > 0.0f)) {
+    return -1;
+  }
+  return static_cast<int>(std::floor(std::log2(viewZ) * m_sliceScale + m_sliceBias));
+}
+
+void
+ClusteredLights::assign(const ClusterLight* lights, size_t count, const Matrix& view, bool parallel) {
+  m_stats = ClusterStats();
+  m_stats.lights = count;
+  m_lightIndices.clear();
+  if (m_work.empty()) {
+    return;
+  }
+  for (SliceWork& work : m_work) {
+    work.lights.clear();
+  }
+
+  // Luces a espacio de vista y, en la misma pasada, recorte contra el frustum:
+  // cada luz se apunta solo en los cortes cuya caja alcanza.
+  m_viewLights.resize(count);
+  const size_t sliceSearch = m_sliceFar.size();
+  for (size_t i = 0; i < count; ++i) {
+    const ClusterLight& light = lights[i];
+    Float3 position;
+    Float3 direction;
+    storeFloat3(&position, transformPoint(loadFloat3(&light.position), view));
+    storeFloat3(&direction, transformNormal(loadFloat3(&light.direction), view));
+    bool spot = light.type == CLUSTER_LIGHT_SPOT;
+    float cosine = spot ? (std::max)(-1.0f, (std::min)(1.0f, light.spotCosine)) : -1.0f;
+
+    ViewLight& viewLight = m_viewLights[i];
+    viewLight.x = position.x;
+    viewLight.y = position.y;
+    viewLight.z = position.z;
+    viewLight.radiusSq = light.range > 0.0f ? light.range * light.range : -1.0f;
+    viewLight.reach = light.range * kReachSlack;
+    viewLight.spot = spot ? 1 : 0;
+    viewLight.dirX = direction.x;
+    viewLight.dirY = direction.y;
+    viewLight.dirZ = direction.z;
+    viewLight.cosine = cosine;
+    viewLight.sine = std::sqrt(1.0f - cosine * cosine);
+    viewLight.range = light.range;
+
+    if (!(light.range > 0.0f)) {
+      continue;
+    }
+    // Primer corte cuyo fondo alcanza: los fondos crecen, as que es el nmero
+    // de cortes que quedan por delante (se cuentan de cuatro en cuatro sin
+    // saltos; el relleno con infinito nunca cuenta). Desde l, los cortes cuyo
+    // frente alcanza.
+    float reach = viewLight.reach;
+    Vector center = loadFloat3(&position);
+    Vector depth = splat(position.z);
+    Vector reachLanes = splat(reach);
+    unsigned int s = 0;
+    for (size_t k = 0; k < sliceSearch; k += 4) {
+      s += kLaneCount[greaterMask(subtract(depth, load(&m_sliceFar[k])), reachLanes)];
+    }
+    for (; s < m_desc.slices && m_sliceBounds[s].min.z - position.z <= reach; ++s) {
+      if (overlaps(m_sliceBounds[s], center, reachLanes)) {
+        m_work[s].lights.push_back(static_cast<uint32_t>(i));
+      }
+    }
+  }
+
+  // Cada corte escribe sus rangos y su propia lista: no hay nada compartido.
+  if (parallel) {
+    JobSystem::instance().parallelFor(0, m_desc.slices, [this](size_t begin, size_t end) {
+      for (size_t s = begin; s < end; ++s) {
+        assignSlice(static_cast<unsigned int>(s));
+      }
+    }, 1);
+  }
+  else {
+    for (unsigned int s = 0; s < m_desc.slices; ++s) {
+      assignSlice(s);
+    }
+  }
+
+  // Compactacin: las listas de los cortes se concatenan en orden y los
+  // offsets locales pasan a ser globales. Lo que no cabe se descarta por
+  // clusters enteros del final de la lista.
+  unsigned int clustersPerSlice = m_desc.tilesX * m_desc.tilesY;
+  size_t total = 0;
+  for (const SliceWork& work : m_work) {
+    total += work.indices.size();
+  }
+  m_lightIndices.resize((std::min)(total, m_desc.maxLightIndices));
+
+  size_t base = 0;
+  for (unsigned int s = 0; s < m_desc.slices; ++s) {
+    const SliceWork& work = m_work[s];
+    size_t used = work.indices.size();
+    for (unsigned int c = 0; c < clustersPerSlice; ++c) {
+      ClusterRange& range = m_ranges[s * clustersPerSlice + c];
+      if (base + range.offset + range.count > m_lightIndices.size()) {
+        used = (std::min)(used, static_cast<size_t>(range.offset));
+        m_stats.droppedIndices += range.count;
+        range = ClusterRange();
+        continue;
+      }
+      if (range.count > 0) {
+        ++m_stats.occupiedClusters;
+        m_stats.maxLightsPerCluster = (std::max)(m_stats.maxLightsPerCluster, range.count);
+      }
+      range.offset += static_cast<uint32_t>(base);
+    }
+    std::copy(work.indices.begin(), work.indices.begin() + used, m_lightIndices.begin() + base);
+    base += used;
+  }
+  m_lightIndices.resize(base);
+  m_stats.lightIndices = base;
+}
+
+void
+ClusteredLights::assignSlice(unsigned int slice) {
+  SliceWork& work = m_work[slice];
+
+  const unsigned int tilesX = m_desc.tilesX;
+  const unsigned int tilesY = m_desc.tilesY;
+  const unsigned int columnStride = m_columnStride;
+  const Vector zeroLanes = zero();
+
+  // De vista a unidades de tile en el frente y el fondo del corte. Un borde
+  // de la luz cae en tiles distintos segn la profundidad; el rango de
+  // columnas (y de filas) toma en cada lado el ms alejado de los dos.
+  const Aabb& sliceBox = m_sliceBounds[slice];
+  const float depths[2] = { sliceBox.min.z, sliceBox.max.z };
+  const float centerZ = sliceBox.min.z + (sliceBox.max.z - sliceBox.min.z) * 0.5f;
+  const float halfX = 0.5f * static_cast<float>(tilesX);
+  const float halfY = 0.5f * static_cast<float>(tilesY);
+  const float scaleX[2] = { halfX / (m_tanX * depths[0]), halfX / (m_tanX * depths[1]) };
+  const float scaleY[2] = { halfY / (m_tanY * depths[0]), halfY / (m_tanY * depths[1]) };
+  const Vector nearScale = set(scaleX[0], scaleX[0], scaleY[0], scaleY[0]);
+  const Vector farScale = set(scaleX[1], scaleX[1], scaleY[1], scaleY[1]);
+  const Vector halfTiles = set(halfX, halfX, halfY, halfY);
+  const Vector tileSigns = set(1.0f, -1.0f, 1.0f, -1.0f);
+  const Vector tileSlack = set(-kTileSlack, kTileSlack, -kTileSlack, kTileSlack);
+  const Vector lastTiles = set(static_cast<float>(tilesX - 1), static_cast<float>(tilesX - 1),
+                               static_cast<float>(tilesY - 1), static_cast<float>(tilesY - 1));
+
+  // Tablas del corte; las escrituras de aciertos no se solapan con ellas.
+  const float* minX = m_tiles.minX.data() + static_cast<size_t>(slice) * columnStride;
+  const float* maxX = m_tiles.maxX.data() + static_cast<size_t>(slice) * columnStride;
+  const float* centerX = m_tiles.centerX.data() + static_cast<size_t>(slice) * columnStride;
+  const float* minY = m_tiles.minY.data() + static_cast<size_t>(slice) * m_rowStride;
+  const float* maxY = m_tiles.maxY.data() + static_cast<size_t>(slice) * m_rowStride;
+  const float* centerY = m_tiles.centerY.data() + static_cast<size_t>(slice) * m_rowStride;
+  const float* radii = m_tiles.radius.data() + static_cast<size_t>(slice) * tilesY * columnStride;
+  float* columnDistanceSq = work.columns.distanceSq.data();
+  float* columnLengthSq = work.columns.lengthSq.data();
+  float* columnAlong = work.columns.along.data();
+  float* rowDistanceSq = work.rows.distanceSq.data();
+  float* rowLengthSq = work.rows.lengthSq.data();
+  float* rowAlong = work.rows.along.data();
+
+  size_t written = 0;
+  for (uint32_t light : work.lights) {
+    const ViewLight& viewLight = m_viewLights[light];
+    float x = viewLight.x;
+    float y = viewLight.y;
+    float z = viewLight.z;
+    float reach = viewLight.reach;
+
+    // Columnas y filas a su alcance (las columnas crecen con x y las filas
+    // decrecen con y; la fila 0 es la superior).
+    float left = x - reach;
+    float right = x + reach;
+    float top = y + reach;
+    float bottom = y - reach;
+    // Los cuatro bordes a la vez y sin saltos: los que buscan el mximo van
+    // con el signo cambiado para tomar tambin el mnimo de los dos productos.
+    Vector edges = set(left, -right, -top, bottom);
+    Vector tiles = add(add(halfTiles, multiply(minimum(multiply(edges, nearScale), multiply(edges, farScale)),
+                                               tileSigns)), tileSlack);
+    float tileLanes[4];
+    store(tileLanes, minimum(maximum(tiles, zeroLanes), lastTiles));
+    unsigned int firstX = static_cast<unsigned int>(tileLanes[0]);
+    unsigned int lastX = static_cast<unsigned int>(tileLanes[1]);
+    unsigned int firstY = static_cast<unsigned int>(tileLanes[2]);
+    unsigned int lastY = static_cast<unsigned int>(tileLanes[3]);
+
+    // Ventanas de cuatro tiles desde firstX; cada una escribe cuatro aciertos
+    // aunque acepte menos.
+    unsigned int windows = (lastX - firstX) / 4 + 1;
+    unsigned int rows = lastY - firstY + 1;
+    unsigned int pairs = rows * windows;
+    if (work.hitLights.size() < written + pairs * 4) {
+      work.hitLights.resize((std::max)(written + pairs * 4, work.hitLights.size() * 2));
+      work.hitClusters.resize(work.hitLights.size());
+    }
+    uint16_t* hitClusters = work.hitClusters.data();
+    uint32_t* hitLights = work.hitLights.data();
+
+    // Prueba exacta de la luz contra cuatro tiles a la vez, con las mismas
+    // operaciones en el mismo orden que la prueba escalar. Como la caja se
+    // separa por ejes, los trminos en x se calculan una vez por columna (de
+    // ocho en ocho; las de relleno, con mnimo infinito, nunca aceptan), los
+    // de y una vez por fila (de cuatro en cuatro) y los de z una por corte.
+    Vector cx = splat(x);
+    Vector cy = splat(y);
+    Vector dirX = splat(viewLight.dirX);
+    Vector dirY = splat(viewLight.dirY);
+    auto columnTerms = [&](unsigned int w) {
+      Vector dx = add(maximum(subtract(load(minX + firstX + w), cx), zeroLanes),
+                      maximum(subtract(cx, load(maxX + firstX + w)), zeroLanes));
+      Vector vx = subtract(load(centerX + firstX + w), cx);
+      store(columnDistanceSq + w, multiply(dx, dx));
+      store(columnLengthSq + w, multiply(vx, vx));
+      store(columnAlong + w, multiply(vx, dirX));
+    };
+    for (unsigned int w = 0; w < windows * 4; w += 8) {
+      columnTerms(w);
+      columnTerms(w + 4);
+    }
+    for (unsigned int r = 0; r < rows; r += 4) {
+      unsigned int row = firstY + r;
+      Vector dy = add(maximum(subtract(load(minY + row), cy), zeroLanes),
+                      maximum(subtract(cy, load(maxY + row)), zeroLanes));
+      Vector vy = subtract(load(centerY + row), cy);
+      store(rowDistanceSq + r, multiply(dy, dy));
+      store(rowLengthSq + r, multiply(vy, vy));
+      store(rowAlong + r, multiply(vy, dirY));
+    }
+    Vector outside = maximum(subtract(set(depths[0], z, 0.0f, 0.0f), set(z, depths[1], 0.0f, 0.0f)), zeroLanes);
+    float dz = getX(outside) + getY(outside);
+    float vz = centerZ - z;
+    Vector dzSq = splat(dz * dz);
+    Vector vzSq = splat(vz * vz);
+    Vector vzAlong = splat(vz * viewLight.dirZ);
+    Vector radiusSq = splat(viewLight.radiusSq);
+    uint64_t lightPair = light * 0x0000000100000001ull;
+
+    // Un solo bucle por los pares (fila, ventana) a su alcance, con una
+    // versin para focos y otra para luces puntuales.
+    auto testPairs = [&](auto spotLight) {
+      unsigned int r = 0;
+      unsigned int w = 0;
+      for (unsigned int pair = 0; pair < pairs; ++pair) {
+        Vector distanceSq = add(add(load(columnDistanceSq + w), splat(rowDistanceSq[r])), dzSq);
+        int mask = lessOrEqualMask(distanceSq, radiusSq);
+        if constexpr (decltype(spotLight)::value) {
+          // Prueba de cono contra esfera: se descarta si la esfera queda fuera
+          // del ngulo, ms all del alcance o detrs del foco.
+          Vector radius = load(radii + (firstY + r) * columnStride + firstX + w);
+          Vector lengthSq = add(add(load(columnLengthSq + w), splat(rowLengthSq[r])), vzSq);
+          Vector along = add(add(load(columnAlong + w), splat(rowAlong[r])), vzAlong);
+          Vector across = sqrt(maximum(subtract(lengthSq, multiply(along, along)), zeroLanes));
+          Vector closest = subtract(multiply(splat(viewLight.cosine), across),
+                                    multiply(along, splat(viewLight.sine)));
+          mask &= lessOrEqualMask(closest, radius) &
+                  lessOrEqualMask(along, add(radius, splat(viewLight.range))) &
+                  lessOrEqualMask(negate(radius), along);
+        }
+        uint64_t clusters = ((firstY + r) * tilesX + firstX + w) * kLaneStep + kPackedLanes[mask];
+        std::memcpy(hitClusters + written, &clusters, sizeof(clusters));
+        std::memcpy(hitLights + written, &lightPair, sizeof(lightPair));
+        std::memcpy(hitLights + written + 2, &lightPair, sizeof(lightPair));
+        written += kLaneCount[mask];
+
+        bool nextRow = w + 4 >= windows * 4;
+        w = nextRow ? 0 : w + 4;
+        r += nextRow ? 1 : 0;
+      }
+    };
+    if (viewLight.spot) {
+      testPairs(std::true_type());
+    }
+    else {
+      testPairs(std::false_type());
+    }
+  }
+
+  // Los aciertos salen en orden de luz; se reparten por cluster conservando
+  // ese orden (ordenacin por recuento, llenando cada rango desde el final).
+  ClusterRange* ranges = &m_ranges[clusterIndex(0, 0, slice)];
+  const unsigned int clusters = tilesX * tilesY;
+  std::fill(ranges, ranges + clusters, ClusterRange());
+  const uint16_t* hitClusters = work.hitClusters.data();
+  const uint32_t* hitLights = work.hitLights.data();
+  for (size_t i = 0; i < written; ++i) {
+    ++ranges[hitClusters[i]].count;
+  }
+  uint32_t end = 0;
+  for (unsigned int c = 0; c < clusters; ++c) {
+    end += ranges[c].count;
+    ranges[c].offset = end;
+  }
+  work.indices.resize(end);
+  for (size_t i = written; i-- > 0;) {
+    work.indices[--ranges[hitClusters[i]].offset] = hitLights[i];
+  }
+}
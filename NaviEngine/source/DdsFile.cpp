@@ -0,0 +1,322 @@
+#include "DdsFile.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+  const uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+  const uint32_t DDPF_ALPHA = 0x2;
+  const uint32_t DDPF_FOURCC = 0x4;
+  const uint32_t DDPF_RGB = 0x40;
+  const uint32_t DDPF_LUMINANCE = 0x20000;
+  const uint32_t DDPF_BUMPDUDV = 0x80000;
+  const uint32_t DDSCAPS2_CUBEMAP = 0x200;
+  const uint32_t DDSCAPS2_CUBEMAP_ALLFACES = 0xFC00;
+  const uint32_t DDSCAPS2_VOLUME = 0x200000;
+  const uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+  /**
+   * @brief DDS_PIXELFORMAT tal como est en el archivo.
+   */
+  struct
+  PixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t bitCount;
+    uint32_t redMask;
+    uint32_t greenMask;
+    uint32_t blueMask;
+    uint32_t alphaMask;
+  };
+
+  /**
+   * @brief DDS_HEADER (124 bytes) tal como est en el archivo.
+   */
+  struct
+  Header {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];
+    PixelFormat pixelFormat;
+    uint32_t caps;
+    uint32_t caps2;
+    uint32_t caps3;
+    uint32_t caps4;
+    uint32_t reserved2;
+  };
+
+  /**
+   * @brief DDS_HEADER_DXT10 (extensin DX10).
+   */
+  struct
+  HeaderDx10 {
+    uint32_t dxgiFormat;
+    uint32_t resourceDimension;
+    uint32_t miscFlag;
+    uint32_t arraySize;
+    uint32_t miscFlags2;
+  };
+
+  static_assert(sizeof(Header) == 124, "DDS_HEADER must be 124 bytes");
+  static_assert(sizeof(HeaderDx10) == 20, "DDS_HEADER_DXT10 must be 20 bytes");
+
+  constexpr uint32_t
+  fourCC(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+  }
+
+  bool
+  fail(std::string* error, const char* message) {
+    if (error) {
+      *error = message;
+    }
+    return false;
+  }
+
+  bool
+  hasMasks(const PixelFormat& format, uint32_t red, uint32_t green, uint32_t blue, uint32_t alpha) {
+    return format.redMask == red && format.greenMask == green &&
+           format.blueMask == blue && format.alphaMask == alpha;
+  }
+
+  /**
+   * @brief Traduce un DDS_PIXELFORMAT clsico a DXGI_FORMAT (0 si no tiene equivalente).
+   */
+  uint32_t
+  legacyFormat(const PixelFormat& format) {
+    if (format.flags & DDPF_FOURCC) {
+      switch (format.fourCC) {
+      case fourCC('D', 'X', 'T', '1'): return 71;  // BC1_UNORM
+      case fourCC('D', 'X', 'T', '2'):
+      case fourCC('D', 'X', 'T', '3'): return 74;  // BC2_UNORM
+      case fourCC('D', 'X', 'T', '4'):
+      case fourCC('D', 'X', 'T', '5'): return 77;  // BC3_UNORM
+      case fourCC('A', 'T', 'I', '1'):
+      case fourCC('B', 'C', '4', 'U'): return 80;  // BC4_UNORM
+      case fourCC('B', 'C', '4', 'S'): return 81;  // BC4_SNORM
+      case fourCC('A', 'T', 'I', '2'):
+      case fourCC('B', 'C', '5', 'U'): return 83;  // BC5_UNORM
+      case fourCC('B', 'C', '5', 'S'): return 84;  // BC5_SNORM
+      // Cdigos D3DFORMAT numricos que D3DX escribe en el campo FourCC.
+      case 36:  return 11;                         // R16G16B16A16_UNORM
+      case 110: return 13;                         // R16G16B16A16_SNORM
+      case 111: return 54;                         // R16_FLOAT
+      case 112: return 34;                         // R16G16_FLOAT
+      case 113: return 10;                         // R16G16B16A16_FLOAT
+      case 114: return 41;                         // R32_FLOAT
+      case 115: return 16;                         // R32G32_FLOAT
+      case 116: return 2;                          // R32G32B32A32_FLOAT
+      default:  return 0;
+      }
+    }
+    if (format.flags & DDPF_RGB) {
+      switch (format.bitCount) {
+      case 32:
+        if (hasMasks(format, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000)) return 28; // R8G8B8A8_UNORM
+        if (hasMasks(format, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000)) return 87; // B8G8R8A8_UNORM
+        if (hasMasks(format, 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00000000)) return 88; // B8G8R8X8_UNORM
+        // D3DX escribe R10G10B10A2 con las mscaras de rojo y azul invertidas.
+        if (hasMasks(format, 0x3FF00000, 0x000FFC00, 0x000003FF, 0xC0000000) ||
+            hasMasks(format, 0x000003FF, 0x000FFC00, 0x3FF00000, 0xC0000000)) return 24;  // R10G10B10A2_UNORM
+        if (hasMasks(format, 0x0000FFFF, 0xFFFF0000, 0x00000000, 0x00000000)) return 35; // R16G16_UNORM
+        if (hasMasks(format, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000)) return 41; // R32_FLOAT
+        return 0;
+      case 16:
+        if (hasMasks(format, 0x7C00, 0x03E0, 0x001F, 0x8000)) return 86;                 // B5G5R5A1_UNORM
+        if (hasMasks(format, 0xF800, 0x07E0, 0x001F, 0x0000)) return 85;                 // B5G6R5_UNORM
+        if (hasMasks(format, 0x0F00, 0x00F0, 0x000F, 0xF000)) return 115;                // B4G4R4A4_UNORM
+        return 0;
+      default:
+        // 24 bits por pxel no tiene formato DXGI.
+        return 0;
+      }
+    }
+    if (format.flags & DDPF_LUMINANCE) {
+      if (format.bitCount == 8 && format.redMask == 0xFF) return 61;                      // R8_UNORM
+      if (format.bitCount == 16 && format.redMask == 0xFFFF) return 56;                   // R16_UNORM
+      if (format.bitCount == 16 && format.redMask == 0xFF && format.alphaMask == 0xFF00) return 49; // R8G8_UNORM
+      return 0;
+    }
+    if ((format.flags & DDPF_ALPHA) && format.bitCount == 8) {
+      return 65;                                                                          // A8_UNORM
+    }
+    if ((format.flags & DDPF_BUMPDUDV) && format.bitCount == 16 && format.redMask == 0xFF) {
+      return 51;                                                                          // R8G8_SNORM
+    }
+    return 0;
+  }
+
+  unsigned int
+  fullMipCount(unsigned int width, unsigned int height, unsigned int depth) {
+    unsigned int size = std::max(width, std::max(height, depth));
+    unsigned int levels = 1;
+    while (size > 1) {
+      size /= 2;
+      ++levels;
+    }
+    return levels;
+  }
+}
+
+unsigned int
+dxgiBitsPerPixel(uint32_t dxgiFormat) {
+  if (dxgiFormat >= 1 && dxgiFormat <= 4) return 128;
+  if (dxgiFormat >= 5 && dxgiFormat <= 8) return 96;
+  if (dxgiFormat >= 9 && dxgiFormat <= 22) return 64;
+  if (dxgiFormat >= 23 && dxgiFormat <= 47) return 32;
+  if (dxgiFormat >= 48 && dxgiFormat <= 59) return 16;
+  if (dxgiFormat >= 60 && dxgiFormat <= 65) return 8;
+  if (dxgiFormat == 67) return 32;                          // R9G9B9E5_SHAREDEXP
+  if (dxgiFormat == 85 || dxgiFormat == 86) return 16;      // B5G6R5, B5G5R5A1
+  if (dxgiFormat >= 87 && dxgiFormat <= 93) return 32;      // B8G8R8A8/X8 y variantes
+  if (dxgiFormat == 115) return 16;                         // B4G4R4A4
+  return 0;
+}
+
+unsigned int
+dxgiBlockBytes(uint32_t dxgiFormat) {
+  if (dxgiFormat >= 70 && dxgiFormat <= 72) return 8;       // BC1
+  if (dxgiFormat >= 73 && dxgiFormat <= 78) return 16;      // BC2, BC3
+  if (dxgiFormat >= 79 && dxgiFormat <= 81) return 8;       // BC4
+  if (dxgiFormat >= 82 && dxgiFormat <= 84) return 16;      // BC5
+  if (dxgiFormat >= 94 && dxgiFormat <= 99) return 16;      // BC6H, BC7
+  return 0;
+}
+
+bool
+parseDds(const uint8_t* data, size_t size, DdsImage& image, std::string* error) {
+  image = DdsImage();
+  if (!data || size < 4 + sizeof(Header)) {
+    return fail(error, "file too small");
+  }
+  uint32_t magic;
+  std::memcpy(&magic, data, sizeof(magic));
+  if (magic != fourCC('D', 'D', 'S', ' ')) {
+    return fail(error, "missing DDS magic");
+  }
+  // Copia a una estructura alineada: la proyeccin puede no estarlo y el archivo es little-endian.
+  Header header;
+  std::memcpy(&header, data + 4, sizeof(header));
+  if (header.size != sizeof(Header) || header.pixelFormat.size != sizeof(PixelFormat)) {
+    return fail(error, "invalid header size");
+  }
+  size_t offset = 4 + sizeof(Header);
+
+  image.width = std::max(1u, header.width);
+  image.height = std::max(1u, header.height);
+  image.depth = 1;
+  image.mipLevels = (header.flags & DDSD_MIPMAPCOUNT) || header.mipMapCount > 1 ? std::max(1u, header.mipMapCount) : 1;
+
+  if ((header.pixelFormat.flags & DDPF_FOURCC) && header.pixelFormat.fourCC == fourCC('D', 'X', '1', '0')) {
+    if (size < offset + sizeof(HeaderDx10)) {
+      return fail(error, "truncated DX10 header");
+    }
+    HeaderDx10 extension;
+    std::memcpy(&extension, data + offset, sizeof(extension));
+    offset += sizeof(HeaderDx10);
+
+    image.dxgiFormat = extension.dxgiFormat;
+    image.arraySize = extension.arraySize;
+    if (image.arraySize == 0) {
+      return fail(error, "array size is zero");
+    }
+    switch (extension.resourceDimension) {
+    case DDS_TEXTURE1D:
+      if (header.height > 1) {
+        return fail(error, "1D texture with height");
+      }
+      image.dimension = DDS_TEXTURE1D;
+      break;
+    case DDS_TEXTURE2D:
+      image.dimension = DDS_TEXTURE2D;
+      image.cubemap = (extension.miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) != 0;
+      break;
+    case DDS_TEXTURE3D:
+      if (image.arraySize != 1) {
+        return fail(error, "volume texture arrays are not valid");
+      }
+      image.dimension = DDS_TEXTURE3D;
+      image.depth = std::max(1u, header.depth);
+      break;
+    default:
+      return fail(error, "unknown resource dimension");
+    }
+  }
+  else {
+    image.dxgiFormat = legacyFormat(header.pixelFormat);
+    if (header.caps2 & DDSCAPS2_CUBEMAP) {
+      // Los DDS clsicos pueden omitir caras; Direct3D 11 necesita las seis.
+      if ((header.caps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES) {
+        return fail(error, "partial cubemaps are not supported");
+      }
+      image.cubemap = true;
+    }
+    else if (header.caps2 & DDSCAPS2_VOLUME) {
+      image.dimension = DDS_TEXTURE3D;
+      image.depth = std::max(1u, header.depth);
+    }
+  }
+
+  unsigned int blockBytes = dxgiBlockBytes(image.dxgiFormat);
+  unsigned int bitsPerPixel = dxgiBitsPerPixel(image.dxgiFormat);
+  if (blockBytes == 0 && bitsPerPixel == 0) {
+    return fail(error, "unsupported pixel format");
+  }
+  if (image.mipLevels > fullMipCount(image.width, image.height, image.depth)) {
+    return fail(error, "too many mip levels");
+  }
+  if (image.cubemap && image.width != image.height) {
+    return fail(error, "cubemap faces must be square");
+  }
+
+  // Cada subrecurso ocupa al menos un byte: un arraySize absurdo se rechaza
+  // antes de reservar (y antes de que sliceCount() desborde).
+  uint64_t surfaceCount = static_cast<uint64_t>(image.arraySize) * (image.cubemap ? 6 : 1) * image.mipLevels;
+  if (surfaceCount > size - offset) {
+    return fail(error, "truncated pixel data");
+  }
+
+  unsigned int slices = image.sliceCount();
+  image.surfaces.reserve(static_cast<size_t>(slices) * image.mipLevels);
+  for (unsigned int slice = 0; slice < slices; ++slice) {
+    unsigned int width = image.width;
+    unsigned int height = image.height;
+    unsigned int depth = image.depth;
+    for (unsigned int mip = 0; mip < image.mipLevels; ++mip) {
+      DdsSurface surface;
+      surface.width = width;
+      surface.height = height;
+      surface.depth = depth;
+      size_t rows;
+      if (blockBytes != 0) {
+        surface.rowPitch = static_cast<size_t>(std::max(1u, (width + 3) / 4)) * blockBytes;
+        rows = std::max(1u, (height + 3) / 4);
+      }
+      else {
+        surface.rowPitch = (static_cast<size_t>(width) * bitsPerPixel + 7) / 8;
+        rows = height;
+      }
+      surface.slicePitch = surface.rowPitch * rows;
+      size_t bytes = surface.slicePitch * depth;
+      if (bytes > size - offset) {
+        return fail(error, "truncated pixel data");
+      }
+      surface.data = data + offset;
+      offset += bytes;
+      image.surfaces.push_back(surface);
+
+      width = std::max(1u, width / 2);
+      height = std::max(1u, height / 2);
+      depth = std::max(1u, depth / 2);
+    }
+  }
+  return true;
+}
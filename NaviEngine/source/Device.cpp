@@ -39,7 +39,7 @@ Device::CreateRenderTargetView(ID3D11Resource* pResource,
 	}
 	else {
 		ERROR("Device", "CreateRenderTargetView",
-			("Failed to create Render Target View. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Render Target View. HRESULT: %d", hr);
 	}
 
 	return hr;
@@ -75,7 +75,7 @@ Device::CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
 	}
 	else {
 		ERROR("Device", "CreateTexture2D",
-			("Failed to create Texture2D. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Texture2D. HRESULT: %d", hr);
 	}
 
 	return hr;
@@ -111,7 +111,7 @@ Device::CreateDepthStencilView(ID3D11Resource* pResource,
 	}
 	else {
 		ERROR("Device", "CreateDepthStencilView",
-			("Failed to create Depth Stencil View. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Depth Stencil View. HRESULT: %d", hr);
 	}
 
 	return hr;
@@ -149,7 +149,7 @@ Device::CreateVertexShader(const void* pShaderBytecode,
 	}
 	else {
 		ERROR("Device", "CreateVertexShader",
-			("Failed to create Vertex Shader. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Vertex Shader. HRESULT: %d", hr);
 	}
 
 	return hr;
@@ -190,7 +190,7 @@ Device::CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
 	}
 	else {
 		ERROR("Device", "CreateInputLayout",
-			("Failed to create Input Layout. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Input Layout. HRESULT: %d", hr);
 	}
 
 	return hr;
@@ -228,7 +228,7 @@ Device::CreatePixelShader(const void* pShaderBytecode,
 	}
 	else {
 		ERROR("Device", "CreatePixelShader",
-			("Failed to create Pixel Shader. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Pixel Shader. HRESULT: %d", hr);
 	}
 
 	return hr;
@@ -261,7 +261,7 @@ Device::CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
 	}
 	else {
 		ERROR("Device", "CreateSamplerState",
-			("Failed to create Sampler State. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Sampler State. HRESULT: %d", hr);
 	}
 
 	return hr;
@@ -295,7 +295,7 @@ Device::CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
 	}
 	else {
 		ERROR("Device", "CreateBuffer",
-			("Failed to create Buffer. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create Buffer. HRESULT: %d", hr);
 
 	}
 	return hr;
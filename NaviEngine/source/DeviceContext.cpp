@@ -1,4 +1,5 @@
 #include "DeviceContext.h"
+#include "Metrics.h"
 
 //
 // La funcin `destroy` se encarga de liberar el objeto principal de Direct3D, el ID3D11DeviceContext.
@@ -23,6 +24,7 @@ DeviceContext::RSSetViewports(unsigned int NumViewports,
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->RSSetViewports(NumViewports, 
 																	pViewports);
 }
@@ -43,6 +45,7 @@ DeviceContext::PSSetShaderResources(unsigned int StartSlot,
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->PSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews);
 }
 
@@ -59,6 +62,7 @@ DeviceContext::IASetInputLayout(ID3D11InputLayout* pInputLayout) {
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->IASetInputLayout(pInputLayout);
 }
 
@@ -76,6 +80,7 @@ DeviceContext::VSSetShader(ID3D11VertexShader* pVertexShader,
 		return;
 	}
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->VSSetShader(pVertexShader, 
 																ppClassInstances, 
 																NumClassInstances);
@@ -96,6 +101,7 @@ DeviceContext::PSSetShader(ID3D11PixelShader* pPixelShader,
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->PSSetShader(pPixelShader, 
 															ppClassInstances, 
 															NumClassInstances);
@@ -127,6 +133,36 @@ DeviceContext::UpdateSubresource(ID3D11Resource* pDstResource,
 																		SrcDepthPitch);
 }
 
+//
+// `Map` da acceso de CPU a un recurso dinmico (por ejemplo, un vertex buffer
+// que se reescribe cada frame). Con D3D11_MAP_WRITE_DISCARD el contenido anterior se descarta.
+//
+HRESULT
+DeviceContext::Map(ID3D11Resource* pResource,
+									 unsigned int Subresource,
+									 D3D11_MAP MapType,
+									 D3D11_MAPPED_SUBRESOURCE* pMappedResource) {
+	// Verificacin para evitar punteros nulos.
+	if (!pResource || !pMappedResource) {
+		ERROR("DeviceContext", "Map",
+			"Invalid arguments: pResource or pMappedResource is nullptr");
+		return E_INVALIDARG;
+	}
+	return m_deviceContext->Map(pResource, Subresource, MapType, 0, pMappedResource);
+}
+
+//
+// `Unmap` devuelve a la GPU un recurso mapeado con `Map`.
+//
+void
+DeviceContext::Unmap(ID3D11Resource* pResource, unsigned int Subresource) {
+	if (!pResource) {
+		ERROR("DeviceContext", "Unmap", "Invalid argument: pResource is nullptr");
+		return;
+	}
+	m_deviceContext->Unmap(pResource, Subresource);
+}
+
 //
 // `IASetVertexBuffers` asigna bferes de vrtices a la etapa de Ensamblador de Entrada.
 // Estos bferes contienen los datos de los vrtices (posiciones, normales, coordenadas de textura, etc.).
@@ -144,6 +180,7 @@ DeviceContext::IASetVertexBuffers(unsigned int StartSlot,
 		return;
 	}
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->IASetVertexBuffers(StartSlot,
 																			NumBuffers,
 																			ppVertexBuffers,
@@ -165,6 +202,7 @@ DeviceContext::IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
 		return;
 	}
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->IASetIndexBuffer(pIndexBuffer, 
 																		Format, 
 																		Offset);
@@ -184,6 +222,7 @@ DeviceContext::PSSetSamplers(unsigned int StartSlot,
 		return;
 	}
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->PSSetSamplers(StartSlot, NumSamplers, ppSamplers);
 }
 
@@ -199,6 +238,7 @@ DeviceContext::RSSetState(ID3D11RasterizerState* pRasterizerState) {
 		return;
 	}
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->RSSetState(pRasterizerState);
 }
 
@@ -216,6 +256,7 @@ DeviceContext::OMSetBlendState(ID3D11BlendState* pBlendState,
 		return;
 	}
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->OMSetBlendState(pBlendState, 
 																	BlendFactor, 
 																	SampleMask);
@@ -243,11 +284,39 @@ DeviceContext::OMSetRenderTargets(unsigned int NumViews,
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->OMSetRenderTargets(NumViews, 
 																			ppRenderTargetViews, 
 																			pDepthStencilView);
 }
 
+//
+// `OMUnbindRenderTargets` deja la etapa de salida sin render targets ni profundidad.
+// `OMSetRenderTargets` rechaza esta llamada con punteros nulos, as que va aparte.
+//
+void
+DeviceContext::OMUnbindRenderTargets() {
+	EngineMetrics::stateChanges().add();
+	m_deviceContext->OMSetRenderTargets(0, nullptr, nullptr);
+}
+
+//
+// `PSUnbindShaderResources` vaca un rango de slots de recursos del Pixel Shader.
+//
+void
+DeviceContext::PSUnbindShaderResources(unsigned int StartSlot,
+																			 unsigned int NumViews) {
+	if (StartSlot >= D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT) {
+		ERROR("DeviceContext", "PSUnbindShaderResources", "StartSlot is out of range");
+		return;
+	}
+
+	ID3D11ShaderResourceView* nullViews[D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT] = {};
+	NumViews = (std::min)(NumViews, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT - StartSlot);
+	EngineMetrics::stateChanges().add();
+	m_deviceContext->PSSetShaderResources(StartSlot, NumViews, nullViews);
+}
+
 //
 // `IASetPrimitiveTopology` establece el tipo de primitivas (tringulos, puntos, lneas) que se dibujarn.
 //
@@ -261,6 +330,7 @@ DeviceContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) {
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->IASetPrimitiveTopology(Topology);
 }
 
@@ -329,6 +399,7 @@ DeviceContext::VSSetConstantBuffers(unsigned int StartSlot,
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->VSSetConstantBuffers(StartSlot, 
 																				NumBuffers,
 																				ppConstantBuffers);
@@ -348,6 +419,7 @@ DeviceContext::PSSetConstantBuffers(unsigned int StartSlot,
 		return;
 	}
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::stateChanges().add();
 	m_deviceContext->PSSetConstantBuffers(StartSlot, 
 																				NumBuffers, 
 																				ppConstantBuffers);
@@ -368,6 +440,8 @@ DeviceContext::DrawIndexed(unsigned int IndexCount,
 	}
 
 	// Se llama a la funcin nativa de Direct3D.
+	EngineMetrics::drawCalls().add();
+	EngineMetrics::trianglesSubmitted().add(IndexCount / 3);
 	m_deviceContext->DrawIndexed(IndexCount, 
 															StartIndexLocation, 
 															BaseVertexLocation);
@@ -0,0 +1,131 @@
+#include "FileSystem.h"
+#include "MappedFile.h"
+#include "PakFile.h"
+#include <algorithm>
+#include <sys/stat.h>
+#include <utility>
+
+FileView::FileView(std::shared_ptr<const MappedFile> mapping, const uint8_t* data, size_t size)
+  : m_owner(mapping), m_mapping(mapping.get()), m_data(data), m_size(size) {
+}
+
+FileView::FileView(std::vector<uint8_t>&& bytes) {
+  auto owned = std::make_shared<std::vector<uint8_t>>(std::move(bytes));
+  m_data = owned->data();
+  m_size = owned->size();
+  m_owner = std::move(owned);
+}
+
+void
+FileView::prefetch(size_t offset, size_t size) const {
+  if (m_mapping && offset < m_size) {
+    m_mapping->prefetch(static_cast<size_t>(m_data - m_mapping->data()) + offset,
+                        std::min(size, m_size - offset));
+  }
+}
+
+void
+FileView::reset() {
+  m_owner.reset();
+  m_mapping = nullptr;
+  m_data = nullptr;
+  m_size = 0;
+}
+
+DirectorySource::DirectorySource(const std::string& root) : m_root(root) {
+  if (!m_root.empty() && m_root.back() != '/' && m_root.back() != '\\') {
+    m_root += '/';
+  }
+}
+
+std::string
+DirectorySource::resolve(const std::string& path) const {
+  return m_root + path;
+}
+
+bool
+DirectorySource::open(const std::string& path, FileView& view) const {
+  auto file = std::make_shared<MappedFile>();
+  if (!file->open(resolve(path))) {
+    return false;
+  }
+  const uint8_t* data = file->data();
+  size_t size = file->size();
+  view = FileView(std::move(file), data, size);
+  return true;
+}
+
+bool
+DirectorySource::exists(const std::string& path) const {
+  struct stat info;
+  return stat(resolve(path).c_str(), &info) == 0 && (info.st_mode & S_IFREG) != 0;
+}
+
+VirtualFileSystem&
+VirtualFileSystem::instance() {
+  static VirtualFileSystem fileSystem;
+  return fileSystem;
+}
+
+void
+VirtualFileSystem::mount(std::shared_ptr<FileSource> source) {
+  if (!source) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_sources.push_back(std::move(source));
+}
+
+bool
+VirtualFileSystem::mountPak(const std::string& path) {
+  auto archive = std::make_shared<PakArchive>();
+  if (!archive->load(path)) {
+    return false;
+  }
+  mount(std::move(archive));
+  return true;
+}
+
+void
+VirtualFileSystem::unmountAll() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_sources.clear();
+}
+
+std::vector<std::shared_ptr<FileSource>>
+VirtualFileSystem::sources() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_sources;
+}
+
+bool
+VirtualFileSystem::open(const std::string& path, FileView& view) const {
+  std::vector<std::shared_ptr<FileSource>> mounted = sources();
+  for (auto source = mounted.rbegin(); source != mounted.rend(); ++source) {
+    if ((*source)->open(path, view)) {
+      return true;
+    }
+  }
+  return m_loose.open(path, view);
+}
+
+bool
+VirtualFileSystem::exists(const std::string& path) const {
+  std::vector<std::shared_ptr<FileSource>> mounted = sources();
+  for (const auto& source : mounted) {
+    if (source->exists(path)) {
+      return true;
+    }
+  }
+  return m_loose.exists(path);
+}
+
+bool
+VirtualFileSystem::readText(const std::string& path, std::string& text) const {
+  FileView view;
+  if (!open(path, view)) {
+    return false;
+  }
+  text.assign(reinterpret_cast<const char*>(view.data()), view.size());
+  return true;
+}
@@ -0,0 +1,684 @@
+#include "FrameGraph.h"
+#include <algorithm>
+
+namespace {
+
+  uint32_t
+  accessBit(FrameGraphAccess access) {
+    return 1u << static_cast<uint32_t>(access);
+  }
+
+  // Bytes por pxel de los formatos DXGI que usan los render targets habituales.
+  // Un formato desconocido cuenta como 4 bytes: solo afecta a las estadsticas
+  // y a la colocacin en el heap, no a qu texturas se comparten.
+  unsigned int
+  bytesPerPixel(uint32_t format) {
+    switch (format) {
+    case 2:                                      // R32G32B32A32_FLOAT
+      return 16;
+    case 10:                                     // R16G16B16A16_FLOAT
+    case 11:                                     // R16G16B16A16_UNORM
+    case 16:                                     // R32G32_FLOAT
+      return 8;
+    case 49:                                     // R8G8_UNORM
+    case 53: case 54: case 55: case 56:          // R16 / D16
+      return 2;
+    case 61:                                     // R8_UNORM
+      return 1;
+    default:                                     // RGBA8, RGB10A2, R11G11B10, R32, D24S8, D32...
+      return 4;
+    }
+  }
+
+  uint64_t
+  alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+}
+
+const char*
+frameGraphAccessName(FrameGraphAccess access) {
+  switch (access) {
+  case FRAME_GRAPH_ACCESS_NONE:             return "none";
+  case FRAME_GRAPH_ACCESS_RENDER_TARGET:    return "render target";
+  case FRAME_GRAPH_ACCESS_DEPTH_WRITE:      return "depth write";
+  case FRAME_GRAPH_ACCESS_DEPTH_READ:       return "depth read";
+  case FRAME_GRAPH_ACCESS_SHADER_READ:      return "shader read";
+  case FRAME_GRAPH_ACCESS_UNORDERED_ACCESS: return "unordered access";
+  case FRAME_GRAPH_ACCESS_COPY_SOURCE:      return "copy source";
+  case FRAME_GRAPH_ACCESS_COPY_DEST:        return "copy dest";
+  case FRAME_GRAPH_ACCESS_PRESENT:          return "present";
+  default:                                  return "unknown";
+  }
+}
+
+bool
+isFrameGraphWrite(FrameGraphAccess access) {
+  return access == FRAME_GRAPH_ACCESS_RENDER_TARGET ||
+         access == FRAME_GRAPH_ACCESS_DEPTH_WRITE ||
+         access == FRAME_GRAPH_ACCESS_UNORDERED_ACCESS ||
+         access == FRAME_GRAPH_ACCESS_COPY_DEST;
+}
+
+uint64_t
+frameGraphTextureBytes(const FrameGraphTextureDesc& desc) {
+  return static_cast<uint64_t>(desc.width) * desc.height *
+         (std::max)(desc.sampleCount, 1u) * bytesPerPixel(desc.format);
+}
+
+// ---------------------------------------------------------------------------
+// FrameGraphBuilder / FrameGraphPassContext
+// ---------------------------------------------------------------------------
+
+FrameGraphHandle
+FrameGraphBuilder::createTexture(const std::string& name, const FrameGraphTextureDesc& desc) {
+  FrameGraph::Resource resource;
+  resource.name = name;
+  resource.desc = desc;
+  resource.bytes = frameGraphTextureBytes(desc);
+  m_graph.m_resources.push_back(resource);
+  return m_graph.addNode(static_cast<uint32_t>(m_graph.m_resources.size() - 1));
+}
+
+FrameGraphHandle
+FrameGraphBuilder::read(FrameGraphHandle handle, FrameGraphAccess access) {
+  return m_graph.addAccess(m_pass, handle, access, false);
+}
+
+FrameGraphHandle
+FrameGraphBuilder::write(FrameGraphHandle handle, FrameGraphAccess access) {
+  return m_graph.addAccess(m_pass, handle, access, true);
+}
+
+FrameGraphHandle
+FrameGraphBuilder::modify(FrameGraphHandle handle, FrameGraphAccess access) {
+  m_graph.addAccess(m_pass, handle, access, false);
+  return m_graph.addAccess(m_pass, handle, access, true);
+}
+
+void
+FrameGraphBuilder::sideEffect() {
+  m_graph.m_passes[m_pass].sideEffect = true;
+}
+
+void*
+FrameGraphPassContext::physical(FrameGraphHandle handle) const {
+  if (!handle.valid() || handle.index >= m_graph.m_nodes.size()) {
+    return nullptr;
+  }
+  const FrameGraph::Resource& resource = m_graph.m_resources[m_graph.m_nodes[handle.index].resource];
+  if (resource.imported) {
+    return resource.importedTexture;
+  }
+  if (resource.physical < 0 ||
+      static_cast<size_t>(resource.physical) >= m_graph.m_physicalTextures.size()) {
+    return nullptr;
+  }
+  return m_graph.m_physicalTextures[resource.physical];
+}
+
+const FrameGraphTextureDesc&
+FrameGraphPassContext::desc(FrameGraphHandle handle) const {
+  return m_graph.m_resources[m_graph.m_nodes[handle.index].resource].desc;
+}
+
+const std::string&
+FrameGraphPassContext::passName() const {
+  return m_graph.m_passes[m_pass].name;
+}
+
+// ---------------------------------------------------------------------------
+// Construccin del grafo
+// ---------------------------------------------------------------------------
+
+void
+FrameGraph::reset() {
+  m_resources.clear();
+  m_nodes.clear();
+  m_passes.clear();
+  m_physical.clear();
+  m_finalBarriers.clear();
+  m_physicalTextures.clear();
+  m_stats = FrameGraphStats();
+  m_compiled = false;
+  m_buildError.clear();
+}
+
+FrameGraphHandle
+FrameGraph::importTexture(const std::string& name,
+                          const FrameGraphTextureDesc& desc,
+                          void* physical,
+                          FrameGraphAccess initialAccess,
+                          FrameGraphAccess finalAccess) {
+  Resource resource;
+  resource.name = name;
+  resource.desc = desc;
+  resource.bytes = frameGraphTextureBytes(desc);
+  resource.imported = true;
+  resource.importedTexture = physical;
+  resource.initialAccess = initialAccess;
+  resource.finalAccess = finalAccess;
+  m_resources.push_back(resource);
+  return addNode(static_cast<uint32_t>(m_resources.size() - 1));
+}
+
+uint32_t
+FrameGraph::addPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute) {
+  m_compiled = false;
+  m_passes.emplace_back();
+  m_passes.back().name = name;
+  m_passes.back().execute = std::move(execute);
+
+  uint32_t pass = static_cast<uint32_t>(m_passes.size() - 1);
+  FrameGraphBuilder builder(*this, pass);
+  if (setup) {
+    setup(builder);
+  }
+  return pass;
+}
+
+FrameGraphHandle
+FrameGraph::addNode(uint32_t resource) {
+  Node node;
+  node.resource = resource;
+  m_nodes.push_back(node);
+
+  FrameGraphHandle handle;
+  handle.index = static_cast<uint32_t>(m_nodes.size() - 1);
+  m_resources[resource].latestNode = handle.index;
+  return handle;
+}
+
+FrameGraphHandle
+FrameGraph::addAccess(uint32_t pass, FrameGraphHandle handle, FrameGraphAccess access, bool write) {
+  // Los errores de configuracin se guardan y los devuelve compile(): la
+  // funcin de setup no tiene forma razonable de tratarlos.
+  if (!handle.valid() || handle.index >= m_nodes.size()) {
+    if (m_buildError.empty()) {
+      m_buildError = "pase '" + m_passes[pass].name + "': handle invlido";
+    }
+    return FrameGraphHandle();
+  }
+
+  uint32_t resourceIndex = m_nodes[handle.index].resource;
+  Resource& resource = m_resources[resourceIndex];
+  Pass& current = m_passes[pass];
+
+  // Un pase deja cada textura en un nico estado: no se puede, por ejemplo,
+  // leerla como SRV y escribirla como render target a la vez.
+  for (const Access& other : current.accesses) {
+    if (m_nodes[other.node].resource == resourceIndex && other.access != access) {
+      if (m_buildError.empty()) {
+        m_buildError = "pase '" + current.name + "': '" + resource.name + "' se usa como " +
+                       frameGraphAccessName(other.access) + " y como " +
+                       frameGraphAccessName(access);
+      }
+      return FrameGraphHandle();
+    }
+  }
+
+  Access entry;
+  entry.access = access;
+  entry.write = write;
+  if (!write) {
+    entry.node = handle.index;
+    current.accesses.push_back(entry);
+    return handle;
+  }
+
+  // Escribir una versin que ya no es la ltima dejara a sus lectores
+  // posteriores viendo un contenido distinto del que declararon.
+  if (resource.latestNode != handle.index) {
+    if (m_buildError.empty()) {
+      m_buildError = "pase '" + current.name + "': escribe una versin antigua de '" +
+                     resource.name + "'";
+    }
+    return FrameGraphHandle();
+  }
+
+  FrameGraphHandle next = addNode(resourceIndex);
+  m_nodes[next.index].producer = static_cast<int>(pass);
+  entry.node = next.index;
+  current.accesses.push_back(entry);
+  return next;
+}
+
+// ---------------------------------------------------------------------------
+// Compilacin
+// ---------------------------------------------------------------------------
+
+bool
+FrameGraph::fail(std::string* error, const std::string& message) {
+  if (error) {
+    *error = message;
+  }
+  return false;
+}
+
+bool
+FrameGraph::compile(std::string* error) {
+  m_compiled = false;
+  if (!m_buildError.empty()) {
+    return fail(error, m_buildError);
+  }
+  if (!validate(error)) {
+    return false;
+  }
+
+  cull();
+  computeLifetimes();
+  assignPhysical();
+  placeInHeap();
+  buildBarriers();
+
+  m_stats.passes = static_cast<unsigned int>(m_passes.size());
+  m_stats.physicalTextures = static_cast<unsigned int>(m_physical.size());
+  m_compiled = true;
+  return true;
+}
+
+bool
+FrameGraph::validate(std::string* error) {
+  for (uint32_t p = 0; p < m_passes.size(); ++p) {
+    const Pass& pass = m_passes[p];
+    for (const Access& access : pass.accesses) {
+      if (access.write) {
+        continue;
+      }
+      const Node& node = m_nodes[access.node];
+      const Resource& resource = m_resources[node.resource];
+      if (node.producer < 0 && !resource.imported) {
+        return fail(error, "pase '" + pass.name + "': lee '" + resource.name +
+                           "' antes de que ningn pase la escriba");
+      }
+      if (node.producer == static_cast<int>(p)) {
+        return fail(error, "pase '" + pass.name + "': lee su propia salida '" +
+                           resource.name + "'");
+      }
+    }
+  }
+  return true;
+}
+
+void
+FrameGraph::cull() {
+  // Recuento de referencias: un pase vive mientras alguien lea alguna de las
+  // versiones que escribe. La ltima versin de una textura importada la lee
+  // el exterior, as que sus escritores son las races del grafo.
+  for (Node& node : m_nodes) {
+    node.readers = 0;
+  }
+  for (Pass& pass : m_passes) {
+    pass.culled = false;
+    pass.references = 0;
+    for (const Access& access : pass.accesses) {
+      if (access.write) {
+        ++pass.references;
+      }
+      else {
+        ++m_nodes[access.node].readers;
+      }
+    }
+  }
+  for (const Resource& resource : m_resources) {
+    if (resource.imported) {
+      ++m_nodes[resource.latestNode].readers;
+    }
+  }
+
+  std::vector<uint32_t>& stack = m_scratch;
+  stack.clear();
+  for (uint32_t n = 0; n < m_nodes.size(); ++n) {
+    if (m_nodes[n].readers == 0) {
+      stack.push_back(n);
+    }
+  }
+  // Los pases que no escriben nada (ni tienen efectos laterales) mueren de entrada.
+  for (Pass& pass : m_passes) {
+    if (pass.references == 0 && !pass.sideEffect) {
+      pass.culled = true;
+      for (const Access& access : pass.accesses) {
+        if (!access.write && --m_nodes[access.node].readers == 0) {
+          stack.push_back(access.node);
+        }
+      }
+    }
+  }
+
+  while (!stack.empty()) {
+    const Node& node = m_nodes[stack.back()];
+    stack.pop_back();
+    if (node.producer < 0) {
+      continue;
+    }
+    Pass& producer = m_passes[node.producer];
+    if (producer.sideEffect || producer.culled || --producer.references > 0) {
+      continue;
+    }
+    producer.culled = true;
+    for (const Access& access : producer.accesses) {
+      if (!access.write && --m_nodes[access.node].readers == 0) {
+        stack.push_back(access.node);
+      }
+    }
+  }
+
+  m_stats.culledPasses = 0;
+  for (const Pass& pass : m_passes) {
+    m_stats.culledPasses += pass.culled ? 1 : 0;
+  }
+}
+
+void
+FrameGraph::computeLifetimes() {
+  for (Resource& resource : m_resources) {
+    resource.firstPass = -1;
+    resource.lastPass = -1;
+    resource.accessMask = 0;
+    resource.physical = -1;
+    resource.heapOffset = 0;
+  }
+  for (uint32_t p = 0; p < m_passes.size(); ++p) {
+    if (m_passes[p].culled) {
+      continue;
+    }
+    for (const Access& access : m_passes[p].accesses) {
+      Resource& resource = m_resources[m_nodes[access.node].resource];
+      if (resource.firstPass < 0) {
+        resource.firstPass = static_cast<int>(p);
+      }
+      resource.lastPass = static_cast<int>(p);
+      resource.accessMask |= accessBit(access.access);
+    }
+  }
+
+  m_stats.transientTextures = 0;
+  m_stats.transientBytes = 0;
+  for (const Resource& resource : m_resources) {
+    if (!resource.imported && resource.firstPass >= 0) {
+      ++m_stats.transientTextures;
+      m_stats.transientBytes += resource.bytes;
+    }
+  }
+}
+
+void
+FrameGraph::assignPhysical() {
+  // D3D11 no tiene recursos colocados: dos transitorias solo pueden compartir
+  // memoria si comparten la textura entera, es decir, la misma descripcin.
+  // Se recorren por orden de primer uso y cada una toma la primera textura
+  // compatible que ya qued libre.
+  std::vector<uint32_t>& order = m_scratch;
+  order.clear();
+  for (uint32_t r = 0; r < m_resources.size(); ++r) {
+    if (!m_resources[r].imported && m_resources[r].firstPass >= 0) {
+      order.push_back(r);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+    return m_resources[a].firstPass < m_resources[b].firstPass;
+  });
+
+  m_physical.clear();
+  for (uint32_t r : order) {
+    Resource& resource = m_resources[r];
+    int chosen = -1;
+    for (size_t i = 0; i < m_physical.size(); ++i) {
+      if (m_physical[i].busyUntil < resource.firstPass && m_physical[i].desc == resource.desc) {
+        chosen = static_cast<int>(i);
+        break;
+      }
+    }
+    if (chosen < 0) {
+      PhysicalTexture physical;
+      physical.desc = resource.desc;
+      m_physical.push_back(physical);
+      chosen = static_cast<int>(m_physical.size() - 1);
+    }
+    m_physical[chosen].busyUntil = resource.lastPass;
+    m_physical[chosen].accessMask |= resource.accessMask;
+    resource.physical = chosen;
+  }
+
+  m_stats.physicalBytes = 0;
+  for (const PhysicalTexture& physical : m_physical) {
+    m_stats.physicalBytes += frameGraphTextureBytes(physical.desc);
+  }
+}
+
+void
+FrameGraph::placeInHeap() {
+  // Colocacin para APIs con heaps (D3D12/Vulkan): aqu s pueden solaparse
+  // texturas de distinto formato. Primero las grandes; cada una va al hueco
+  // ms bajo que no pise a ninguna ya colocada con la que coincida en el tiempo.
+  std::vector<uint32_t>& order = m_scratch;
+  order.clear();
+  for (uint32_t r = 0; r < m_resources.size(); ++r) {
+    if (!m_resources[r].imported && m_resources[r].firstPass >= 0) {
+      order.push_back(r);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+    return m_resources[a].bytes > m_resources[b].bytes;
+  });
+
+  struct Interval {
+    uint64_t begin;
+    uint64_t end;
+  };
+  std::vector<Interval> busy;
+  uint64_t heapBytes = 0;
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    Resource& resource = m_resources[order[i]];
+    uint64_t size = alignUp((std::max)(resource.bytes, uint64_t(1)), kHeapAlignment);
+
+    busy.clear();
+    for (size_t j = 0; j < i; ++j) {
+      const Resource& placed = m_resources[order[j]];
+      if (placed.firstPass <= resource.lastPass && resource.firstPass <= placed.lastPass) {
+        busy.push_back({ placed.heapOffset,
+                         placed.heapOffset + alignUp((std::max)(placed.bytes, uint64_t(1)),
+                                                     kHeapAlignment) });
+      }
+    }
+    std::sort(busy.begin(), busy.end(), [](const Interval& a, const Interval& b) {
+      return a.begin < b.begin;
+    });
+
+    uint64_t offset = 0;
+    for (const Interval& interval : busy) {
+      if (offset + size <= interval.begin) {
+        break;
+      }
+      offset = (std::max)(offset, interval.end);
+    }
+    resource.heapOffset = offset;
+    heapBytes = (std::max)(heapBytes, offset + size);
+  }
+  m_stats.heapBytes = heapBytes;
+}
+
+void
+FrameGraph::buildBarriers() {
+  // Estado actual de cada textura fsica (las transitorias comparten el de su
+  // textura) y de cada importada, y qu recurso ocup la fsica por ltima vez.
+  std::vector<FrameGraphAccess> physicalState(m_physical.size(), FRAME_GRAPH_ACCESS_NONE);
+  std::vector<int> physicalOwner(m_physical.size(), -1);
+  std::vector<FrameGraphAccess> importedState(m_resources.size(), FRAME_GRAPH_ACCESS_NONE);
+  for (uint32_t r = 0; r < m_resources.size(); ++r) {
+    importedState[r] = m_resources[r].initialAccess;
+  }
+
+  m_stats.barriers = 0;
+  m_finalBarriers.clear();
+  for (uint32_t p = 0; p < m_passes.size(); ++p) {
+    Pass& pass = m_passes[p];
+    pass.barriers.clear();
+    if (pass.culled) {
+      continue;
+    }
+    for (size_t a = 0; a < pass.accesses.size(); ++a) {
+      const Access& access = pass.accesses[a];
+      uint32_t resourceIndex = m_nodes[access.node].resource;
+      const Resource& resource = m_resources[resourceIndex];
+
+      // modify() registra lectura y escritura del mismo recurso: una sola transicin.
+      bool seen = false;
+      for (size_t b = 0; b < a; ++b) {
+        seen = seen || m_nodes[pass.accesses[b].node].resource == resourceIndex;
+      }
+      if (seen) {
+        continue;
+      }
+
+      FrameGraphAccess* state = &importedState[resourceIndex];
+      bool aliasing = false;
+      if (!resource.imported) {
+        state = &physicalState[resource.physical];
+        int& owner = physicalOwner[resource.physical];
+        aliasing = owner >= 0 && owner != static_cast<int>(resourceIndex);
+        owner = static_cast<int>(resourceIndex);
+      }
+
+      // Dos escrituras UAV seguidas tambin necesitan esperar a la primera.
+      bool uavHazard = *state == FRAME_GRAPH_ACCESS_UNORDERED_ACCESS &&
+                       access.access == FRAME_GRAPH_ACCESS_UNORDERED_ACCESS;
+      if (*state != access.access || aliasing || uavHazard) {
+        FrameGraphBarrier barrier;
+        barrier.resource.index = access.node;
+        barrier.before = *state;
+        barrier.after = access.access;
+        barrier.aliasing = aliasing;
+        pass.barriers.push_back(barrier);
+      }
+      *state = access.access;
+    }
+    m_stats.barriers += static_cast<unsigned int>(pass.barriers.size());
+  }
+
+  for (uint32_t r = 0; r < m_resources.size(); ++r) {
+    const Resource& resource = m_resources[r];
+    if (resource.imported && resource.finalAccess != FRAME_GRAPH_ACCESS_NONE &&
+        importedState[r] != resource.finalAccess) {
+      FrameGraphBarrier barrier;
+      barrier.resource.index = resource.latestNode;
+      barrier.before = importedState[r];
+      barrier.after = resource.finalAccess;
+      m_finalBarriers.push_back(barrier);
+    }
+  }
+  m_stats.barriers += static_cast<unsigned int>(m_finalBarriers.size());
+}
+
+// ---------------------------------------------------------------------------
+// Ejecucin
+// ---------------------------------------------------------------------------
+
+bool
+FrameGraph::execute(FrameGraphBackend& backend) {
+  if (!m_compiled) {
+    return false;
+  }
+  ++m_frame;
+
+  // Cada textura fsica del frame toma del pool una con la misma descripcin
+  // y al menos los mismos usos; si no la hay, la crea el backend.
+  bool ok = true;
+  m_physicalTextures.assign(m_physical.size(), nullptr);
+  for (size_t i = 0; i < m_physical.size(); ++i) {
+    PhysicalTexture& physical = m_physical[i];
+    for (size_t j = 0; j < m_pool.size(); ++j) {
+      PooledTexture& pooled = m_pool[j];
+      if (!pooled.taken && pooled.desc == physical.desc &&
+          (pooled.accessMask & physical.accessMask) == physical.accessMask) {
+        physical.pooled = static_cast<int>(j);
+        break;
+      }
+    }
+    if (physical.pooled < 0) {
+      void* texture = backend.createTexture(physical.desc, physical.accessMask);
+      if (!texture) {
+        ok = false;
+        break;
+      }
+      PooledTexture pooled;
+      pooled.desc = physical.desc;
+      pooled.accessMask = physical.accessMask;
+      pooled.texture = texture;
+      m_pool.push_back(pooled);
+      physical.pooled = static_cast<int>(m_pool.size() - 1);
+    }
+    m_pool[physical.pooled].taken = true;
+    m_pool[physical.pooled].lastUsedFrame = m_frame;
+    m_physicalTextures[i] = m_pool[physical.pooled].texture;
+  }
+
+  if (ok) {
+    FrameGraphPassContext context(*this, 0);
+    for (uint32_t p = 0; p < m_passes.size(); ++p) {
+      const Pass& pass = m_passes[p];
+      if (pass.culled) {
+        continue;
+      }
+      context.m_pass = p;
+      for (const FrameGraphBarrier& barrier : pass.barriers) {
+        backend.barrier(barrier, context.physical(barrier.resource));
+      }
+      if (pass.execute) {
+        pass.execute(context);
+      }
+    }
+    for (const FrameGraphBarrier& barrier : m_finalBarriers) {
+      backend.barrier(barrier, context.physical(barrier.resource));
+    }
+  }
+
+  // Devolver al pool y liberar lo que lleva varios frames sin usarse.
+  for (PhysicalTexture& physical : m_physical) {
+    physical.pooled = -1;
+  }
+  for (size_t j = 0; j < m_pool.size();) {
+    m_pool[j].taken = false;
+    if (m_frame - m_pool[j].lastUsedFrame > kPoolFrames) {
+      backend.destroyTexture(m_pool[j].texture);
+      m_pool[j] = m_pool.back();
+      m_pool.pop_back();
+    }
+    else {
+      ++j;
+    }
+  }
+  return ok;
+}
+
+void
+FrameGraph::destroy(FrameGraphBackend& backend) {
+  for (PooledTexture& pooled : m_pool) {
+    backend.destroyTexture(pooled.texture);
+  }
+  m_pool.clear();
+  reset();
+}
+
+// ---------------------------------------------------------------------------
+// Consultas
+// ---------------------------------------------------------------------------
+
+void
+FrameGraph::lifetime(FrameGraphHandle handle, int& firstPass, int& lastPass) const {
+  const Resource& resource = m_resources[m_nodes[handle.index].resource];
+  firstPass = resource.firstPass;
+  lastPass = resource.lastPass;
+}
+
+int
+FrameGraph::physicalIndex(FrameGraphHandle handle) const {
+  return m_resources[m_nodes[handle.index].resource].physical;
+}
+
+uint64_t
+FrameGraph::heapOffset(FrameGraphHandle handle) const {
+  return m_resources[m_nodes[handle.index].resource].heapOffset;
+}
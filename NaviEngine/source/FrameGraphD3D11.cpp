@@ -0,0 +1,138 @@
+#include "FrameGraphD3D11.h"
+#include "Device.h"
+#include "DeviceContext.h"
+
+namespace {
+
+  bool
+  hasAccess(uint32_t accessMask, FrameGraphAccess access) {
+    return (accessMask & (1u << static_cast<uint32_t>(access))) != 0;
+  }
+
+  bool
+  isDepthAccess(FrameGraphAccess access) {
+    return access == FRAME_GRAPH_ACCESS_DEPTH_WRITE || access == FRAME_GRAPH_ACCESS_DEPTH_READ;
+  }
+
+  //
+  // Formatos de textura, DSV y SRV de una profundidad que tambin se muestrea.
+  // Devuelve false si el formato no es de profundidad.
+  //
+  bool
+  depthFormats(DXGI_FORMAT format, DXGI_FORMAT& typeless, DXGI_FORMAT& shaderView) {
+    switch (format) {
+    case DXGI_FORMAT_D24_UNORM_S8_UINT:
+      typeless = DXGI_FORMAT_R24G8_TYPELESS;
+      shaderView = DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+      return true;
+    case DXGI_FORMAT_D32_FLOAT:
+      typeless = DXGI_FORMAT_R32_TYPELESS;
+      shaderView = DXGI_FORMAT_R32_FLOAT;
+      return true;
+    case DXGI_FORMAT_D16_UNORM:
+      typeless = DXGI_FORMAT_R16_TYPELESS;
+      shaderView = DXGI_FORMAT_R16_UNORM;
+      return true;
+    default:
+      return false;
+    }
+  }
+
+}
+
+void
+FrameGraphTextureD3D11::destroy() {
+  renderTargetView.destroy();
+  depthStencilView.destroy();
+  texture.destroy();
+}
+
+void*
+D3D11FrameGraphBackend::createTexture(const FrameGraphTextureDesc& desc, uint32_t accessMask) {
+  DXGI_FORMAT format = static_cast<DXGI_FORMAT>(desc.format);
+  bool depth = hasAccess(accessMask, FRAME_GRAPH_ACCESS_DEPTH_WRITE) ||
+               hasAccess(accessMask, FRAME_GRAPH_ACCESS_DEPTH_READ);
+  bool shaderRead = hasAccess(accessMask, FRAME_GRAPH_ACCESS_SHADER_READ);
+
+  unsigned int bindFlags = 0;
+  if (hasAccess(accessMask, FRAME_GRAPH_ACCESS_RENDER_TARGET)) {
+    bindFlags |= D3D11_BIND_RENDER_TARGET;
+  }
+  if (depth) {
+    bindFlags |= D3D11_BIND_DEPTH_STENCIL;
+  }
+  if (shaderRead) {
+    bindFlags |= D3D11_BIND_SHADER_RESOURCE;
+  }
+  // La vista UAV la crea el pase que la necesita: no hay envoltorio para ella.
+  if (hasAccess(accessMask, FRAME_GRAPH_ACCESS_UNORDERED_ACCESS)) {
+    bindFlags |= D3D11_BIND_UNORDERED_ACCESS;
+  }
+
+  DXGI_FORMAT textureFormat = format;
+  DXGI_FORMAT shaderFormat = format;
+  if (depth && shaderRead && !depthFormats(format, textureFormat, shaderFormat)) {
+    ERROR("D3D11FrameGraphBackend", "createTexture",
+      "Depth format %u cannot be sampled", desc.format);
+    return nullptr;
+  }
+
+  FrameGraphTextureD3D11* texture = new FrameGraphTextureD3D11();
+  HRESULT hr = texture->texture.init(m_device,
+                                     desc.width,
+                                     desc.height,
+                                     textureFormat,
+                                     bindFlags,
+                                     desc.sampleCount,
+                                     desc.sampleQuality);
+  if (SUCCEEDED(hr) && (bindFlags & D3D11_BIND_RENDER_TARGET)) {
+    hr = texture->renderTargetView.init(m_device,
+                                        texture->texture,
+                                        desc.sampleCount > 1 ? D3D11_RTV_DIMENSION_TEXTURE2DMS
+                                                             : D3D11_RTV_DIMENSION_TEXTURE2D,
+                                        format);
+  }
+  if (SUCCEEDED(hr) && depth) {
+    hr = texture->depthStencilView.init(m_device, texture->texture, format);
+  }
+  if (SUCCEEDED(hr) && shaderRead) {
+    // La SRV queda en la propia textura (m_textureFromImg), lista para Texture::render().
+    hr = texture->texture.init(m_device, texture->texture, shaderFormat);
+  }
+  if (FAILED(hr)) {
+    ERROR("D3D11FrameGraphBackend", "createTexture",
+      "Failed to create %ux%u frame graph texture. HRESULT: %d", desc.width, desc.height, hr);
+    texture->destroy();
+    delete texture;
+    return nullptr;
+  }
+  return texture;
+}
+
+void
+D3D11FrameGraphBackend::destroyTexture(void* texture) {
+  FrameGraphTextureD3D11* d3dTexture = static_cast<FrameGraphTextureD3D11*>(texture);
+  if (d3dTexture) {
+    d3dTexture->destroy();
+    delete d3dTexture;
+  }
+}
+
+void
+D3D11FrameGraphBackend::barrier(const FrameGraphBarrier& barrier, void* texture) {
+  (void)texture;
+  if (!m_deviceContext.m_deviceContext) {
+    return;
+  }
+
+  // Una textura enlazada como salida no puede leerse: el runtime anulara el SRV.
+  if (barrier.after == FRAME_GRAPH_ACCESS_SHADER_READ &&
+      (barrier.before == FRAME_GRAPH_ACCESS_RENDER_TARGET || isDepthAccess(barrier.before))) {
+    m_deviceContext.OMUnbindRenderTargets();
+  }
+
+  // Y al revs: un SRV enlazado impedira enlazarla como render target o profundidad.
+  if (barrier.before == FRAME_GRAPH_ACCESS_SHADER_READ && isFrameGraphWrite(barrier.after)) {
+    m_deviceContext.PSUnbindShaderResources(0, kShaderResourceSlots);
+  }
+}
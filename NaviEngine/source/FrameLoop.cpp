@@ -0,0 +1,74 @@
+#include "FrameLoop.h"
+#include <cmath>
+
+bool
+FrameLoop::init(double fixedStep, double maxFrameTime, unsigned int maxStepsPerTick) {
+  if (!(fixedStep > 0.0) || maxFrameTime < fixedStep) {
+    return false;
+  }
+  m_fixedStep = fixedStep;
+  m_maxFrameTime = maxFrameTime;
+
+  // Si no se indica, el lmite de pasos es el que cabe en el tiempo mximo de frame.
+  m_maxStepsPerTick = maxStepsPerTick != 0
+    ? maxStepsPerTick
+    : static_cast<unsigned int>(std::ceil(maxFrameTime / fixedStep));
+  return true;
+}
+
+void
+FrameLoop::reset(double now) {
+  m_previousTime = now;
+  m_started = true;
+  m_accumulator = 0.0;
+  m_totalSteps = 0;
+  m_droppedTime = 0.0;
+  m_lastFrameTime = 0.0;
+}
+
+unsigned int
+FrameLoop::tick(double now, const StepFunction& step) {
+  if (!m_started) {
+    reset(now);
+  }
+  double frameTime = now - m_previousTime;
+  m_previousTime = now;
+
+  // Un reloj que retrocede (o un reset tardo) no debe generar pasos negativos.
+  if (frameTime < 0.0) {
+    frameTime = 0.0;
+  }
+  return advance(frameTime, step);
+}
+
+unsigned int
+FrameLoop::advance(double frameTime, const StepFunction& step) {
+  m_lastFrameTime = frameTime;
+
+  // Lmite de tiempo por frame: tras un breakpoint o un arrastre de ventana
+  // no intentamos "recuperar" segundos enteros de simulacin.
+  if (frameTime > m_maxFrameTime) {
+    m_droppedTime += frameTime - m_maxFrameTime;
+    frameTime = m_maxFrameTime;
+  }
+  m_accumulator += frameTime;
+
+  unsigned int steps = 0;
+  while (m_accumulator >= m_fixedStep && steps < m_maxStepsPerTick) {
+    if (step) {
+      step(m_fixedStep);
+    }
+    m_accumulator -= m_fixedStep;
+    ++steps;
+  }
+  m_totalSteps += steps;
+
+  // Si an sobra ms de un paso, la simulacin no puede seguir el ritmo:
+  // se descarta el excedente y se conserva solo la fraccin para interpolar.
+  if (m_accumulator >= m_fixedStep) {
+    double excess = m_accumulator - std::fmod(m_accumulator, m_fixedStep);
+    m_droppedTime += excess;
+    m_accumulator -= excess;
+  }
+  return steps;
+}
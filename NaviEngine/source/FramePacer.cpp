@@ -0,0 +1,134 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+double
+FrameTimeStats::stdDev() const {
+  return std::sqrt(variance());
+}
+
+void
+FramePacer::init(const Clock& clock,
+                 double targetRate,
+                 double spinThreshold,
+                 SleepFunction sleepFn,
+                 SpinFunction spinFn) {
+  m_clock = &clock;
+  m_spinThreshold = std::max(0.0, spinThreshold);
+  m_sleepOvershoot = 0.0;
+  m_started = false;
+  m_sleep = sleepFn ? std::move(sleepFn) : SleepFunction([](double seconds) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  });
+  m_spin = spinFn ? std::move(spinFn) : SpinFunction([]() {
+    std::this_thread::yield();
+  });
+  setTargetRate(targetRate);
+  resetStats();
+}
+
+void
+FramePacer::setTargetRate(double targetRate) {
+  m_period = targetRate > 0.0 ? 1.0 / targetRate : 0.0;
+  // La fecha lmite se recalcula a partir del frame actual.
+  if (m_started) {
+    m_nextDeadline = m_lastFrameTime + m_period;
+  }
+}
+
+double
+FramePacer::waitForNextFrame() {
+  if (!m_clock) {
+    return 0.0;
+  }
+
+  if (!m_started) {
+    m_started = true;
+    m_lastFrameTime = m_clock->now();
+    m_nextDeadline = m_lastFrameTime + m_period;
+    return 0.0;
+  }
+
+  bool waited = false;
+  if (m_period > 0.0) {
+    double start = m_clock->now();
+    if (start > m_nextDeadline) {
+      ++m_stats.missedDeadlines;
+    }
+    else {
+      waitUntil(m_nextDeadline);
+      waited = true;
+    }
+  }
+
+  double now = m_clock->now();
+  double frameTime = now - m_lastFrameTime;
+  m_lastFrameTime = now;
+
+  if (m_period > 0.0) {
+    // Solo las esperas que llegaron a ejecutarse miden la precisin de dormir y
+    // girar; un frame que ya llegaba tarde cuenta en missedDeadlines.
+    if (waited) {
+      m_stats.maxWaitError = std::max(m_stats.maxWaitError, now - m_nextDeadline);
+    }
+
+    // Las fechas lmite avanzan en mltiplos exactos del periodo para no
+    // acumular deriva; si nos quedamos ms de un periodo atrs, se resincroniza.
+    m_nextDeadline += m_period;
+    if (m_nextDeadline < now) {
+      m_nextDeadline = now + m_period;
+    }
+  }
+
+  record(frameTime);
+  return frameTime;
+}
+
+void
+FramePacer::waitUntil(double deadline) {
+  // Fase 1: dormir mientras quede margen suficiente, restando el exceso de
+  // sueo observado para no pasarnos de la fecha lmite.
+  for (;;) {
+    double remaining = deadline - m_clock->now();
+    double sleepTime = remaining - m_spinThreshold - m_sleepOvershoot;
+    if (sleepTime <= 0.0) {
+      break;
+    }
+    double before = m_clock->now();
+    m_sleep(sleepTime);
+    double overshoot = (m_clock->now() - before) - sleepTime;
+
+    // Media mvil asimtrica: sube rpido ante un sueo largo, baja despacio.
+    if (overshoot > m_sleepOvershoot) {
+      m_sleepOvershoot = overshoot;
+    }
+    else {
+      m_sleepOvershoot += (std::max(0.0, overshoot) - m_sleepOvershoot) * 0.05;
+    }
+  }
+
+  // Fase 2: espera activa hasta la fecha lmite.
+  while (m_clock->now() < deadline) {
+    m_spin();
+  }
+}
+
+void
+FramePacer::record(double frameTime) {
+  FrameTimeStats& s = m_stats;
+  s.lastFrame = frameTime;
+  if (s.frameCount == 0) {
+    s.minFrame = frameTime;
+    s.maxFrame = frameTime;
+  }
+  else {
+    s.minFrame = std::min(s.minFrame, frameTime);
+    s.maxFrame = std::max(s.maxFrame, frameTime);
+  }
+  ++s.frameCount;
+  double delta = frameTime - s.mean;
+  s.mean += delta / static_cast<double>(s.frameCount);
+  s.m2 += delta * (frameTime - s.mean);
+}
@@ -0,0 +1,213 @@
+#include "ImageDecoder.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+namespace {
+  void*
+  stbMalloc(size_t size) {
+    return ImageDecoder::instance().allocate(size);
+  }
+
+  void*
+  stbRealloc(void* pointer, size_t size) {
+    return ImageDecoder::instance().reallocate(pointer, size);
+  }
+
+  void
+  stbFree(void* pointer) {
+    ImageDecoder::instance().release(pointer);
+  }
+
+  /** @brief Granularidad de las reservas: tamaos parecidos comparten bferes. */
+  const size_t kGranularity = 4096;
+}
+
+// nica implementacin de stb_image del motor, con sus reservas desviadas al pool.
+#define STBI_MALLOC(size) stbMalloc(size)
+#define STBI_REALLOC(pointer, size) stbRealloc(pointer, size)
+#define STBI_FREE(pointer) stbFree(pointer)
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+ImageDecoder&
+ImageDecoder::instance() {
+  static ImageDecoder decoder;
+  return decoder;
+}
+
+bool
+ImageDecoder::decodeFile(const std::string& path, DecodedImage& image, std::string* error,
+                         unsigned int desiredChannels) {
+  NAVI_PROFILE_SCOPE("ImageDecoder::decodeFile");
+  int width = 0, height = 0, channels = 0;
+  uint8_t* pixels = stbi_load(path.c_str(), &width, &height, &channels, static_cast<int>(desiredChannels));
+  return finish(pixels, width, height, channels, desiredChannels, image, error);
+}
+
+bool
+ImageDecoder::decodeMemory(const uint8_t* data, size_t size, DecodedImage& image, std::string* error,
+                           unsigned int desiredChannels) {
+  NAVI_PROFILE_SCOPE("ImageDecoder::decodeMemory");
+  int width = 0, height = 0, channels = 0;
+  uint8_t* pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels,
+                                          static_cast<int>(desiredChannels));
+  return finish(pixels, width, height, channels, desiredChannels, image, error);
+}
+
+bool
+ImageDecoder::finish(uint8_t* pixels, int width, int height, int channels, unsigned int desiredChannels,
+                     DecodedImage& image, std::string* error) {
+  if (!pixels) {
+    if (error) {
+      *error = stbi_failure_reason() ? stbi_failure_reason() : "unknown error";
+    }
+    return false;
+  }
+
+  // La salida de stb es un bfer del pool: se entrega el vector, no una copia,
+  // y deja de contar como memoria de decodificacin.
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto used = m_used.find(pixels);
+  if (used == m_used.end()) {
+    if (error) {
+      *error = "decoded image was not allocated by the pool";
+    }
+    return false;
+  }
+  image.width = static_cast<unsigned int>(width);
+  image.height = static_cast<unsigned int>(height);
+  image.channels = static_cast<unsigned int>(desiredChannels != 0 ? desiredChannels : channels);
+  image.pixels = std::move(used->second);
+  m_stats.bytesInUse -= image.pixels.size();
+  m_used.erase(used);
+  ++m_stats.images;
+  return true;
+}
+
+void*
+ImageDecoder::allocate(size_t size) {
+  size_t rounded = (std::max<size_t>(size, 1) + kGranularity - 1) / kGranularity * kGranularity;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_stats.allocations;
+  std::vector<uint8_t> buffer = take(rounded);
+
+  void* pointer = buffer.data();
+  m_stats.bytesInUse += buffer.size();
+  m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.bytesInUse);
+  m_used.emplace(pointer, std::move(buffer));
+  return pointer;
+}
+
+std::vector<uint8_t>
+ImageDecoder::take(size_t size) {
+  // Se reutiliza el menor bfer libre que sirva, si no desperdicia ms de la mitad.
+  std::vector<uint8_t> buffer;
+  auto found = m_free.lower_bound(size);
+  if (found != m_free.end() && found->first <= size * 2) {
+    buffer = std::move(found->second);
+    m_stats.pooledBytes -= found->first;
+    m_free.erase(found);
+    ++m_stats.poolHits;
+  }
+  else {
+    buffer.resize(size);
+  }
+  return buffer;
+}
+
+std::vector<uint8_t>
+ImageDecoder::acquire(size_t size) {
+  std::vector<uint8_t> buffer;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer = take(size);
+  }
+  buffer.resize(size);
+  return buffer;
+}
+
+void*
+ImageDecoder::reallocate(void* pointer, size_t size) {
+  if (!pointer) {
+    return allocate(size);
+  }
+  size_t oldSize = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto used = m_used.find(pointer);
+    if (used == m_used.end()) {
+      return nullptr;
+    }
+    oldSize = used->second.size();
+  }
+  if (size <= oldSize) {
+    return pointer;
+  }
+  void* grown = allocate(size);
+  std::memcpy(grown, pointer, oldSize);
+  release(pointer);
+  return grown;
+}
+
+void
+ImageDecoder::release(void* pointer) {
+  if (!pointer) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto used = m_used.find(pointer);
+  if (used == m_used.end()) {
+    return;
+  }
+  std::vector<uint8_t> buffer = std::move(used->second);
+  m_used.erase(used);
+  m_stats.bytesInUse -= buffer.size();
+  store(std::move(buffer));
+}
+
+void
+ImageDecoder::recycle(std::vector<uint8_t>&& buffer) {
+  if (buffer.size() < kGranularity) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  store(std::move(buffer));
+}
+
+void
+ImageDecoder::store(std::vector<uint8_t>&& buffer) {
+  if (m_stats.pooledBytes + buffer.size() > m_poolLimit) {
+    return;
+  }
+  m_stats.pooledBytes += buffer.size();
+  size_t size = buffer.size();
+  m_free.emplace(size, std::move(buffer));
+}
+
+void
+ImageDecoder::setPoolLimit(size_t bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_poolLimit = bytes;
+  while (m_stats.pooledBytes > m_poolLimit && !m_free.empty()) {
+    auto largest = std::prev(m_free.end());
+    m_stats.pooledBytes -= largest->first;
+    m_free.erase(largest);
+  }
+}
+
+void
+ImageDecoder::trim() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_free.clear();
+  m_stats.pooledBytes = 0;
+}
+
+DecodeStats
+ImageDecoder::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
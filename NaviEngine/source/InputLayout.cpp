@@ -24,7 +24,7 @@ InputLayout::init(Device& device,
 
   if (FAILED(hr)) {
     ERROR("InputLayout", "init",
-      ("Failed to create InputLayout. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to create InputLayout. HRESULT: %d", hr);
       return hr;
     }
 
@@ -43,7 +43,7 @@ InputLayout::render(DeviceContext& deviceContext) {
      
     return;
   }
-  deviceContext.m_deviceContext->IASetInputLayout(m_inputLayout);
+  deviceContext.IASetInputLayout(m_inputLayout);
 }
 
 void
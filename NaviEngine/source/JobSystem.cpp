@@ -0,0 +1,479 @@
+#include "JobSystem.h"
+#include "Prerequisites.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <set>
+#include <string>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+struct
+Job {
+  std::function<void()> function;
+  JobCounter* counter = nullptr;
+};
+
+namespace {
+  // ndice del hilo dentro del JobSystem (-1 = hilo externo).
+  thread_local int t_threadIndex = -1;
+
+  // Generador xorshift por hilo para elegir vctima al robar.
+  thread_local uint32_t t_randomState = 0;
+
+  uint32_t
+  nextRandom() {
+    if (t_randomState == 0) {
+      t_randomState = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+    }
+    uint32_t x = t_randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    t_randomState = x;
+    return x;
+  }
+
+  void
+  pinThread(std::thread& thread, unsigned int logicalCore) {
+#if defined(_WIN32)
+    if (logicalCore < sizeof(DWORD_PTR) * 8) {
+      SetThreadAffinityMask(reinterpret_cast<HANDLE>(thread.native_handle()), static_cast<DWORD_PTR>(1) << logicalCore);
+    }
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(logicalCore, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#endif
+  }
+}
+
+//
+// WorkStealingDeque
+//
+
+WorkStealingDeque::WorkStealingDeque()
+  : m_buffer(new std::atomic<Job*>[kCapacity]) {
+  for (int64_t i = 0; i < kCapacity; ++i) {
+    m_buffer[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+bool
+WorkStealingDeque::push(Job* job) {
+  int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+  int64_t top = m_top.load(std::memory_order_acquire);
+  if (bottom - top >= kCapacity) {
+    return false;
+  }
+  m_buffer[bottom & (kCapacity - 1)].store(job, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  return true;
+}
+
+Job*
+WorkStealingDeque::pop() {
+  int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+  m_bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = m_top.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    // Cola vaca: se deshace la reserva.
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  Job* job = m_buffer[bottom & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    // ltimo elemento: compite con los ladrones por l.
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      job = nullptr;
+    }
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return job;
+}
+
+Job*
+WorkStealingDeque::steal() {
+  int64_t top = m_top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = m_bottom.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return nullptr;
+  }
+
+  Job* job = m_buffer[top & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return job;
+}
+
+int64_t
+WorkStealingDeque::size() const {
+  int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+  int64_t top = m_top.load(std::memory_order_relaxed);
+  return bottom > top ? bottom - top : 0;
+}
+
+//
+// Topologa
+//
+
+CpuTopology
+detectCpuTopology() {
+  CpuTopology topology;
+  topology.logicalCores = (std::max)(1u, std::thread::hardware_concurrency());
+
+#if defined(_WIN32)
+  DWORD length = 0;
+  GetLogicalProcessorInformation(nullptr, &length);
+  std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+  if (!info.empty() && GetLogicalProcessorInformation(info.data(), &length)) {
+    unsigned int cores = 0;
+    unsigned int packages = 0;
+    for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& entry : info) {
+      if (entry.Relationship == RelationProcessorCore) {
+        ++cores;
+        // El bit ms bajo de la mscara es el primer hilo lgico del ncleo.
+        for (unsigned int bit = 0; bit < sizeof(ULONG_PTR) * 8; ++bit) {
+          if (entry.ProcessorMask & (static_cast<ULONG_PTR>(1) << bit)) {
+            topology.primaryLogicalCores.push_back(bit);
+            break;
+          }
+        }
+      }
+      else if (entry.Relationship == RelationProcessorPackage) {
+        ++packages;
+      }
+    }
+    if (cores > 0) {
+      topology.physicalCores = cores;
+      topology.packages = (std::max)(1u, packages);
+    }
+  }
+#else
+  // sysfs: cada CPU lgica indica su ncleo y su paquete.
+  std::set<std::pair<int, int>> cores;
+  std::set<int> packages;
+  for (unsigned int cpu = 0; cpu < topology.logicalCores; ++cpu) {
+    std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+    std::ifstream coreFile(base + "core_id");
+    std::ifstream packageFile(base + "physical_package_id");
+    int coreId = -1;
+    int packageId = -1;
+    if (!(coreFile >> coreId) || !(packageFile >> packageId)) {
+      continue;
+    }
+    packages.insert(packageId);
+    if (cores.insert({ packageId, coreId }).second) {
+      topology.primaryLogicalCores.push_back(cpu);
+    }
+  }
+  if (!cores.empty()) {
+    topology.physicalCores = static_cast<unsigned int>(cores.size());
+    topology.packages = static_cast<unsigned int>(packages.size());
+  }
+#endif
+
+  // Sin informacin fiable se asume un hilo por ncleo.
+  if (topology.primaryLogicalCores.empty()) {
+    topology.physicalCores = topology.logicalCores;
+    for (unsigned int cpu = 0; cpu < topology.logicalCores; ++cpu) {
+      topology.primaryLogicalCores.push_back(cpu);
+    }
+  }
+  return topology;
+}
+
+//
+// JobSystem
+//
+
+JobSystem&
+JobSystem::instance() {
+  static JobSystem system;
+  return system;
+}
+
+bool
+JobSystem::init(unsigned int workerThreads, bool pinThreads) {
+  if (m_initialized) {
+    return true;
+  }
+  m_topology = detectCpuTopology();
+  if (workerThreads == 0) {
+    // Un hilo por ncleo fsico; el principal ocupa uno de ellos.
+    workerThreads = (std::max)(1u, m_topology.physicalCores - 1);
+  }
+
+  m_stopping = false;
+  m_queuedJobs = 0;
+  m_queues.clear();
+  for (unsigned int i = 0; i <= workerThreads; ++i) {
+    m_queues.emplace_back(new WorkStealingDeque());
+  }
+  t_threadIndex = 0;
+  m_initialized = true;
+
+  for (unsigned int i = 1; i <= workerThreads; ++i) {
+    m_threads.emplace_back(&JobSystem::workerMain, this, i);
+    if (pinThreads) {
+      // El hilo principal queda libre; los trabajadores van a ncleos fsicos distintos.
+      const std::vector<unsigned int>& cores = m_topology.primaryLogicalCores;
+      pinThread(m_threads.back(), cores[i % cores.size()]);
+    }
+  }
+  MESSAGE("JobSystem", "init", "Threads: %u (logical %u, physical %u)",
+          threadCount(), m_topology.logicalCores, m_topology.physicalCores);
+  return true;
+}
+
+void
+JobSystem::destroy() {
+  if (!m_initialized) {
+    return;
+  }
+  // Se vaca el trabajo pendiente antes de parar los hilos.
+  while (m_queuedJobs.load() > 0) {
+    if (!tryRunOne()) {
+      std::this_thread::yield();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    m_stopping = true;
+  }
+  m_wakeUp.notify_all();
+  for (std::thread& thread : m_threads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  m_threads.clear();
+  m_queues.clear();
+  m_initialized = false;
+  t_threadIndex = -1;
+}
+
+void
+JobSystem::run(std::function<void()> function, JobCounter* counter) {
+  if (!m_initialized) {
+    function();
+    return;
+  }
+  if (counter) {
+    counter->m_value.fetch_add(1, std::memory_order_relaxed);
+  }
+  Job* job = new Job();
+  job->function = std::move(function);
+  job->counter = counter;
+  submit(job);
+}
+
+void
+JobSystem::runAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter) {
+  if (counter) {
+    counter->m_value.fetch_add(1, std::memory_order_relaxed);
+  }
+  Job* job = new Job();
+  job->function = std::move(function);
+  job->counter = counter;
+
+  {
+    std::lock_guard<std::mutex> lock(dependency.m_mutex);
+    if (dependency.m_value.load(std::memory_order_acquire) != 0) {
+      dependency.m_continuations.push_back(job);
+      return;
+    }
+  }
+  if (m_initialized) {
+    submit(job);
+  }
+  else {
+    execute(job);
+  }
+}
+
+void
+JobSystem::wait(JobCounter& counter) {
+  while (!counter.isDone()) {
+    if (!tryRunOne()) {
+      std::this_thread::yield();
+    }
+  }
+  // finish() puede seguir dentro del mutex del contador; se espera a que salga
+  // para que el llamador pueda destruir el contador al volver.
+  std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+bool
+JobSystem::tryRunOne() {
+  if (!m_initialized) {
+    return false;
+  }
+  Job* job = findJob(t_threadIndex);
+  if (!job) {
+    return false;
+  }
+  execute(job);
+  return true;
+}
+
+void
+JobSystem::parallelFor(size_t begin, size_t end, const RangeFunction& function, size_t grain) {
+  if (begin >= end) {
+    return;
+  }
+  size_t count = end - begin;
+  if (grain == 0) {
+    // ~8 trozos por hilo: suficientes para repartir carga desigual por robo
+    // sin que el coste de planificar domine en rangos pequeos.
+    size_t threads = (std::max)(1u, threadCount());
+    grain = (std::max)(static_cast<size_t>(1), count / (threads * 8));
+  }
+  if (!m_initialized || threadCount() < 2 || count <= grain) {
+    function(begin, end);
+    return;
+  }
+
+  JobCounter counter;
+  splitRange(begin, end, grain, function, counter);
+  wait(counter);
+}
+
+int
+JobSystem::currentThreadIndex() {
+  return t_threadIndex;
+}
+
+void
+JobSystem::workerMain(unsigned int index) {
+  t_threadIndex = static_cast<int>(index);
+  Profiler::instance().setThreadName("Job worker " + std::to_string(index));
+
+  for (;;) {
+    Job* job = findJob(static_cast<int>(index));
+    if (job) {
+      execute(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    if (m_stopping) {
+      return;
+    }
+    m_sleepers.fetch_add(1);
+    // El timeout acota el coste de una notificacin perdida por un robo fallido.
+    m_wakeUp.wait_for(lock, std::chrono::milliseconds(2), [this]() {
+      return m_stopping.load() || m_queuedJobs.load() > 0;
+    });
+    m_sleepers.fetch_sub(1);
+    if (m_stopping) {
+      return;
+    }
+  }
+}
+
+void
+JobSystem::submit(Job* job) {
+  int index = t_threadIndex;
+  if (index < 0 || index >= static_cast<int>(m_queues.size()) || !m_queues[index]->push(job)) {
+    std::lock_guard<std::mutex> lock(m_injectedMutex);
+    m_injected.push_back(job);
+  }
+  m_queuedJobs.fetch_add(1);
+
+  if (m_sleepers.load() > 0) {
+    // Tomar el mutex evita que el aviso llegue entre la comprobacin y el wait.
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wakeUp.notify_one();
+  }
+}
+
+Job*
+JobSystem::findJob(int index) {
+  Job* job = nullptr;
+  if (index >= 0 && index < static_cast<int>(m_queues.size())) {
+    job = m_queues[index]->pop();
+  }
+
+  if (!job) {
+    std::lock_guard<std::mutex> lock(m_injectedMutex);
+    if (!m_injected.empty()) {
+      job = m_injected.front();
+      m_injected.pop_front();
+    }
+  }
+
+  if (!job) {
+    // Se empieza por una vctima aleatoria para no concentrar los robos.
+    size_t count = m_queues.size();
+    size_t start = count > 0 ? nextRandom() % count : 0;
+    for (size_t i = 0; i < count && !job; ++i) {
+      size_t victim = (start + i) % count;
+      if (static_cast<int>(victim) != index) {
+        job = m_queues[victim]->steal();
+      }
+    }
+  }
+
+  if (job) {
+    m_queuedJobs.fetch_sub(1);
+  }
+  return job;
+}
+
+void
+JobSystem::execute(Job* job) {
+  job->function();
+  finish(job->counter);
+  delete job;
+}
+
+void
+JobSystem::finish(JobCounter* counter) {
+  if (!counter) {
+    return;
+  }
+  std::vector<Job*> ready;
+  {
+    std::lock_guard<std::mutex> lock(counter->m_mutex);
+    if (counter->m_value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      ready.swap(counter->m_continuations);
+    }
+  }
+  for (Job* job : ready) {
+    if (m_initialized) {
+      submit(job);
+    }
+    else {
+      execute(job);
+    }
+  }
+}
+
+void
+JobSystem::splitRange(size_t begin, size_t end, size_t grain, const RangeFunction& function, JobCounter& counter) {
+  // Se publica la mitad derecha y se sigue con la izquierda: los ladrones se
+  // llevan los trozos grandes y el dueo procesa los pequeos con buena localidad.
+  while (end - begin > grain) {
+    size_t middle = begin + (end - begin) / 2;
+    run([this, middle, end, grain, &function, &counter]() {
+      splitRange(middle, end, grain, function, counter);
+    }, &counter);
+    end = middle;
+  }
+  function(begin, end);
+}
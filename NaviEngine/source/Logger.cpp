@@ -0,0 +1,458 @@
+#include "Logger.h"
+#include <chrono>
+#include <cstdarg>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace {
+  // Banderas del estado de un registro (los 30 bits bajos son su tamao).
+  const uint32_t kRecordReady = 0x80000000u;
+  const uint32_t kRecordPadding = 0x40000000u;
+  const uint32_t kRecordSizeMask = 0x3FFFFFFFu;
+
+  const char* const kLevelNames[] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+
+  // Origen de las marcas de tiempo (el primer uso del registro).
+  const std::chrono::steady_clock::time_point g_logStart = std::chrono::steady_clock::now();
+
+  // Nmero de hilo corto y estable para las lneas del registro.
+  std::atomic<uint32_t> g_nextThread{ 1 };
+  thread_local uint32_t t_logThread = 0;
+
+  uint32_t
+  logThread() {
+    if (t_logThread == 0) {
+      t_logThread = g_nextThread.fetch_add(1, std::memory_order_relaxed);
+    }
+    return t_logThread;
+  }
+
+  std::atomic<uint32_t>&
+  recordState(uint8_t* record) {
+    return reinterpret_cast<LogDetail::RecordHeader*>(record)->state;
+  }
+
+  /**
+   * @brief Lector secuencial de los argumentos codificados.
+   */
+  struct
+  ArgReader {
+    const uint8_t* cursor;
+    const uint8_t* end;
+
+    bool
+    next(LogDetail::ArgType& type, uint64_t& bits, const char*& text, uint32_t& length) {
+      if (cursor >= end) {
+        return false;
+      }
+      type = static_cast<LogDetail::ArgType>(*cursor++);
+      if (type == LogDetail::ARG_STRING) {
+        std::memcpy(&length, cursor, sizeof(length));
+        text = reinterpret_cast<const char*>(cursor + sizeof(length));
+        cursor += sizeof(length) + length;
+      }
+      else {
+        std::memcpy(&bits, cursor, 8);
+        cursor += 8;
+      }
+      return true;
+    }
+  };
+
+  int64_t
+  asSigned(LogDetail::ArgType type, uint64_t bits) {
+    if (type == LogDetail::ARG_DOUBLE) {
+      double value;
+      std::memcpy(&value, &bits, 8);
+      return static_cast<int64_t>(value);
+    }
+    return static_cast<int64_t>(bits);
+  }
+
+  double
+  asDouble(LogDetail::ArgType type, uint64_t bits) {
+    if (type == LogDetail::ARG_DOUBLE) {
+      double value;
+      std::memcpy(&value, &bits, 8);
+      return value;
+    }
+    return type == LogDetail::ARG_INT ? static_cast<double>(static_cast<int64_t>(bits)) : static_cast<double>(bits);
+  }
+
+  void
+  appendFormatted(std::string& out, const char* spec, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, spec);
+    int length = std::vsnprintf(buffer, sizeof(buffer), spec, args);
+    va_end(args);
+    if (length > 0) {
+      out.append(buffer, std::min<size_t>(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+  }
+}
+
+void
+StdoutLogSink::write(LogLevel, const char* text, size_t length) {
+  std::fwrite(text, 1, length, stdout);
+}
+
+void
+StdoutLogSink::flush() {
+  std::fflush(stdout);
+}
+
+FileLogSink::FileLogSink(const std::string& fileName) {
+  m_file = std::fopen(fileName.c_str(), "wb");
+}
+
+FileLogSink::~FileLogSink() {
+  if (m_file) {
+    std::fclose(m_file);
+  }
+}
+
+void
+FileLogSink::write(LogLevel, const char* text, size_t length) {
+  if (m_file) {
+    std::fwrite(text, 1, length, m_file);
+  }
+}
+
+void
+FileLogSink::flush() {
+  if (m_file) {
+    std::fflush(m_file);
+  }
+}
+
+void
+DebugOutputLogSink::write(LogLevel, const char* text, size_t) {
+#if defined(_WIN32)
+  OutputDebugStringA(text);
+#else
+  std::fputs(text, stderr);
+#endif
+}
+
+Logger&
+Logger::instance() {
+  static Logger logger;
+  return logger;
+}
+
+Logger::~Logger() {
+  stop();
+}
+
+void
+Logger::addSink(std::unique_ptr<LogSink> sink) {
+  std::lock_guard<std::mutex> lock(m_sinkMutex);
+  m_sinks.push_back(std::move(sink));
+}
+
+void
+Logger::clearSinks() {
+  std::lock_guard<std::mutex> lock(m_sinkMutex);
+  m_sinks.clear();
+}
+
+bool
+Logger::start(size_t capacityBytes) {
+  if (m_running.load(std::memory_order_acquire)) {
+    return false;
+  }
+  size_t capacity = 64 * 1024;
+  while (capacity < capacityBytes) {
+    capacity *= 2;
+  }
+  if (capacity != m_capacity) {
+    m_buffer.reset(new uint8_t[capacity]);
+    m_capacity = capacity;
+    m_mask = capacity - 1;
+  }
+  std::memset(m_buffer.get(), 0, m_capacity);
+  m_head.store(0, std::memory_order_relaxed);
+  m_tail.store(0, std::memory_order_relaxed);
+  m_stopping.store(false, std::memory_order_relaxed);
+  m_running.store(true, std::memory_order_release);
+  m_thread = std::thread(&Logger::consumerLoop, this);
+  return true;
+}
+
+void
+Logger::stop() {
+  if (!m_running.load(std::memory_order_acquire)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_stopping.store(true, std::memory_order_release);
+  }
+  m_wakeUp.notify_one();
+  m_thread.join();
+  m_running.store(false, std::memory_order_release);
+
+  std::lock_guard<std::mutex> lock(m_sinkMutex);
+  for (auto& sink : m_sinks) {
+    sink->flush();
+  }
+}
+
+void
+Logger::flush() {
+  if (m_running.load(std::memory_order_acquire)) {
+    uint64_t target = m_head.load(std::memory_order_acquire);
+    m_wakeUp.notify_one();
+    while (m_tail.load(std::memory_order_acquire) < target) {
+      std::this_thread::yield();
+    }
+  }
+  std::lock_guard<std::mutex> lock(m_sinkMutex);
+  for (auto& sink : m_sinks) {
+    sink->flush();
+  }
+}
+
+uint8_t*
+Logger::reserve(size_t& size) {
+  size = (size + 7) & ~static_cast<size_t>(7);
+  if (size > m_capacity / 4) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  uint64_t head = m_head.load(std::memory_order_relaxed);
+  size_t padding;
+  for (;;) {
+    // Un registro nunca da la vuelta al anillo: si no cabe al final, se rellena hasta el inicio.
+    size_t offset = static_cast<size_t>(head & m_mask);
+    padding = offset + size > m_capacity ? m_capacity - offset : 0;
+    if (head + padding + size - m_tail.load(std::memory_order_acquire) > m_capacity) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    if (m_head.compare_exchange_weak(head, head + padding + size, std::memory_order_relaxed)) {
+      break;
+    }
+  }
+  if (padding != 0) {
+    recordState(m_buffer.get() + (head & m_mask)).store(static_cast<uint32_t>(padding) | kRecordPadding | kRecordReady,
+                                                      std::memory_order_release);
+  }
+  return m_buffer.get() + ((head + padding) & m_mask);
+}
+
+void
+Logger::fillHeader(uint8_t* record, size_t size, LogLevel level, const char* classObj, const char* method,
+                   const char* format, size_t argCount) {
+  LogDetail::RecordHeader* header = reinterpret_cast<LogDetail::RecordHeader*>(record);
+  header->level = static_cast<uint16_t>(level);
+  header->argCount = static_cast<uint16_t>(argCount);
+  header->thread = logThread();
+  header->reserved = 0;
+  header->timestamp = static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_logStart).count());
+  header->classObj = classObj;
+  header->method = method;
+  header->format = format;
+  (void)size;
+}
+
+void
+Logger::commit(uint8_t* record, size_t size, LogLevel level, const char* classObj, const char* method,
+               const char* format, size_t argCount) {
+  fillHeader(record, size, level, classObj, method, format, argCount);
+  recordState(record).store(static_cast<uint32_t>(size) | kRecordReady, std::memory_order_release);
+}
+
+std::vector<uint8_t>&
+Logger::directBuffer() {
+  thread_local std::vector<uint8_t> buffer;
+  return buffer;
+}
+
+void
+Logger::formatRecord(const LogDetail::RecordHeader& header, const uint8_t* args, const uint8_t* end, std::string& out) {
+  appendFormatted(out, "[%10.6f] [%s] [T%u] ", header.timestamp / 1e9,
+                  header.level < 4 ? kLevelNames[header.level] : "?", header.thread);
+  out.append(header.classObj);
+  out.append("::");
+  out.append(header.method);
+  out.append(" : ");
+
+  ArgReader reader = { args, end };
+  const char* format = header.format;
+  while (*format) {
+    const char* percent = std::strchr(format, '%');
+    if (!percent) {
+      out.append(format);
+      break;
+    }
+    out.append(format, percent - format);
+    if (percent[1] == '%') {
+      out.push_back('%');
+      format = percent + 2;
+      continue;
+    }
+
+    // Especificacin: banderas, ancho y precisin se conservan; los
+    // modificadores de longitud se descartan porque el valor ya es de 64 bits.
+    char spec[32];
+    size_t specLength = 0;
+    const char* cursor = percent;
+    spec[specLength++] = *cursor++;
+    while (*cursor && std::strchr("-+ #0123456789.", *cursor) && specLength < sizeof(spec) - 4) {
+      spec[specLength++] = *cursor++;
+    }
+    while (*cursor && std::strchr("hljztL", *cursor)) {
+      ++cursor;
+    }
+    char conversion = *cursor;
+    format = conversion ? cursor + 1 : cursor;
+
+    LogDetail::ArgType type;
+    uint64_t bits = 0;
+    const char* text = nullptr;
+    uint32_t length = 0;
+    if (!reader.next(type, bits, text, length)) {
+      out.append("<missing>");
+      continue;
+    }
+
+    if (type == LogDetail::ARG_STRING) {
+      // Una cadena siempre se escribe como texto, sea cual sea la conversin.
+      out.append(text, length);
+      continue;
+    }
+    switch (conversion) {
+    case 'd':
+    case 'i':
+    case 'c':
+      if (conversion != 'c') {
+        spec[specLength++] = 'l';
+        spec[specLength++] = 'l';
+      }
+      spec[specLength++] = conversion;
+      spec[specLength] = '\0';
+      if (conversion == 'c') {
+        appendFormatted(out, spec, static_cast<int>(asSigned(type, bits)));
+      }
+      else {
+        appendFormatted(out, spec, static_cast<long long>(asSigned(type, bits)));
+      }
+      break;
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+      spec[specLength++] = 'l';
+      spec[specLength++] = 'l';
+      spec[specLength++] = conversion;
+      spec[specLength] = '\0';
+      appendFormatted(out, spec, static_cast<unsigned long long>(
+        type == LogDetail::ARG_DOUBLE ? static_cast<uint64_t>(asSigned(type, bits)) : bits));
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      spec[specLength++] = conversion;
+      spec[specLength] = '\0';
+      appendFormatted(out, spec, asDouble(type, bits));
+      break;
+    case 'p':
+      appendFormatted(out, "0x%llx", static_cast<unsigned long long>(bits));
+      break;
+    default:
+      // %s con un nmero (o una conversin desconocida): se escribe el valor tal cual.
+      if (type == LogDetail::ARG_DOUBLE) {
+        appendFormatted(out, "%g", asDouble(type, bits));
+      }
+      else if (type == LogDetail::ARG_INT) {
+        appendFormatted(out, "%lld", static_cast<long long>(bits));
+      }
+      else {
+        appendFormatted(out, type == LogDetail::ARG_POINTER ? "0x%llx" : "%llu", static_cast<unsigned long long>(bits));
+      }
+      break;
+    }
+  }
+  out.push_back('\n');
+}
+
+void
+Logger::dispatch(const LogDetail::RecordHeader& header, const uint8_t* args, const uint8_t* end) {
+  std::lock_guard<std::mutex> lock(m_sinkMutex);
+  m_line.clear();
+  formatRecord(header, args, end, m_line);
+  LogLevel level = static_cast<LogLevel>(header.level);
+  if (m_sinks.empty()) {
+    m_defaultSink.write(level, m_line.c_str(), m_line.size());
+  }
+  for (auto& sink : m_sinks) {
+    sink->write(level, m_line.c_str(), m_line.size());
+  }
+}
+
+size_t
+Logger::drain() {
+  size_t processed = 0;
+  uint64_t tail = m_tail.load(std::memory_order_relaxed);
+  while (tail != m_head.load(std::memory_order_acquire)) {
+    uint8_t* record = m_buffer.get() + (tail & m_mask);
+    uint32_t state = recordState(record).load(std::memory_order_acquire);
+    if (!(state & kRecordReady)) {
+      // Un productor reserv pero an no publica: se retoma en la siguiente vuelta.
+      break;
+    }
+    size_t size = state & kRecordSizeMask;
+    if (!(state & kRecordPadding)) {
+      dispatch(*reinterpret_cast<const LogDetail::RecordHeader*>(record), record + sizeof(LogDetail::RecordHeader),
+               record + size);
+      ++processed;
+    }
+    // El espacio se devuelve a cero: la cabecera del prximo registro que caiga aqu empieza sin publicar.
+    std::memset(record, 0, size);
+    tail += size;
+    m_tail.store(tail, std::memory_order_release);
+  }
+
+  uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+  if (dropped != m_reportedDrops) {
+    uint64_t lost = dropped - m_reportedDrops;
+    m_reportedDrops = dropped;
+    LogDetail::RecordHeader header{};
+    header.level = LOG_LEVEL_WARNING;
+    header.thread = logThread();
+    header.classObj = "Logger";
+    header.method = "drain";
+    header.format = "%llu messages dropped (ring buffer full)";
+    uint8_t args[9];
+    LogDetail::encode(args, static_cast<unsigned long long>(lost));
+    dispatch(header, args, args + sizeof(args));
+  }
+  return processed;
+}
+
+void
+Logger::consumerLoop() {
+  for (;;) {
+    bool stopping = m_stopping.load(std::memory_order_acquire);
+    size_t processed = drain();
+    if (stopping && m_tail.load(std::memory_order_relaxed) == m_head.load(std::memory_order_acquire)) {
+      break;
+    }
+    if (processed == 0) {
+      // Sin trabajo se duerme hasta 1 ms: los productores no despiertan al hilo
+      // para no pagar un mutex en cada mensaje.
+      std::unique_lock<std::mutex> lock(m_wakeMutex);
+      m_wakeUp.wait_for(lock, std::chrono::milliseconds(1));
+    }
+  }
+}
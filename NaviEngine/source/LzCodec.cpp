@@ -0,0 +1,186 @@
+#include "LzCodec.h"
+#include "Profiler.h"
+#include <cstring>
+
+namespace {
+  const size_t kMinMatch = 4;
+  const size_t kMaxOffset = 65535;
+  const unsigned int kHashBits = 16;
+  const uint32_t kEmpty = 0xFFFFFFFFu;
+
+  inline uint32_t
+  load32(const uint8_t* at) {
+    uint32_t value;
+    std::memcpy(&value, at, 4);
+    return value;
+  }
+
+  inline uint32_t
+  hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+  }
+
+  /**
+   * @brief Escribe la extensin de una longitud que no cabe en el nibble (ya restado 15).
+   */
+  inline void
+  writeLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+      out.push_back(255);
+      length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+  }
+
+  /**
+   * @brief Emite una secuencia: literales [literals, literals + literalCount) y, si
+   *        @p matchLength != 0, la coincidencia.
+   */
+  void
+  writeSequence(std::vector<uint8_t>& out,
+                const uint8_t* literals,
+                size_t literalCount,
+                size_t offset,
+                size_t matchLength) {
+    size_t matchCode = matchLength != 0 ? matchLength - kMinMatch : 0;
+    uint8_t token = static_cast<uint8_t>((literalCount >= 15 ? 15 : literalCount) << 4);
+    token |= static_cast<uint8_t>(matchCode >= 15 ? 15 : matchCode);
+    out.push_back(token);
+    if (literalCount >= 15) {
+      writeLength(out, literalCount - 15);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0) {
+      return;
+    }
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) {
+      writeLength(out, matchCode - 15);
+    }
+  }
+
+  /**
+   * @brief Lee la extensin de una longitud. Devuelve false si el bloque se acaba.
+   */
+  inline bool
+  readLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t next;
+    do {
+      if (in >= end) {
+        return false;
+      }
+      next = *in++;
+      length += next;
+    } while (next == 255);
+    return true;
+  }
+}
+
+size_t
+lzCompressBound(size_t size) {
+  // Peor caso: todo literales, un byte de extensin cada 255 y el token.
+  return size + size / 255 + 16;
+}
+
+size_t
+lzCompress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+  NAVI_PROFILE_SCOPE("lzCompress");
+  out.clear();
+  out.reserve(lzCompressBound(size));
+  if (size < kMinMatch + 1) {
+    writeSequence(out, src, size, 0, 0);
+    return out.size();
+  }
+
+  std::vector<uint32_t> table(size_t(1) << kHashBits, kEmpty);
+  size_t anchor = 0;
+  size_t at = 0;
+  while (at + kMinMatch <= size) {
+    uint32_t sequence = load32(src + at);
+    uint32_t& slot = table[hashSequence(sequence)];
+    size_t candidate = slot;
+    slot = static_cast<uint32_t>(at);
+
+    if (candidate == kEmpty || at - candidate > kMaxOffset || load32(src + candidate) != sequence) {
+      // Sin coincidencia: el paso crece en zonas incompresibles para no perder tiempo en ellas.
+      at += 1 + ((at - anchor) >> 6);
+      continue;
+    }
+
+    // Se extiende hacia atrs sobre los literales pendientes y hacia delante hasta el final.
+    while (at > anchor && candidate > 0 && src[at - 1] == src[candidate - 1]) {
+      --at;
+      --candidate;
+    }
+    size_t length = kMinMatch;
+    while (at + length < size && src[candidate + length] == src[at + length]) {
+      ++length;
+    }
+    writeSequence(out, src + anchor, at - anchor, at - candidate, length);
+    at += length;
+    anchor = at;
+
+    // La posicin anterior al final de la coincidencia tambin entra en la tabla.
+    if (at >= 2 && at - 2 + kMinMatch <= size) {
+      table[hashSequence(load32(src + at - 2))] = static_cast<uint32_t>(at - 2);
+    }
+  }
+  writeSequence(out, src + anchor, size - anchor, 0, 0);
+  return out.size();
+}
+
+bool
+lzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+  NAVI_PROFILE_SCOPE("lzDecompress");
+  const uint8_t* in = src;
+  const uint8_t* inEnd = src + srcSize;
+  uint8_t* out = dst;
+  uint8_t* outEnd = dst + dstSize;
+
+  while (in < inEnd) {
+    uint8_t token = *in++;
+    size_t literalCount = token >> 4;
+    if (literalCount == 15 && !readLength(in, inEnd, literalCount)) {
+      return false;
+    }
+    if (literalCount > static_cast<size_t>(inEnd - in) || literalCount > static_cast<size_t>(outEnd - out)) {
+      return false;
+    }
+    if (literalCount != 0) {
+      std::memcpy(out, in, literalCount);
+    }
+    in += literalCount;
+    out += literalCount;
+    if (in == inEnd) {
+      break;
+    }
+
+    if (inEnd - in < 2) {
+      return false;
+    }
+    size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+    in += 2;
+    size_t length = token & 15;
+    if (length == 15 && !readLength(in, inEnd, length)) {
+      return false;
+    }
+    length += kMinMatch;
+    if (offset == 0 || offset > static_cast<size_t>(out - dst) || length > static_cast<size_t>(outEnd - out)) {
+      return false;
+    }
+
+    // Con desplazamiento menor que la longitud la copia se solapa y repite un patrn.
+    const uint8_t* match = out - offset;
+    if (offset >= length) {
+      std::memcpy(out, match, length);
+      out += length;
+    }
+    else {
+      for (size_t i = 0; i < length; ++i) {
+        *out++ = match[i];
+      }
+    }
+  }
+  return out == outEnd;
+}
@@ -0,0 +1,131 @@
+#include "MappedFile.h"
+#include <algorithm>
+#include <utility>
+
+#if defined(_WIN32)
+#include "Prerequisites.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile&
+MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_file, other.m_file);
+    std::swap(m_mapping, other.m_mapping);
+  }
+  return *this;
+}
+
+#if defined(_WIN32)
+bool
+MappedFile::open(const std::string& path) {
+  close();
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  LARGE_INTEGER size = {};
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    CloseHandle(file);
+    return false;
+  }
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  m_file = file;
+  m_mapping = mapping;
+  m_data = static_cast<const uint8_t*>(view);
+  m_size = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+void
+MappedFile::close() {
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file) {
+    CloseHandle(m_file);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_file = nullptr;
+  m_mapping = nullptr;
+}
+#else
+bool
+MappedFile::open(const std::string& path) {
+  close();
+  int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(descriptor, &info) != 0 || info.st_size <= 0) {
+    ::close(descriptor);
+    return false;
+  }
+  void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+  // La proyeccin sigue siendo vlida despus de cerrar el descriptor.
+  ::close(descriptor);
+  if (view == MAP_FAILED) {
+    return false;
+  }
+  m_data = static_cast<const uint8_t*>(view);
+  m_size = static_cast<size_t>(info.st_size);
+  return true;
+}
+
+void
+MappedFile::close() {
+  if (m_data) {
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+}
+#endif
+
+void
+MappedFile::prefetch(size_t offset, size_t size) const {
+  if (!m_data || offset >= m_size) {
+    return;
+  }
+  size = std::min(size, m_size - offset);
+  const size_t kPageSize = 4096;
+#if !defined(_WIN32)
+  size_t begin = offset & ~(kPageSize - 1);
+  madvise(const_cast<uint8_t*>(m_data) + begin, offset + size - begin, MADV_WILLNEED);
+#endif
+  volatile uint8_t sink = 0;
+  for (size_t at = offset; at < offset + size; at += kPageSize) {
+    sink = static_cast<uint8_t>(sink + m_data[at]);
+  }
+  if (size != 0) {
+    sink = static_cast<uint8_t>(sink + m_data[offset + size - 1]);
+  }
+  (void)sink;
+}
@@ -0,0 +1,400 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#ifndef NAVI_METRICS_TRACK_ALLOCATIONS
+#define NAVI_METRICS_TRACK_ALLOCATIONS 1
+#endif
+
+namespace {
+  // Inicializacin constante: vlido aunque operator new se llame antes que
+  // cualquier constructor esttico.
+  std::atomic<uint64_t> g_allocationCount{ 0 };
+
+  void
+  atomicAdd(std::atomic<double>& target, double value) {
+    double expected = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::string
+  prometheusName(const std::string& name) {
+    return "navi_" + name;
+  }
+
+  /**
+   * @brief Nombre del archivo CSV alternativo @p index: "a/b.csv" -> "a/b_2.csv".
+   */
+  std::string
+  numberedFileName(const std::string& fileName, unsigned int index) {
+    size_t slash = fileName.find_last_of("/\\");
+    size_t dot = fileName.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+      dot = fileName.size();
+    }
+    return fileName.substr(0, dot) + '_' + std::to_string(index) + fileName.substr(dot);
+  }
+
+  /**
+   * @brief Primera lnea del archivo; vaca si no existe o est vaco.
+   */
+  std::string
+  firstLine(const std::string& fileName) {
+    std::ifstream is(fileName);
+    std::string line;
+    std::getline(is, line);
+    return line;
+  }
+}
+
+#if NAVI_METRICS_TRACK_ALLOCATIONS
+// Reemplazo global de new/delete para contar asignaciones por frame.
+// Las variantes de arreglo y con tamao delegan en estas por defecto.
+void*
+operator new(std::size_t size) {
+  g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void
+operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+#endif
+
+void
+MetricCounter::endFrame() {
+  uint64_t value = m_current.exchange(0, std::memory_order_relaxed);
+  m_lastFrame.store(value, std::memory_order_relaxed);
+  m_total.fetch_add(value, std::memory_order_relaxed);
+}
+
+MetricHistogram::MetricHistogram(std::string name,
+                                 std::string help,
+                                 double minValue,
+                                 double maxValue,
+                                 unsigned int bucketsPerOctave)
+  : m_name(std::move(name)),
+    m_help(std::move(help)),
+    m_minValue(minValue > 0.0 ? minValue : 1e-9),
+    m_logMin(std::log2(m_minValue)),
+    m_bucketsPerLog2(static_cast<double>(std::max(1u, bucketsPerOctave))) {
+  double octaves = std::log2(std::max(maxValue, m_minValue * 2.0)) - m_logMin;
+  m_bucketCount = static_cast<size_t>(std::ceil(octaves * m_bucketsPerLog2)) + 1;
+  m_buckets.reset(new std::atomic<uint64_t>[m_bucketCount]);
+  for (size_t i = 0; i < m_bucketCount; ++i) {
+    m_buckets[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void
+MetricHistogram::record(double value) {
+  size_t bucket = 0;
+  if (value > m_minValue) {
+    double position = (std::log2(value) - m_logMin) * m_bucketsPerLog2;
+    bucket = std::min(m_bucketCount - 1, static_cast<size_t>(position));
+  }
+  m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  atomicAdd(m_sum, value);
+}
+
+double
+MetricHistogram::percentile(double p) const {
+  uint64_t total = count();
+  if (total == 0) {
+    return 0.0;
+  }
+  p = std::min(1.0, std::max(0.0, p));
+  uint64_t rank = static_cast<uint64_t>(std::ceil(p * static_cast<double>(total)));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t accumulated = 0;
+  for (size_t i = 0; i < m_bucketCount; ++i) {
+    accumulated += m_buckets[i].load(std::memory_order_relaxed);
+    if (accumulated >= rank) {
+      // Media geomtrica de los lmites de la cubeta.
+      return std::exp2(m_logMin + (static_cast<double>(i) + 0.5) / m_bucketsPerLog2);
+    }
+  }
+  return std::exp2(m_logMin + static_cast<double>(m_bucketCount) / m_bucketsPerLog2);
+}
+
+void
+MetricHistogram::reset() {
+  for (size_t i = 0; i < m_bucketCount; ++i) {
+    m_buckets[i].store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_sum.store(0.0, std::memory_order_relaxed);
+}
+
+MetricsRegistry&
+MetricsRegistry::instance() {
+  static MetricsRegistry registry;
+  return registry;
+}
+
+MetricsRegistry::MetricsRegistry() {
+  m_lastAllocationCount = g_allocationCount.load(std::memory_order_relaxed);
+}
+
+MetricCounter&
+MetricsRegistry::counter(const std::string& name, const std::string& help) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& c : m_counters) {
+    if (c->name() == name) return *c;
+  }
+  m_counters.push_back(std::make_unique<MetricCounter>(name, help));
+  return *m_counters.back();
+}
+
+MetricGauge&
+MetricsRegistry::gauge(const std::string& name, const std::string& help) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& g : m_gauges) {
+    if (g->name() == name) return *g;
+  }
+  m_gauges.push_back(std::make_unique<MetricGauge>(name, help));
+  return *m_gauges.back();
+}
+
+MetricHistogram&
+MetricsRegistry::histogram(const std::string& name,
+                           const std::string& help,
+                           double minValue,
+                           double maxValue,
+                           unsigned int bucketsPerOctave) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& h : m_histograms) {
+    if (h->name() == name) return *h;
+  }
+  m_histograms.push_back(std::make_unique<MetricHistogram>(name, help, minValue, maxValue, bucketsPerOctave));
+  return *m_histograms.back();
+}
+
+void
+MetricsRegistry::endFrame(double frameSeconds) {
+  EngineMetrics::frameTime().record(frameSeconds);
+  EngineMetrics::frameTimeMs().set(frameSeconds * 1000.0);
+
+  uint64_t allocations = g_allocationCount.load(std::memory_order_relaxed);
+  EngineMetrics::allocationsPerFrame().set(static_cast<double>(allocations - m_lastAllocationCount));
+  m_lastAllocationCount = allocations;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& c : m_counters) {
+    c->endFrame();
+  }
+  ++m_frameIndex;
+}
+
+void
+MetricsRegistry::setDumpTargets(const std::string& csvFile,
+                                const std::string& prometheusFile,
+                                double intervalSeconds) {
+  EngineMetrics::registerAll();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_csvFile = csvFile;
+  m_prometheusFile = prometheusFile;
+  m_dumpInterval = intervalSeconds;
+  m_nextDump = 0.0;
+  m_csvTarget.clear();
+}
+
+bool
+MetricsRegistry::dumpIfDue(double now) {
+  if (m_dumpInterval <= 0.0 || now < m_nextDump) {
+    return false;
+  }
+  m_nextDump = now + m_dumpInterval;
+  bool ok = true;
+  if (!m_csvFile.empty()) {
+    ok = writeCsv(m_csvFile) && ok;
+  }
+  if (!m_prometheusFile.empty()) {
+    ok = writePrometheus(m_prometheusFile) && ok;
+  }
+
+  // Los percentiles de la siguiente fila cubren solo el siguiente intervalo.
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& h : m_histograms) {
+    h->reset();
+  }
+  return ok;
+}
+
+std::string
+MetricsRegistry::csvHeader() const {
+  std::string header = "frame";
+  for (auto& c : m_counters) header += ',' + c->name();
+  for (auto& g : m_gauges) header += ',' + g->name();
+  for (auto& h : m_histograms) {
+    header += ',' + h->name() + "_p50," + h->name() + "_p95," + h->name() + "_p99";
+  }
+  return header;
+}
+
+bool
+MetricsRegistry::writeCsv(const std::string& fileName) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::string header = csvHeader();
+
+  // Se elige el archivo al empezar y cuando cambia el conjunto de mtricas: el
+  // pedido o el primer <nombre>_<n> que est vaco o tenga la misma cabecera.
+  // Nunca se trunca, para conservar las filas de ejecuciones anteriores.
+  bool writeHeader = false;
+  if (fileName != m_csvTarget || header != m_csvHeader) {
+    std::string path = fileName;
+    for (unsigned int index = 1; ; ++index) {
+      std::string existing = firstLine(path);
+      if (existing.empty() || existing == header) {
+        writeHeader = existing.empty();
+        break;
+      }
+      if (index == 1000) {
+        return false;
+      }
+      path = numberedFileName(fileName, index);
+    }
+    m_csvTarget = fileName;
+    m_csvPath = path;
+    m_csvHeader = header;
+  }
+
+  std::ofstream os(m_csvPath, std::ios::app);
+  if (!os.is_open()) {
+    return false;
+  }
+  if (writeHeader) {
+    os << header << '\n';
+  }
+  os << m_frameIndex;
+  for (auto& c : m_counters) os << ',' << c->lastFrame();
+  for (auto& g : m_gauges) os << ',' << g->value();
+  for (auto& h : m_histograms) {
+    os << ',' << h->percentile(0.50) << ',' << h->percentile(0.95) << ',' << h->percentile(0.99);
+  }
+  os << '\n';
+  return os.good();
+}
+
+bool
+MetricsRegistry::writePrometheus(const std::string& fileName) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // Se escribe en un temporal y se renombra para que un lector nunca vea el archivo a medias.
+  std::string tempName = fileName + ".tmp";
+  {
+    std::ofstream os(tempName, std::ios::trunc);
+    if (!os.is_open()) {
+      return false;
+    }
+    for (auto& c : m_counters) {
+      std::string name = prometheusName(c->name());
+      os << "# HELP " << name << "_total " << c->help() << '\n'
+         << "# TYPE " << name << "_total counter\n"
+         << name << "_total " << c->total() << '\n'
+         << "# HELP " << name << "_last_frame " << c->help() << " (last frame)\n"
+         << "# TYPE " << name << "_last_frame gauge\n"
+         << name << "_last_frame " << c->lastFrame() << '\n';
+    }
+    for (auto& g : m_gauges) {
+      std::string name = prometheusName(g->name());
+      os << "# HELP " << name << ' ' << g->help() << '\n'
+         << "# TYPE " << name << " gauge\n"
+         << name << ' ' << g->value() << '\n';
+    }
+    for (auto& h : m_histograms) {
+      std::string name = prometheusName(h->name());
+      os << "# HELP " << name << ' ' << h->help() << '\n'
+         << "# TYPE " << name << " summary\n"
+         << name << "{quantile=\"0.5\"} " << h->percentile(0.50) << '\n'
+         << name << "{quantile=\"0.95\"} " << h->percentile(0.95) << '\n'
+         << name << "{quantile=\"0.99\"} " << h->percentile(0.99) << '\n'
+         << name << "_sum " << h->sum() << '\n'
+         << name << "_count " << h->count() << '\n';
+    }
+    if (!os.good()) {
+      return false;
+    }
+  }
+  std::remove(fileName.c_str());
+  return std::rename(tempName.c_str(), fileName.c_str()) == 0;
+}
+
+namespace
+EngineMetrics {
+  MetricCounter&
+  drawCalls() {
+    static MetricCounter& metric = MetricsRegistry::instance().counter("draw_calls", "Draw calls issued");
+    return metric;
+  }
+
+  MetricCounter&
+  stateChanges() {
+    static MetricCounter& metric = MetricsRegistry::instance().counter("state_changes", "Pipeline state changes");
+    return metric;
+  }
+
+  MetricCounter&
+  bytesUploaded() {
+    static MetricCounter& metric = MetricsRegistry::instance().counter("bytes_uploaded", "Bytes uploaded to the GPU");
+    return metric;
+  }
+
+  MetricCounter&
+  trianglesSubmitted() {
+    static MetricCounter& metric = MetricsRegistry::instance().counter("triangles_submitted", "Triangles submitted for drawing");
+    return metric;
+  }
+
+  MetricGauge&
+  allocationsPerFrame() {
+    static MetricGauge& metric = MetricsRegistry::instance().gauge("allocations_per_frame", "Heap allocations in the last frame");
+    return metric;
+  }
+
+  MetricGauge&
+  frameTimeMs() {
+    static MetricGauge& metric = MetricsRegistry::instance().gauge("frame_time_ms", "Duration of the last frame in milliseconds");
+    return metric;
+  }
+
+  MetricHistogram&
+  frameTime() {
+    static MetricHistogram& metric = MetricsRegistry::instance().histogram(
+      "frame_time_seconds", "Frame time distribution in seconds", 1e-5, 10.0);
+    return metric;
+  }
+
+  void
+  registerAll() {
+    drawCalls();
+    stateChanges();
+    bytesUploaded();
+    trianglesSubmitted();
+    allocationsPerFrame();
+    frameTimeMs();
+    frameTime();
+  }
+
+  uint64_t
+  allocationCount() {
+    return g_allocationCount.load(std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,409 @@
+#include "MipGenerator.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NAVI_MIP_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+  //
+  // Operaciones sobre un pxel RGBA en coma flotante.
+  //
+#if defined(NAVI_MIP_SSE)
+  using Vec4 = __m128;
+
+  inline Vec4 load4(const float* p) { return _mm_loadu_ps(p); }
+  inline void store4(float* p, Vec4 v) { _mm_storeu_ps(p, v); }
+  inline Vec4 splat4(float value) { return _mm_set1_ps(value); }
+  inline Vec4 add4(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+  inline Vec4 mul4(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+  inline Vec4 zero4() { return _mm_setzero_ps(); }
+#else
+  struct
+  Vec4 {
+    float v[4];
+  };
+
+  inline Vec4 load4(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+  inline void store4(float* p, Vec4 a) { std::memcpy(p, a.v, sizeof(a.v)); }
+  inline Vec4 splat4(float value) { return { { value, value, value, value } }; }
+  inline Vec4 add4(Vec4 a, Vec4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+  inline Vec4 mul4(Vec4 a, Vec4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+  inline Vec4 zero4() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+#endif
+
+  /**
+   * @brief Imagen RGBA en coma flotante (espacio lineal).
+   */
+  struct
+  FloatImage {
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<float> data;
+
+    void
+    resize(unsigned int w, unsigned int h) {
+      width = w;
+      height = h;
+      data.resize(static_cast<size_t>(w) * h * 4);
+    }
+
+    float*
+    row(unsigned int y) { return data.data() + static_cast<size_t>(y) * width * 4; }
+
+    const float*
+    row(unsigned int y) const { return data.data() + static_cast<size_t>(y) * width * 4; }
+  };
+
+  /**
+   * @brief Tablas de conversin sRGB <-> lineal.
+   *
+   * La codificacin usa 16 bits de entrada: cerca del negro la curva sRGB es muy
+   * pronunciada y una tabla de 8 o 12 bits pierde precisin en las sombras.
+   */
+  struct
+  SrgbTables {
+    float toLinear[256];
+    uint8_t toSrgb[65536];
+
+    SrgbTables() {
+      for (int i = 0; i < 256; ++i) {
+        float c = i / 255.0f;
+        toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+      }
+      for (int i = 0; i < 65536; ++i) {
+        float l = i / 65535.0f;
+        float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+        toSrgb[i] = static_cast<uint8_t>(std::min(255.0f, c * 255.0f + 0.5f));
+      }
+    }
+  };
+
+  const SrgbTables&
+  srgbTables() {
+    static const SrgbTables tables;
+    return tables;
+  }
+
+  void
+  decodeLevel(const uint8_t* rgba, unsigned int width, unsigned int height, bool srgb, FloatImage& out) {
+    const SrgbTables& tables = srgbTables();
+    out.resize(width, height);
+    JobSystem::instance().parallelFor(0, height, [&](size_t begin, size_t end) {
+      for (size_t y = begin; y < end; ++y) {
+        const uint8_t* src = rgba + y * width * 4;
+        float* dst = out.row(static_cast<unsigned int>(y));
+        for (unsigned int i = 0; i < width * 4; i += 4) {
+          for (int c = 0; c < 3; ++c) {
+            dst[i + c] = srgb ? tables.toLinear[src[i + c]] : src[i + c] / 255.0f;
+          }
+          dst[i + 3] = src[i + 3] / 255.0f;
+        }
+      }
+    });
+  }
+
+  void
+  encodeLevel(const FloatImage& image, bool srgb, float alphaScale, MipLevel& out) {
+    const SrgbTables& tables = srgbTables();
+    out.width = image.width;
+    out.height = image.height;
+    out.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+    JobSystem::instance().parallelFor(0, image.height, [&](size_t begin, size_t end) {
+      for (size_t y = begin; y < end; ++y) {
+        const float* src = image.row(static_cast<unsigned int>(y));
+        uint8_t* dst = out.pixels.data() + y * image.width * 4;
+        for (unsigned int i = 0; i < image.width * 4; i += 4) {
+          for (int c = 0; c < 3; ++c) {
+            float value = std::min(1.0f, std::max(0.0f, src[i + c]));
+            dst[i + c] = srgb ? tables.toSrgb[static_cast<int>(value * 65535.0f + 0.5f)]
+                              : static_cast<uint8_t>(value * 255.0f + 0.5f);
+          }
+          float alpha = std::min(1.0f, std::max(0.0f, src[i + 3] * alphaScale));
+          dst[i + 3] = static_cast<uint8_t>(alpha * 255.0f + 0.5f);
+        }
+      }
+    });
+  }
+
+  void
+  downsampleBox(const FloatImage& src, FloatImage& dst) {
+    dst.resize(std::max(1u, src.width / 2), std::max(1u, src.height / 2));
+    const Vec4 quarter = splat4(0.25f);
+    JobSystem::instance().parallelFor(0, dst.height, [&](size_t begin, size_t end) {
+      for (size_t y = begin; y < end; ++y) {
+        unsigned int y0 = std::min(static_cast<unsigned int>(y) * 2, src.height - 1);
+        unsigned int y1 = std::min(y0 + 1, src.height - 1);
+        const float* row0 = src.row(y0);
+        const float* row1 = src.row(y1);
+        float* out = dst.row(static_cast<unsigned int>(y));
+        for (unsigned int x = 0; x < dst.width; ++x) {
+          unsigned int x0 = std::min(x * 2, src.width - 1) * 4;
+          unsigned int x1 = std::min(x * 2 + 1, src.width - 1) * 4;
+          Vec4 sum = add4(add4(load4(row0 + x0), load4(row0 + x1)),
+                          add4(load4(row1 + x0), load4(row1 + x1)));
+          store4(out + x * 4, mul4(sum, quarter));
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Funcin de Bessel modificada de primera especie, orden 0 (serie de potencias).
+   */
+  double
+  besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    double quarterSquare = x * x * 0.25;
+    for (int k = 1; k < 32 && term > sum * 1e-12; ++k) {
+      term *= quarterSquare / (static_cast<double>(k) * k);
+      sum += term;
+    }
+    return sum;
+  }
+
+  /**
+   * @brief Pesos del filtro de Kaiser para reducir @p srcSize a @p dstSize muestras.
+   */
+  struct
+  FilterTaps {
+    std::vector<int> first;     /**< Primera muestra de origen de cada destino. */
+    std::vector<int> count;     /**< Nmero de muestras de cada destino. */
+    std::vector<float> weights; /**< count[i] pesos normalizados por destino, con paso maxTaps. */
+    int maxTaps = 0;
+  };
+
+  FilterTaps
+  buildKaiserTaps(unsigned int srcSize, unsigned int dstSize, const MipSettings& settings) {
+    FilterTaps taps;
+    double ratio = static_cast<double>(srcSize) / dstSize;
+    double radius = settings.kaiserWidth * ratio;
+    double normalization = besselI0(settings.kaiserAlpha);
+    taps.maxTaps = static_cast<int>(std::ceil(radius)) * 2 + 1;
+    taps.first.resize(dstSize);
+    taps.count.resize(dstSize);
+    taps.weights.assign(static_cast<size_t>(dstSize) * taps.maxTaps, 0.0f);
+
+    for (unsigned int i = 0; i < dstSize; ++i) {
+      double center = (i + 0.5) * ratio;
+      int first = static_cast<int>(std::floor(center - radius));
+      int last = static_cast<int>(std::ceil(center + radius));
+      double total = 0.0;
+      int count = 0;
+      std::vector<double> weights;
+      for (int s = first; s <= last && count < taps.maxTaps; ++s) {
+        double d = (s + 0.5 - center) / ratio;
+        double t = (s + 0.5 - center) / radius;
+        double weight = 0.0;
+        if (std::fabs(t) < 1.0) {
+          double sinc = std::fabs(d) < 1e-9 ? 1.0 : std::sin(3.14159265358979 * d) / (3.14159265358979 * d);
+          weight = sinc * besselI0(settings.kaiserAlpha * std::sqrt(1.0 - t * t)) / normalization;
+        }
+        weights.push_back(weight);
+        total += weight;
+        ++count;
+      }
+      taps.first[i] = first;
+      taps.count[i] = count;
+      for (int k = 0; k < count; ++k) {
+        taps.weights[static_cast<size_t>(i) * taps.maxTaps + k] = static_cast<float>(weights[k] / total);
+      }
+    }
+    return taps;
+  }
+
+  void
+  downsampleKaiser(const FloatImage& src, FloatImage& dst, const MipSettings& settings) {
+    unsigned int dstWidth = std::max(1u, src.width / 2);
+    unsigned int dstHeight = std::max(1u, src.height / 2);
+    FilterTaps horizontal = buildKaiserTaps(src.width, dstWidth, settings);
+    FilterTaps vertical = buildKaiserTaps(src.height, dstHeight, settings);
+
+    // Filtro separable: primero las filas (dstWidth x srcHeight), luego las columnas.
+    FloatImage temp;
+    temp.resize(dstWidth, src.height);
+    JobSystem::instance().parallelFor(0, src.height, [&](size_t begin, size_t end) {
+      for (size_t y = begin; y < end; ++y) {
+        const float* in = src.row(static_cast<unsigned int>(y));
+        float* out = temp.row(static_cast<unsigned int>(y));
+        for (unsigned int x = 0; x < dstWidth; ++x) {
+          const float* weights = &horizontal.weights[static_cast<size_t>(x) * horizontal.maxTaps];
+          Vec4 sum = zero4();
+          for (int k = 0; k < horizontal.count[x]; ++k) {
+            int s = std::min(std::max(horizontal.first[x] + k, 0), static_cast<int>(src.width) - 1);
+            sum = add4(sum, mul4(load4(in + s * 4), splat4(weights[k])));
+          }
+          store4(out + x * 4, sum);
+        }
+      }
+    });
+
+    dst.resize(dstWidth, dstHeight);
+    JobSystem::instance().parallelFor(0, dstHeight, [&](size_t begin, size_t end) {
+      for (size_t y = begin; y < end; ++y) {
+        const float* weights = &vertical.weights[y * vertical.maxTaps];
+        float* out = dst.row(static_cast<unsigned int>(y));
+        for (unsigned int x = 0; x < dstWidth; ++x) {
+          store4(out + x * 4, zero4());
+        }
+        for (int k = 0; k < vertical.count[y]; ++k) {
+          int s = std::min(std::max(vertical.first[y] + k, 0), static_cast<int>(src.height) - 1);
+          const float* in = temp.row(static_cast<unsigned int>(s));
+          Vec4 weight = splat4(weights[k]);
+          for (unsigned int x = 0; x < dstWidth; ++x) {
+            store4(out + x * 4, add4(load4(out + x * 4), mul4(load4(in + x * 4), weight)));
+          }
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Histograma de alpha para evaluar la cobertura con cualquier escala en O(bins).
+   */
+  struct
+  AlphaHistogram {
+    static const int kBins = 1024;
+    std::vector<uint64_t> counts = std::vector<uint64_t>(kBins + 1, 0);
+    uint64_t total = 0;
+
+    explicit AlphaHistogram(const FloatImage& image) {
+      for (size_t i = 3; i < image.data.size(); i += 4) {
+        float alpha = std::min(1.0f, std::max(0.0f, image.data[i]));
+        ++counts[static_cast<int>(alpha * kBins)];
+      }
+      total = image.data.size() / 4;
+    }
+
+    /**
+     * @brief Fraccin de pxeles con alpha * scale > reference.
+     */
+    float
+    coverage(float reference, float scale) const {
+      if (scale <= 0.0f) {
+        return 0.0f;
+      }
+      float threshold = reference / scale;
+      if (threshold >= 1.0f) {
+        return 0.0f;
+      }
+      uint64_t covered = 0;
+      for (int bin = static_cast<int>(threshold * kBins) + 1; bin <= kBins; ++bin) {
+        covered += counts[bin];
+      }
+      return static_cast<float>(covered) / total;
+    }
+  };
+
+  /**
+   * @brief Escala de alpha que iguala la cobertura de @p image a @p target (bsqueda binaria).
+   */
+  float
+  findAlphaScale(const FloatImage& image, float reference, float target) {
+    AlphaHistogram histogram(image);
+    float low = 0.0f;
+    float high = 16.0f;
+    for (int i = 0; i < 24; ++i) {
+      float middle = (low + high) * 0.5f;
+      if (histogram.coverage(reference, middle) < target) {
+        low = middle;
+      }
+      else {
+        high = middle;
+      }
+    }
+    // En niveles pequeos la cobertura avanza a saltos: se elige el extremo ms cercano.
+    float lowError = std::fabs(histogram.coverage(reference, low) - target);
+    float highError = std::fabs(histogram.coverage(reference, high) - target);
+    return lowError < highError ? low : high;
+  }
+}
+
+unsigned int
+mipLevelCount(unsigned int width, unsigned int height) {
+  unsigned int levels = 1;
+  unsigned int size = std::max(width, height);
+  while (size > 1) {
+    size /= 2;
+    ++levels;
+  }
+  return levels;
+}
+
+bool
+generateMipChain(const uint8_t* rgba,
+                 unsigned int width,
+                 unsigned int height,
+                 const MipSettings& settings,
+                 MipChain& chain) {
+  if (!rgba || width == 0 || height == 0) {
+    chain.levels.clear();
+    return false;
+  }
+  std::vector<uint8_t> pixels(rgba, rgba + static_cast<size_t>(width) * height * 4);
+  return generateMipChain(std::move(pixels), width, height, settings, chain);
+}
+
+bool
+generateMipChain(std::vector<uint8_t>&& rgba,
+                 unsigned int width,
+                 unsigned int height,
+                 const MipSettings& settings,
+                 MipChain& chain) {
+  NAVI_PROFILE_SCOPE("generateMipChain");
+  chain.levels.clear();
+  chain.channels = 4;
+  size_t baseBytes = static_cast<size_t>(width) * height * 4;
+  if (width == 0 || height == 0 || rgba.size() < baseBytes) {
+    return false;
+  }
+
+  unsigned int levelCount = mipLevelCount(width, height);
+  if (settings.maxLevels != 0) {
+    levelCount = std::min(levelCount, settings.maxLevels);
+  }
+  chain.levels.resize(levelCount);
+
+  MipLevel& base = chain.levels[0];
+  base.width = width;
+  base.height = height;
+  // El bfer se adopta como nivel 0: reducirlo no reserva ni copia.
+  base.pixels = std::move(rgba);
+  base.pixels.resize(baseBytes);
+  if (levelCount == 1) {
+    return true;
+  }
+
+  FloatImage current;
+  FloatImage next;
+  decodeLevel(base.pixels.data(), width, height, settings.srgb, current);
+  float targetCoverage = 0.0f;
+  if (settings.preserveAlphaCoverage) {
+    targetCoverage = AlphaHistogram(current).coverage(settings.alphaReference, 1.0f);
+  }
+
+  // Cada nivel parte del anterior sin escalar: la correccin de cobertura solo
+  // se aplica al codificar, para que no se acumule de un nivel al siguiente.
+  for (unsigned int level = 1; level < levelCount; ++level) {
+    if (settings.filter == MIP_FILTER_KAISER) {
+      downsampleKaiser(current, next, settings);
+    }
+    else {
+      downsampleBox(current, next);
+    }
+
+    float alphaScale = 1.0f;
+    if (settings.preserveAlphaCoverage) {
+      alphaScale = findAlphaScale(next, settings.alphaReference, targetCoverage);
+    }
+    encodeLevel(next, settings.srgb, alphaScale, chain.levels[level]);
+    std::swap(current, next);
+  }
+  return true;
+}
@@ -1,5 +1,6 @@
 #include "ModelLoader.h"
 #include "ParserOBJ.h"
+#include "Profiler.h"
 
 void
 ModelLoader::init()
@@ -28,6 +29,7 @@ ModelLoader::destroy()
 LoadData
 ModelLoader::Load(std::string objFileName)
 {
+  NAVI_PROFILE_SCOPE("ModelLoader::Load");
   LoadData LD;                       // Estructura donde se almacenarn los datos del modelo.
   objl::Loader m_loader;              // Instancia temporal del cargador OBJ.
 
@@ -58,11 +60,61 @@ ModelLoader::Load(std::string objFileName)
   }
 
   size_t indexCount = m_loader.LoadedIndices.size();   // Nmero total de ndices cargados.
-  LD.index.resize(indexCount);                         // Redimensiona el vector de ndices.
-  LD.index = m_loader.LoadedIndices;                   // Copia los ndices cargados.
+  LD.index.assign(m_loader.LoadedIndices.begin(), m_loader.LoadedIndices.end()); // Copia los ndices cargados.
 
   LD.numVertex = (int)vertexCount;                     // Guarda la cantidad de vrtices.
   LD.numIndex = (int)indexCount;                       // Guarda la cantidad de ndices.
 
   return LD;                                           // Retorna la estructura con los datos del modelo cargado.
 }
+
+LoadData
+ModelLoader::CreateCube(float halfExtent)
+{
+  LoadData LD;
+  LD.name = "PlaceholderCube";
+
+  // Cada cara: normal y los dos ejes que la recorren (u, v).
+  const float faces[6][9] = {
+    {  0.0f,  1.0f,  0.0f,   1.0f, 0.0f,  0.0f,   0.0f, 0.0f,  1.0f },
+    {  0.0f, -1.0f,  0.0f,   1.0f, 0.0f,  0.0f,   0.0f, 0.0f, -1.0f },
+    { -1.0f,  0.0f,  0.0f,   0.0f, 0.0f, -1.0f,   0.0f, 1.0f,  0.0f },
+    {  1.0f,  0.0f,  0.0f,   0.0f, 0.0f,  1.0f,   0.0f, 1.0f,  0.0f },
+    {  0.0f,  0.0f, -1.0f,   1.0f, 0.0f,  0.0f,   0.0f, 1.0f,  0.0f },
+    {  0.0f,  0.0f,  1.0f,  -1.0f, 0.0f,  0.0f,   0.0f, 1.0f,  0.0f },
+  };
+  const float corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+
+  for (int f = 0; f < 6; f++)
+  {
+    const float* n = faces[f];
+    const float* u = faces[f] + 3;
+    const float* v = faces[f] + 6;
+    unsigned int base = static_cast<unsigned int>(LD.vertex.size());
+
+    for (int c = 0; c < 4; c++)
+    {
+      SimpleVertex vertex;
+      vertex.Pos.x = (n[0] + u[0] * corners[c][0] + v[0] * corners[c][1]) * halfExtent;
+      vertex.Pos.y = (n[1] + u[1] * corners[c][0] + v[1] * corners[c][1]) * halfExtent;
+      vertex.Pos.z = (n[2] + u[2] * corners[c][0] + v[2] * corners[c][1]) * halfExtent;
+      vertex.Tex.x = (corners[c][0] + 1.0f) * 0.5f;
+      vertex.Tex.y = (1.0f - corners[c][1]) * 0.5f;
+      vertex.Normal.x = n[0];
+      vertex.Normal.y = n[1];
+      vertex.Normal.z = n[2];
+      LD.vertex.push_back(vertex);
+    }
+
+    // Orden horario visto desde fuera (culling por defecto de Direct3D).
+    const unsigned int quad[6] = { 0, 2, 1, 0, 3, 2 };
+    for (unsigned int i : quad)
+    {
+      LD.index.push_back(base + i);
+    }
+  }
+
+  LD.numVertex = static_cast<int>(LD.vertex.size());
+  LD.numIndex = static_cast<int>(LD.index.size());
+  return LD;
+}
@@ -0,0 +1,293 @@
+#include "PakFile.h"
+#include "LzCodec.h"
+#include "MappedFile.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+namespace {
+  const char kMagic[4] = { 'N', 'P', 'A', 'K' };
+  const uint64_t kTocAlignment = 64;
+
+  static_assert(sizeof(PakHeader) == 48, "PakHeader layout");
+  static_assert(sizeof(PakEntry) == 48, "PakEntry layout");
+
+  uint64_t
+  alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  void
+  setError(std::string* error, const std::string& message) {
+    if (error) {
+      *error = message;
+    }
+  }
+}
+
+std::string
+normalizePakPath(const std::string& path) {
+  std::string out;
+  out.reserve(path.size());
+  for (size_t i = 0; i < path.size(); ++i) {
+    char c = path[i] == '\\' ? '/' : path[i];
+    if (c == '/' && (out.empty() || out.back() == '/')) {
+      continue;
+    }
+    // "./" al principio de un segmento no cambia la ruta.
+    if (c == '.' && (out.empty() || out.back() == '/') &&
+        (i + 1 == path.size() || path[i + 1] == '/' || path[i + 1] == '\\')) {
+      ++i;
+      continue;
+    }
+    out += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+  }
+  return out;
+}
+
+uint64_t
+pakPathHash(const std::string& path) {
+  std::string normalized = normalizePakPath(path);
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : normalized) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+void
+PakWriter::setAlignment(uint32_t bytes) {
+  // Se redondea a potencia de 2 (mnimo 16).
+  uint32_t alignment = 16;
+  while (alignment < bytes && alignment < (1u << 20)) {
+    alignment <<= 1;
+  }
+  m_alignment = alignment;
+}
+
+bool
+PakWriter::add(const std::string& path, const uint8_t* data, size_t size, bool compress) {
+  Pending entry;
+  entry.name = normalizePakPath(path);
+  entry.hash = pakPathHash(entry.name);
+  entry.size = size;
+  if (entry.name.empty() || entry.name.size() > 0xFFFFu) {
+    return false;
+  }
+  for (const Pending& existing : m_entries) {
+    if (existing.hash == entry.hash && existing.name == entry.name) {
+      return false;
+    }
+  }
+
+  if (compress && size >= 64) {
+    lzCompress(data, size, entry.stored);
+    if (entry.stored.size() <= size - size / 8) {
+      entry.flags |= PAK_ENTRY_LZ;
+    }
+  }
+  if (!(entry.flags & PAK_ENTRY_LZ)) {
+    entry.stored.assign(data, data + size);
+  }
+  m_originalBytes += entry.size;
+  m_storedBytes += entry.stored.size();
+  m_entries.push_back(std::move(entry));
+  return true;
+}
+
+bool
+PakWriter::write(const std::string& fileName, std::string* error) const {
+  NAVI_PROFILE_SCOPE("PakWriter::write");
+  // Nombres en el orden de la tabla (por hash) y datos en el orden de insercin.
+  std::vector<size_t> order(m_entries.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    const Pending& left = m_entries[a];
+    const Pending& right = m_entries[b];
+    return left.hash != right.hash ? left.hash < right.hash : left.name < right.name;
+  });
+
+  PakHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kPakVersion;
+  header.entryCount = static_cast<uint32_t>(m_entries.size());
+  header.alignment = m_alignment;
+  header.tocOffset = alignUp(sizeof(PakHeader), kTocAlignment);
+  header.namesOffset = header.tocOffset + sizeof(PakEntry) * m_entries.size();
+
+  std::vector<PakEntry> toc(m_entries.size());
+  std::string names;
+  for (size_t i = 0; i < order.size(); ++i) {
+    const Pending& pending = m_entries[order[i]];
+    PakEntry& entry = toc[i];
+    entry.hash = pending.hash;
+    entry.size = pending.size;
+    entry.storedSize = pending.stored.size();
+    entry.flags = pending.flags;
+    entry.nameOffset = static_cast<uint32_t>(names.size());
+    entry.nameLength = static_cast<uint32_t>(pending.name.size());
+    names += pending.name;
+  }
+  header.namesSize = names.size();
+  header.dataOffset = alignUp(header.namesOffset + names.size(), m_alignment);
+
+  std::vector<uint64_t> offsets(m_entries.size());
+  uint64_t offset = header.dataOffset;
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    offsets[i] = offset;
+    offset = alignUp(offset + m_entries[i].stored.size(), m_alignment);
+  }
+  for (size_t i = 0; i < order.size(); ++i) {
+    toc[i].offset = offsets[order[i]];
+  }
+
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    setError(error, "cannot create " + fileName);
+    return false;
+  }
+  uint64_t written = 0;
+  auto pad = [&file, &written](uint64_t target) {
+    static const char kZeros[256] = {};
+    while (written < target) {
+      uint64_t count = std::min<uint64_t>(target - written, sizeof(kZeros));
+      file.write(kZeros, static_cast<std::streamsize>(count));
+      written += count;
+    }
+  };
+  auto put = [&file, &written](const void* data, size_t size) {
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    written += size;
+  };
+
+  put(&header, sizeof(header));
+  pad(header.tocOffset);
+  put(toc.data(), sizeof(PakEntry) * toc.size());
+  put(names.data(), names.size());
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    pad(offsets[i]);
+    put(m_entries[i].stored.data(), m_entries[i].stored.size());
+  }
+  file.flush();
+  if (!file) {
+    setError(error, "write error on " + fileName);
+    return false;
+  }
+  return true;
+}
+
+bool
+PakArchive::load(const std::string& fileName, std::string* error) {
+  close();
+  auto file = std::make_shared<MappedFile>();
+  if (!file->open(fileName)) {
+    setError(error, "cannot open " + fileName);
+    return false;
+  }
+
+  PakHeader header;
+  if (file->size() < sizeof(header)) {
+    setError(error, "file too small");
+    return false;
+  }
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kPakVersion) {
+    setError(error, "not a version " + std::to_string(kPakVersion) + " pak file");
+    return false;
+  }
+
+  // Todos los rangos deben caer dentro del archivo antes de leer la tabla en su sitio.
+  uint64_t fileSize = file->size();
+  uint64_t tocBytes = static_cast<uint64_t>(header.entryCount) * sizeof(PakEntry);
+  if (header.tocOffset % alignof(PakEntry) != 0 || header.tocOffset > fileSize ||
+      tocBytes > fileSize - header.tocOffset ||
+      header.namesOffset > fileSize || header.namesSize > fileSize - header.namesOffset) {
+    setError(error, "corrupt table of contents");
+    return false;
+  }
+  const PakEntry* entries = reinterpret_cast<const PakEntry*>(file->data() + header.tocOffset);
+  for (uint32_t i = 0; i < header.entryCount; ++i) {
+    const PakEntry& entry = entries[i];
+    bool sorted = i == 0 || entries[i - 1].hash <= entry.hash;
+    bool inside = entry.offset <= fileSize && entry.storedSize <= fileSize - entry.offset &&
+                  static_cast<uint64_t>(entry.nameOffset) + entry.nameLength <= header.namesSize;
+    // Cada byte de un bloque LZ produce como mucho 255 (una extensin de
+    // longitud), ms el token final: un tamao mayor es corrupto y reservarlo
+    // en extract() podra agotar la memoria.
+    bool sized = (entry.flags & PAK_ENTRY_LZ)
+                   ? entry.size != 0 && entry.size <= entry.storedSize * 255 + 16
+                   : entry.size == entry.storedSize;
+    if (!sorted || !inside || !sized) {
+      setError(error, "corrupt entry " + std::to_string(i));
+      return false;
+    }
+  }
+
+  m_entries = entries;
+  m_count = header.entryCount;
+  m_names = reinterpret_cast<const char*>(file->data() + header.namesOffset);
+  m_file = std::move(file);
+  return true;
+}
+
+void
+PakArchive::close() {
+  m_file.reset();
+  m_entries = nullptr;
+  m_count = 0;
+  m_names = nullptr;
+}
+
+std::string
+PakArchive::entryName(const PakEntry& entry) const {
+  return std::string(m_names + entry.nameOffset, entry.nameLength);
+}
+
+const PakEntry*
+PakArchive::find(const std::string& path) const {
+  if (!m_file) {
+    return nullptr;
+  }
+  std::string name = normalizePakPath(path);
+  uint64_t hash = pakPathHash(name);
+  const PakEntry* end = m_entries + m_count;
+  const PakEntry* found = std::lower_bound(m_entries, end, hash, [](const PakEntry& entry, uint64_t value) {
+    return entry.hash < value;
+  });
+  // Entradas con el mismo hash: decide el nombre.
+  for (; found != end && found->hash == hash; ++found) {
+    if (found->nameLength == name.size() && std::memcmp(m_names + found->nameOffset, name.data(), name.size()) == 0) {
+      return found;
+    }
+  }
+  return nullptr;
+}
+
+bool
+PakArchive::extract(const PakEntry& entry, FileView& view) const {
+  if (!m_file) {
+    return false;
+  }
+  const uint8_t* stored = m_file->data() + entry.offset;
+  if (!(entry.flags & PAK_ENTRY_LZ)) {
+    view = FileView(m_file, stored, static_cast<size_t>(entry.size));
+    return true;
+  }
+  std::vector<uint8_t> bytes(static_cast<size_t>(entry.size));
+  if (!lzDecompress(stored, static_cast<size_t>(entry.storedSize), bytes.data(), bytes.size())) {
+    return false;
+  }
+  view = FileView(std::move(bytes));
+  return true;
+}
+
+bool
+PakArchive::open(const std::string& path, FileView& view) const {
+  const PakEntry* entry = find(path);
+  return entry && extract(*entry, view);
+}
@@ -1,5 +1,7 @@
 #include "ParserOBJ.h" 
-#include <fstream>     // Para leer archivos (std::ifstream)
+#include "Allocators.h" // Para los temporales del parseo (LinearAllocator)
+#include "FileSystem.h" // Para leer archivos (sueltos o dentro de un .pak)
+#include <istream>     // Para leer el archivo por lneas (std::istream)
 #include <sstream>     // Para procesar lneas (std::stringstream)
 #include <map>         // Para el cach de vrtices (std::map)
 
@@ -30,19 +32,30 @@ objl::Loader::LoadFile(std::string fileName)
 void 
 objl::Loader::Parse(std::string fileName)
 {
+  // Los temporales viven en un bloque lineal que se libera de una vez al salir,
+  // en lugar de pedir y devolver al heap cada nodo del cach.
+  LinearAllocator scratch(256 * 1024, MEMORY_LOADER);
+
   //Almacenamiento temporal ara los datos leidos el .obj
-  std::vector<XMFLOAT3> temp_positions;
-  std::vector<XMFLOAT2> temp_texcoords;
-  std::vector<XMFLOAT3> temp_normals;
+  LinearVector<XMFLOAT3> temp_positions{ LinearStlAllocator<XMFLOAT3>(scratch) };
+  LinearVector<XMFLOAT2> temp_texcoords{ LinearStlAllocator<XMFLOAT2>(scratch) };
+  LinearVector<XMFLOAT3> temp_normals{ LinearStlAllocator<XMFLOAT3>(scratch) };
 
   // Cache de vrtices para la indexacin
-  std::map<std::string, unsigned int> vertexCache;
+  LinearMap<std::string, unsigned int> vertexCache{ LinearStlAllocator<std::pair<const std::string, unsigned int>>(scratch) };
+
+  // Se reutilizan entre caras para no reservar por cada una.
+  std::vector<std::string> faceVertices; //Almacenamiento "1/1/1", "2/2/2" ...
+  std::vector<int> indices; // v, vt, vn
 
-  std::ifstream file(fileName);
-  if (!file.is_open()) {
+  // El archivo se lee directamente de la vista del VFS, sin copiarlo.
+  FileView view;
+  if (!VirtualFileSystem::instance().open(fileName, view)) {
     ERROR("ParserOBJ", "Parse", "No se pudo abrir el archivo .obj");
     return; // Salimos de la funcin si no se puede abrir
   }
+  FileViewBuffer buffer(view);
+  std::istream file(&buffer);
 
   std::string line;
   while (std::getline(file, line))
@@ -76,7 +89,7 @@ objl::Loader::Parse(std::string fileName)
     // Leer Caras (la parte de indexacin)
     else if (prefix == "f") {
       std::string faceVeretxStr;
-      std::vector<std::string> faceVertices; //Almacenamiento "1/1/1", "2/2/2" ...
+      faceVertices.clear();
 
       //Lee todos los vertices de la cara (ya sean 3 = triangulos, 4 = quad, etc)
       while (ss >> faceVeretxStr) {
@@ -109,7 +122,7 @@ objl::Loader::Parse(std::string fileName)
             //Vertice nuevo (Cache miss)
             std::stringstream ss_face(vertexKey);
             std::string segment;
-            std::vector<int> indices; // v, vt, vn
+            indices.clear();
 
             //Parser "v/vt/vn" (o "v//vn", o "v/vt")
             while (std::getline(ss_face, segment, '/')) {
@@ -173,8 +186,6 @@ objl::Loader::Parse(std::string fileName)
     }
   }
 
-  file.close();
-
   // No se devuelve nada. La funcin LoadFile() se encarga
   // de revisar los miembros LoadedVertices y LoadedIndices que se llamen aqu.
 }
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "PixelFormat.h"
+#include "Profiler.h"
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NAVI_PIXEL_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+  /**
+   * @brief Conversin de un pxel; es la referencia de los ncleos vectoriales.
+   */
+  inline void
+  convertPixel(const uint8_t* src, unsigned int srcChannels, uint8_t* dst, unsigned int dstChannels) {
+    uint8_t r = src[0];
+    uint8_t g = srcChannels >= 3 ? src[1] : r;
+    uint8_t b = srcChannels >= 3 ? src[2] : r;
+    uint8_t a = srcChannels == 2 ? src[1] : srcChannels == 4 ? src[3] : 255;
+    if (dstChannels == 1) {
+      dst[0] = r;
+    }
+    else if (dstChannels == 2) {
+      dst[0] = r;
+      dst[1] = srcChannels <= 2 ? a : g;
+    }
+    else {
+      dst[0] = r;
+      dst[1] = g;
+      dst[2] = b;
+      dst[3] = a;
+    }
+  }
+
+  void
+  convertScalar(const uint8_t* src, unsigned int srcChannels, uint8_t* dst, unsigned int dstChannels,
+                size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      convertPixel(src + i * srcChannels, srcChannels, dst + i * dstChannels, dstChannels);
+    }
+  }
+
+  /**
+   * @brief RGB -> RGBA leyendo 4 bytes por pxel y fijando el alpha (sin leer fuera del bfer).
+   */
+  size_t
+  expandRgb(const uint8_t* src, uint8_t* dst, size_t count) {
+    if (count < 2) {
+      return 0;
+    }
+    size_t i = 0;
+    for (; i + 1 < count; ++i) {
+      uint32_t pixel;
+      std::memcpy(&pixel, src + i * 3, 4);
+      pixel = (pixel & 0x00FFFFFFu) | 0xFF000000u;
+      std::memcpy(dst + i * 4, &pixel, 4);
+    }
+    return i;
+  }
+
+#if defined(NAVI_PIXEL_SSE)
+  /**
+   * @brief Ncleos de 16 pxeles por iteracin. Devuelven cuntos pxeles procesaron.
+   */
+  size_t
+  grayToRgba(const uint8_t* src, uint8_t* dst, size_t count, bool hasAlpha) {
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    if (!hasAlpha) {
+      for (; i + 16 <= count; i += 16) {
+        __m128i gray = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i pairs0 = _mm_unpacklo_epi8(gray, gray);
+        __m128i pairs1 = _mm_unpackhi_epi8(gray, gray);
+        __m128i* out = reinterpret_cast<__m128i*>(dst + i * 4);
+        _mm_storeu_si128(out + 0, _mm_or_si128(_mm_unpacklo_epi16(pairs0, pairs0), alpha));
+        _mm_storeu_si128(out + 1, _mm_or_si128(_mm_unpackhi_epi16(pairs0, pairs0), alpha));
+        _mm_storeu_si128(out + 2, _mm_or_si128(_mm_unpacklo_epi16(pairs1, pairs1), alpha));
+        _mm_storeu_si128(out + 3, _mm_or_si128(_mm_unpackhi_epi16(pairs1, pairs1), alpha));
+      }
+      return i;
+    }
+    // Gris + alpha: cada par (g, a) de 16 bits pasa a 32 bits como g | g<<8 | g<<16 | a<<24.
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+    for (; i + 8 <= count; i += 8) {
+      __m128i pairs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+      __m128i halves[2] = { _mm_unpacklo_epi16(pairs, zero), _mm_unpackhi_epi16(pairs, zero) };
+      for (int h = 0; h < 2; ++h) {
+        __m128i g = _mm_and_si128(halves[h], lowByte);
+        __m128i a = _mm_slli_epi32(_mm_srli_epi32(halves[h], 8), 24);
+        __m128i rgb = _mm_or_si128(_mm_or_si128(g, _mm_slli_epi32(g, 8)), _mm_slli_epi32(g, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i + h * 4) * 4), _mm_or_si128(rgb, a));
+      }
+    }
+    return i;
+  }
+
+  size_t
+  rgbaToRg(const uint8_t* src, uint8_t* dst, size_t count, bool singleChannel) {
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      const __m128i* in = reinterpret_cast<const __m128i*>(src + i * 4);
+      __m128i p0 = _mm_loadu_si128(in + 0);
+      __m128i p1 = _mm_loadu_si128(in + 1);
+      __m128i p2 = _mm_loadu_si128(in + 2);
+      __m128i p3 = _mm_loadu_si128(in + 3);
+      if (singleChannel) {
+        // R en el byte bajo de cada palabra de 32 bits; dos empaquetados lo juntan.
+        __m128i lo = _mm_packs_epi32(_mm_and_si128(p0, lowByte), _mm_and_si128(p1, lowByte));
+        __m128i hi = _mm_packs_epi32(_mm_and_si128(p2, lowByte), _mm_and_si128(p3, lowByte));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+      }
+      else {
+        // RG en los 16 bits bajos: se extienden con signo para que packs no sature.
+        p0 = _mm_srai_epi32(_mm_slli_epi32(p0, 16), 16);
+        p1 = _mm_srai_epi32(_mm_slli_epi32(p1, 16), 16);
+        p2 = _mm_srai_epi32(_mm_slli_epi32(p2, 16), 16);
+        p3 = _mm_srai_epi32(_mm_slli_epi32(p3, 16), 16);
+        __m128i* out = reinterpret_cast<__m128i*>(dst + i * 2);
+        _mm_storeu_si128(out + 0, _mm_packs_epi32(p0, p1));
+        _mm_storeu_si128(out + 1, _mm_packs_epi32(p2, p3));
+      }
+    }
+    return i;
+  }
+
+  size_t
+  grayAlphaToGray(const uint8_t* src, uint8_t* dst, size_t count) {
+    const __m128i lowByte = _mm_set1_epi16(0xFF);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      const __m128i* in = reinterpret_cast<const __m128i*>(src + i * 2);
+      __m128i lo = _mm_and_si128(_mm_loadu_si128(in + 0), lowByte);
+      __m128i hi = _mm_and_si128(_mm_loadu_si128(in + 1), lowByte);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+  }
+
+  size_t
+  grayToGrayAlpha(const uint8_t* src, uint8_t* dst, size_t count) {
+    const __m128i opaque = _mm_set1_epi8(static_cast<char>(0xFF));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+      __m128i gray = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      __m128i* out = reinterpret_cast<__m128i*>(dst + i * 2);
+      _mm_storeu_si128(out + 0, _mm_unpacklo_epi8(gray, opaque));
+      _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(gray, opaque));
+    }
+    return i;
+  }
+#endif
+}
+
+ImageFormat
+chooseImageFormat(unsigned int sourceChannels, TextureUsage usage) {
+  ImageFormat format;
+  switch (usage) {
+  case TEXTURE_USAGE_AUTO:
+    format.channels = sourceChannels == 1 ? 1 : sourceChannels == 2 ? 2 : 4;
+    format.color = format.channels == 4;
+    break;
+  case TEXTURE_USAGE_COLOR:
+    break;
+  case TEXTURE_USAGE_COLOR_SRGB:
+    format.srgb = true;
+    break;
+  case TEXTURE_USAGE_DATA:
+    format.color = false;
+    break;
+  case TEXTURE_USAGE_MASK:
+    format.channels = 1;
+    format.color = false;
+    break;
+  case TEXTURE_USAGE_NORMAL_XY:
+    format.channels = 2;
+    format.color = false;
+    break;
+  }
+  format.dxgiFormat = format.channels == 1 ? 61   // DXGI_FORMAT_R8_UNORM
+                    : format.channels == 2 ? 49   // DXGI_FORMAT_R8G8_UNORM
+                    : format.srgb ? 29 : 28;      // DXGI_FORMAT_R8G8B8A8_UNORM(_SRGB)
+  return format;
+}
+
+bool
+convertChannels(const uint8_t* src,
+                unsigned int srcChannels,
+                uint8_t* dst,
+                unsigned int dstChannels,
+                size_t pixelCount) {
+  if (srcChannels < 1 || srcChannels > 4 || (dstChannels != 1 && dstChannels != 2 && dstChannels != 4)) {
+    return false;
+  }
+  if (srcChannels == dstChannels) {
+    std::memcpy(dst, src, pixelCount * srcChannels);
+    return true;
+  }
+
+  size_t done = 0;
+  if (srcChannels == 3 && dstChannels == 4) {
+    done = expandRgb(src, dst, pixelCount);
+  }
+#if defined(NAVI_PIXEL_SSE)
+  else if (srcChannels <= 2 && dstChannels == 4) {
+    done = grayToRgba(src, dst, pixelCount, srcChannels == 2);
+  }
+  else if (srcChannels == 4) {
+    done = rgbaToRg(src, dst, pixelCount, dstChannels == 1);
+  }
+  else if (srcChannels == 2 && dstChannels == 1) {
+    done = grayAlphaToGray(src, dst, pixelCount);
+  }
+  else if (srcChannels == 1 && dstChannels == 2) {
+    done = grayToGrayAlpha(src, dst, pixelCount);
+  }
+#endif
+  convertScalar(src, srcChannels, dst, dstChannels, done, pixelCount);
+  return true;
+}
+
+bool
+buildMipChain(DecodedImage&& image, const ImageFormat& format, unsigned int channels, MipChain& chain) {
+  NAVI_PROFILE_SCOPE("buildMipChain");
+  size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+  if (pixelCount == 0 || image.channels < 1 || image.channels > 4 ||
+      image.pixels.size() < pixelCount * image.channels) {
+    return false;
+  }
+
+  // Los mips se generan en RGBA8; una imagen con menos canales se expande antes.
+  ImageDecoder& decoder = ImageDecoder::instance();
+  std::vector<uint8_t> rgba;
+  if (image.channels == 4) {
+    rgba = std::move(image.pixels);
+  }
+  else {
+    rgba = decoder.acquire(pixelCount * 4);
+    convertChannels(image.pixels.data(), image.channels, rgba.data(), 4, pixelCount);
+    decoder.recycle(std::move(image.pixels));
+  }
+
+  MipSettings settings;
+  settings.srgb = format.color;
+  if (!generateMipChain(std::move(rgba), image.width, image.height, settings, chain)) {
+    return false;
+  }
+  if (channels == 4) {
+    return true;
+  }
+
+  for (MipLevel& level : chain.levels) {
+    size_t levelPixels = static_cast<size_t>(level.width) * level.height;
+    std::vector<uint8_t> reduced = decoder.acquire(levelPixels * channels);
+    convertChannels(level.pixels.data(), 4, reduced.data(), channels, levelPixels);
+    decoder.recycle(std::move(level.pixels));
+    level.pixels = std::move(reduced);
+  }
+  chain.channels = channels;
+  return true;
+}
@@ -0,0 +1,266 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+std::atomic<bool> Profiler::s_enabled{ false };
+
+namespace {
+  // Buffer del hilo actual. Lo posee el Profiler, por lo que sigue siendo
+  // vlido aunque el hilo termine antes de vaciarlo.
+  thread_local ProfileThreadBuffer* t_threadBuffer = nullptr;
+
+  void
+  writeJsonString(std::ostream& os, const char* text) {
+    os << '"';
+    for (const char* c = text; *c; ++c) {
+      switch (*c) {
+      case '"':  os << "\\\""; break;
+      case '\\': os << "\\\\"; break;
+      case '\n': os << "\\n"; break;
+      case '\t': os << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(*c));
+          os << buffer;
+        }
+        else {
+          os << *c;
+        }
+      }
+    }
+    os << '"';
+  }
+
+  template<typename T>
+  void
+  writePod(std::ofstream& os, T value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+ProfileThreadBuffer::ProfileThreadBuffer(uint32_t threadId, std::string threadName)
+  : m_threadId(threadId),
+    m_threadName(std::move(threadName)),
+    m_events(new ProfileEvent[kCapacity]) {
+}
+
+size_t
+ProfileThreadBuffer::drain(std::vector<ProfileEvent>& out) {
+  uint64_t tail = m_tail.load(std::memory_order_relaxed);
+  uint64_t head = m_head.load(std::memory_order_acquire);
+  for (uint64_t i = tail; i != head; ++i) {
+    out.push_back(m_events[i & (kCapacity - 1)]);
+  }
+  m_tail.store(head, std::memory_order_release);
+  return static_cast<size_t>(head - tail);
+}
+
+Profiler&
+Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+uint64_t
+Profiler::now() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void
+Profiler::setEnabled(bool enabled) {
+  if (enabled && !isEnabled()) {
+    m_frameStart = now();
+  }
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+ProfileThreadBuffer*
+Profiler::threadBuffer() {
+  if (!t_threadBuffer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t id = static_cast<uint32_t>(m_threads.size());
+    // El orden de registro depende de qu hilo perfila primero (puede ser un
+    // trabajador del JobSystem): el nombre real lo pone cada hilo con setThreadName().
+    m_threads.push_back(std::make_unique<ProfileThreadBuffer>(id, "Thread " + std::to_string(id)));
+    t_threadBuffer = m_threads.back().get();
+  }
+  return t_threadBuffer;
+}
+
+void
+Profiler::setThreadName(const std::string& name) {
+  ProfileThreadBuffer* buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  buffer->m_threadName = name;
+}
+
+void
+Profiler::endFrame() {
+  if (!isEnabled()) {
+    return;
+  }
+  uint64_t frameEnd = now();
+  m_lastFrameDuration = frameEnd - m_frameStart;
+  m_frameStart = frameEnd;
+  ++m_frameIndex;
+
+  m_frameEvents.clear();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& thread : m_threads) {
+      thread->drain(m_frameEvents);
+    }
+    if (m_capturing) {
+      size_t room = m_captureLimit - std::min(m_captureLimit, m_capture.size());
+      size_t count = std::min(room, m_frameEvents.size());
+      m_capture.insert(m_capture.end(), m_frameEvents.begin(), m_frameEvents.begin() + count);
+    }
+  }
+  aggregate(m_frameEvents);
+}
+
+void
+Profiler::aggregate(std::vector<ProfileEvent>& events) {
+  // Orden por hilo y por inicio (a igual inicio, el padre va antes que el hijo)
+  // para poder reconstruir la jerarqua con una pila.
+  std::sort(events.begin(), events.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+    if (a.threadId != b.threadId) return a.threadId < b.threadId;
+    if (a.start != b.start) return a.start < b.start;
+    return a.depth < b.depth;
+  });
+
+  std::vector<uint64_t> childTime(events.size(), 0);
+  std::vector<size_t> stack;
+  uint32_t currentThread = UINT32_MAX;
+  for (size_t i = 0; i < events.size(); ++i) {
+    const ProfileEvent& e = events[i];
+    if (e.threadId != currentThread) {
+      stack.clear();
+      currentThread = e.threadId;
+    }
+    while (!stack.empty() && events[stack.back()].end <= e.start) {
+      stack.pop_back();
+    }
+    if (!stack.empty()) {
+      childTime[stack.back()] += e.end - e.start;
+    }
+    stack.push_back(i);
+  }
+
+  // Agregacin por nombre (los nombres son literales: se comparan por puntero).
+  std::unordered_map<const char*, size_t> index;
+  m_lastFrame.clear();
+  for (size_t i = 0; i < events.size(); ++i) {
+    const ProfileEvent& e = events[i];
+    uint64_t duration = e.end - e.start;
+    auto it = index.find(e.name);
+    if (it == index.end()) {
+      it = index.emplace(e.name, m_lastFrame.size()).first;
+      ProfileZoneStats stats;
+      stats.name = e.name;
+      stats.depth = e.depth;
+      m_lastFrame.push_back(stats);
+    }
+    ProfileZoneStats& stats = m_lastFrame[it->second];
+    ++stats.calls;
+    stats.depth = std::min(stats.depth, e.depth);
+    stats.totalNs += duration;
+    stats.selfNs += duration - std::min(duration, childTime[i]);
+    stats.maxNs = std::max(stats.maxNs, duration);
+  }
+  std::sort(m_lastFrame.begin(), m_lastFrame.end(),
+    [](const ProfileZoneStats& a, const ProfileZoneStats& b) { return a.totalNs > b.totalNs; });
+}
+
+void
+Profiler::beginCapture(size_t maxEvents) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_capture.clear();
+  m_capture.reserve(std::min<size_t>(maxEvents, 1u << 16));
+  m_captureLimit = maxEvents;
+  m_capturing = true;
+}
+
+void
+Profiler::endCapture() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_capturing = false;
+}
+
+bool
+Profiler::exportChromeTrace(const std::string& fileName) {
+  std::ofstream os(fileName, std::ios::out | std::ios::trunc);
+  if (!os.is_open()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint64_t origin = UINT64_MAX;
+  for (const ProfileEvent& e : m_capture) {
+    origin = std::min(origin, e.start);
+  }
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+  for (const auto& thread : m_threads) {
+    os << (first ? "" : ",\n")
+       << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << thread->m_threadId
+       << ",\"args\":{\"name\":";
+    writeJsonString(os, thread->m_threadName.c_str());
+    os << "}}";
+    first = false;
+  }
+  char number[64];
+  for (const ProfileEvent& e : m_capture) {
+    os << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+    writeJsonString(os, e.name);
+    // Chrome espera microsegundos; se conservan los nanosegundos como decimales.
+    std::snprintf(number, sizeof(number), ",\"ts\":%.3f,\"dur\":%.3f",
+      (e.start - origin) / 1000.0, (e.end - e.start) / 1000.0);
+    os << number << ",\"pid\":1,\"tid\":" << e.threadId << "}";
+    first = false;
+  }
+  os << "\n]}\n";
+  return os.good();
+}
+
+bool
+Profiler::exportBinary(const std::string& fileName) {
+  std::ofstream os(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!os.is_open()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // Tabla de nombres: cada nombre distinto se escribe una sola vez.
+  std::unordered_map<const char*, uint32_t> nameIndex;
+  std::vector<const char*> names;
+  for (const ProfileEvent& e : m_capture) {
+    if (nameIndex.emplace(e.name, static_cast<uint32_t>(names.size())).second) {
+      names.push_back(e.name);
+    }
+  }
+
+  os.write("NPRF", 4);
+  writePod<uint32_t>(os, 1);
+  writePod<uint64_t>(os, 1000000000ull);
+  writePod<uint32_t>(os, static_cast<uint32_t>(names.size()));
+  for (const char* name : names) {
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(std::char_traits<char>::length(name), 0xFFFF));
+    writePod<uint16_t>(os, length);
+    os.write(name, length);
+  }
+  writePod<uint32_t>(os, static_cast<uint32_t>(m_capture.size()));
+  for (const ProfileEvent& e : m_capture) {
+    writePod<uint32_t>(os, nameIndex[e.name]);
+    writePod<uint32_t>(os, e.threadId);
+    writePod<uint32_t>(os, e.depth);
+    writePod<uint64_t>(os, e.start);
+    writePod<uint64_t>(os, e.end - e.start);
+  }
+  return os.good();
+}
@@ -41,7 +41,7 @@ RenderTargetView::init(Device& device,
 	// Se verifica si la creacin fue exitosa.
 	if (FAILED(hr)) {
 		ERROR("RenderTargetView", "init",
-			("Failed to create render target view. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create render target view. HRESULT: %d", hr);
 		return hr;
 	}
 	return S_OK;
@@ -84,7 +84,7 @@ RenderTargetView::init(Device& device,
 	// Se verifica si la creacin fue exitosa.
 	if (FAILED(hr)) {
 		ERROR("RenderTargetView", "init",
-			("Failed to create render target view. HRESULT: " + std::to_string(hr)).c_str());
+			"Failed to create render target view. HRESULT: %d", hr);
 		return hr;
 	}
 
@@ -111,11 +111,11 @@ RenderTargetView::render(DeviceContext& deviceContext,
 	}
 
 	// Se limpia el color de la vista de destino de renderizado con el color especificado.
-	deviceContext.m_deviceContext->ClearRenderTargetView(m_renderTargetView, ClearColor);
+	deviceContext.ClearRenderTargetView(m_renderTargetView, ClearColor);
 
 	// Se configura la vista de destino de renderizado y el buffer de profundidad/plantilla
 	// para que la GPU sepa dnde dibujar.
-	deviceContext.m_deviceContext->OMSetRenderTargets(numViews,
+	deviceContext.OMSetRenderTargets(numViews,
 																										&m_renderTargetView,
 																										depthStencilView.m_depthStencilView);
 }
@@ -136,7 +136,7 @@ RenderTargetView::render(DeviceContext& deviceContext, unsigned int numViews) {
 		return;
 	}
 	// Se configura la vista de destino de renderizado, pasando nullptr para el buffer de profundidad.
-	deviceContext.m_deviceContext->OMSetRenderTargets(numViews,
+	deviceContext.OMSetRenderTargets(numViews,
 																										&m_renderTargetView,
 																										nullptr);
 }
@@ -0,0 +1,355 @@
+#include "ShaderCache.h"
+#include "FileSystem.h"
+#include "Prerequisites.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace {
+  // Firma "NVSC" y versin del formato de las entradas.
+  const uint32_t kCacheMagic = 0x4353564E;
+  const uint32_t kCacheFormatVersion = 1;
+
+  /**
+   * @brief Cabecera de una entrada de cach.
+   */
+  struct
+  CacheHeader {
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint64_t key;
+    uint64_t size;
+    uint64_t checksum;
+  };
+
+  const uint64_t kFnvOffset = 14695981039346656037ull;
+  const uint64_t kFnvPrime = 1099511628211ull;
+
+  uint64_t
+  fnv1a(const void* data, size_t size, uint64_t hash = kFnvOffset) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= kFnvPrime;
+    }
+    return hash;
+  }
+
+  uint64_t
+  fnv1a(const std::string& text, uint64_t hash) {
+    // Se incluye el terminador para que "ab"+"c" y "a"+"bc" no coincidan.
+    return fnv1a(text.c_str(), text.size() + 1, hash);
+  }
+
+  /**
+   * @brief Lee una fuente HLSL con VirtualFileSystem (suelta o dentro de un .pak).
+   */
+  bool
+  readText(const std::string& fileName, std::string& text) {
+    return VirtualFileSystem::instance().readText(fileName, text);
+  }
+
+#if defined(_WIN32)
+  /**
+   * @class VfsInclude
+   * @brief Resuelve los #include de HLSL con VirtualFileSystem.
+   *
+   * Igual que hashIncludes(), cada include se busca respecto a la carpeta del
+   * archivo que lo incluye; las vistas abiertas viven hasta que el compilador
+   * llama a Close().
+   */
+  class
+  VfsInclude : public ID3DInclude {
+  public:
+    explicit
+    VfsInclude(const std::string& fileName)
+      : m_root(std::filesystem::path(fileName).parent_path()) {}
+
+    HRESULT __stdcall
+    Open(D3D_INCLUDE_TYPE type, LPCSTR fileName, LPCVOID parentData, LPCVOID* data, UINT* bytes) override {
+      (void)type;
+      auto parent = m_directories.find(parentData);
+      std::filesystem::path directory = parent != m_directories.end() ? parent->second : m_root;
+      std::filesystem::path path = (directory / fileName).lexically_normal();
+
+      FileView view;
+      if (!VirtualFileSystem::instance().open(path.generic_string(), view)) {
+        return E_FAIL;
+      }
+      *data = view.data();
+      *bytes = static_cast<UINT>(view.size());
+      m_directories[view.data()] = path.parent_path();
+      m_open[view.data()] = std::move(view);
+      return S_OK;
+    }
+
+    HRESULT __stdcall
+    Close(LPCVOID data) override {
+      m_directories.erase(data);
+      m_open.erase(data);
+      return S_OK;
+    }
+
+  private:
+    std::filesystem::path m_root;
+    std::map<LPCVOID, std::filesystem::path> m_directories;
+    std::map<LPCVOID, FileView> m_open;
+  };
+#endif
+
+  /**
+   * @brief Aade al hash el contenido de los #include de @p source, recursivamente.
+   *
+   * Los include se resuelven respecto a la carpeta del archivo que los incluye,
+   * igual que el compilador. Un include inexistente entra en el hash por nombre.
+   */
+  uint64_t
+  hashIncludes(const std::string& source,
+               const std::filesystem::path& directory,
+               std::set<std::string>& visited,
+               uint64_t hash) {
+    std::istringstream lines(source);
+    std::string line;
+    while (std::getline(lines, line)) {
+      size_t start = line.find_first_not_of(" \t");
+      if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+        continue;
+      }
+      size_t open = line.find_first_of("\"<", start + 8);
+      if (open == std::string::npos) {
+        continue;
+      }
+      size_t close = line.find_first_of("\">", open + 1);
+      if (close == std::string::npos) {
+        continue;
+      }
+
+      std::filesystem::path includePath = directory / line.substr(open + 1, close - open - 1);
+      std::string key = includePath.lexically_normal().generic_string();
+      hash = fnv1a(key, hash);
+      if (!visited.insert(key).second) {
+        continue;
+      }
+
+      std::string included;
+      if (readText(includePath.string(), included)) {
+        hash = fnv1a(included, hash);
+        hash = hashIncludes(included, includePath.parent_path(), visited, hash);
+      }
+    }
+    return hash;
+  }
+}
+
+ShaderCache&
+ShaderCache::instance() {
+  static ShaderCache cache;
+  return cache;
+}
+
+bool
+ShaderCache::init(const std::string& directory, ShaderCompiler& compiler) {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (!std::filesystem::is_directory(directory, error)) {
+    ERROR("ShaderCache", "init", "Cannot create cache directory %s", directory);
+    return false;
+  }
+  m_directory = directory;
+  m_compiler = &compiler;
+  MESSAGE("ShaderCache", "init", "Directory: %s compiler: %s", directory, compiler.version());
+  return true;
+}
+
+void
+ShaderCache::destroy() {
+  m_compiler = nullptr;
+}
+
+bool
+ShaderCache::getOrCompile(const ShaderCompileRequest& request,
+                          std::vector<uint8_t>& bytecode,
+                          std::string* errors) {
+  if (!m_compiler) {
+    ERROR("ShaderCache", "getOrCompile", "ShaderCache not initialized");
+    return false;
+  }
+
+  uint64_t key = computeKey(request);
+  if (key != 0 && load(key, bytecode)) {
+    m_hits.fetch_add(1);
+    return true;
+  }
+
+  m_misses.fetch_add(1);
+  std::string messages;
+  if (!m_compiler->compile(request, bytecode, messages) || bytecode.empty()) {
+    m_failures.fetch_add(1);
+    ERROR("ShaderCache", "getOrCompile",
+          "Failed to compile %s (%s, %s): %s",
+          request.fileName, request.entryPoint, request.profile, messages);
+    if (errors) {
+      *errors = messages;
+    }
+    return false;
+  }
+
+  if (key != 0 && !store(key, bytecode)) {
+    ERROR("ShaderCache", "getOrCompile", "Failed to write %s", entryPath(key));
+  }
+  return true;
+}
+
+uint64_t
+ShaderCache::computeKey(const ShaderCompileRequest& request) const {
+  std::string source;
+  if (!readText(request.fileName, source)) {
+    return 0;
+  }
+
+  uint64_t hash = fnv1a(source, kFnvOffset);
+  std::set<std::string> visited;
+  hash = hashIncludes(source, std::filesystem::path(request.fileName).parent_path(), visited, hash);
+
+  for (const auto& define : request.defines) {
+    hash = fnv1a(define.first, hash);
+    hash = fnv1a(define.second, hash);
+  }
+  hash = fnv1a(request.entryPoint, hash);
+  hash = fnv1a(request.profile, hash);
+  hash = fnv1a(&request.flags, sizeof(request.flags), hash);
+  if (m_compiler) {
+    hash = fnv1a(m_compiler->version(), hash);
+  }
+  // 0 queda reservado para "sin clave".
+  return hash != 0 ? hash : 1;
+}
+
+bool
+ShaderCache::load(uint64_t key, std::vector<uint8_t>& bytecode) const {
+  std::ifstream file(entryPath(key), std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  CacheHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.magic != kCacheMagic ||
+      header.formatVersion != kCacheFormatVersion ||
+      header.key != key ||
+      header.size == 0 || header.size > (64u << 20)) {
+    return false;
+  }
+
+  std::vector<uint8_t> data(static_cast<size_t>(header.size));
+  if (!file.read(reinterpret_cast<char*>(data.data()), data.size()) ||
+      fnv1a(data.data(), data.size()) != header.checksum) {
+    return false;
+  }
+  bytecode.swap(data);
+  return true;
+}
+
+bool
+ShaderCache::store(uint64_t key, const std::vector<uint8_t>& bytecode) const {
+  std::string finalPath = entryPath(key);
+
+  // Nombre temporal nico por hilo: dos hilos pueden compilar la misma clave a la vez.
+  std::ostringstream tempPath;
+  tempPath << finalPath << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+  CacheHeader header;
+  header.magic = kCacheMagic;
+  header.formatVersion = kCacheFormatVersion;
+  header.key = key;
+  header.size = bytecode.size();
+  header.checksum = fnv1a(bytecode.data(), bytecode.size());
+  {
+    std::ofstream file(tempPath.str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open() ||
+        !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        !file.write(reinterpret_cast<const char*>(bytecode.data()), bytecode.size())) {
+      std::remove(tempPath.str().c_str());
+      return false;
+    }
+  }
+
+  // rename() no sobrescribe en Windows; el lector nunca ve una entrada a medias.
+  std::error_code error;
+  std::filesystem::rename(tempPath.str(), finalPath, error);
+  if (error) {
+    std::filesystem::remove(finalPath, error);
+    std::filesystem::rename(tempPath.str(), finalPath, error);
+  }
+  if (error) {
+    std::remove(tempPath.str().c_str());
+    return false;
+  }
+  return true;
+}
+
+std::string
+ShaderCache::entryPath(uint64_t key) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.cso", static_cast<unsigned long long>(key));
+  return (std::filesystem::path(m_directory) / name).string();
+}
+
+#if defined(_WIN32)
+bool
+D3DShaderCompiler::compile(const ShaderCompileRequest& request,
+                           std::vector<uint8_t>& bytecode,
+                           std::string& errors) {
+  std::vector<D3D10_SHADER_MACRO> macros;
+  for (const auto& define : request.defines) {
+    macros.push_back({ define.first.c_str(), define.second.c_str() });
+  }
+  macros.push_back({ nullptr, nullptr });
+
+  // La fuente y sus #include se leen del VFS: pueden estar dentro de un .pak.
+  FileView source;
+  if (!VirtualFileSystem::instance().open(request.fileName, source)) {
+    errors = "Cannot open " + request.fileName;
+    return false;
+  }
+  VfsInclude include(request.fileName);
+
+  ID3DBlob* blob = nullptr;
+  ID3DBlob* errorBlob = nullptr;
+  HRESULT hr = D3DCompile(source.data(),
+                          source.size(),
+                          request.fileName.c_str(),
+                          macros.data(),
+                          &include,
+                          request.entryPoint.c_str(),
+                          request.profile.c_str(),
+                          request.flags,
+                          0,
+                          &blob,
+                          &errorBlob);
+  if (errorBlob) {
+    errors.assign(static_cast<const char*>(errorBlob->GetBufferPointer()), errorBlob->GetBufferSize());
+  }
+  SAFE_RELEASE(errorBlob);
+  if (FAILED(hr) || !blob) {
+    SAFE_RELEASE(blob);
+    return false;
+  }
+
+  const uint8_t* data = static_cast<const uint8_t*>(blob->GetBufferPointer());
+  bytecode.assign(data, data + blob->GetBufferSize());
+  SAFE_RELEASE(blob);
+  return true;
+}
+
+std::string
+D3DShaderCompiler::version() const {
+  return "d3dcompiler_" + std::to_string(D3D_COMPILER_VERSION);
+}
+#endif
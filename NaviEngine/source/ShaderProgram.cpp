@@ -1,11 +1,14 @@
 #include "ShaderProgram.h"
 #include "Device.h"
 #include "DeviceContext.h"
+#include "Profiler.h"
+#include "ShaderCache.h"
 
 HRESULT
 ShaderProgram::init(Device& device,
                     const std::string& fileName,
                     std::vector < D3D11_INPUT_ELEMENT_DESC> Layout) {
+  NAVI_PROFILE_SCOPE("ShaderProgram::init");
   if (!device.m_device) {
     ERROR("ShaderProgram", "init", "InputLayout is empty.");
     return E_POINTER;
@@ -44,6 +47,51 @@ ShaderProgram::init(Device& device,
   return hr;
 }
 
+HRESULT
+ShaderProgram::init(Device& device,
+                    const std::vector<uint8_t>& vertexBytecode,
+                    const std::vector<uint8_t>& pixelBytecode,
+                    std::vector<D3D11_INPUT_ELEMENT_DESC> Layout) {
+  if (!device.m_device) {
+    ERROR("ShaderProgram", "init", "Device is null");
+    return E_POINTER;
+  }
+  if (vertexBytecode.empty() || pixelBytecode.empty() || Layout.empty()) {
+    ERROR("ShaderProgram", "init", "Bytecode or InputLayout is empty.");
+    return E_INVALIDARG;
+  }
+
+  HRESULT hr = device.CreateVertexShader(vertexBytecode.data(), vertexBytecode.size(),
+                                         nullptr, &m_VertexShader);
+  if (FAILED(hr)) {
+    ERROR("ShaderProgram", "init", "Failed to create vertex shader.");
+    return hr;
+  }
+
+  // CreateInputLayout valida la firma de entrada contra el bytecode del VS.
+  SAFE_RELEASE(m_vertexShaderData);
+  hr = D3DCreateBlob(vertexBytecode.size(), &m_vertexShaderData);
+  if (FAILED(hr)) {
+    ERROR("ShaderProgram", "init", "Failed to allocate shader blob.");
+    return hr;
+  }
+  memcpy(m_vertexShaderData->GetBufferPointer(), vertexBytecode.data(), vertexBytecode.size());
+
+  hr = CreateInputLayout(device, Layout);
+  if (FAILED(hr)) {
+    ERROR("ShaderProgram", "init", "Failed to create input layout.");
+    return hr;
+  }
+
+  hr = device.CreatePixelShader(pixelBytecode.data(), pixelBytecode.size(),
+                                nullptr, &m_PixelShader);
+  if (FAILED(hr)) {
+    ERROR("ShaderProgram", "init", "Failed to create pixel shader.");
+    return hr;
+  }
+  return S_OK;
+}
+
 HRESULT
 ShaderProgram::CreateInputLayout(Device& device,
   std::vector<D3D11_INPUT_ELEMENT_DESC> Layout) {
@@ -172,37 +220,39 @@ ShaderProgram::CompileShaderFromFile(char* szFileName,
 
   dwShaderFlags |= D3DCOMPILE_DEBUG;
 #endif
-  ID3DBlob* pErrorBlob;
-  hr = D3DX11CompileFromFile(szFileName, 
-                            nullptr, 
-                            nullptr, 
-                            szEntryPoint, 
-                            szShaderModel,
-                            dwShaderFlags, 
-                            0, 
-                            nullptr,
-                            ppBlobOut,
-                            &pErrorBlob,
-                            nullptr);
 
-  if (FAILED(hr)) {
-    if (pErrorBlob) {
-      ERROR("ShaderProgram", "CompileShaderFromfile",
-        "Failed to compile shader from file: %s. ERROR: %s",
-        szFileName, static_cast<const char*>(pErrorBlob->GetBufferPointer()));
-
-      pErrorBlob->Release();
+  ShaderCompileRequest request;
+  request.fileName = szFileName;
+  request.entryPoint = szEntryPoint;
+  request.profile = szShaderModel;
+  request.flags = dwShaderFlags;
+
+  // Con la cach activa el bytecode sale de disco si la fuente no cambi; sin
+  // ella se compila directamente. En ambos casos la fuente se lee del VFS.
+  std::vector<uint8_t> bytecode;
+  ShaderCache& cache = ShaderCache::instance();
+  if (cache.isInitialized()) {
+    if (!cache.getOrCompile(request, bytecode)) {
+      return E_FAIL;
     }
-    else {
-      ERROR("ShaderProgram", "CompileShaderFromfile",
-        "Failed to compile shader from file: %s. ERROR: %s. No error message available",
-        szFileName);
+  }
+  else {
+    D3DShaderCompiler compiler;
+    std::string errors;
+    if (!compiler.compile(request, bytecode, errors)) {
+      ERROR("ShaderProgram", "CompileShaderFromFile",
+        "Failed to compile shader from file: %s. ERROR: %s",
+        request.fileName, errors.empty() ? "No error message available" : errors.c_str());
+      return E_FAIL;
     }
-    return hr;
   }
 
-  SAFE_RELEASE(pErrorBlob)
-
+  hr = D3DCreateBlob(bytecode.size(), ppBlobOut);
+  if (FAILED(hr)) {
+    ERROR("ShaderProgram", "CompileShaderFromFile", "Failed to allocate shader blob.");
+    return hr;
+  }
+  memcpy((*ppBlobOut)->GetBufferPointer(), bytecode.data(), bytecode.size());
   return S_OK;
 }
 
@@ -214,8 +264,8 @@ ShaderProgram::render(DeviceContext& deviceContext) {
   }
 
   m_inputLayout.render(deviceContext);
-  deviceContext.m_deviceContext->VSSetShader(m_VertexShader, nullptr, 0);
-  deviceContext.m_deviceContext->PSSetShader(m_PixelShader, nullptr, 0);
+  deviceContext.VSSetShader(m_VertexShader, nullptr, 0);
+  deviceContext.PSSetShader(m_PixelShader, nullptr, 0);
 }
 
 void
@@ -226,10 +276,10 @@ ShaderProgram::render(DeviceContext& deviceContext, ShaderType type) {
   }
   switch (type) {
   case VERTEX_SHADER:
-    deviceContext.m_deviceContext->VSSetShader(m_VertexShader, nullptr, 0);
+    deviceContext.VSSetShader(m_VertexShader, nullptr, 0);
     break;
   case PIXEL_SHADER:
-    deviceContext.m_deviceContext->PSSetShader(m_PixelShader, nullptr, 0);
+    deviceContext.PSSetShader(m_PixelShader, nullptr, 0);
     break;
   default:
     break;
@@ -0,0 +1,150 @@
+#include "ShaderVariants.h"
+#include "Device.h"
+#include "DeviceContext.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "ShaderCache.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+  bool
+  compileStage(const ShaderCompileRequest& request, std::vector<uint8_t>& bytecode) {
+    ShaderCache& cache = ShaderCache::instance();
+    if (cache.isInitialized()) {
+      return cache.getOrCompile(request, bytecode);
+    }
+    // Sin cach se compila directamente; D3DCompile admite varios hilos.
+    D3DShaderCompiler compiler;
+    std::string errors;
+    if (!compiler.compile(request, bytecode, errors)) {
+      ERROR("ShaderVariants", "compileStage",
+            "Failed to compile %s (%s): %s", request.fileName, request.entryPoint, errors);
+      return false;
+    }
+    return true;
+  }
+}
+
+HRESULT
+ShaderVariants::init(Device& device,
+                     const std::string& fileName,
+                     const ShaderStageEntryPoints& entryPoints,
+                     const std::vector<D3D11_INPUT_ELEMENT_DESC>& Layout,
+                     const std::vector<std::string>& keywords,
+                     std::vector<ShaderVariantMask> masks) {
+  NAVI_PROFILE_SCOPE("ShaderVariants::init");
+  if (!device.m_device) {
+    ERROR("ShaderVariants", "init", "Device is null");
+    return E_POINTER;
+  }
+  if (fileName.empty() || Layout.empty() || keywords.size() > kMaxKeywords ||
+      entryPoints.vertexEntryPoint.empty() || entryPoints.vertexProfile.empty() ||
+      entryPoints.pixelEntryPoint.empty() || entryPoints.pixelProfile.empty()) {
+    ERROR("ShaderVariants", "init", "Invalid file name, entry points, layout or keyword count.");
+    return E_INVALIDARG;
+  }
+
+  destroy();
+  m_keywords = keywords;
+  ShaderVariantMask variantCount = 1u << keywords.size();
+  if (masks.empty()) {
+    for (ShaderVariantMask mask = 0; mask < variantCount; ++mask) {
+      masks.push_back(mask);
+    }
+  }
+  for (ShaderVariantMask mask : masks) {
+    if (mask >= variantCount) {
+      ERROR("ShaderVariants", "init", "Variant mask uses undeclared keywords.");
+      return E_INVALIDARG;
+    }
+  }
+  // Una mscara repetida creara dos veces los objetos de la misma variante.
+  std::sort(masks.begin(), masks.end());
+  masks.erase(std::unique(masks.begin(), masks.end()), masks.end());
+
+  DWORD flags = D3DCOMPILE_ENABLE_STRICTNESS;
+#if defined (DEBUG) || defined (_DEBUG)
+  flags |= D3DCOMPILE_DEBUG;
+#endif
+
+  // Cada variante necesita dos compilaciones (VS y PS) independientes entre
+  // s: la tarea i compila la etapa i % 2 de masks[i / 2] y solo escribe bytecode[i].
+  std::vector<std::vector<uint8_t>> bytecode(masks.size() * 2);
+  std::atomic<bool> allCompiled{ true };
+  JobSystem::instance().parallelFor(0, bytecode.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      bool pixel = (i % 2) != 0;
+      ShaderCompileRequest request;
+      request.fileName = fileName;
+      request.entryPoint = pixel ? entryPoints.pixelEntryPoint : entryPoints.vertexEntryPoint;
+      request.profile = pixel ? entryPoints.pixelProfile : entryPoints.vertexProfile;
+      request.defines = definesFor(m_keywords, masks[i / 2]);
+      request.flags = flags;
+      if (!compileStage(request, bytecode[i])) {
+        allCompiled = false;
+      }
+    }
+  }, 1);
+  if (!allCompiled) {
+    ERROR("ShaderVariants", "init", "Failed to compile variants of %s", fileName);
+    return E_FAIL;
+  }
+
+  // Los objetos de D3D se crean en este hilo, ya con todo el bytecode listo.
+  m_variants.resize(variantCount);
+  for (size_t k = 0; k < masks.size(); ++k) {
+    HRESULT hr = m_variants[masks[k]].init(device, bytecode[2 * k], bytecode[2 * k + 1], Layout);
+    if (FAILED(hr)) {
+      ERROR("ShaderVariants", "init", "Failed to create variant %u", masks[k]);
+      destroy();
+      return hr;
+    }
+  }
+  MESSAGE("ShaderVariants", "init", "%s variants: %u", fileName, masks.size());
+  return S_OK;
+}
+
+void
+ShaderVariants::render(DeviceContext& deviceContext, ShaderVariantMask mask) {
+  if (!hasVariant(mask)) {
+    ERROR("ShaderVariants", "render", "Variant not built: %u", mask);
+    return;
+  }
+  m_variants[mask].render(deviceContext);
+}
+
+void
+ShaderVariants::destroy() {
+  for (ShaderProgram& variant : m_variants) {
+    variant.destroy();
+  }
+  m_variants.clear();
+  m_keywords.clear();
+}
+
+ShaderVariantMask
+ShaderVariants::maskOf(const std::string& keyword) const {
+  for (size_t i = 0; i < m_keywords.size(); ++i) {
+    if (m_keywords[i] == keyword) {
+      return 1u << i;
+    }
+  }
+  return 0;
+}
+
+bool
+ShaderVariants::hasVariant(ShaderVariantMask mask) const {
+  return mask < m_variants.size() && m_variants[mask].m_VertexShader != nullptr;
+}
+
+std::vector<std::pair<std::string, std::string>>
+ShaderVariants::definesFor(const std::vector<std::string>& keywords, ShaderVariantMask mask) {
+  std::vector<std::pair<std::string, std::string>> defines;
+  for (size_t i = 0; i < keywords.size(); ++i) {
+    if (mask & (1u << i)) {
+      defines.push_back({ keywords[i], "1" });
+    }
+  }
+  return defines;
+}
@@ -0,0 +1,356 @@
+#include "SimdMath.h"
+
+namespace SimdMath {
+  namespace {
+#if defined(SIMD_MATH_SSE)
+    /**
+     * @brief Cuatro Float3 consecutivos (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) a
+     *        tres registros x, y, z.
+     */
+    inline void
+    loadSoA4(const Float3* source, __m128& x, __m128& y, __m128& z) {
+      const float* p = &source->x;
+      __m128 a = _mm_loadu_ps(p);
+      __m128 b = _mm_loadu_ps(p + 4);
+      __m128 c = _mm_loadu_ps(p + 8);
+      x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+      y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                         _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+      z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                         _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    /**
+     * @brief Inversa de loadSoA4().
+     */
+    inline void
+    storeSoA4(Float3* destination, __m128 x, __m128 y, __m128 z) {
+      float* p = &destination->x;
+      __m128 xy01 = _mm_unpacklo_ps(x, y);
+      __m128 xy23 = _mm_unpackhi_ps(x, y);
+      __m128 a = _mm_shuffle_ps(xy01, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+      __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+      __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                                _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+      _mm_storeu_ps(p, a);
+      _mm_storeu_ps(p + 4, b);
+      _mm_storeu_ps(p + 8, c);
+    }
+#endif
+
+#if defined(SIMD_MATH_AVX2)
+#if defined(SIMD_MATH_FMA)
+    inline __m256 multiplyAdd8(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+    inline __m256 multiplyAdd8(__m256 a, __m256 b, __m256 c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+
+    inline __m256
+    combine(__m128 low, __m128 high) {
+      return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+    }
+
+    /**
+     * @brief Ocho Float3 consecutivos a tres registros de 256 bits x, y, z.
+     */
+    inline void
+    loadSoA8(const Float3* source, __m256& x, __m256& y, __m256& z) {
+      __m128 x0, y0, z0, x1, y1, z1;
+      loadSoA4(source, x0, y0, z0);
+      loadSoA4(source + 4, x1, y1, z1);
+      x = combine(x0, x1);
+      y = combine(y0, y1);
+      z = combine(z0, z1);
+    }
+
+    inline void
+    storeSoA8(Float3* destination, __m256 x, __m256 y, __m256 z) {
+      storeSoA4(destination, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+      storeSoA4(destination + 4, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1),
+                _mm256_extractf128_ps(z, 1));
+    }
+
+    /**
+     * @brief Los 16 elementos de una matriz repetidos en registros de 8 lanes.
+     */
+    struct
+    SplatMatrix8 {
+      __m256 m[4][4];
+
+      explicit SplatMatrix8(const Matrix& matrix) {
+        Float4x4 values;
+        storeFloat4x4(&values, matrix);
+        for (int row = 0; row < 4; ++row) {
+          for (int column = 0; column < 4; ++column) {
+            m[row][column] = _mm256_set1_ps(values.m[row][column]);
+          }
+        }
+      }
+    };
+
+    /**
+     * @brief Las cuatro filas de @p b repetidas en las dos mitades de un registro de 256 bits.
+     */
+    struct
+    BroadcastRows8 {
+      __m256 r[4];
+
+      explicit BroadcastRows8(const Matrix& b) {
+        for (int row = 0; row < 4; ++row) {
+          r[row] = _mm256_broadcast_ps(&b.r[row]);
+        }
+      }
+    };
+
+    /**
+     * @brief Dos filas de @p a (una por mitad) multiplicadas por la matriz en @p b.
+     */
+    inline __m256
+    multiplyRows8(__m256 rows, const BroadcastRows8& b) {
+      __m256 result = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), b.r[0]);
+      result = multiplyAdd8(_mm256_permute_ps(rows, 0x55), b.r[1], result);
+      result = multiplyAdd8(_mm256_permute_ps(rows, 0xAA), b.r[2], result);
+      return multiplyAdd8(_mm256_permute_ps(rows, 0xFF), b.r[3], result);
+    }
+
+    inline void
+    multiplyMatrix8(const Matrix& a, const BroadcastRows8& b, Matrix& output) {
+      __m256 rows01 = _mm256_loadu_ps(reinterpret_cast<const float*>(&a.r[0]));
+      __m256 rows23 = _mm256_loadu_ps(reinterpret_cast<const float*>(&a.r[2]));
+      _mm256_storeu_ps(reinterpret_cast<float*>(&output.r[0]), multiplyRows8(rows01, b));
+      _mm256_storeu_ps(reinterpret_cast<float*>(&output.r[2]), multiplyRows8(rows23, b));
+    }
+#elif defined(SIMD_MATH_SSE)
+    /**
+     * @brief Los 16 elementos de una matriz repetidos en registros de 4 lanes.
+     */
+    struct
+    SplatMatrix4 {
+      __m128 m[4][4];
+
+      explicit SplatMatrix4(const Matrix& matrix) {
+        for (int row = 0; row < 4; ++row) {
+          m[row][0] = splatX(matrix.r[row]);
+          m[row][1] = splatY(matrix.r[row]);
+          m[row][2] = splatZ(matrix.r[row]);
+          m[row][3] = splatW(matrix.r[row]);
+        }
+      }
+    };
+#endif
+
+    /**
+     * @brief Aabb con las dos esquinas ya cargadas: centro y extensin transformados.
+     */
+    inline void
+    transformAabb(const Matrix& m, const Matrix& absolute, Vector minimum, Vector maximum, Aabb& output) {
+      Vector half = splat(0.5f);
+      Vector center = transformPoint(multiply(add(minimum, maximum), half), m);
+      Vector extent = transformNormal(multiply(subtract(maximum, minimum), half), absolute);
+      storeFloat3(&output.min, subtract(center, extent));
+      storeFloat3(&output.max, add(center, extent));
+    }
+  }
+
+  const char*
+  simdPath() {
+#if defined(SIMD_MATH_AVX2)
+    return "AVX2";
+#elif defined(SIMD_MATH_SSE4)
+    return "SSE4.1";
+#elif defined(SIMD_MATH_SSE)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+  }
+
+  Matrix
+  inverse(const Matrix& m, float* determinant) {
+    Float4x4 source;
+    storeFloat4x4(&source, m);
+    const float* a = &source.m[0][0];
+    float c[16];
+
+    c[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] +
+           a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+    c[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] -
+           a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+    c[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] +
+           a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+    c[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] -
+            a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+    c[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] -
+           a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+    c[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] +
+           a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+    c[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] -
+           a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+    c[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] +
+            a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+    c[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] +
+           a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+    c[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] -
+           a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+    c[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] +
+            a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+    c[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] -
+            a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+    c[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] -
+           a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+    c[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] +
+           a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+    c[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] -
+            a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+    c[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] +
+            a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+    float det = a[0] * c[0] + a[1] * c[4] + a[2] * c[8] + a[3] * c[12];
+    if (determinant) {
+      *determinant = det;
+    }
+    if (det == 0.0f) {
+      return identity();
+    }
+    Float4x4 result;
+    float inverseDet = 1.0f / det;
+    for (int i = 0; i < 16; ++i) {
+      result.m[i / 4][i % 4] = c[i] * inverseDet;
+    }
+    return loadFloat4x4(&result);
+  }
+
+  void
+  transformPoints(const Matrix& m, const Float3* input, Float3* output, size_t count) {
+    size_t i = 0;
+#if defined(SIMD_MATH_AVX2)
+    SplatMatrix8 s(m);
+    for (; i + 8 <= count; i += 8) {
+      __m256 x, y, z;
+      loadSoA8(input + i, x, y, z);
+      __m256 outX = multiplyAdd8(x, s.m[0][0], multiplyAdd8(y, s.m[1][0], multiplyAdd8(z, s.m[2][0], s.m[3][0])));
+      __m256 outY = multiplyAdd8(x, s.m[0][1], multiplyAdd8(y, s.m[1][1], multiplyAdd8(z, s.m[2][1], s.m[3][1])));
+      __m256 outZ = multiplyAdd8(x, s.m[0][2], multiplyAdd8(y, s.m[1][2], multiplyAdd8(z, s.m[2][2], s.m[3][2])));
+      storeSoA8(output + i, outX, outY, outZ);
+    }
+#elif defined(SIMD_MATH_SSE)
+    SplatMatrix4 s(m);
+    for (; i + 4 <= count; i += 4) {
+      __m128 x, y, z;
+      loadSoA4(input + i, x, y, z);
+      __m128 outX = multiplyAdd(x, s.m[0][0], multiplyAdd(y, s.m[1][0], multiplyAdd(z, s.m[2][0], s.m[3][0])));
+      __m128 outY = multiplyAdd(x, s.m[0][1], multiplyAdd(y, s.m[1][1], multiplyAdd(z, s.m[2][1], s.m[3][1])));
+      __m128 outZ = multiplyAdd(x, s.m[0][2], multiplyAdd(y, s.m[1][2], multiplyAdd(z, s.m[2][2], s.m[3][2])));
+      storeSoA4(output + i, outX, outY, outZ);
+    }
+#endif
+    for (; i < count; ++i) {
+      storeFloat3(output + i, transformPoint(loadFloat3(input + i), m));
+    }
+  }
+
+  void
+  transformNormals(const Matrix& m, const Float3* input, Float3* output, size_t count) {
+    size_t i = 0;
+#if defined(SIMD_MATH_AVX2)
+    SplatMatrix8 s(m);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero8 = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+      __m256 x, y, z;
+      loadSoA8(input + i, x, y, z);
+      __m256 outX = multiplyAdd8(x, s.m[0][0], multiplyAdd8(y, s.m[1][0], _mm256_mul_ps(z, s.m[2][0])));
+      __m256 outY = multiplyAdd8(x, s.m[0][1], multiplyAdd8(y, s.m[1][1], _mm256_mul_ps(z, s.m[2][1])));
+      __m256 outZ = multiplyAdd8(x, s.m[0][2], multiplyAdd8(y, s.m[1][2], _mm256_mul_ps(z, s.m[2][2])));
+      __m256 lengthSq = multiplyAdd8(outX, outX, multiplyAdd8(outY, outY, _mm256_mul_ps(outZ, outZ)));
+      // Las normales de longitud 0 quedan en 0, como en normalize3().
+      __m256 scaleFactor = _mm256_and_ps(_mm256_div_ps(one, _mm256_sqrt_ps(lengthSq)),
+                                         _mm256_cmp_ps(lengthSq, zero8, _CMP_GT_OQ));
+      storeSoA8(output + i, _mm256_mul_ps(outX, scaleFactor), _mm256_mul_ps(outY, scaleFactor),
+                _mm256_mul_ps(outZ, scaleFactor));
+    }
+#elif defined(SIMD_MATH_SSE)
+    SplatMatrix4 s(m);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero4 = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+      __m128 x, y, z;
+      loadSoA4(input + i, x, y, z);
+      __m128 outX = multiplyAdd(x, s.m[0][0], multiplyAdd(y, s.m[1][0], _mm_mul_ps(z, s.m[2][0])));
+      __m128 outY = multiplyAdd(x, s.m[0][1], multiplyAdd(y, s.m[1][1], _mm_mul_ps(z, s.m[2][1])));
+      __m128 outZ = multiplyAdd(x, s.m[0][2], multiplyAdd(y, s.m[1][2], _mm_mul_ps(z, s.m[2][2])));
+      __m128 lengthSq = multiplyAdd(outX, outX, multiplyAdd(outY, outY, _mm_mul_ps(outZ, outZ)));
+      // Las normales de longitud 0 quedan en 0, como en normalize3().
+      __m128 scaleFactor = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(lengthSq)), _mm_cmpgt_ps(lengthSq, zero4));
+      storeSoA4(output + i, _mm_mul_ps(outX, scaleFactor), _mm_mul_ps(outY, scaleFactor),
+                _mm_mul_ps(outZ, scaleFactor));
+    }
+#endif
+    for (; i < count; ++i) {
+      storeFloat3(output + i, normalize3(transformNormal(loadFloat3(input + i), m)));
+    }
+  }
+
+  void
+  transformAabbs(const Matrix& m, const Aabb* input, Aabb* output, size_t count) {
+    // La extensin se transforma con el valor absoluto de la parte 3x3.
+    Matrix absolute = { { abs(m.r[0]), abs(m.r[1]), abs(m.r[2]), zero() } };
+    size_t i = 0;
+#if defined(SIMD_MATH_AVX2)
+    // Dos cajas por iteracin, una en cada mitad del registro.
+    const __m256 half = _mm256_set1_ps(0.5f);
+    BroadcastRows8 rows(m);
+    BroadcastRows8 absoluteRows(absolute);
+    for (; i + 2 <= count; i += 2) {
+      const Aabb& first = input[i];
+      const Aabb& second = input[i + 1];
+      __m256 minimum = combine(loadFloat3(&first.min), loadFloat3(&second.min));
+      __m256 maximum = combine(loadFloat3(&first.max), loadFloat3(&second.max));
+      __m256 center = _mm256_mul_ps(_mm256_add_ps(minimum, maximum), half);
+      __m256 extent = _mm256_mul_ps(_mm256_sub_ps(maximum, minimum), half);
+      __m256 newCenter = multiplyAdd8(_mm256_permute_ps(center, 0x00), rows.r[0], rows.r[3]);
+      newCenter = multiplyAdd8(_mm256_permute_ps(center, 0x55), rows.r[1], newCenter);
+      newCenter = multiplyAdd8(_mm256_permute_ps(center, 0xAA), rows.r[2], newCenter);
+      __m256 newExtent = _mm256_mul_ps(_mm256_permute_ps(extent, 0x00), absoluteRows.r[0]);
+      newExtent = multiplyAdd8(_mm256_permute_ps(extent, 0x55), absoluteRows.r[1], newExtent);
+      newExtent = multiplyAdd8(_mm256_permute_ps(extent, 0xAA), absoluteRows.r[2], newExtent);
+      __m256 newMinimum = _mm256_sub_ps(newCenter, newExtent);
+      __m256 newMaximum = _mm256_add_ps(newCenter, newExtent);
+      storeFloat3(&output[i].min, _mm256_castps256_ps128(newMinimum));
+      storeFloat3(&output[i].max, _mm256_castps256_ps128(newMaximum));
+      storeFloat3(&output[i + 1].min, _mm256_extractf128_ps(newMinimum, 1));
+      storeFloat3(&output[i + 1].max, _mm256_extractf128_ps(newMaximum, 1));
+    }
+#endif
+    for (; i < count; ++i) {
+      transformAabb(m, absolute, loadFloat3(&input[i].min), loadFloat3(&input[i].max), output[i]);
+    }
+  }
+
+  void
+  multiplyMatrices(const Matrix* a, const Matrix& b, Matrix* output, size_t count) {
+#if defined(SIMD_MATH_AVX2)
+    BroadcastRows8 rows(b);
+    for (size_t i = 0; i < count; ++i) {
+      multiplyMatrix8(a[i], rows, output[i]);
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+      output[i] = multiply(a[i], b);
+    }
+#endif
+  }
+
+  void
+  multiplyMatrices(const Matrix* a, const Matrix* b, Matrix* output, size_t count) {
+#if defined(SIMD_MATH_AVX2)
+    for (size_t i = 0; i < count; ++i) {
+      multiplyMatrix8(a[i], BroadcastRows8(b[i]), output[i]);
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+      output[i] = multiply(a[i], b[i]);
+    }
+#endif
+  }
+}
@@ -0,0 +1,237 @@
+#include "Skinning.h"
+#include "JobSystem.h"
+#include "Prerequisites.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// skinMeshes() escribe SkinnedOutputVertex en los buffers de Buffer::initDynamic() que se dibujan como SimpleVertex.
+static_assert(sizeof(SkinnedOutputVertex) == sizeof(SimpleVertex) &&
+              offsetof(SkinnedOutputVertex, texCoord) == offsetof(SimpleVertex, Tex) &&
+              offsetof(SkinnedOutputVertex, normal) == offsetof(SimpleVertex, Normal),
+              "SkinnedOutputVertex debe tener la disposicin de SimpleVertex");
+
+using namespace SimdMath;
+
+namespace {
+
+  /** @brief Vrtices por tarea de skinMeshes(). */
+  const size_t kSkinningGrain = 4096;
+
+  inline Matrix
+  jointMatrix(const JointPose& pose) {
+    return affineTransformation(loadFloat3(&pose.scale), loadFloat4(&pose.rotation),
+                                loadFloat3(&pose.translation));
+  }
+
+  /**
+   * @brief Suma de las matrices de las influencias de @p vertex ponderadas por sus pesos.
+   */
+  inline Matrix
+  blendMatrices(const Matrix* skin, const SkinnedVertex& vertex) {
+    Matrix result;
+#if defined(SIMD_MATH_AVX2)
+    // Dos filas por registro: la mitad de multiplicaciones-suma que con 128 bits.
+    __m256 rows01 = _mm256_setzero_ps();
+    __m256 rows23 = _mm256_setzero_ps();
+    for (unsigned int k = 0; k < kSkinInfluences; ++k) {
+      const float* m = reinterpret_cast<const float*>(&skin[vertex.joints[k]]);
+      __m256 weight = _mm256_set1_ps(vertex.weights[k]);
+#if defined(SIMD_MATH_FMA)
+      rows01 = _mm256_fmadd_ps(_mm256_loadu_ps(m), weight, rows01);
+      rows23 = _mm256_fmadd_ps(_mm256_loadu_ps(m + 8), weight, rows23);
+#else
+      rows01 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(m), weight), rows01);
+      rows23 = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(m + 8), weight), rows23);
+#endif
+    }
+    result.r[0] = _mm256_castps256_ps128(rows01);
+    result.r[1] = _mm256_extractf128_ps(rows01, 1);
+    result.r[2] = _mm256_castps256_ps128(rows23);
+    result.r[3] = _mm256_extractf128_ps(rows23, 1);
+#else
+    const Matrix& m0 = skin[vertex.joints[0]];
+    const Matrix& m1 = skin[vertex.joints[1]];
+    const Matrix& m2 = skin[vertex.joints[2]];
+    const Matrix& m3 = skin[vertex.joints[3]];
+    Vector weights = load(vertex.weights);
+    Vector w0 = splatX(weights);
+    Vector w1 = splatY(weights);
+    Vector w2 = splatZ(weights);
+    Vector w3 = splatW(weights);
+    for (int row = 0; row < 4; ++row) {
+      result.r[row] = multiplyAdd(m3.r[row], w3, multiplyAdd(m2.r[row], w2,
+                        multiplyAdd(m1.r[row], w1, multiply(m0.r[row], w0))));
+    }
+#endif
+    return result;
+  }
+
+  inline void
+  writeVertex(SkinnedOutputVertex& output, Vector position, const Float2& texCoord, Vector normal) {
+    storeFloat3(&output.position, position);
+    output.texCoord = texCoord;
+    storeFloat3(&output.normal, normal);
+  }
+
+  void
+  skinRange(const SkinningJob& job, size_t first, size_t count) {
+    if (job.method == SKINNING_DUAL_QUATERNION) {
+      skinDualQuaternion(job.dualQuaternions, job.vertices + first, job.output + first, count);
+    }
+    else {
+      skinLinear(job.matrices, job.vertices + first, job.output + first, count);
+    }
+  }
+
+}
+
+// ---------------------------------------------------------------------------
+// Skeleton
+// ---------------------------------------------------------------------------
+
+bool
+Skeleton::init(const int* parents,
+               const JointPose* restPose,
+               size_t jointCount,
+               const Float4x4* inverseBindPoses,
+               std::string* error) {
+  const char* problem = nullptr;
+  if (jointCount == 0 || jointCount > kMaxJoints || !parents || !restPose) {
+    problem = "a skeleton needs between 1 and 256 joints with their parents and rest pose";
+  }
+  for (size_t i = 0; !problem && i < jointCount; ++i) {
+    if (parents[i] < -1 || parents[i] >= static_cast<int>(i)) {
+      problem = "every parent joint must come before its children";
+    }
+  }
+  if (problem) {
+    if (error) {
+      *error = problem;
+    }
+    return false;
+  }
+
+  m_parents.assign(parents, parents + jointCount);
+  m_restPose.assign(restPose, restPose + jointCount);
+  m_inverseBindPoses.resize(jointCount);
+  if (inverseBindPoses) {
+    for (size_t i = 0; i < jointCount; ++i) {
+      m_inverseBindPoses[i] = loadFloat4x4(&inverseBindPoses[i]);
+    }
+  }
+  else {
+    localToModel(restPose, m_inverseBindPoses.data());
+    for (Matrix& bind : m_inverseBindPoses) {
+      bind = inverse(bind);
+    }
+  }
+  return true;
+}
+
+void
+Skeleton::localToModel(const JointPose* local, Matrix* model) const {
+  for (size_t i = 0; i < m_parents.size(); ++i) {
+    Matrix matrix = jointMatrix(local[i]);
+    model[i] = m_parents[i] < 0 ? matrix : multiply(matrix, model[m_parents[i]]);
+  }
+}
+
+void
+Skeleton::skinningMatrices(const Matrix* model, Matrix* skin) const {
+  multiplyMatrices(m_inverseBindPoses.data(), model, skin, m_inverseBindPoses.size());
+}
+
+// ---------------------------------------------------------------------------
+// Skinning
+// ---------------------------------------------------------------------------
+
+void
+toDualQuaternions(const Matrix* skin, DualQuaternion* output, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const Matrix& m = skin[i];
+    Matrix rotation = { { normalize3(m.r[0]), normalize3(m.r[1]), normalize3(m.r[2]),
+                          set(0.0f, 0.0f, 0.0f, 1.0f) } };
+    Vector real = quaternionNormalize(quaternionRotationMatrix(rotation));
+    // dual = 0.5 * t * real, con t como cuaternin puro (quaternionMultiply invierte el orden).
+    Vector dual = scale(quaternionMultiply(real, setW(m.r[3], 0.0f)), 0.5f);
+    storeFloat4(&output[i].real, real);
+    storeFloat4(&output[i].dual, dual);
+  }
+}
+
+void
+skinLinear(const Matrix* skin, const SkinnedVertex* input, SkinnedOutputVertex* output, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const SkinnedVertex& vertex = input[i];
+    Matrix blended = blendMatrices(skin, vertex);
+    // Las normales usan la misma matriz: con escala no uniforme se deforman un poco.
+    writeVertex(output[i], transformPoint(loadFloat3(&vertex.position), blended), vertex.texCoord,
+                normalize3(transformNormal(loadFloat3(&vertex.normal), blended)));
+  }
+}
+
+void
+skinDualQuaternion(const DualQuaternion* skin, const SkinnedVertex* input, SkinnedOutputVertex* output,
+                   size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const SkinnedVertex& vertex = input[i];
+    const DualQuaternion& q0 = skin[vertex.joints[0]];
+    Vector first = loadFloat4(&q0.real);
+    Vector real = multiply(first, splat(vertex.weights[0]));
+    Vector dual = multiply(loadFloat4(&q0.dual), splat(vertex.weights[0]));
+    for (unsigned int k = 1; k < kSkinInfluences; ++k) {
+      const DualQuaternion& q = skin[vertex.joints[k]];
+      Vector other = loadFloat4(&q.real);
+      // Camino corto: q y -q son la misma rotacin, pero su suma no.
+      Vector w = splat(std::copysign(vertex.weights[k], getX(dot4(first, other))));
+      real = multiplyAdd(other, w, real);
+      dual = multiplyAdd(loadFloat4(&q.dual), w, dual);
+    }
+
+    float length = getX(length4(real));
+    Vector inverseLength = splat(length > 0.0f ? 1.0f / length : 0.0f);
+    real = multiply(real, inverseLength);
+    dual = multiply(dual, inverseLength);
+
+    // t = 2 * dual * conjugado(real): 2 (real.w dual.xyz - dual.w real.xyz + real.xyz x dual.xyz).
+    Vector offset = multiplyAdd(splatW(real), dual, cross3(real, dual));
+    offset = scale(subtract(offset, multiply(splatW(dual), real)), 2.0f);
+    Vector position = add(quaternionRotate(loadFloat3(&vertex.position), real), offset);
+    // Una rotacin pura conserva la longitud de la normal.
+    writeVertex(output[i], position, vertex.texCoord, quaternionRotate(loadFloat3(&vertex.normal), real));
+  }
+}
+
+void
+skinMeshes(const SkinningJob* jobs, size_t jobCount, bool parallel) {
+  // Cada malla se parte en tramos de kSkinningGrain vrtices; firstChunk[j] es
+  // el primer tramo de la malla j y los tramos de todas se reparten juntos.
+  std::vector<size_t> firstChunk(jobCount + 1, 0);
+  for (size_t j = 0; j < jobCount; ++j) {
+    const SkinningJob& job = jobs[j];
+    bool valid = job.vertices && job.output &&
+                 (job.method == SKINNING_DUAL_QUATERNION ? job.dualQuaternions != nullptr
+                                                         : job.matrices != nullptr);
+    size_t chunks = valid ? (job.count + kSkinningGrain - 1) / kSkinningGrain : 0;
+    firstChunk[j + 1] = firstChunk[j] + chunks;
+  }
+
+  auto skinChunks = [jobs, &firstChunk](size_t begin, size_t end) {
+    size_t job = std::upper_bound(firstChunk.begin(), firstChunk.end(), begin) - firstChunk.begin() - 1;
+    for (size_t chunk = begin; chunk < end; ++chunk) {
+      while (chunk >= firstChunk[job + 1]) {
+        ++job;
+      }
+      size_t first = (chunk - firstChunk[job]) * kSkinningGrain;
+      skinRange(jobs[job], first, (std::min)(kSkinningGrain, jobs[job].count - first));
+    }
+  };
+
+  if (parallel) {
+    JobSystem::instance().parallelFor(0, firstChunk.back(), skinChunks, 1);
+  }
+  else {
+    skinChunks(0, firstChunk.back());
+  }
+}
@@ -81,7 +81,7 @@ SwapChain::init(Device& device,
   // Si la creacin del dispositivo falla despus de todos los intentos, se devuelve un error.
   if (FAILED(hr)) {
     ERROR("SwapChain", "init",
-      ("Failed to create D3D11 device. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to create D3D11 device. HRESULT: %d", hr);
     return hr;
   }
 
@@ -95,7 +95,7 @@ SwapChain::init(Device& device,
     &m_qualityLevels);
   if (FAILED(hr) || m_qualityLevels == 0) {
     ERROR("SwapChain", "init",
-      ("MSAA not supported or invalid quality level. HRESULT: " + std::to_string(hr)).c_str());
+      "MSAA not supported or invalid quality level. HRESULT: %d", hr);
     return hr;
   }
 
@@ -106,7 +106,9 @@ SwapChain::init(Device& device,
   //
   DXGI_SWAP_CHAIN_DESC sd;
   memset(&sd, 0, sizeof(sd));
-  sd.BufferCount = 1;
+  // Dos buffers: la CPU puede preparar el siguiente frame mientras se muestra el actual.
+  // (Los modelos FLIP no admiten back buffers MSAA, por eso se mantiene DISCARD.)
+  sd.BufferCount = 2;
   sd.BufferDesc.Width = window.m_width;
   sd.BufferDesc.Height = window.m_height;
   sd.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -126,14 +128,14 @@ SwapChain::init(Device& device,
   hr = device.m_device->QueryInterface(__uuidof(IDXGIDevice), (void**)&m_dxgiDevice);
   if (FAILED(hr)) {
     ERROR("SwapChain", "init",
-      ("Failed to query IDXGIDevice. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to query IDXGIDevice. HRESULT: %d", hr);
     return hr;
   }
 
   hr = m_dxgiDevice->GetAdapter(&m_dxgiAdapter);
   if (FAILED(hr)) {
     ERROR("SwapChain", "init",
-      ("Failed to get IDXGIAdapter. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to get IDXGIAdapter. HRESULT: %d", hr);
     return hr;
   }
 
@@ -141,7 +143,7 @@ SwapChain::init(Device& device,
                                  reinterpret_cast<void**>(&m_dxgiFactory));
   if (FAILED(hr)) {
     ERROR("SwapChain", "init",
-      ("Failed to get IDXGIFactory. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to get IDXGIFactory. HRESULT: %d", hr);
     return hr;
   }
 
@@ -153,7 +155,7 @@ SwapChain::init(Device& device,
 
   if (FAILED(hr)) {
     ERROR("SwapChain", "init",
-      ("Failed to create swap chain. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to create swap chain. HRESULT: %d", hr);
     return hr;
   }
 
@@ -165,7 +167,7 @@ SwapChain::init(Device& device,
                              reinterpret_cast<void**>(&backBuffer));
   if (FAILED(hr)) {
     ERROR("SwapChain", "init",
-      ("Failed to get back buffer. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to get back buffer. HRESULT: %d", hr);
     return hr;
   }
   return S_OK;
@@ -196,12 +198,12 @@ SwapChain::destroy() {
 // Esto hace que la imagen renderizada en el back buffer sea visible en la pantalla.
 //
 void
-SwapChain::present() {
+SwapChain::present(unsigned int syncInterval) {
   if (m_swapChain) {
-    HRESULT hr = m_swapChain->Present(0, 0);
+    HRESULT hr = m_swapChain->Present(syncInterval, 0);
     if (FAILED(hr)) {
       ERROR("SwapChain", "present",
-        ("Failed to present swap chain. HRESULT: " + std::to_string(hr)).c_str());
+        "Failed to present swap chain. HRESULT: %d", hr);
     }
   }
   else {
@@ -1,8 +1,13 @@
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
 #include "Texture.h"
 #include "Device.h"
 #include "DeviceContext.h"
+#include "Profiler.h"
+#include "MipGenerator.h"
+#include "PixelFormat.h"
+#include "BlockCompressor.h"
+#include "DdsFile.h"
+#include "ImageDecoder.h"
+#include "FileSystem.h"
 
 //
 // La primera funcin `init` est diseada para cargar una textura desde un archivo,
@@ -11,8 +16,9 @@
 HRESULT
 Texture::init(Device& device,
               const std::string& textureName,
-              ExtensionType extensionType) {
-  //return E_NOTIMPL;
+              ExtensionType extensionType,
+              TextureUsage usage) {
+  NAVI_PROFILE_SCOPE("Texture::init");
   if (!device.m_device) {
     ERROR("Texture", "init", "Device is null.");
     return E_POINTER;
@@ -27,19 +33,23 @@ Texture::init(Device& device,
   switch (extensionType) {
   case DDS: {
     m_textureName = textureName + ".dds";
-    // Cargar textura DDS
-    hr = D3DX11CreateShaderResourceViewFromFile(
-      device.m_device,
-      m_textureName.c_str(),
-      nullptr,
-      nullptr,
-      &m_textureFromImg,
-      nullptr
-    );
-
-    if (FAILED(hr)) {
+    // Cargar textura DDS: el archivo (suelto o dentro de un .pak) se lee de la
+    // proyeccin en memoria y se sube sin copiarlo.
+    FileView file;
+    if (!VirtualFileSystem::instance().open(m_textureName, file)) {
       ERROR("Texture", "init",
-        ("Failed to load DDS texture. Verify filepath: " + m_textureName).c_str());
+        "Failed to load DDS texture. Verify filepath: %s", m_textureName);
+      return E_FAIL;
+    }
+    DdsImage image;
+    std::string error;
+    if (!parseDds(file.data(), file.size(), image, &error)) {
+      ERROR("Texture", "init",
+        "Invalid DDS texture %s: %s", m_textureName, error);
+      return E_FAIL;
+    }
+    hr = init(device, image);
+    if (FAILED(hr)) {
       return hr;
     }
     break;
@@ -47,98 +57,60 @@ Texture::init(Device& device,
 
   case PNG: {
     m_textureName = textureName + ".png";
-    int width, height, channels;
-    unsigned char* data = stbi_load(m_textureName.c_str(), & width, &height, &channels, 4);
-    if (!data) {
+    // La imagen se decodifica en memoria del pool con sus propios canales y
+    // pasa a ser el nivel 0 sin copias si no hay que convertirla.
+    DecodedImage image;
+    std::string error;
+    FileView file;
+    if (!VirtualFileSystem::instance().open(m_textureName, file)) {
+      error = "file not found";
+    }
+    if (file.empty() || !ImageDecoder::instance().decodeMemory(file.data(), file.size(), image, &error, 0)) {
       ERROR("Texture", "init",
-        ("Failed to load PNG texture: " + std::string(stbi_failure_reason())).c_str());
+        "Failed to load PNG texture: %s", error);
       return E_FAIL;
     }
 
-    //Crear descirpcion de textura
-    D3D11_TEXTURE2D_DESC textureDesc = {};
-    textureDesc.Width = width;
-    textureDesc.Height = height;
-    textureDesc.MipLevels = 1;
-    textureDesc.ArraySize = 1;
-    textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    textureDesc.SampleDesc.Count = 1;
-    textureDesc.Usage = D3D11_USAGE_DEFAULT;
-    textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-    //Crear datos de descarga
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = data;
-    initData.SysMemPitch = width * 4;
-
-    hr = device.CreateTexture2D(&textureDesc, &initData, &m_texture);
-    stbi_image_free(data); //libera los datos de imagen inmediatamente
-
-    if (FAILED(hr)) {
-      ERROR("Texture", "init", "Failed to create texture from PNG data");
-      return hr;
+    ImageFormat format = chooseImageFormat(image.channels, usage);
+    MipChain chain;
+    if (!buildMipChain(std::move(image), format, format.channels, chain)) {
+      ERROR("Texture", "init", "Failed to build PNG mip chain");
+      return E_FAIL;
     }
-      
-    //Crear vista del recurso de la textura
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = textureDesc.Format;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MipLevels = 1;
-
-    hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
-    SAFE_RELEASE(m_texture); //Liberar texturra inmediatamente
-
+    hr = init(device, chain, static_cast<DXGI_FORMAT>(format.dxgiFormat));
+    ImageDecoder::instance().recycle(std::move(chain.levels[0].pixels));
     if (FAILED(hr)) {
-      ERROR("Texture", "init", "Failed to create shader resoucrce view for PNG texture ");
+      ERROR("Texture", "init", "Failed to create texture from PNG data");
       return hr;
     }
     break;
   }
   case JPG: {
     m_textureName = textureName + ".jpg";
-    int width, height, channels;
-    unsigned char* data = stbi_load(m_textureName.c_str(), &width, & height, &channels, 4);
-    if (!data) {
+    // La imagen se decodifica en memoria del pool con sus propios canales y
+    // pasa a ser el nivel 0 sin copias si no hay que convertirla.
+    DecodedImage image;
+    std::string error;
+    FileView file;
+    if (!VirtualFileSystem::instance().open(m_textureName, file)) {
+      error = "file not found";
+    }
+    if (file.empty() || !ImageDecoder::instance().decodeMemory(file.data(), file.size(), image, &error, 0)) {
       ERROR("Texture", "init",
-        ("Failed to load JPG texture: " + std::string(stbi_failure_reason())).c_str());
+        "Failed to load JPG texture: %s", error);
       return E_FAIL;
     }
 
-    //Crear descripcion de textrurea
-    D3D11_TEXTURE2D_DESC textureDesc = {};
-    textureDesc.Width = width;
-    textureDesc.Height = height;
-    textureDesc.MipLevels = 1;
-    textureDesc.ArraySize = 1;
-    textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    textureDesc.SampleDesc.Count = 1;
-    textureDesc.Usage = D3D11_USAGE_DEFAULT;
-    textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-    //Crear datos de subcarga
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = data;
-    initData.SysMemPitch = width * 4;
-
-    hr = device.CreateTexture2D(&textureDesc, &initData, &m_texture);
-    stbi_image_free(data); //Liberar los datos de imagen inmediatamente
-
-    if (FAILED(hr)) {
-      ERROR("Texture", "init", "Failed to create texture from JPG data");
-      return hr;
+    ImageFormat format = chooseImageFormat(image.channels, usage);
+    MipChain chain;
+    if (!buildMipChain(std::move(image), format, format.channels, chain)) {
+      ERROR("Texture", "init", "Failed to build JPG mip chain");
+      return E_FAIL;
     }
-
-    //Crear vista de recurso de la textura
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = textureDesc.Format;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MipLevels = 1;
-
-    hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
-    SAFE_RELEASE(m_texture); //Liberar texturra inmediatamente
-
+    hr = init(device, chain, static_cast<DXGI_FORMAT>(format.dxgiFormat));
+    ImageDecoder::instance().recycle(std::move(chain.levels[0].pixels));
     if (FAILED(hr)) {
-      ERROR("Texture", "init", "Failed to create shader resoucrce view for JPG texture ");
+      ERROR("Texture", "init", "Failed to create texture from JPG data");
       return hr;
     }
     break;
@@ -196,7 +168,7 @@ Texture::init(Device& device,
   // Se verifica si la creacin fue exitosa y se devuelve el resultado.
   if (FAILED(hr)) {
     ERROR("Texture", "init",
-      ("Failed to create texture with specified params. HRESULT: " + std::to_string(hr)).c_str());
+      "Failed to create texture with specified params. HRESULT: %d", hr);
     return hr;
   }
 
@@ -222,12 +194,22 @@ Texture::init(Device& device, Texture& textureRef, DXGI_FORMAT format) {
   //
   // Se configura la descripcin para la vista del recurso de sombreador.
   // Se especifica el formato y la dimensin de la vista.
+  // Las texturas multimuestreo (p. ej. la profundidad del frame graph) solo
+  // admiten vistas TEXTURE2DMS.
   //
+  D3D11_TEXTURE2D_DESC texDesc;
+  textureRef.m_texture->GetDesc(&texDesc);
+
   D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
   srvDesc.Format = format;
-  srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-  srvDesc.Texture2D.MipLevels = 1;
-  srvDesc.Texture2D.MostDetailedMip = 0;
+  if (texDesc.SampleDesc.Count > 1) {
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DMS;
+  }
+  else {
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+    srvDesc.Texture2D.MostDetailedMip = 0;
+  }
 
   // Se crea la vista de recurso de sombreador a partir de la textura de referencia.
   HRESULT hr = device.m_device->CreateShaderResourceView(textureRef.m_texture,
@@ -237,13 +219,365 @@ Texture::init(Device& device, Texture& textureRef, DXGI_FORMAT format) {
   // Se verifica si la creacin fue exitosa.
   if (FAILED(hr)) {
     ERROR("Texture", "init",
-      ("Failed to create shader resource view for texture. HRESULT: " +
-        std::to_string(hr)).c_str());
+      "Failed to create shader resource view for texture. HRESULT: %d", hr);
+    return hr;
+  }
+  return S_OK;
+}
+
+//
+// Crea la textura y su vista de recurso de sombreador a partir de pxeles ya decodificados.
+// La textura intermedia se libera: la vista mantiene viva la memoria de GPU.
+//
+HRESULT
+Texture::init(Device& device,
+              const unsigned char* pixels,
+              unsigned int width,
+              unsigned int height,
+              DXGI_FORMAT format) {
+  if (!device.m_device) {
+    ERROR("Texture", "init", "Device is null.");
+    return E_POINTER;
+  }
+  if (!pixels || width == 0 || height == 0) {
+    ERROR("Texture", "init", "Invalid pixel data");
+    return E_INVALIDARG;
+  }
+
+  D3D11_TEXTURE2D_DESC textureDesc = {};
+  textureDesc.Width = width;
+  textureDesc.Height = height;
+  textureDesc.MipLevels = 1;
+  textureDesc.ArraySize = 1;
+  textureDesc.Format = format;
+  textureDesc.SampleDesc.Count = 1;
+  textureDesc.Usage = D3D11_USAGE_DEFAULT;
+  textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+  D3D11_SUBRESOURCE_DATA initData = {};
+  initData.pSysMem = pixels;
+  initData.SysMemPitch = width * 4;
+
+  HRESULT hr = device.CreateTexture2D(&textureDesc, &initData, &m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create texture from pixel data");
+    return hr;
+  }
+
+  D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+  srvDesc.Format = textureDesc.Format;
+  srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+  srvDesc.Texture2D.MipLevels = 1;
+
+  hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
+  SAFE_RELEASE(m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create shader resource view from pixel data");
+    return hr;
+  }
+  return S_OK;
+}
+
+//
+// Crea la textura con todos sus niveles de mip: un D3D11_SUBRESOURCE_DATA por nivel.
+//
+HRESULT
+Texture::init(Device& device,
+              const MipChain& chain,
+              DXGI_FORMAT format) {
+  if (!device.m_device) {
+    ERROR("Texture", "init", "Device is null.");
+    return E_POINTER;
+  }
+  if (chain.levels.empty() || chain.width() == 0 || chain.height() == 0) {
+    ERROR("Texture", "init", "Invalid mip chain");
+    return E_INVALIDARG;
+  }
+
+  D3D11_TEXTURE2D_DESC textureDesc = {};
+  textureDesc.Width = chain.width();
+  textureDesc.Height = chain.height();
+  textureDesc.MipLevels = static_cast<UINT>(chain.levels.size());
+  textureDesc.ArraySize = 1;
+  textureDesc.Format = format;
+  textureDesc.SampleDesc.Count = 1;
+  textureDesc.Usage = D3D11_USAGE_DEFAULT;
+  textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+  std::vector<D3D11_SUBRESOURCE_DATA> initData(chain.levels.size());
+  for (size_t i = 0; i < chain.levels.size(); ++i) {
+    initData[i].pSysMem = chain.levels[i].pixels.data();
+    initData[i].SysMemPitch = chain.levels[i].width * chain.channels;
+  }
+
+  HRESULT hr = device.CreateTexture2D(&textureDesc, initData.data(), &m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create texture from mip chain");
+    return hr;
+  }
+
+  D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+  srvDesc.Format = textureDesc.Format;
+  srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+  srvDesc.Texture2D.MipLevels = textureDesc.MipLevels;
+
+  hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
+  SAFE_RELEASE(m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create shader resource view from mip chain");
+    return hr;
+  }
+  return S_OK;
+}
+
+//
+// Crea un Texture2DArray: los subrecursos van por corte y, dentro de cada corte, por nivel.
+//
+HRESULT
+Texture::init(Device& device,
+              const std::vector<const MipChain*>& slices,
+              DXGI_FORMAT format) {
+  if (!device.m_device) {
+    ERROR("Texture", "init", "Device is null.");
+    return E_POINTER;
+  }
+  if (slices.empty() || !slices[0] || slices[0]->levels.empty()) {
+    ERROR("Texture", "init", "Invalid texture array");
+    return E_INVALIDARG;
+  }
+  const MipChain& first = *slices[0];
+  for (const MipChain* chain : slices) {
+    if (!chain || chain->width() != first.width() || chain->height() != first.height() ||
+        chain->levels.size() != first.levels.size()) {
+      ERROR("Texture", "init", "Texture array slices must share size and mip count");
+      return E_INVALIDARG;
+    }
+  }
+
+  D3D11_TEXTURE2D_DESC textureDesc = {};
+  textureDesc.Width = first.width();
+  textureDesc.Height = first.height();
+  textureDesc.MipLevels = static_cast<UINT>(first.levels.size());
+  textureDesc.ArraySize = static_cast<UINT>(slices.size());
+  textureDesc.Format = format;
+  textureDesc.SampleDesc.Count = 1;
+  textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
+  textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+  std::vector<D3D11_SUBRESOURCE_DATA> initData;
+  initData.reserve(slices.size() * first.levels.size());
+  for (const MipChain* chain : slices) {
+    for (const MipLevel& level : chain->levels) {
+      D3D11_SUBRESOURCE_DATA data = {};
+      data.pSysMem = level.pixels.data();
+      data.SysMemPitch = level.width * chain->channels;
+      initData.push_back(data);
+    }
+  }
+
+  HRESULT hr = device.CreateTexture2D(&textureDesc, initData.data(), &m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create texture array");
+    return hr;
+  }
+
+  D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+  srvDesc.Format = textureDesc.Format;
+  srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+  srvDesc.Texture2DArray.MipLevels = textureDesc.MipLevels;
+  srvDesc.Texture2DArray.ArraySize = textureDesc.ArraySize;
+
+  hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
+  SAFE_RELEASE(m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create shader resource view for texture array");
+    return hr;
+  }
+  return S_OK;
+}
+
+//
+// Igual que la versin con MipChain, pero el paso de fila se cuenta en filas de bloques de 4x4.
+//
+HRESULT
+Texture::init(Device& device, const CompressedChain& chain) {
+  if (!device.m_device) {
+    ERROR("Texture", "init", "Device is null.");
+    return E_POINTER;
+  }
+  if (chain.levels.empty() || blockBytes(chain.format) == 0 ||
+      !canBlockCompress(chain.levels[0].width, chain.levels[0].height)) {
+    ERROR("Texture", "init", "Invalid compressed chain");
+    return E_INVALIDARG;
+  }
+
+  D3D11_TEXTURE2D_DESC textureDesc = {};
+  textureDesc.Width = chain.levels[0].width;
+  textureDesc.Height = chain.levels[0].height;
+  textureDesc.MipLevels = static_cast<UINT>(chain.levels.size());
+  textureDesc.ArraySize = 1;
+  textureDesc.Format = static_cast<DXGI_FORMAT>(dxgiFormatOf(chain.format, chain.srgb));
+  textureDesc.SampleDesc.Count = 1;
+  textureDesc.Usage = D3D11_USAGE_DEFAULT;
+  textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+  std::vector<D3D11_SUBRESOURCE_DATA> initData(chain.levels.size());
+  for (size_t i = 0; i < chain.levels.size(); ++i) {
+    initData[i].pSysMem = chain.levels[i].blocks.data();
+    initData[i].SysMemPitch = static_cast<UINT>(blockRowPitch(chain.format, chain.levels[i].width));
+  }
+
+  HRESULT hr = device.CreateTexture2D(&textureDesc, initData.data(), &m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create block-compressed texture");
+    return hr;
+  }
+
+  D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+  srvDesc.Format = textureDesc.Format;
+  srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+  srvDesc.Texture2D.MipLevels = textureDesc.MipLevels;
+
+  hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
+  SAFE_RELEASE(m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create shader resource view for compressed texture");
     return hr;
   }
   return S_OK;
 }
 
+//
+// Crea la textura de un DDS. Cada subrecurso apunta al pxel correspondiente del archivo;
+// Direct3D copia los datos durante CreateTexture2D, as que el archivo puede cerrarse despus.
+//
+HRESULT
+Texture::init(Device& device, const DdsImage& image, unsigned int mostDetailedMip) {
+  if (!device.m_device) {
+    ERROR("Texture", "init", "Device is null.");
+    return E_POINTER;
+  }
+  if (image.dimension != DDS_TEXTURE2D) {
+    ERROR("Texture", "init", "Only 2D DDS textures, arrays and cubemaps are supported");
+    return E_NOTIMPL;
+  }
+  if (image.surfaces.empty() || mostDetailedMip >= image.mipLevels) {
+    ERROR("Texture", "init", "DDS image has no surfaces for the requested mip range");
+    return E_INVALIDARG;
+  }
+
+  const DdsSurface& top = image.surface(mostDetailedMip, 0);
+  const unsigned int mipLevels = image.mipLevels - mostDetailedMip;
+  if (dxgiBlockBytes(image.dxgiFormat) != 0 && (top.width % 4 != 0 || top.height % 4 != 0)) {
+    ERROR("Texture", "init", "Block-compressed textures need a top mip multiple of 4");
+    return E_INVALIDARG;
+  }
+
+  D3D11_TEXTURE2D_DESC textureDesc = {};
+  textureDesc.Width = top.width;
+  textureDesc.Height = top.height;
+  textureDesc.MipLevels = mipLevels;
+  textureDesc.ArraySize = image.sliceCount();
+  textureDesc.Format = static_cast<DXGI_FORMAT>(image.dxgiFormat);
+  textureDesc.SampleDesc.Count = 1;
+  textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
+  textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+  textureDesc.MiscFlags = image.cubemap ? D3D11_RESOURCE_MISC_TEXTURECUBE : 0;
+
+  std::vector<D3D11_SUBRESOURCE_DATA> initData;
+  initData.reserve(static_cast<size_t>(image.sliceCount()) * mipLevels);
+  for (unsigned int slice = 0; slice < image.sliceCount(); ++slice) {
+    for (unsigned int mip = mostDetailedMip; mip < image.mipLevels; ++mip) {
+      const DdsSurface& surface = image.surface(mip, slice);
+      D3D11_SUBRESOURCE_DATA data = {};
+      data.pSysMem = surface.data;
+      data.SysMemPitch = static_cast<UINT>(surface.rowPitch);
+      data.SysMemSlicePitch = static_cast<UINT>(surface.slicePitch);
+      initData.push_back(data);
+    }
+  }
+
+  HRESULT hr = device.CreateTexture2D(&textureDesc, initData.data(), &m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create texture from DDS data");
+    return hr;
+  }
+
+  D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+  srvDesc.Format = textureDesc.Format;
+  if (image.cubemap && image.arraySize > 1) {
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+    srvDesc.TextureCubeArray.MipLevels = mipLevels;
+    srvDesc.TextureCubeArray.NumCubes = image.arraySize;
+  }
+  else if (image.cubemap) {
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+    srvDesc.TextureCube.MipLevels = mipLevels;
+  }
+  else if (image.arraySize > 1) {
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+    srvDesc.Texture2DArray.MipLevels = mipLevels;
+    srvDesc.Texture2DArray.ArraySize = image.arraySize;
+  }
+  else {
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = mipLevels;
+  }
+
+  hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
+  SAFE_RELEASE(m_texture);
+  if (FAILED(hr)) {
+    ERROR("Texture", "init", "Failed to create shader resource view for DDS texture");
+    return hr;
+  }
+  return S_OK;
+}
+
+//
+// Crea la textura a partir de un archivo completo ya ledo a memoria (por ejemplo en otro hilo).
+//
+HRESULT
+Texture::init(Device& device,
+              const std::vector<unsigned char>& fileData,
+              ExtensionType extensionType,
+              TextureUsage usage) {
+  NAVI_PROFILE_SCOPE("Texture::init(memory)");
+  if (!device.m_device) {
+    ERROR("Texture", "init", "Device is null.");
+    return E_POINTER;
+  }
+  if (fileData.empty()) {
+    ERROR("Texture", "init", "File data is empty.");
+    return E_INVALIDARG;
+  }
+
+  if (extensionType == DDS) {
+    DdsImage image;
+    std::string error;
+    if (!parseDds(fileData.data(), fileData.size(), image, &error)) {
+      ERROR("Texture", "init", "Invalid DDS data: %s", error);
+      return E_FAIL;
+    }
+    return init(device, image);
+  }
+
+  DecodedImage image;
+  std::string error;
+  if (!ImageDecoder::instance().decodeMemory(fileData.data(), fileData.size(), image, &error, 0)) {
+    ERROR("Texture", "init", "Failed to decode texture: %s", error);
+    return E_FAIL;
+  }
+  ImageFormat format = chooseImageFormat(image.channels, usage);
+  MipChain chain;
+  if (!buildMipChain(std::move(image), format, format.channels, chain)) {
+    ERROR("Texture", "init", "Failed to build mip chain");
+    return E_FAIL;
+  }
+  HRESULT hr = init(device, chain, static_cast<DXGI_FORMAT>(format.dxgiFormat));
+  ImageDecoder::instance().recycle(std::move(chain.levels[0].pixels));
+  return hr;
+}
+
 //
 // La funcin `update` est vaca, lo que sugiere que no hay lgica de actualizacin
 // de la textura en tiempo de ejecucin en esta implementacin.
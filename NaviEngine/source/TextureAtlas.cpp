@@ -0,0 +1,267 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+  unsigned int
+  cellsFor(unsigned int texels, unsigned int alignment) {
+    return (texels + alignment - 1) / alignment;
+  }
+}
+
+double
+AtlasLayout::occupancy() const {
+  uint64_t used = 0;
+  uint64_t total = 0;
+  for (const AtlasPage& page : pages) {
+    total += static_cast<uint64_t>(page.width) * page.height;
+    for (uint32_t item : page.items) {
+      used += static_cast<uint64_t>(rects[item].width) * rects[item].height;
+    }
+  }
+  return total != 0 ? static_cast<double>(used) / static_cast<double>(total) : 0.0;
+}
+
+void
+SkylinePacker::init(unsigned int width, unsigned int height) {
+  m_width = width;
+  m_height = height;
+  m_usedWidth = 0;
+  m_usedHeight = 0;
+  m_nodes.clear();
+  m_nodes.push_back({ 0, 0, width });
+}
+
+bool
+SkylinePacker::fit(size_t index, unsigned int width, unsigned int height, unsigned int& y) const {
+  if (m_nodes[index].x + width > m_width) {
+    return false;
+  }
+  // El rectngulo descansa sobre el segmento ms alto de los que cubre.
+  y = 0;
+  unsigned int remaining = width;
+  for (size_t i = index; remaining > 0; ++i) {
+    y = std::max(y, m_nodes[i].y);
+    if (y + height > m_height) {
+      return false;
+    }
+    remaining -= std::min(remaining, m_nodes[i].width);
+  }
+  return true;
+}
+
+bool
+SkylinePacker::insert(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y) {
+  if (width == 0 || height == 0) {
+    return false;
+  }
+
+  // Mejor posicin: el borde superior ms bajo; a igualdad, el segmento ms estrecho.
+  size_t best = m_nodes.size();
+  unsigned int bestTop = UINT_MAX;
+  unsigned int bestWidth = UINT_MAX;
+  unsigned int bestY = 0;
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    unsigned int candidateY;
+    if (!fit(i, width, height, candidateY)) {
+      continue;
+    }
+    unsigned int top = candidateY + height;
+    if (top < bestTop || (top == bestTop && m_nodes[i].width < bestWidth)) {
+      best = i;
+      bestTop = top;
+      bestWidth = m_nodes[i].width;
+      bestY = candidateY;
+    }
+  }
+  if (best == m_nodes.size()) {
+    return false;
+  }
+
+  x = m_nodes[best].x;
+  y = bestY;
+  m_nodes.insert(m_nodes.begin() + best, { x, y + height, width });
+
+  // Los segmentos que quedan bajo el nuevo se recortan o se eliminan.
+  for (size_t i = best + 1; i < m_nodes.size();) {
+    unsigned int end = m_nodes[i - 1].x + m_nodes[i - 1].width;
+    if (m_nodes[i].x >= end) {
+      break;
+    }
+    unsigned int overlap = end - m_nodes[i].x;
+    if (m_nodes[i].width <= overlap) {
+      m_nodes.erase(m_nodes.begin() + i);
+      continue;
+    }
+    m_nodes[i].x += overlap;
+    m_nodes[i].width -= overlap;
+    break;
+  }
+
+  // Segmentos contiguos a la misma altura se funden en uno.
+  for (size_t i = 0; i + 1 < m_nodes.size();) {
+    if (m_nodes[i].y == m_nodes[i + 1].y) {
+      m_nodes[i].width += m_nodes[i + 1].width;
+      m_nodes.erase(m_nodes.begin() + i + 1);
+    }
+    else {
+      ++i;
+    }
+  }
+
+  m_usedWidth = std::max(m_usedWidth, x + width);
+  m_usedHeight = std::max(m_usedHeight, y + height);
+  return true;
+}
+
+bool
+packAtlas(const std::vector<AtlasInput>& inputs, const AtlasSettings& settings, AtlasLayout& layout) {
+  unsigned int alignment = 1u << (std::max(1u, std::min(settings.mipLevels, 16u)) - 1);
+  unsigned int pageCells = settings.maxSize / alignment;
+
+  layout.pages.clear();
+  layout.rects.assign(inputs.size(), AtlasRect());
+  layout.padding = settings.padding;
+  layout.alignment = alignment;
+
+  // Las imgenes altas primero: el horizonte queda ms plano y se desperdicia menos.
+  std::vector<uint32_t> order(inputs.size());
+  std::vector<unsigned int> cellWidth(inputs.size());
+  std::vector<unsigned int> cellHeight(inputs.size());
+  for (uint32_t i = 0; i < inputs.size(); ++i) {
+    order[i] = i;
+    cellWidth[i] = cellsFor(inputs[i].width + 2 * settings.padding, alignment);
+    cellHeight[i] = cellsFor(inputs[i].height + 2 * settings.padding, alignment);
+  }
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return cellHeight[a] != cellHeight[b] ? cellHeight[a] > cellHeight[b] : cellWidth[a] > cellWidth[b];
+  });
+
+  bool allPacked = true;
+  std::vector<SkylinePacker> packers;
+  for (uint32_t item : order) {
+    const AtlasInput& input = inputs[item];
+    if (input.width == 0 || input.height == 0 ||
+        cellWidth[item] > pageCells || cellHeight[item] > pageCells) {
+      allPacked = false;
+      continue;
+    }
+
+    unsigned int cellX = 0;
+    unsigned int cellY = 0;
+    size_t page = 0;
+    while (page < packers.size() &&
+           !packers[page].insert(cellWidth[item], cellHeight[item], cellX, cellY)) {
+      ++page;
+    }
+    if (page == packers.size()) {
+      packers.emplace_back();
+      packers.back().init(pageCells, pageCells);
+      packers.back().insert(cellWidth[item], cellHeight[item], cellX, cellY);
+      layout.pages.emplace_back();
+    }
+
+    AtlasRect& rect = layout.rects[item];
+    rect.page = static_cast<int>(page);
+    rect.x = cellX * alignment + settings.padding;
+    rect.y = cellY * alignment + settings.padding;
+    rect.width = input.width;
+    rect.height = input.height;
+    layout.pages[page].items.push_back(item);
+  }
+
+  // Cada pgina se recorta a lo usado; los UV dependen del tamao final.
+  for (size_t page = 0; page < layout.pages.size(); ++page) {
+    AtlasPage& atlasPage = layout.pages[page];
+    atlasPage.width = packers[page].usedWidth() * alignment;
+    atlasPage.height = packers[page].usedHeight() * alignment;
+    for (uint32_t item : atlasPage.items) {
+      AtlasRect& rect = layout.rects[item];
+      rect.scaleU = static_cast<float>(rect.width) / static_cast<float>(atlasPage.width);
+      rect.scaleV = static_cast<float>(rect.height) / static_cast<float>(atlasPage.height);
+      rect.offsetU = static_cast<float>(rect.x) / static_cast<float>(atlasPage.width);
+      rect.offsetV = static_cast<float>(rect.y) / static_cast<float>(atlasPage.height);
+    }
+  }
+  return allPacked;
+}
+
+bool
+composeAtlasPage(const AtlasLayout& layout,
+                 const std::vector<const uint8_t*>& pixels,
+                 unsigned int page,
+                 std::vector<uint8_t>& rgba) {
+  if (page >= layout.pages.size() || pixels.size() != layout.rects.size()) {
+    return false;
+  }
+  const AtlasPage& atlasPage = layout.pages[page];
+  rgba.assign(static_cast<size_t>(atlasPage.width) * atlasPage.height * 4, 0);
+
+  for (uint32_t item : atlasPage.items) {
+    const AtlasRect& rect = layout.rects[item];
+    const uint8_t* source = pixels[item];
+    if (!source) {
+      continue;
+    }
+
+    // Celda completa de la imagen: borde ms relleno hasta la alineacin. Todo
+    // lo que queda fuera del rea til repite el texel del contorno ms cercano.
+    unsigned int left = rect.x - layout.padding;
+    unsigned int top = rect.y - layout.padding;
+    unsigned int right = std::min(atlasPage.width,
+      left + cellsFor(rect.width + 2 * layout.padding, layout.alignment) * layout.alignment);
+    unsigned int bottom = std::min(atlasPage.height,
+      top + cellsFor(rect.height + 2 * layout.padding, layout.alignment) * layout.alignment);
+
+    size_t sourcePitch = static_cast<size_t>(rect.width) * 4;
+    for (unsigned int y = top; y < bottom; ++y) {
+      unsigned int sourceY = y < rect.y ? 0 : std::min(y - rect.y, rect.height - 1);
+      const uint8_t* sourceRow = source + sourceY * sourcePitch;
+      uint8_t* row = rgba.data() + (static_cast<size_t>(y) * atlasPage.width) * 4;
+
+      for (unsigned int x = left; x < rect.x; ++x) {
+        std::memcpy(row + x * 4, sourceRow, 4);
+      }
+      std::memcpy(row + rect.x * 4, sourceRow, sourcePitch);
+      for (unsigned int x = rect.x + rect.width; x < right; ++x) {
+        std::memcpy(row + x * 4, sourceRow + sourcePitch - 4, 4);
+      }
+    }
+  }
+  return true;
+}
+
+void
+packTextureArrays(const std::vector<ArrayInput>& inputs,
+                  std::vector<ArrayGroup>& groups,
+                  std::vector<ArraySlot>& slots,
+                  unsigned int maxSlices) {
+  groups.clear();
+  slots.assign(inputs.size(), ArraySlot());
+  maxSlices = std::max(1u, maxSlices);
+
+  // Clave de compatibilidad -> grupo abierto (el ltimo con cortes libres).
+  std::unordered_map<uint64_t, uint32_t> open;
+  for (uint32_t i = 0; i < inputs.size(); ++i) {
+    const ArrayInput& input = inputs[i];
+    uint64_t key = (static_cast<uint64_t>(input.width) << 48) |
+                   (static_cast<uint64_t>(input.height) << 32) |
+                   (static_cast<uint64_t>(input.format) << 8) | input.mipLevels;
+    auto found = open.find(key);
+    if (found == open.end() || groups[found->second].items.size() >= maxSlices) {
+      ArrayGroup group;
+      group.width = input.width;
+      group.height = input.height;
+      group.format = input.format;
+      group.mipLevels = input.mipLevels;
+      groups.push_back(std::move(group));
+      found = open.insert_or_assign(key, static_cast<uint32_t>(groups.size() - 1)).first;
+    }
+    ArrayGroup& group = groups[found->second];
+    slots[i].group = found->second;
+    slots[i].slice = static_cast<uint32_t>(group.items.size());
+    group.items.push_back(i);
+  }
+}
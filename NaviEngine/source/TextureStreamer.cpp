@@ -0,0 +1,204 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+void
+TextureStreamer::init(size_t budgetBytes, unsigned int maxLoadsInFlight, unsigned int keepFrames) {
+  m_budget = budgetBytes;
+  m_maxLoadsInFlight = std::max(1u, maxLoadsInFlight);
+  m_keepFrames = keepFrames;
+}
+
+unsigned int
+TextureStreamer::tailMipFor(unsigned int width,
+                            unsigned int height,
+                            unsigned int mipLevels,
+                            unsigned int tailSize) {
+  unsigned int mip = 0;
+  while (mip + 1 < mipLevels && std::max(width, height) > tailSize) {
+    width = std::max(1u, width / 2);
+    height = std::max(1u, height / 2);
+    ++mip;
+  }
+  return mip;
+}
+
+float
+TextureStreamer::requiredMip(unsigned int textureSize, float screenPixels, float uvSpan) {
+  if (!(screenPixels > 0.0f)) {
+    return 32.0f;
+  }
+  float texelsPerPixel = static_cast<float>(textureSize) * std::max(uvSpan, 0.0f) / screenPixels;
+  return texelsPerPixel > 1.0f ? std::log2(texelsPerPixel) : 0.0f;
+}
+
+size_t
+TextureStreamer::bytesFrom(const Entry& entry, unsigned int mip) {
+  size_t bytes = 0;
+  for (size_t i = mip; i < entry.levelBytes.size(); ++i) {
+    bytes += entry.levelBytes[i];
+  }
+  return bytes;
+}
+
+StreamHandle
+TextureStreamer::add(const StreamTextureDesc& desc) {
+  if (desc.levelBytes.empty()) {
+    return StreamHandle();
+  }
+  Entry entry;
+  entry.levelBytes = desc.levelBytes;
+  entry.size = std::max(desc.width, desc.height);
+  entry.tailMip = std::min(desc.tailMip, static_cast<unsigned int>(desc.levelBytes.size() - 1));
+  entry.residentMip = entry.tailMip;
+  entry.wantedMip = entry.tailMip;
+  entry.targetMip = entry.tailMip;
+  entry.lastRequest = m_frame;
+  m_stats.residentBytes += bytesFrom(entry, entry.tailMip);
+  return m_entries.insert(std::move(entry));
+}
+
+void
+TextureStreamer::remove(StreamHandle handle) {
+  Entry* entry = m_entries.get(handle);
+  if (!entry) {
+    return;
+  }
+  if (entry->loading) {
+    m_stats.pendingBytes -= entry->levelBytes[entry->loadingMip];
+    --m_stats.loadsInFlight;
+  }
+  m_stats.residentBytes -= bytesFrom(*entry, entry->residentMip);
+  m_entries.remove(handle);
+}
+
+void
+TextureStreamer::request(StreamHandle handle, float screenPixels, float uvSpan) {
+  Entry* entry = m_entries.get(handle);
+  if (!entry) {
+    return;
+  }
+  float mip = requiredMip(entry->size, screenPixels, uvSpan);
+  entry->frameMip = entry->requested ? std::min(entry->frameMip, mip) : mip;
+  entry->frameImportance = entry->requested ? std::max(entry->frameImportance, screenPixels) : screenPixels;
+  entry->requested = true;
+}
+
+void
+TextureStreamer::update(std::vector<StreamAction>& actions) {
+  ++m_frame;
+
+  // Mip deseado segn lo reportado este frame. Una textura que deja de verse
+  // conserva sus mips unos frames para no recargarlos si reaparece enseguida.
+  size_t total = 0;
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    Entry& entry = m_entries.at(i);
+    if (entry.requested) {
+      float mip = std::floor(entry.frameMip);
+      entry.wantedMip = mip >= static_cast<float>(entry.tailMip) ? entry.tailMip : static_cast<unsigned int>(mip);
+      entry.importance = entry.frameImportance;
+      entry.lastRequest = m_frame;
+      entry.requested = false;
+    }
+    else if (m_frame - entry.lastRequest > m_keepFrames) {
+      entry.wantedMip = entry.tailMip;
+      entry.importance = 0.0f;
+    }
+    entry.targetMip = entry.wantedMip;
+    total += bytesFrom(entry, entry.targetMip);
+  }
+  m_stats.wantedBytes = total;
+
+  // Ajuste al presupuesto: se quita un nivel a la textura con menor coste, donde
+  // el coste es su importancia multiplicada por 2 por cada nivel ya quitado.
+  if (total > m_budget) {
+    using Candidate = std::pair<float, size_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> heap;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+      const Entry& entry = m_entries.at(i);
+      if (entry.targetMip < entry.tailMip) {
+        heap.push({ entry.importance, i });
+      }
+    }
+    while (total > m_budget && !heap.empty()) {
+      Candidate candidate = heap.top();
+      heap.pop();
+      Entry& entry = m_entries.at(candidate.second);
+      total -= entry.levelBytes[entry.targetMip];
+      if (++entry.targetMip < entry.tailMip) {
+        heap.push({ candidate.first * 2.0f, candidate.second });
+      }
+    }
+  }
+
+  // Expulsiones: inmediatas, liberan memoria para las cargas de este mismo frame.
+  std::vector<size_t> loads;
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    Entry& entry = m_entries.at(i);
+    if (entry.residentMip < entry.targetMip) {
+      m_stats.residentBytes -= bytesFrom(entry, entry.residentMip) - bytesFrom(entry, entry.targetMip);
+      entry.residentMip = entry.targetMip;
+      actions.push_back({ m_entries.handleAt(i), STREAM_EVICT, entry.targetMip });
+      ++m_stats.evictions;
+    }
+    else if (entry.targetMip < entry.residentMip && !entry.loading) {
+      loads.push_back(i);
+    }
+  }
+
+  // Cargas: un nivel por textura, primero las ms visibles y ms lejos de su objetivo.
+  std::sort(loads.begin(), loads.end(), [this](size_t a, size_t b) {
+    const Entry& ea = m_entries.at(a);
+    const Entry& eb = m_entries.at(b);
+    return ea.importance * (ea.residentMip - ea.targetMip) > eb.importance * (eb.residentMip - eb.targetMip);
+  });
+  for (size_t i : loads) {
+    if (m_stats.loadsInFlight >= m_maxLoadsInFlight) {
+      break;
+    }
+    Entry& entry = m_entries.at(i);
+    unsigned int mip = entry.residentMip - 1;
+    size_t bytes = entry.levelBytes[mip];
+    if (m_stats.residentBytes + m_stats.pendingBytes + bytes > m_budget) {
+      continue;
+    }
+    entry.loading = true;
+    entry.loadingMip = mip;
+    m_stats.pendingBytes += bytes;
+    ++m_stats.loadsInFlight;
+    ++m_stats.loadsIssued;
+    actions.push_back({ m_entries.handleAt(i), STREAM_LOAD, mip });
+  }
+}
+
+void
+TextureStreamer::onLoaded(StreamHandle handle, unsigned int mip, bool success) {
+  Entry* entry = m_entries.get(handle);
+  if (!entry || !entry->loading || entry->loadingMip != mip) {
+    return;
+  }
+  size_t bytes = entry->levelBytes[mip];
+  entry->loading = false;
+  m_stats.pendingBytes -= bytes;
+  --m_stats.loadsInFlight;
+
+  // Si el objetivo baj mientras se cargaba, el siguiente update() lo expulsa.
+  if (success && mip + 1 == entry->residentMip) {
+    entry->residentMip = mip;
+    m_stats.residentBytes += bytes;
+  }
+}
+
+unsigned int
+TextureStreamer::residentMip(StreamHandle handle) const {
+  const Entry* entry = m_entries.get(handle);
+  return entry ? entry->residentMip : 0;
+}
+
+unsigned int
+TextureStreamer::targetMip(StreamHandle handle) const {
+  const Entry* entry = m_entries.get(handle);
+  return entry ? entry->targetMip : 0;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file AllocatorsTests.cpp
+ * @brief Pruebas del subsistema de memoria: contabilidad del heap etiquetado,
+ *        reinicio del asignador lineal y reutilizacin de bloques de los pools.
+ */
+#include "NaviTest.h"
+#include "Allocators.h"
+
+namespace {
+  bool
+  isAligned(const void* pointer, size_t alignment) {
+    return (reinterpret_cast<uintptr_t>(pointer) & (alignment - 1)) == 0;
+  }
+
+  /**
+   * @brief Objeto que cuenta construcciones y destrucciones.
+   */
+  struct
+  Tracked {
+    static int alive;
+    uint64_t value;
+
+    explicit Tracked(uint64_t v) : value(v) { ++alive; }
+    ~Tracked() { --alive; }
+  };
+  int Tracked::alive = 0;
+}
+
+NAVI_TEST(allocators, taggedHeapAccounting) {
+  TaggedHeap& heap = TaggedHeap::instance();
+  MemoryStats before = heap.stats(MEMORY_LOADER);
+  void* small = heap.allocate(100, MEMORY_LOADER);
+  void* wide = heap.allocate(1000, MEMORY_LOADER, 256);
+  CHECK(small && wide);
+  CHECK(isAligned(small, 16));
+  CHECK(isAligned(wide, 256));
+
+  MemoryStats during = heap.stats(MEMORY_LOADER);
+  CHECK_EQ(during.currentBytes, before.currentBytes + 1100);
+  CHECK_EQ(during.liveAllocations, before.liveAllocations + 2);
+  CHECK_EQ(during.totalAllocations, before.totalAllocations + 2);
+  CHECK(during.peakBytes >= during.currentBytes);
+
+  heap.deallocate(small);
+  heap.deallocate(wide);
+  heap.deallocate(nullptr);
+  MemoryStats after = heap.stats(MEMORY_LOADER);
+  CHECK_EQ(after.currentBytes, before.currentBytes);
+  CHECK_EQ(after.liveAllocations, before.liveAllocations);
+  CHECK_EQ(after.peakBytes, during.peakBytes);
+
+  // Alineaciones que no son potencia de dos no se admiten.
+  CHECK(heap.allocate(16, MEMORY_LOADER, 48) == nullptr);
+  CHECK_EQ(std::string(memoryTagName(MEMORY_FRAME)), std::string("frame"));
+}
+
+NAVI_TEST(allocators, linearResetReusesBlock) {
+  LinearAllocator linear(4096, MEMORY_LOADER);
+  uint8_t* first = static_cast<uint8_t*>(linear.allocate(10, 1));
+  void* aligned = linear.allocate(32, 64);
+  CHECK(isAligned(aligned, 64));
+  CHECK(linear.used() >= 42);
+
+  // Solo la ltima asignacin se puede devolver.
+  linear.deallocate(first, 10);
+  size_t used = linear.used();
+  linear.deallocate(aligned, 32);
+  CHECK(linear.used() < used);
+
+  linear.reset();
+  CHECK_EQ(linear.used(), 0u);
+  CHECK(linear.allocate(10, 1) == first);
+  CHECK_EQ(linear.overflowCount(), 0u);
+  CHECK_EQ(linear.capacity(), 4096u);
+}
+
+NAVI_TEST(allocators, linearOverflowGrowsOnReset) {
+  LinearAllocator linear(1024, MEMORY_LOADER);
+  MemoryStats before = TaggedHeap::instance().stats(MEMORY_LOADER);
+
+  // Un ciclo que no cabe encadena bloques extra sin fallar.
+  for (int i = 0; i < 40; ++i) {
+    uint8_t* block = static_cast<uint8_t*>(linear.allocate(100, 16));
+    CHECK(block != nullptr);
+    block[99] = static_cast<uint8_t>(i);
+  }
+  CHECK(linear.overflowCount() > 0);
+  CHECK(linear.used() >= 4000);
+  uint64_t overflows = linear.overflowCount();
+
+  // El reset libera los bloques extra y agranda el principal al pico del ciclo.
+  linear.reset();
+  CHECK(linear.capacity() >= linear.highWater());
+  CHECK(linear.highWater() >= 4000);
+  CHECK_EQ(TaggedHeap::instance().stats(MEMORY_LOADER).liveAllocations, before.liveAllocations);
+
+  // Los siguientes ciclos iguales caben en el bloque principal.
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    for (int i = 0; i < 40; ++i) {
+      linear.allocate(100, 16);
+    }
+    linear.reset();
+  }
+  CHECK_EQ(linear.overflowCount(), overflows);
+  CHECK_EQ(TaggedHeap::instance().stats(MEMORY_LOADER).liveAllocations, before.liveAllocations);
+}
+
+NAVI_TEST(allocators, linearVectorReclaimsLastBuffer) {
+  LinearAllocator linear(64 * 1024, MEMORY_LOADER);
+  size_t usedWithVector = 0;
+  size_t finalBytes = 0;
+  {
+    LinearVector<int> values{ LinearStlAllocator<int>(linear) };
+    for (int i = 0; i < 1000; ++i) {
+      values.push_back(i);
+    }
+    CHECK_EQ(values.size(), 1000u);
+    CHECK_EQ(values[999], 999);
+    usedWithVector = linear.used();
+    finalBytes = values.capacity() * sizeof(int);
+  }
+  // El bfer final es la ltima asignacin: al destruir el vector se recupera.
+  CHECK_EQ(linear.used(), usedWithVector - finalBytes);
+  CHECK_EQ(linear.overflowCount(), 0u);
+  linear.reset();
+  CHECK_EQ(linear.used(), 0u);
+}
+
+NAVI_TEST(allocators, poolReusesBlocks) {
+  MemoryStats before = TaggedHeap::instance().stats(MEMORY_LOADER);
+  {
+    PoolAllocator pool(40, 8, MEMORY_LOADER);
+    CHECK_EQ(pool.blockSize(), 48u);
+    CHECK_EQ(pool.capacity(), 0u);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 8; ++i) {
+      blocks.push_back(pool.allocate());
+      CHECK(isAligned(blocks.back(), 16));
+    }
+    CHECK_EQ(pool.capacity(), 8u);
+    CHECK_EQ(pool.liveCount(), 8u);
+    // El primer trozo se entrega en orden de direccin.
+    for (size_t i = 1; i < blocks.size(); ++i) {
+      CHECK(static_cast<uint8_t*>(blocks[i]) == static_cast<uint8_t*>(blocks[i - 1]) + 48);
+    }
+
+    // Un bloque devuelto es el siguiente en salir, sin tocar el heap.
+    uint64_t heapAllocations = TaggedHeap::instance().stats(MEMORY_LOADER).totalAllocations;
+    for (int i = 0; i < 100; ++i) {
+      void* block = blocks[i % blocks.size()];
+      pool.deallocate(block);
+      CHECK(pool.allocate() == block);
+    }
+    CHECK_EQ(TaggedHeap::instance().stats(MEMORY_LOADER).totalAllocations, heapAllocations);
+    CHECK_EQ(pool.capacity(), 8u);
+
+    // Lleno, crece otro trozo entero.
+    void* extra = pool.allocate();
+    CHECK(extra != nullptr);
+    CHECK_EQ(pool.capacity(), 16u);
+    CHECK_EQ(pool.liveCount(), 9u);
+    pool.deallocate(extra);
+    pool.deallocate(nullptr);
+    for (void* block : blocks) {
+      pool.deallocate(block);
+    }
+    CHECK_EQ(pool.liveCount(), 0u);
+  }
+  // El destructor devuelve los trozos al heap.
+  CHECK_EQ(TaggedHeap::instance().stats(MEMORY_LOADER).liveAllocations, before.liveAllocations);
+  CHECK_EQ(TaggedHeap::instance().stats(MEMORY_LOADER).currentBytes, before.currentBytes);
+}
+
+NAVI_TEST(allocators, typedPoolConstructsAndDestroys) {
+  TypedPool<Tracked> pool(4, MEMORY_LOADER);
+  std::vector<Tracked*> objects;
+  for (uint64_t i = 0; i < 10; ++i) {
+    objects.push_back(pool.create(i));
+  }
+  CHECK_EQ(Tracked::alive, 10);
+  CHECK_EQ(pool.liveCount(), 10u);
+  CHECK_EQ(pool.capacity(), 12u);
+  for (uint64_t i = 0; i < objects.size(); ++i) {
+    CHECK_EQ(objects[i]->value, i);
+  }
+
+  Tracked* reused = objects[3];
+  pool.destroy(reused);
+  CHECK_EQ(Tracked::alive, 9);
+  objects[3] = pool.create(33u);
+  CHECK(objects[3] == reused);
+  CHECK_EQ(objects[3]->value, 33u);
+
+  for (Tracked* object : objects) {
+    pool.destroy(object);
+  }
+  pool.destroy(nullptr);
+  CHECK_EQ(Tracked::alive, 0);
+  CHECK_EQ(pool.liveCount(), 0u);
+  CHECK_EQ(pool.capacity(), 12u);
+}
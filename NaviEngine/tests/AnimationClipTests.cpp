@@ -0,0 +1,300 @@
+/**
+ * @file AnimationClipTests.cpp
+ * @brief Pruebas de AnimationClip: cota de error por pista, cursor, formato y mezcla.
+ */
+#include "NaviTest.h"
+#include "AnimationClip.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SimdMath;
+
+namespace {
+  /**
+   * @brief Clip sinttico de @p joints articulaciones (no mltiplo de 4, para
+   *        probar el relleno): rotaciones que oscilan y cruzan el hemisferio del
+   *        cuaternin, traslacin y escala animadas en unas articulaciones y
+   *        constantes en otras.
+   */
+  RawAnimationClip
+  testClip(size_t joints, size_t frames, float frequency) {
+    RawAnimationClip clip;
+    clip.sampleRate = 30.0f;
+    clip.jointCount = joints;
+    clip.frameCount = frames;
+    clip.poses.resize(joints * frames);
+    for (size_t frame = 0; frame < frames; ++frame) {
+      float time = frame / clip.sampleRate;
+      for (size_t j = 0; j < joints; ++j) {
+        JointPose& pose = clip.poses[frame * joints + j];
+        float phase = 0.7f * j;
+        Vector axis = normalize3(set(1.0f, 0.3f * j, 0.5f - 0.1f * j, 0.0f));
+        float angle = j % 3 == 2 ? 0.4f : 1.5f * j + 2.0f * std::sin(time * frequency * 6.2831853f + phase);
+        storeFloat4(&pose.rotation, quaternionRotationAxis(axis, angle));
+        pose.translation = j % 2 == 0 ? Float3{ std::sin(time * frequency + phase), 0.1f * j, time }
+                                      : Float3{ 0.0f, 0.12f, 0.0f };
+        float s = j == 1 ? 1.0f + 0.25f * std::sin(time * 3.0f) : 1.0f;
+        pose.scale = { s, s, s };
+      }
+    }
+    return clip;
+  }
+
+  /**
+   * @brief Error mximo de cada tipo de pista muestreando todos los frames del clip.
+   */
+  void
+  measureError(const AnimationClip& clip, const RawAnimationClip& raw, float* worst) {
+    ClipCursor cursor;
+    SoaPose pose;
+    std::fill(worst, worst + CLIP_TRACK_KIND_COUNT, 0.0f);
+    for (size_t frame = 0; frame < raw.frameCount; ++frame) {
+      clip.sample(frame / raw.sampleRate, cursor, pose);
+      for (size_t j = 0; j < raw.jointCount; ++j) {
+        const JointPose& expected = raw.poses[frame * raw.jointCount + j];
+        const float rotation[4] = { expected.rotation.x, expected.rotation.y, expected.rotation.z, expected.rotation.w };
+        const float translation[3] = { expected.translation.x, expected.translation.y, expected.translation.z };
+        const float scale[3] = { expected.scale.x, expected.scale.y, expected.scale.z };
+        // q y -q son la misma rotacin: se compara con el signo que d el clip.
+        float dot = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+          dot += rotation[c] * pose.rotation[c][j];
+        }
+        for (int c = 0; c < 4; ++c) {
+          float value = dot < 0.0f ? -rotation[c] : rotation[c];
+          worst[CLIP_TRACK_ROTATION] = (std::max)(worst[CLIP_TRACK_ROTATION], std::fabs(value - pose.rotation[c][j]));
+        }
+        for (int c = 0; c < 3; ++c) {
+          worst[CLIP_TRACK_TRANSLATION] =
+            (std::max)(worst[CLIP_TRACK_TRANSLATION], std::fabs(translation[c] - pose.translation[c][j]));
+          worst[CLIP_TRACK_SCALE] = (std::max)(worst[CLIP_TRACK_SCALE], std::fabs(scale[c] - pose.scale[c][j]));
+        }
+      }
+    }
+  }
+
+  bool
+  samePose(const SoaPose& a, const SoaPose& b) {
+    if (a.jointCount != b.jointCount) {
+      return false;
+    }
+    for (size_t j = 0; j < a.jointCount; ++j) {
+      for (int c = 0; c < 4; ++c) {
+        if (a.rotation[c][j] != b.rotation[c][j]) {
+          return false;
+        }
+      }
+      for (int c = 0; c < 3; ++c) {
+        if (a.translation[c][j] != b.translation[c][j] || a.scale[c][j] != b.scale[c][j]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+}
+
+NAVI_TEST(anim, errorWithinTolerance) {
+  // Redondeo del tiempo a frame y de la descuantizacin, por encima de la tolerancia.
+  const float kSlack = 1e-5f;
+  RawAnimationClip raw = testClip(7, 181, 1.3f);
+  const float tolerances[] = { 0.0005f, 0.002f, 0.01f };
+  size_t previousKeys = raw.frameCount * raw.jointCount * CLIP_TRACK_KIND_COUNT + 1;
+  for (float tolerance : tolerances) {
+    ClipCompressionSettings settings;
+    settings.rotationTolerance = tolerance;
+    settings.translationTolerance = tolerance * 2.0f;
+    settings.scaleTolerance = tolerance * 0.5f;
+    const float limits[CLIP_TRACK_KIND_COUNT] = {
+      settings.rotationTolerance, settings.translationTolerance, settings.scaleTolerance
+    };
+
+    AnimationClip clip;
+    ClipCompressionStats stats;
+    std::string error;
+    CHECK(clip.compress(raw, settings, &stats, &error));
+    CHECK(error.empty());
+    CHECK_EQ(stats.rawKeys, raw.frameCount * raw.jointCount * CLIP_TRACK_KIND_COUNT);
+    CHECK(stats.keys < stats.rawKeys);
+    // Ms tolerancia, menos claves.
+    CHECK(stats.keys < previousKeys);
+    previousKeys = stats.keys;
+
+    float worst[CLIP_TRACK_KIND_COUNT];
+    measureError(clip, raw, worst);
+    for (unsigned int kind = 0; kind < CLIP_TRACK_KIND_COUNT; ++kind) {
+      CHECK(stats.maxError[kind] <= limits[kind]);
+      CHECK(worst[kind] <= limits[kind] + kSlack);
+    }
+  }
+}
+
+NAVI_TEST(anim, constantTracksKeepOneKey) {
+  RawAnimationClip raw = testClip(5, 60, 1.0f);
+  for (size_t frame = 0; frame < raw.frameCount; ++frame) {
+    for (size_t j = 0; j < raw.jointCount; ++j) {
+      raw.poses[frame * raw.jointCount + j] = raw.poses[j];
+    }
+  }
+  AnimationClip clip;
+  ClipCompressionStats stats;
+  CHECK(clip.compress(raw, ClipCompressionSettings(), &stats));
+  CHECK_EQ(stats.keys, raw.jointCount * CLIP_TRACK_KIND_COUNT);
+  float worst[CLIP_TRACK_KIND_COUNT];
+  measureError(clip, raw, worst);
+  CHECK(worst[CLIP_TRACK_ROTATION] <= 0.0005f + 1e-5f);
+}
+
+NAVI_TEST(anim, rejectsInvalidClips) {
+  AnimationClip clip;
+  std::string error;
+  RawAnimationClip empty;
+  CHECK(!clip.compress(empty, ClipCompressionSettings(), nullptr, &error));
+  CHECK(!error.empty());
+  RawAnimationClip mismatched = testClip(3, 10, 1.0f);
+  mismatched.poses.pop_back();
+  CHECK(!clip.compress(mismatched, ClipCompressionSettings()));
+  RawAnimationClip noRate = testClip(3, 10, 1.0f);
+  noRate.sampleRate = 0.0f;
+  CHECK(!clip.compress(noRate, ClipCompressionSettings()));
+}
+
+NAVI_TEST(anim, cursorMatchesFreshSampling) {
+  // Un cursor que avanza, salta hacia atrs o viene de otro clip debe dar la
+  // misma pose que uno nuevo en cada instante.
+  RawAnimationClip raw = testClip(9, 121, 1.7f);
+  AnimationClip clip;
+  CHECK(clip.compress(raw, ClipCompressionSettings()));
+  AnimationClip other;
+  CHECK(other.compress(testClip(9, 40, 0.5f), ClipCompressionSettings()));
+
+  ClipCursor cursor;
+  SoaPose pose;
+  SoaPose otherPose;
+  other.sample(0.5f, cursor, otherPose);
+  const float times[] = { 0.0f, 0.01f, 0.5f, 0.51f, 1.25f, 3.9f, 4.0f, 10.0f, 0.2f, 0.0f, -1.0f,
+                          2.0f, 2.0f + 1.0f / 60.0f, 2.0f + 2.0f / 60.0f, 1.0f / 30.0f };
+  size_t wrong = 0;
+  for (float time : times) {
+    ClipCursor fresh;
+    SoaPose expected;
+    clip.sample(time, fresh, expected);
+    clip.sample(time, cursor, pose);
+    wrong += !samePose(pose, expected);
+  }
+  // Recorrido continuo a 60 Hz, dos veces (la vuelta al principio es un salto atrs).
+  for (int frame = 0; frame < 2 * 240; ++frame) {
+    float time = std::fmod(frame / 60.0f, clip.duration());
+    ClipCursor fresh;
+    SoaPose expected;
+    clip.sample(time, fresh, expected);
+    clip.sample(time, cursor, pose);
+    wrong += !samePose(pose, expected);
+  }
+  CHECK_EQ(wrong, 0u);
+
+  // Las articulaciones de relleno no aparecen y los cuaterniones salen normalizados.
+  CHECK_EQ(pose.jointCount, raw.jointCount);
+  CHECK_EQ(pose.rotation[0].size(), 12u);
+  for (size_t j = 0; j < pose.jointCount; ++j) {
+    float lengthSq = 0.0f;
+    for (int c = 0; c < 4; ++c) {
+      lengthSq += pose.rotation[c][j] * pose.rotation[c][j];
+    }
+    CHECK_NEAR(lengthSq, 1.0f, 1e-5);
+  }
+
+  // Recomprimir el clip invalida los cursores que lo reproducan.
+  clip.sample(1.0f, cursor, pose);
+  CHECK(clip.compress(testClip(9, 121, 0.4f), ClipCompressionSettings()));
+  ClipCursor fresh;
+  SoaPose expected;
+  clip.sample(1.0f, fresh, expected);
+  clip.sample(1.0f, cursor, pose);
+  CHECK(samePose(pose, expected));
+}
+
+NAVI_TEST(anim, serializeRoundTrip) {
+  RawAnimationClip raw = testClip(6, 90, 2.0f);
+  AnimationClip clip;
+  CHECK(clip.compress(raw, ClipCompressionSettings()));
+  std::vector<uint8_t> bytes;
+  clip.serialize(bytes);
+  CHECK_EQ(bytes.size(), clip.sizeInBytes());
+
+  AnimationClip loaded;
+  std::string error;
+  CHECK(loaded.deserialize(bytes.data(), bytes.size(), &error));
+  CHECK_EQ(loaded.jointCount(), clip.jointCount());
+  CHECK_EQ(loaded.duration(), clip.duration());
+  size_t wrong = 0;
+  for (int frame = 0; frame < 180; ++frame) {
+    ClipCursor cursorA;
+    ClipCursor cursorB;
+    SoaPose a;
+    SoaPose b;
+    clip.sample(frame / 60.0f, cursorA, a);
+    loaded.sample(frame / 60.0f, cursorB, b);
+    wrong += !samePose(a, b);
+  }
+  CHECK_EQ(wrong, 0u);
+
+  // Datos truncados, magia o versin distintas y pistas fuera de rango.
+  CHECK(!loaded.deserialize(bytes.data(), bytes.size() - 1, &error));
+  std::vector<uint8_t> corrupt = bytes;
+  corrupt[0] = 'X';
+  CHECK(!loaded.deserialize(corrupt.data(), corrupt.size()));
+  corrupt = bytes;
+  uint32_t version = kClipVersion + 1;
+  std::memcpy(&corrupt[offsetof(ClipHeader, version)], &version, sizeof(version));
+  CHECK(!loaded.deserialize(corrupt.data(), corrupt.size()));
+  corrupt = bytes;
+  uint32_t keyCount = 0xFFFF;
+  std::memcpy(&corrupt[sizeof(ClipHeader) + offsetof(ClipTrack, keyCount)], &keyCount, sizeof(keyCount));
+  CHECK(!loaded.deserialize(corrupt.data(), corrupt.size(), &error));
+  CHECK(!error.empty());
+}
+
+NAVI_TEST(anim, blendPoses) {
+  SoaPose a;
+  SoaPose b;
+  a.resize(5);
+  b.resize(5);
+  for (size_t j = 0; j < 5; ++j) {
+    Float4 q;
+    storeFloat4(&q, quaternionRotationAxis(set(0.0f, 1.0f, 0.0f, 0.0f), 0.3f * j));
+    a.rotation[0][j] = q.x;
+    a.rotation[1][j] = q.y;
+    a.rotation[2][j] = q.z;
+    a.rotation[3][j] = q.w;
+    // La misma rotacin con el signo opuesto: la mezcla no debe anularse.
+    for (int c = 0; c < 4; ++c) {
+      b.rotation[c][j] = -a.rotation[c][j];
+    }
+    for (int c = 0; c < 3; ++c) {
+      a.translation[c][j] = static_cast<float>(j);
+      b.translation[c][j] = static_cast<float>(j) + 4.0f;
+      a.scale[c][j] = 1.0f;
+      b.scale[c][j] = 2.0f;
+    }
+  }
+
+  const SoaPose* poses[2] = { &a, &b };
+  const float weights[2] = { 3.0f, 1.0f };   // Se normalizan a 0.75 y 0.25.
+  SoaPose output;
+  blendPoses(poses, weights, 2, output);
+  CHECK_EQ(output.jointCount, 5u);
+  for (size_t j = 0; j < 5; ++j) {
+    for (int c = 0; c < 4; ++c) {
+      CHECK_NEAR(output.rotation[c][j], a.rotation[c][j], 1e-5);
+    }
+    CHECK_NEAR(output.translation[0][j], j + 1.0f, 1e-5);
+    CHECK_NEAR(output.scale[2][j], 1.25f, 1e-5);
+  }
+
+  // Pesos nulos: la primera pose tal cual.
+  const float none[2] = { 0.0f, 0.0f };
+  blendPoses(poses, none, 2, output);
+  CHECK(samePose(output, a));
+}
@@ -0,0 +1,335 @@
+/**
+ * @file DdsFileTests.cpp
+ * @brief Pruebas de parseDds(): archivos vlidos, los que escribe writeDds()
+ *        y cabeceras mal formadas.
+ */
+#include "NaviTest.h"
+#include "BlockCompressor.h"
+#include "DdsFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+  const uint32_t kMipMapCount = 0x20000;
+  const uint32_t kFourCCFlag = 0x4;
+  const uint32_t kRgbFlag = 0x40;
+  const uint32_t kCubemap = 0x200;
+  const uint32_t kAllFaces = 0xFC00;
+
+  // ndices de DDS_HEADER en palabras de 32 bits, contando desde la firma.
+  enum {
+    kMagic = 0, kSize, kFlags, kHeight, kWidth, kPitch, kDepth, kMipCount,
+    kFormatSize = 19, kFormatFlags, kFourCC, kBitCount, kRedMask, kGreenMask, kBlueMask, kAlphaMask,
+    kCaps, kCaps2,
+    kHeaderWords = 32
+  };
+
+  uint32_t
+  fourCC(const char* code) {
+    uint32_t value;
+    std::memcpy(&value, code, 4);
+    return value;
+  }
+
+  /**
+   * @brief DDS sinttico: cabecera editable palabra a palabra, extensin DX10
+   *        opcional y @p pixelBytes bytes de datos con un patrn reconocible.
+   */
+  struct
+  DdsBuilder {
+    uint32_t header[kHeaderWords] = {};
+    std::vector<uint32_t> dx10;
+    size_t pixelBytes = 0;
+
+    DdsBuilder(unsigned int width, unsigned int height) {
+      header[kMagic] = fourCC("DDS ");
+      header[kSize] = 124;
+      header[kWidth] = width;
+      header[kHeight] = height;
+      header[kFormatSize] = 32;
+    }
+
+    DdsBuilder&
+    rgba8() {
+      header[kFormatFlags] = kRgbFlag;
+      header[kBitCount] = 32;
+      header[kRedMask] = 0x000000FF;
+      header[kGreenMask] = 0x0000FF00;
+      header[kBlueMask] = 0x00FF0000;
+      header[kAlphaMask] = 0xFF000000;
+      return *this;
+    }
+
+    DdsBuilder&
+    compressed(const char* code) {
+      header[kFormatFlags] = kFourCCFlag;
+      header[kFourCC] = fourCC(code);
+      return *this;
+    }
+
+    DdsBuilder&
+    extension(uint32_t format, uint32_t dimension, uint32_t miscFlag, uint32_t arraySize) {
+      compressed("DX10");
+      dx10 = { format, dimension, miscFlag, arraySize, 0 };
+      return *this;
+    }
+
+    DdsBuilder&
+    mips(uint32_t count) {
+      header[kFlags] |= kMipMapCount;
+      header[kMipCount] = count;
+      return *this;
+    }
+
+    std::vector<uint8_t>
+    build() const {
+      std::vector<uint8_t> bytes(sizeof(header) + dx10.size() * sizeof(uint32_t));
+      std::memcpy(bytes.data(), header, sizeof(header));
+      for (size_t i = 0; i < dx10.size(); ++i) {
+        std::memcpy(&bytes[sizeof(header) + i * sizeof(uint32_t)], &dx10[i], sizeof(uint32_t));
+      }
+      for (size_t i = 0; i < pixelBytes; ++i) {
+        bytes.push_back(static_cast<uint8_t>(i));
+      }
+      return bytes;
+    }
+  };
+
+  /**
+   * @brief Bytes de una cadena de mips RGBA8 o de bloques de @p blockBytes.
+   */
+  size_t
+  chainBytes(unsigned int width, unsigned int height, unsigned int mips, unsigned int blockBytes) {
+    size_t total = 0;
+    for (unsigned int mip = 0; mip < mips; ++mip) {
+      total += blockBytes ? static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes
+                          : static_cast<size_t>(width) * height * 4;
+      width = width > 1 ? width / 2 : 1;
+      height = height > 1 ? height / 2 : 1;
+    }
+    return total;
+  }
+
+  bool
+  rejects(const std::vector<uint8_t>& bytes, const char* expected) {
+    DdsImage image;
+    std::string error;
+    bool ok = parseDds(bytes.data(), bytes.size(), image, &error);
+    if (ok || error.find(expected) == std::string::npos) {
+      std::fprintf(stderr, "  expected \"%s\", got %s \"%s\"\n", expected, ok ? "success" : "error", error.c_str());
+      return false;
+    }
+    return true;
+  }
+}
+
+NAVI_TEST(dds, parsesMipChain) {
+  DdsBuilder builder(16, 8);
+  builder.rgba8().mips(5);
+  builder.pixelBytes = chainBytes(16, 8, 5, 0);
+  std::vector<uint8_t> bytes = builder.build();
+  DdsImage image;
+  std::string error;
+  CHECK(parseDds(bytes.data(), bytes.size(), image, &error));
+  CHECK_EQ(image.dxgiFormat, 28u);
+  CHECK_EQ(image.mipLevels, 5u);
+  CHECK_EQ(image.surfaces.size(), 5u);
+  CHECK_EQ(image.surface(0, 0).rowPitch, 64u);
+  CHECK_EQ(image.surface(4, 0).width, 1u);
+  CHECK_EQ(image.surface(4, 0).height, 1u);
+  // Los subrecursos apuntan dentro del bfer, sin copiar.
+  CHECK(image.surface(0, 0).data == bytes.data() + 128);
+  CHECK(image.surface(1, 0).data == bytes.data() + 128 + 16 * 8 * 4);
+}
+
+NAVI_TEST(dds, parsesBlockCompressedCubemap) {
+  DdsBuilder builder(8, 8);
+  builder.compressed("DXT5").mips(4);
+  builder.header[kCaps2] = kCubemap | kAllFaces;
+  builder.pixelBytes = 6 * chainBytes(8, 8, 4, 16);
+  std::vector<uint8_t> bytes = builder.build();
+  DdsImage image;
+  CHECK(parseDds(bytes.data(), bytes.size(), image));
+  CHECK(image.cubemap);
+  CHECK_EQ(image.dxgiFormat, 77u);
+  CHECK_EQ(image.sliceCount(), 6u);
+  CHECK_EQ(image.surfaces.size(), 24u);
+  // Los mips menores que un bloque ocupan un bloque entero.
+  CHECK_EQ(image.surface(3, 5).slicePitch, 16u);
+  CHECK(image.surface(3, 5).data + 16 == bytes.data() + bytes.size());
+}
+
+NAVI_TEST(dds, readsWrittenBc4) {
+  // Degradado en R sobre basura en G, B y A: BC4 solo conserva R.
+  const unsigned int kSide = 8;
+  std::vector<uint8_t> rgba(kSide * kSide * 4);
+  for (unsigned int i = 0; i < kSide * kSide; ++i) {
+    rgba[i * 4 + 0] = static_cast<uint8_t>(i * 2);
+    rgba[i * 4 + 1] = static_cast<uint8_t>(i * 37);
+    rgba[i * 4 + 2] = static_cast<uint8_t>(i * 91);
+    rgba[i * 4 + 3] = static_cast<uint8_t>(i * 13);
+  }
+  CompressedChain chain;
+  chain.format = BLOCK_BC4;
+  chain.levels.resize(1);
+  chain.levels[0].width = kSide;
+  chain.levels[0].height = kSide;
+  CHECK(compressImage(rgba.data(), kSide, kSide, BLOCK_BC4, BLOCK_QUALITY_HIGH, chain.levels[0].blocks));
+  CHECK_EQ(chain.levels[0].blocks.size(), 4u * 8u);
+
+  std::vector<uint8_t> bytes;
+  CHECK(writeDds(chain, bytes));
+  DdsImage image;
+  std::string error;
+  CHECK(parseDds(bytes.data(), bytes.size(), image, &error));
+  CHECK_EQ(image.dxgiFormat, 80u);
+  CHECK_EQ(image.surface(0, 0).slicePitch, 32u);
+
+  std::vector<uint8_t> decoded;
+  CHECK(decompressImage(image.surface(0, 0).data, kSide, kSide, BLOCK_BC4, decoded));
+  int worst = 0;
+  bool clean = true;
+  for (unsigned int i = 0; i < kSide * kSide; ++i) {
+    worst = (std::max)(worst, std::abs(decoded[i * 4] - rgba[i * 4]));
+    clean = clean && decoded[i * 4 + 1] == 0 && decoded[i * 4 + 2] == 0 && decoded[i * 4 + 3] == 255;
+  }
+  CHECK(worst <= 4);
+  CHECK(clean);
+}
+
+NAVI_TEST(dds, parsesDx10Array) {
+  DdsBuilder builder(4, 4);
+  builder.extension(98, DDS_TEXTURE2D, 0, 3);   // BC7_UNORM
+  builder.pixelBytes = 3 * 16;
+  std::vector<uint8_t> bytes = builder.build();
+  DdsImage image;
+  CHECK(parseDds(bytes.data(), bytes.size(), image));
+  CHECK_EQ(image.dxgiFormat, 98u);
+  CHECK_EQ(image.arraySize, 3u);
+  CHECK_EQ(image.surfaces.size(), 3u);
+  CHECK(image.surface(0, 0).data == bytes.data() + 148);
+}
+
+NAVI_TEST(dds, rejectsMalformedHeaders) {
+  DdsBuilder valid(16, 16);
+  valid.rgba8().mips(2);
+  valid.pixelBytes = chainBytes(16, 16, 2, 0);
+  std::vector<uint8_t> bytes = valid.build();
+
+  // Archivo ms corto que la cabecera, sin firma o con tamaos de cabecera errneos.
+  CHECK(rejects(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 100), "too small"));
+  DdsImage image;
+  std::string error;
+  CHECK(!parseDds(nullptr, 0, image, &error));
+  {
+    DdsBuilder builder = valid;
+    builder.header[kMagic] = fourCC("PNG ");
+    CHECK(rejects(builder.build(), "magic"));
+  }
+  {
+    DdsBuilder builder = valid;
+    builder.header[kSize] = 128;
+    CHECK(rejects(builder.build(), "header size"));
+  }
+  {
+    DdsBuilder builder = valid;
+    builder.header[kFormatSize] = 0;
+    CHECK(rejects(builder.build(), "header size"));
+  }
+
+  // Datos de pxeles truncados: en el ltimo mip y en el primero.
+  CHECK(rejects(std::vector<uint8_t>(bytes.begin(), bytes.end() - 1), "truncated pixel data"));
+  CHECK(rejects(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 128 + 10), "truncated pixel data"));
+
+  // Ms mips de los que admite el tamao (16x16 tiene 5).
+  {
+    DdsBuilder builder = valid;
+    builder.mips(6);
+    builder.pixelBytes = 1 << 12;
+    CHECK(rejects(builder.build(), "too many mip levels"));
+  }
+  // Mscaras de 24 bits y FourCC desconocido: sin formato DXGI.
+  {
+    DdsBuilder builder = valid;
+    builder.header[kBitCount] = 24;
+    CHECK(rejects(builder.build(), "unsupported pixel format"));
+  }
+  {
+    DdsBuilder builder = valid;
+    builder.compressed("ABCD");
+    CHECK(rejects(builder.build(), "unsupported pixel format"));
+  }
+  // Cubemaps incompletos o con caras no cuadradas.
+  {
+    DdsBuilder builder = valid;
+    builder.header[kCaps2] = kCubemap | 0x0C00;
+    CHECK(rejects(builder.build(), "partial cubemaps"));
+  }
+  {
+    DdsBuilder builder(16, 8);
+    builder.rgba8();
+    builder.header[kCaps2] = kCubemap | kAllFaces;
+    builder.pixelBytes = 6 * 16 * 8 * 4;
+    CHECK(rejects(builder.build(), "square"));
+  }
+}
+
+NAVI_TEST(dds, rejectsMalformedDx10Headers) {
+  // Extensin DX10 cortada.
+  {
+    DdsBuilder builder(4, 4);
+    builder.compressed("DX10");
+    std::vector<uint8_t> bytes = builder.build();
+    bytes.resize(bytes.size() + 8);
+    CHECK(rejects(bytes, "truncated DX10 header"));
+  }
+  {
+    DdsBuilder builder(4, 4);
+    builder.extension(28, DDS_TEXTURE2D, 0, 0);
+    builder.pixelBytes = 64;
+    CHECK(rejects(builder.build(), "array size is zero"));
+  }
+  {
+    DdsBuilder builder(4, 4);
+    builder.extension(28, 7, 0, 1);
+    builder.pixelBytes = 64;
+    CHECK(rejects(builder.build(), "unknown resource dimension"));
+  }
+  {
+    DdsBuilder builder(4, 4);
+    builder.extension(28, DDS_TEXTURE1D, 0, 1);
+    builder.pixelBytes = 64;
+    CHECK(rejects(builder.build(), "1D texture with height"));
+  }
+  {
+    DdsBuilder builder(4, 4);
+    builder.header[kDepth] = 4;
+    builder.extension(28, DDS_TEXTURE3D, 0, 2);
+    builder.pixelBytes = 4 * 64 * 2;
+    CHECK(rejects(builder.build(), "volume texture arrays"));
+  }
+  {
+    DdsBuilder builder(4, 4);
+    builder.extension(0, DDS_TEXTURE2D, 0, 1);   // DXGI_FORMAT_UNKNOWN
+    builder.pixelBytes = 64;
+    CHECK(rejects(builder.build(), "unsupported pixel format"));
+  }
+  // Un array que declara ms elementos de los que hay en el archivo, tambin
+  // con un tamao que desbordara el nmero de caras de un cubemap.
+  {
+    DdsBuilder builder(4, 4);
+    builder.extension(28, DDS_TEXTURE2D, 0, 1000000);
+    builder.pixelBytes = 64 * 3;
+    CHECK(rejects(builder.build(), "truncated pixel data"));
+  }
+  {
+    DdsBuilder builder(4, 4);
+    builder.extension(28, DDS_TEXTURE2D, 0x4, 0xFFFFFFFFu);
+    builder.mips(3);
+    builder.pixelBytes = 64 * 3;
+    CHECK(rejects(builder.build(), "truncated pixel data"));
+  }
+}
@@ -0,0 +1,364 @@
+/**
+ * @file FrameGraphTests.cpp
+ * @brief Pruebas de FrameGraph: descarte de pases, vidas, texturas compartidas,
+ *        colocacin en el heap, transiciones y reutilizacin entre frames.
+ */
+#include "NaviTest.h"
+#include "FrameGraph.h"
+
+#include <cstdio>
+
+namespace {
+  FrameGraphTextureDesc
+  textureDesc(unsigned int width, unsigned int height, uint32_t format) {
+    FrameGraphTextureDesc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = format;
+    return desc;
+  }
+
+  const FrameGraphTextureDesc kFull = textureDesc(1920, 1080, 28);   // R8G8B8A8_UNORM
+  const FrameGraphTextureDesc kHalf = textureDesc(960, 540, 10);     // R16G16B16A16_FLOAT
+
+  /**
+   * @brief Backend que reparte enteros como texturas y cuenta las llamadas.
+   */
+  class
+  RecordingBackend : public FrameGraphBackend {
+  public:
+    void*
+    createTexture(const FrameGraphTextureDesc& desc, uint32_t accessMask) override {
+      (void)desc;
+      (void)accessMask;
+      ++created;
+      return new int(created);
+    }
+
+    void
+    destroyTexture(void* texture) override {
+      ++destroyed;
+      delete static_cast<int*>(texture);
+    }
+
+    void
+    barrier(const FrameGraphBarrier& barrier, void* texture) override {
+      (void)barrier;
+      barriers += texture ? 1 : 0;
+    }
+
+    int created = 0;
+    int destroyed = 0;
+    unsigned int barriers = 0;
+  };
+
+  /**
+   * @brief Cadena A -> B -> C -> D -> Present de cuatro transitorias; T1 y T3
+   *        tienen la misma descripcin y no coinciden en el tiempo.
+   */
+  struct
+  ChainGraph {
+    FrameGraph graph;
+    FrameGraphHandle back;
+    FrameGraphHandle t1, t2, t3, half;
+    std::vector<std::string> executed;
+    std::vector<void*> physical;
+    int backBuffer = 0;
+
+    void
+    build() {
+      graph.reset();
+      executed.clear();
+      physical.assign(4, nullptr);
+      back = graph.importTexture("BackBuffer", kFull, &backBuffer,
+                                 FRAME_GRAPH_ACCESS_PRESENT, FRAME_GRAPH_ACCESS_PRESENT);
+      graph.addPass("A", [&](FrameGraphBuilder& builder) {
+        t1 = builder.write(builder.createTexture("T1", kFull));
+      }, record(0, t1));
+      graph.addPass("B", [&](FrameGraphBuilder& builder) {
+        builder.read(t1);
+        t2 = builder.write(builder.createTexture("T2", kFull));
+      }, record(1, t2));
+      graph.addPass("C", [&](FrameGraphBuilder& builder) {
+        builder.read(t2);
+        t3 = builder.write(builder.createTexture("T3", kFull));
+      }, record(2, t3));
+      graph.addPass("D", [&](FrameGraphBuilder& builder) {
+        builder.read(t3);
+        half = builder.write(builder.createTexture("Half", kHalf));
+      }, record(3, half));
+      graph.addPass("Present", [&](FrameGraphBuilder& builder) {
+        builder.read(half);
+        back = builder.write(back);
+      }, [this](FrameGraphPassContext& context) { executed.push_back(context.passName()); });
+    }
+
+    FrameGraph::ExecuteFunction
+    record(size_t slot, const FrameGraphHandle& output) {
+      return [this, slot, &output](FrameGraphPassContext& context) {
+        executed.push_back(context.passName());
+        physical[slot] = context.physical(output);
+      };
+    }
+  };
+
+  bool
+  compileFails(FrameGraph& graph, const std::string& expected) {
+    std::string error;
+    if (graph.compile(&error)) {
+      std::fprintf(stderr, "  expected failure \"%s\"\n", expected.c_str());
+      return false;
+    }
+    if (error.find(expected) == std::string::npos) {
+      std::fprintf(stderr, "  expected \"%s\", got \"%s\"\n", expected.c_str(), error.c_str());
+      return false;
+    }
+    return true;
+  }
+}
+
+NAVI_TEST(framegraph, cullsUnusedPasses) {
+  FrameGraph graph;
+  int backBuffer = 0;
+  FrameGraphHandle back = graph.importTexture("BackBuffer", kFull, &backBuffer,
+                                              FRAME_GRAPH_ACCESS_PRESENT, FRAME_GRAPH_ACCESS_PRESENT);
+  FrameGraphHandle gbuffer;
+  FrameGraphHandle blur;
+  uint32_t gbufferPass = graph.addPass("GBuffer", [&](FrameGraphBuilder& builder) {
+    gbuffer = builder.write(builder.createTexture("GBuffer", kFull));
+  }, nullptr);
+  // Escribe algo que nadie lee.
+  uint32_t unusedPass = graph.addPass("Unused", [&](FrameGraphBuilder& builder) {
+    builder.read(gbuffer);
+    builder.write(builder.createTexture("Unused", kHalf));
+  }, nullptr);
+  // Cadena entera sin consumidor final: caen los dos pases.
+  uint32_t blurPass = graph.addPass("Blur", [&](FrameGraphBuilder& builder) {
+    blur = builder.write(builder.createTexture("Blur", kHalf));
+  }, nullptr);
+  uint32_t blurUsePass = graph.addPass("BlurUse", [&](FrameGraphBuilder& builder) {
+    builder.read(blur);
+    builder.write(builder.createTexture("BlurOut", kHalf));
+  }, nullptr);
+  // modify() lee el contenido anterior, pero eso no lo mantiene vivo.
+  uint32_t decalPass = graph.addPass("Decals", [&](FrameGraphBuilder& builder) {
+    builder.modify(gbuffer);
+  }, nullptr);
+  // Solo lee: sin efecto lateral cae; con l se conserva.
+  uint32_t debugPass = graph.addPass("Debug", [&](FrameGraphBuilder& builder) {
+    builder.read(gbuffer);
+  }, nullptr);
+  uint32_t capturePass = graph.addPass("Capture", [&](FrameGraphBuilder& builder) {
+    builder.read(gbuffer);
+    builder.sideEffect();
+  }, nullptr);
+  uint32_t presentPass = graph.addPass("Present", [&](FrameGraphBuilder& builder) {
+    builder.read(gbuffer);
+    back = builder.write(back);
+  }, nullptr);
+
+  std::string error;
+  CHECK(graph.compile(&error));
+  CHECK(!graph.isCulled(gbufferPass));
+  CHECK(graph.isCulled(unusedPass));
+  CHECK(graph.isCulled(blurPass));
+  CHECK(graph.isCulled(blurUsePass));
+  CHECK(graph.isCulled(decalPass));
+  CHECK(graph.isCulled(debugPass));
+  CHECK(!graph.isCulled(capturePass));
+  CHECK(!graph.isCulled(presentPass));
+  CHECK_EQ(graph.stats().passes, 8u);
+  CHECK_EQ(graph.stats().culledPasses, 5u);
+  // Las texturas de los pases descartados no cuentan ni reciben memoria.
+  CHECK_EQ(graph.stats().transientTextures, 1u);
+  CHECK_EQ(graph.physicalIndex(blur), -1);
+  CHECK(graph.barriers(blurPass).empty());
+}
+
+NAVI_TEST(framegraph, aliasesDisjointLifetimes) {
+  ChainGraph chain;
+  chain.build();
+  CHECK(chain.graph.compile());
+
+  int first = 0;
+  int last = 0;
+  chain.graph.lifetime(chain.t1, first, last);
+  CHECK_EQ(first, 0);
+  CHECK_EQ(last, 1);
+  chain.graph.lifetime(chain.t3, first, last);
+  CHECK_EQ(first, 2);
+  CHECK_EQ(last, 3);
+
+  // T3 reutiliza la textura de T1; T2 coincide con ambas y Half tiene otra descripcin.
+  CHECK(chain.graph.physicalIndex(chain.t1) >= 0);
+  CHECK_EQ(chain.graph.physicalIndex(chain.t3), chain.graph.physicalIndex(chain.t1));
+  CHECK(chain.graph.physicalIndex(chain.t2) != chain.graph.physicalIndex(chain.t1));
+  CHECK(chain.graph.physicalIndex(chain.half) != chain.graph.physicalIndex(chain.t1));
+  CHECK_EQ(chain.graph.physicalIndex(chain.back), -1);
+  const FrameGraphStats& stats = chain.graph.stats();
+  CHECK_EQ(stats.transientTextures, 4u);
+  CHECK_EQ(stats.physicalTextures, 3u);
+  CHECK_EQ(stats.transientBytes, 3 * frameGraphTextureBytes(kFull) + frameGraphTextureBytes(kHalf));
+  CHECK_EQ(stats.physicalBytes, 2 * frameGraphTextureBytes(kFull) + frameGraphTextureBytes(kHalf));
+
+  // En el heap, las que coinciden en el tiempo no se pisan y el resto se solapa.
+  FrameGraphHandle all[4] = { chain.t1, chain.t2, chain.t3, chain.half };
+  for (int a = 0; a < 4; ++a) {
+    CHECK_EQ(chain.graph.heapOffset(all[a]) % FrameGraph::kHeapAlignment, 0u);
+    for (int b = a + 1; b < 4; ++b) {
+      int firstA, lastA, firstB, lastB;
+      chain.graph.lifetime(all[a], firstA, lastA);
+      chain.graph.lifetime(all[b], firstB, lastB);
+      if (firstA > lastB || firstB > lastA) {
+        continue;
+      }
+      uint64_t beginA = chain.graph.heapOffset(all[a]);
+      uint64_t beginB = chain.graph.heapOffset(all[b]);
+      const FrameGraphTextureDesc& descA = a == 3 ? kHalf : kFull;
+      const FrameGraphTextureDesc& descB = b == 3 ? kHalf : kFull;
+      CHECK(beginA + frameGraphTextureBytes(descA) <= beginB || beginB + frameGraphTextureBytes(descB) <= beginA);
+    }
+  }
+  CHECK_EQ(chain.graph.heapOffset(chain.t3), chain.graph.heapOffset(chain.t1));
+  CHECK(stats.heapBytes < stats.transientBytes);
+  CHECK(stats.heapBytes >= 2 * frameGraphTextureBytes(kFull));
+}
+
+NAVI_TEST(framegraph, barriersFollowAccesses) {
+  ChainGraph chain;
+  chain.build();
+  CHECK(chain.graph.compile());
+
+  // A: T1 de sin estado a render target.
+  const std::vector<FrameGraphBarrier>& a = chain.graph.barriers(0);
+  CHECK_EQ(a.size(), 1u);
+  CHECK_EQ(a[0].before, FRAME_GRAPH_ACCESS_NONE);
+  CHECK_EQ(a[0].after, FRAME_GRAPH_ACCESS_RENDER_TARGET);
+  CHECK(!a[0].aliasing);
+
+  // B: T1 pasa a lectura y T2 empieza como render target.
+  const std::vector<FrameGraphBarrier>& b = chain.graph.barriers(1);
+  CHECK_EQ(b.size(), 2u);
+  CHECK_EQ(b[0].before, FRAME_GRAPH_ACCESS_RENDER_TARGET);
+  CHECK_EQ(b[0].after, FRAME_GRAPH_ACCESS_SHADER_READ);
+
+  // C: T3 ocupa la textura de T1, que qued en lectura: transicin de aliasing.
+  const std::vector<FrameGraphBarrier>& c = chain.graph.barriers(2);
+  CHECK_EQ(c.size(), 2u);
+  CHECK_EQ(c[1].resource.index, chain.t3.index);
+  CHECK(c[1].aliasing);
+  CHECK_EQ(c[1].before, FRAME_GRAPH_ACCESS_SHADER_READ);
+  CHECK_EQ(c[1].after, FRAME_GRAPH_ACCESS_RENDER_TARGET);
+
+  // Present: el back buffer sale de PRESENT y vuelve a l al final del frame.
+  const std::vector<FrameGraphBarrier>& present = chain.graph.barriers(4);
+  CHECK_EQ(present.size(), 2u);
+  CHECK_EQ(present[1].before, FRAME_GRAPH_ACCESS_PRESENT);
+  CHECK_EQ(present[1].after, FRAME_GRAPH_ACCESS_RENDER_TARGET);
+  CHECK_EQ(chain.graph.finalBarriers().size(), 1u);
+  CHECK_EQ(chain.graph.finalBarriers()[0].after, FRAME_GRAPH_ACCESS_PRESENT);
+  CHECK_EQ(chain.graph.stats().barriers, 10u);
+}
+
+NAVI_TEST(framegraph, executeReusesPooledTextures) {
+  ChainGraph chain;
+  RecordingBackend backend;
+  chain.build();
+  CHECK(chain.graph.compile());
+  CHECK(chain.graph.execute(backend));
+  CHECK_EQ(backend.created, 3);
+  CHECK_EQ(backend.barriers, chain.graph.stats().barriers);
+  CHECK_EQ(chain.executed.size(), 5u);
+  CHECK_EQ(chain.executed.back(), std::string("Present"));
+  CHECK(chain.physical[0] != nullptr);
+  CHECK(chain.physical[2] == chain.physical[0]);
+  CHECK(chain.physical[1] != chain.physical[0]);
+
+  // Los frames siguientes con el mismo grafo no crean texturas.
+  for (int frame = 0; frame < 5; ++frame) {
+    chain.build();
+    CHECK(chain.graph.compile());
+    CHECK(chain.graph.execute(backend));
+  }
+  CHECK_EQ(backend.created, 3);
+  CHECK_EQ(chain.graph.pooledTextureCount(), 3u);
+
+  // Sin uso, las texturas del pool se destruyen pasados kPoolFrames frames.
+  for (unsigned int frame = 0; frame <= FrameGraph::kPoolFrames; ++frame) {
+    CHECK_EQ(backend.destroyed, 0);
+    chain.graph.reset();
+    CHECK(chain.graph.compile());
+    CHECK(chain.graph.execute(backend));
+  }
+  CHECK_EQ(backend.destroyed, 3);
+  CHECK_EQ(chain.graph.pooledTextureCount(), 0u);
+
+  // execute() sin compile() no hace nada.
+  chain.build();
+  CHECK(!chain.graph.execute(backend));
+  CHECK(chain.executed.empty());
+  CHECK(chain.graph.compile());
+  CHECK(chain.graph.execute(backend));
+  chain.graph.destroy(backend);
+  CHECK_EQ(backend.destroyed, backend.created);
+}
+
+NAVI_TEST(framegraph, rejectsInvalidGraphs) {
+  {
+    FrameGraph graph;
+    FrameGraphHandle texture;
+    graph.addPass("Create", [&](FrameGraphBuilder& builder) {
+      texture = builder.createTexture("Empty", kFull);
+    }, nullptr);
+    graph.addPass("Read", [&](FrameGraphBuilder& builder) {
+      builder.read(texture);
+      builder.sideEffect();
+    }, nullptr);
+    CHECK(compileFails(graph, "antes de que"));
+  }
+  {
+    FrameGraph graph;
+    graph.addPass("Self", [&](FrameGraphBuilder& builder) {
+      FrameGraphHandle written = builder.write(builder.createTexture("Self", kFull), FRAME_GRAPH_ACCESS_UNORDERED_ACCESS);
+      builder.read(written, FRAME_GRAPH_ACCESS_UNORDERED_ACCESS);
+      builder.sideEffect();
+    }, nullptr);
+    CHECK(compileFails(graph, "su propia salida"));
+  }
+  {
+    FrameGraph graph;
+    graph.addPass("Conflict", [&](FrameGraphBuilder& builder) {
+      FrameGraphHandle texture = builder.createTexture("Conflict", kFull);
+      builder.write(texture, FRAME_GRAPH_ACCESS_RENDER_TARGET);
+      builder.read(texture, FRAME_GRAPH_ACCESS_SHADER_READ);
+    }, nullptr);
+    CHECK(compileFails(graph, "se usa como render target y como shader read"));
+  }
+  {
+    FrameGraph graph;
+    FrameGraphHandle first;
+    graph.addPass("First", [&](FrameGraphBuilder& builder) {
+      first = builder.createTexture("Versioned", kFull);
+      builder.write(first);
+    }, nullptr);
+    graph.addPass("Stale", [&](FrameGraphBuilder& builder) {
+      builder.write(first);
+    }, nullptr);
+    CHECK(compileFails(graph, "versin antigua"));
+  }
+  {
+    // Un handle de un frame anterior no existe tras reset().
+    FrameGraph graph;
+    FrameGraphHandle old;
+    graph.addPass("Old", [&](FrameGraphBuilder& builder) {
+      old = builder.write(builder.createTexture("Old", kFull));
+      builder.sideEffect();
+    }, nullptr);
+    CHECK(graph.compile());
+    graph.reset();
+    graph.addPass("New", [&](FrameGraphBuilder& builder) {
+      builder.read(old);
+    }, nullptr);
+    CHECK(compileFails(graph, "handle invlido"));
+  }
+}
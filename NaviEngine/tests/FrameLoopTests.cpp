@@ -0,0 +1,136 @@
+/**
+ * @file FrameLoopTests.cpp
+ * @brief Pruebas de FrameLoop conducido por un ManualClock, sin ventana.
+ */
+#include "NaviTest.h"
+#include "Clock.h"
+#include "FrameLoop.h"
+
+#include <cstdint>
+
+namespace {
+  // 1/64 s es exacto en binario: los pasos y alphas esperados no dependen del redondeo.
+  const double kStep = 1.0 / 64.0;
+}
+
+NAVI_TEST(frameloop, rejectsInvalidSettings) {
+  FrameLoop loop;
+  CHECK(!loop.init(0.0));
+  CHECK(!loop.init(-kStep));
+  CHECK(!loop.init(kStep, kStep / 2.0));
+  CHECK(loop.init(kStep, 0.25));
+}
+
+NAVI_TEST(frameloop, fixedDeltas) {
+  ManualClock clock;
+  FrameLoop loop;
+  CHECK(loop.init(kStep, 0.25));
+  loop.reset(clock.now());
+
+  unsigned int callbacks = 0;
+  double stepSum = 0.0;
+  auto step = [&](double dt) {
+    ++callbacks;
+    stepSum += dt;
+  };
+
+  struct Frame {
+    double delta;
+    unsigned int steps;
+    double alpha;
+  };
+  // Acumulador en pasos antes de simular: 0.5, 1.25, 2.25, 3.25, 0.25 y 1.0.
+  const Frame frames[] = {
+    { kStep * 0.5, 0, 0.5 },
+    { kStep * 0.75, 1, 0.25 },
+    { kStep * 2.0, 2, 0.25 },
+    { kStep * 3.0, 3, 0.25 },
+    { 0.0, 0, 0.25 },
+    { kStep * 0.75, 1, 0.0 },
+  };
+  unsigned int expectedTotal = 0;
+  for (const Frame& frame : frames) {
+    clock.advance(frame.delta);
+    unsigned int steps = loop.tick(clock.now(), step);
+    expectedTotal += frame.steps;
+    CHECK_EQ(steps, frame.steps);
+    CHECK_NEAR(loop.alpha(), frame.alpha, 1e-12);
+    CHECK(loop.alpha() >= 0.0 && loop.alpha() < 1.0);
+  }
+  CHECK_EQ(callbacks, expectedTotal);
+  CHECK_EQ(loop.totalSteps(), static_cast<uint64_t>(expectedTotal));
+  CHECK_NEAR(stepSum, expectedTotal * kStep, 1e-12);
+  CHECK_NEAR(loop.simulationTime(), clock.now(), 1e-12);
+  CHECK_EQ(loop.droppedTime(), 0.0);
+}
+
+NAVI_TEST(frameloop, spiralOfDeathClamp) {
+  // Lmite por tiempo de frame: 0.125 s como mucho, es decir 8 pasos.
+  {
+    ManualClock clock;
+    FrameLoop loop;
+    CHECK(loop.init(kStep, 0.125));
+    loop.reset(clock.now());
+    clock.advance(1.0);   // Un breakpoint de un segundo.
+    CHECK_EQ(loop.tick(clock.now(), nullptr), 8u);
+    CHECK_NEAR(loop.droppedTime(), 0.875, 1e-12);
+    CHECK_NEAR(loop.alpha(), 0.0, 1e-12);
+    CHECK_NEAR(loop.lastFrameTime(), 1.0, 1e-12);
+    // El siguiente frame normal vuelve a un paso.
+    clock.advance(kStep);
+    CHECK_EQ(loop.tick(clock.now(), nullptr), 1u);
+  }
+  // Lmite por pasos: 4 por tick; el excedente entero se descarta y se
+  // conserva la fraccin para interpolar.
+  {
+    FrameLoop loop;
+    CHECK(loop.init(kStep, 0.25, 4));
+    loop.reset(0.0);
+    CHECK_EQ(loop.advance(kStep * 6.5, nullptr), 4u);
+    CHECK_NEAR(loop.droppedTime(), kStep * 2.0, 1e-12);
+    CHECK_NEAR(loop.alpha(), 0.5, 1e-12);
+    CHECK_EQ(loop.totalSteps(), 4u);
+  }
+}
+
+NAVI_TEST(frameloop, clockGoingBackwards) {
+  FrameLoop loop;
+  CHECK(loop.init(kStep));
+  loop.reset(10.0);
+  CHECK_EQ(loop.tick(10.0 + kStep * 1.5, nullptr), 1u);
+  CHECK_EQ(loop.tick(5.0, nullptr), 0u);
+  CHECK_NEAR(loop.alpha(), 0.5, 1e-12);
+}
+
+NAVI_TEST(frameloop, deterministicUnderJitter) {
+  // Dos ejecuciones con la misma secuencia de frames irregulares (60 Hz con
+  // ruido) dan exactamente los mismos pasos y el mismo estado simulado.
+  auto simulate = [](uint64_t& steps, double& position, double& totalTime) {
+    ManualClock clock;
+    FrameLoop loop;
+    loop.init(1.0 / 60.0);
+    loop.reset(clock.now());
+    uint32_t state = 12345u;
+    double velocity = 1.0;
+    position = 0.0;
+    for (int frame = 0; frame < 2000; ++frame) {
+      state = state * 1664525u + 1013904223u;
+      clock.advance(1.0 / 60.0 + ((state >> 8) / 16777216.0 - 0.5) * 0.01);
+      loop.tick(clock.now(), [&](double dt) {
+        velocity -= position * dt;
+        position += velocity * dt;
+      });
+    }
+    steps = loop.totalSteps();
+    totalTime = clock.now();
+    // Tiempo simulado + fraccin pendiente = tiempo real (sin descartes).
+    return loop.simulationTime() + loop.alpha() * loop.fixedStep();
+  };
+  uint64_t stepsA = 0, stepsB = 0;
+  double positionA = 0.0, positionB = 0.0, timeA = 0.0, timeB = 0.0;
+  double accountedA = simulate(stepsA, positionA, timeA);
+  simulate(stepsB, positionB, timeB);
+  CHECK_EQ(stepsA, stepsB);
+  CHECK_EQ(positionA, positionB);
+  CHECK_NEAR(accountedA, timeA, 1e-9);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file FramePacerTests.cpp
+ * @brief Pruebas de FramePacer con un reloj simulado: dormir y girar solo
+ *        avanzan el ManualClock, as que las pruebas no dependen del sistema.
+ */
+#include "NaviTest.h"
+#include "Clock.h"
+#include "FramePacer.h"
+
+namespace {
+  const double kRate = 64.0;
+  const double kPeriod = 1.0 / kRate;
+  const double kSpinStep = 0.0001;
+
+  /**
+   * @brief Pacer sobre un ManualClock cuyo sueo se pasa @p oversleep segundos.
+   */
+  struct
+  FakePacer {
+    ManualClock clock;
+    FramePacer pacer;
+    unsigned int sleeps = 0;
+    unsigned int spins = 0;
+
+    explicit FakePacer(double targetRate, double oversleep = 0.001) {
+      pacer.init(clock, targetRate, 0.002,
+                 [this, oversleep](double seconds) {
+                   ++sleeps;
+                   clock.advance(seconds + oversleep);
+                 },
+                 [this]() {
+                   ++spins;
+                   clock.advance(kSpinStep);
+                 });
+      pacer.waitForNextFrame();   // Primer frame: fija la fecha lmite.
+    }
+
+    /**
+     * @brief Un frame con @p work segundos de trabajo antes de esperar.
+     */
+    double
+    frame(double work) {
+      clock.advance(work);
+      return pacer.waitForNextFrame();
+    }
+  };
+}
+
+NAVI_TEST(pacer, holdsTargetRate) {
+  FakePacer fake(kRate);
+  for (int i = 0; i < 100; ++i) {
+    double frameTime = fake.frame(0.004);
+    // Las fechas lmite forman una rejilla exacta: cada frame termina entre su
+    // fecha y un paso de giro despus, as que el intervalo vara en un paso.
+    CHECK(frameTime >= kPeriod - kSpinStep - 1e-9);
+    CHECK(frameTime <= kPeriod + kSpinStep + 1e-9);
+  }
+  const FrameTimeStats& stats = fake.pacer.stats();
+  CHECK_EQ(stats.frameCount, 100u);
+  CHECK_EQ(stats.missedDeadlines, 0u);
+  CHECK_NEAR(stats.mean, kPeriod, kSpinStep);
+  CHECK(stats.maxWaitError <= kSpinStep + 1e-9);
+  // Una espera por frame durmiendo: el exceso de sueo aprendido evita pasarse.
+  CHECK_EQ(fake.sleeps, 100u);
+  // El giro cubre el margen final (2 ms) ms el exceso de sueo, no el frame entero.
+  CHECK(fake.spins <= 100u * 40u);
+}
+
+NAVI_TEST(pacer, missedFrameIsNotWaitError) {
+  FakePacer fake(kRate);
+  for (int i = 0; i < 10; ++i) {
+    fake.frame(0.004);
+  }
+  double errorBefore = fake.pacer.stats().maxWaitError;
+
+  // Un frame de tres periodos: ya llega tarde, no se espera.
+  unsigned int sleepsBefore = fake.sleeps;
+  double late = fake.frame(3.0 * kPeriod);
+  CHECK_NEAR(late, 3.0 * kPeriod, 1e-9);
+  CHECK_EQ(fake.pacer.stats().missedDeadlines, 1u);
+  CHECK_EQ(fake.sleeps, sleepsBefore);
+  CHECK_EQ(fake.pacer.stats().maxWaitError, errorBefore);
+  CHECK(fake.pacer.stats().maxWaitError < 0.001);
+
+  // La fecha lmite se resincroniza: el siguiente frame vuelve al periodo sin
+  // intentar recuperar los perdidos.
+  double next = fake.frame(0.004);
+  CHECK_NEAR(next, kPeriod, kSpinStep + 1e-9);
+  CHECK_EQ(fake.pacer.stats().missedDeadlines, 1u);
+  CHECK_EQ(fake.pacer.stats().frameCount, 12u);
+  CHECK_NEAR(fake.pacer.stats().maxFrame, 3.0 * kPeriod, 1e-9);
+}
+
+NAVI_TEST(pacer, oversleepIsWaitError) {
+  // Un sueo que se pasa 10 ms s es imprecisin de la espera.
+  FakePacer fake(kRate, 0.010);
+  fake.frame(0.001);
+  CHECK_EQ(fake.pacer.stats().missedDeadlines, 0u);
+  CHECK(fake.pacer.stats().maxWaitError > 0.005);
+}
+
+NAVI_TEST(pacer, unlimitedRate) {
+  FakePacer fake(0.0);
+  CHECK_EQ(fake.pacer.targetRate(), 0.0);
+  CHECK_NEAR(fake.frame(0.003), 0.003, 1e-12);
+  CHECK_NEAR(fake.frame(0.007), 0.007, 1e-12);
+  CHECK_EQ(fake.sleeps, 0u);
+  CHECK_EQ(fake.spins, 0u);
+  CHECK_EQ(fake.pacer.stats().missedDeadlines, 0u);
+  CHECK_NEAR(fake.pacer.stats().minFrame, 0.003, 1e-12);
+  CHECK_NEAR(fake.pacer.stats().maxFrame, 0.007, 1e-12);
+}
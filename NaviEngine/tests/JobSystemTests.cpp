@@ -0,0 +1,266 @@
+/**
+ * @file JobSystemTests.cpp
+ * @brief Pruebas de WorkStealingDeque y JobSystem (JobSystem.h).
+ */
+#include "NaviTest.h"
+#include "JobSystem.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+  // La cola solo guarda punteros: las pruebas usan valores centinela en lugar de Jobs.
+  Job*
+  fakeJob(size_t index) {
+    return reinterpret_cast<Job*>((index + 1) * 8);
+  }
+
+  size_t
+  fakeIndex(Job* job) {
+    return reinterpret_cast<size_t>(job) / 8 - 1;
+  }
+
+  /**
+   * @brief Arranca el JobSystem con @p workers hilos y lo detiene al salir del mbito.
+   */
+  struct
+  ScopedJobSystem {
+    explicit ScopedJobSystem(unsigned int workers) {
+      JobSystem::instance().destroy();
+      JobSystem::instance().init(workers);
+    }
+    ~ScopedJobSystem() { JobSystem::instance().destroy(); }
+  };
+}
+
+NAVI_TEST(jobs, dequeOrder) {
+  WorkStealingDeque deque;
+  CHECK(deque.pop() == nullptr);
+  CHECK(deque.steal() == nullptr);
+  for (size_t i = 0; i < 4; ++i) {
+    CHECK(deque.push(fakeJob(i)));
+  }
+  CHECK_EQ(deque.size(), 4);
+  // El dueo desapila lo ms reciente; los ladrones roban lo ms antiguo.
+  CHECK(deque.pop() == fakeJob(3));
+  CHECK(deque.steal() == fakeJob(0));
+  CHECK(deque.steal() == fakeJob(1));
+  CHECK(deque.pop() == fakeJob(2));
+  CHECK(deque.pop() == nullptr);
+  CHECK(deque.steal() == nullptr);
+  CHECK_EQ(deque.size(), 0);
+}
+
+NAVI_TEST(jobs, dequeCapacity) {
+  WorkStealingDeque deque;
+  for (int64_t i = 0; i < WorkStealingDeque::kCapacity; ++i) {
+    CHECK(deque.push(fakeJob(static_cast<size_t>(i))));
+  }
+  CHECK(!deque.push(fakeJob(0)));
+  CHECK_EQ(deque.size(), WorkStealingDeque::kCapacity);
+  // Al liberar un hueco por arriba se puede volver a apilar (el buffer es circular).
+  CHECK(deque.steal() == fakeJob(0));
+  CHECK(deque.push(fakeJob(12345)));
+  CHECK(deque.pop() == fakeJob(12345));
+}
+
+NAVI_TEST(jobs, dequeStealRace) {
+  // El dueo apila y desapila mientras tres ladrones roban: cada elemento
+  // debe salir exactamente una vez.
+  const size_t kItems = 200000;
+  const unsigned int kThieves = 3;
+  WorkStealingDeque deque;
+  std::unique_ptr<std::atomic<int>[]> taken(new std::atomic<int>[kItems]);
+  for (size_t i = 0; i < kItems; ++i) {
+    taken[i] = 0;
+  }
+  std::atomic<bool> done{ false };
+
+  std::vector<std::thread> thieves;
+  for (unsigned int t = 0; t < kThieves; ++t) {
+    thieves.emplace_back([&]() {
+      while (!done.load()) {
+        if (Job* job = deque.steal()) {
+          taken[fakeIndex(job)].fetch_add(1);
+        }
+      }
+    });
+  }
+
+  size_t next = 0;
+  while (next < kItems) {
+    // Rfagas de tamao variable para pasar por cola vaca, con un elemento y llena.
+    size_t burst = 1 + next % 7;
+    for (size_t i = 0; i < burst && next < kItems; ++i) {
+      if (deque.push(fakeJob(next))) {
+        ++next;
+      }
+    }
+    if (next % 3 == 0) {
+      if (Job* job = deque.pop()) {
+        taken[fakeIndex(job)].fetch_add(1);
+      }
+    }
+  }
+  while (Job* job = deque.pop()) {
+    taken[fakeIndex(job)].fetch_add(1);
+  }
+  done = true;
+  for (std::thread& thread : thieves) {
+    thread.join();
+  }
+
+  size_t wrong = 0;
+  for (size_t i = 0; i < kItems; ++i) {
+    wrong += taken[i].load() != 1;
+  }
+  CHECK_EQ(wrong, 0u);
+}
+
+NAVI_TEST(jobs, overflowToInjectedQueue) {
+  // Con el nico trabajador ocupado, el hilo principal apila ms tareas de
+  // las que caben en su cola: las sobrantes van a la cola compartida.
+  ScopedJobSystem system(1);
+  JobSystem& jobs = JobSystem::instance();
+  std::atomic<bool> started{ false };
+  std::atomic<bool> release{ false };
+  JobCounter blocker;
+  jobs.run([&]() {
+    started = true;
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  }, &blocker);
+  // Se espera a que el trabajador la robe; ejecutarla aqu bloqueara el hilo principal.
+  while (!started.load()) {
+    std::this_thread::yield();
+  }
+
+  const size_t kJobs = static_cast<size_t>(WorkStealingDeque::kCapacity) + 500;
+  std::unique_ptr<std::atomic<int>[]> runs(new std::atomic<int>[kJobs]);
+  JobCounter counter;
+  for (size_t i = 0; i < kJobs; ++i) {
+    runs[i] = 0;
+    jobs.run([&runs, i]() { runs[i].fetch_add(1); }, &counter);
+  }
+  CHECK_EQ(counter.value(), static_cast<int>(kJobs));
+  release = true;
+  jobs.wait(counter);
+  jobs.wait(blocker);
+
+  size_t wrong = 0;
+  for (size_t i = 0; i < kJobs; ++i) {
+    wrong += runs[i].load() != 1;
+  }
+  CHECK_EQ(wrong, 0u);
+}
+
+NAVI_TEST(jobs, runAfterOrder) {
+  ScopedJobSystem system(3);
+  JobSystem& jobs = JobSystem::instance();
+  const int kFirst = 64;
+  std::atomic<int> firstDone{ 0 };
+  std::atomic<int> secondSawFirst{ -1 };
+  std::atomic<int> thirdSawSecond{ 0 };
+  std::atomic<int> secondDone{ 0 };
+
+  JobCounter first;
+  JobCounter second;
+  JobCounter third;
+  // El primer grupo queda retenido hasta registrar las continuaciones.
+  std::atomic<bool> gate{ false };
+  for (int i = 0; i < kFirst; ++i) {
+    jobs.run([&]() {
+      while (!gate.load()) {
+        std::this_thread::yield();
+      }
+      firstDone.fetch_add(1);
+    }, &first);
+  }
+  jobs.runAfter(first, [&]() {
+    secondSawFirst = firstDone.load();
+    secondDone = 1;
+  }, &second);
+  jobs.runAfter(second, [&]() { thirdSawSecond = secondDone.load(); }, &third);
+  CHECK_EQ(second.value(), 1);
+  CHECK_EQ(third.value(), 1);
+  CHECK_EQ(secondSawFirst.load(), -1);
+  gate = true;
+  jobs.wait(third);
+  CHECK(first.isDone());
+  CHECK(second.isDone());
+  CHECK_EQ(secondSawFirst.load(), kFirst);
+  CHECK_EQ(thirdSawSecond.load(), 1);
+
+  // Sobre un contador ya en cero la continuacin se planifica de inmediato.
+  JobCounter idle;
+  JobCounter after;
+  std::atomic<bool> ran{ false };
+  jobs.runAfter(idle, [&]() { ran = true; }, &after);
+  jobs.wait(after);
+  CHECK(ran.load());
+}
+
+NAVI_TEST(jobs, parallelForCoversRange) {
+  ScopedJobSystem system(3);
+  JobSystem& jobs = JobSystem::instance();
+  struct Range {
+    size_t begin, end, grain;
+  };
+  const Range ranges[] = {
+    { 0, 0, 0 }, { 5, 6, 0 }, { 0, 1000, 1 }, { 17, 100003, 0 }, { 3, 4099, 64 }, { 0, 100, 1000 }
+  };
+  for (const Range& range : ranges) {
+    std::unique_ptr<std::atomic<int>[]> hits(new std::atomic<int>[range.end + 1]);
+    for (size_t i = 0; i <= range.end; ++i) {
+      hits[i] = 0;
+    }
+    std::atomic<size_t> calls{ 0 };
+    std::atomic<bool> tooSmall{ false };
+    jobs.parallelFor(range.begin, range.end, [&](size_t begin, size_t end) {
+      calls.fetch_add(1);
+      if (end - begin == 0) {
+        tooSmall = true;
+      }
+      for (size_t i = begin; i < end; ++i) {
+        hits[i].fetch_add(1);
+      }
+    }, range.grain);
+
+    size_t wrong = 0;
+    for (size_t i = 0; i <= range.end; ++i) {
+      int expected = i >= range.begin && i < range.end ? 1 : 0;
+      wrong += hits[i].load() != expected;
+    }
+    CHECK_EQ(wrong, 0u);
+    CHECK(!tooSmall.load());
+    if (range.grain > 0 && range.end > range.begin) {
+      // Tramos de entre grain / 2 y grain ndices: no ms llamadas de las necesarias.
+      size_t count = range.end - range.begin;
+      CHECK(calls.load() <= 2 * ((count + range.grain - 1) / range.grain));
+    }
+  }
+
+  // parallelFor anidado dentro de las tareas de otro.
+  std::atomic<size_t> total{ 0 };
+  jobs.parallelFor(0, 64, [&](size_t begin, size_t end) {
+    for (size_t outer = begin; outer < end; ++outer) {
+      jobs.parallelFor(0, 100, [&](size_t innerBegin, size_t innerEnd) {
+        total.fetch_add(innerEnd - innerBegin);
+      }, 10);
+    }
+  }, 1);
+  CHECK_EQ(total.load(), 6400u);
+}
+
+NAVI_TEST(jobs, notInitializedRunsInline) {
+  JobSystem::instance().destroy();
+  JobSystem& jobs = JobSystem::instance();
+  int value = 0;
+  jobs.run([&]() { value = 1; });
+  CHECK_EQ(value, 1);
+  size_t covered = 0;
+  jobs.parallelFor(0, 50, [&](size_t begin, size_t end) { covered += end - begin; });
+  CHECK_EQ(covered, 50u);
+}
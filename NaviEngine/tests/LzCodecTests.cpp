@@ -0,0 +1,98 @@
+/**
+ * @file LzCodecTests.cpp
+ * @brief Pruebas de LzCodec: ida y vuelta y bloques truncados o corruptos.
+ */
+#include "NaviTest.h"
+#include "LzCodec.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+  /**
+   * @brief Datos con repeticiones (texto) seguidos de ruido incompresible.
+   */
+  std::vector<uint8_t>
+  sampleData(size_t size) {
+    std::vector<uint8_t> data(size);
+    const char kText[] = "the quick brown fox jumps over the lazy dog; ";
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < size; ++i) {
+      if (i < size / 2) {
+        data[i] = static_cast<uint8_t>(kText[i % (sizeof(kText) - 1)]);
+      }
+      else {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        data[i] = static_cast<uint8_t>(state);
+      }
+    }
+    return data;
+  }
+
+  bool
+  decompresses(const std::vector<uint8_t>& block, size_t size) {
+    std::vector<uint8_t> out(size + 1);
+    return lzDecompress(block.data(), block.size(), out.data(), size);
+  }
+}
+
+NAVI_TEST(lz, roundTrips) {
+  for (size_t size : { size_t(0), size_t(1), size_t(4), size_t(5), size_t(100), size_t(70000), size_t(300000) }) {
+    std::vector<uint8_t> data = sampleData(size);
+    std::vector<uint8_t> block;
+    size_t stored = lzCompress(data.data(), data.size(), block);
+    CHECK_EQ(stored, block.size());
+    CHECK(stored <= lzCompressBound(size));
+    std::vector<uint8_t> out(size);
+    CHECK(lzDecompress(block.data(), block.size(), out.data(), out.size()));
+    CHECK(out == data);
+  }
+
+  // Coincidencias que se solapan con su propia salida (desplazamiento 1).
+  std::vector<uint8_t> run(5000, 'x');
+  std::vector<uint8_t> block;
+  lzCompress(run.data(), run.size(), block);
+  CHECK(block.size() < 64);
+  std::vector<uint8_t> out(run.size());
+  CHECK(lzDecompress(block.data(), block.size(), out.data(), out.size()));
+  CHECK(out == run);
+}
+
+NAVI_TEST(lz, rejectsTruncatedBlocks) {
+  std::vector<uint8_t> data = sampleData(4096);
+  std::vector<uint8_t> block;
+  lzCompress(data.data(), data.size(), block);
+  // Ningn prefijo estricto del bloque produce los datos completos.
+  size_t accepted = 0;
+  for (size_t length = 0; length < block.size(); ++length) {
+    std::vector<uint8_t> prefix(block.begin(), block.begin() + length);
+    accepted += decompresses(prefix, data.size()) ? 1 : 0;
+  }
+  CHECK_EQ(accepted, 0u);
+  // Ni un tamao de salida distinto del original.
+  CHECK(!decompresses(block, data.size() - 1));
+  CHECK(!decompresses(block, data.size() + 1));
+}
+
+NAVI_TEST(lz, rejectsBadOffsets) {
+  // Un literal y una coincidencia de 4 bytes con desplazamiento 0.
+  CHECK(!decompresses({ 0x10, 'a', 0x00, 0x00 }, 5));
+  // Desplazamiento 2 con un solo byte escrito: apuntara antes de la salida.
+  CHECK(!decompresses({ 0x10, 'a', 0x02, 0x00 }, 5));
+  // El mismo bloque con desplazamiento 1 s es vlido.
+  CHECK(decompresses({ 0x10, 'a', 0x01, 0x00 }, 5));
+}
+
+NAVI_TEST(lz, rejectsOverlongLengths) {
+  // Literales: 15 + 255 + 255 + 10 con solo tres bytes detrs.
+  CHECK(!decompresses({ 0xF0, 0xFF, 0xFF, 0x0A, 'a', 'b', 'c' }, 3));
+  // Extensin de longitud sin terminar.
+  CHECK(!decompresses({ 0xF0, 0xFF, 0xFF }, 600));
+  // Literales que caben en la entrada pero no en la salida.
+  CHECK(!decompresses({ 0x30, 'a', 'b', 'c' }, 2));
+  // Coincidencia de 15 + 4 + 200 bytes para una salida de 100.
+  CHECK(!decompresses({ 0x1F, 'a', 0x01, 0x00, 200 }, 100));
+  CHECK(decompresses({ 0x1F, 'a', 0x01, 0x00, 200 }, 220));
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * @file NaviTest.h
+ * @brief Mnimo marco de pruebas de navitests: registro de casos y comprobaciones.
+ *
+ * Cada archivo *Tests.cpp define sus casos con NAVI_TEST(grupo, nombre); el
+ * ejecutable los lanza todos (o los que contienen el filtro de la lnea de
+ * rdenes) y devuelve 1 si alguna comprobacin falla, de modo que ctest y la
+ * CI lo detectan. Una comprobacin fallida no aborta el caso: se informa del
+ * archivo, la lnea y la expresin y el caso sigue.
+ */
+
+/**
+ * @struct TestCase
+ * @brief Caso registrado: "grupo/nombre" y la funcin que lo ejecuta.
+ */
+struct
+TestCase {
+  std::string name;
+  void (*run)();
+};
+
+/**
+ * @brief Casos registrados por los NAVI_TEST de todos los archivos.
+ */
+std::vector<TestCase>&
+testRegistry();
+
+/**
+ * @brief Registra un caso durante la inicializacin esttica.
+ */
+struct
+TestRegistrar {
+  TestRegistrar(const char* group, const char* name, void (*run)()) {
+    testRegistry().push_back({ std::string(group) + "/" + name, run });
+  }
+};
+
+/**
+ * @brief Anota un fallo del caso en curso.
+ */
+void
+testFailure(const char* file, int line, const std::string& message);
+
+#define NAVI_TEST(group, name)                                                   \
+  static void group##_##name();                                                  \
+  static TestRegistrar group##_##name##_registrar(#group, #name, group##_##name); \
+  static void group##_##name()
+
+#define CHECK(expression)                                                        \
+  do {                                                                           \
+    if (!(expression)) {                                                         \
+      testFailure(__FILE__, __LINE__, #expression);                              \
+    }                                                                            \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                           \
+  do {                                                                           \
+    if (!((a) == (b))) {                                                         \
+      testFailure(__FILE__, __LINE__, #a " == " #b);                             \
+    }                                                                            \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tolerance)                                              \
+  do {                                                                           \
+    double navi_a = (a);                                                         \
+    double navi_b = (b);                                                         \
+    if (!(std::fabs(navi_a - navi_b) <= (tolerance))) {                          \
+      testFailure(__FILE__, __LINE__, std::string(#a " ~= " #b " (") +           \
+                  std::to_string(navi_a) + " vs " + std::to_string(navi_b) + ")"); \
+    }                                                                            \
+  } while (0)
@@ -0,0 +1,75 @@
+/**
+ * @file NaviTests.cpp
+ * @brief Pruebas de las partes portables del motor (objetivo navitests).
+ *
+ * Se compila con NaviEngine/CMakeLists.txt y se lanza con ctest:
+ *
+ *   cmake -S NaviEngine -B build
+ *   cmake --build build -j
+ *   ctest --test-dir build --output-on-failure
+ *
+ * Opciones:
+ *   <texto>   Solo ejecuta los casos cuyo nombre contiene el texto.
+ *   --list    Lista los casos sin ejecutarlos.
+ */
+#include "NaviTest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+  /** @brief Fallos del caso en curso. */
+  unsigned int g_failures = 0;
+}
+
+std::vector<TestCase>&
+testRegistry() {
+  static std::vector<TestCase> registry;
+  return registry;
+}
+
+void
+testFailure(const char* file, int line, const std::string& message) {
+  ++g_failures;
+  std::fprintf(stderr, "  %s:%d: check failed: %s\n", file, line, message.c_str());
+}
+
+int
+main(int argc, char** argv) {
+  const char* filter = nullptr;
+  bool list = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--list") == 0) {
+      list = true;
+    }
+    else {
+      filter = argv[i];
+    }
+  }
+
+  unsigned int ran = 0;
+  unsigned int failed = 0;
+  for (const TestCase& test : testRegistry()) {
+    if (filter && test.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    if (list) {
+      std::printf("%s\n", test.name.c_str());
+      continue;
+    }
+    g_failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    test.run();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "[%s] %s (%.1f ms)\n", g_failures ? "FAIL" : " OK ", test.name.c_str(), ms);
+    ++ran;
+    if (g_failures) {
+      ++failed;
+    }
+  }
+  if (!list) {
+    std::fprintf(stderr, "%u tests, %u failed\n", ran, failed);
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file PakFileTests.cpp
+ * @brief Pruebas de PakWriter y PakArchive: lectura de entradas y rechazo de
+ *        archivos con la cabecera o la tabla de contenidos corruptas.
+ */
+#include "NaviTest.h"
+#include "PakFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+  /**
+   * @brief Carpeta temporal con un .pak de dos entradas (una comprimida); se
+   *        borra al salir.
+   */
+  struct
+  PakFixture {
+    std::filesystem::path root;
+    std::filesystem::path pak;
+    std::vector<uint8_t> text;
+    std::vector<uint8_t> noise;
+
+    explicit PakFixture(const char* name) {
+      root = std::filesystem::temp_directory_path() / (std::string("navitests_") + name);
+      std::filesystem::remove_all(root);
+      std::filesystem::create_directories(root);
+      pak = root / "assets.pak";
+
+      const char kLine[] = "float4 PS() : SV_Target { return 1; }\n";
+      for (int i = 0; i < 64; ++i) {
+        text.insert(text.end(), kLine, kLine + sizeof(kLine) - 1);
+      }
+      uint32_t state = 2463534242u;
+      for (int i = 0; i < 1000; ++i) {
+        state = state * 1664525u + 1013904223u;
+        noise.push_back(static_cast<uint8_t>(state >> 24));
+      }
+      PakWriter writer;
+      writer.add("shaders/Main.fx", text.data(), text.size(), true);
+      writer.add("textures/noise.bin", noise.data(), noise.size(), false);
+      writer.write(pak.string());
+    }
+
+    ~PakFixture() {
+      std::error_code error;
+      std::filesystem::remove_all(root, error);
+    }
+
+    std::vector<uint8_t>
+    bytes() const {
+      std::ifstream file(pak, std::ios::binary);
+      return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * @brief Escribe @p bytes en otro archivo y comprueba que load() lo
+     *        rechaza con un error que contiene @p expected.
+     */
+    bool
+    rejects(const std::vector<uint8_t>& bytes, const char* expected) const {
+      std::filesystem::path corrupt = root / "corrupt.pak";
+      {
+        std::ofstream file(corrupt, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+      }
+      PakArchive archive;
+      std::string error;
+      bool ok = archive.load(corrupt.string(), &error);
+      if (ok || error.find(expected) == std::string::npos) {
+        std::fprintf(stderr, "  expected \"%s\", got %s \"%s\"\n", expected, ok ? "success" : "error", error.c_str());
+        return false;
+      }
+      return !archive.isLoaded();
+    }
+  };
+
+  /**
+   * @brief Entrada @p index de la tabla de contenidos de @p bytes.
+   */
+  PakEntry*
+  entryAt(std::vector<uint8_t>& bytes, size_t index) {
+    PakHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    return reinterpret_cast<PakEntry*>(bytes.data() + header.tocOffset) + index;
+  }
+
+  /**
+   * @brief Primera entrada de @p bytes con los flags @p flags.
+   */
+  PakEntry*
+  entryWithFlags(std::vector<uint8_t>& bytes, uint32_t flags) {
+    for (size_t i = 0; i < 2; ++i) {
+      if (entryAt(bytes, i)->flags == flags) {
+        return entryAt(bytes, i);
+      }
+    }
+    return nullptr;
+  }
+}
+
+NAVI_TEST(pak, readsEntries) {
+  PakFixture fixture("pak_reads");
+  PakArchive archive;
+  std::string error;
+  CHECK(archive.load(fixture.pak.string(), &error));
+  CHECK_EQ(archive.entryCount(), 2u);
+
+  const PakEntry* shader = archive.find("Shaders\\main.fx");
+  CHECK(shader != nullptr);
+  if (shader) {
+    CHECK(shader->flags & PAK_ENTRY_LZ);
+    CHECK(shader->storedSize < shader->size);
+  }
+  FileView view;
+  CHECK(archive.open("shaders/Main.fx", view));
+  CHECK(view.size() == fixture.text.size() && std::memcmp(view.data(), fixture.text.data(), view.size()) == 0);
+  CHECK(archive.open("textures/noise.bin", view));
+  CHECK(view.size() == fixture.noise.size() && std::memcmp(view.data(), fixture.noise.data(), view.size()) == 0);
+  CHECK(!archive.exists("textures/missing.bin"));
+}
+
+NAVI_TEST(pak, rejectsBadMagic) {
+  PakFixture fixture("pak_magic");
+  std::vector<uint8_t> bytes = fixture.bytes();
+  bytes[0] = 'X';
+  CHECK(fixture.rejects(bytes, "pak file"));
+  CHECK(fixture.rejects(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 20), "too small"));
+}
+
+NAVI_TEST(pak, rejectsTocOutOfRange) {
+  PakFixture fixture("pak_toc");
+  std::vector<uint8_t> valid = fixture.bytes();
+  PakHeader header;
+  std::memcpy(&header, valid.data(), sizeof(header));
+
+  std::vector<uint8_t> bytes = valid;
+  header.tocOffset = valid.size() + 64;
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  CHECK(fixture.rejects(bytes, "table of contents"));
+
+  // Ms entradas de las que caben en el archivo.
+  std::memcpy(&header, valid.data(), sizeof(header));
+  header.entryCount = 0x10000000u;
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  CHECK(fixture.rejects(bytes, "table of contents"));
+
+  std::memcpy(&header, valid.data(), sizeof(header));
+  header.namesSize = valid.size();
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  CHECK(fixture.rejects(bytes, "table of contents"));
+}
+
+NAVI_TEST(pak, rejectsEntryOutOfRange) {
+  PakFixture fixture("pak_entry");
+  std::vector<uint8_t> valid = fixture.bytes();
+
+  std::vector<uint8_t> bytes = valid;
+  entryAt(bytes, 1)->offset = valid.size() + 1;
+  CHECK(fixture.rejects(bytes, "corrupt entry 1"));
+
+  bytes = valid;
+  entryAt(bytes, 0)->storedSize = valid.size();
+  CHECK(fixture.rejects(bytes, "corrupt entry 0"));
+
+  bytes = valid;
+  entryAt(bytes, 1)->nameLength = 0x1000;
+  CHECK(fixture.rejects(bytes, "corrupt entry 1"));
+
+  // Una entrada sin comprimir con otro tamao que el guardado.
+  bytes = valid;
+  PakEntry* raw = entryWithFlags(bytes, 0);
+  CHECK(raw != nullptr);
+  if (raw) {
+    raw->size += 1;
+    CHECK(fixture.rejects(bytes, "corrupt entry"));
+  }
+}
+
+NAVI_TEST(pak, rejectsImpossibleLzSizes) {
+  PakFixture fixture("pak_lz");
+  std::vector<uint8_t> valid = fixture.bytes();
+
+  // Tamaos que un bloque LZ de storedSize bytes no puede producir: extract()
+  // los reservara antes de descomprimir.
+  std::vector<uint8_t> bytes = valid;
+  PakEntry* packed = entryWithFlags(bytes, PAK_ENTRY_LZ);
+  CHECK(packed != nullptr);
+  if (!packed) {
+    return;
+  }
+  uint64_t storedSize = packed->storedSize;
+  packed->size = ~0ull;
+  CHECK(fixture.rejects(bytes, "corrupt entry"));
+  packed->size = storedSize * 255 + 17;
+  CHECK(fixture.rejects(bytes, "corrupt entry"));
+  packed->size = 0;
+  CHECK(fixture.rejects(bytes, "corrupt entry"));
+
+  // En el lmite se acepta la tabla, y es la descompresin la que falla.
+  packed->size = storedSize * 255 + 16;
+  std::filesystem::path limit = fixture.root / "limit.pak";
+  {
+    std::ofstream file(limit, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  }
+  PakArchive archive;
+  CHECK(archive.load(limit.string()));
+  FileView view;
+  CHECK(!archive.open("shaders/main.fx", view));
+}
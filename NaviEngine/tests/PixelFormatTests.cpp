@@ -0,0 +1,164 @@
+/**
+ * @file PixelFormatTests.cpp
+ * @brief Pruebas de la eleccin de formato por canales y uso, y de convertChannels()
+ *        contra una conversin de referencia.
+ */
+#include "NaviTest.h"
+#include "PixelFormat.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+  /**
+   * @brief Conversin de referencia de un pxel, independiente de PixelFormat.cpp.
+   */
+  void
+  referenceChannels(const uint8_t* src, unsigned int srcChannels, uint8_t* dst, unsigned int dstChannels) {
+    uint8_t rgba[4] = { src[0], src[0], src[0], 255 };
+    if (srcChannels == 2) {
+      rgba[3] = src[1];
+    }
+    else if (srcChannels >= 3) {
+      rgba[1] = src[1];
+      rgba[2] = src[2];
+      rgba[3] = srcChannels == 4 ? src[3] : 255;
+    }
+    dst[0] = rgba[0];
+    if (dstChannels == 2) {
+      dst[1] = srcChannels <= 2 ? rgba[3] : rgba[1];
+    }
+    else if (dstChannels == 4) {
+      std::memcpy(dst, rgba, 4);
+    }
+  }
+
+  std::vector<uint8_t>
+  patternPixels(size_t pixelCount, unsigned int channels) {
+    std::vector<uint8_t> pixels(pixelCount * channels);
+    uint32_t state = 12345;
+    for (uint8_t& value : pixels) {
+      state = state * 1664525u + 1013904223u;
+      value = static_cast<uint8_t>(state >> 24);
+    }
+    return pixels;
+  }
+
+  /**
+   * @brief Convierte @p count de @p total pxeles y compara con la referencia;
+   *        los pxeles que no se piden deben quedar intactos.
+   */
+  bool
+  matchesReference(unsigned int srcChannels, unsigned int dstChannels, size_t total, size_t count) {
+    std::vector<uint8_t> pixels = patternPixels(total, srcChannels);
+    std::vector<uint8_t> output(total * dstChannels, 0);
+    if (!convertChannels(pixels.data(), srcChannels, output.data(), dstChannels, count)) {
+      return false;
+    }
+    uint8_t expected[4] = {};
+    for (size_t i = 0; i < total; ++i) {
+      const uint8_t* actual = output.data() + i * dstChannels;
+      if (i < count) {
+        referenceChannels(pixels.data() + i * srcChannels, srcChannels, expected, dstChannels);
+      }
+      else {
+        std::memset(expected, 0, sizeof(expected));
+      }
+      if (std::memcmp(actual, expected, dstChannels) != 0) {
+        std::fprintf(stderr, "  channels %u->%u mismatch at pixel %zu of %zu\n", srcChannels, dstChannels, i, count);
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+NAVI_TEST(pixelformat, autoFollowsSourceChannels) {
+  ImageFormat gray = chooseImageFormat(1, TEXTURE_USAGE_AUTO);
+  CHECK_EQ(gray.channels, 1u);
+  CHECK_EQ(gray.dxgiFormat, 61u);
+  CHECK(!gray.color);
+
+  ImageFormat grayAlpha = chooseImageFormat(2, TEXTURE_USAGE_AUTO);
+  CHECK_EQ(grayAlpha.channels, 2u);
+  CHECK_EQ(grayAlpha.dxgiFormat, 49u);
+  CHECK(!grayAlpha.color);
+
+  // RGB no tiene formato de tres canales: se sube como RGBA8.
+  for (unsigned int channels : { 3u, 4u }) {
+    ImageFormat color = chooseImageFormat(channels, TEXTURE_USAGE_AUTO);
+    CHECK_EQ(color.channels, 4u);
+    CHECK_EQ(color.dxgiFormat, 28u);
+    CHECK(color.color);
+    CHECK(!color.srgb);
+  }
+}
+
+NAVI_TEST(pixelformat, usageOverridesSourceChannels) {
+  for (unsigned int source = 1; source <= 4; ++source) {
+    ImageFormat color = chooseImageFormat(source, TEXTURE_USAGE_COLOR);
+    CHECK_EQ(color.channels, 4u);
+    CHECK_EQ(color.dxgiFormat, 28u);
+    CHECK(color.color);
+
+    ImageFormat srgb = chooseImageFormat(source, TEXTURE_USAGE_COLOR_SRGB);
+    CHECK_EQ(srgb.channels, 4u);
+    CHECK_EQ(srgb.dxgiFormat, 29u);
+    CHECK(srgb.srgb);
+
+    ImageFormat data = chooseImageFormat(source, TEXTURE_USAGE_DATA);
+    CHECK_EQ(data.channels, 4u);
+    CHECK_EQ(data.dxgiFormat, 28u);
+    CHECK(!data.color);
+
+    ImageFormat mask = chooseImageFormat(source, TEXTURE_USAGE_MASK);
+    CHECK_EQ(mask.channels, 1u);
+    CHECK_EQ(mask.dxgiFormat, 61u);
+    CHECK(!mask.color);
+
+    ImageFormat normal = chooseImageFormat(source, TEXTURE_USAGE_NORMAL_XY);
+    CHECK_EQ(normal.channels, 2u);
+    CHECK_EQ(normal.dxgiFormat, 49u);
+    CHECK(!normal.color);
+  }
+}
+
+NAVI_TEST(pixelformat, convertMatchesReference) {
+  // Recuentos por debajo, en y por encima de un bloque de 16 pxeles, con cola
+  // escalar impar tras los ncleos vectoriales.
+  static const size_t kCounts[] = { 0, 1, 2, 15, 16, 17, 31, 64, 1000, 1013 };
+  for (unsigned int srcChannels = 1; srcChannels <= 4; ++srcChannels) {
+    for (unsigned int dstChannels : { 1u, 2u, 4u }) {
+      for (size_t count : kCounts) {
+        CHECK(matchesReference(srcChannels, dstChannels, 1024, count));
+      }
+    }
+  }
+}
+
+NAVI_TEST(pixelformat, convertRejectsUnsupported) {
+  uint8_t src[16] = {};
+  uint8_t dst[16] = {};
+  CHECK(!convertChannels(src, 0, dst, 4, 1));
+  CHECK(!convertChannels(src, 5, dst, 4, 1));
+  CHECK(!convertChannels(src, 4, dst, 3, 1));
+}
+
+NAVI_TEST(pixelformat, mipChainReducesChannels) {
+  DecodedImage image;
+  image.width = 8;
+  image.height = 4;
+  image.channels = 3;
+  image.pixels = patternPixels(32, 3);
+  ImageFormat format = chooseImageFormat(3, TEXTURE_USAGE_NORMAL_XY);
+  MipChain chain;
+  CHECK(buildMipChain(std::move(image), format, format.channels, chain));
+  CHECK_EQ(chain.channels, 2u);
+  CHECK_EQ(chain.levels.size(), 4u);
+  for (const MipLevel& level : chain.levels) {
+    CHECK_EQ(level.pixels.size(), static_cast<size_t>(level.width) * level.height * 2);
+  }
+
+  DecodedImage empty;
+  CHECK(!buildMipChain(std::move(empty), format, 2, chain));
+}
@@ -0,0 +1,34 @@
+/**
+ * @file ProfilerTests.cpp
+ * @brief Pruebas del registro de hilos del Profiler.
+ */
+#include "NaviTest.h"
+#include "Profiler.h"
+
+#include <thread>
+
+NAVI_TEST(profiler, threadNamesDoNotDependOnOrder) {
+  // Un hilo secundario se registra antes que el principal: ninguno recibe
+  // "Main" por llegar primero.
+  Profiler& profiler = Profiler::instance();
+  std::string workerName;
+  uint32_t workerId = 0;
+  std::thread worker([&]() {
+    ProfileThreadBuffer* buffer = profiler.threadBuffer();
+    workerName = buffer->m_threadName;
+    workerId = buffer->m_threadId;
+  });
+  worker.join();
+  CHECK_EQ(workerName, "Thread " + std::to_string(workerId));
+
+  profiler.setThreadName("Main");
+  CHECK_EQ(profiler.threadBuffer()->m_threadName, std::string("Main"));
+  CHECK(profiler.threadBuffer()->m_threadId != workerId);
+
+  std::thread named([&]() {
+    profiler.setThreadName("Loader");
+    workerName = profiler.threadBuffer()->m_threadName;
+  });
+  named.join();
+  CHECK_EQ(workerName, std::string("Loader"));
+}
@@ -0,0 +1,255 @@
+/**
+ * @file ShaderCacheTests.cpp
+ * @brief Pruebas de ShaderCache con un compilador simulado y fuentes en una
+ *        carpeta temporal: aciertos, invalidacin y escritura de entradas.
+ */
+#include "NaviTest.h"
+#include "ShaderCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+  /**
+   * @brief Compilador simulado: el "bytecode" son el perfil, la entrada y los
+   *        defines, y cuenta las compilaciones.
+   */
+  class
+  FakeShaderCompiler : public ShaderCompiler {
+  public:
+    bool
+    compile(const ShaderCompileRequest& request,
+            std::vector<uint8_t>& bytecode,
+            std::string& errors) override {
+      ++compilations;
+      if (fail) {
+        errors = "fake compile error";
+        return false;
+      }
+      std::string text = m_version + ":" + request.profile + ":" + request.entryPoint;
+      for (const auto& define : request.defines) {
+        text += ":" + define.first + "=" + define.second;
+      }
+      bytecode.assign(text.begin(), text.end());
+      return true;
+    }
+
+    std::string
+    version() const override { return m_version; }
+
+    unsigned int compilations = 0;
+    bool fail = false;
+    std::string m_version = "fake_1";
+  };
+
+  /**
+   * @brief Carpeta temporal con un shader que incluye otro archivo; se borra al salir.
+   */
+  struct
+  ShaderFixture {
+    std::filesystem::path root;
+    std::filesystem::path cache;
+    FakeShaderCompiler compiler;
+    ShaderCache shaderCache;
+    ShaderCompileRequest request;
+
+    explicit ShaderFixture(const char* name) {
+      root = std::filesystem::temp_directory_path() / (std::string("navitests_") + name);
+      std::filesystem::remove_all(root);
+      std::filesystem::create_directories(root / "shaders" / "common");
+      cache = root / "cache";
+      write("shaders/Main.fx", "#include \"common/Lighting.hlsli\"\nfloat4 PS() : SV_Target { return 1; }\n");
+      write("shaders/common/Lighting.hlsli", "#include \"Constants.hlsli\"\nfloat3 light;\n");
+      write("shaders/common/Constants.hlsli", "static const float kPi = 3.14159;\n");
+      shaderCache.init(cache.string(), compiler);
+      request.fileName = (root / "shaders" / "Main.fx").string();
+      request.entryPoint = "PS";
+      request.profile = "ps_4_0";
+      request.defines = { { "TEXTURED", "1" } };
+    }
+
+    ~ShaderFixture() {
+      std::error_code error;
+      std::filesystem::remove_all(root, error);
+    }
+
+    void
+    write(const std::string& relative, const std::string& text) {
+      std::ofstream file(root / relative, std::ios::binary | std::ios::trunc);
+      file << text;
+    }
+
+    /**
+     * @brief Archivos de la carpeta de cach con la extensin @p extension.
+     */
+    size_t
+    countEntries(const std::string& extension) const {
+      size_t count = 0;
+      for (const auto& entry : std::filesystem::directory_iterator(cache)) {
+        count += entry.path().extension() == extension;
+      }
+      return count;
+    }
+  };
+}
+
+NAVI_TEST(shadercache, hitOnIdenticalRequest) {
+  ShaderFixture fixture("shadercache_hit");
+  CHECK(fixture.shaderCache.isInitialized());
+  std::vector<uint8_t> first;
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, first));
+  CHECK_EQ(fixture.compiler.compilations, 1u);
+  CHECK_EQ(fixture.shaderCache.misses(), 1u);
+
+  std::vector<uint8_t> second;
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, second));
+  CHECK_EQ(fixture.compiler.compilations, 1u);
+  CHECK_EQ(fixture.shaderCache.hits(), 1u);
+  CHECK(second == first);
+
+  // Otra instancia sobre la misma carpeta (un arranque posterior) tambin acierta.
+  ShaderCache restarted;
+  CHECK(restarted.init(fixture.cache.string(), fixture.compiler));
+  std::vector<uint8_t> third;
+  CHECK(restarted.getOrCompile(fixture.request, third));
+  CHECK_EQ(fixture.compiler.compilations, 1u);
+  CHECK(third == first);
+}
+
+NAVI_TEST(shadercache, missWhenIncludeOrDefineChanges) {
+  ShaderFixture fixture("shadercache_invalidate");
+  std::vector<uint8_t> bytecode;
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, bytecode));
+  uint64_t original = fixture.shaderCache.computeKey(fixture.request);
+
+  // Un include de segundo nivel cambia: clave nueva y recompilacin.
+  fixture.write("shaders/common/Constants.hlsli", "static const float kPi = 3.1415926;\n");
+  CHECK(fixture.shaderCache.computeKey(fixture.request) != original);
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, bytecode));
+  CHECK_EQ(fixture.compiler.compilations, 2u);
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, bytecode));
+  CHECK_EQ(fixture.compiler.compilations, 2u);
+
+  // Un define distinto es otra variante: otra entrada.
+  ShaderCompileRequest skinned = fixture.request;
+  skinned.defines.push_back({ "SKINNING", "1" });
+  CHECK(fixture.shaderCache.getOrCompile(skinned, bytecode));
+  CHECK_EQ(fixture.compiler.compilations, 3u);
+  ShaderCompileRequest valueChanged = fixture.request;
+  valueChanged.defines[0].second = "0";
+  CHECK(fixture.shaderCache.getOrCompile(valueChanged, bytecode));
+  CHECK_EQ(fixture.compiler.compilations, 4u);
+
+  // Entrada, perfil y banderas tambin forman parte de la clave.
+  ShaderCompileRequest vertex = fixture.request;
+  vertex.entryPoint = "VS";
+  vertex.profile = "vs_4_0";
+  CHECK(fixture.shaderCache.computeKey(vertex) != fixture.shaderCache.computeKey(fixture.request));
+  ShaderCompileRequest flagged = fixture.request;
+  flagged.flags = 1;
+  CHECK(fixture.shaderCache.computeKey(flagged) != fixture.shaderCache.computeKey(fixture.request));
+
+  // La peticin original sigue acertando: su entrada no se toc.
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, bytecode));
+  CHECK_EQ(fixture.compiler.compilations, 4u);
+  CHECK_EQ(fixture.countEntries(".cso"), 4u);
+}
+
+NAVI_TEST(shadercache, missWhenCompilerVersionChanges) {
+  ShaderFixture fixture("shadercache_version");
+  std::vector<uint8_t> bytecode;
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, bytecode));
+  CHECK_EQ(fixture.compiler.compilations, 1u);
+
+  fixture.compiler.m_version = "fake_2";
+  std::vector<uint8_t> recompiled;
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, recompiled));
+  CHECK_EQ(fixture.compiler.compilations, 2u);
+  CHECK(recompiled != bytecode);
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, recompiled));
+  CHECK_EQ(fixture.compiler.compilations, 2u);
+}
+
+NAVI_TEST(shadercache, storeWritesCompleteEntries) {
+  ShaderFixture fixture("shadercache_store");
+  std::vector<uint8_t> bytecode;
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, bytecode));
+  uint64_t key = fixture.shaderCache.computeKey(fixture.request);
+  // El temporal se renombra a la entrada final y no queda rastro de l.
+  CHECK(std::filesystem::exists(fixture.shaderCache.entryPath(key)));
+  CHECK_EQ(fixture.countEntries(".cso"), 1u);
+  CHECK_EQ(fixture.countEntries(".tmp"), 0u);
+
+  // Reescribir una entrada existente la sustituye.
+  std::vector<uint8_t> replacement = { 1, 2, 3, 4, 5 };
+  CHECK(fixture.shaderCache.store(key, replacement));
+  std::vector<uint8_t> loaded;
+  CHECK(fixture.shaderCache.load(key, loaded));
+  CHECK(loaded == replacement);
+  CHECK_EQ(fixture.countEntries(".tmp"), 0u);
+
+  // Una entrada truncada o con otra clave no se acepta: se recompila y se reescribe.
+  std::filesystem::resize_file(fixture.shaderCache.entryPath(key), 20);
+  CHECK(!fixture.shaderCache.load(key, loaded));
+  CHECK(!fixture.shaderCache.load(key + 1, loaded));
+  CHECK(fixture.shaderCache.getOrCompile(fixture.request, loaded));
+  CHECK_EQ(fixture.compiler.compilations, 2u);
+  CHECK(loaded == bytecode);
+  CHECK(fixture.shaderCache.load(key, loaded));
+
+  // Sin carpeta de destino la escritura falla sin dejar el temporal.
+  std::filesystem::remove_all(fixture.cache);
+  CHECK(!fixture.shaderCache.store(key, bytecode));
+  CHECK(!std::filesystem::exists(fixture.cache));
+}
+
+NAVI_TEST(shadercache, concurrentStoresOfOneKey) {
+  // Varios hilos compilan el mismo shader a la vez: cada uno escribe su propio
+  // temporal y el ltimo renombrado gana; la entrada final es vlida y completa.
+  ShaderFixture fixture("shadercache_concurrent");
+  uint64_t key = fixture.shaderCache.computeKey(fixture.request);
+  std::vector<uint8_t> payload(4096);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i * 7);
+  }
+  std::vector<std::thread> writers;
+  std::vector<int> stored(4, 0);
+  for (size_t t = 0; t < stored.size(); ++t) {
+    writers.emplace_back([&fixture, &payload, &stored, key, t]() {
+      for (int i = 0; i < 25; ++i) {
+        stored[t] += fixture.shaderCache.store(key, payload) ? 1 : 0;
+      }
+    });
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  for (int count : stored) {
+    CHECK_EQ(count, 25);
+  }
+  std::vector<uint8_t> loaded;
+  CHECK(fixture.shaderCache.load(key, loaded));
+  CHECK(loaded == payload);
+  CHECK_EQ(fixture.countEntries(".cso"), 1u);
+  CHECK_EQ(fixture.countEntries(".tmp"), 0u);
+}
+
+NAVI_TEST(shadercache, compileFailure) {
+  ShaderFixture fixture("shadercache_failure");
+  fixture.compiler.fail = true;
+  std::vector<uint8_t> bytecode;
+  std::string errors;
+  CHECK(!fixture.shaderCache.getOrCompile(fixture.request, bytecode, &errors));
+  CHECK_EQ(errors, std::string("fake compile error"));
+  CHECK_EQ(fixture.shaderCache.failures(), 1u);
+  CHECK_EQ(fixture.countEntries(".cso"), 0u);
+
+  // Un archivo fuente inexistente no tiene clave: se intenta compilar sin guardar.
+  fixture.compiler.fail = false;
+  ShaderCompileRequest missing = fixture.request;
+  missing.fileName = (fixture.root / "shaders" / "Missing.fx").string();
+  CHECK_EQ(fixture.shaderCache.computeKey(missing), 0u);
+  CHECK(fixture.shaderCache.getOrCompile(missing, bytecode));
+  CHECK_EQ(fixture.countEntries(".cso"), 0u);
+}
@@ -0,0 +1,247 @@
+/**
+ * @file SimdMathTests.cpp
+ * @brief Pruebas de SimdMath: los ncleos por lotes de la ruta compilada contra
+ *        referencias escalares en double, con recuentos que ejercitan la cola.
+ */
+#include "NaviTest.h"
+#include "SimdMath.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace SimdMath;
+
+namespace {
+  const double kTolerance = 1e-4;
+
+  // Recuentos por debajo y alrededor de los bloques de 4 y 8 elementos.
+  const size_t kCounts[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1001 };
+
+  struct
+  Random {
+    uint32_t state = 2024;
+
+    float
+    next() {
+      state = state * 1664525u + 1013904223u;
+      return static_cast<float>(state >> 8) / 16777216.0f * 20.0f - 10.0f;
+    }
+  };
+
+  Matrix
+  testWorld() {
+    return multiply(multiply(scaling(1.5f, 0.5f, 2.0f), rotationRollPitchYaw(0.3f, 1.1f, -0.7f)),
+                    translation(3.0f, -2.0f, 5.0f));
+  }
+
+  /**
+   * @brief Componente @p column de p * M en double, con o sin traslacin.
+   */
+  double
+  referenceTransform(const Float4x4& m, const Float3& p, int column, bool translate) {
+    return p.x * static_cast<double>(m.m[0][column]) + p.y * static_cast<double>(m.m[1][column]) +
+           p.z * static_cast<double>(m.m[2][column]) + (translate ? m.m[3][column] : 0.0);
+  }
+
+  bool
+  near3(const Float3& actual, const double expected[3]) {
+    return std::fabs(actual.x - expected[0]) <= kTolerance && std::fabs(actual.y - expected[1]) <= kTolerance &&
+           std::fabs(actual.z - expected[2]) <= kTolerance;
+  }
+
+  bool
+  nearMatrix(const Matrix& a, const Matrix& b, float epsilon) {
+    for (int row = 0; row < 4; ++row) {
+      if (!nearEqual(a.r[row], b.r[row], epsilon)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Centinela tras los @p count elementos de salida: el ncleo no debe tocarlo.
+   */
+  const float kSentinel = 12345.0f;
+}
+
+NAVI_TEST(simdmath, transformPointsMatchesReference) {
+  Matrix world = testWorld();
+  Float4x4 m;
+  storeFloat4x4(&m, world);
+  Random random;
+  for (size_t count : kCounts) {
+    std::vector<Float3> points(count);
+    for (Float3& point : points) {
+      point = { random.next(), random.next(), random.next() };
+    }
+    std::vector<Float3> output(count + 1, Float3{ kSentinel, kSentinel, kSentinel });
+    transformPoints(world, points.data(), output.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      double expected[3];
+      for (int c = 0; c < 3; ++c) {
+        expected[c] = referenceTransform(m, points[i], c, true);
+      }
+      if (!near3(output[i], expected)) {
+        std::fprintf(stderr, "  %s points mismatch at %zu of %zu\n", simdPath(), i, count);
+        CHECK(false);
+        break;
+      }
+      // El ncleo por lotes coincide con la versin de un elemento.
+      Float3 single;
+      storeFloat3(&single, transformPoint(loadFloat3(&points[i]), world));
+      CHECK_NEAR(single.x, output[i].x, 1e-4);
+    }
+    CHECK_EQ(output[count].x, kSentinel);
+  }
+}
+
+NAVI_TEST(simdmath, transformNormalsMatchesReference) {
+  Matrix world = testWorld();
+  Float4x4 m;
+  storeFloat4x4(&m, world);
+  Random random;
+  for (size_t count : kCounts) {
+    std::vector<Float3> normals(count);
+    for (Float3& normal : normals) {
+      normal = { random.next(), random.next(), random.next() };
+    }
+    std::vector<Float3> output(count + 1, Float3{ kSentinel, kSentinel, kSentinel });
+    transformNormals(world, normals.data(), output.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      double expected[3];
+      for (int c = 0; c < 3; ++c) {
+        expected[c] = referenceTransform(m, normals[i], c, false);
+      }
+      double length = std::sqrt(expected[0] * expected[0] + expected[1] * expected[1] + expected[2] * expected[2]);
+      for (double& value : expected) {
+        value /= length;
+      }
+      if (!near3(output[i], expected)) {
+        std::fprintf(stderr, "  %s normals mismatch at %zu of %zu\n", simdPath(), i, count);
+        CHECK(false);
+        break;
+      }
+    }
+    CHECK_EQ(output[count].x, kSentinel);
+  }
+
+  // Una normal nula no produce NaN.
+  Float3 zero = { 0.0f, 0.0f, 0.0f };
+  Float3 result;
+  transformNormals(world, &zero, &result, 1);
+  CHECK_EQ(result.x, 0.0f);
+  CHECK_EQ(result.y, 0.0f);
+  CHECK_EQ(result.z, 0.0f);
+}
+
+NAVI_TEST(simdmath, transformAabbsMatchesReference) {
+  Matrix world = testWorld();
+  Float4x4 m;
+  storeFloat4x4(&m, world);
+  Random random;
+  for (size_t count : kCounts) {
+    std::vector<Aabb> boxes(count);
+    for (Aabb& box : boxes) {
+      Float3 corner = { random.next(), random.next(), random.next() };
+      box = { corner, { corner.x + std::fabs(random.next()), corner.y + std::fabs(random.next()),
+                        corner.z + std::fabs(random.next()) } };
+    }
+    std::vector<Aabb> output(count + 1);
+    output[count].min.x = kSentinel;
+    transformAabbs(world, boxes.data(), output.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      // La caja exacta es la envolvente de las ocho esquinas transformadas.
+      const Aabb& box = boxes[i];
+      double low[3] = { 1e30, 1e30, 1e30 };
+      double high[3] = { -1e30, -1e30, -1e30 };
+      for (int corner = 0; corner < 8; ++corner) {
+        Float3 p = { (corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+                     (corner & 4) ? box.max.z : box.min.z };
+        for (int c = 0; c < 3; ++c) {
+          double value = referenceTransform(m, p, c, true);
+          low[c] = (std::min)(low[c], value);
+          high[c] = (std::max)(high[c], value);
+        }
+      }
+      if (!near3(output[i].min, low) || !near3(output[i].max, high)) {
+        std::fprintf(stderr, "  %s aabbs mismatch at %zu of %zu\n", simdPath(), i, count);
+        CHECK(false);
+        break;
+      }
+    }
+    CHECK_EQ(output[count].min.x, kSentinel);
+  }
+}
+
+NAVI_TEST(simdmath, multiplyMatricesMatchesReference) {
+  Matrix viewProjection = multiply(lookAtLH(set(0.0f, 3.0f, -6.0f, 1.0f), set(0.0f, 1.0f, 0.0f, 1.0f),
+                                            set(0.0f, 1.0f, 0.0f, 0.0f)),
+                                   perspectiveFovLH(0.785398163f, 16.0f / 9.0f, 0.01f, 100.0f));
+  Float4x4 b;
+  storeFloat4x4(&b, viewProjection);
+  Random random;
+  for (size_t count : kCounts) {
+    std::vector<Matrix> matrices(count);
+    std::vector<Matrix> rights(count);
+    for (size_t i = 0; i < count; ++i) {
+      matrices[i] = multiply(rotationRollPitchYaw(random.next(), random.next(), random.next()),
+                             translation(random.next(), random.next(), random.next()));
+      rights[i] = multiply(viewProjection, rotationY(random.next()));
+    }
+    std::vector<Matrix> output(count);
+    std::vector<Matrix> pairwise(count);
+    multiplyMatrices(matrices.data(), viewProjection, output.data(), count);
+    multiplyMatrices(matrices.data(), rights.data(), pairwise.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      Float4x4 a, actual;
+      storeFloat4x4(&a, matrices[i]);
+      storeFloat4x4(&actual, output[i]);
+      bool matches = true;
+      for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+          double expected = 0.0;
+          for (int k = 0; k < 4; ++k) {
+            expected += static_cast<double>(a.m[row][k]) * b.m[k][column];
+          }
+          matches = matches && std::fabs(actual.m[row][column] - expected) <= kTolerance;
+        }
+      }
+      if (!matches) {
+        std::fprintf(stderr, "  %s matrices mismatch at %zu of %zu\n", simdPath(), i, count);
+        CHECK(false);
+        break;
+      }
+      CHECK(nearMatrix(pairwise[i], multiply(matrices[i], rights[i]), 1e-4f));
+    }
+  }
+}
+
+NAVI_TEST(simdmath, inverseAndQuaternions) {
+  Matrix world = testWorld();
+  float determinant = 0.0f;
+  Matrix inverted = inverse(world, &determinant);
+  CHECK_NEAR(determinant, 1.5 * 0.5 * 2.0, 1e-4);
+  CHECK(nearMatrix(multiply(world, inverted), identity(), 1e-5f));
+
+  // El cuaternin de pitch/yaw/roll genera la misma rotacin que la matriz.
+  Vector q = quaternionRotationRollPitchYaw(0.3f, 1.1f, -0.7f);
+  Matrix rotation = rotationRollPitchYaw(0.3f, 1.1f, -0.7f);
+  CHECK(nearMatrix(rotationQuaternion(q), rotation, 1e-5f));
+  Vector v = set(1.0f, -2.0f, 3.0f, 0.0f);
+  CHECK(nearEqual(setW(quaternionRotate(v, q), 0.0f), transformNormal(v, rotation), 1e-5f));
+  Vector back = quaternionRotationMatrix(rotation);
+  CHECK_NEAR(std::fabs(getX(dot4(back, q))), 1.0, 1e-5);
+
+  // Los extremos de slerp y nlerp son las entradas.
+  Vector other = quaternionRotationAxis(set(0.0f, 1.0f, 0.0f, 0.0f), 2.0f);
+  CHECK(nearEqual(quaternionSlerp(q, other, 0.0f), q, 1e-5f));
+  CHECK(nearEqual(quaternionSlerp(q, other, 1.0f), other, 1e-5f));
+  CHECK(nearEqual(quaternionNlerp(q, other, 1.0f), other, 1e-5f));
+
+  // Mscaras por componente.
+  Vector a = set(1.0f, 5.0f, 3.0f, -1.0f);
+  Vector b = set(2.0f, 5.0f, 1.0f, 0.0f);
+  CHECK_EQ(lessOrEqualMask(a, b), 0xB);
+  CHECK_EQ(greaterMask(a, b), 0x4);
+}
@@ -0,0 +1,255 @@
+/**
+ * @file TextureStreamerTests.cpp
+ * @brief Pruebas de TextureStreamer: transiciones de residencia y ajuste al presupuesto.
+ */
+#include "NaviTest.h"
+#include "TextureStreamer.h"
+
+namespace {
+  /**
+   * @brief Textura cuadrada RGBA8 de @p size texels con su cadena completa de mips.
+   */
+  StreamTextureDesc
+  squareTexture(unsigned int size) {
+    StreamTextureDesc desc;
+    desc.width = size;
+    desc.height = size;
+    for (unsigned int side = size; ; side /= 2) {
+      desc.levelBytes.push_back(static_cast<size_t>(side) * side * 4);
+      if (side == 1) {
+        break;
+      }
+    }
+    desc.tailMip = TextureStreamer::tailMipFor(size, size, static_cast<unsigned int>(desc.levelBytes.size()));
+    return desc;
+  }
+
+  size_t
+  bytesFrom(const StreamTextureDesc& desc, unsigned int mip) {
+    size_t bytes = 0;
+    for (size_t i = mip; i < desc.levelBytes.size(); ++i) {
+      bytes += desc.levelBytes[i];
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Ejecuta update() confirmando al instante todas las cargas emitidas.
+   * @return Acciones del frame.
+   */
+  std::vector<StreamAction>
+  updateAndLoad(TextureStreamer& streamer) {
+    std::vector<StreamAction> actions;
+    streamer.update(actions);
+    for (const StreamAction& action : actions) {
+      if (action.type == STREAM_LOAD) {
+        streamer.onLoaded(action.handle, action.mip);
+      }
+    }
+    return actions;
+  }
+}
+
+NAVI_TEST(streamer, tailAndRequiredMip) {
+  // La cola empieza en el primer mip de 64 px o menos.
+  CHECK_EQ(TextureStreamer::tailMipFor(1024, 1024, 11), 4u);
+  CHECK_EQ(TextureStreamer::tailMipFor(1024, 256, 11), 4u);
+  CHECK_EQ(TextureStreamer::tailMipFor(32, 32, 6), 0u);
+  // Con una cadena corta, la cola es el ltimo mip que haya.
+  CHECK_EQ(TextureStreamer::tailMipFor(1024, 1024, 2), 1u);
+
+  CHECK_NEAR(TextureStreamer::requiredMip(1024, 256.0f), 2.0f, 1e-6);
+  CHECK_NEAR(TextureStreamer::requiredMip(1024, 2048.0f), 0.0f, 1e-6);
+  CHECK_NEAR(TextureStreamer::requiredMip(1024, 256.0f, 4.0f), 4.0f, 1e-6);
+  CHECK(TextureStreamer::requiredMip(1024, 0.0f) >= 10.0f);
+}
+
+NAVI_TEST(streamer, loadsOneLevelAtATime) {
+  TextureStreamer streamer;
+  streamer.init(64u << 20);
+  StreamTextureDesc desc = squareTexture(1024);
+  StreamHandle handle = streamer.add(desc);
+  CHECK_EQ(streamer.residentMip(handle), 4u);
+  CHECK_EQ(streamer.stats().residentBytes, bytesFrom(desc, 4));
+
+  // Visto a pantalla completa: sube de la cola al mip 0 de nivel en nivel.
+  for (unsigned int expected = 3; ; --expected) {
+    streamer.request(handle, 2048.0f);
+    std::vector<StreamAction> actions;
+    streamer.update(actions);
+    CHECK_EQ(streamer.targetMip(handle), 0u);
+    CHECK_EQ(actions.size(), 1u);
+    if (actions.size() != 1) {
+      break;
+    }
+    CHECK_EQ(actions[0].type, STREAM_LOAD);
+    CHECK_EQ(actions[0].mip, expected);
+    CHECK_EQ(streamer.stats().loadsInFlight, 1u);
+    CHECK_EQ(streamer.stats().pendingBytes, desc.levelBytes[expected]);
+    // Mientras la carga est en curso no se pide otra para la misma textura.
+    std::vector<StreamAction> waiting;
+    streamer.request(handle, 2048.0f);
+    streamer.update(waiting);
+    CHECK(waiting.empty());
+
+    streamer.onLoaded(actions[0].handle, actions[0].mip);
+    CHECK_EQ(streamer.residentMip(handle), expected);
+    CHECK_EQ(streamer.stats().pendingBytes, 0u);
+    if (expected == 0) {
+      break;
+    }
+  }
+  CHECK_EQ(streamer.stats().residentBytes, bytesFrom(desc, 0));
+  CHECK_EQ(streamer.stats().loadsIssued, 4u);
+
+  // Una confirmacin repetida o de otro mip no cambia nada.
+  streamer.onLoaded(handle, 0);
+  CHECK_EQ(streamer.stats().residentBytes, bytesFrom(desc, 0));
+}
+
+NAVI_TEST(streamer, budgetDropsLeastImportantFirst) {
+  StreamTextureDesc desc = squareTexture(1024);
+  TextureStreamer streamer;
+  streamer.init(64u << 20, 8);
+  StreamHandle hero = streamer.add(desc);
+  StreamHandle prop = streamer.add(desc);
+  for (int frame = 0; frame < 8; ++frame) {
+    streamer.request(hero, 5000.0f);
+    streamer.request(prop, 1024.0f);
+    updateAndLoad(streamer);
+  }
+  CHECK_EQ(streamer.residentMip(hero), 0u);
+  CHECK_EQ(streamer.residentMip(prop), 0u);
+
+  // Con sitio para una textura completa y el mip 3 de la otra, se quitan los
+  // niveles 0 a 2 de la menos visible: su coste (1024, 2048, 4096) sigue por
+  // debajo de la importancia de la principal (5000).
+  size_t budget = bytesFrom(desc, 0) + bytesFrom(desc, 3);
+  streamer.setBudget(budget);
+  streamer.request(hero, 5000.0f);
+  streamer.request(prop, 1024.0f);
+  std::vector<StreamAction> actions;
+  streamer.update(actions);
+  CHECK_EQ(streamer.targetMip(hero), 0u);
+  CHECK_EQ(streamer.targetMip(prop), 3u);
+  CHECK_EQ(actions.size(), 1u);
+  if (actions.size() == 1) {
+    CHECK(actions[0].handle == prop);
+    CHECK_EQ(actions[0].type, STREAM_EVICT);
+    CHECK_EQ(actions[0].mip, 3u);
+  }
+  // La expulsin se contabiliza en el acto.
+  CHECK_EQ(streamer.residentMip(prop), 3u);
+  CHECK_EQ(streamer.stats().residentBytes, budget);
+  CHECK_EQ(streamer.stats().evictions, 1u);
+  CHECK_EQ(streamer.stats().wantedBytes, 2 * bytesFrom(desc, 0));
+
+  // Con ms presupuesto vuelve a cargar la textura recortada.
+  streamer.setBudget(2 * bytesFrom(desc, 0));
+  for (int frame = 0; frame < 4; ++frame) {
+    streamer.request(hero, 5000.0f);
+    streamer.request(prop, 1024.0f);
+    updateAndLoad(streamer);
+  }
+  CHECK_EQ(streamer.residentMip(prop), 0u);
+  CHECK_EQ(streamer.stats().residentBytes, 2 * bytesFrom(desc, 0));
+}
+
+NAVI_TEST(streamer, loadsRespectBudgetAndInFlightLimit) {
+  StreamTextureDesc desc = squareTexture(256);   // Cola en el mip 2.
+  TextureStreamer streamer;
+  streamer.init(64u << 20, 2);
+  std::vector<StreamHandle> handles;
+  for (int i = 0; i < 5; ++i) {
+    handles.push_back(streamer.add(desc));
+  }
+  for (StreamHandle handle : handles) {
+    streamer.request(handle, 512.0f);
+  }
+  std::vector<StreamAction> actions;
+  streamer.update(actions);
+  CHECK_EQ(actions.size(), 2u);
+  CHECK_EQ(streamer.stats().loadsInFlight, 2u);
+
+  // Una carga fallida libera su hueco y el mip se vuelve a pedir.
+  StreamHandle failed = actions[0].handle;
+  streamer.onLoaded(failed, actions[0].mip, false);
+  CHECK_EQ(streamer.residentMip(failed), 2u);
+  CHECK_EQ(streamer.stats().loadsInFlight, 1u);
+  for (StreamHandle handle : handles) {
+    streamer.request(handle, 512.0f);
+  }
+  std::vector<StreamAction> retry;
+  streamer.update(retry);
+  CHECK_EQ(retry.size(), 1u);
+  CHECK_EQ(streamer.stats().loadsInFlight, 2u);
+
+  // Nunca se emite una carga que no quepa con lo residente y lo pendiente. Con
+  // la misma importancia, el recorte quita el mip 0 a las tres y el 1 a dos.
+  TextureStreamer tight;
+  size_t budget = 3 * bytesFrom(desc, 2) + desc.levelBytes[1];
+  tight.init(budget, 8);
+  std::vector<StreamHandle> tightHandles;
+  for (int i = 0; i < 3; ++i) {
+    tightHandles.push_back(tight.add(desc));
+  }
+  for (int frame = 0; frame < 6; ++frame) {
+    for (StreamHandle handle : tightHandles) {
+      tight.request(handle, 512.0f);
+    }
+    updateAndLoad(tight);
+    CHECK(tight.stats().residentBytes + tight.stats().pendingBytes <= budget);
+  }
+  CHECK_EQ(tight.stats().residentBytes, budget);
+  unsigned int sharpened = 0;
+  for (StreamHandle handle : tightHandles) {
+    sharpened += tight.residentMip(handle) == 1 ? 1 : 0;
+  }
+  CHECK_EQ(sharpened, 1u);
+}
+
+NAVI_TEST(streamer, unseenTexturesReturnToTail) {
+  StreamTextureDesc desc = squareTexture(512);   // Cola en el mip 3.
+  TextureStreamer streamer;
+  streamer.init(64u << 20, 4, 5);
+  StreamHandle handle = streamer.add(desc);
+  for (int frame = 0; frame < 4; ++frame) {
+    streamer.request(handle, 1024.0f);
+    updateAndLoad(streamer);
+  }
+  CHECK_EQ(streamer.residentMip(handle), 0u);
+
+  // Sin request() conserva sus mips keepFrames frames y despus los suelta.
+  unsigned int evictedAt = 0;
+  for (unsigned int frame = 1; frame <= 10 && evictedAt == 0; ++frame) {
+    std::vector<StreamAction> actions = updateAndLoad(streamer);
+    if (!actions.empty()) {
+      CHECK_EQ(actions[0].type, STREAM_EVICT);
+      CHECK_EQ(actions[0].mip, 3u);
+      evictedAt = frame;
+    }
+  }
+  CHECK_EQ(evictedAt, 6u);
+  CHECK_EQ(streamer.stats().residentBytes, bytesFrom(desc, 3));
+}
+
+NAVI_TEST(streamer, removeReleasesAccounting) {
+  StreamTextureDesc desc = squareTexture(512);
+  TextureStreamer streamer;
+  streamer.init(64u << 20);
+  StreamHandle handle = streamer.add(desc);
+  streamer.request(handle, 1024.0f);
+  std::vector<StreamAction> actions;
+  streamer.update(actions);
+  CHECK_EQ(streamer.stats().loadsInFlight, 1u);
+  streamer.remove(handle);
+  CHECK_EQ(streamer.size(), 0u);
+  CHECK_EQ(streamer.stats().loadsInFlight, 0u);
+  CHECK_EQ(streamer.stats().pendingBytes, 0u);
+  CHECK_EQ(streamer.stats().residentBytes, 0u);
+  // La confirmacin tarda de la carga de una textura eliminada se ignora.
+  streamer.onLoaded(handle, actions[0].mip);
+  CHECK_EQ(streamer.stats().residentBytes, 0u);
+  CHECK_EQ(streamer.residentMip(handle), 0u);
+  CHECK(!streamer.add(StreamTextureDesc()).isValid());
+}
@@ -0,0 +1,189 @@
+/**
+ * @file AtlasCook.cpp
+ * @brief Herramienta de cocinado offline: muchas imgenes PNG/JPG -> pginas de atlas DDS.
+ *
+ * Empaqueta las imgenes con packAtlas() (TextureAtlas.h), compone cada pgina
+ * con bordes repetidos, genera sus mips sin mezcla entre imgenes vecinas,
+ * la comprime por bloques y escribe <prefijo>_<pgina>.dds. El archivo
+ * <prefijo>.atlas lista, por imagen, la pgina y la transformacin de UV
+ * (offsetU offsetV scaleU scaleV) que hay que aplicar a las mallas que la usan.
+ *
+ * No forma parte de las soluciones de Visual Studio; se compila con el objetivo
+ * atlascook de CMakeLists.txt:
+ *
+ *   cmake -S NaviEngine -B build && cmake --build build --target atlascook
+ *   ./build/atlascook Assets/Props Assets/Props/Barrel.png Assets/Props/Crate.png --max-size 2048 --srgb
+ *
+ * Las imgenes se pasan una a una; el shell expande los comodines de la carpeta.
+ *
+ * Opciones:
+ *   --max-size <n>                  Lado mximo de pgina (por defecto 4096).
+ *   --padding <n>                   Borde por imagen en texels (por defecto 4).
+ *   --mips <n>                      Niveles de mip de las pginas, 3 o ms (por defecto 4).
+ *   --format <bc1|bc3|bc4|bc5|bc7>  Formato de salida (por defecto bc7).
+ *   --quality <fast|normal|high>    Preset de calidad (por defecto normal).
+ *   --srgb                          El color est en sRGB.
+ */
+#include "BlockCompressor.h"
+#include "ImageDecoder.h"
+#include "JobSystem.h"
+#include "MipGenerator.h"
+#include "TextureAtlas.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+  bool
+  parseFormat(const std::string& name, BlockFormat& format) {
+    if (name == "bc1") format = BLOCK_BC1;
+    else if (name == "bc3") format = BLOCK_BC3;
+    else if (name == "bc4") format = BLOCK_BC4;
+    else if (name == "bc5") format = BLOCK_BC5;
+    else if (name == "bc7") format = BLOCK_BC7;
+    else return false;
+    return true;
+  }
+
+  bool
+  parseQuality(const std::string& name, BlockQuality& quality) {
+    if (name == "fast") quality = BLOCK_QUALITY_FAST;
+    else if (name == "normal") quality = BLOCK_QUALITY_NORMAL;
+    else if (name == "high") quality = BLOCK_QUALITY_HIGH;
+    else return false;
+    return true;
+  }
+
+  bool
+  writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    bool ok = file && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    if (file) {
+      std::fclose(file);
+    }
+    return ok;
+  }
+}
+
+int
+main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: atlascook <output-prefix> <image> [image...] [options]\n");
+    return 2;
+  }
+  std::string prefix = argv[1];
+  std::vector<std::string> inputs;
+  AtlasSettings atlasSettings;
+  BlockFormat format = BLOCK_BC7;
+  BlockQuality quality = BLOCK_QUALITY_NORMAL;
+  MipSettings mipSettings;
+  mipSettings.srgb = false;
+
+  for (int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> const char* {
+      if (i + 1 >= argc) {
+        std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--max-size") atlasSettings.maxSize = static_cast<unsigned int>(std::strtoul(value(), nullptr, 10));
+    else if (arg == "--padding") atlasSettings.padding = static_cast<unsigned int>(std::strtoul(value(), nullptr, 10));
+    else if (arg == "--mips") atlasSettings.mipLevels = static_cast<unsigned int>(std::strtoul(value(), nullptr, 10));
+    else if (arg == "--format") {
+      if (!parseFormat(value(), format)) {
+        std::fprintf(stderr, "unknown format\n");
+        return 2;
+      }
+    }
+    else if (arg == "--quality") {
+      if (!parseQuality(value(), quality)) {
+        std::fprintf(stderr, "unknown quality\n");
+        return 2;
+      }
+    }
+    else if (arg == "--srgb") mipSettings.srgb = true;
+    else if (arg.compare(0, 2, "--") == 0) {
+      std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+      return 2;
+    }
+    else inputs.push_back(arg);
+  }
+  // Con 3 niveles o ms las pginas son mltiplo de 4, como exigen los formatos BC.
+  if (atlasSettings.mipLevels < 3) {
+    std::fprintf(stderr, "--mips must be 3 or more for block-compressed pages\n");
+    return 2;
+  }
+  mipSettings.maxLevels = atlasSettings.mipLevels;
+
+  std::vector<AtlasInput> sizes(inputs.size());
+  std::vector<DecodedImage> images(inputs.size());
+  std::vector<const uint8_t*> pixels(inputs.size(), nullptr);
+  bool ok = true;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    std::string error;
+    if (!ImageDecoder::instance().decodeFile(inputs[i], images[i], &error)) {
+      std::fprintf(stderr, "failed to decode %s: %s\n", inputs[i].c_str(), error.c_str());
+      ok = false;
+      break;
+    }
+    sizes[i].width = images[i].width;
+    sizes[i].height = images[i].height;
+    pixels[i] = images[i].pixels.data();
+  }
+
+  JobSystem::instance().init();
+  auto start = std::chrono::steady_clock::now();
+  AtlasLayout layout;
+  if (ok && !packAtlas(sizes, atlasSettings, layout)) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (layout.rects[i].page < 0) {
+        std::fprintf(stderr, "%s does not fit in a %u page\n", inputs[i].c_str(), atlasSettings.maxSize);
+      }
+    }
+    ok = false;
+  }
+
+  size_t totalBytes = 0;
+  for (unsigned int page = 0; ok && page < layout.pages.size(); ++page) {
+    std::vector<uint8_t> rgba;
+    MipChain mips;
+    CompressedChain chain;
+    std::vector<uint8_t> dds;
+    const AtlasPage& atlasPage = layout.pages[page];
+    ok = composeAtlasPage(layout, pixels, page, rgba) &&
+         generateMipChain(rgba.data(), atlasPage.width, atlasPage.height, mipSettings, mips) &&
+         compressMipChain(mips, format, quality, mipSettings.srgb, chain) &&
+         writeDds(chain, dds) &&
+         writeFile(prefix + "_" + std::to_string(page) + ".dds", dds);
+    totalBytes += dds.size();
+  }
+
+  if (ok) {
+    std::FILE* manifest = std::fopen((prefix + ".atlas").c_str(), "w");
+    ok = manifest != nullptr;
+    for (size_t i = 0; ok && i < inputs.size(); ++i) {
+      const AtlasRect& rect = layout.rects[i];
+      std::fprintf(manifest, "%s %d %.8f %.8f %.8f %.8f\n", inputs[i].c_str(), rect.page,
+                   rect.offsetU, rect.offsetV, rect.scaleU, rect.scaleV);
+    }
+    if (manifest) {
+      std::fclose(manifest);
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  if (ok) {
+    std::printf("%s: %zu images, %zu pages, %.1f%% occupancy, %zu bytes, %.1f ms\n",
+                prefix.c_str(), inputs.size(), layout.pages.size(), layout.occupancy() * 100.0,
+                totalBytes, seconds * 1000.0);
+  }
+  else {
+    std::fprintf(stderr, "failed to cook atlas %s\n", prefix.c_str());
+  }
+  JobSystem::instance().destroy();
+  return ok ? 0 : 1;
+}
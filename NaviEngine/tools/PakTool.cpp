@@ -0,0 +1,157 @@
+/**
+ * @file PakTool.cpp
+ * @brief Herramienta de empaquetado: carpetas y archivos sueltos -> archivo .pak.
+ *
+ * Cada entrada se guarda con la ruta tal como se escribi en la lnea de
+ * comandos (ms la ruta relativa dentro de las carpetas), as que el motor la
+ * encuentra por la misma ruta con la que antes abra el archivo suelto:
+ *
+ *   ./paktool Assets.pak Assets NaviEngine.fx --compress
+ *
+ * guarda "assets/ducktexture.dds", "naviengine.fx", etc. (PakFile.h normaliza
+ * las rutas a minsculas con '/'). BaseApp monta Assets.pak si existe.
+ *
+ * No forma parte de las soluciones de Visual Studio; se compila con el objetivo
+ * paktool de CMakeLists.txt:
+ *
+ *   cmake -S NaviEngine -B build && cmake --build build --target paktool
+ *
+ * Opciones:
+ *   --compress      Comprime con LzCodec las entradas en las que ahorra al menos 1/8.
+ *   --align <n>     Alineacin de cada entrada en bytes (por defecto 64; 4096 = pgina).
+ *   --list          Lista el contenido de un .pak existente: paktool --list Assets.pak
+ */
+#include "LzCodec.h"
+#include "MappedFile.h"
+#include "PakFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+  /**
+   * @brief Aade a @p files el archivo o, si es carpeta, todos los archivos que contiene.
+   */
+  bool
+  collectInputs(const std::string& input, std::vector<std::string>& files) {
+    std::error_code error;
+    std::filesystem::path path(input);
+    if (std::filesystem::is_regular_file(path, error)) {
+      files.push_back(path.generic_string());
+      return true;
+    }
+    if (!std::filesystem::is_directory(path, error)) {
+      return false;
+    }
+    std::vector<std::string> found;
+    for (auto it = std::filesystem::recursive_directory_iterator(path, error);
+         it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+      if (error) {
+        return false;
+      }
+      if (it->is_regular_file(error)) {
+        found.push_back(it->path().generic_string());
+      }
+    }
+    // Orden estable: los archivos de una misma carpeta quedan contiguos en el .pak.
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+    return true;
+  }
+
+  int
+  listPak(const std::string& fileName) {
+    PakArchive archive;
+    std::string error;
+    if (!archive.load(fileName, &error)) {
+      std::fprintf(stderr, "failed to open %s: %s\n", fileName.c_str(), error.c_str());
+      return 1;
+    }
+    for (size_t i = 0; i < archive.entryCount(); ++i) {
+      const PakEntry& entry = archive.entry(i);
+      std::printf("%12llu %12llu %s %s\n",
+                  static_cast<unsigned long long>(entry.size),
+                  static_cast<unsigned long long>(entry.storedSize),
+                  (entry.flags & PAK_ENTRY_LZ) ? "lz " : "raw",
+                  archive.entryName(entry).c_str());
+    }
+    return 0;
+  }
+}
+
+int
+main(int argc, char** argv) {
+  if (argc == 3 && std::string(argv[1]) == "--list") {
+    return listPak(argv[2]);
+  }
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: paktool <output.pak> <file|directory>... [options]\n"
+                         "       paktool --list <file.pak>\n");
+    return 2;
+  }
+
+  std::string output = argv[1];
+  std::vector<std::string> inputs;
+  bool compress = false;
+  PakWriter writer;
+  for (int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--compress") {
+      compress = true;
+    }
+    else if (arg == "--align") {
+      if (i + 1 >= argc) {
+        std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+        return 2;
+      }
+      writer.setAlignment(static_cast<uint32_t>(std::atoi(argv[++i])));
+    }
+    else if (arg.compare(0, 2, "--") == 0) {
+      std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+      return 2;
+    }
+    else {
+      inputs.push_back(arg);
+    }
+  }
+
+  std::vector<std::string> files;
+  for (const std::string& input : inputs) {
+    if (!collectInputs(input, files)) {
+      std::fprintf(stderr, "cannot read %s\n", input.c_str());
+      return 1;
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (const std::string& file : files) {
+    MappedFile mapped;
+    // MappedFile no proyecta archivos vacos: se guardan como entrada de 0 bytes.
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (mapped.open(file)) {
+      data = mapped.data();
+      size = mapped.size();
+    }
+    if (!writer.add(file, data, size, compress)) {
+      std::fprintf(stderr, "duplicate or invalid path %s\n", file.c_str());
+      return 1;
+    }
+  }
+  std::string error;
+  if (!writer.write(output, &error)) {
+    std::fprintf(stderr, "failed to write %s: %s\n", output.c_str(), error.c_str());
+    return 1;
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::printf("%s: %zu files, %.2f MB -> %.2f MB stored in %.2f s\n",
+              output.c_str(), writer.entryCount(),
+              writer.originalBytes() / 1e6, writer.storedBytes() / 1e6, seconds);
+  return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file TextureCook.cpp
+ * @brief Herramienta de cocinado offline: PNG/JPG -> DDS comprimido con mips.
+ *
+ * Decodifica la imagen con ImageDecoder, genera la cadena de mips (MipGenerator.h),
+ * la comprime por bloques (BlockCompressor.h) y escribe un DDS que el motor
+ * carga por la ruta DDS de Texture sin trabajo adicional en tiempo de carga.
+ *
+ * No forma parte de las soluciones de Visual Studio; se compila con el objetivo
+ * texturecook de CMakeLists.txt:
+ *
+ *   cmake -S NaviEngine -B build && cmake --build build --target texturecook
+ *   ./build/texturecook Assets/Brick.png Assets/Brick.dds --format bc7 --quality high --srgb
+ *
+ * Opciones:
+ *   --format <bc1|bc3|bc4|bc5|bc7>  Formato de salida (por defecto bc7).
+ *   --quality <fast|normal|high>    Preset de calidad (por defecto normal).
+ *   --srgb                          El color est en sRGB (mips en espacio lineal, formato _SRGB).
+ *   --kaiser                        Filtro Kaiser en lugar de box para los mips.
+ *   --alpha-test <ref>              Conserva la cobertura del alpha test con el umbral dado.
+ *   --no-mips                       Solo el nivel 0.
+ */
+#include "BlockCompressor.h"
+#include "ImageDecoder.h"
+#include "JobSystem.h"
+#include "MipGenerator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+  bool
+  parseFormat(const std::string& name, BlockFormat& format) {
+    if (name == "bc1") format = BLOCK_BC1;
+    else if (name == "bc3") format = BLOCK_BC3;
+    else if (name == "bc4") format = BLOCK_BC4;
+    else if (name == "bc5") format = BLOCK_BC5;
+    else if (name == "bc7") format = BLOCK_BC7;
+    else return false;
+    return true;
+  }
+
+  bool
+  parseQuality(const std::string& name, BlockQuality& quality) {
+    if (name == "fast") quality = BLOCK_QUALITY_FAST;
+    else if (name == "normal") quality = BLOCK_QUALITY_NORMAL;
+    else if (name == "high") quality = BLOCK_QUALITY_HIGH;
+    else return false;
+    return true;
+  }
+}
+
+int
+main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: texturecook <input.png|jpg> <output.dds> [options]\n");
+    return 2;
+  }
+  std::string input = argv[1];
+  std::string output = argv[2];
+  BlockFormat format = BLOCK_BC7;
+  BlockQuality quality = BLOCK_QUALITY_NORMAL;
+  MipSettings settings;
+  settings.srgb = false;
+
+  for (int i = 3; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> const char* {
+      if (i + 1 >= argc) {
+        std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+        std::exit(2);
+      }
+      return argv[++i];
+    };
+    if (arg == "--format") {
+      if (!parseFormat(value(), format)) {
+        std::fprintf(stderr, "unknown format\n");
+        return 2;
+      }
+    }
+    else if (arg == "--quality") {
+      if (!parseQuality(value(), quality)) {
+        std::fprintf(stderr, "unknown quality\n");
+        return 2;
+      }
+    }
+    else if (arg == "--srgb") settings.srgb = true;
+    else if (arg == "--kaiser") settings.filter = MIP_FILTER_KAISER;
+    else if (arg == "--alpha-test") {
+      settings.preserveAlphaCoverage = true;
+      settings.alphaReference = static_cast<float>(std::strtod(value(), nullptr));
+    }
+    else if (arg == "--no-mips") settings.maxLevels = 1;
+    else {
+      std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+      return 2;
+    }
+  }
+
+  DecodedImage image;
+  std::string error;
+  if (!ImageDecoder::instance().decodeFile(input, image, &error)) {
+    std::fprintf(stderr, "failed to decode %s: %s\n", input.c_str(), error.c_str());
+    return 1;
+  }
+  unsigned int width = image.width;
+  unsigned int height = image.height;
+  if (!canBlockCompress(width, height)) {
+    std::fprintf(stderr, "%s is %ux%u; block-compressed textures need multiples of 4\n",
+                 input.c_str(), width, height);
+    return 1;
+  }
+
+  JobSystem::instance().init();
+  auto start = std::chrono::steady_clock::now();
+  MipChain mips;
+  CompressedChain chain;
+  bool ok = generateMipChain(std::move(image.pixels), width, height, settings, mips) &&
+            compressMipChain(mips, format, quality, settings.srgb, chain);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::vector<uint8_t> dds;
+  if (ok) {
+    ok = writeDds(chain, dds);
+  }
+  if (ok) {
+    std::FILE* file = std::fopen(output.c_str(), "wb");
+    ok = file && std::fwrite(dds.data(), 1, dds.size(), file) == dds.size();
+    if (file) {
+      std::fclose(file);
+    }
+  }
+  if (ok) {
+    std::vector<uint8_t> decoded;
+    const MipLevel& top = mips.levels[0];
+    double psnr = decompressImage(chain.levels[0].blocks.data(), top.width, top.height, format, decoded)
+                ? computePsnr(top.pixels.data(), decoded.data(), static_cast<size_t>(top.width) * top.height,
+                              format == BLOCK_BC4 ? 0x1 : format == BLOCK_BC5 ? 0x3 : format == BLOCK_BC1 ? 0x7 : 0xF)
+                : 0.0;
+    std::printf("%s: %ux%u, %zu mips, %zu bytes, %.1f ms, level 0 PSNR %.2f dB\n",
+                output.c_str(), width, height, chain.levels.size(), dds.size(), seconds * 1000.0, psnr);
+  }
+  else {
+    std::fprintf(stderr, "failed to cook %s\n", input.c_str());
+  }
+  JobSystem::instance().destroy();
+  return ok ? 0 : 1;
+}